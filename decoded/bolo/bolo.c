@@ -36,10 +36,11 @@ void init_emulated(void) {
 
 void run_emulated(unsigned run_cycles) {
   bool branchTarget = true;
-  for(unsigned start_cycles = s_cycles; s_cycles - start_cycles < run_cycles;) {
+  start_run(run_cycles);
+  while (s_remaining_cycles > 0) {
     uint16_t tmp16;
     uint8_t tmp;
-    switch (s_pc) {
+    switch (dispatch_pc()) {
     case 0x0000: // [$0000..$0000]    1 bytes
       CYCLES(0x0000, 2);
       // WARNING: opcode self modification.
@@ -18308,6 +18309,10 @@ void run_emulated(unsigned run_cycles) {
       CYCLES(0xfca8, 2);
       /* $FCA8 SEC */ s_status |= STATUS_C;
     case 0xfca9: // [$FCA9..$FCA9]    1 bytes
+      if (wait_fast(2, 7, 9)) {
+        s_pc = s_a ? 0xfca9 : 0xfcb3;
+        break;
+      }
       CYCLES(0xfca9, 2);
       /* $FCA9 PHA */ push8(s_a);
     case 0xfcaa: // [$FCAA..$FCAD]    4 bytes
@@ -18593,8 +18598,10 @@ void run_emulated(unsigned run_cycles) {
       branchTarget = true;
       break;
     default:
-      fprintf(stderr, "Unknown code address: $%04X\n", s_pc);
-      error_handler(s_pc);
+      if (!unknown_code_address())
+        return;
+      branchTarget = true;
+      break;
     }
   }
 }
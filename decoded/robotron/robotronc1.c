@@ -49,22 +49,6 @@ static uint16_t sbc_dec16(uint8_t a, uint8_t b, uint8_t cf) {
   return res.result | (res.status << 8);
 }
 
-static int cmp_map_addr(const void *a, const void *b) {
-  return *((const int *)a) - *((const int *)b);
-}
-
-static unsigned
-addr_to_block_id(uint16_t from_pc, uint16_t addr, const unsigned *block_map, size_t length) {
-  unsigned uaddr = addr;
-  const unsigned *p =
-      (const unsigned *)bsearch(&uaddr, block_map, length, sizeof(unsigned) * 2, cmp_map_addr);
-  if (p)
-    return p[1];
-  fprintf(stderr, "Unknown address $%04X\n", addr);
-  error_handler(from_pc);
-  abort();
-};
-
 void func_t001(uint16_t ret_addr);
 void func_0143(uint16_t ret_addr);
 void func_0146(uint16_t ret_addr);
@@ -147,6 +131,137 @@ void func_7821(uint16_t ret_addr);
 void func_7979(uint16_t ret_addr);
 void FUNC_PREAD(uint16_t ret_addr);
 
+/// The entry points of the functions, where interpreted code continues
+/// natively.
+static const struct func_entry {
+  uint16_t addr;
+  void (*fn)(uint16_t ret_addr);
+} s_func_entries[] = {
+    {0x0143, func_0143},
+    {0x0146, func_0146},
+    {0x0149, func_0149},
+    {0x014c, func_014c},
+    {0x014f, func_014f},
+    {0x0540, func_0540},
+    {0x4185, func_4185},
+    {0x4242, func_4242},
+    {0x424e, func_424e},
+    {0x425b, func_425b},
+    {0x430e, func_430e},
+    {0x4353, func_4353},
+    {0x442a, func_442a},
+    {0x46e9, func_46e9},
+    {0x4824, func_4824},
+    {0x4831, func_4831},
+    {0x4c00, func_4c00},
+    {0x4c1c, func_4c1c},
+    {0x4c36, func_4c36},
+    {0x4c4b, func_4c4b},
+    {0x4c6e, func_4c6e},
+    {0x4c7c, func_4c7c},
+    {0x4cac, func_4cac},
+    {0x4cd0, func_4cd0},
+    {0x4cf6, func_4cf6},
+    {0x4d21, func_4d21},
+    {0x4da2, func_4da2},
+    {0x4dd0, func_4dd0},
+    {0x4e1f, func_4e1f},
+    {0x4e4f, func_4e4f},
+    {0x4ec4, func_4ec4},
+    {0x4ef1, func_4ef1},
+    {0x4f25, func_4f25},
+    {0x4f42, func_4f42},
+    {0x4fcd, func_4fcd},
+    {0x4ffe, func_4ffe},
+    {0x502d, func_502d},
+    {0x5059, func_5059},
+    {0x5081, func_5081},
+    {0x50a1, func_50a1},
+    {0x50c5, func_50c5},
+    {0x5108, func_5108},
+    {0x51e8, func_51e8},
+    {0x5200, func_5200},
+    {0x5209, func_5209},
+    {0x54dd, func_54dd},
+    {0x54e5, func_54e5},
+    {0x54f5, func_54f5},
+    {0x5837, func_5837},
+    {0x5855, func_5855},
+    {0x5883, func_5883},
+    {0x58b9, func_58b9},
+    {0x58ee, func_58ee},
+    {0x5924, func_5924},
+    {0x598d, func_598d},
+    {0x5a00, func_5a00},
+    {0x5a03, func_5a03},
+    {0x5a1b, func_5a1b},
+    {0x5a1e, func_5a1e},
+    {0x6200, func_6200},
+    {0x6215, func_6215},
+    {0x64a8, func_64a8},
+    {0x6500, func_6500},
+    {0x67b8, func_67b8},
+    {0x6832, func_6832},
+    {0x6c2f, func_6c2f},
+    {0x7000, func_7000},
+    {0x7006, func_7006},
+    {0x7009, func_7009},
+    {0x72d9, func_72d9},
+    {0x7459, func_7459},
+    {0x7546, func_7546},
+    {0x7628, func_7628},
+    {0x768f, func_768f},
+    {0x7778, func_7778},
+    {0x779e, func_779e},
+    {0x7812, func_7812},
+    {0x7821, func_7821},
+    {0x7979, func_7979},
+    {0xfb1e, FUNC_PREAD},
+};
+
+static int cmp_func_entry(const void *key, const void *entry) {
+  return *((const uint16_t *)key) - ((const struct func_entry *)entry)->addr;
+}
+
+/// Invoked when execution reaches \p addr, which isn't a block of the current
+/// function. Return true if the function must return, because the code
+/// returned to one of its callers. Otherwise run the function starting at
+/// \p addr natively, or interpret one instruction, and store the address of
+/// the next one in \p addr.
+static bool run_unknown(uint16_t *addr) {
+  if (native_unwind(*addr))
+    return true;
+  const struct func_entry *f = (const struct func_entry *)bsearch(
+      addr,
+      s_func_entries,
+      sizeof(s_func_entries) / sizeof(s_func_entries[0]),
+      sizeof(s_func_entries[0]),
+      cmp_func_entry);
+  if (f && f->fn)
+    return native_call(f->fn, addr);
+  *addr = interpret_unknown(*addr);
+  return false;
+}
+
+static int cmp_map_addr(const void *a, const void *b) {
+  return *((const int *)a) - *((const int *)b);
+}
+
+/// Map \p addr to a block id. Code which wasn't decompiled is interpreted
+/// until it reaches a block in the map, or returns to a caller.
+static unsigned
+addr_to_block_id(uint16_t from_pc, uint16_t addr, const unsigned *block_map, size_t length) {
+  for (;;) {
+    unsigned uaddr = addr;
+    const unsigned *p =
+        (const unsigned *)bsearch(&uaddr, block_map, length, sizeof(unsigned) * 2, cmp_map_addr);
+    if (p)
+      return p[1];
+    if (run_unknown(&addr))
+      return UNWIND_BLOCK_ID;
+  }
+};
+
 static void emulated_entry_point(void) {
   func_t001(false);
 }
@@ -154,8 +269,7 @@ static void emulated_entry_point(void) {
 void func_0143(uint16_t ret_addr) {
   bool branchTarget = true;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$0143*/ CYCLES(0x0143, 2);
@@ -166,8 +280,7 @@ bb_0:
 void func_0146(uint16_t ret_addr) {
   bool branchTarget = true;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$0146*/ CYCLES(0x0146, 2);
@@ -178,8 +291,7 @@ bb_0:
 void func_0149(uint16_t ret_addr) {
   bool branchTarget = true;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$0149*/ CYCLES(0x0149, 2);
@@ -190,8 +302,7 @@ bb_0:
 void func_014c(uint16_t ret_addr) {
   bool branchTarget = true;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$014C*/ CYCLES(0x014c, 2);
@@ -202,8 +313,7 @@ bb_0:
 void func_014f(uint16_t ret_addr) {
   bool branchTarget = true;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$014F*/ CYCLES(0x014f, 2);
@@ -215,8 +325,7 @@ void func_0540(uint16_t ret_addr) {
   bool branchTarget = true;
   uint8_t tmp1_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$0540*/ CYCLES(0x0540, 7);
@@ -239,7 +348,7 @@ bb_2:
               goto bb_0;
 bb_3:
   /*$0549*/ CYCLES(0x0549, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
@@ -248,8 +357,7 @@ void func_4185(uint16_t ret_addr) {
   uint8_t tmp1_U8;
   uint16_t tmp2_U16;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$4185*/ CYCLES(0x4185, 12);
@@ -265,7 +373,7 @@ bb_1:
 bb_2:
   /*$418E*/ CYCLES(0x418e, 16);
   /*$4191*/ ram_poke(0x1506, (s_a & ram_peek(0x1506)));
-  /*$4194*/ FUNC_PREAD(0xfffe);
+  /*$4194*/ FUNC_PREAD(0xfffe); if (s_native_depth <= depth) return;
   /*$4197*/ CYCLES(0x4197, 11);
             s_x = 0x00;
             branchTarget = true;
@@ -304,7 +412,7 @@ bb_8:
             s_status_n = (tmp1_U8 & 0x80);
             s_a = tmp1_U8;
   /*$41B0*/ ram_poke(0x1506, tmp1_U8);
-  /*$41B3*/ if (ret_addr) pop16(); return;
+  /*$41B3*/ native_return(ret_addr); return;
 }
 
 
@@ -312,8 +420,7 @@ void func_4242(uint16_t ret_addr) {
   bool branchTarget = true;
   uint8_t tmp1_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$4242*/ CYCLES(0x4242, 9);
@@ -329,7 +436,7 @@ bb_1:
   /*$424A*/ tmp1_U8 = tmp1_U8 & 0x7f;
             s_a = tmp1_U8;
   /*$424C*/ s_y = tmp1_U8;
-  /*$424D*/ if (ret_addr) pop16(); return;
+  /*$424D*/ native_return(ret_addr); return;
 }
 
 
@@ -340,12 +447,11 @@ void func_424e(uint16_t ret_addr) {
   uint16_t tmp3_U16;
   uint16_t tmp4_U16;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$424E*/ CYCLES(0x424e, 6);
-            func_4242(0xfffe);
+            func_4242(0xfffe); if (s_native_depth <= depth) return;
   /*$4251*/ CYCLES(0x4251, 7);
             tmp1_U8 = s_a;
             tmp2_U8 = tmp1_U8 != 0x0d;
@@ -365,7 +471,7 @@ bb_1:
             s_status_c = (tmp2_U8 >= 0x0a);
 bb_2:
   /*$425A*/ CYCLES(0x425a, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
@@ -373,8 +479,7 @@ void func_425b(uint16_t ret_addr) {
   bool branchTarget = true;
   uint8_t tmp1_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$425B*/ CYCLES(0x425b, 7);
@@ -391,7 +496,7 @@ bb_2:
               goto bb_2;
 bb_3:
   /*$4264*/ CYCLES(0x4264, 6);
-            func_4c6e(0xfffe);
+            func_4c6e(0xfffe); if (s_native_depth <= depth) return;
   /*$4267*/ CYCLES(0x4267, 6);
             tmp1_U8 = (uint8_t)(s_x - 0x01);
             s_x = tmp1_U8;
@@ -400,7 +505,7 @@ bb_3:
               goto bb_1;
 bb_4:
   /*$426A*/ CYCLES(0x426a, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
@@ -411,8 +516,7 @@ void func_430e(uint16_t ret_addr) {
   uint16_t tmp3_U16;
   uint16_t tmp4_U16;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$430E*/ CYCLES(0x430e, 18);
@@ -595,8 +699,8 @@ bb_23:
 bb_24:
   /*$43BB*/ CYCLES(0x43bb, 9);
             ram_poke(0x00ca, s_x);
-  /*$43BD*/ func_4c6e(0x0000);
-            if (ret_addr) pop16(); return;
+  /*$43BD*/ func_4c6e(0x0000); if (s_native_depth <= depth) return;
+            native_return(ret_addr); return;
 }
 
 
@@ -605,8 +709,7 @@ void func_4353(uint16_t ret_addr) {
   uint8_t tmp1_U8;
   uint16_t tmp2_U16;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$4353*/ CYCLES(0x4353, 14);
@@ -726,8 +829,8 @@ bb_17:
 bb_18:
   /*$43BB*/ CYCLES(0x43bb, 9);
             ram_poke(0x00ca, s_x);
-  /*$43BD*/ func_4c6e(0x0000);
-            if (ret_addr) pop16(); return;
+  /*$43BD*/ func_4c6e(0x0000); if (s_native_depth <= depth) return;
+            native_return(ret_addr); return;
 }
 
 
@@ -735,8 +838,7 @@ void func_442a(uint16_t ret_addr) {
   bool branchTarget = true;
   uint8_t tmp1_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$442A*/ CYCLES(0x442a, 53);
@@ -830,7 +932,7 @@ bb_11:
   /*$4497*/ CYCLES(0x4497, 11);
             s_a = 0x00;
   /*$4499*/ ram_poke(0x1428, 0x00);
-  /*$449C*/ if (ret_addr) pop16(); return;
+  /*$449C*/ native_return(ret_addr); return;
 }
 
 
@@ -838,8 +940,7 @@ void func_46e9(uint16_t ret_addr) {
   bool branchTarget = true;
   uint8_t tmp1_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$46E9*/ CYCLES(0x46e9, 12);
@@ -877,15 +978,14 @@ bb_4:
             goto bb_1;
 bb_5:
   /*$4705*/ CYCLES(0x4705, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
 void func_4824(uint16_t ret_addr) {
   bool branchTarget = true;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$4824*/ CYCLES(0x4824, 23);
@@ -894,7 +994,7 @@ bb_0:
   /*$482A*/ ram_poke(0x00fa, 0x01);
   /*$482C*/ s_a = 0x00;
   /*$482E*/ ram_poke(0x00fb, 0x00);
-  /*$4830*/ if (ret_addr) pop16(); return;
+  /*$4830*/ native_return(ret_addr); return;
 }
 
 
@@ -902,8 +1002,7 @@ void func_4831(uint16_t ret_addr) {
   bool branchTarget = true;
   uint8_t tmp1_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$4831*/ CYCLES(0x4831, 23);
@@ -913,7 +1012,7 @@ bb_0:
   /*$4837*/ tmp1_U8 = s_y;
             ram_poke(0x1501, tmp1_U8);
   /*$483A*/ ram_poke(0x1503, tmp1_U8);
-  /*$483D*/ if (ret_addr) pop16(); return;
+  /*$483D*/ native_return(ret_addr); return;
 }
 
 
@@ -924,8 +1023,7 @@ void func_4c00(uint16_t ret_addr) {
   uint16_t tmp3_U16;
   uint16_t tmp4_U16;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$4C00*/ CYCLES(0x4c00, 18);
@@ -965,7 +1063,7 @@ bb_4:
   /*$4C18*/ CYCLES(0x4c18, 7);
             s_x = s_a;
   /*$4C19*/ s_a = ram_peek(0x00e2);
-  /*$4C1B*/ if (ret_addr) pop16(); return;
+  /*$4C1B*/ native_return(ret_addr); return;
 }
 
 
@@ -975,8 +1073,7 @@ void func_4c1c(uint16_t ret_addr) {
   uint8_t tmp2_U8;
   uint16_t tmp3_U16;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$4C1C*/ CYCLES(0x4c1c, 14);
@@ -1016,7 +1113,7 @@ bb_4:
   /*$4C32*/ CYCLES(0x4c32, 7);
             s_x = s_a;
   /*$4C33*/ s_a = ram_peek(0x00e2);
-  /*$4C35*/ if (ret_addr) pop16(); return;
+  /*$4C35*/ native_return(ret_addr); return;
 }
 
 
@@ -1027,8 +1124,7 @@ void func_4c36(uint16_t ret_addr) {
   uint16_t tmp3_U16;
   uint8_t tmp4_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$4C36*/ CYCLES(0x4c36, 36);
@@ -1046,7 +1142,7 @@ bb_0:
             s_status_n = (tmp4_U8 & 0x80);
             s_a = tmp4_U8;
   /*$4C48*/ ram_poke(0x004e, tmp4_U8);
-  /*$4C4A*/ if (ret_addr) pop16(); return;
+  /*$4C4A*/ native_return(ret_addr); return;
 }
 
 
@@ -1057,13 +1153,12 @@ void func_4c4b(uint16_t ret_addr) {
   uint16_t tmp3_U16;
   uint16_t tmp4_U16;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$4C4B*/ CYCLES(0x4c4b, 7);
             tmp1_U8 = s_a;
-  /*$4C4C*/ func_4c36(0xfffe);
+  /*$4C4C*/ func_4c36(0xfffe); if (s_native_depth <= depth) return;
   /*$4C4F*/ CYCLES(0x4c4f, 18);
             ram_poke(0x00e0, s_a);
   /*$4C51*/ ram_poke(0x00e1, tmp1_U8);
@@ -1110,7 +1205,7 @@ bb_5:
   /*$4C6B*/ tmp1_U8 = ram_peek(0x00e2);
             s_status_n = (tmp1_U8 & 0x80);
             s_a = tmp1_U8;
-  /*$4C6D*/ if (ret_addr) pop16(); return;
+  /*$4C6D*/ native_return(ret_addr); return;
 }
 
 
@@ -1122,8 +1217,7 @@ void func_4c6e(uint16_t ret_addr) {
   uint16_t tmp4_U16;
   uint8_t tmp5_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$4C6E*/ CYCLES(0x4c6e, 7);
@@ -1158,7 +1252,7 @@ bb_2:
             s_a = tmp1_U8;
 bb_3:
   /*$4C7B*/ CYCLES(0x4c7b, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
@@ -1168,8 +1262,7 @@ void func_4c7c(uint16_t ret_addr) {
   uint16_t tmp2_U16;
   uint16_t tmp3_U16;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$4C7C*/ CYCLES(0x4c7c, 21);
@@ -1220,7 +1313,7 @@ bb_4:
   /*$4CA5*/ tmp1_U8 = peek((ram_peek16al(0x0006) + 0x0001));
   /*$4CA8*/ s_y = (uint8_t)(tmp1_U8 - 0x01);
   /*$4CA9*/ s_x = 0x00;
-  /*$4CAB*/ if (ret_addr) pop16(); return;
+  /*$4CAB*/ native_return(ret_addr); return;
 }
 
 
@@ -1230,12 +1323,11 @@ void func_4cac(uint16_t ret_addr) {
   uint8_t tmp2_U8;
   uint8_t tmp3_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$4CAC*/ CYCLES(0x4cac, 6);
-            func_4c7c(0xfffe);
+            func_4c7c(0xfffe); if (s_native_depth <= depth) return;
             branchTarget = true;
 bb_1:
   /*$4CAF*/ CYCLES(0x4caf, 52);
@@ -1260,8 +1352,8 @@ bb_1:
               goto bb_1;
 bb_2:
   /*$4CCD*/ CYCLES(0x4ccd, 6);
-            func_4c6e(0x0000);
-            if (ret_addr) pop16(); return;
+            func_4c6e(0x0000); if (s_native_depth <= depth) return;
+            native_return(ret_addr); return;
 }
 
 
@@ -1270,15 +1362,14 @@ void func_4cd0(uint16_t ret_addr) {
   uint8_t tmp1_U8;
   uint8_t tmp2_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$4CD0*/ CYCLES(0x4cd0, 12);
             tmp1_U8 = s_x;
             ram_poke(0x00fc, tmp1_U8);
   /*$4CD2*/ ram_poke(0x00fe, tmp1_U8);
-  /*$4CD4*/ func_4c1c(0xfffe);
+  /*$4CD4*/ func_4c1c(0xfffe); if (s_native_depth <= depth) return;
   /*$4CD7*/ CYCLES(0x4cd7, 9);
             ram_poke(0x0004, s_a);
   /*$4CD9*/ s_y = (uint8_t)(s_y - 0x01);
@@ -1302,8 +1393,8 @@ bb_1:
               goto bb_1;
 bb_2:
   /*$4CF3*/ CYCLES(0x4cf3, 6);
-            func_4c6e(0x0000);
-            if (ret_addr) pop16(); return;
+            func_4c6e(0x0000); if (s_native_depth <= depth) return;
+            native_return(ret_addr); return;
 }
 
 
@@ -1313,12 +1404,11 @@ void func_4cf6(uint16_t ret_addr) {
   uint8_t tmp2_U8;
   uint8_t tmp3_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$4CF6*/ CYCLES(0x4cf6, 6);
-            func_4c7c(0xfffe);
+            func_4c7c(0xfffe); if (s_native_depth <= depth) return;
             branchTarget = true;
 bb_1:
   /*$4CF9*/ CYCLES(0x4cf9, 63);
@@ -1346,8 +1436,8 @@ bb_1:
               goto bb_1;
 bb_2:
   /*$4D1E*/ CYCLES(0x4d1e, 6);
-            func_4c6e(0x0000);
-            if (ret_addr) pop16(); return;
+            func_4c6e(0x0000); if (s_native_depth <= depth) return;
+            native_return(ret_addr); return;
 }
 
 
@@ -1356,15 +1446,14 @@ void func_4d21(uint16_t ret_addr) {
   uint8_t tmp1_U8;
   uint8_t tmp2_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$4D21*/ CYCLES(0x4d21, 12);
             tmp1_U8 = s_x;
             ram_poke(0x00fc, tmp1_U8);
   /*$4D23*/ ram_poke(0x00fe, tmp1_U8);
-  /*$4D25*/ func_4c1c(0xfffe);
+  /*$4D25*/ func_4c1c(0xfffe); if (s_native_depth <= depth) return;
   /*$4D28*/ CYCLES(0x4d28, 9);
             ram_poke(0x0004, s_a);
   /*$4D2A*/ s_y = (uint8_t)(s_y - 0x01);
@@ -1389,8 +1478,8 @@ bb_1:
               goto bb_1;
 bb_2:
   /*$4D47*/ CYCLES(0x4d47, 6);
-            func_4c6e(0x0000);
-            if (ret_addr) pop16(); return;
+            func_4c6e(0x0000); if (s_native_depth <= depth) return;
+            native_return(ret_addr); return;
 }
 
 
@@ -1399,8 +1488,7 @@ void func_4da2(uint16_t ret_addr) {
   uint8_t tmp1_U8;
   uint8_t tmp2_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$4DA2*/ CYCLES(0x4da2, 24);
@@ -1422,7 +1510,7 @@ bb_1:
               goto bb_1;
 bb_2:
   /*$4DB6*/ CYCLES(0x4db6, 6);
-            func_4c6e(0xfffe);
+            func_4c6e(0xfffe); if (s_native_depth <= depth) return;
   /*$4DB9*/ CYCLES(0x4db9, 9);
             s_y = 0x27;
   /*$4DBB*/ s_a = ram_peek((0x0780 + s_x));
@@ -1437,7 +1525,7 @@ bb_3:
               goto bb_3;
 bb_4:
   /*$4DC4*/ CYCLES(0x4dc4, 6);
-            func_4c6e(0xfffe);
+            func_4c6e(0xfffe); if (s_native_depth <= depth) return;
   /*$4DC7*/ CYCLES(0x4dc7, 4);
             s_y = 0xff;
 bb_5:
@@ -1449,9 +1537,9 @@ bb_5:
               goto bb_5;
 bb_6:
   /*$4DCC*/ CYCLES(0x4dcc, 6);
-            func_4c6e(0xfffe);
+            func_4c6e(0xfffe); if (s_native_depth <= depth) return;
   /*$4DCF*/ CYCLES(0x4dcf, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
@@ -1460,8 +1548,7 @@ void func_4dd0(uint16_t ret_addr) {
   uint16_t tmp1_U16;
   uint8_t tmp2_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$4DD0*/ CYCLES(0x4dd0, 82);
@@ -1482,17 +1569,17 @@ bb_0:
 bb_1:
   /*$4E00*/ CYCLES(0x4e00, 11);
             ram_poke(0x1509, (uint8_t)(ram_peek(0x1509) + 0x01));
-  /*$4E03*/ func_4e4f(0xfffe);
+  /*$4E03*/ func_4e4f(0xfffe); if (s_native_depth <= depth) return;
   /*$4E06*/ CYCLES(0x4e06, 43);
   /*$4E0A*/ tmp1_U16 = ram_peek(0x150d) + ram_peek(0x0c10);
   /*$4E0D*/ ram_poke(0x150d, ((uint8_t)tmp1_U16));
   /*$4E16*/ ram_poke(0x150e, (uint8_t)((ram_peek(0x150e) + ram_peek(0x0c11)) + (uint8_t)(tmp1_U16 >> 8)));
   /*$4E1C*/ ram_poke(0x1430, ram_peek(0x0c69));
-            func_4e1f(0x0000);
-            if (ret_addr) pop16(); return;
+            func_4e1f(0x0000); if (s_native_depth <= depth) return;
+            native_return(ret_addr); return;
 bb_2:
-  /*$4DFE*/ func_4e1f(0x0000);
-            if (ret_addr) pop16(); return;
+  /*$4DFE*/ func_4e1f(0x0000); if (s_native_depth <= depth) return;
+            native_return(ret_addr); return;
 }
 
 
@@ -1502,8 +1589,7 @@ void func_4e1f(uint16_t ret_addr) {
   uint16_t tmp2_U16;
   uint16_t tmp3_U16;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$4E1F*/ CYCLES(0x4e1f, 33);
@@ -1515,12 +1601,12 @@ bb_0:
   /*$4E30*/ ram_poke(0x0002, tmp1_U8);
 bb_1:
   /*$4E32*/ CYCLES(0x4e32, 6);
-            func_4ec4(0xfffe);
+            func_4ec4(0xfffe); if (s_native_depth <= depth) return;
   /*$4E35*/ CYCLES(0x4e35, 18);
   /*$4E36*/ s_a = (uint8_t)(s_a + 0x00b0);
   /*$4E38*/ s_x = 0x27;
   /*$4E3A*/ s_y = ram_peek(0x00fc);
-  /*$4E3C*/ func_5108(0xfffe);
+  /*$4E3C*/ func_5108(0xfffe); if (s_native_depth <= depth) return;
   /*$4E3F*/ CYCLES(0x4e3f, 26);
   /*$4E42*/ tmp2_U16 = ram_peek(0x00fc);
             tmp3_U16 = tmp2_U16 - 0x0008;
@@ -1536,7 +1622,7 @@ bb_1:
               goto bb_1;
 bb_2:
   /*$4E4E*/ CYCLES(0x4e4e, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
@@ -1545,8 +1631,7 @@ void func_4e4f(uint16_t ret_addr) {
   uint8_t tmp1_U8;
   uint8_t tmp2_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$4E4F*/ CYCLES(0x4e4f, 57);
@@ -1603,7 +1688,7 @@ bb_4:
               goto bb_1;
 bb_5:
   /*$4EA6*/ CYCLES(0x4ea6, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 bb_6:
   /*$4EA7*/ CYCLES(0x4ea7, 11);
             tmp1_U8 = ram_peek(0x00fc);
@@ -1631,7 +1716,7 @@ bb_8:
               goto bb_8;
 bb_9:
   /*$4EC3*/ CYCLES(0x4ec3, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
@@ -1640,8 +1725,7 @@ void func_4ec4(uint16_t ret_addr) {
   uint16_t tmp1_U16;
   uint8_t tmp2_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$4EC4*/ CYCLES(0x4ec4, 18);
@@ -1687,7 +1771,7 @@ bb_4:
   /*$4EE6*/ ram_poke(0x0000, ram_peek(0x0003));
   /*$4EEA*/ ram_poke(0x0001, ram_peek(0x0004));
   /*$4EEE*/ ram_poke(0x0002, ram_peek(0x0005));
-  /*$4EF0*/ if (ret_addr) pop16(); return;
+  /*$4EF0*/ native_return(ret_addr); return;
 }
 
 
@@ -1696,13 +1780,12 @@ void func_4ef1(uint16_t ret_addr) {
   uint8_t tmp1_U8;
   uint8_t tmp2_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$4EF1*/ CYCLES(0x4ef1, 12);
   /*$4EF3*/ ram_poke(0x0000, 0x06);
-  /*$4EF5*/ func_4c36(0xfffe);
+  /*$4EF5*/ func_4c36(0xfffe); if (s_native_depth <= depth) return;
   /*$4EF8*/ CYCLES(0x4ef8, 14);
             ram_poke(0x00ca, s_a);
   /*$4EFA*/ s_y = 0x00;
@@ -1718,7 +1801,7 @@ bb_1:
   /*$4F08*/ s_x = 0x20;
 bb_2:
   /*$4F0A*/ CYCLES(0x4f0a, 6);
-            func_4c36(0xfffe);
+            func_4c36(0xfffe); if (s_native_depth <= depth) return;
   /*$4F0D*/ CYCLES(0x4f0d, 4);
             ram_poke(0x00cb, s_a);
 bb_3:
@@ -1726,7 +1809,7 @@ bb_3:
             tmp1_U8 = s_y;
             tmp2_U8 = peek((ram_peek16al(0x0006) + tmp1_U8));
   /*$4F13*/ poke((ram_peek16al(0x0006) + tmp1_U8), (tmp2_U8 ^ 0xff));
-  /*$4F15*/ func_4c6e(0xfffe);
+  /*$4F15*/ func_4c6e(0xfffe); if (s_native_depth <= depth) return;
   /*$4F18*/ CYCLES(0x4f18, 6);
             tmp1_U8 = (uint8_t)(tmp1_U8 + 0x01);
             s_y = tmp1_U8;
@@ -1750,7 +1833,7 @@ bb_5:
               goto bb_1;
 bb_6:
   /*$4F24*/ CYCLES(0x4f24, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
@@ -1758,8 +1841,7 @@ void func_4f25(uint16_t ret_addr) {
   bool branchTarget = true;
   uint8_t tmp1_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$4F25*/ CYCLES(0x4f25, 31);
@@ -1791,7 +1873,7 @@ bb_2:
               goto bb_1;
 bb_3:
   /*$4F41*/ CYCLES(0x4f41, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
@@ -1801,16 +1883,15 @@ void func_4f42(uint16_t ret_addr) {
   uint16_t tmp2_U16;
   uint8_t tmp3_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$4F42*/ CYCLES(0x4f42, 6);
-            func_4f25(0xfffe);
+            func_4f25(0xfffe); if (s_native_depth <= depth) return;
   /*$4F45*/ CYCLES(0x4f45, 6);
-            func_4e1f(0xfffe);
+            func_4e1f(0xfffe); if (s_native_depth <= depth) return;
   /*$4F48*/ CYCLES(0x4f48, 6);
-            func_4e4f(0xfffe);
+            func_4e4f(0xfffe); if (s_native_depth <= depth) return;
   /*$4F4B*/ CYCLES(0x4f4b, 28);
   /*$4F4F*/ ram_poke(0x0000, (uint8_t)(ram_peek(0x1407) + 0x01));
   /*$4F53*/ ram_poke(0x0001, 0x00);
@@ -1819,12 +1900,12 @@ bb_0:
   /*$4F59*/ ram_poke(0x00fc, 0xb8);
 bb_1:
   /*$4F5B*/ CYCLES(0x4f5b, 6);
-            func_4ec4(0xfffe);
+            func_4ec4(0xfffe); if (s_native_depth <= depth) return;
   /*$4F5E*/ CYCLES(0x4f5e, 18);
   /*$4F5F*/ s_a = (uint8_t)(s_a + 0x00b0);
   /*$4F61*/ s_y = ram_peek(0x00fc);
   /*$4F63*/ s_x = 0x27;
-  /*$4F65*/ func_5108(0xfffe);
+  /*$4F65*/ func_5108(0xfffe); if (s_native_depth <= depth) return;
   /*$4F68*/ CYCLES(0x4f68, 19);
   /*$4F6B*/ tmp1_U16 = ram_peek(0x00fc);
             tmp2_U16 = tmp1_U16 - 0x0008;
@@ -1838,7 +1919,7 @@ bb_1:
               goto bb_1;
 bb_2:
   /*$4F73*/ CYCLES(0x4f73, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
@@ -1850,12 +1931,11 @@ void func_4fcd(uint16_t ret_addr) {
   uint8_t tmp4_U8;
   uint8_t tmp5_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$4FCD*/ CYCLES(0x4fcd, 6);
-            func_4c7c(0xfffe);
+            func_4c7c(0xfffe); if (s_native_depth <= depth) return;
             branchTarget = true;
 bb_1:
   /*$4FD0*/ CYCLES(0x4fd0, 74);
@@ -1888,8 +1968,8 @@ bb_1:
               goto bb_1;
 bb_2:
   /*$4FFB*/ CYCLES(0x4ffb, 6);
-            func_4c6e(0x0000);
-            if (ret_addr) pop16(); return;
+            func_4c6e(0x0000); if (s_native_depth <= depth) return;
+            native_return(ret_addr); return;
 }
 
 
@@ -1901,12 +1981,11 @@ void func_4ffe(uint16_t ret_addr) {
   uint8_t tmp4_U8;
   uint8_t tmp5_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$4FFE*/ CYCLES(0x4ffe, 6);
-            func_4c7c(0xfffe);
+            func_4c7c(0xfffe); if (s_native_depth <= depth) return;
             branchTarget = true;
 bb_1:
   /*$5001*/ CYCLES(0x5001, 70);
@@ -1938,8 +2017,8 @@ bb_1:
               goto bb_1;
 bb_2:
   /*$502A*/ CYCLES(0x502a, 6);
-            func_4c6e(0x0000);
-            if (ret_addr) pop16(); return;
+            func_4c6e(0x0000); if (s_native_depth <= depth) return;
+            native_return(ret_addr); return;
 }
 
 
@@ -1950,12 +2029,11 @@ void func_502d(uint16_t ret_addr) {
   uint8_t tmp3_U8;
   uint8_t tmp4_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$502D*/ CYCLES(0x502d, 6);
-            func_4c7c(0xfffe);
+            func_4c7c(0xfffe); if (s_native_depth <= depth) return;
             branchTarget = true;
 bb_1:
   /*$5030*/ CYCLES(0x5030, 65);
@@ -1983,8 +2061,8 @@ bb_1:
               goto bb_1;
 bb_2:
   /*$5056*/ CYCLES(0x5056, 6);
-            func_4c6e(0x0000);
-            if (ret_addr) pop16(); return;
+            func_4c6e(0x0000); if (s_native_depth <= depth) return;
+            native_return(ret_addr); return;
 }
 
 
@@ -1995,12 +2073,11 @@ void func_5059(uint16_t ret_addr) {
   uint8_t tmp3_U8;
   uint8_t tmp4_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$5059*/ CYCLES(0x5059, 6);
-            func_4c7c(0xfffe);
+            func_4c7c(0xfffe); if (s_native_depth <= depth) return;
             branchTarget = true;
 bb_1:
   /*$505C*/ CYCLES(0x505c, 58);
@@ -2028,8 +2105,8 @@ bb_1:
               goto bb_1;
 bb_2:
   /*$507E*/ CYCLES(0x507e, 6);
-            func_4c6e(0x0000);
-            if (ret_addr) pop16(); return;
+            func_4c6e(0x0000); if (s_native_depth <= depth) return;
+            native_return(ret_addr); return;
 }
 
 
@@ -2037,8 +2114,7 @@ void func_5081(uint16_t ret_addr) {
   bool branchTarget = true;
   uint8_t tmp1_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$5081*/ CYCLES(0x5081, 55);
@@ -2054,7 +2130,7 @@ bb_0:
   /*$509B*/ s_y = 0x03;
   /*$509C*/ tmp1_U8 = peek((ram_peek16al(0x0006) + 0x0003));
   /*$509E*/ ram_poke(0x00e9, tmp1_U8);
-  /*$50A0*/ if (ret_addr) pop16(); return;
+  /*$50A0*/ native_return(ret_addr); return;
 }
 
 
@@ -2063,8 +2139,7 @@ void func_50a1(uint16_t ret_addr) {
   uint8_t tmp1_U8;
   uint8_t tmp2_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$50A1*/ CYCLES(0x50a1, 18);
@@ -2078,7 +2153,7 @@ bb_1:
   /*$50AF*/ s_x = 0x07;
 bb_2:
   /*$50B1*/ CYCLES(0x50b1, 6);
-            func_4c36(0xfffe);
+            func_4c36(0xfffe); if (s_native_depth <= depth) return;
   /*$50B4*/ CYCLES(0x50b4, 12);
   /*$50B6*/ ram_poke(0x0006, (uint8_t)((ram_peek(0x0006) << 0x01) | (s_a >= ram_peek(0x000a))));
   /*$50B8*/ tmp1_U8 = (uint8_t)(s_x - 0x01);
@@ -2101,7 +2176,7 @@ bb_3:
               goto bb_1;
 bb_4:
   /*$50C4*/ CYCLES(0x50c4, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
@@ -2110,13 +2185,12 @@ void func_50c5(uint16_t ret_addr) {
   uint8_t tmp1_U8;
   uint8_t tmp2_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$50C5*/ CYCLES(0x50c5, 9);
             s_y = 0x00;
-  /*$50C7*/ func_50a1(0xfffe);
+  /*$50C7*/ func_50a1(0xfffe); if (s_native_depth <= depth) return;
   /*$50CA*/ CYCLES(0x50ca, 35);
             tmp1_U8 = ram_peek(0x0c5b);
   /*$50CD*/ ram_poke(0x00fc, tmp1_U8);
@@ -2169,7 +2243,7 @@ bb_5:
               goto bb_1;
 bb_6:
   /*$5107*/ CYCLES(0x5107, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
@@ -2180,8 +2254,7 @@ void func_5108(uint16_t ret_addr) {
   uint16_t tmp3_U16;
   uint8_t tmp4_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$5108*/ CYCLES(0x5108, 35);
@@ -2214,7 +2287,7 @@ bb_1:
               goto bb_1;
 bb_2:
   /*$512E*/ CYCLES(0x512e, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
@@ -2222,8 +2295,7 @@ void func_51e8(uint16_t ret_addr) {
   bool branchTarget = true;
   uint8_t tmp1_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$51E8*/ CYCLES(0x51e8, 7);
@@ -2240,15 +2312,14 @@ bb_2:
             s_y = 0x00;
   /*$51F0*/ tmp1_U8 = peek(ram_peek16al(0x0022));
             s_a = tmp1_U8;
-  /*$51F2*/ if (ret_addr) pop16(); return;
+  /*$51F2*/ native_return(ret_addr); return;
 }
 
 
 void func_5200(uint16_t ret_addr) {
   bool branchTarget = true;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$5200*/ CYCLES(0x5200, 6);
@@ -2262,7 +2333,7 @@ bb_0:
   /*$5224*/ ram_poke(0x1506, 0x00);
   /*$5227*/ ram_poke(0x1507, 0x00);
   /*$522A*/ ram_poke(0x1508, 0x00);
-  /*$522D*/ if (ret_addr) pop16(); return;
+  /*$522D*/ native_return(ret_addr); return;
 }
 
 
@@ -2273,8 +2344,7 @@ void func_5209(uint16_t ret_addr) {
   uint16_t tmp3_U16;
   uint16_t tmp4_U16;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$5209*/ CYCLES(0x5209, 6);
@@ -2284,7 +2354,7 @@ bb_0:
               goto bb_2;
 bb_1:
   /*$53F1*/ CYCLES(0x53f1, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 bb_2:
   /*$53F2*/ CYCLES(0x53f2, 9);
             tmp1_U8 = (uint8_t)(ram_peek(0x1401) - 0x01);
@@ -2327,7 +2397,7 @@ bb_6:
             tmp4_U16 = tmp3_U16 + 0x000b;
             s_status_v = ovf8((uint8_t)tmp4_U16, (uint8_t)tmp3_U16, (uint8_t)0x000b);
             s_a = ((uint8_t)tmp4_U16);
-  /*$5422*/ func_4c1c(0xfffe);
+  /*$5422*/ func_4c1c(0xfffe); if (s_native_depth <= depth) return;
   /*$5425*/ CYCLES(0x5425, 9);
             ram_poke((0x1520 + s_y), s_a);
   /*$5428*/ s_a = 0xff;
@@ -2349,7 +2419,7 @@ bb_9:
             s_status_c = (uint8_t)(tmp3_U16 >> 8);
             s_status_v = ovf8((uint8_t)tmp3_U16, (uint8_t)tmp4_U16, (uint8_t)0x0005);
   /*$5438*/ ram_poke((0x1510 + s_y), ((uint8_t)tmp3_U16));
-  /*$543B*/ if (ret_addr) pop16(); return;
+  /*$543B*/ native_return(ret_addr); return;
 bb_10:
   /*$543C*/ CYCLES(0x543c, 7);
             branchTarget = true;
@@ -2361,7 +2431,7 @@ bb_11:
             tmp4_U16 = tmp3_U16 - 0x0004;
             s_status_v = ovf8((uint8_t)tmp4_U16, (uint8_t)tmp3_U16, (uint8_t)0xfffb);
             s_a = ((uint8_t)tmp4_U16);
-  /*$5446*/ func_4c1c(0xfffe);
+  /*$5446*/ func_4c1c(0xfffe); if (s_native_depth <= depth) return;
   /*$5449*/ CYCLES(0x5449, 11);
             ram_poke((0x1520 + s_y), s_a);
             branchTarget = true;
@@ -2409,7 +2479,7 @@ bb_17:
             s_a = tmp1_U8;
   /*$5474*/ tmp2_U8 = s_y;
             ram_poke((0x1510 + tmp2_U8), tmp1_U8);
-  /*$5477*/ func_4c1c(0xfffe);
+  /*$5477*/ func_4c1c(0xfffe); if (s_native_depth <= depth) return;
   /*$547A*/ CYCLES(0x547a, 21);
             ram_poke(0x0000, s_x);
   /*$547F*/ tmp1_U8 = (uint8_t)(0x0006 - ram_peek(0x0000));
@@ -2428,7 +2498,7 @@ bb_19:
             tmp4_U16 = tmp3_U16 - 0x0004;
             s_status_v = ovf8((uint8_t)tmp4_U16, (uint8_t)tmp3_U16, (uint8_t)0xfffb);
             s_a = ((uint8_t)tmp4_U16);
-  /*$5490*/ func_4c1c(0xfffe);
+  /*$5490*/ func_4c1c(0xfffe); if (s_native_depth <= depth) return;
   /*$5493*/ CYCLES(0x5493, 26);
             tmp1_U8 = s_a;
             ram_poke(0x0000, tmp1_U8);
@@ -2443,7 +2513,7 @@ bb_20:
             tmp3_U16 = tmp4_U16 + 0x0003;
             s_status_v = ovf8((uint8_t)tmp3_U16, (uint8_t)tmp4_U16, (uint8_t)0x0003);
             s_a = ((uint8_t)tmp3_U16);
-  /*$54A8*/ func_4c1c(0xfffe);
+  /*$54A8*/ func_4c1c(0xfffe); if (s_native_depth <= depth) return;
   /*$54AB*/ CYCLES(0x54ab, 11);
             ram_poke((0x1520 + s_y), s_a);
   /*$54AE*/ s_a = 0x00;
@@ -2461,7 +2531,7 @@ bb_21:
 bb_22:
   /*$54B5*/ CYCLES(0x54b5, 7);
             ram_poke((0x1550 + s_y), s_a);
-  /*$54B8*/ if (ret_addr) pop16(); return;
+  /*$54B8*/ native_return(ret_addr); return;
 bb_23:
   /*$54B9*/ CYCLES(0x54b9, 7);
             branchTarget = true;
@@ -2469,7 +2539,7 @@ bb_23:
               goto bb_25;
 bb_24:
   /*$54BD*/ CYCLES(0x54bd, 6);
-            func_54dd(0xfffe);
+            func_54dd(0xfffe); if (s_native_depth <= depth) return;
   /*$54C0*/ CYCLES(0x54c0, 6);
             branchTarget = true;
             goto bb_30;
@@ -2480,7 +2550,7 @@ bb_25:
               goto bb_27;
 bb_26:
   /*$54C7*/ CYCLES(0x54c7, 6);
-            func_54dd(0xfffe);
+            func_54dd(0xfffe); if (s_native_depth <= depth) return;
   /*$54CA*/ CYCLES(0x54ca, 6);
             branchTarget = true;
             goto bb_31;
@@ -2491,13 +2561,13 @@ bb_27:
               goto bb_29;
 bb_28:
   /*$54D1*/ CYCLES(0x54d1, 6);
-            func_54e5(0xfffe);
+            func_54e5(0xfffe); if (s_native_depth <= depth) return;
   /*$54D4*/ CYCLES(0x54d4, 6);
             branchTarget = true;
             goto bb_30;
 bb_29:
   /*$54D7*/ CYCLES(0x54d7, 6);
-            func_54e5(0xfffe);
+            func_54e5(0xfffe); if (s_native_depth <= depth) return;
   /*$54DA*/ CYCLES(0x54da, 6);
             branchTarget = true;
             goto bb_31;
@@ -2507,15 +2577,15 @@ bb_30:
             tmp4_U16 = tmp3_U16 + 0x0009;
             s_status_v = ovf8((uint8_t)tmp4_U16, (uint8_t)tmp3_U16, (uint8_t)0x0009);
             s_a = ((uint8_t)tmp4_U16);
-            func_54f5(0x0000);
-            if (ret_addr) pop16(); return;
+            func_54f5(0x0000); if (s_native_depth <= depth) return;
+            native_return(ret_addr); return;
 bb_31:
   /*$5506*/ CYCLES(0x5506, 16);
   /*$550A*/ tmp4_U16 = ram_peek(0x1500);
             tmp3_U16 = tmp4_U16 - 0x0002;
             s_status_v = ovf8((uint8_t)tmp3_U16, (uint8_t)tmp4_U16, (uint8_t)0xfffd);
             s_a = ((uint8_t)tmp3_U16);
-  /*$550C*/ func_54f5(0xfffe);
+  /*$550C*/ func_54f5(0xfffe); if (s_native_depth <= depth) return;
   /*$550F*/ CYCLES(0x550f, 6);
             tmp1_U8 = s_a & 0x01;
             s_status_c = tmp1_U8;
@@ -2531,7 +2601,7 @@ bb_32:
   /*$5519*/ ram_poke((0x1550 + tmp1_U8), 0x40);
 bb_33:
   /*$551C*/ CYCLES(0x551c, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
@@ -2540,8 +2610,7 @@ void func_54dd(uint16_t ret_addr) {
   uint16_t tmp1_U16;
   uint8_t tmp2_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$54DD*/ CYCLES(0x54dd, 14);
@@ -2555,10 +2624,10 @@ bb_0:
 bb_1:
   /*$54EB*/ CYCLES(0x54eb, 7);
             ram_poke((0x1510 + s_y), s_a);
-  /*$54EE*/ if (ret_addr) pop16(); return;
+  /*$54EE*/ native_return(ret_addr); return;
 bb_2:
-  /*$54E3*/ func_54e5(0x0000);
-            if (ret_addr) pop16(); return;
+  /*$54E3*/ func_54e5(0x0000); if (s_native_depth <= depth) return;
+            native_return(ret_addr); return;
 }
 
 
@@ -2568,8 +2637,7 @@ void func_54e5(uint16_t ret_addr) {
   uint16_t tmp2_U16;
   uint8_t tmp3_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$54E5*/ CYCLES(0x54e5, 11);
@@ -2583,7 +2651,7 @@ bb_0:
             s_a = tmp3_U8;
   /*$54EB*/ CYCLES(0x54eb, 7);
             ram_poke((0x1510 + s_y), tmp3_U8);
-  /*$54EE*/ if (ret_addr) pop16(); return;
+  /*$54EE*/ native_return(ret_addr); return;
 }
 
 
@@ -2593,12 +2661,11 @@ void func_54f5(uint16_t ret_addr) {
   uint8_t tmp2_U8;
   uint8_t tmp3_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$54F5*/ CYCLES(0x54f5, 6);
-            func_4c1c(0xfffe);
+            func_4c1c(0xfffe); if (s_native_depth <= depth) return;
   /*$54F8*/ CYCLES(0x54f8, 11);
             ram_poke((0x1520 + s_y), s_a);
   /*$54FB*/ s_a = 0x00;
@@ -2619,7 +2686,7 @@ bb_1:
 bb_2:
   /*$5502*/ CYCLES(0x5502, 7);
             ram_poke((0x1550 + s_y), s_a);
-  /*$5505*/ if (ret_addr) pop16(); return;
+  /*$5505*/ native_return(ret_addr); return;
 }
 
 
@@ -2629,8 +2696,7 @@ void func_5837(uint16_t ret_addr) {
   uint8_t tmp2_U8;
   uint8_t tmp3_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$5837*/ CYCLES(0x5837, 52);
@@ -2646,7 +2712,7 @@ bb_0:
             s_y = tmp2_U8;
   /*$5850*/ tmp3_U8 = peek((ram_peek16al(0x0006) + tmp2_U8));
   /*$5852*/ poke((ram_peek16al(0x0006) + tmp2_U8), ((ram_peek((0x1550 + tmp1_U8)) ^ 0xff) & tmp3_U8));
-  /*$5854*/ if (ret_addr) pop16(); return;
+  /*$5854*/ native_return(ret_addr); return;
 }
 
 
@@ -2655,8 +2721,7 @@ void func_5855(uint16_t ret_addr) {
   uint8_t tmp1_U8;
   uint8_t tmp2_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$5855*/ CYCLES(0x5855, 36);
@@ -2685,8 +2750,8 @@ bb_1:
               goto bb_1;
 bb_2:
   /*$5880*/ CYCLES(0x5880, 6);
-            func_4c6e(0x0000);
-            if (ret_addr) pop16(); return;
+            func_4c6e(0x0000); if (s_native_depth <= depth) return;
+            native_return(ret_addr); return;
 }
 
 
@@ -2697,8 +2762,7 @@ void func_5883(uint16_t ret_addr) {
   uint8_t tmp3_U8;
   uint16_t tmp4_U16;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$5883*/ CYCLES(0x5883, 35);
@@ -2739,8 +2803,8 @@ bb_2:
 bb_3:
   /*$58B3*/ CYCLES(0x58b3, 11);
   /*$58B5*/ s_y = (uint8_t)(ram_peek(0x0005) + 0x01);
-  /*$58B6*/ func_4c6e(0x0000);
-            if (ret_addr) pop16(); return;
+  /*$58B6*/ func_4c6e(0x0000); if (s_native_depth <= depth) return;
+            native_return(ret_addr); return;
 }
 
 
@@ -2750,8 +2814,7 @@ void func_58b9(uint16_t ret_addr) {
   uint8_t tmp2_U8;
   uint8_t tmp3_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$58B9*/ CYCLES(0x58b9, 35);
@@ -2793,8 +2856,8 @@ bb_2:
 bb_3:
   /*$58E8*/ CYCLES(0x58e8, 11);
   /*$58EA*/ s_y = (uint8_t)(ram_peek(0x0005) + 0x01);
-  /*$58EB*/ func_4c6e(0x0000);
-            if (ret_addr) pop16(); return;
+  /*$58EB*/ func_4c6e(0x0000); if (s_native_depth <= depth) return;
+            native_return(ret_addr); return;
 }
 
 
@@ -2805,8 +2868,7 @@ void func_58ee(uint16_t ret_addr) {
   uint8_t tmp3_U8;
   uint16_t tmp4_U16;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$58EE*/ CYCLES(0x58ee, 35);
@@ -2846,8 +2908,8 @@ bb_2:
 bb_3:
   /*$591E*/ CYCLES(0x591e, 11);
   /*$5920*/ s_y = (uint8_t)(ram_peek(0x0005) - 0x01);
-  /*$5921*/ func_4c6e(0x0000);
-            if (ret_addr) pop16(); return;
+  /*$5921*/ func_4c6e(0x0000); if (s_native_depth <= depth) return;
+            native_return(ret_addr); return;
 }
 
 
@@ -2857,8 +2919,7 @@ void func_5924(uint16_t ret_addr) {
   uint8_t tmp2_U8;
   uint8_t tmp3_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$5924*/ CYCLES(0x5924, 35);
@@ -2899,8 +2960,8 @@ bb_2:
 bb_3:
   /*$5953*/ CYCLES(0x5953, 11);
   /*$5955*/ s_y = (uint8_t)(ram_peek(0x0005) - 0x01);
-  /*$5956*/ func_4c6e(0x0000);
-            if (ret_addr) pop16(); return;
+  /*$5956*/ func_4c6e(0x0000); if (s_native_depth <= depth) return;
+            native_return(ret_addr); return;
 }
 
 
@@ -2911,8 +2972,7 @@ void func_598d(uint16_t ret_addr) {
   uint16_t tmp3_U16;
   uint16_t tmp4_U16;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$598D*/ CYCLES(0x598d, 4);
@@ -2940,7 +3000,7 @@ bb_2:
             s_status_c = (uint8_t)(tmp4_U16 >> 8);
             s_status_v = ovf8((uint8_t)tmp4_U16, (uint8_t)tmp2_U16, (uint8_t)tmp3_U16);
   /*$59A7*/ ram_poke(0x001d, ((uint8_t)tmp4_U16));
-  /*$59A9*/ if (ret_addr) pop16(); return;
+  /*$59A9*/ native_return(ret_addr); return;
 }
 
 
@@ -2952,8 +3012,7 @@ void func_5a00(uint16_t ret_addr) {
   uint16_t tmp4_U16;
   uint8_t tmp5_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$5A00*/ CYCLES(0x5a00, 6);
@@ -2973,7 +3032,7 @@ bb_2:
   /*$5A3B*/ CYCLES(0x5a3b, 14);
             s_a = ram_peek(0x1407);
   /*$5A3E*/ s_x = 0x0a;
-  /*$5A40*/ func_4c00(0xfffe);
+  /*$5A40*/ func_4c00(0xfffe); if (s_native_depth <= depth) return;
   /*$5A43*/ CYCLES(0x5a43, 12);
             s_a = ram_peek(0x0c0c);
             branchTarget = true;
@@ -2985,10 +3044,10 @@ bb_3:
 bb_4:
   /*$5A4D*/ CYCLES(0x5a4d, 7);
             ram_poke(0x1403, s_a);
-  /*$5A50*/ if (ret_addr) pop16(); return;
+  /*$5A50*/ native_return(ret_addr); return;
 bb_5:
   /*$5A51*/ CYCLES(0x5a51, 6);
-            func_4c36(0xfffe);
+            func_4c36(0xfffe); if (s_native_depth <= depth) return;
   /*$5A54*/ CYCLES(0x5a54, 7);
             branchTarget = true;
             if ((s_a >= 0xa0))
@@ -2996,15 +3055,15 @@ bb_5:
 bb_6:
   /*$5A58*/ CYCLES(0x5a58, 9);
             s_a = 0xf5;
-  /*$5A5A*/ func_4c4b(0xfffe);
+  /*$5A5A*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
   /*$5A5D*/ CYCLES(0x5a5d, 18);
   /*$5A5F*/ ram_poke((0x1570 + s_y), (s_a & 0xfe));
   /*$5A62*/ s_a = 0x22;
-  /*$5A64*/ func_4c4b(0xfffe);
+  /*$5A64*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
   /*$5A67*/ CYCLES(0x5a67, 12);
             ram_poke(0x0000, s_a);
   /*$5A69*/ s_x = 0x00;
-  /*$5A6B*/ func_4c36(0xfffe);
+  /*$5A6B*/ func_4c36(0xfffe); if (s_native_depth <= depth) return;
   /*$5A6E*/ CYCLES(0x5a6e, 4);
             branchTarget = true;
             if (!s_status_n)
@@ -3020,15 +3079,15 @@ bb_8:
 bb_9:
   /*$5A7C*/ CYCLES(0x5a7c, 9);
             s_a = 0xb2;
-  /*$5A7E*/ func_4c4b(0xfffe);
+  /*$5A7E*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
   /*$5A81*/ CYCLES(0x5a81, 14);
             ram_poke((0x15f0 + s_y), s_a);
   /*$5A84*/ s_a = 0x45;
-  /*$5A86*/ func_4c4b(0xfffe);
+  /*$5A86*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
   /*$5A89*/ CYCLES(0x5a89, 12);
             ram_poke(0x0000, s_a);
   /*$5A8B*/ s_x = 0x00;
-  /*$5A8D*/ func_4c36(0xfffe);
+  /*$5A8D*/ func_4c36(0xfffe); if (s_native_depth <= depth) return;
   /*$5A90*/ CYCLES(0x5a90, 4);
             branchTarget = true;
             if (!s_status_n)
@@ -3041,7 +3100,7 @@ bb_11:
   /*$5A9A*/ ram_poke((0x1570 + s_y), ((uint8_t)(s_x + ram_peek(0x0000)) & 0xfe));
 bb_12:
   /*$5A9D*/ CYCLES(0x5a9d, 6);
-            func_4c36(0xfffe);
+            func_4c36(0xfffe); if (s_native_depth <= depth) return;
   /*$5AA0*/ CYCLES(0x5aa0, 29);
   /*$5AA2*/ tmp1_U8 = s_y;
             ram_poke((0x1670 + tmp1_U8), (s_a & 0x01));
@@ -3066,10 +3125,10 @@ bb_14:
               goto bb_16;
 bb_15:
   /*$5AB7*/ CYCLES(0x5ab7, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 bb_16:
   /*$5AB8*/ CYCLES(0x5ab8, 6);
-            func_4c36(0xfffe);
+            func_4c36(0xfffe); if (s_native_depth <= depth) return;
   /*$5ABB*/ CYCLES(0x5abb, 7);
             branchTarget = true;
             if ((s_a >= 0xa0))
@@ -3077,11 +3136,11 @@ bb_16:
 bb_17:
   /*$5ABF*/ CYCLES(0x5abf, 9);
             s_a = 0xe6;
-  /*$5AC1*/ func_4c4b(0xfffe);
+  /*$5AC1*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
   /*$5AC4*/ CYCLES(0x5ac4, 23);
   /*$5AC9*/ ram_poke((0x1900 + s_y), ((uint8_t)(s_a + 0x0006) | 0x01));
   /*$5ACC*/ s_x = 0x06;
-  /*$5ACE*/ func_4c36(0xfffe);
+  /*$5ACE*/ func_4c36(0xfffe); if (s_native_depth <= depth) return;
   /*$5AD1*/ CYCLES(0x5ad1, 4);
             branchTarget = true;
             if (!s_status_n)
@@ -3093,7 +3152,7 @@ bb_19:
   /*$5AD5*/ CYCLES(0x5ad5, 12);
             ram_poke(0x0000, s_x);
   /*$5AD7*/ s_a = 0x1c;
-  /*$5AD9*/ func_4c4b(0xfffe);
+  /*$5AD9*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
   /*$5ADC*/ CYCLES(0x5adc, 14);
   /*$5ADD*/ tmp5_U8 = (uint8_t)(s_a + ram_peek(0x0000));
   /*$5ADF*/ ram_poke((0x1910 + s_y), tmp5_U8);
@@ -3103,11 +3162,11 @@ bb_19:
 bb_20:
   /*$5AE4*/ CYCLES(0x5ae4, 9);
             s_a = 0xa6;
-  /*$5AE6*/ func_4c4b(0xfffe);
+  /*$5AE6*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
   /*$5AE9*/ CYCLES(0x5ae9, 19);
   /*$5AEC*/ ram_poke((0x1910 + s_y), (uint8_t)(s_a + 0x0006));
   /*$5AEF*/ s_x = 0x06;
-  /*$5AF1*/ func_4c36(0xfffe);
+  /*$5AF1*/ func_4c36(0xfffe); if (s_native_depth <= depth) return;
   /*$5AF4*/ CYCLES(0x5af4, 4);
             branchTarget = true;
             if (!s_status_n)
@@ -3119,18 +3178,18 @@ bb_22:
   /*$5AF8*/ CYCLES(0x5af8, 12);
             ram_poke(0x0000, s_x);
   /*$5AFA*/ s_a = 0x2c;
-  /*$5AFC*/ func_4c4b(0xfffe);
+  /*$5AFC*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
   /*$5AFF*/ CYCLES(0x5aff, 14);
   /*$5B04*/ ram_poke((0x1900 + s_y), ((uint8_t)(s_a + ram_peek(0x0000)) | 0x01));
 bb_23:
   /*$5B07*/ CYCLES(0x5b07, 6);
-            func_4c36(0xfffe);
+            func_4c36(0xfffe); if (s_native_depth <= depth) return;
   /*$5B0A*/ CYCLES(0x5b0a, 29);
   /*$5B0C*/ tmp5_U8 = s_y;
             ram_poke((0x1920 + tmp5_U8), (s_a & 0x01));
   /*$5B12*/ ram_poke((0x1930 + tmp5_U8), (tmp5_U8 & 0x03));
   /*$5B15*/ s_a = ram_peek(0x0c0e);
-  /*$5B18*/ func_4c4b(0xfffe);
+  /*$5B18*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
   /*$5B1B*/ CYCLES(0x5b1b, 19);
   /*$5B1C*/ tmp4_U16 = s_a;
             tmp3_U16 = tmp4_U16 + 0x0003;
@@ -3148,8 +3207,7 @@ void func_5a03(uint16_t ret_addr) {
   uint16_t tmp3_U16;
   uint8_t tmp4_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$5A03*/ CYCLES(0x5a03, 6);
@@ -3164,10 +3222,10 @@ bb_1:
               goto bb_3;
 bb_2:
   /*$5AB7*/ CYCLES(0x5ab7, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 bb_3:
   /*$5AB8*/ CYCLES(0x5ab8, 6);
-            func_4c36(0xfffe);
+            func_4c36(0xfffe); if (s_native_depth <= depth) return;
   /*$5ABB*/ CYCLES(0x5abb, 7);
             branchTarget = true;
             if ((s_a >= 0xa0))
@@ -3175,11 +3233,11 @@ bb_3:
 bb_4:
   /*$5ABF*/ CYCLES(0x5abf, 9);
             s_a = 0xe6;
-  /*$5AC1*/ func_4c4b(0xfffe);
+  /*$5AC1*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
   /*$5AC4*/ CYCLES(0x5ac4, 23);
   /*$5AC9*/ ram_poke((0x1900 + s_y), ((uint8_t)(s_a + 0x0006) | 0x01));
   /*$5ACC*/ s_x = 0x06;
-  /*$5ACE*/ func_4c36(0xfffe);
+  /*$5ACE*/ func_4c36(0xfffe); if (s_native_depth <= depth) return;
   /*$5AD1*/ CYCLES(0x5ad1, 4);
             branchTarget = true;
             if (!s_status_n)
@@ -3191,7 +3249,7 @@ bb_6:
   /*$5AD5*/ CYCLES(0x5ad5, 12);
             ram_poke(0x0000, s_x);
   /*$5AD7*/ s_a = 0x1c;
-  /*$5AD9*/ func_4c4b(0xfffe);
+  /*$5AD9*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
   /*$5ADC*/ CYCLES(0x5adc, 14);
   /*$5ADD*/ tmp1_U8 = (uint8_t)(s_a + ram_peek(0x0000));
   /*$5ADF*/ ram_poke((0x1910 + s_y), tmp1_U8);
@@ -3201,11 +3259,11 @@ bb_6:
 bb_7:
   /*$5AE4*/ CYCLES(0x5ae4, 9);
             s_a = 0xa6;
-  /*$5AE6*/ func_4c4b(0xfffe);
+  /*$5AE6*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
   /*$5AE9*/ CYCLES(0x5ae9, 19);
   /*$5AEC*/ ram_poke((0x1910 + s_y), (uint8_t)(s_a + 0x0006));
   /*$5AEF*/ s_x = 0x06;
-  /*$5AF1*/ func_4c36(0xfffe);
+  /*$5AF1*/ func_4c36(0xfffe); if (s_native_depth <= depth) return;
   /*$5AF4*/ CYCLES(0x5af4, 4);
             branchTarget = true;
             if (!s_status_n)
@@ -3217,18 +3275,18 @@ bb_9:
   /*$5AF8*/ CYCLES(0x5af8, 12);
             ram_poke(0x0000, s_x);
   /*$5AFA*/ s_a = 0x2c;
-  /*$5AFC*/ func_4c4b(0xfffe);
+  /*$5AFC*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
   /*$5AFF*/ CYCLES(0x5aff, 14);
   /*$5B04*/ ram_poke((0x1900 + s_y), ((uint8_t)(s_a + ram_peek(0x0000)) | 0x01));
 bb_10:
   /*$5B07*/ CYCLES(0x5b07, 6);
-            func_4c36(0xfffe);
+            func_4c36(0xfffe); if (s_native_depth <= depth) return;
   /*$5B0A*/ CYCLES(0x5b0a, 29);
   /*$5B0C*/ tmp1_U8 = s_y;
             ram_poke((0x1920 + tmp1_U8), (s_a & 0x01));
   /*$5B12*/ ram_poke((0x1930 + tmp1_U8), (tmp1_U8 & 0x03));
   /*$5B15*/ s_a = ram_peek(0x0c0e);
-  /*$5B18*/ func_4c4b(0xfffe);
+  /*$5B18*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
   /*$5B1B*/ CYCLES(0x5b1b, 19);
   /*$5B1C*/ tmp2_U16 = s_a;
             tmp3_U16 = tmp2_U16 + 0x0003;
@@ -3251,8 +3309,7 @@ void func_5a1b(uint16_t ret_addr) {
   uint16_t tmp5_U16;
   uint16_t tmp6_U16;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$5A1B*/ CYCLES(0x5a1b, 6);
@@ -3269,7 +3326,7 @@ bb_1:
               goto bb_3;
 bb_2:
   /*$5F96*/ CYCLES(0x5f96, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 bb_3:
   /*$5F97*/ CYCLES(0x5f97, 57);
             tmp1_U8 = s_x;
@@ -3331,7 +3388,7 @@ bb_8:
               goto bb_10;
 bb_9:
   /*$5FEF*/ CYCLES(0x5fef, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 bb_10:
   /*$5FF0*/ CYCLES(0x5ff0, 36);
             tmp1_U8 = s_x;
@@ -3360,8 +3417,7 @@ void func_5a1e(uint16_t ret_addr) {
   uint8_t tmp2_U8;
   uint8_t tmp3_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$5A1E*/ CYCLES(0x5a1e, 6);
@@ -3379,7 +3435,7 @@ bb_1:
               goto bb_3;
 bb_2:
   /*$5FEF*/ CYCLES(0x5fef, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 bb_3:
   /*$5FF0*/ CYCLES(0x5ff0, 36);
             tmp1_U8 = s_x;
@@ -3408,8 +3464,7 @@ void func_6200(uint16_t ret_addr) {
   uint8_t tmp1_U8;
   uint16_t tmp2_U16;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$6200*/ CYCLES(0x6200, 6);
@@ -3482,10 +3537,10 @@ bb_10:
   /*$6253*/ ram_poke(0x140f, 0x00);
   /*$6256*/ ram_poke(0x1410, 0x00);
   /*$625B*/ ram_poke(0x1414, 0xff);
-  /*$625E*/ if (ret_addr) pop16(); return;
+  /*$625E*/ native_return(ret_addr); return;
 bb_11:
   /*$625F*/ CYCLES(0x625f, 6);
-            func_4c36(0xfffe);
+            func_4c36(0xfffe); if (s_native_depth <= depth) return;
   /*$6262*/ CYCLES(0x6262, 4);
             branchTarget = true;
             if (s_status_n)
@@ -3493,11 +3548,11 @@ bb_11:
 bb_12:
   /*$6264*/ CYCLES(0x6264, 9);
             s_a = 0xf3;
-  /*$6266*/ func_4c4b(0xfffe);
+  /*$6266*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
   /*$6269*/ CYCLES(0x6269, 18);
   /*$626B*/ ram_poke((0x19c0 + s_y), (s_a | 0x01));
   /*$626E*/ s_x = 0x00;
-  /*$6270*/ func_4c36(0xfffe);
+  /*$6270*/ func_4c36(0xfffe); if (s_native_depth <= depth) return;
   /*$6273*/ CYCLES(0x6273, 4);
             branchTarget = true;
             if (!s_status_n)
@@ -3513,11 +3568,11 @@ bb_14:
 bb_15:
   /*$627E*/ CYCLES(0x627e, 9);
             s_a = 0xb3;
-  /*$6280*/ func_4c4b(0xfffe);
+  /*$6280*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
   /*$6283*/ CYCLES(0x6283, 14);
             ram_poke((0x19d0 + s_y), s_a);
   /*$6286*/ s_x = 0x01;
-  /*$6288*/ func_4c36(0xfffe);
+  /*$6288*/ func_4c36(0xfffe); if (s_native_depth <= depth) return;
   /*$628B*/ CYCLES(0x628b, 4);
             branchTarget = true;
             if (!s_status_n)
@@ -3537,11 +3592,11 @@ bb_18:
   /*$629E*/ ram_poke((0x1a00 + tmp1_U8), 0x00);
   /*$62A1*/ s_a = ram_peek(0x1421);
   /*$62A7*/ s_x = (uint8_t)(ram_peek(0x0c18) + 0x01);
-  /*$62A8*/ func_4c00(0xfffe);
+  /*$62A8*/ func_4c00(0xfffe); if (s_native_depth <= depth) return;
   /*$62AB*/ CYCLES(0x62ab, 16);
             ram_poke((0x1a10 + tmp1_U8), s_a);
   /*$62AE*/ s_a = ram_peek(0x0c13);
-  /*$62B1*/ func_4c4b(0xfffe);
+  /*$62B1*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
   /*$62B4*/ CYCLES(0x62b4, 18);
   /*$62B8*/ ram_poke((0x1a20 + tmp1_U8), (uint8_t)(s_a + ram_peek(0x0c12)));
             branchTarget = true;
@@ -3554,8 +3609,7 @@ void func_6215(uint16_t ret_addr) {
   uint8_t tmp1_U8;
   uint8_t tmp2_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$6215*/ CYCLES(0x6215, 6);
@@ -3602,7 +3656,7 @@ bb_5:
               goto bb_5;
 bb_6:
   /*$6869*/ CYCLES(0x6869, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
@@ -3613,8 +3667,7 @@ void func_64a8(uint16_t ret_addr) {
   uint16_t tmp3_U16;
   uint16_t tmp4_U16;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$64A8*/ CYCLES(0x64a8, 12);
@@ -3637,24 +3690,24 @@ bb_1:
             s_a = tmp2_U8;
   /*$64BC*/ ram_poke((0x1aa0 + tmp1_U8), tmp2_U8);
   /*$64BF*/ s_x = ram_peek(0x1500);
-  /*$64C2*/ func_6500(0xfffe);
+  /*$64C2*/ func_6500(0xfffe); if (s_native_depth <= depth) return;
   /*$64C5*/ CYCLES(0x64c5, 21);
             ram_poke((0x1ac0 + tmp1_U8), s_a);
   /*$64C8*/ s_a = ram_peek((0x1ab0 + tmp1_U8));
   /*$64CB*/ s_x = ram_peek(0x1501);
-  /*$64CE*/ func_6500(0xfffe);
+  /*$64CE*/ func_6500(0xfffe); if (s_native_depth <= depth) return;
   /*$64D1*/ CYCLES(0x64d1, 36);
             ram_poke((0x1ad0 + tmp1_U8), s_a);
   /*$64D7*/ ram_poke((0x1af0 + tmp1_U8), ram_peek(0x0c16));
   /*$64DE*/ ram_poke((0x1ae0 + tmp1_U8), (ram_peek(0x004e) & 0x01));
   /*$64E1*/ s_a = 0x03;
-  /*$64E3*/ func_4c4b(0xfffe);
+  /*$64E3*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
   /*$64E6*/ CYCLES(0x64e6, 11);
   /*$64E9*/ ram_poke((0x1b00 + tmp1_U8), (uint8_t)(s_a - 0x0001));
 bb_2:
   /*$64EC*/ CYCLES(0x64ec, 9);
             s_a = 0x03;
-  /*$64EE*/ func_4c4b(0xfffe);
+  /*$64EE*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
   /*$64F1*/ CYCLES(0x64f1, 19);
   /*$64F2*/ tmp3_U16 = s_a;
             tmp4_U16 = tmp3_U16 - 0x0001;
@@ -3676,7 +3729,7 @@ bb_3:
             ram_poke(0x1410, tmp2_U8);
 bb_4:
   /*$64FF*/ CYCLES(0x64ff, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
@@ -3687,8 +3740,7 @@ void func_6500(uint16_t ret_addr) {
   uint16_t tmp3_U16;
   uint8_t tmp4_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$6500*/ CYCLES(0x6500, 40);
@@ -3699,7 +3751,7 @@ bb_0:
             s_status_v = ovf8((uint8_t)tmp3_U16, (uint8_t)tmp1_U16, (uint8_t)(~tmp2_U16));
   /*$6510*/ ram_poke(0x0006, ((uint8_t)tmp3_U16));
   /*$6512*/ s_a = 0x05;
-  /*$6514*/ func_4c4b(0xfffe);
+  /*$6514*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
   /*$6517*/ CYCLES(0x6517, 14);
   /*$651B*/ tmp4_U8 = (uint8_t)((s_a - 0x0002) + ram_peek(0x0006));
             s_a = tmp4_U8;
@@ -3711,7 +3763,7 @@ bb_1:
   /*$6520*/ s_a = (uint8_t)(s_a + 0x0001);
 bb_2:
   /*$6522*/ CYCLES(0x6522, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
@@ -3719,23 +3771,22 @@ void func_67b8(uint16_t ret_addr) {
   bool branchTarget = true;
   uint8_t tmp1_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$67B8*/ CYCLES(0x67b8, 16);
             tmp1_U8 = s_x;
             s_a = ram_peek((0x1a50 + tmp1_U8));
   /*$67BB*/ s_y = ram_peek(0x1500);
-  /*$67BE*/ func_6832(0xfffe);
+  /*$67BE*/ func_6832(0xfffe); if (s_native_depth <= depth) return;
   /*$67C1*/ CYCLES(0x67c1, 21);
             ram_poke((0x1a80 + tmp1_U8), s_a);
   /*$67C4*/ s_a = ram_peek((0x1a60 + tmp1_U8));
   /*$67C7*/ s_y = ram_peek(0x1501);
-  /*$67CA*/ func_6832(0xfffe);
+  /*$67CA*/ func_6832(0xfffe); if (s_native_depth <= depth) return;
   /*$67CD*/ CYCLES(0x67cd, 7);
             ram_poke((0x1a90 + tmp1_U8), s_a);
-  /*$67D0*/ if (ret_addr) pop16(); return;
+  /*$67D0*/ native_return(ret_addr); return;
 }
 
 
@@ -3748,8 +3799,7 @@ void func_6832(uint16_t ret_addr) {
   uint8_t tmp5_U8;
   uint8_t tmp6_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$6832*/ CYCLES(0x6832, 33);
@@ -3788,7 +3838,7 @@ bb_2:
             s_a = 0xff;
 bb_3:
   /*$684D*/ CYCLES(0x684d, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
@@ -3797,8 +3847,7 @@ void func_6c2f(uint16_t ret_addr) {
   uint8_t tmp1_U8;
   uint8_t tmp2_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$6C2F*/ CYCLES(0x6c2f, 16);
@@ -3807,7 +3856,7 @@ bb_0:
             s_status_n = (tmp2_U8 & 0x80);
             s_a = tmp2_U8;
   /*$6C34*/ ram_poke((0x1e30 + tmp1_U8), tmp2_U8);
-  /*$6C37*/ if (ret_addr) pop16(); return;
+  /*$6C37*/ native_return(ret_addr); return;
 }
 
 
@@ -3816,8 +3865,7 @@ void func_7000(uint16_t ret_addr) {
   uint8_t tmp1_U8;
   uint16_t tmp2_U16;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$7000*/ CYCLES(0x7000, 6);
@@ -3855,10 +3903,10 @@ bb_5:
   /*$7035*/ ram_poke(0x141e, 0x00);
   /*$7038*/ ram_poke(0x1419, 0x00);
   /*$703B*/ ram_poke(0x1426, 0x00);
-  /*$703E*/ if (ret_addr) pop16(); return;
+  /*$703E*/ native_return(ret_addr); return;
 bb_6:
   /*$703F*/ CYCLES(0x703f, 6);
-            func_4c36(0xfffe);
+            func_4c36(0xfffe); if (s_native_depth <= depth) return;
   /*$7042*/ CYCLES(0x7042, 16);
             push8((s_status_c | ((s_status_not_z == 0) << 1) | (s_status_i << 2) | (s_status_d << 3) | STATUS_B | (s_status_v << 6) | s_status_n));
   /*$7045*/ ram_poke((0x1b40 + s_y), (s_a & 0x01));
@@ -3872,14 +3920,14 @@ bb_6:
 bb_7:
   /*$704B*/ CYCLES(0x704b, 9);
             s_a = 0xdb;
-  /*$704D*/ func_4c4b(0xfffe);
+  /*$704D*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
   /*$7050*/ CYCLES(0x7050, 19);
   /*$7055*/ ram_poke((0x1b20 + s_y), ((uint8_t)(s_a + 0x000c) & 0xfe));
-  /*$7058*/ func_4c36(0xfffe);
+  /*$7058*/ func_4c36(0xfffe); if (s_native_depth <= depth) return;
   /*$705B*/ CYCLES(0x705b, 12);
             ram_poke(0x0000, s_a);
   /*$705D*/ s_a = 0x20;
-  /*$705F*/ func_4c4b(0xfffe);
+  /*$705F*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
   /*$7062*/ CYCLES(0x7062, 12);
   /*$7063*/ tmp2_U16 = s_a + 0x000c;
             s_status_c = (uint8_t)(tmp2_U16 >> 8);
@@ -3904,14 +3952,14 @@ bb_9:
 bb_10:
   /*$7070*/ CYCLES(0x7070, 9);
             s_a = 0x9c;
-  /*$7072*/ func_4c4b(0xfffe);
+  /*$7072*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
   /*$7075*/ CYCLES(0x7075, 16);
   /*$7078*/ ram_poke((0x1b30 + s_y), (uint8_t)(s_a + 0x000c));
-  /*$707B*/ func_4c36(0xfffe);
+  /*$707B*/ func_4c36(0xfffe); if (s_native_depth <= depth) return;
   /*$707E*/ CYCLES(0x707e, 12);
             ram_poke(0x0000, s_a);
   /*$7080*/ s_a = 0x37;
-  /*$7082*/ func_4c4b(0xfffe);
+  /*$7082*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
   /*$7085*/ CYCLES(0x7085, 12);
   /*$7086*/ tmp2_U16 = s_a + 0x000c;
             s_status_c = (uint8_t)(tmp2_U16 >> 8);
@@ -3941,7 +3989,7 @@ bb_14:
             goto bb_16;
 bb_15:
   /*$709C*/ CYCLES(0x709c, 6);
-            func_4c4b(0xfffe);
+            func_4c4b(0xfffe); if (s_native_depth <= depth) return;
             branchTarget = true;
 bb_16:
   /*$709F*/ CYCLES(0x709f, 26);
@@ -3949,15 +3997,15 @@ bb_16:
             ram_poke((0x1b50 + tmp1_U8), s_a);
   /*$70A5*/ ram_poke((0x1b60 + tmp1_U8), (tmp1_U8 & 0x03));
   /*$70A8*/ s_a = ram_peek(0x0c25);
-  /*$70AB*/ func_4c4b(0xfffe);
+  /*$70AB*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
   /*$70AE*/ CYCLES(0x70ae, 16);
             ram_poke((0x1b70 + tmp1_U8), s_a);
   /*$70B1*/ s_a = ram_peek(0x0c26);
-  /*$70B4*/ func_4c4b(0xfffe);
+  /*$70B4*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
   /*$70B7*/ CYCLES(0x70b7, 19);
             ram_poke((0x1b80 + tmp1_U8), s_a);
   /*$70BC*/ ram_poke((0x1b90 + tmp1_U8), 0xff);
-  /*$70BF*/ func_4c36(0xfffe);
+  /*$70BF*/ func_4c36(0xfffe); if (s_native_depth <= depth) return;
   /*$70C2*/ CYCLES(0x70c2, 14);
   /*$70C4*/ ram_poke((0x1ba0 + tmp1_U8), (s_a & 0x01));
             branchTarget = true;
@@ -3973,8 +4021,7 @@ void func_7006(uint16_t ret_addr) {
   uint16_t tmp4_U16;
   uint8_t tmp5_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$7006*/ CYCLES(0x7006, 6);
@@ -4009,7 +4056,7 @@ bb_3:
 bb_4:
   /*$7702*/ CYCLES(0x7702, 9);
             ram_poke(0x0000, s_x);
-  /*$7704*/ func_7821(0xfffe);
+  /*$7704*/ func_7821(0xfffe); if (s_native_depth <= depth) return;
   /*$7707*/ CYCLES(0x7707, 7);
             tmp5_U8 = ram_peek(0x0000);
             s_x = tmp5_U8;
@@ -4038,13 +4085,13 @@ bb_7:
             goto bb_9;
 bb_8:
   /*$771D*/ CYCLES(0x771d, 6);
-            func_7778(0xfffe);
+            func_7778(0xfffe); if (s_native_depth <= depth) return;
             branchTarget = true;
 bb_9:
   /*$7720*/ CYCLES(0x7720, 9);
             tmp5_U8 = ram_peek(0x0000);
             s_x = tmp5_U8;
-  /*$7722*/ func_779e(0xfffe);
+  /*$7722*/ func_779e(0xfffe); if (s_native_depth <= depth) return;
   /*$7725*/ CYCLES(0x7725, 50);
   /*$7729*/ tmp1_U16 = ram_peek((0x1c50 + tmp5_U8)) << 0x02;
             s_status_c = (uint8_t)((tmp1_U16 & 0x01ff) >> 8);
@@ -4055,7 +4102,7 @@ bb_9:
   /*$773B*/ tmp5_U8 = ram_peek((0x1bb0 + tmp5_U8));
             s_a = tmp5_U8;
   /*$773E*/ s_x = tmp5_U8;
-  /*$773F*/ func_5059(0xfffe);
+  /*$773F*/ func_5059(0xfffe); if (s_native_depth <= depth) return;
   /*$7742*/ CYCLES(0x7742, 12);
             tmp5_U8 = ram_peek(0x0000);
             s_x = tmp5_U8;
@@ -4071,13 +4118,13 @@ bb_10:
             ram_poke((0x1c10 + tmp5_U8), 0x70);
   /*$774E*/ s_a = ram_peek((0x1bb0 + tmp5_U8));
   /*$7751*/ s_y = ram_peek(0x1500);
-  /*$7754*/ func_7812(0xfffe);
+  /*$7754*/ func_7812(0xfffe); if (s_native_depth <= depth) return;
   /*$7757*/ CYCLES(0x7757, 23);
             ram_poke(0x0002, s_a);
   /*$7759*/ ram_poke(0x0003, s_y);
   /*$775B*/ s_a = ram_peek((0x1bd0 + tmp5_U8));
   /*$775E*/ s_y = ram_peek(0x1501);
-  /*$7761*/ func_7812(0xfffe);
+  /*$7761*/ func_7812(0xfffe); if (s_native_depth <= depth) return;
   /*$7764*/ CYCLES(0x7764, 7);
             tmp5_U8 = s_a >= ram_peek(0x0002);
             s_status_c = tmp5_U8;
@@ -4105,7 +4152,7 @@ bb_13:
 bb_14:
   /*$77E2*/ CYCLES(0x77e2, 11);
             s_a = ram_peek(0x0c2b);
-  /*$77E5*/ func_4c4b(0xfffe);
+  /*$77E5*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
   /*$77E8*/ CYCLES(0x77e8, 33);
             ram_poke(0x0006, s_a);
   /*$77F0*/ tmp1_U16 = (ram_peek(0x0c2a) + 0x0001) << 0x01;
@@ -4145,7 +4192,7 @@ bb_17:
               goto bb_15;
 bb_18:
   /*$7811*/ CYCLES(0x7811, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
@@ -4157,8 +4204,7 @@ void func_7009(uint16_t ret_addr) {
   uint16_t tmp4_U16;
   uint16_t tmp5_U16;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$7009*/ CYCLES(0x7009, 6);
@@ -4179,19 +4225,19 @@ bb_1:
               goto bb_3;
 bb_2:
   /*$74CC*/ CYCLES(0x74cc, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 bb_3:
   /*$74CD*/ CYCLES(0x74cd, 9);
             ram_poke(0x0000, s_x);
-  /*$74CF*/ func_7628(0xfffe);
+  /*$74CF*/ func_7628(0xfffe); if (s_native_depth <= depth) return;
   /*$74D2*/ CYCLES(0x74d2, 9);
             tmp2_U8 = ram_peek(0x0000);
             s_x = tmp2_U8;
-  /*$74D4*/ func_7546(0xfffe);
+  /*$74D4*/ func_7546(0xfffe); if (s_native_depth <= depth) return;
   /*$74D7*/ CYCLES(0x74d7, 16);
             s_y = ram_peek((0x1c80 + tmp2_U8));
   /*$74DA*/ s_a = ram_peek((0x1c70 + tmp2_U8));
-  /*$74DD*/ func_4c1c(0xfffe);
+  /*$74DD*/ func_4c1c(0xfffe); if (s_native_depth <= depth) return;
   /*$74E0*/ CYCLES(0x74e0, 9);
             ram_poke(0x0004, s_a);
   /*$74E2*/ s_a = 0x00;
@@ -4260,7 +4306,7 @@ bb_10:
   /*$7518*/ CYCLES(0x7518, 9);
             tmp2_U8 = ram_peek(0x0000);
             s_y = tmp2_U8;
-  /*$751A*/ func_768f(0xfffe);
+  /*$751A*/ func_768f(0xfffe); if (s_native_depth <= depth) return;
   /*$751D*/ CYCLES(0x751d, 38);
             tmp3_U8 = ram_peek(0x0002);
   /*$751F*/ ram_poke((0x1c90 + tmp2_U8), tmp3_U8);
@@ -4269,7 +4315,7 @@ bb_10:
   /*$7527*/ ram_poke((0x1ca0 + tmp2_U8), tmp3_U8);
   /*$752A*/ ram_poke((0x1cd0 + tmp2_U8), tmp3_U8);
   /*$752D*/ s_a = ram_peek(0x0c2d);
-  /*$7530*/ func_4c4b(0xfffe);
+  /*$7530*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
   /*$7533*/ CYCLES(0x7533, 33);
   /*$7534*/ tmp1_U16 = s_a;
             tmp4_U16 = ram_peek(0x0c2e);
@@ -4293,8 +4339,7 @@ void func_72d9(uint16_t ret_addr) {
   uint8_t tmp1_U8;
   uint16_t tmp2_U16;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$72D9*/ CYCLES(0x72d9, 9);
@@ -4306,7 +4351,7 @@ bb_0:
 bb_1:
   /*$72DE*/ CYCLES(0x72de, 4);
             s_y = (uint8_t)(s_y - 0x01);
-  /*$72DF*/ if (ret_addr) pop16(); return;
+  /*$72DF*/ native_return(ret_addr); return;
 bb_2:
   /*$72E0*/ CYCLES(0x72e0, 14);
   /*$72E2*/ ram_poke(0x0006, 0xff);
@@ -4370,7 +4415,7 @@ bb_11:
 bb_12:
   /*$7311*/ CYCLES(0x7311, 6);
             s_y = ram_peek(0x0007);
-  /*$7313*/ if (ret_addr) pop16(); return;
+  /*$7313*/ native_return(ret_addr); return;
 }
 
 
@@ -4379,8 +4424,7 @@ void func_7459(uint16_t ret_addr) {
   uint8_t tmp1_U8;
   uint8_t tmp2_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$7459*/ CYCLES(0x7459, 9);
@@ -4432,7 +4476,7 @@ bb_6:
             ram_poke(0x1419, s_a);
 bb_7:
   /*$7478*/ CYCLES(0x7478, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
@@ -4444,8 +4488,7 @@ void func_7546(uint16_t ret_addr) {
   uint16_t tmp4_U16;
   uint16_t tmp5_U16;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$7546*/ CYCLES(0x7546, 19);
@@ -4507,7 +4550,7 @@ bb_6:
 bb_7:
   /*$7581*/ CYCLES(0x7581, 7);
             ram_poke((0x1c80 + s_x), s_a);
-  /*$7584*/ if (ret_addr) pop16(); return;
+  /*$7584*/ native_return(ret_addr); return;
 }
 
 
@@ -4517,8 +4560,7 @@ void func_7628(uint16_t ret_addr) {
   uint16_t tmp2_U16;
   uint8_t tmp3_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$7628*/ CYCLES(0x7628, 14);
@@ -4542,7 +4584,7 @@ bb_2:
             tmp1_U8 = s_x;
             s_y = ram_peek((0x1c80 + tmp1_U8));
   /*$7638*/ s_a = ram_peek((0x1c70 + tmp1_U8));
-  /*$763B*/ func_4c1c(0xfffe);
+  /*$763B*/ func_4c1c(0xfffe); if (s_native_depth <= depth) return;
   /*$763E*/ CYCLES(0x763e, 9);
             ram_poke(0x0004, s_a);
   /*$7640*/ s_a = 0xff;
@@ -4597,7 +4639,7 @@ bb_8:
   /*$7670*/ CYCLES(0x7670, 11);
   /*$7672*/ tmp1_U8 = (uint8_t)(ram_peek(0x0000) + 0x01);
             s_x = tmp1_U8;
-  /*$7673*/ func_7546(0xfffe);
+  /*$7673*/ func_7546(0xfffe); if (s_native_depth <= depth) return;
   /*$7676*/ CYCLES(0x7676, 9);
             tmp2_U16 = 0x1cb0 + tmp1_U8;
             tmp1_U8 = (uint8_t)(ram_peek(tmp2_U16) - 0x01);
@@ -4617,7 +4659,7 @@ bb_9:
   /*$768B*/ ram_poke((0x1ca0 + tmp1_U8), tmp3_U8);
 bb_10:
   /*$768E*/ CYCLES(0x768e, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
@@ -4628,8 +4670,7 @@ void func_768f(uint16_t ret_addr) {
   uint8_t tmp3_U8;
   uint16_t tmp4_U16;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$768F*/ CYCLES(0x768f, 12);
@@ -4674,7 +4715,7 @@ bb_7:
   /*$76B0*/ CYCLES(0x76b0, 12);
             ram_poke(0x0002, s_x);
   /*$76B2*/ ram_poke(0x0003, s_a);
-  /*$76B4*/ func_4c36(0xfffe);
+  /*$76B4*/ func_4c36(0xfffe); if (s_native_depth <= depth) return;
   /*$76B7*/ CYCLES(0x76b7, 9);
             branchTarget = true;
             if ((s_a >= ram_peek(0x0c2f)))
@@ -4763,7 +4804,7 @@ bb_18:
             ram_poke(0x0003, s_a);
 bb_19:
   /*$76F0*/ CYCLES(0x76f0, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
@@ -4772,19 +4813,18 @@ void func_7778(uint16_t ret_addr) {
   uint8_t tmp1_U8;
   uint16_t tmp2_U16;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$7778*/ CYCLES(0x7778, 11);
   /*$777A*/ tmp1_U8 = (uint8_t)(ram_peek(0x0000) + 0x01);
             s_x = tmp1_U8;
-  /*$777B*/ func_779e(0xfffe);
+  /*$777B*/ func_779e(0xfffe); if (s_native_depth <= depth) return;
   /*$777E*/ CYCLES(0x777e, 23);
   /*$7780*/ s_x = ram_peek((0x1bd0 + tmp1_U8));
   /*$7783*/ s_a = ram_peek((0x1bb0 + tmp1_U8));
   /*$7786*/ s_y = 0x0a;
-  /*$7788*/ func_4cd0(0xfffe);
+  /*$7788*/ func_4cd0(0xfffe); if (s_native_depth <= depth) return;
   /*$778B*/ CYCLES(0x778b, 12);
             tmp1_U8 = ram_peek(0x0000);
             s_x = tmp1_U8;
@@ -4801,7 +4841,7 @@ bb_1:
   /*$779A*/ ram_poke((0x1bf1 + tmp1_U8), ram_peek((0x1c30 + tmp1_U8)));
 bb_2:
   /*$779D*/ CYCLES(0x779d, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
@@ -4813,8 +4853,7 @@ void func_779e(uint16_t ret_addr) {
   uint16_t tmp4_U16;
   uint16_t tmp5_U16;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$779E*/ CYCLES(0x779e, 24);
@@ -4889,7 +4928,7 @@ bb_10:
 bb_11:
   /*$77D9*/ CYCLES(0x77d9, 7);
             ram_poke((0x1bd0 + s_x), s_a);
-  /*$77DC*/ if (ret_addr) pop16(); return;
+  /*$77DC*/ native_return(ret_addr); return;
 }
 
 
@@ -4900,8 +4939,7 @@ void func_7812(uint16_t ret_addr) {
   uint16_t tmp3_U16;
   uint8_t tmp4_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$7812*/ CYCLES(0x7812, 16);
@@ -4926,7 +4964,7 @@ bb_1:
   /*$781F*/ s_y = (uint8_t)(s_y - 0x01);
 bb_2:
   /*$7820*/ CYCLES(0x7820, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
@@ -4938,8 +4976,7 @@ void func_7821(uint16_t ret_addr) {
   uint8_t tmp4_U8;
   uint8_t tmp5_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$7821*/ CYCLES(0x7821, 23);
@@ -4960,8 +4997,8 @@ bb_1:
   /*$7837*/ s_x = ((uint8_t)tmp3_U16);
   /*$7838*/ s_a = ram_peek((0x1bb0 + tmp2_U8));
   /*$7839*/ s_y = 0x0e;
-  /*$783B*/ func_4cd0(0x0000);
-            if (ret_addr) pop16(); return;
+  /*$783B*/ func_4cd0(0x0000); if (s_native_depth <= depth) return;
+            native_return(ret_addr); return;
 bb_2:
   /*$783E*/ CYCLES(0x783e, 50);
             tmp2_U8 = s_x;
@@ -4981,7 +5018,7 @@ bb_4:
   /*$785D*/ CYCLES(0x785d, 14);
             s_y = s_a;
   /*$7861*/ s_x = ram_peek((0x1bb0 + s_x));
-  /*$7862*/ func_4c7c(0xfffe);
+  /*$7862*/ func_4c7c(0xfffe); if (s_native_depth <= depth) return;
             branchTarget = true;
 bb_5:
   /*$7865*/ CYCLES(0x7865, 58);
@@ -5006,8 +5043,8 @@ bb_5:
               goto bb_5;
 bb_6:
   /*$7887*/ CYCLES(0x7887, 6);
-            func_4c6e(0x0000);
-            if (ret_addr) pop16(); return;
+            func_4c6e(0x0000); if (s_native_depth <= depth) return;
+            native_return(ret_addr); return;
 }
 
 
@@ -5017,8 +5054,7 @@ void func_7979(uint16_t ret_addr) {
   uint16_t tmp2_U16;
   uint16_t tmp3_U16;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$7979*/ CYCLES(0x7979, 14);
@@ -5050,11 +5086,11 @@ bb_2:
 bb_3:
   /*$7994*/ CYCLES(0x7994, 4);
             s_status_c = 0x01;
-  /*$7995*/ if (ret_addr) pop16(); return;
+  /*$7995*/ native_return(ret_addr); return;
 bb_4:
   /*$7996*/ CYCLES(0x7996, 4);
             s_status_c = 0x00;
-  /*$7997*/ if (ret_addr) pop16(); return;
+  /*$7997*/ native_return(ret_addr); return;
 }
 
 
@@ -5062,8 +5098,7 @@ void FUNC_PREAD(uint16_t ret_addr) {
   bool branchTarget = true;
   uint8_t tmp1_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$FB1E*/ CYCLES(0xfb1e, 12);
@@ -5087,7 +5122,7 @@ bb_3:
             s_y = (uint8_t)(s_y - 0x01);
 bb_4:
   /*$FB2E*/ CYCLES(0xfb2e, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
@@ -5106,8 +5141,7 @@ void func_t001(uint16_t ret_addr) {
   uint8_t tmp8_U8;
   uint16_t tmp9_U16;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
   for(;;) {
     switch (block_id) {
@@ -5179,7 +5213,7 @@ void func_t001(uint16_t ret_addr) {
       /*$04DF*/ ram_poke(0x002b, 0xff);
       /*$04E1*/ ram_poke(0x002c, 0xff);
       /*$04E3*/ s_x = 0x01;
-      /*$04E5*/ func_0540(0xfffe);
+      /*$04E5*/ func_0540(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 11;
       break;
     case 11:  // $04E8
@@ -5237,7 +5271,7 @@ void func_t001(uint16_t ret_addr) {
                 s_a = tmp1_U8;
       /*$051F*/ ram_poke(0x002e, tmp1_U8);
       /*$0521*/ s_x = 0x03;
-      /*$0523*/ func_0540(0x0000);
+      /*$0523*/ func_0540(0x0000); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = find_block_id_func_t001(0x0523, pop16() + 1);;
       break;
     case 21:  // $0526
@@ -5245,7 +5279,7 @@ void func_t001(uint16_t ret_addr) {
                 s_x = ram_peek(0x002d);
       /*$0528*/ s_y = ram_peek(0x002e);
       /*$052A*/ push8(s_a);
-      /*$052B*/ func_5108(0xfffe);
+      /*$052B*/ func_5108(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 22;
       break;
     case 22:  // $052E
@@ -5272,7 +5306,7 @@ void func_t001(uint16_t ret_addr) {
       /*$053C*/ CYCLES(0x053c, 7);
                 ram_poke(0x002d, (uint8_t)(ram_peek(0x002d) + 0x01));
       /*$053E*/ s_x = 0x01;
-                func_0540(0x0000);
+                func_0540(0x0000); if (s_native_depth <= depth) return;
                 block_id = find_block_id_func_t001(0x053e, pop16() + 1);;
       break;
     case 26:  // $0540
@@ -5376,7 +5410,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 40:  // $408A
       /*$408A*/ CYCLES(0x408a, 6);
-                func_442a(0xfffe);
+                func_442a(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 41;
       break;
     case 41:  // $408D
@@ -5412,7 +5446,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 47:  // $40AC
       /*$40AC*/ CYCLES(0x40ac, 6);
-                func_430e(0xfffe);
+                func_430e(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 48;
       break;
     case 48:  // $40AF
@@ -5421,7 +5455,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 49:  // $40B2
       /*$40B2*/ CYCLES(0x40b2, 6);
-                func_425b(0xfffe);
+                func_425b(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 50;
       break;
     case 50:  // $40B5
@@ -5434,12 +5468,12 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 52:  // $40BB
       /*$40BB*/ CYCLES(0x40bb, 6);
-                func_5209(0xfffe);
+                func_5209(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 53;
       break;
     case 53:  // $40BE
       /*$40BE*/ CYCLES(0x40be, 6);
-                func_5a1b(0xfffe);
+                func_5a1b(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 54;
       break;
     case 54:  // $40C1
@@ -5456,7 +5490,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 57:  // $40C9
       /*$40C9*/ CYCLES(0x40c9, 6);
-                func_4ef1(0xfffe);
+                func_4ef1(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 58;
       break;
     case 58:  // $40CC
@@ -5467,13 +5501,13 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 59:  // $40D1
       /*$40D1*/ CYCLES(0x40d1, 6);
-                func_6215(0xfffe);
+                func_6215(0xfffe); if (s_native_depth <= depth) return;
       /*$40D4*/ CYCLES(0x40d4, 6);
                 branchTarget = true; block_id = 37;
       break;
     case 60:  // $40D7
       /*$40D7*/ CYCLES(0x40d7, 6);
-                func_5a1e(0xfffe);
+                func_5a1e(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 61;
       break;
     case 61:  // $40DA
@@ -5518,17 +5552,17 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 71:  // $40F8
       /*$40F8*/ CYCLES(0x40f8, 6);
-                func_7006(0xfffe);
+                func_7006(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 72;
       break;
     case 72:  // $40FB
       /*$40FB*/ CYCLES(0x40fb, 6);
-                func_7009(0xfffe);
+                func_7009(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 73;
       break;
     case 73:  // $40FE
       /*$40FE*/ CYCLES(0x40fe, 6);
-                func_7009(0xfffe);
+                func_7009(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 74;
       break;
     case 74:  // $4101
@@ -5659,7 +5693,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 95:  // $416E
       /*$416E*/ CYCLES(0x416e, 6);
-                func_4c6e(0x0000);
+                func_4c6e(0x0000); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = find_block_id_func_t001(0x416e, pop16() + 1);;
       break;
     case 96:  // $4171
@@ -5670,7 +5704,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 97:  // $4178
       /*$4178*/ CYCLES(0x4178, 6);
-                func_4185(0xfffe);
+                func_4185(0xfffe); if (s_native_depth <= depth) return;
       /*$417B*/ CYCLES(0x417b, 6);
                 branchTarget = true; push16(0x417d); block_id = 117;
       break;
@@ -5698,7 +5732,7 @@ void func_t001(uint16_t ret_addr) {
     case 101:  // $418E
       /*$418E*/ CYCLES(0x418e, 16);
       /*$4191*/ ram_poke(0x1506, (s_a & ram_peek(0x1506)));
-      /*$4194*/ FUNC_PREAD(0xfffe);
+      /*$4194*/ FUNC_PREAD(0xfffe); if (s_native_depth <= depth) return;
       /*$4197*/ CYCLES(0x4197, 11);
                 s_x = 0x00;
       /*$419B*/ branchTarget = true; block_id = !(s_y >= 0xc0) ? 103 : 102;
@@ -5751,7 +5785,7 @@ void func_t001(uint16_t ret_addr) {
     case 109:  // $41B8
       /*$41B8*/ CYCLES(0x41b8, 11);
                 s_x = ram_peek(0x1508);
-      /*$41BB*/ FUNC_PREAD(0xfffe);
+      /*$41BB*/ FUNC_PREAD(0xfffe); if (s_native_depth <= depth) return;
       /*$41BE*/ CYCLES(0x41be, 26);
                 tmp1_U8 = s_y;
       /*$41C3*/ s_status_c = ((tmp1_U8 >> 0x04) & 0x01);
@@ -5792,7 +5826,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 115:  // $41DC
       /*$41DC*/ CYCLES(0x41dc, 6);
-                func_4185(0xfffe);
+                func_4185(0xfffe); if (s_native_depth <= depth) return;
       /*$41DF*/ CYCLES(0x41df, 6);
                 branchTarget = true; push16(0x41e1); block_id = 117;
       break;
@@ -5816,7 +5850,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 119:  // $41EB
       /*$41EB*/ CYCLES(0x41eb, 6);
-                func_4242(0xfffe);
+                func_4242(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 120;
       break;
     case 120:  // $41EE
@@ -5856,7 +5890,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 126:  // $420B
       /*$420B*/ CYCLES(0x420b, 6);
-                func_424e(0xfffe);
+                func_424e(0xfffe); if (s_native_depth <= depth) return;
       /*$420E*/ CYCLES(0x420e, 4);
                 branchTarget = true; block_id = s_status_c ? 118 : 127;
       break;
@@ -5869,7 +5903,7 @@ void func_t001(uint16_t ret_addr) {
     case 128:  // $4217
       /*$4217*/ CYCLES(0x4217, 9);
                 ram_poke(0x0006, s_x);
-      /*$4219*/ func_424e(0xfffe);
+      /*$4219*/ func_424e(0xfffe); if (s_native_depth <= depth) return;
       /*$421C*/ CYCLES(0x421c, 4);
                 branchTarget = true; block_id = s_status_not_z ? 130 : 129;
       break;
@@ -5949,7 +5983,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 139:  // $424E
       /*$424E*/ CYCLES(0x424e, 6);
-                func_4242(0xfffe);
+                func_4242(0xfffe); if (s_native_depth <= depth) return;
       /*$4251*/ CYCLES(0x4251, 7);
                 tmp1_U8 = s_a;
                 tmp2_U8 = tmp1_U8 != 0x0d;
@@ -5992,7 +6026,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 145:  // $4264
       /*$4264*/ CYCLES(0x4264, 6);
-                func_4c6e(0xfffe);
+                func_4c6e(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 146;
       break;
     case 146:  // $4267
@@ -6026,7 +6060,7 @@ void func_t001(uint16_t ret_addr) {
       /*$4274*/ ram_poke(0x1404, 0x0a);
       /*$4277*/ s_a = ram_peek(0x1402);
       /*$427A*/ s_x = ram_peek(0x1403);
-      /*$427D*/ func_4c00(0xfffe);
+      /*$427D*/ func_4c00(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 151;
       break;
     case 151:  // $4280
@@ -6097,7 +6131,7 @@ void func_t001(uint16_t ret_addr) {
       /*$42DD*/ CYCLES(0x42dd, 18);
                 s_a = ram_peek(0x0c14);
       /*$42E3*/ s_x = (uint8_t)(ram_peek(0x140f) + 0x01);
-      /*$42E4*/ func_4c00(0xfffe);
+      /*$42E4*/ func_4c00(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 159;
       break;
     case 159:  // $42E7
@@ -6105,7 +6139,7 @@ void func_t001(uint16_t ret_addr) {
                 ram_poke(0x1425, s_a);
       /*$42EA*/ s_a = ram_peek(0x0c55);
       /*$42F0*/ s_x = (uint8_t)(ram_peek(0x1428) + 0x01);
-      /*$42F1*/ func_4c00(0xfffe);
+      /*$42F1*/ func_4c00(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 160;
       break;
     case 160:  // $42F4
@@ -6314,12 +6348,12 @@ void func_t001(uint16_t ret_addr) {
     case 187:  // $43BB
       /*$43BB*/ CYCLES(0x43bb, 9);
                 ram_poke(0x00ca, s_x);
-      /*$43BD*/ func_4c6e(0x0000);
+      /*$43BD*/ func_4c6e(0x0000); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = find_block_id_func_t001(0x43bd, pop16() + 1);;
       break;
     case 188:  // $43C0
       /*$43C0*/ CYCLES(0x43c0, 6);
-                func_4f42(0xfffe);
+                func_4f42(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 189;
       break;
     case 189:  // $43C3
@@ -6385,17 +6419,17 @@ void func_t001(uint16_t ret_addr) {
       /*$43FD*/ ram_poke(0x1436, 0x0c);
       /*$4402*/ ram_poke(0x1412, 0xff);
       /*$4405*/ ram_poke(0x1430, 0xff);
-      /*$4408*/ func_5200(0xfffe);
+      /*$4408*/ func_5200(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 198;
       break;
     case 198:  // $440B
       /*$440B*/ CYCLES(0x440b, 6);
-                func_5a00(0xfffe);
+                func_5a00(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 199;
       break;
     case 199:  // $440E
       /*$440E*/ CYCLES(0x440e, 6);
-                func_7000(0xfffe);
+                func_7000(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 200;
       break;
     case 200:  // $4411
@@ -6419,7 +6453,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 202:  // $441E
       /*$441E*/ CYCLES(0x441e, 6);
-                func_5a03(0xfffe);
+                func_5a03(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 203;
       break;
     case 203:  // $4421
@@ -6428,7 +6462,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 204:  // $4424
       /*$4424*/ CYCLES(0x4424, 6);
-                func_6200(0xfffe);
+                func_6200(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 205;
       break;
     case 205:  // $4427
@@ -6437,7 +6471,7 @@ void func_t001(uint16_t ret_addr) {
       /*$6915*/ CYCLES(0x6915, 18);
       /*$6918*/ s_x = (uint8_t)(ram_peek(0x0c4d) + 0x01);
       /*$6919*/ s_a = ram_peek(0x1421);
-      /*$691C*/ func_4c00(0xfffe);
+      /*$691C*/ func_4c00(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1278;
       break;
     case 206:  // $442A
@@ -6583,17 +6617,17 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 223:  // $44C5
       /*$44C5*/ CYCLES(0x44c5, 6);
-                func_425b(0xfffe);
+                func_425b(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 224;
       break;
     case 224:  // $44C8
       /*$44C8*/ CYCLES(0x44c8, 6);
-                func_5209(0xfffe);
+                func_5209(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 225;
       break;
     case 225:  // $44CB
       /*$44CB*/ CYCLES(0x44cb, 6);
-                func_5a1b(0xfffe);
+                func_5a1b(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 226;
       break;
     case 226:  // $44CE
@@ -6606,7 +6640,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 228:  // $44D4
       /*$44D4*/ CYCLES(0x44d4, 6);
-                func_5a1e(0xfffe);
+                func_5a1e(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 229;
       break;
     case 229:  // $44D7
@@ -6639,17 +6673,17 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 236:  // $44EC
       /*$44EC*/ CYCLES(0x44ec, 6);
-                func_7006(0xfffe);
+                func_7006(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 237;
       break;
     case 237:  // $44EF
       /*$44EF*/ CYCLES(0x44ef, 6);
-                func_7009(0xfffe);
+                func_7009(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 238;
       break;
     case 238:  // $44F2
       /*$44F2*/ CYCLES(0x44f2, 6);
-                func_7009(0xfffe);
+                func_7009(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 239;
       break;
     case 239:  // $44F5
@@ -6788,7 +6822,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 264:  // $455E
       /*$455E*/ CYCLES(0x455e, 6);
-                func_4f42(0xfffe);
+                func_4f42(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 265;
       break;
     case 265:  // $4561
@@ -6821,7 +6855,7 @@ void func_t001(uint16_t ret_addr) {
       /*$4584*/ ram_poke(0x0c5a, 0x03);
       /*$4589*/ ram_poke(0x0c5b, 0x28);
       /*$458C*/ s_x = 0x00;
-      /*$458E*/ func_5081(0xfffe);
+      /*$458E*/ func_5081(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 271;
       break;
     case 271:  // $4591
@@ -6831,7 +6865,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 272:  // $4595
       /*$4595*/ CYCLES(0x4595, 6);
-                func_50c5(0xfffe);
+                func_50c5(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 273;
       break;
     case 273:  // $4598
@@ -6864,7 +6898,7 @@ void func_t001(uint16_t ret_addr) {
       /*$45AE*/ ram_poke(0x0c5a, 0x0f);
       /*$45B3*/ ram_poke(0x0c5b, 0x60);
       /*$45B6*/ s_x = 0x01;
-      /*$45B8*/ func_5081(0xfffe);
+      /*$45B8*/ func_5081(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 278;
       break;
     case 278:  // $45BB
@@ -6890,7 +6924,7 @@ void func_t001(uint16_t ret_addr) {
       /*$45CA*/ ram_poke(0x0c5a, 0x03);
       /*$45CF*/ ram_poke(0x0c5b, 0x28);
       /*$45D2*/ s_x = 0x00;
-      /*$45D4*/ func_5081(0xfffe);
+      /*$45D4*/ func_5081(0xfffe); if (s_native_depth <= depth) return;
                 block_id = 283;
       break;
     case 282:  // $45CC
@@ -6989,7 +7023,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 299:  // $4633
       /*$4633*/ CYCLES(0x4633, 6);
-                func_425b(0xfffe);
+                func_425b(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 300;
       break;
     case 300:  // $4636
@@ -7055,11 +7089,11 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 311:  // $4682
       /*$4682*/ CYCLES(0x4682, 6);
-                func_0143(0xfffe);
+                func_0143(0xfffe); if (s_native_depth <= depth) return;
       /*$4685*/ CYCLES(0x4685, 12);
                 s_y = 0x90;
       /*$4687*/ s_x = 0x06;
-      /*$4689*/ func_4831(0xfffe);
+      /*$4689*/ func_4831(0xfffe); if (s_native_depth <= depth) return;
       /*$468C*/ CYCLES(0x468c, 24);
                 s_y = 0x14;
       /*$468E*/ ram_poke(0x1402, 0x14);
@@ -7076,7 +7110,7 @@ void func_t001(uint16_t ret_addr) {
     case 313:  // $469D
       /*$469D*/ CYCLES(0x469d, 9);
                 s_a = 0x56;
-      /*$469F*/ func_4c4b(0xfffe);
+      /*$469F*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
       /*$46A2*/ CYCLES(0x46a2, 18);
                 tmp5_U16 = s_a;
                 tmp3_U16 = (tmp5_U16 + 0x0060) + s_status_c;
@@ -7084,7 +7118,7 @@ void func_t001(uint16_t ret_addr) {
       /*$46A4*/ tmp2_U8 = s_y;
                 ram_poke((0x15f0 + tmp2_U8), ((uint8_t)tmp3_U16));
       /*$46A7*/ s_a = 0x10;
-      /*$46A9*/ func_4c4b(0xfffe);
+      /*$46A9*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
       /*$46AC*/ CYCLES(0x46ac, 24);
       /*$46AD*/ tmp3_U16 = s_a;
                 tmp5_U16 = tmp3_U16 + 0x00e8;
@@ -7106,7 +7140,7 @@ void func_t001(uint16_t ret_addr) {
       /*$46C5*/ CYCLES(0x46c5, 12);
                 s_x = 0xdc;
       /*$46C7*/ s_a = 0x46;
-      /*$46C9*/ func_4824(0xfffe);
+      /*$46C9*/ func_4824(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 316;
       break;
     case 316:  // $46CC
@@ -7121,7 +7155,7 @@ void func_t001(uint16_t ret_addr) {
       /*$46D2*/ CYCLES(0x46d2, 12);
                 s_a = 0x68;
       /*$46D4*/ s_x = 0xc0;
-      /*$46D6*/ func_46e9(0xfffe);
+      /*$46D6*/ func_46e9(0xfffe); if (s_native_depth <= depth) return;
       /*$46D9*/ CYCLES(0x46d9, 6);
                 branchTarget = true; block_id = 316;
       break;
@@ -7230,11 +7264,11 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 334:  // $472B
       /*$472B*/ CYCLES(0x472b, 6);
-                func_0146(0xfffe);
+                func_0146(0xfffe); if (s_native_depth <= depth) return;
       /*$472E*/ CYCLES(0x472e, 12);
                 s_y = 0xa0;
       /*$4730*/ s_x = 0x78;
-      /*$4732*/ func_4831(0xfffe);
+      /*$4732*/ func_4831(0xfffe); if (s_native_depth <= depth) return;
       /*$4735*/ CYCLES(0x4735, 19);
       /*$4737*/ ram_poke(0x0020, 0x6d);
       /*$473B*/ ram_poke(0x0021, 0x47);
@@ -7244,7 +7278,7 @@ void func_t001(uint16_t ret_addr) {
       /*$4740*/ CYCLES(0x4740, 12);
                 s_x = 0x50;
       /*$4742*/ s_a = 0x47;
-      /*$4744*/ func_4824(0xfffe);
+      /*$4744*/ func_4824(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 336;
       break;
     case 336:  // $4747
@@ -7305,11 +7339,11 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 344:  // $47BF
       /*$47BF*/ CYCLES(0x47bf, 6);
-                func_0149(0xfffe);
+                func_0149(0xfffe); if (s_native_depth <= depth) return;
       /*$47C2*/ CYCLES(0x47c2, 12);
                 s_x = 0xf0;
       /*$47C4*/ s_y = 0xb0;
-      /*$47C6*/ func_4831(0xfffe);
+      /*$47C6*/ func_4831(0xfffe); if (s_native_depth <= depth) return;
       /*$47C9*/ CYCLES(0x47c9, 19);
       /*$47CB*/ ram_poke(0x0020, 0x17);
       /*$47CF*/ ram_poke(0x0021, 0x48);
@@ -7319,7 +7353,7 @@ void func_t001(uint16_t ret_addr) {
       /*$47D4*/ CYCLES(0x47d4, 12);
                 s_x = 0xfe;
       /*$47D6*/ s_a = 0x47;
-      /*$47D8*/ func_4824(0xfffe);
+      /*$47D8*/ func_4824(0xfffe); if (s_native_depth <= depth) return;
       /*$47DB*/ CYCLES(0x47db, 45);
       /*$47DD*/ ram_poke(0x1900, 0x09);
       /*$47E2*/ ram_poke(0x1910, 0x90);
@@ -7375,14 +7409,14 @@ void func_t001(uint16_t ret_addr) {
       /*$4844*/ CYCLES(0x4844, 12);
                 s_x = 0x08;
       /*$4846*/ s_y = 0x08;
-      /*$4848*/ func_4831(0xfffe);
+      /*$4848*/ func_4831(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 354;
       break;
     case 354:  // $484B
       /*$484B*/ CYCLES(0x484b, 12);
                 s_x = 0x5f;
       /*$484D*/ s_a = 0x48;
-      /*$484F*/ func_4824(0xfffe);
+      /*$484F*/ func_4824(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 355;
       break;
     case 355:  // $4852
@@ -7405,11 +7439,11 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 359:  // $488B
       /*$488B*/ CYCLES(0x488b, 6);
-                func_014c(0xfffe);
+                func_014c(0xfffe); if (s_native_depth <= depth) return;
       /*$488E*/ CYCLES(0x488e, 12);
                 s_x = 0xf0;
       /*$4890*/ s_y = 0xa0;
-      /*$4892*/ func_4831(0xfffe);
+      /*$4892*/ func_4831(0xfffe); if (s_native_depth <= depth) return;
       /*$4895*/ CYCLES(0x4895, 19);
       /*$4897*/ ram_poke(0x0020, 0x2b);
       /*$489B*/ ram_poke(0x0021, 0x49);
@@ -7419,7 +7453,7 @@ void func_t001(uint16_t ret_addr) {
       /*$48A0*/ CYCLES(0x48a0, 12);
                 s_x = 0x10;
       /*$48A2*/ s_a = 0x49;
-      /*$48A4*/ func_4824(0xfffe);
+      /*$48A4*/ func_4824(0xfffe); if (s_native_depth <= depth) return;
       /*$48A7*/ CYCLES(0x48a7, 58);
       /*$48A9*/ ram_poke(0x1b20, 0x08);
       /*$48AE*/ ram_poke(0x1b30, 0xa0);
@@ -7444,7 +7478,7 @@ void func_t001(uint16_t ret_addr) {
       /*$48CF*/ CYCLES(0x48cf, 12);
                 s_a = 0x80;
       /*$48D1*/ s_x = 0xc0;
-      /*$48D3*/ func_46e9(0xfffe);
+      /*$48D3*/ func_46e9(0xfffe); if (s_native_depth <= depth) return;
       /*$48D6*/ CYCLES(0x48d6, 9);
                 tmp1_U8 = ram_peek(0x141d);
                 s_a = tmp1_U8;
@@ -7508,15 +7542,15 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 373:  // $4A55
       /*$4A55*/ CYCLES(0x4a55, 6);
-                func_014f(0xfffe);
+                func_014f(0xfffe); if (s_native_depth <= depth) return;
       /*$4A58*/ CYCLES(0x4a58, 12);
                 s_x = 0x08;
       /*$4A5A*/ s_y = 0x08;
-      /*$4A5C*/ func_4831(0xfffe);
+      /*$4A5C*/ func_4831(0xfffe); if (s_native_depth <= depth) return;
       /*$4A5F*/ CYCLES(0x4a5f, 12);
                 s_x = 0x42;
       /*$4A61*/ s_a = 0x4b;
-      /*$4A63*/ func_4824(0xfffe);
+      /*$4A63*/ func_4824(0xfffe); if (s_native_depth <= depth) return;
       /*$4A66*/ CYCLES(0x4a66, 118);
       /*$4A68*/ ram_poke(0x19c0, 0xf1);
       /*$4A6D*/ ram_poke(0x1ce0, 0xf0);
@@ -7637,13 +7671,13 @@ void func_t001(uint16_t ret_addr) {
       /*$4B38*/ CYCLES(0x4b38, 12);
                 s_a = 0x80;
       /*$4B3A*/ s_x = 0xb0;
-      /*$4B3C*/ func_46e9(0xfffe);
+      /*$4B3C*/ func_46e9(0xfffe); if (s_native_depth <= depth) return;
       /*$4B3F*/ CYCLES(0x4b3f, 6);
                 branchTarget = true; block_id = 374;
       break;
     case 389:  // $4B67
       /*$4B67*/ CYCLES(0x4b67, 6);
-                func_4f25(0xfffe);
+                func_4f25(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 390;
       break;
     case 390:  // $4B6A
@@ -7656,7 +7690,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 392:  // $4BCE
       /*$4BCE*/ CYCLES(0x4bce, 6);
-                func_4242(0xfffe);
+                func_4242(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 393;
       break;
     case 393:  // $4BD1
@@ -7830,7 +7864,7 @@ void func_t001(uint16_t ret_addr) {
     case 412:  // $4C4B
       /*$4C4B*/ CYCLES(0x4c4b, 7);
                 s_x = s_a;
-      /*$4C4C*/ func_4c36(0xfffe);
+      /*$4C4C*/ func_4c36(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 413;
       break;
     case 413:  // $4C4F
@@ -7977,7 +8011,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 428:  // $4CAC
       /*$4CAC*/ CYCLES(0x4cac, 6);
-                func_4c7c(0xfffe);
+                func_4c7c(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 429;
       break;
     case 429:  // $4CAF
@@ -8002,7 +8036,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 430:  // $4CCD
       /*$4CCD*/ CYCLES(0x4ccd, 6);
-                func_4c6e(0x0000);
+                func_4c6e(0x0000); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = find_block_id_func_t001(0x4ccd, pop16() + 1);;
       break;
     case 431:  // $4CD0
@@ -8010,7 +8044,7 @@ void func_t001(uint16_t ret_addr) {
                 tmp6_U8 = s_x;
                 ram_poke(0x00fc, tmp6_U8);
       /*$4CD2*/ ram_poke(0x00fe, tmp6_U8);
-      /*$4CD4*/ func_4c1c(0xfffe);
+      /*$4CD4*/ func_4c1c(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 432;
       break;
     case 432:  // $4CD7
@@ -8038,12 +8072,12 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 434:  // $4CF3
       /*$4CF3*/ CYCLES(0x4cf3, 6);
-                func_4c6e(0x0000);
+                func_4c6e(0x0000); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = find_block_id_func_t001(0x4cf3, pop16() + 1);;
       break;
     case 435:  // $4CF6
       /*$4CF6*/ CYCLES(0x4cf6, 6);
-                func_4c7c(0xfffe);
+                func_4c7c(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 436;
       break;
     case 436:  // $4CF9
@@ -8071,7 +8105,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 437:  // $4D1E
       /*$4D1E*/ CYCLES(0x4d1e, 6);
-                func_4c6e(0x0000);
+                func_4c6e(0x0000); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = find_block_id_func_t001(0x4d1e, pop16() + 1);;
       break;
     case 438:  // $4D21
@@ -8079,7 +8113,7 @@ void func_t001(uint16_t ret_addr) {
                 tmp6_U8 = s_x;
                 ram_poke(0x00fc, tmp6_U8);
       /*$4D23*/ ram_poke(0x00fe, tmp6_U8);
-      /*$4D25*/ func_4c1c(0xfffe);
+      /*$4D25*/ func_4c1c(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 439;
       break;
     case 439:  // $4D28
@@ -8108,7 +8142,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 441:  // $4D47
       /*$4D47*/ CYCLES(0x4d47, 6);
-                func_4c6e(0x0000);
+                func_4c6e(0x0000); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = find_block_id_func_t001(0x4d47, pop16() + 1);;
       break;
     case 442:  // $4D4A
@@ -8118,13 +8152,13 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 443:  // $4D4C
       /*$4D4C*/ CYCLES(0x4d4c, 6);
-                func_4c36(0xfffe);
+                func_4c36(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 444;
       break;
     case 444:  // $4D4F
       /*$4D4F*/ CYCLES(0x4d4f, 11);
                 ram_poke((0x0700 + s_x), s_a);
-      /*$4D52*/ func_4c36(0xfffe);
+      /*$4D52*/ func_4c36(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 445;
       break;
     case 445:  // $4D55
@@ -8167,7 +8201,7 @@ void func_t001(uint16_t ret_addr) {
       /*$4D81*/ tmp4_U16 = 0x0060 + ram_peek(0x0001);
                 s_status_c = (uint8_t)(tmp4_U16 >> 8);
                 s_a = ((uint8_t)tmp4_U16);
-      /*$4D83*/ func_4da2(0xfffe);
+      /*$4D83*/ func_4da2(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 450;
       break;
     case 450:  // $4D86
@@ -8175,7 +8209,7 @@ void func_t001(uint16_t ret_addr) {
       /*$4D89*/ tmp4_U16 = 0x005f - ram_peek(0x0001);
                 s_status_c = (uint8_t)(0x01 - ((uint8_t)(tmp4_U16 >> 8) & 0x01));
                 s_a = ((uint8_t)tmp4_U16);
-      /*$4D8B*/ func_4da2(0xfffe);
+      /*$4D8B*/ func_4da2(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 451;
       break;
     case 451:  // $4D8E
@@ -8223,7 +8257,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 456:  // $4DB6
       /*$4DB6*/ CYCLES(0x4db6, 6);
-                func_4c6e(0xfffe);
+                func_4c6e(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 457;
       break;
     case 457:  // $4DB9
@@ -8242,7 +8276,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 459:  // $4DC4
       /*$4DC4*/ CYCLES(0x4dc4, 6);
-                func_4c6e(0xfffe);
+                func_4c6e(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 460;
       break;
     case 460:  // $4DC7
@@ -8258,7 +8292,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 462:  // $4DCC
       /*$4DCC*/ CYCLES(0x4dcc, 6);
-                func_4c6e(0xfffe);
+                func_4c6e(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 463;
       break;
     case 463:  // $4DCF
@@ -8283,13 +8317,13 @@ void func_t001(uint16_t ret_addr) {
     case 465:  // $4E00
       /*$4E00*/ CYCLES(0x4e00, 11);
                 ram_poke(0x1509, (uint8_t)(ram_peek(0x1509) + 0x01));
-      /*$4E03*/ func_4e4f(0xfffe);
+      /*$4E03*/ func_4e4f(0xfffe); if (s_native_depth <= depth) return;
       /*$4E06*/ CYCLES(0x4e06, 43);
       /*$4E0A*/ tmp3_U16 = ram_peek(0x150d) + ram_peek(0x0c10);
       /*$4E0D*/ ram_poke(0x150d, ((uint8_t)tmp3_U16));
       /*$4E16*/ ram_poke(0x150e, (uint8_t)((ram_peek(0x150e) + ram_peek(0x0c11)) + (uint8_t)(tmp3_U16 >> 8)));
       /*$4E1C*/ ram_poke(0x1430, ram_peek(0x0c69));
-                func_4e1f(0x0000);
+                func_4e1f(0x0000); if (s_native_depth <= depth) return;
                 block_id = find_block_id_func_t001(0x4e1c, pop16() + 1);;
       break;
     case 466:  // $4E1F
@@ -8304,7 +8338,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 467:  // $4E32
       /*$4E32*/ CYCLES(0x4e32, 6);
-                func_4ec4(0xfffe);
+                func_4ec4(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 468;
       break;
     case 468:  // $4E35
@@ -8312,7 +8346,7 @@ void func_t001(uint16_t ret_addr) {
       /*$4E36*/ s_a = (uint8_t)(s_a + 0x00b0);
       /*$4E38*/ s_x = 0x27;
       /*$4E3A*/ s_y = ram_peek(0x00fc);
-      /*$4E3C*/ func_5108(0xfffe);
+      /*$4E3C*/ func_5108(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 469;
       break;
     case 469:  // $4E3F
@@ -8493,7 +8527,7 @@ void func_t001(uint16_t ret_addr) {
     case 486:  // $4EF1
       /*$4EF1*/ CYCLES(0x4ef1, 12);
       /*$4EF3*/ ram_poke(0x0000, 0x06);
-      /*$4EF5*/ func_4c36(0xfffe);
+      /*$4EF5*/ func_4c36(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 487;
       break;
     case 487:  // $4EF8
@@ -8516,7 +8550,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 489:  // $4F0A
       /*$4F0A*/ CYCLES(0x4f0a, 6);
-                func_4c36(0xfffe);
+                func_4c36(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 490;
       break;
     case 490:  // $4F0D
@@ -8529,7 +8563,7 @@ void func_t001(uint16_t ret_addr) {
                 tmp6_U8 = s_y;
                 tmp2_U8 = peek((ram_peek16al(0x0006) + tmp6_U8));
       /*$4F13*/ poke((ram_peek16al(0x0006) + tmp6_U8), (tmp2_U8 ^ 0xff));
-      /*$4F15*/ func_4c6e(0xfffe);
+      /*$4F15*/ func_4c6e(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 492;
       break;
     case 492:  // $4F18
@@ -8593,17 +8627,17 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 500:  // $4F42
       /*$4F42*/ CYCLES(0x4f42, 6);
-                func_4f25(0xfffe);
+                func_4f25(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 501;
       break;
     case 501:  // $4F45
       /*$4F45*/ CYCLES(0x4f45, 6);
-                func_4e1f(0xfffe);
+                func_4e1f(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 502;
       break;
     case 502:  // $4F48
       /*$4F48*/ CYCLES(0x4f48, 6);
-                func_4e4f(0xfffe);
+                func_4e4f(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 503;
       break;
     case 503:  // $4F4B
@@ -8617,7 +8651,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 504:  // $4F5B
       /*$4F5B*/ CYCLES(0x4f5b, 6);
-                func_4ec4(0xfffe);
+                func_4ec4(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 505;
       break;
     case 505:  // $4F5E
@@ -8625,7 +8659,7 @@ void func_t001(uint16_t ret_addr) {
       /*$4F5F*/ s_a = (uint8_t)(s_a + 0x00b0);
       /*$4F61*/ s_y = ram_peek(0x00fc);
       /*$4F63*/ s_x = 0x27;
-      /*$4F65*/ func_5108(0xfffe);
+      /*$4F65*/ func_5108(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 506;
       break;
     case 506:  // $4F68
@@ -8667,7 +8701,7 @@ void func_t001(uint16_t ret_addr) {
     case 510:  // $4F83
       /*$4F83*/ CYCLES(0x4f83, 7);
                 s_a = s_x;
-      /*$4F84*/ func_4c1c(0xfffe);
+      /*$4F84*/ func_4c1c(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 511;
       break;
     case 511:  // $4F87
@@ -8735,7 +8769,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 518:  // $4FCD
       /*$4FCD*/ CYCLES(0x4fcd, 6);
-                func_4c7c(0xfffe);
+                func_4c7c(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 519;
       break;
     case 519:  // $4FD0
@@ -8768,12 +8802,12 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 520:  // $4FFB
       /*$4FFB*/ CYCLES(0x4ffb, 6);
-                func_4c6e(0x0000);
+                func_4c6e(0x0000); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = find_block_id_func_t001(0x4ffb, pop16() + 1);;
       break;
     case 521:  // $4FFE
       /*$4FFE*/ CYCLES(0x4ffe, 6);
-                func_4c7c(0xfffe);
+                func_4c7c(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 522;
       break;
     case 522:  // $5001
@@ -8805,12 +8839,12 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 523:  // $502A
       /*$502A*/ CYCLES(0x502a, 6);
-                func_4c6e(0x0000);
+                func_4c6e(0x0000); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = find_block_id_func_t001(0x502a, pop16() + 1);;
       break;
     case 524:  // $502D
       /*$502D*/ CYCLES(0x502d, 6);
-                func_4c7c(0xfffe);
+                func_4c7c(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 525;
       break;
     case 525:  // $5030
@@ -8838,12 +8872,12 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 526:  // $5056
       /*$5056*/ CYCLES(0x5056, 6);
-                func_4c6e(0x0000);
+                func_4c6e(0x0000); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = find_block_id_func_t001(0x5056, pop16() + 1);;
       break;
     case 527:  // $5059
       /*$5059*/ CYCLES(0x5059, 6);
-                func_4c7c(0xfffe);
+                func_4c7c(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 528;
       break;
     case 528:  // $505C
@@ -8871,7 +8905,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 529:  // $507E
       /*$507E*/ CYCLES(0x507e, 6);
-                func_4c6e(0x0000);
+                func_4c6e(0x0000); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = find_block_id_func_t001(0x507e, pop16() + 1);;
       break;
     case 530:  // $5081
@@ -8909,7 +8943,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 533:  // $50B1
       /*$50B1*/ CYCLES(0x50b1, 6);
-                func_4c36(0xfffe);
+                func_4c36(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 534;
       break;
     case 534:  // $50B4
@@ -8941,7 +8975,7 @@ void func_t001(uint16_t ret_addr) {
     case 537:  // $50C5
       /*$50C5*/ CYCLES(0x50c5, 9);
                 s_y = 0x00;
-      /*$50C7*/ func_50a1(0xfffe);
+      /*$50C7*/ func_50a1(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 538;
       break;
     case 538:  // $50CA
@@ -9164,7 +9198,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 561:  // $51BE
       /*$51BE*/ CYCLES(0x51be, 6);
-                func_51e8(0xfffe);
+                func_51e8(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 562;
       break;
     case 562:  // $51C1
@@ -9191,13 +9225,13 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 565:  // $51CF
       /*$51CF*/ CYCLES(0x51cf, 6);
-                func_51e8(0xfffe);
+                func_51e8(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 566;
       break;
     case 566:  // $51D2
       /*$51D2*/ CYCLES(0x51d2, 9);
                 ram_poke(0x00e0, s_a);
-      /*$51D4*/ func_51e8(0xfffe);
+      /*$51D4*/ func_51e8(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 567;
       break;
     case 567:  // $51D7
@@ -9209,7 +9243,7 @@ void func_t001(uint16_t ret_addr) {
       /*$51DC*/ CYCLES(0x51dc, 12);
                 s_x = ram_peek(0x00e0);
       /*$51DE*/ s_y = ram_peek(0x00e1);
-      /*$51E0*/ func_5108(0xfffe);
+      /*$51E0*/ func_5108(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 569;
       break;
     case 569:  // $51E3
@@ -9295,7 +9329,7 @@ void func_t001(uint16_t ret_addr) {
                 s_y = ram_peek(0x1405);
       /*$5240*/ ram_poke(0x0000, 0x0b);
       /*$5242*/ s_a = ram_peek(0x1500);
-      /*$5245*/ func_4c1c(0xfffe);
+      /*$5245*/ func_4c1c(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 579;
       break;
     case 579:  // $5248
@@ -9388,7 +9422,7 @@ void func_t001(uint16_t ret_addr) {
       /*$52CE*/ ram_poke(0x0007, ram_peek((0x0820 + tmp6_U8)));
       /*$52D0*/ s_y = ram_peek(0x1501);
       /*$52D3*/ s_x = ram_peek(0x1500);
-      /*$52D6*/ func_502d(0xfffe);
+      /*$52D6*/ func_502d(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 591;
       break;
     case 591:  // $52D9
@@ -9398,7 +9432,7 @@ void func_t001(uint16_t ret_addr) {
       /*$52E3*/ ram_poke(0x0007, ram_peek((0x0860 + tmp2_U8)));
       /*$52E8*/ s_y = (uint8_t)(ram_peek(0x1501) - 0x01);
       /*$52ED*/ s_x = (uint8_t)(ram_peek(0x1500) - 0x02);
-      /*$52EE*/ func_4c7c(0xfffe);
+      /*$52EE*/ func_4c7c(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 592;
       break;
     case 592:  // $52F1
@@ -9463,7 +9497,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 599:  // $5325
       /*$5325*/ CYCLES(0x5325, 6);
-                func_4c6e(0xfffe);
+                func_4c6e(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 600;
       break;
     case 600:  // $5328
@@ -9480,7 +9514,7 @@ void func_t001(uint16_t ret_addr) {
       /*$534B*/ tmp2_U8 = ram_peek(0x1502);
                 s_x = tmp2_U8;
       /*$534E*/ ram_poke(0x1500, tmp2_U8);
-      /*$5351*/ func_4c7c(0xfffe);
+      /*$5351*/ func_4c7c(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 601;
       break;
     case 601:  // $5354
@@ -9538,7 +9572,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 606:  // $5388
       /*$5388*/ CYCLES(0x5388, 6);
-                func_4c6e(0xfffe);
+                func_4c6e(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 607;
       break;
     case 607:  // $538B
@@ -9567,7 +9601,7 @@ void func_t001(uint16_t ret_addr) {
       /*$53A3*/ CYCLES(0x53a3, 7);
                 tmp2_U8 = pop8();
                 s_a = tmp2_U8;
-      /*$53A4*/ func_598d(0xfffe);
+      /*$53A4*/ func_598d(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 611;
       break;
     case 611:  // $53A7
@@ -9597,7 +9631,7 @@ void func_t001(uint16_t ret_addr) {
       /*$53C5*/ ram_poke(0x0007, ram_peek((0x0820 + tmp2_U8)));
       /*$53C7*/ s_x = ram_peek(0x1502);
       /*$53CA*/ s_y = ram_peek(0x1503);
-      /*$53CD*/ func_5059(0xfffe);
+      /*$53CD*/ func_5059(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 616;
       break;
     case 616:  // $53D0
@@ -9686,7 +9720,7 @@ void func_t001(uint16_t ret_addr) {
                 tmp4_U16 = tmp3_U16 + 0x000b;
                 s_status_v = ovf8((uint8_t)tmp4_U16, (uint8_t)tmp3_U16, (uint8_t)0x000b);
                 s_a = ((uint8_t)tmp4_U16);
-      /*$5422*/ func_4c1c(0xfffe);
+      /*$5422*/ func_4c1c(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 626;
       break;
     case 626:  // $5425
@@ -9730,7 +9764,7 @@ void func_t001(uint16_t ret_addr) {
                 tmp4_U16 = tmp3_U16 - 0x0004;
                 s_status_v = ovf8((uint8_t)tmp4_U16, (uint8_t)tmp3_U16, (uint8_t)0xfffb);
                 s_a = ((uint8_t)tmp4_U16);
-      /*$5446*/ func_4c1c(0xfffe);
+      /*$5446*/ func_4c1c(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 632;
       break;
     case 632:  // $5449
@@ -9777,7 +9811,7 @@ void func_t001(uint16_t ret_addr) {
                 tmp6_U8 = (uint8_t)tmp3_U16;
                 s_a = tmp6_U8;
       /*$5474*/ ram_poke((0x1510 + s_y), tmp6_U8);
-      /*$5477*/ func_4c1c(0xfffe);
+      /*$5477*/ func_4c1c(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 639;
       break;
     case 639:  // $547A
@@ -9797,7 +9831,7 @@ void func_t001(uint16_t ret_addr) {
                 tmp3_U16 = tmp4_U16 - 0x0004;
                 s_status_v = ovf8((uint8_t)tmp3_U16, (uint8_t)tmp4_U16, (uint8_t)0xfffb);
                 s_a = ((uint8_t)tmp3_U16);
-      /*$5490*/ func_4c1c(0xfffe);
+      /*$5490*/ func_4c1c(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 642;
       break;
     case 642:  // $5493
@@ -9817,7 +9851,7 @@ void func_t001(uint16_t ret_addr) {
                 tmp4_U16 = tmp3_U16 + 0x0003;
                 s_status_v = ovf8((uint8_t)tmp4_U16, (uint8_t)tmp3_U16, (uint8_t)0x0003);
                 s_a = ((uint8_t)tmp4_U16);
-      /*$54A8*/ func_4c1c(0xfffe);
+      /*$54A8*/ func_4c1c(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 644;
       break;
     case 644:  // $54AB
@@ -9850,7 +9884,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 648:  // $54BD
       /*$54BD*/ CYCLES(0x54bd, 6);
-                func_54dd(0xfffe);
+                func_54dd(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 649;
       break;
     case 649:  // $54C0
@@ -9863,7 +9897,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 651:  // $54C7
       /*$54C7*/ CYCLES(0x54c7, 6);
-                func_54dd(0xfffe);
+                func_54dd(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 652;
       break;
     case 652:  // $54CA
@@ -9876,7 +9910,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 654:  // $54D1
       /*$54D1*/ CYCLES(0x54d1, 6);
-                func_54e5(0xfffe);
+                func_54e5(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 655;
       break;
     case 655:  // $54D4
@@ -9885,7 +9919,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 656:  // $54D7
       /*$54D7*/ CYCLES(0x54d7, 6);
-                func_54e5(0xfffe);
+                func_54e5(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 657;
       break;
     case 657:  // $54DA
@@ -9928,12 +9962,12 @@ void func_t001(uint16_t ret_addr) {
                 tmp3_U16 = tmp4_U16 + 0x0009;
                 s_status_v = ovf8((uint8_t)tmp3_U16, (uint8_t)tmp4_U16, (uint8_t)0x0009);
                 s_a = ((uint8_t)tmp3_U16);
-                func_54f5(0x0000);
+                func_54f5(0x0000); if (s_native_depth <= depth) return;
                 block_id = find_block_id_func_t001(0x54f3, pop16() + 1);;
       break;
     case 662:  // $54F5
       /*$54F5*/ CYCLES(0x54f5, 6);
-                func_4c1c(0xfffe);
+                func_4c1c(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 663;
       break;
     case 663:  // $54F8
@@ -9966,7 +10000,7 @@ void func_t001(uint16_t ret_addr) {
                 tmp4_U16 = tmp3_U16 - 0x0002;
                 s_status_v = ovf8((uint8_t)tmp4_U16, (uint8_t)tmp3_U16, (uint8_t)0xfffd);
                 s_a = ((uint8_t)tmp4_U16);
-      /*$550C*/ func_54f5(0xfffe);
+      /*$550C*/ func_54f5(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 667;
       break;
     case 667:  // $550F
@@ -10034,7 +10068,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 675:  // $5542
       /*$5542*/ CYCLES(0x5542, 6);
-                func_5837(0xfffe);
+                func_5837(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 676;
       break;
     case 676:  // $5545
@@ -10083,7 +10117,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 681:  // $557C
       /*$557C*/ CYCLES(0x557c, 6);
-                func_5837(0xfffe);
+                func_5837(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 682;
       break;
     case 682:  // $557F
@@ -10118,7 +10152,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 687:  // $559A
       /*$559A*/ CYCLES(0x559a, 6);
-                func_5855(0xfffe);
+                func_5855(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 688;
       break;
     case 688:  // $559D
@@ -10182,7 +10216,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 695:  // $55E2
       /*$55E2*/ CYCLES(0x55e2, 6);
-                func_5855(0xfffe);
+                func_5855(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 696;
       break;
     case 696:  // $55E5
@@ -10230,7 +10264,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 703:  // $5609
       /*$5609*/ CYCLES(0x5609, 6);
-                func_5855(0xfffe);
+                func_5855(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 704;
       break;
     case 704:  // $560C
@@ -10292,7 +10326,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 711:  // $564E
       /*$564E*/ CYCLES(0x564e, 6);
-                func_5855(0xfffe);
+                func_5855(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 712;
       break;
     case 712:  // $5651
@@ -10340,7 +10374,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 719:  // $5675
       /*$5675*/ CYCLES(0x5675, 6);
-                func_5883(0xfffe);
+                func_5883(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 720;
       break;
     case 720:  // $5678
@@ -10407,7 +10441,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 727:  // $56C4
       /*$56C4*/ CYCLES(0x56c4, 6);
-                func_5883(0xfffe);
+                func_5883(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 728;
       break;
     case 728:  // $56C7
@@ -10461,7 +10495,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 736:  // $56F0
       /*$56F0*/ CYCLES(0x56f0, 6);
-                func_58b9(0xfffe);
+                func_58b9(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 737;
       break;
     case 737:  // $56F3
@@ -10536,7 +10570,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 745:  // $573E
       /*$573E*/ CYCLES(0x573e, 6);
-                func_58b9(0xfffe);
+                func_58b9(0xfffe); if (s_native_depth <= depth) return;
       /*$5741*/ CYCLES(0x5741, 9);
                 s_x = ram_peek(0x001f);
       /*$5743*/ branchTarget = true; block_id = 801;
@@ -10581,7 +10615,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 752:  // $5765
       /*$5765*/ CYCLES(0x5765, 6);
-                func_58ee(0xfffe);
+                func_58ee(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 753;
       break;
     case 753:  // $5768
@@ -10642,7 +10676,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 760:  // $57AE
       /*$57AE*/ CYCLES(0x57ae, 6);
-                func_58ee(0xfffe);
+                func_58ee(0xfffe); if (s_native_depth <= depth) return;
       /*$57B1*/ CYCLES(0x57b1, 9);
                 s_x = ram_peek(0x001f);
       /*$57B3*/ branchTarget = true; block_id = 801;
@@ -10689,7 +10723,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 767:  // $57D6
       /*$57D6*/ CYCLES(0x57d6, 6);
-                func_5924(0xfffe);
+                func_5924(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 768;
       break;
     case 768:  // $57D9
@@ -10758,7 +10792,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 776:  // $581E
       /*$581E*/ CYCLES(0x581e, 6);
-                func_5924(0xfffe);
+                func_5924(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 777;
       break;
     case 777:  // $5821
@@ -10835,7 +10869,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 784:  // $5880
       /*$5880*/ CYCLES(0x5880, 6);
-                func_4c6e(0x0000);
+                func_4c6e(0x0000); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = find_block_id_func_t001(0x5880, pop16() + 1);;
       break;
     case 785:  // $5883
@@ -10877,7 +10911,7 @@ void func_t001(uint16_t ret_addr) {
     case 788:  // $58B3
       /*$58B3*/ CYCLES(0x58b3, 11);
       /*$58B5*/ s_y = (uint8_t)(ram_peek(0x0005) + 0x01);
-      /*$58B6*/ func_4c6e(0x0000);
+      /*$58B6*/ func_4c6e(0x0000); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = find_block_id_func_t001(0x58b6, pop16() + 1);;
       break;
     case 789:  // $58B9
@@ -10920,7 +10954,7 @@ void func_t001(uint16_t ret_addr) {
     case 792:  // $58E8
       /*$58E8*/ CYCLES(0x58e8, 11);
       /*$58EA*/ s_y = (uint8_t)(ram_peek(0x0005) + 0x01);
-      /*$58EB*/ func_4c6e(0x0000);
+      /*$58EB*/ func_4c6e(0x0000); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = find_block_id_func_t001(0x58eb, pop16() + 1);;
       break;
     case 793:  // $58EE
@@ -10961,7 +10995,7 @@ void func_t001(uint16_t ret_addr) {
     case 796:  // $591E
       /*$591E*/ CYCLES(0x591e, 11);
       /*$5920*/ s_y = (uint8_t)(ram_peek(0x0005) - 0x01);
-      /*$5921*/ func_4c6e(0x0000);
+      /*$5921*/ func_4c6e(0x0000); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = find_block_id_func_t001(0x5921, pop16() + 1);;
       break;
     case 797:  // $5924
@@ -11003,7 +11037,7 @@ void func_t001(uint16_t ret_addr) {
     case 800:  // $5953
       /*$5953*/ CYCLES(0x5953, 11);
       /*$5955*/ s_y = (uint8_t)(ram_peek(0x0005) - 0x01);
-      /*$5956*/ func_4c6e(0x0000);
+      /*$5956*/ func_4c6e(0x0000); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = find_block_id_func_t001(0x5956, pop16() + 1);;
       break;
     case 801:  // $5959
@@ -11071,7 +11105,7 @@ void func_t001(uint16_t ret_addr) {
       /*$59AA*/ CYCLES(0x59aa, 12);
                 ram_poke(0x001f, s_x);
       /*$59AC*/ ram_poke(0x001e, s_y);
-      /*$59AE*/ func_598d(0xfffe);
+      /*$59AE*/ func_598d(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 808;
       break;
     case 808:  // $59B1
@@ -11267,7 +11301,7 @@ void func_t001(uint16_t ret_addr) {
       /*$5A3B*/ CYCLES(0x5a3b, 14);
                 s_a = ram_peek(0x1407);
       /*$5A3E*/ s_x = 0x0a;
-      /*$5A40*/ func_4c00(0xfffe);
+      /*$5A40*/ func_4c00(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 848;
       break;
     case 848:  // $5A43
@@ -11295,7 +11329,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 851:  // $5A51
       /*$5A51*/ CYCLES(0x5a51, 6);
-                func_4c36(0xfffe);
+                func_4c36(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 852;
       break;
     case 852:  // $5A54
@@ -11305,21 +11339,21 @@ void func_t001(uint16_t ret_addr) {
     case 853:  // $5A58
       /*$5A58*/ CYCLES(0x5a58, 9);
                 s_a = 0xf5;
-      /*$5A5A*/ func_4c4b(0xfffe);
+      /*$5A5A*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 854;
       break;
     case 854:  // $5A5D
       /*$5A5D*/ CYCLES(0x5a5d, 18);
       /*$5A5F*/ ram_poke((0x1570 + s_y), (s_a & 0xfe));
       /*$5A62*/ s_a = 0x22;
-      /*$5A64*/ func_4c4b(0xfffe);
+      /*$5A64*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 855;
       break;
     case 855:  // $5A67
       /*$5A67*/ CYCLES(0x5a67, 12);
                 ram_poke(0x0000, s_a);
       /*$5A69*/ s_x = 0x00;
-      /*$5A6B*/ func_4c36(0xfffe);
+      /*$5A6B*/ func_4c36(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 856;
       break;
     case 856:  // $5A6E
@@ -11339,21 +11373,21 @@ void func_t001(uint16_t ret_addr) {
     case 859:  // $5A7C
       /*$5A7C*/ CYCLES(0x5a7c, 9);
                 s_a = 0xb2;
-      /*$5A7E*/ func_4c4b(0xfffe);
+      /*$5A7E*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 860;
       break;
     case 860:  // $5A81
       /*$5A81*/ CYCLES(0x5a81, 14);
                 ram_poke((0x15f0 + s_y), s_a);
       /*$5A84*/ s_a = 0x45;
-      /*$5A86*/ func_4c4b(0xfffe);
+      /*$5A86*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 861;
       break;
     case 861:  // $5A89
       /*$5A89*/ CYCLES(0x5a89, 12);
                 ram_poke(0x0000, s_a);
       /*$5A8B*/ s_x = 0x00;
-      /*$5A8D*/ func_4c36(0xfffe);
+      /*$5A8D*/ func_4c36(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 862;
       break;
     case 862:  // $5A90
@@ -11372,7 +11406,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 865:  // $5A9D
       /*$5A9D*/ CYCLES(0x5a9d, 6);
-                func_4c36(0xfffe);
+                func_4c36(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 866;
       break;
     case 866:  // $5AA0
@@ -11409,7 +11443,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 870:  // $5AB8
       /*$5AB8*/ CYCLES(0x5ab8, 6);
-                func_4c36(0xfffe);
+                func_4c36(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 871;
       break;
     case 871:  // $5ABB
@@ -11419,14 +11453,14 @@ void func_t001(uint16_t ret_addr) {
     case 872:  // $5ABF
       /*$5ABF*/ CYCLES(0x5abf, 9);
                 s_a = 0xe6;
-      /*$5AC1*/ func_4c4b(0xfffe);
+      /*$5AC1*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 873;
       break;
     case 873:  // $5AC4
       /*$5AC4*/ CYCLES(0x5ac4, 23);
       /*$5AC9*/ ram_poke((0x1900 + s_y), ((uint8_t)(s_a + 0x0006) | 0x01));
       /*$5ACC*/ s_x = 0x06;
-      /*$5ACE*/ func_4c36(0xfffe);
+      /*$5ACE*/ func_4c36(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 874;
       break;
     case 874:  // $5AD1
@@ -11442,7 +11476,7 @@ void func_t001(uint16_t ret_addr) {
       /*$5AD5*/ CYCLES(0x5ad5, 12);
                 ram_poke(0x0000, s_x);
       /*$5AD7*/ s_a = 0x1c;
-      /*$5AD9*/ func_4c4b(0xfffe);
+      /*$5AD9*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 877;
       break;
     case 877:  // $5ADC
@@ -11454,14 +11488,14 @@ void func_t001(uint16_t ret_addr) {
     case 878:  // $5AE4
       /*$5AE4*/ CYCLES(0x5ae4, 9);
                 s_a = 0xa6;
-      /*$5AE6*/ func_4c4b(0xfffe);
+      /*$5AE6*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 879;
       break;
     case 879:  // $5AE9
       /*$5AE9*/ CYCLES(0x5ae9, 19);
       /*$5AEC*/ ram_poke((0x1910 + s_y), (uint8_t)(s_a + 0x0006));
       /*$5AEF*/ s_x = 0x06;
-      /*$5AF1*/ func_4c36(0xfffe);
+      /*$5AF1*/ func_4c36(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 880;
       break;
     case 880:  // $5AF4
@@ -11477,7 +11511,7 @@ void func_t001(uint16_t ret_addr) {
       /*$5AF8*/ CYCLES(0x5af8, 12);
                 ram_poke(0x0000, s_x);
       /*$5AFA*/ s_a = 0x2c;
-      /*$5AFC*/ func_4c4b(0xfffe);
+      /*$5AFC*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 883;
       break;
     case 883:  // $5AFF
@@ -11487,7 +11521,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 884:  // $5B07
       /*$5B07*/ CYCLES(0x5b07, 6);
-                func_4c36(0xfffe);
+                func_4c36(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 885;
       break;
     case 885:  // $5B0A
@@ -11496,7 +11530,7 @@ void func_t001(uint16_t ret_addr) {
                 ram_poke((0x1920 + tmp1_U8), (s_a & 0x01));
       /*$5B12*/ ram_poke((0x1930 + tmp1_U8), (tmp1_U8 & 0x03));
       /*$5B15*/ s_a = ram_peek(0x0c0e);
-      /*$5B18*/ func_4c4b(0xfffe);
+      /*$5B18*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 886;
       break;
     case 886:  // $5B1B
@@ -11532,7 +11566,7 @@ void func_t001(uint16_t ret_addr) {
     case 889:  // $5B45
       /*$5B45*/ CYCLES(0x5b45, 9);
                 s_a = 0xf1;
-      /*$5B47*/ func_4c4b(0xfffe);
+      /*$5B47*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 890;
       break;
     case 890:  // $5B4A
@@ -11542,20 +11576,20 @@ void func_t001(uint16_t ret_addr) {
                 s_status_v = ovf8((uint8_t)tmp5_U16, (uint8_t)tmp3_U16, (uint8_t)0x0004);
       /*$5B4D*/ ram_poke((0x1950 + s_y), ((uint8_t)tmp5_U16));
       /*$5B50*/ s_a = 0xae;
-      /*$5B52*/ func_4c4b(0xfffe);
+      /*$5B52*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 891;
       break;
     case 891:  // $5B55
       /*$5B55*/ CYCLES(0x5b55, 16);
       /*$5B58*/ ram_poke((0x1960 + s_y), (uint8_t)(s_a + 0x0004));
-      /*$5B5B*/ func_4c36(0xfffe);
+      /*$5B5B*/ func_4c36(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 892;
       break;
     case 892:  // $5B5E
       /*$5B5E*/ CYCLES(0x5b5e, 18);
       /*$5B60*/ ram_poke((0x1970 + s_y), (s_a & 0x01));
       /*$5B63*/ s_a = 0x05;
-      /*$5B65*/ func_4c4b(0xfffe);
+      /*$5B65*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 893;
       break;
     case 893:  // $5B68
@@ -11567,7 +11601,7 @@ void func_t001(uint16_t ret_addr) {
                 ram_poke((0x1980 + tmp2_U8), ((uint8_t)tmp3_U16));
       /*$5B71*/ ram_poke((0x19a0 + tmp2_U8), (tmp2_U8 & 0x03));
       /*$5B74*/ s_a = 0x20;
-      /*$5B76*/ func_4c4b(0xfffe);
+      /*$5B76*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 894;
       break;
     case 894:  // $5B79
@@ -11614,7 +11648,7 @@ void func_t001(uint16_t ret_addr) {
       /*$5B99*/ ram_poke(0x0007, ram_peek((0x088c + tmp2_U8)));
       /*$5B9B*/ s_y = ram_peek((0x15f0 + tmp7_U8));
       /*$5BA1*/ s_x = ram_peek((0x1570 + tmp7_U8));
-      /*$5BA2*/ func_4fcd(0xfffe);
+      /*$5BA2*/ func_4fcd(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 900;
       break;
     case 900:  // $5BA5
@@ -11682,13 +11716,13 @@ void func_t001(uint16_t ret_addr) {
                 tmp7_U8 = s_a;
                 ram_poke((0x1570 + s_x), tmp7_U8);
       /*$5BE1*/ s_x = tmp7_U8;
-      /*$5BE2*/ func_4ffe(0xfffe);
+      /*$5BE2*/ func_4ffe(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 907;
       break;
     case 907:  // $5BE5
       /*$5BE5*/ CYCLES(0x5be5, 11);
                 s_a = ram_peek(0x1403);
-      /*$5BE8*/ func_4c4b(0xfffe);
+      /*$5BE8*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 908;
       break;
     case 908:  // $5BEB
@@ -11804,7 +11838,7 @@ void func_t001(uint16_t ret_addr) {
       /*$5C4D*/ ram_poke(0x0007, ram_peek((0x088c + tmp7_U8)));
       /*$5C4F*/ s_y = ram_peek((0x15f0 + tmp2_U8));
       /*$5C55*/ s_x = ram_peek((0x1570 + tmp2_U8));
-      /*$5C56*/ func_4fcd(0xfffe);
+      /*$5C56*/ func_4fcd(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 925;
       break;
     case 925:  // $5C59
@@ -11839,14 +11873,14 @@ void func_t001(uint16_t ret_addr) {
       /*$5C93*/ CYCLES(0x5c93, 12);
                 s_a = 0x00;
       /*$5C95*/ s_x = 0x64;
-      /*$5C97*/ func_4dd0(0xfffe);
+      /*$5C97*/ func_4dd0(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 929;
       break;
     case 929:  // $5C9A
       /*$5C9A*/ CYCLES(0x5c9a, 9);
                 tmp2_U8 = pop8();
       /*$5C9B*/ s_x = tmp2_U8;
-      /*$5C9C*/ func_4c6e(0x0000);
+      /*$5C9C*/ func_4c6e(0x0000); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = find_block_id_func_t001(0x5c9c, pop16() + 1);;
       break;
     case 930:  // $5CA2
@@ -11886,7 +11920,7 @@ void func_t001(uint16_t ret_addr) {
     case 935:  // $5CBC
       /*$5CBC*/ CYCLES(0x5cbc, 21);
       /*$5CC3*/ ram_poke(0x0006, ((ram_peek((0x1920 + s_x)) & 0x02) ^ 0x02));
-      /*$5CC5*/ func_4c36(0xfffe);
+      /*$5CC5*/ func_4c36(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 936;
       break;
     case 936:  // $5CC8
@@ -11897,7 +11931,7 @@ void func_t001(uint16_t ret_addr) {
     case 937:  // $5CCF
       /*$5CCF*/ CYCLES(0x5ccf, 11);
                 s_a = ram_peek(0x0c0e);
-      /*$5CD2*/ func_4c4b(0xfffe);
+      /*$5CD2*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 938;
       break;
     case 938:  // $5CD5
@@ -11915,7 +11949,7 @@ void func_t001(uint16_t ret_addr) {
       /*$5CE1*/ s_a = ram_peek((0x1900 + tmp7_U8));
       /*$5CE4*/ s_x = ram_peek((0x1910 + tmp7_U8));
       /*$5CE7*/ s_y = 0x0e;
-      /*$5CE9*/ func_4d21(0xfffe);
+      /*$5CE9*/ func_4d21(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 940;
       break;
     case 940:  // $5CEC
@@ -11944,7 +11978,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 944:  // $5D0C
       /*$5D0C*/ CYCLES(0x5d0c, 6);
-                func_4c36(0xfffe);
+                func_4c36(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 945;
       break;
     case 945:  // $5D0F
@@ -11987,7 +12021,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 951:  // $5D3A
       /*$5D3A*/ CYCLES(0x5d3a, 6);
-                func_4c36(0xfffe);
+                func_4c36(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 952;
       break;
     case 952:  // $5D3D
@@ -12029,7 +12063,7 @@ void func_t001(uint16_t ret_addr) {
       /*$5D67*/ tmp7_U8 = s_y;
                 s_x = ram_peek((0x1900 + tmp7_U8));
       /*$5D6D*/ s_y = ram_peek((0x1910 + tmp7_U8));
-      /*$5D6E*/ func_4cf6(0xfffe);
+      /*$5D6E*/ func_4cf6(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 957;
       break;
     case 957:  // $5D71
@@ -12086,7 +12120,7 @@ void func_t001(uint16_t ret_addr) {
       /*$5D9C*/ s_x = ram_peek((0x1960 + tmp7_U8));
       /*$5D9F*/ s_a = ram_peek((0x1950 + tmp7_U8));
       /*$5DA2*/ s_y = 0x0a;
-      /*$5DA4*/ func_4cd0(0xfffe);
+      /*$5DA4*/ func_4cd0(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 966;
       break;
     case 966:  // $5DA7
@@ -12188,7 +12222,7 @@ void func_t001(uint16_t ret_addr) {
       /*$5DF7*/ s_x = ram_peek((0x1910 + tmp2_U8));
       /*$5DFA*/ s_a = ram_peek((0x1900 + tmp2_U8));
       /*$5DFD*/ s_y = 0x0e;
-      /*$5DFF*/ func_4d21(0xfffe);
+      /*$5DFF*/ func_4d21(0xfffe); if (s_native_depth <= depth) return;
       /*$5E02*/ CYCLES(0x5e02, 9);
                 tmp2_U8 = pop8();
       /*$5E03*/ s_x = tmp2_U8;
@@ -12205,7 +12239,7 @@ void func_t001(uint16_t ret_addr) {
       /*$5E1D*/ tmp2_U8 = ram_peek((0x1900 + tmp2_U8));
                 s_a = tmp2_U8;
       /*$5E20*/ s_x = tmp2_U8;
-      /*$5E21*/ func_4cf6(0xfffe);
+      /*$5E21*/ func_4cf6(0xfffe); if (s_native_depth <= depth) return;
       /*$5E24*/ CYCLES(0x5e24, 4);
                 s_status_c = 0x01;
       /*$5E25*/ branchTarget = true; block_id = find_block_id_func_t001(0x5e25, pop16() + 1);;
@@ -12318,14 +12352,14 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 996:  // $5E7B
       /*$5E7B*/ CYCLES(0x5e7b, 6);
-                func_4c36(0xfffe);
+                func_4c36(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 997;
       break;
     case 997:  // $5E7E
       /*$5E7E*/ CYCLES(0x5e7e, 18);
       /*$5E80*/ ram_poke((0x1970 + s_x), (s_a & 0x01));
       /*$5E83*/ s_a = 0x05;
-      /*$5E85*/ func_4c4b(0xfffe);
+      /*$5E85*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 998;
       break;
     case 998:  // $5E88
@@ -12337,7 +12371,7 @@ void func_t001(uint16_t ret_addr) {
                 s_y = tmp2_U8;
       /*$5E8D*/ ram_poke((0x1980 + tmp2_U8), ((uint8_t)tmp3_U16));
       /*$5E90*/ s_a = ram_peek(0x0c0a);
-      /*$5E93*/ func_4c4b(0xfffe);
+      /*$5E93*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 999;
       break;
     case 999:  // $5E96
@@ -12351,7 +12385,7 @@ void func_t001(uint16_t ret_addr) {
       /*$5E9B*/ s_x = ram_peek((0x1960 + tmp2_U8));
       /*$5E9E*/ s_a = ram_peek((0x1950 + tmp2_U8));
       /*$5EA1*/ s_y = 0x0a;
-      /*$5EA3*/ func_4cd0(0xfffe);
+      /*$5EA3*/ func_4cd0(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1001;
       break;
     case 1001:  // $5EA6
@@ -12416,7 +12450,7 @@ void func_t001(uint16_t ret_addr) {
       /*$5EFE*/ tmp2_U8 = ram_peek((0x1960 + tmp2_U8));
                 s_a = tmp2_U8;
       /*$5F01*/ s_y = tmp2_U8;
-      /*$5F02*/ func_4cac(0xfffe);
+      /*$5F02*/ func_4cac(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1009;
       break;
     case 1009:  // $5F05
@@ -12438,7 +12472,7 @@ void func_t001(uint16_t ret_addr) {
       /*$5F1B*/ CYCLES(0x5f1b, 14);
                 s_a = ram_peek(0x140d);
       /*$5F1E*/ s_x = 0x0a;
-      /*$5F20*/ func_4c00(0xfffe);
+      /*$5F20*/ func_4c00(0xfffe); if (s_native_depth <= depth) return;
       /*$5F23*/ CYCLES(0x5f23, 24);
       /*$5F24*/ tmp3_U16 = s_a;
                 tmp4_U16 = tmp3_U16 - 0x0001;
@@ -12459,7 +12493,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 1013:  // $5F39
       /*$5F39*/ CYCLES(0x5f39, 6);
-                func_4dd0(0xfffe);
+                func_4dd0(0xfffe); if (s_native_depth <= depth) return;
       /*$5F3C*/ CYCLES(0x5f3c, 18);
       /*$5F40*/ tmp4_U16 = ram_peek(0x140d);
                 tmp3_U16 = tmp4_U16 + 0x000a;
@@ -12478,7 +12512,7 @@ void func_t001(uint16_t ret_addr) {
     case 1015:  // $5F49
       /*$5F49*/ CYCLES(0x5f49, 16);
       /*$5F4C*/ ram_poke(0x140b, ram_peek(0x0c68));
-      /*$5F4F*/ func_4c6e(0x0000);
+      /*$5F4F*/ func_4c6e(0x0000); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = find_block_id_func_t001(0x5f4f, pop16() + 1);;
       break;
     case 1016:  // $5F52
@@ -12628,7 +12662,7 @@ void func_t001(uint16_t ret_addr) {
                 tmp4_U16 = tmp5_U16 + 0x0003;
                 s_status_v = ovf8((uint8_t)tmp4_U16, (uint8_t)tmp5_U16, (uint8_t)0x0003);
                 s_a = ((uint8_t)tmp4_U16);
-      /*$6026*/ func_4c1c(0xfffe);
+      /*$6026*/ func_4c1c(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1032;
       break;
     case 1032:  // $6029
@@ -12687,7 +12721,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 1037:  // $6070
       /*$6070*/ CYCLES(0x6070, 6);
-                func_4c6e(0x0000);
+                func_4c6e(0x0000); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = find_block_id_func_t001(0x6070, pop16() + 1);;
       break;
     case 1038:  // $6076
@@ -12758,7 +12792,7 @@ void func_t001(uint16_t ret_addr) {
       /*$609E*/ s_x = ram_peek((0x1960 + tmp7_U8));
       /*$60A1*/ s_a = ram_peek((0x1950 + tmp7_U8));
       /*$60A4*/ s_y = 0x0a;
-      /*$60A6*/ func_4cd0(0xfffe);
+      /*$60A6*/ func_4cd0(0xfffe); if (s_native_depth <= depth) return;
       /*$60A9*/ CYCLES(0x60a9, 9);
                 tmp7_U8 = pop8();
                 s_a = tmp7_U8;
@@ -12803,7 +12837,7 @@ void func_t001(uint16_t ret_addr) {
       /*$60D6*/ tmp7_U8 = ram_peek((0x1eb0 + tmp7_U8));
                 s_a = tmp7_U8;
       /*$60D9*/ s_x = tmp7_U8;
-      /*$60DA*/ func_4cf6(0xfffe);
+      /*$60DA*/ func_4cf6(0xfffe); if (s_native_depth <= depth) return;
       /*$60DD*/ CYCLES(0x60dd, 12);
                 tmp7_U8 = ram_peek(0x0000);
                 s_x = tmp7_U8;
@@ -12829,7 +12863,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 1055:  // $60F7
       /*$60F7*/ CYCLES(0x60f7, 6);
-                func_4d21(0xfffe);
+                func_4d21(0xfffe); if (s_native_depth <= depth) return;
       /*$60FA*/ CYCLES(0x60fa, 9);
                 s_x = ram_peek(0x0000);
       /*$60FC*/ ram_poke(0x142c, (uint8_t)(ram_peek(0x142c) - 0x01));
@@ -12864,7 +12898,7 @@ void func_t001(uint16_t ret_addr) {
                 s_y = tmp2_U8;
       /*$612C*/ ram_poke((0x1f10 + tmp2_U8), (uint8_t)(tmp6_U8 - 0x01));
       /*$612F*/ s_a = s_x;
-      /*$6130*/ func_4c1c(0xfffe);
+      /*$6130*/ func_4c1c(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1059;
       break;
     case 1059:  // $6133
@@ -12917,7 +12951,7 @@ void func_t001(uint16_t ret_addr) {
       /*$6177*/ tmp7_U8 = ram_peek((0x1f00 + tmp7_U8));
                 s_a = tmp7_U8;
       /*$617A*/ s_x = tmp7_U8;
-      /*$617B*/ func_4cac(0xfffe);
+      /*$617B*/ func_4cac(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1065;
       break;
     case 1065:  // $617E
@@ -12935,7 +12969,7 @@ void func_t001(uint16_t ret_addr) {
       /*$6187*/ s_x = ram_peek((0x1f10 + tmp7_U8));
       /*$618A*/ s_a = ram_peek((0x1f00 + tmp7_U8));
       /*$618D*/ s_y = 0x0c;
-      /*$618F*/ func_4cd0(0xfffe);
+      /*$618F*/ func_4cd0(0xfffe); if (s_native_depth <= depth) return;
       /*$6192*/ CYCLES(0x6192, 9);
                 s_x = ram_peek(0x0000);
       /*$6194*/ ram_poke(0x142d, (uint8_t)(ram_peek(0x142d) - 0x01));
@@ -12966,7 +13000,7 @@ void func_t001(uint16_t ret_addr) {
       /*$61B9*/ CYCLES(0x61b9, 9);
                 push8(s_a);
       /*$61BA*/ s_a = s_x;
-      /*$61BB*/ func_4c1c(0xfffe);
+      /*$61BB*/ func_4c1c(0xfffe); if (s_native_depth <= depth) return;
       /*$61BE*/ CYCLES(0x61be, 9);
                 s_x = 0x07;
       /*$61C0*/ branchTarget = true; push16(0x61c2); block_id = 413;
@@ -13151,7 +13185,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 1092:  // $625F
       /*$625F*/ CYCLES(0x625f, 6);
-                func_4c36(0xfffe);
+                func_4c36(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1093;
       break;
     case 1093:  // $6262
@@ -13161,14 +13195,14 @@ void func_t001(uint16_t ret_addr) {
     case 1094:  // $6264
       /*$6264*/ CYCLES(0x6264, 9);
                 s_a = 0xf3;
-      /*$6266*/ func_4c4b(0xfffe);
+      /*$6266*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1095;
       break;
     case 1095:  // $6269
       /*$6269*/ CYCLES(0x6269, 18);
       /*$626B*/ ram_poke((0x19c0 + s_y), (s_a | 0x01));
       /*$626E*/ s_x = 0x00;
-      /*$6270*/ func_4c36(0xfffe);
+      /*$6270*/ func_4c36(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1096;
       break;
     case 1096:  // $6273
@@ -13188,14 +13222,14 @@ void func_t001(uint16_t ret_addr) {
     case 1099:  // $627E
       /*$627E*/ CYCLES(0x627e, 9);
                 s_a = 0xb3;
-      /*$6280*/ func_4c4b(0xfffe);
+      /*$6280*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1100;
       break;
     case 1100:  // $6283
       /*$6283*/ CYCLES(0x6283, 14);
                 ram_poke((0x19d0 + s_y), s_a);
       /*$6286*/ s_x = 0x01;
-      /*$6288*/ func_4c36(0xfffe);
+      /*$6288*/ func_4c36(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1101;
       break;
     case 1101:  // $628B
@@ -13221,14 +13255,14 @@ void func_t001(uint16_t ret_addr) {
       /*$629E*/ ram_poke((0x1a00 + tmp7_U8), 0x00);
       /*$62A1*/ s_a = ram_peek(0x1421);
       /*$62A7*/ s_x = (uint8_t)(ram_peek(0x0c18) + 0x01);
-      /*$62A8*/ func_4c00(0xfffe);
+      /*$62A8*/ func_4c00(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1105;
       break;
     case 1105:  // $62AB
       /*$62AB*/ CYCLES(0x62ab, 16);
                 ram_poke((0x1a10 + s_y), s_a);
       /*$62AE*/ s_a = ram_peek(0x0c13);
-      /*$62B1*/ func_4c4b(0xfffe);
+      /*$62B1*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1106;
       break;
     case 1106:  // $62B4
@@ -13270,7 +13304,7 @@ void func_t001(uint16_t ret_addr) {
       /*$62D4*/ s_x = ram_peek((0x19d0 + tmp2_U8));
       /*$62D7*/ s_a = ram_peek((0x19c0 + tmp2_U8));
       /*$62DA*/ s_y = 0x0d;
-      /*$62DC*/ func_4d21(0xfffe);
+      /*$62DC*/ func_4d21(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1111;
       break;
     case 1111:  // $62DF
@@ -13285,7 +13319,7 @@ void func_t001(uint16_t ret_addr) {
     case 1112:  // $62E6
       /*$62E6*/ CYCLES(0x62e6, 11);
                 s_a = ram_peek(0x0c1b);
-      /*$62E9*/ func_4c4b(0xfffe);
+      /*$62E9*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1113;
       break;
     case 1113:  // $62EC
@@ -13296,7 +13330,7 @@ void func_t001(uint16_t ret_addr) {
       /*$62F4*/ tmp2_U8 = (uint8_t)(ram_peek(0x0c17) << 0x01);
                 s_a = tmp2_U8;
       /*$62F5*/ push8(tmp2_U8);
-      /*$62F6*/ func_4c4b(0xfffe);
+      /*$62F6*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1114;
       break;
     case 1114:  // $62F9
@@ -13308,7 +13342,7 @@ void func_t001(uint16_t ret_addr) {
       /*$62FF*/ ram_poke((0x19e0 + s_y), (((uint8_t)tmp4_U16) & 0xfe));
       /*$6302*/ tmp2_U8 = pop8();
                 s_a = tmp2_U8;
-      /*$6303*/ func_4c4b(0xfffe);
+      /*$6303*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1115;
       break;
     case 1115:  // $6306
@@ -13328,7 +13362,7 @@ void func_t001(uint16_t ret_addr) {
     case 1116:  // $6314
       /*$6314*/ CYCLES(0x6314, 11);
                 s_a = ram_peek(0x0c13);
-      /*$6317*/ func_4c4b(0xfffe);
+      /*$6317*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
       /*$631A*/ CYCLES(0x631a, 14);
                 ram_poke((0x1a20 + s_y), s_a);
       /*$631D*/ s_x = ram_peek(0x0000);
@@ -13472,7 +13506,7 @@ void func_t001(uint16_t ret_addr) {
       /*$63A7*/ tmp2_U8 = ram_peek((0x19c0 + tmp2_U8));
                 s_a = tmp2_U8;
       /*$63AA*/ s_x = tmp2_U8;
-      /*$63AB*/ func_4cf6(0xfffe);
+      /*$63AB*/ func_4cf6(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1139;
       break;
     case 1139:  // $63AE
@@ -13503,7 +13537,7 @@ void func_t001(uint16_t ret_addr) {
       /*$63C9*/ ram_poke((0x1a70 + tmp2_U8), 0x01);
       /*$63CC*/ ram_poke(0x0000, tmp7_U8);
       /*$63CF*/ s_x = tmp2_U8;
-      /*$63D0*/ func_67b8(0xfffe);
+      /*$63D0*/ func_67b8(0xfffe); if (s_native_depth <= depth) return;
       /*$63D3*/ CYCLES(0x63d3, 38);
                 tmp2_U8 = ram_peek(0x0000);
                 s_x = tmp2_U8;
@@ -13603,7 +13637,7 @@ void func_t001(uint16_t ret_addr) {
       /*$6451*/ s_x = ram_peek((0x1a60 + tmp7_U8));
       /*$6454*/ s_a = ram_peek((0x1a50 + tmp7_U8));
       /*$6457*/ s_y = 0x0d;
-      /*$6459*/ func_4d21(0xfffe);
+      /*$6459*/ func_4d21(0xfffe); if (s_native_depth <= depth) return;
       /*$645C*/ CYCLES(0x645c, 24);
                 tmp7_U8 = ram_peek(0x0000);
                 s_x = tmp7_U8;
@@ -13669,7 +13703,7 @@ void func_t001(uint16_t ret_addr) {
       /*$649C*/ tmp7_U8 = ram_peek(0x08d4);
                 s_a = tmp7_U8;
       /*$649F*/ ram_poke(0x0007, tmp7_U8);
-      /*$64A1*/ func_4cf6(0xfffe);
+      /*$64A1*/ func_4cf6(0xfffe); if (s_native_depth <= depth) return;
       /*$64A4*/ CYCLES(0x64a4, 7);
                 tmp7_U8 = ram_peek(0x0000);
                 s_x = tmp7_U8;
@@ -13695,18 +13729,18 @@ void func_t001(uint16_t ret_addr) {
                 s_a = tmp2_U8;
       /*$64BC*/ ram_poke((0x1aa0 + tmp7_U8), tmp2_U8);
       /*$64BF*/ s_x = ram_peek(0x1500);
-      /*$64C2*/ func_6500(0xfffe);
+      /*$64C2*/ func_6500(0xfffe); if (s_native_depth <= depth) return;
       /*$64C5*/ CYCLES(0x64c5, 21);
                 ram_poke((0x1ac0 + tmp7_U8), s_a);
       /*$64C8*/ s_a = ram_peek((0x1ab0 + tmp7_U8));
       /*$64CB*/ s_x = ram_peek(0x1501);
-      /*$64CE*/ func_6500(0xfffe);
+      /*$64CE*/ func_6500(0xfffe); if (s_native_depth <= depth) return;
       /*$64D1*/ CYCLES(0x64d1, 36);
                 ram_poke((0x1ad0 + tmp7_U8), s_a);
       /*$64D7*/ ram_poke((0x1af0 + tmp7_U8), ram_peek(0x0c16));
       /*$64DE*/ ram_poke((0x1ae0 + tmp7_U8), (ram_peek(0x004e) & 0x01));
       /*$64E1*/ s_a = 0x03;
-      /*$64E3*/ func_4c4b(0xfffe);
+      /*$64E3*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
       /*$64E6*/ CYCLES(0x64e6, 11);
       /*$64E9*/ ram_poke((0x1b00 + tmp7_U8), (uint8_t)(s_a - 0x0001));
                 block_id = 1165;
@@ -13714,7 +13748,7 @@ void func_t001(uint16_t ret_addr) {
     case 1165:  // $64EC
       /*$64EC*/ CYCLES(0x64ec, 9);
                 s_a = 0x03;
-      /*$64EE*/ func_4c4b(0xfffe);
+      /*$64EE*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
       /*$64F1*/ CYCLES(0x64f1, 19);
       /*$64F2*/ tmp5_U16 = s_a;
                 tmp4_U16 = tmp5_U16 - 0x0001;
@@ -13748,7 +13782,7 @@ void func_t001(uint16_t ret_addr) {
                 s_status_v = ovf8((uint8_t)tmp4_U16, (uint8_t)tmp5_U16, (uint8_t)(~tmp3_U16));
       /*$6510*/ ram_poke(0x0006, ((uint8_t)tmp4_U16));
       /*$6512*/ s_a = 0x05;
-      /*$6514*/ func_4c4b(0xfffe);
+      /*$6514*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
       /*$6517*/ CYCLES(0x6517, 14);
       /*$6518*/ tmp4_U16 = s_a - 0x0002;
       /*$651B*/ tmp3_U16 = tmp4_U16 & 0x00ff;
@@ -13807,7 +13841,7 @@ void func_t001(uint16_t ret_addr) {
       /*$6539*/ s_x = ram_peek((0x1ab0 + tmp7_U8));
       /*$653C*/ s_a = ram_peek((0x1aa0 + tmp7_U8));
       /*$653F*/ s_y = 0x07;
-      /*$6541*/ func_4cd0(0xfffe);
+      /*$6541*/ func_4cd0(0xfffe); if (s_native_depth <= depth) return;
       /*$6544*/ CYCLES(0x6544, 12);
                 tmp7_U8 = ram_peek(0x0000);
                 s_x = tmp7_U8;
@@ -13955,7 +13989,7 @@ void func_t001(uint16_t ret_addr) {
       /*$65CF*/ tmp7_U8 = pop8();
                 s_a = tmp7_U8;
       /*$65D0*/ s_y = tmp7_U8;
-      /*$65D1*/ func_4cac(0xfffe);
+      /*$65D1*/ func_4cac(0xfffe); if (s_native_depth <= depth) return;
       /*$65D4*/ CYCLES(0x65d4, 9);
                 s_x = ram_peek(0x0000);
       /*$65D6*/ branchTarget = true; block_id = 1171;
@@ -14102,7 +14136,7 @@ void func_t001(uint16_t ret_addr) {
       /*$667B*/ s_x = ram_peek((0x1ab0 + tmp2_U8));
       /*$667E*/ s_a = ram_peek((0x1aa0 + tmp2_U8));
       /*$6681*/ s_y = 0x07;
-      /*$6683*/ func_4cd0(0xfffe);
+      /*$6683*/ func_4cd0(0xfffe); if (s_native_depth <= depth) return;
       /*$6686*/ CYCLES(0x6686, 9);
                 tmp2_U8 = pop8();
       /*$6687*/ s_x = tmp2_U8;
@@ -14114,7 +14148,7 @@ void func_t001(uint16_t ret_addr) {
       /*$6693*/ ram_poke(0x1412, 0x01);
       /*$6696*/ s_a = 0x00;
       /*$6698*/ s_x = 0x19;
-      /*$669A*/ func_4dd0(0xfffe);
+      /*$669A*/ func_4dd0(0xfffe); if (s_native_depth <= depth) return;
       /*$669D*/ CYCLES(0x669d, 4);
                 s_status_c = 0x01;
       /*$669E*/ branchTarget = true; block_id = find_block_id_func_t001(0x669e, pop16() + 1);;
@@ -14200,7 +14234,7 @@ void func_t001(uint16_t ret_addr) {
       /*$66D7*/ s_x = ram_peek((0x19d0 + tmp7_U8));
       /*$66DA*/ s_a = ram_peek((0x19c0 + tmp7_U8));
       /*$66DD*/ s_y = 0x0d;
-      /*$66DF*/ func_4d21(0xfffe);
+      /*$66DF*/ func_4d21(0xfffe); if (s_native_depth <= depth) return;
       /*$66E2*/ CYCLES(0x66e2, 33);
                 tmp7_U8 = pop8();
       /*$66E3*/ push8(tmp7_U8);
@@ -14222,7 +14256,7 @@ void func_t001(uint16_t ret_addr) {
       /*$66FA*/ CYCLES(0x66fa, 12);
                 s_a = 0x03;
       /*$66FC*/ s_x = 0xe8;
-      /*$66FE*/ func_4dd0(0xfffe);
+      /*$66FE*/ func_4dd0(0xfffe); if (s_native_depth <= depth) return;
       /*$6701*/ CYCLES(0x6701, 23);
       /*$6704*/ ram_poke(0x1414, ram_peek(0x0c22));
       /*$6707*/ s_status_not_z = 0x00;
@@ -14320,7 +14354,7 @@ void func_t001(uint16_t ret_addr) {
       /*$6748*/ s_x = ram_peek((0x1a60 + tmp7_U8));
       /*$674B*/ s_a = ram_peek((0x1a50 + tmp7_U8));
       /*$674E*/ s_y = 0x0d;
-      /*$6750*/ func_4d21(0xfffe);
+      /*$6750*/ func_4d21(0xfffe); if (s_native_depth <= depth) return;
       /*$6753*/ CYCLES(0x6753, 38);
                 tmp7_U8 = pop8();
       /*$6755*/ push8(tmp7_U8);
@@ -14342,7 +14376,7 @@ void func_t001(uint16_t ret_addr) {
       /*$676E*/ CYCLES(0x676e, 12);
                 s_a = 0x00;
       /*$6770*/ s_x = 0xc8;
-      /*$6772*/ func_4dd0(0xfffe);
+      /*$6772*/ func_4dd0(0xfffe); if (s_native_depth <= depth) return;
       /*$6775*/ CYCLES(0x6775, 35);
       /*$6778*/ ram_poke(0x1406, ram_peek(0x0c34));
       /*$677E*/ ram_poke(0x1422, ram_peek(0x0c35));
@@ -14361,20 +14395,20 @@ void func_t001(uint16_t ret_addr) {
     case 1248:  // $678F
       /*$678F*/ CYCLES(0x678f, 11);
                 s_a = ram_peek(0x1425);
-      /*$6792*/ func_4c4b(0xfffe);
+      /*$6792*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
       /*$6795*/ CYCLES(0x6795, 16);
                 ram_poke(0x1424, s_a);
       /*$6798*/ s_a = ram_peek(0x140f);
-      /*$679B*/ func_4c4b(0xfffe);
+      /*$679B*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
       /*$679E*/ CYCLES(0x679e, 7);
                 s_x = s_a;
-      /*$679F*/ func_64a8(0xfffe);
+      /*$679F*/ func_64a8(0xfffe); if (s_native_depth <= depth) return;
       /*$67A2*/ CYCLES(0x67a2, 11);
                 s_a = ram_peek(0x140f);
-      /*$67A5*/ func_4c4b(0xfffe);
+      /*$67A5*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
       /*$67A8*/ CYCLES(0x67a8, 7);
                 s_x = s_a;
-      /*$67A9*/ func_4c36(0xfffe);
+      /*$67A9*/ func_4c36(0xfffe); if (s_native_depth <= depth) return;
       /*$67AC*/ CYCLES(0x67ac, 9);
       /*$67AF*/ branchTarget = true; block_id = !(s_a >= ram_peek(0x0c3a)) ? 1757 : 1249;
       break;
@@ -14393,12 +14427,12 @@ void func_t001(uint16_t ret_addr) {
                 tmp2_U8 = s_x;
                 s_a = ram_peek((0x1a50 + tmp2_U8));
       /*$67BB*/ s_y = ram_peek(0x1500);
-      /*$67BE*/ func_6832(0xfffe);
+      /*$67BE*/ func_6832(0xfffe); if (s_native_depth <= depth) return;
       /*$67C1*/ CYCLES(0x67c1, 21);
                 ram_poke((0x1a80 + tmp2_U8), s_a);
       /*$67C4*/ s_a = ram_peek((0x1a60 + tmp2_U8));
       /*$67C7*/ s_y = ram_peek(0x1501);
-      /*$67CA*/ func_6832(0xfffe);
+      /*$67CA*/ func_6832(0xfffe); if (s_native_depth <= depth) return;
       /*$67CD*/ CYCLES(0x67cd, 7);
                 ram_poke((0x1a90 + tmp2_U8), s_a);
       /*$67D0*/ branchTarget = true; block_id = find_block_id_func_t001(0x67d0, pop16() + 1);;
@@ -14410,7 +14444,7 @@ void func_t001(uint16_t ret_addr) {
       /*$67D6*/ tmp2_U8 = (uint8_t)(ram_peek(0x0c15) << 0x01);
                 s_a = tmp2_U8;
       /*$67D7*/ push8(tmp2_U8);
-      /*$67D8*/ func_4c4b(0xfffe);
+      /*$67D8*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
       /*$67DB*/ CYCLES(0x67db, 19);
       /*$67DC*/ tmp4_U16 = s_a;
                 tmp5_U16 = ram_peek(0x0c15);
@@ -14419,7 +14453,7 @@ void func_t001(uint16_t ret_addr) {
       /*$67DF*/ ram_poke((0x1a80 + tmp7_U8), ((uint8_t)tmp3_U16));
       /*$67E2*/ tmp2_U8 = pop8();
                 s_a = tmp2_U8;
-      /*$67E3*/ func_4c4b(0xfffe);
+      /*$67E3*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
       /*$67E6*/ CYCLES(0x67e6, 14);
       /*$67E7*/ tmp3_U16 = s_a;
                 tmp5_U16 = ram_peek(0x0c15);
@@ -14591,7 +14625,7 @@ void func_t001(uint16_t ret_addr) {
       /*$6871*/ tmp7_U8 = tmp7_U8 ^ 0x47;
                 s_a = tmp7_U8;
       /*$6873*/ push8(tmp7_U8);
-      /*$6874*/ func_4353(0xfffe);
+      /*$6874*/ func_4353(0xfffe); if (s_native_depth <= depth) return;
       /*$6877*/ CYCLES(0x6877, 2);
                 fprintf(stderr, "abort: pc=$%04X, target=$%04X, reason=%u", 0x6877, 0x6877, 0x03); error_handler(0x6877);
       break;
@@ -14681,7 +14715,7 @@ void func_t001(uint16_t ret_addr) {
                 tmp7_U8 = s_y;
                 ram_poke((0x1cf0 + tmp7_U8), s_a);
       /*$6939*/ s_a = 0xf1;
-      /*$693B*/ func_4c4b(0xfffe);
+      /*$693B*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
       /*$693E*/ CYCLES(0x693e, 19);
       /*$6943*/ ram_poke((0x1ce0 + tmp7_U8), ((uint8_t)(s_a + 0x0002) & 0xfe));
       /*$6946*/ branchTarget = true; block_id = 1288;
@@ -14700,7 +14734,7 @@ void func_t001(uint16_t ret_addr) {
                 tmp6_U8 = s_y;
                 ram_poke((0x1ce0 + tmp6_U8), s_a);
       /*$6950*/ s_a = 0xb3;
-      /*$6952*/ func_4c4b(0xfffe);
+      /*$6952*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
       /*$6955*/ CYCLES(0x6955, 6);
                 ram_poke((0x1cf0 + tmp6_U8), s_a);
                 block_id = 1288;
@@ -14714,7 +14748,7 @@ void func_t001(uint16_t ret_addr) {
       /*$6966*/ ram_poke((0x1d20 + tmp7_U8), (tmp7_U8 & 0x01));
       /*$696B*/ ram_poke((0x1d30 + tmp7_U8), ram_peek(0x0008));
       /*$696E*/ s_a = ram_peek(0x0c52);
-      /*$6971*/ func_4c4b(0xfffe);
+      /*$6971*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
       /*$6974*/ CYCLES(0x6974, 16);
       /*$6975*/ tmp6_U8 = (uint8_t)(s_a + ram_peek(0x0c53));
       /*$6978*/ ram_poke((0x1d50 + tmp7_U8), tmp6_U8);
@@ -14724,7 +14758,7 @@ void func_t001(uint16_t ret_addr) {
       /*$697D*/ CYCLES(0x697d, 18);
                 s_a = ram_peek(0x1421);
       /*$6983*/ s_x = (uint8_t)(ram_peek(0x0c4e) + 0x01);
-      /*$6984*/ func_4c00(0xfffe);
+      /*$6984*/ func_4c00(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1290;
       break;
     case 1290:  // $6987
@@ -14776,7 +14810,7 @@ void func_t001(uint16_t ret_addr) {
       /*$69B0*/ CYCLES(0x69b0, 12);
                 ram_poke(0x0006, s_a);
       /*$69B2*/ s_a = 0x3e;
-      /*$69B4*/ func_4c4b(0xfffe);
+      /*$69B4*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
       /*$69B7*/ CYCLES(0x69b7, 23);
       /*$69B8*/ tmp3_U16 = s_a;
                 tmp5_U16 = ram_peek(0x0006);
@@ -14785,7 +14819,7 @@ void func_t001(uint16_t ret_addr) {
       /*$69BC*/ tmp6_U8 = s_y;
                 ram_poke((0x1d70 + tmp6_U8), (((uint8_t)tmp4_U16) | 0x01));
       /*$69BF*/ s_a = 0x90;
-      /*$69C1*/ func_4c4b(0xfffe);
+      /*$69C1*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
       /*$69C4*/ CYCLES(0x69c4, 14);
       /*$69C5*/ tmp4_U16 = s_a + 0x0010;
                 s_status_c = (uint8_t)(tmp4_U16 >> 8);
@@ -14807,7 +14841,7 @@ void func_t001(uint16_t ret_addr) {
       /*$69D2*/ CYCLES(0x69d2, 12);
                 ram_poke(0x0006, s_a);
       /*$69D4*/ s_a = 0x20;
-      /*$69D6*/ func_4c4b(0xfffe);
+      /*$69D6*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
       /*$69D9*/ CYCLES(0x69d9, 19);
       /*$69DA*/ tmp4_U16 = s_a;
                 tmp5_U16 = ram_peek(0x0006);
@@ -14816,7 +14850,7 @@ void func_t001(uint16_t ret_addr) {
       /*$69DC*/ tmp7_U8 = s_y;
                 ram_poke((0x1d90 + tmp7_U8), ((uint8_t)tmp3_U16));
       /*$69DF*/ s_a = 0xce;
-      /*$69E1*/ func_4c4b(0xfffe);
+      /*$69E1*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
       /*$69E4*/ CYCLES(0x69e4, 14);
       /*$69E9*/ ram_poke((0x1d70 + tmp7_U8), ((uint8_t)(s_a + 0x0010) | 0x01));
                 block_id = 1300;
@@ -14828,7 +14862,7 @@ void func_t001(uint16_t ret_addr) {
       /*$69F1*/ ram_poke((0x1dd0 + tmp7_U8), 0x00);
       /*$69F6*/ ram_poke((0x1e10 + tmp7_U8), ram_peek(0x0008));
       /*$69F9*/ s_x = 0x00;
-      /*$69FB*/ func_4c36(0xfffe);
+      /*$69FB*/ func_4c36(0xfffe); if (s_native_depth <= depth) return;
       /*$69FE*/ CYCLES(0x69fe, 4);
                 branchTarget = true; block_id = !s_status_n ? 1302 : 1301;
       break;
@@ -14873,7 +14907,7 @@ void func_t001(uint16_t ret_addr) {
       /*$6A25*/ s_x = ram_peek((0x1cf0 + tmp6_U8));
       /*$6A28*/ s_a = ram_peek((0x1ce0 + tmp6_U8));
       /*$6A2B*/ s_y = 0x0d;
-      /*$6A2D*/ func_4d21(0xfffe);
+      /*$6A2D*/ func_4d21(0xfffe); if (s_native_depth <= depth) return;
       /*$6A30*/ CYCLES(0x6a30, 19);
                 tmp6_U8 = ram_peek(0x0000);
                 s_y = tmp6_U8;
@@ -14949,7 +14983,7 @@ void func_t001(uint16_t ret_addr) {
       /*$6A80*/ ram_poke(0x0007, ram_peek((0x0918 + tmp7_U8)));
       /*$6A82*/ s_x = ram_peek((0x1ce0 + tmp6_U8));
       /*$6A88*/ s_y = ram_peek((0x1cf0 + tmp6_U8));
-      /*$6A89*/ func_4cf6(0xfffe);
+      /*$6A89*/ func_4cf6(0xfffe); if (s_native_depth <= depth) return;
       /*$6A8C*/ CYCLES(0x6a8c, 12);
                 tmp6_U8 = ram_peek(0x0000);
                 s_x = tmp6_U8;
@@ -14961,7 +14995,7 @@ void func_t001(uint16_t ret_addr) {
     case 1317:  // $6A93
       /*$6A93*/ CYCLES(0x6a93, 11);
                 s_a = ram_peek(0x0c4a);
-      /*$6A96*/ func_4c4b(0xfffe);
+      /*$6A96*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
       /*$6A99*/ CYCLES(0x6a99, 28);
       /*$6A9B*/ tmp6_U8 = ram_peek(0x0000);
                 s_x = tmp6_U8;
@@ -14991,7 +15025,7 @@ void func_t001(uint16_t ret_addr) {
     case 1320:  // $6AC2
       /*$6AC2*/ CYCLES(0x6ac2, 11);
                 s_a = ram_peek(0x0c52);
-      /*$6AC5*/ func_4c4b(0xfffe);
+      /*$6AC5*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
       /*$6AC8*/ CYCLES(0x6ac8, 18);
                 tmp6_U8 = ram_peek(0x0000);
                 s_x = tmp6_U8;
@@ -15084,7 +15118,7 @@ void func_t001(uint16_t ret_addr) {
       /*$6B27*/ s_x = ram_peek((0x1cf0 + tmp6_U8));
       /*$6B2A*/ s_a = ram_peek((0x1ce0 + tmp6_U8));
       /*$6B2D*/ s_y = 0x0d;
-      /*$6B2F*/ func_4d21(0xfffe);
+      /*$6B2F*/ func_4d21(0xfffe); if (s_native_depth <= depth) return;
       /*$6B32*/ CYCLES(0x6b32, 9);
                 s_x = ram_peek(0x0000);
       /*$6B34*/ branchTarget = true; push16(0x6b36); block_id = 1419;
@@ -15115,7 +15149,7 @@ void func_t001(uint16_t ret_addr) {
                 tmp6_U8 = s_a;
                 tmp7_U8 = ram_peek(0x0c50);
       /*$6B47*/ push8(((tmp6_U8 >= tmp7_U8) | (((tmp6_U8 != tmp7_U8) == 0) << 1) | (s_status_i << 2) | (s_status_d << 3) | STATUS_B | (s_status_v << 6) | ((uint8_t)(tmp6_U8 - tmp7_U8) & 0x80)));
-      /*$6B48*/ func_4c36(0xfffe);
+      /*$6B48*/ func_4c36(0xfffe); if (s_native_depth <= depth) return;
       /*$6B4B*/ CYCLES(0x6b4b, 14);
                 s_a = 0x00;
       /*$6B4D*/ tmp7_U8 = ram_peek(0x004e);
@@ -15230,7 +15264,7 @@ void func_t001(uint16_t ret_addr) {
       /*$6B91*/ s_x = ram_peek((0x1d90 + tmp7_U8));
       /*$6B94*/ s_a = ram_peek((0x1d70 + tmp7_U8));
       /*$6B97*/ s_y = 0x0f;
-      /*$6B99*/ func_4d21(0xfffe);
+      /*$6B99*/ func_4d21(0xfffe); if (s_native_depth <= depth) return;
       /*$6B9C*/ CYCLES(0x6b9c, 4);
                 s_x = ram_peek(0x0000);
                 block_id = 1353;
@@ -15250,7 +15284,7 @@ void func_t001(uint16_t ret_addr) {
       /*$6BAD*/ CYCLES(0x6bad, 24);
                 tmp7_U8 = s_x;
       /*$6BB5*/ ram_poke((0x1db0 + tmp7_U8), (uint8_t)((ram_peek((0x1db0 + tmp7_U8)) ^ 0xff) + 0x0001));
-      /*$6BB8*/ func_6c2f(0xfffe);
+      /*$6BB8*/ func_6c2f(0xfffe); if (s_native_depth <= depth) return;
       /*$6BBB*/ CYCLES(0x6bbb, 4);
                 branchTarget = true; block_id = !s_status_n ? 1353 : 1356;
       break;
@@ -15284,7 +15318,7 @@ void func_t001(uint16_t ret_addr) {
                 s_status_c = (uint8_t)(tmp3_U16 >> 8);
                 s_status_v = ovf8((uint8_t)tmp3_U16, (uint8_t)tmp4_U16, (uint8_t)0x0001);
       /*$6BD7*/ ram_poke((0x1dd0 + tmp7_U8), ((uint8_t)tmp3_U16));
-      /*$6BDA*/ func_6c2f(0xfffe);
+      /*$6BDA*/ func_6c2f(0xfffe); if (s_native_depth <= depth) return;
       /*$6BDD*/ CYCLES(0x6bdd, 4);
                 branchTarget = true; block_id = !s_status_n ? 1357 : 1360;
       break;
@@ -15299,7 +15333,7 @@ void func_t001(uint16_t ret_addr) {
       /*$6BF8*/ tmp7_U8 = ram_peek((0x1d70 + tmp7_U8));
                 s_a = tmp7_U8;
       /*$6BFB*/ s_x = tmp7_U8;
-      /*$6BFC*/ func_4cf6(0xfffe);
+      /*$6BFC*/ func_4cf6(0xfffe); if (s_native_depth <= depth) return;
       /*$6BFF*/ CYCLES(0x6bff, 12);
                 tmp7_U8 = ram_peek(0x0000);
                 s_x = tmp7_U8;
@@ -15311,7 +15345,7 @@ void func_t001(uint16_t ret_addr) {
     case 1361:  // $6C06
       /*$6C06*/ CYCLES(0x6c06, 11);
                 s_a = ram_peek(0x0c4b);
-      /*$6C09*/ func_4c4b(0xfffe);
+      /*$6C09*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
       /*$6C0C*/ CYCLES(0x6c0c, 24);
                 tmp7_U8 = ram_peek(0x0000);
                 s_x = tmp7_U8;
@@ -15331,7 +15365,7 @@ void func_t001(uint16_t ret_addr) {
     case 1363:  // $6C26
       /*$6C26*/ CYCLES(0x6c26, 11);
                 ram_poke((0x1dd0 + s_x), s_a);
-      /*$6C29*/ func_6c2f(0xfffe);
+      /*$6C29*/ func_6c2f(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1364;
       break;
     case 1364:  // $6C2C
@@ -15355,7 +15389,7 @@ void func_t001(uint16_t ret_addr) {
                 tmp2_U8 = ram_peek(0x0006);
       /*$6C3C*/ push8(((tmp7_U8 >= tmp2_U8) | (((tmp7_U8 != tmp2_U8) == 0) << 1) | (s_status_i << 2) | (s_status_d << 3) | STATUS_B | (s_status_v << 6) | ((uint8_t)(tmp7_U8 - tmp2_U8) & 0x80)));
       /*$6C40*/ s_a = (uint8_t)(ram_peek(0x0c44) << 0x01);
-      /*$6C41*/ func_4c4b(0xfffe);
+      /*$6C41*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
       /*$6C44*/ CYCLES(0x6c44, 29);
       /*$6C45*/ tmp3_U16 = s_a - ram_peek(0x0c44);
       /*$6C4A*/ s_a = ((uint8_t)(tmp3_U16 + (uint8_t)(0x01 - ((uint8_t)(tmp3_U16 >> 8) & 0x01))) & 0xfe);
@@ -15456,7 +15490,7 @@ void func_t001(uint16_t ret_addr) {
       /*$6C7F*/ s_x = ram_peek((0x1e60 + tmp2_U8));
       /*$6C82*/ s_a = ram_peek((0x1e50 + tmp2_U8));
       /*$6C85*/ s_y = 0x07;
-      /*$6C87*/ func_4cd0(0xfffe);
+      /*$6C87*/ func_4cd0(0xfffe); if (s_native_depth <= depth) return;
       /*$6C8A*/ CYCLES(0x6c8a, 4);
                 s_x = ram_peek(0x0000);
                 block_id = 1379;
@@ -15540,7 +15574,7 @@ void func_t001(uint16_t ret_addr) {
       /*$6CE6*/ tmp2_U8 = ram_peek((0x1e50 + tmp2_U8));
                 s_a = tmp2_U8;
       /*$6CE9*/ s_x = tmp2_U8;
-      /*$6CEA*/ func_4cac(0xfffe);
+      /*$6CEA*/ func_4cac(0xfffe); if (s_native_depth <= depth) return;
       /*$6CED*/ CYCLES(0x6ced, 9);
                 s_x = ram_peek(0x0000);
       /*$6CEF*/ branchTarget = true; block_id = 1375;
@@ -15582,7 +15616,7 @@ void func_t001(uint16_t ret_addr) {
     case 1395:  // $6D2A
       /*$6D2A*/ CYCLES(0x6d2a, 11);
                 s_a = ram_peek(0x142b);
-      /*$6D2D*/ func_4c4b(0xfffe);
+      /*$6D2D*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1396;
       break;
     case 1396:  // $6D30
@@ -15596,7 +15630,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 1397:  // $6D38
       /*$6D38*/ CYCLES(0x6d38, 6);
-                func_4c4b(0xfffe);
+                func_4c4b(0xfffe); if (s_native_depth <= depth) return;
       /*$6D3B*/ CYCLES(0x6d3b, 14);
                 s_x = s_a;
       /*$6D3C*/ tmp2_U8 = ram_peek(0x1429);
@@ -15613,7 +15647,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 1399:  // $6D46
       /*$6D46*/ CYCLES(0x6d46, 6);
-                func_4c36(0xfffe);
+                func_4c36(0xfffe); if (s_native_depth <= depth) return;
       /*$6D49*/ CYCLES(0x6d49, 9);
       /*$6D4C*/ branchTarget = true; block_id = (s_a >= ram_peek(0x0c67)) ? 1401 : 1400;
       break;
@@ -15866,7 +15900,7 @@ void func_t001(uint16_t ret_addr) {
       /*$6E6C*/ s_x = ram_peek((0x1cf0 + tmp7_U8));
       /*$6E6F*/ s_a = ram_peek((0x1ce0 + tmp7_U8));
       /*$6E72*/ s_y = 0x0d;
-      /*$6E74*/ func_4d21(0xfffe);
+      /*$6E74*/ func_4d21(0xfffe); if (s_native_depth <= depth) return;
       /*$6E77*/ CYCLES(0x6e77, 33);
                 tmp7_U8 = pop8();
       /*$6E78*/ push8(tmp7_U8);
@@ -15888,7 +15922,7 @@ void func_t001(uint16_t ret_addr) {
       /*$6E8F*/ CYCLES(0x6e8f, 12);
                 s_a = 0x03;
       /*$6E91*/ s_x = 0xe8;
-      /*$6E93*/ func_4dd0(0xfffe);
+      /*$6E93*/ func_4dd0(0xfffe); if (s_native_depth <= depth) return;
       /*$6E96*/ CYCLES(0x6e96, 4);
                 s_status_c = 0x01;
       /*$6E97*/ branchTarget = true; block_id = find_block_id_func_t001(0x6e97, pop16() + 1);;
@@ -15981,7 +16015,7 @@ void func_t001(uint16_t ret_addr) {
       /*$6ED2*/ s_x = ram_peek((0x1d90 + tmp7_U8));
       /*$6ED5*/ s_a = ram_peek((0x1d70 + tmp7_U8));
       /*$6ED8*/ s_y = 0x0f;
-      /*$6EDA*/ func_4d21(0xfffe);
+      /*$6EDA*/ func_4d21(0xfffe); if (s_native_depth <= depth) return;
       /*$6EDD*/ CYCLES(0x6edd, 38);
                 tmp7_U8 = pop8();
       /*$6EDF*/ push8(tmp7_U8);
@@ -16003,7 +16037,7 @@ void func_t001(uint16_t ret_addr) {
       /*$6EF8*/ CYCLES(0x6ef8, 12);
                 s_a = 0x00;
       /*$6EFA*/ s_x = 0xc8;
-      /*$6EFC*/ func_4dd0(0xfffe);
+      /*$6EFC*/ func_4dd0(0xfffe); if (s_native_depth <= depth) return;
       /*$6EFF*/ CYCLES(0x6eff, 35);
       /*$6F02*/ ram_poke(0x1406, ram_peek(0x0c46));
       /*$6F08*/ ram_poke(0x1422, ram_peek(0x0c47));
@@ -16096,7 +16130,7 @@ void func_t001(uint16_t ret_addr) {
       /*$6F4B*/ s_x = ram_peek((0x1e60 + tmp2_U8));
       /*$6F4E*/ s_a = ram_peek((0x1e50 + tmp2_U8));
       /*$6F51*/ s_y = 0x07;
-      /*$6F53*/ func_4cd0(0xfffe);
+      /*$6F53*/ func_4cd0(0xfffe); if (s_native_depth <= depth) return;
       /*$6F56*/ CYCLES(0x6f56, 9);
                 tmp2_U8 = pop8();
       /*$6F57*/ s_x = tmp2_U8;
@@ -16108,7 +16142,7 @@ void func_t001(uint16_t ret_addr) {
       /*$6F63*/ ram_poke(0x1412, 0x01);
       /*$6F66*/ s_a = 0x00;
       /*$6F68*/ s_x = 0x19;
-      /*$6F6A*/ func_4dd0(0xfffe);
+      /*$6F6A*/ func_4dd0(0xfffe); if (s_native_depth <= depth) return;
       /*$6F6D*/ CYCLES(0x6f6d, 4);
                 s_status_c = 0x01;
       /*$6F6E*/ branchTarget = true; block_id = find_block_id_func_t001(0x6f6e, pop16() + 1);;
@@ -16252,7 +16286,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 1482:  // $703F
       /*$703F*/ CYCLES(0x703f, 6);
-                func_4c36(0xfffe);
+                func_4c36(0xfffe); if (s_native_depth <= depth) return;
       /*$7042*/ CYCLES(0x7042, 16);
                 push8((s_status_c | ((s_status_not_z == 0) << 1) | (s_status_i << 2) | (s_status_d << 3) | STATUS_B | (s_status_v << 6) | s_status_n));
       /*$7045*/ ram_poke((0x1b40 + s_y), (s_a & 0x01));
@@ -16265,14 +16299,14 @@ void func_t001(uint16_t ret_addr) {
     case 1483:  // $704B
       /*$704B*/ CYCLES(0x704b, 9);
                 s_a = 0xdb;
-      /*$704D*/ func_4c4b(0xfffe);
+      /*$704D*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
       /*$7050*/ CYCLES(0x7050, 19);
       /*$7055*/ ram_poke((0x1b20 + s_y), ((uint8_t)(s_a + 0x000c) & 0xfe));
-      /*$7058*/ func_4c36(0xfffe);
+      /*$7058*/ func_4c36(0xfffe); if (s_native_depth <= depth) return;
       /*$705B*/ CYCLES(0x705b, 12);
                 ram_poke(0x0000, s_a);
       /*$705D*/ s_a = 0x20;
-      /*$705F*/ func_4c4b(0xfffe);
+      /*$705F*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
       /*$7062*/ CYCLES(0x7062, 12);
       /*$7063*/ tmp3_U16 = s_a + 0x000c;
                 s_status_c = (uint8_t)(tmp3_U16 >> 8);
@@ -16297,14 +16331,14 @@ void func_t001(uint16_t ret_addr) {
     case 1486:  // $7070
       /*$7070*/ CYCLES(0x7070, 9);
                 s_a = 0x9c;
-      /*$7072*/ func_4c4b(0xfffe);
+      /*$7072*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
       /*$7075*/ CYCLES(0x7075, 16);
       /*$7078*/ ram_poke((0x1b30 + s_y), (uint8_t)(s_a + 0x000c));
-      /*$707B*/ func_4c36(0xfffe);
+      /*$707B*/ func_4c36(0xfffe); if (s_native_depth <= depth) return;
       /*$707E*/ CYCLES(0x707e, 12);
                 ram_poke(0x0000, s_a);
       /*$7080*/ s_a = 0x37;
-      /*$7082*/ func_4c4b(0xfffe);
+      /*$7082*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
       /*$7085*/ CYCLES(0x7085, 12);
       /*$7086*/ tmp3_U16 = s_a + 0x000c;
                 s_status_c = (uint8_t)(tmp3_U16 >> 8);
@@ -16336,7 +16370,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 1491:  // $709C
       /*$709C*/ CYCLES(0x709c, 6);
-                func_4c4b(0xfffe);
+                func_4c4b(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1492;
       break;
     case 1492:  // $709F
@@ -16345,15 +16379,15 @@ void func_t001(uint16_t ret_addr) {
                 ram_poke((0x1b50 + tmp2_U8), s_a);
       /*$70A5*/ ram_poke((0x1b60 + tmp2_U8), (tmp2_U8 & 0x03));
       /*$70A8*/ s_a = ram_peek(0x0c25);
-      /*$70AB*/ func_4c4b(0xfffe);
+      /*$70AB*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
       /*$70AE*/ CYCLES(0x70ae, 16);
                 ram_poke((0x1b70 + tmp2_U8), s_a);
       /*$70B1*/ s_a = ram_peek(0x0c26);
-      /*$70B4*/ func_4c4b(0xfffe);
+      /*$70B4*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
       /*$70B7*/ CYCLES(0x70b7, 19);
                 ram_poke((0x1b80 + tmp2_U8), s_a);
       /*$70BC*/ ram_poke((0x1b90 + tmp2_U8), 0xff);
-      /*$70BF*/ func_4c36(0xfffe);
+      /*$70BF*/ func_4c36(0xfffe); if (s_native_depth <= depth) return;
       /*$70C2*/ CYCLES(0x70c2, 14);
       /*$70C4*/ ram_poke((0x1ba0 + tmp2_U8), (s_a & 0x01));
       /*$70C7*/ branchTarget = true; block_id = 1480;
@@ -16363,7 +16397,7 @@ void func_t001(uint16_t ret_addr) {
       /*$7211*/ CYCLES(0x7211, 16);
       /*$7213*/ ram_poke(0x000a, (uint8_t)(s_a << 0x02));
       /*$7215*/ s_y = 0x0d;
-      /*$7217*/ func_50a1(0xfffe);
+      /*$7217*/ func_50a1(0xfffe); if (s_native_depth <= depth) return;
       /*$721A*/ CYCLES(0x721a, 6);
                 s_x = ram_peek(0x1418);
                 block_id = 1523;
@@ -16420,7 +16454,7 @@ void func_t001(uint16_t ret_addr) {
                 s_a = tmp2_U8;
       /*$70F8*/ tmp7_U8 = s_x;
                 ram_poke((0x1b70 + tmp7_U8), tmp2_U8);
-      /*$70FB*/ func_72d9(0xfffe);
+      /*$70FB*/ func_72d9(0xfffe); if (s_native_depth <= depth) return;
       /*$70FE*/ CYCLES(0x70fe, 7);
       /*$70FF*/ ram_poke((0x1b50 + tmp7_U8), s_y);
                 block_id = 1501;
@@ -16431,7 +16465,7 @@ void func_t001(uint16_t ret_addr) {
       /*$7104*/ s_x = ram_peek((0x1b30 + tmp2_U8));
       /*$7107*/ s_a = ram_peek((0x1b20 + tmp2_U8));
       /*$710A*/ s_y = 0x0d;
-      /*$710C*/ func_4d21(0xfffe);
+      /*$710C*/ func_4d21(0xfffe); if (s_native_depth <= depth) return;
       /*$710F*/ CYCLES(0x710f, 26);
                 tmp2_U8 = ram_peek(0x0000);
                 s_y = tmp2_U8;
@@ -16450,7 +16484,7 @@ void func_t001(uint16_t ret_addr) {
       /*$7123*/ CYCLES(0x7123, 9);
                 tmp7_U8 = ram_peek(0x0000);
                 s_x = tmp7_U8;
-      /*$7125*/ func_72d9(0xfffe);
+      /*$7125*/ func_72d9(0xfffe); if (s_native_depth <= depth) return;
       /*$7128*/ CYCLES(0x7128, 16);
                 tmp2_U8 = s_y;
       /*$7129*/ ram_poke((0x1b50 + tmp7_U8), tmp2_U8);
@@ -16555,7 +16589,7 @@ void func_t001(uint16_t ret_addr) {
       /*$731A*/ s_x = ram_peek((0x1960 + tmp2_U8));
       /*$731D*/ s_a = ram_peek((0x1950 + tmp2_U8));
       /*$7320*/ s_y = 0x0a;
-      /*$7322*/ func_4cd0(0xfffe);
+      /*$7322*/ func_4cd0(0xfffe); if (s_native_depth <= depth) return;
       /*$7325*/ CYCLES(0x7325, 14);
                 tmp2_U8 = ram_peek(0x0000);
                 s_y = tmp2_U8;
@@ -16586,7 +16620,7 @@ void func_t001(uint16_t ret_addr) {
       /*$71B2*/ tmp7_U8 = ram_peek((0x1b30 + tmp7_U8));
                 s_a = tmp7_U8;
       /*$71B5*/ s_y = tmp7_U8;
-      /*$71B6*/ func_4cf6(0xfffe);
+      /*$71B6*/ func_4cf6(0xfffe); if (s_native_depth <= depth) return;
       /*$71B9*/ CYCLES(0x71b9, 12);
                 tmp7_U8 = ram_peek(0x0000);
                 s_x = tmp7_U8;
@@ -16615,7 +16649,7 @@ void func_t001(uint16_t ret_addr) {
       /*$71D8*/ tmp2_U8 = ram_peek((0x1b30 + tmp2_U8));
       /*$71DB*/ ram_poke((0x1c80 + tmp6_U8), tmp2_U8);
       /*$71DE*/ ram_poke((0x1c81 + tmp6_U8), tmp2_U8);
-      /*$71E1*/ func_768f(0xfffe);
+      /*$71E1*/ func_768f(0xfffe); if (s_native_depth <= depth) return;
       /*$71E4*/ CYCLES(0x71e4, 63);
                 tmp2_U8 = ram_peek(0x0002);
       /*$71E6*/ ram_poke((0x1c90 + tmp6_U8), tmp2_U8);
@@ -16628,7 +16662,7 @@ void func_t001(uint16_t ret_addr) {
       /*$71FA*/ ram_poke((0x1cb1 + tmp6_U8), tmp2_U8);
       /*$7200*/ ram_poke((0x1cc1 + tmp6_U8), ram_peek(0x0c2e));
       /*$7203*/ s_a = ram_peek(0x0c26);
-      /*$7206*/ func_4c4b(0xfffe);
+      /*$7206*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
       /*$7209*/ CYCLES(0x7209, 9);
                 tmp6_U8 = ram_peek(0x0000);
                 s_x = tmp6_U8;
@@ -16662,7 +16696,7 @@ void func_t001(uint16_t ret_addr) {
       /*$7233*/ ram_poke(0x0007, ram_peek((0x08e8 + (tmp3_U16 & 0x00ff))));
       /*$7235*/ s_y = ram_peek((0x1b30 + tmp6_U8));
       /*$723B*/ s_x = ram_peek((0x1b20 + tmp6_U8));
-      /*$723C*/ func_4c7c(0xfffe);
+      /*$723C*/ func_4c7c(0xfffe); if (s_native_depth <= depth) return;
       /*$723F*/ CYCLES(0x723f, 7);
       /*$7241*/ ram_poke(0x0020, 0x00);
                 block_id = 1526;
@@ -16696,7 +16730,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 1527:  // $7270
       /*$7270*/ CYCLES(0x7270, 6);
-                func_4c6e(0xfffe);
+                func_4c6e(0xfffe); if (s_native_depth <= depth) return;
       /*$7273*/ CYCLES(0x7273, 9);
                 s_x = ram_peek(0x0000);
       /*$7275*/ branchTarget = true; block_id = 1523;
@@ -16715,7 +16749,7 @@ void func_t001(uint16_t ret_addr) {
       /*$7297*/ ram_poke(0x0007, ram_peek((0x08e8 + (tmp3_U16 & 0x00ff))));
       /*$7299*/ s_y = ram_peek((0x1b30 + tmp6_U8));
       /*$729F*/ s_x = ram_peek((0x1b20 + tmp6_U8));
-      /*$72A0*/ func_4c7c(0xfffe);
+      /*$72A0*/ func_4c7c(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1530;
       break;
     case 1530:  // $72A3
@@ -16747,7 +16781,7 @@ void func_t001(uint16_t ret_addr) {
                 s_x = tmp6_U8;
       /*$72D0*/ tmp3_U16 = 0x1b90 + tmp6_U8;
                 ram_poke(tmp3_U16, (uint8_t)(ram_peek(tmp3_U16) - 0x01));
-      /*$72D3*/ func_4c6e(0xfffe);
+      /*$72D3*/ func_4c6e(0xfffe); if (s_native_depth <= depth) return;
       /*$72D6*/ CYCLES(0x72d6, 6);
                 branchTarget = true; block_id = 1494;
       break;
@@ -16995,7 +17029,7 @@ void func_t001(uint16_t ret_addr) {
       /*$73DC*/ s_x = ram_peek((0x1b30 + tmp7_U8));
       /*$73DF*/ s_a = ram_peek((0x1b20 + tmp7_U8));
       /*$73E2*/ s_y = 0x0d;
-      /*$73E4*/ func_4d21(0xfffe);
+      /*$73E4*/ func_4d21(0xfffe); if (s_native_depth <= depth) return;
       /*$73E7*/ CYCLES(0x73e7, 35);
                 tmp7_U8 = ram_peek(0x0000);
       /*$73ED*/ tmp5_U16 = ram_peek((0x1b30 + tmp7_U8)) + 0x0006;
@@ -17030,7 +17064,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 1570:  // $7410
       /*$7410*/ CYCLES(0x7410, 6);
-                func_7979(0xfffe);
+                func_7979(0xfffe); if (s_native_depth <= depth) return;
       /*$7413*/ CYCLES(0x7413, 4);
                 branchTarget = true; block_id = !s_status_c ? 1568 : 1571;
       break;
@@ -17041,7 +17075,7 @@ void func_t001(uint16_t ret_addr) {
       /*$741B*/ s_x = (uint8_t)(ram_peek((0x1bd0 + tmp2_U8)) - 0x02);
       /*$741C*/ s_a = ram_peek((0x1bb0 + tmp2_U8));
       /*$741F*/ s_y = 0x0e;
-      /*$7421*/ func_4cd0(0xfffe);
+      /*$7421*/ func_4cd0(0xfffe); if (s_native_depth <= depth) return;
       /*$7424*/ CYCLES(0x7424, 21);
                 tmp2_U8 = ram_peek(0x0001);
       /*$7426*/ s_y = ram_peek((0x1bd0 + tmp2_U8));
@@ -17058,7 +17092,7 @@ void func_t001(uint16_t ret_addr) {
                 tmp2_U8 = ram_peek(0x0000);
                 s_x = tmp2_U8;
       /*$7439*/ ram_poke((0x1b90 + tmp2_U8), 0xff);
-      /*$743C*/ func_7459(0xfffe);
+      /*$743C*/ func_7459(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1574;
       break;
     case 1574:  // $743F
@@ -17074,7 +17108,7 @@ void func_t001(uint16_t ret_addr) {
       /*$7444*/ CYCLES(0x7444, 12);
                 s_a = 0x01;
       /*$7446*/ s_x = 0xf4;
-      /*$7448*/ func_4dd0(0xfffe);
+      /*$7448*/ func_4dd0(0xfffe); if (s_native_depth <= depth) return;
       /*$744B*/ CYCLES(0x744b, 24);
       /*$744E*/ ram_poke(0x141e, ram_peek(0x0c32));
       /*$7451*/ tmp2_U8 = ram_peek(0x0c31);
@@ -17187,15 +17221,15 @@ void func_t001(uint16_t ret_addr) {
     case 1590:  // $74CD
       /*$74CD*/ CYCLES(0x74cd, 9);
                 ram_poke(0x0000, s_x);
-      /*$74CF*/ func_7628(0xfffe);
+      /*$74CF*/ func_7628(0xfffe); if (s_native_depth <= depth) return;
       /*$74D2*/ CYCLES(0x74d2, 9);
                 tmp6_U8 = ram_peek(0x0000);
                 s_x = tmp6_U8;
-      /*$74D4*/ func_7546(0xfffe);
+      /*$74D4*/ func_7546(0xfffe); if (s_native_depth <= depth) return;
       /*$74D7*/ CYCLES(0x74d7, 16);
                 s_y = ram_peek((0x1c80 + tmp6_U8));
       /*$74DA*/ s_a = ram_peek((0x1c70 + tmp6_U8));
-      /*$74DD*/ func_4c1c(0xfffe);
+      /*$74DD*/ func_4c1c(0xfffe); if (s_native_depth <= depth) return;
       /*$74E0*/ CYCLES(0x74e0, 9);
                 ram_poke(0x0004, s_a);
       /*$74E2*/ s_a = 0x00;
@@ -17266,7 +17300,7 @@ void func_t001(uint16_t ret_addr) {
       /*$7518*/ CYCLES(0x7518, 9);
                 tmp6_U8 = ram_peek(0x0000);
                 s_y = tmp6_U8;
-      /*$751A*/ func_768f(0xfffe);
+      /*$751A*/ func_768f(0xfffe); if (s_native_depth <= depth) return;
       /*$751D*/ CYCLES(0x751d, 38);
                 tmp2_U8 = ram_peek(0x0002);
       /*$751F*/ ram_poke((0x1c90 + tmp6_U8), tmp2_U8);
@@ -17275,7 +17309,7 @@ void func_t001(uint16_t ret_addr) {
       /*$7527*/ ram_poke((0x1ca0 + tmp6_U8), tmp2_U8);
       /*$752A*/ ram_poke((0x1cd0 + tmp6_U8), tmp2_U8);
       /*$752D*/ s_a = ram_peek(0x0c2d);
-      /*$7530*/ func_4c4b(0xfffe);
+      /*$7530*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
       /*$7533*/ CYCLES(0x7533, 33);
       /*$7534*/ tmp5_U16 = s_a;
                 tmp4_U16 = ram_peek(0x0c2e);
@@ -17440,7 +17474,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 1619:  // $75D2
       /*$75D2*/ CYCLES(0x75d2, 6);
-                func_7628(0xfffe);
+                func_7628(0xfffe); if (s_native_depth <= depth) return;
       /*$75D5*/ CYCLES(0x75d5, 7);
                 tmp2_U8 = (uint8_t)(ram_peek(0x0002) - 0x01);
                 ram_poke(0x0002, tmp2_U8);
@@ -17455,7 +17489,7 @@ void func_t001(uint16_t ret_addr) {
       /*$75DE*/ CYCLES(0x75de, 12);
                 s_a = 0x00;
       /*$75E0*/ s_x = 0x64;
-      /*$75E2*/ func_4dd0(0xfffe);
+      /*$75E2*/ func_4dd0(0xfffe); if (s_native_depth <= depth) return;
       /*$75E5*/ CYCLES(0x75e5, 11);
                 ram_poke(0x001c, (uint8_t)(ram_peek(0x001c) - 0x01));
       /*$75E7*/ tmp2_U8 = (uint8_t)(ram_peek(0x001d) - 0x01);
@@ -17520,7 +17554,7 @@ void func_t001(uint16_t ret_addr) {
                 tmp2_U8 = s_x;
                 s_y = ram_peek((0x1c80 + tmp2_U8));
       /*$7638*/ s_a = ram_peek((0x1c70 + tmp2_U8));
-      /*$763B*/ func_4c1c(0xfffe);
+      /*$763B*/ func_4c1c(0xfffe); if (s_native_depth <= depth) return;
       /*$763E*/ CYCLES(0x763e, 9);
                 ram_poke(0x0004, s_a);
       /*$7640*/ s_a = 0xff;
@@ -17578,7 +17612,7 @@ void func_t001(uint16_t ret_addr) {
       /*$7670*/ CYCLES(0x7670, 11);
       /*$7672*/ tmp6_U8 = (uint8_t)(ram_peek(0x0000) + 0x01);
                 s_x = tmp6_U8;
-      /*$7673*/ func_7546(0xfffe);
+      /*$7673*/ func_7546(0xfffe); if (s_native_depth <= depth) return;
       /*$7676*/ CYCLES(0x7676, 9);
                 tmp5_U16 = 0x1cb0 + tmp6_U8;
                 tmp6_U8 = (uint8_t)(ram_peek(tmp5_U16) - 0x01);
@@ -17650,7 +17684,7 @@ void func_t001(uint16_t ret_addr) {
       /*$76B0*/ CYCLES(0x76b0, 12);
                 ram_poke(0x0002, s_x);
       /*$76B2*/ ram_poke(0x0003, s_a);
-      /*$76B4*/ func_4c36(0xfffe);
+      /*$76B4*/ func_4c36(0xfffe); if (s_native_depth <= depth) return;
       /*$76B7*/ CYCLES(0x76b7, 9);
                 tmp6_U8 = s_a;
                 tmp2_U8 = ram_peek(0x0c2f);
@@ -17773,7 +17807,7 @@ void func_t001(uint16_t ret_addr) {
     case 1659:  // $7702
       /*$7702*/ CYCLES(0x7702, 9);
                 ram_poke(0x0000, s_x);
-      /*$7704*/ func_7821(0xfffe);
+      /*$7704*/ func_7821(0xfffe); if (s_native_depth <= depth) return;
       /*$7707*/ CYCLES(0x7707, 7);
                 tmp2_U8 = ram_peek(0x0000);
                 s_x = tmp2_U8;
@@ -17799,14 +17833,14 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 1663:  // $771D
       /*$771D*/ CYCLES(0x771d, 6);
-                func_7778(0xfffe);
+                func_7778(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1664;
       break;
     case 1664:  // $7720
       /*$7720*/ CYCLES(0x7720, 9);
                 tmp2_U8 = ram_peek(0x0000);
                 s_x = tmp2_U8;
-      /*$7722*/ func_779e(0xfffe);
+      /*$7722*/ func_779e(0xfffe); if (s_native_depth <= depth) return;
       /*$7725*/ CYCLES(0x7725, 50);
       /*$7729*/ tmp5_U16 = ram_peek((0x1c50 + tmp2_U8)) << 0x02;
                 s_status_c = (uint8_t)((tmp5_U16 & 0x01ff) >> 8);
@@ -17817,7 +17851,7 @@ void func_t001(uint16_t ret_addr) {
       /*$773B*/ tmp2_U8 = ram_peek((0x1bb0 + tmp2_U8));
                 s_a = tmp2_U8;
       /*$773E*/ s_x = tmp2_U8;
-      /*$773F*/ func_5059(0xfffe);
+      /*$773F*/ func_5059(0xfffe); if (s_native_depth <= depth) return;
       /*$7742*/ CYCLES(0x7742, 12);
                 tmp2_U8 = ram_peek(0x0000);
                 s_x = tmp2_U8;
@@ -17832,13 +17866,13 @@ void func_t001(uint16_t ret_addr) {
                 ram_poke((0x1c10 + tmp7_U8), 0x70);
       /*$774E*/ s_a = ram_peek((0x1bb0 + tmp7_U8));
       /*$7751*/ s_y = ram_peek(0x1500);
-      /*$7754*/ func_7812(0xfffe);
+      /*$7754*/ func_7812(0xfffe); if (s_native_depth <= depth) return;
       /*$7757*/ CYCLES(0x7757, 23);
                 ram_poke(0x0002, s_a);
       /*$7759*/ ram_poke(0x0003, s_y);
       /*$775B*/ s_a = ram_peek((0x1bd0 + tmp7_U8));
       /*$775E*/ s_y = ram_peek(0x1501);
-      /*$7761*/ func_7812(0xfffe);
+      /*$7761*/ func_7812(0xfffe); if (s_native_depth <= depth) return;
       /*$7764*/ CYCLES(0x7764, 7);
                 tmp7_U8 = s_a >= ram_peek(0x0002);
                 s_status_c = tmp7_U8;
@@ -17867,12 +17901,12 @@ void func_t001(uint16_t ret_addr) {
       /*$7778*/ CYCLES(0x7778, 11);
       /*$777A*/ tmp2_U8 = (uint8_t)(ram_peek(0x0000) + 0x01);
                 s_x = tmp2_U8;
-      /*$777B*/ func_779e(0xfffe);
+      /*$777B*/ func_779e(0xfffe); if (s_native_depth <= depth) return;
       /*$777E*/ CYCLES(0x777e, 23);
       /*$7780*/ s_x = ram_peek((0x1bd0 + tmp2_U8));
       /*$7783*/ s_a = ram_peek((0x1bb0 + tmp2_U8));
       /*$7786*/ s_y = 0x0a;
-      /*$7788*/ func_4cd0(0xfffe);
+      /*$7788*/ func_4cd0(0xfffe); if (s_native_depth <= depth) return;
       /*$778B*/ CYCLES(0x778b, 12);
                 tmp2_U8 = ram_peek(0x0000);
                 s_x = tmp2_U8;
@@ -17983,7 +18017,7 @@ void func_t001(uint16_t ret_addr) {
     case 1684:  // $77E2
       /*$77E2*/ CYCLES(0x77e2, 11);
                 s_a = ram_peek(0x0c2b);
-      /*$77E5*/ func_4c4b(0xfffe);
+      /*$77E5*/ func_4c4b(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1685;
       break;
     case 1685:  // $77E8
@@ -18084,7 +18118,7 @@ void func_t001(uint16_t ret_addr) {
       /*$7837*/ s_x = ((uint8_t)tmp5_U16);
       /*$7838*/ s_a = ram_peek((0x1bb0 + tmp6_U8));
       /*$7839*/ s_y = 0x0e;
-      /*$783B*/ func_4cd0(0x0000);
+      /*$783B*/ func_4cd0(0x0000); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = find_block_id_func_t001(0x783b, pop16() + 1);;
       break;
     case 1695:  // $783E
@@ -18107,7 +18141,7 @@ void func_t001(uint16_t ret_addr) {
       /*$785D*/ CYCLES(0x785d, 14);
                 s_y = s_a;
       /*$7861*/ s_x = ram_peek((0x1bb0 + s_x));
-      /*$7862*/ func_4c7c(0xfffe);
+      /*$7862*/ func_4c7c(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1698;
       break;
     case 1698:  // $7865
@@ -18132,7 +18166,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 1699:  // $7887
       /*$7887*/ CYCLES(0x7887, 6);
-                func_4c6e(0x0000);
+                func_4c6e(0x0000); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = find_block_id_func_t001(0x7887, pop16() + 1);;
       break;
     case 1700:  // $7896
@@ -18222,7 +18256,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 1714:  // $78CE
       /*$78CE*/ CYCLES(0x78ce, 6);
-                func_7778(0xfffe);
+                func_7778(0xfffe); if (s_native_depth <= depth) return;
       /*$78D1*/ CYCLES(0x78d1, 7);
                 tmp2_U8 = (uint8_t)(ram_peek(0x0001) - 0x01);
                 ram_poke(0x0001, tmp2_U8);
@@ -18257,7 +18291,7 @@ void func_t001(uint16_t ret_addr) {
       /*$7900*/ s_x = (uint8_t)(ram_peek((0x1bd0 + tmp2_U8)) - 0x02);
       /*$7901*/ s_a = ram_peek((0x1bb0 + tmp2_U8));
       /*$7904*/ s_y = 0x0e;
-      /*$7906*/ func_4cd0(0xfffe);
+      /*$7906*/ func_4cd0(0xfffe); if (s_native_depth <= depth) return;
       /*$7909*/ CYCLES(0x7909, 21);
                 tmp2_U8 = ram_peek(0x0000);
       /*$790B*/ s_y = ram_peek((0x1bd0 + tmp2_U8));
@@ -18289,7 +18323,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 1721:  // $7922
       /*$7922*/ CYCLES(0x7922, 6);
-                func_7979(0xfffe);
+                func_7979(0xfffe); if (s_native_depth <= depth) return;
       /*$7925*/ CYCLES(0x7925, 4);
                 branchTarget = true; block_id = !s_status_c ? 1719 : 1722;
       break;
@@ -18297,7 +18331,7 @@ void func_t001(uint16_t ret_addr) {
       /*$7927*/ CYCLES(0x7927, 14);
                 s_a = 0xff;
       /*$7929*/ ram_poke((0x1b90 + s_x), 0xff);
-      /*$792C*/ func_7459(0xfffe);
+      /*$792C*/ func_7459(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1723;
       break;
     case 1723:  // $792F
@@ -18326,7 +18360,7 @@ void func_t001(uint16_t ret_addr) {
       /*$7939*/ CYCLES(0x7939, 12);
                 s_a = 0x00;
       /*$793B*/ s_x = 0x64;
-      /*$793D*/ func_4dd0(0xfffe);
+      /*$793D*/ func_4dd0(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1727;
       break;
     case 1727:  // $7940
@@ -18533,25 +18567,27 @@ void func_t001(uint16_t ret_addr) {
                 branchTarget = true; block_id = find_block_id_func_t001(0xfded, ram_peek16al(0x0036));
       break;
     case 1754:
-      /*$4DFE*/ func_4e1f(0x0000);
+      /*$4DFE*/ func_4e1f(0x0000); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = find_block_id_func_t001(0x4dfe, pop16() + 1);;
       break;
     case 1755:
-      /*$54E3*/ func_54e5(0x0000);
+      /*$54E3*/ func_54e5(0x0000); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = find_block_id_func_t001(0x54e3, pop16() + 1);;
       break;
     case 1756:
-      /*$64A6*/ func_64a8(0x0000);
+      /*$64A6*/ func_64a8(0x0000); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = find_block_id_func_t001(0x64a6, pop16() + 1);;
       break;
     case 1757:
-      /*$67AF*/ func_67b8(0x0000);
+      /*$67AF*/ func_67b8(0x0000); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = find_block_id_func_t001(0x67af, pop16() + 1);;
       break;
     case 1758:
-      /*$67B6*/ func_67b8(0x0000);
+      /*$67B6*/ func_67b8(0x0000); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = find_block_id_func_t001(0x67b6, pop16() + 1);;
       break;
+    case UNWIND_BLOCK_ID:
+      return;
     default:
       fprintf(stderr, "panic: unknown block_id: %u\n", block_id);
       abort();
@@ -28,22 +28,6 @@ static uint16_t sbc_dec16(uint8_t a, uint8_t b, uint8_t cf) {
   return res.result | (res.status << 8);
 }
 
-static int cmp_map_addr(const void *a, const void *b) {
-  return *((const int *)a) - *((const int *)b);
-}
-
-static unsigned
-addr_to_block_id(uint16_t from_pc, uint16_t addr, const unsigned *block_map, size_t length) {
-  unsigned uaddr = addr;
-  const unsigned *p =
-      (const unsigned *)bsearch(&uaddr, block_map, length, sizeof(unsigned) * 2, cmp_map_addr);
-  if (p)
-    return p[1];
-  fprintf(stderr, "Unknown address $%04X\n", addr);
-  error_handler(from_pc);
-  abort();
-};
-
 void func_t001(uint16_t ret_addr);
 void FUNC_CHRGET(uint16_t ret_addr);
 void FUNC_CHRGOT(uint16_t ret_addr);
@@ -100,6 +84,111 @@ void FUNC_MON_RESTORE(uint16_t ret_addr);
 void FUNC_GETNUM(uint16_t ret_addr);
 void FUNC_ZMODE(uint16_t ret_addr);
 
+/// The entry points of the functions, where interpreted code continues
+/// natively.
+static const struct func_entry {
+  uint16_t addr;
+  void (*fn)(uint16_t ret_addr);
+} s_func_entries[] = {
+    {0x00b1, FUNC_CHRGET},
+    {0x00b7, FUNC_CHRGOT},
+    {0xd365, FUNC_GETFORPTR},
+    {0xd39a, FUNC_MVBLKUP2},
+    {0xd61a, FUNC_FNDLIN},
+    {0xd61e, FUNC_FNDLIN2},
+    {0xd697, FUNC_CLRTXTPTR},
+    {0xd72c, FUNC_GETCHAR},
+    {0xe07d, FUNC_ISLETC},
+    {0xe0ed, FUNC_GETARY},
+    {0xe484, FUNC_GARBAGE},
+    {0xe519, FUNC_CHKSMPLVAR},
+    {0xe523, FUNC_CHKVAR},
+    {0xe635, FUNC_FRETMS},
+    {0xe73d, FUNC_POINT},
+    {0xe89e, FUNC_TWSCMPFAC},
+    {0xe8a4, FUNC_TCFACMANT},
+    {0xe8c6, FUNC_INCFACMAN},
+    {0xe8f0, FUNC_SHFTRGHT},
+    {0xe907, FUNC_SHFTRGHT4},
+    {0xe9b0, FUNC_MULT1},
+    {0xe9b5, FUNC_MULT2},
+    {0xe9e3, FUNC_UPAY2ARG},
+    {0xeaf9, FUNC_UPAY2FAC},
+    {0xeb82, FUNC_SIGN},
+    {0xebb2, FUNC_FCOMP},
+    {0xebb4, FUNC_FCOMP2},
+    {0xebf2, FUNC_QINT},
+    {0xf411, FUNC_HPOSN},
+    {0xf457, FUNC_HPLOT0},
+    {0xf47e, FUNC_COLORSHIFT},
+    {0xf80e, FUNC_PLOT1},
+    {0xf847, FUNC_GBASCALC},
+    {0xf879, FUNC_SCRN2},
+    {0xf953, FUNC_PCADJ},
+    {0xf956, FUNC_PCADJ3},
+    {0xfb1e, FUNC_PREAD},
+    {0xfb2f, FUNC_INIT},
+    {0xfbc1, FUNC_BASCALC},
+    {0xfc24, FUNC_VTABZ},
+    {0xfc9c, FUNC_CLREOL},
+    {0xfc9e, FUNC_CLREOLZ},
+    {0xfcba, FUNC_NXTA1},
+    {0xfcc9, FUNC_HEADER},
+    {0xfcdb, FUNC_ZERODLY},
+    {0xfcfa, FUNC_RD2BIT},
+    {0xfcfd, FUNC_RDBIT},
+    {0xfe75, FUNC_A1PC},
+    {0xfe84, FUNC_SETNORM},
+    {0xfe89, FUNC_SETKBD},
+    {0xfe93, FUNC_SETVID},
+    {0xff3f, FUNC_MON_RESTORE},
+    {0xffa7, FUNC_GETNUM},
+    {0xffc7, FUNC_ZMODE},
+};
+
+static int cmp_func_entry(const void *key, const void *entry) {
+  return *((const uint16_t *)key) - ((const struct func_entry *)entry)->addr;
+}
+
+/// Invoked when execution reaches \p addr, which isn't a block of the current
+/// function. Return true if the function must return, because the code
+/// returned to one of its callers. Otherwise run the function starting at
+/// \p addr natively, or interpret one instruction, and store the address of
+/// the next one in \p addr.
+static bool run_unknown(uint16_t *addr) {
+  if (native_unwind(*addr))
+    return true;
+  const struct func_entry *f = (const struct func_entry *)bsearch(
+      addr,
+      s_func_entries,
+      sizeof(s_func_entries) / sizeof(s_func_entries[0]),
+      sizeof(s_func_entries[0]),
+      cmp_func_entry);
+  if (f && f->fn)
+    return native_call(f->fn, addr);
+  *addr = interpret_unknown(*addr);
+  return false;
+}
+
+static int cmp_map_addr(const void *a, const void *b) {
+  return *((const int *)a) - *((const int *)b);
+}
+
+/// Map \p addr to a block id. Code which wasn't decompiled is interpreted
+/// until it reaches a block in the map, or returns to a caller.
+static unsigned
+addr_to_block_id(uint16_t from_pc, uint16_t addr, const unsigned *block_map, size_t length) {
+  for (;;) {
+    unsigned uaddr = addr;
+    const unsigned *p =
+        (const unsigned *)bsearch(&uaddr, block_map, length, sizeof(unsigned) * 2, cmp_map_addr);
+    if (p)
+      return p[1];
+    if (run_unknown(&addr))
+      return UNWIND_BLOCK_ID;
+  }
+};
+
 static void emulated_entry_point(void) {
   func_t001(false);
 }
@@ -112,8 +201,7 @@ void FUNC_CHRGET(uint16_t ret_addr) {
   uint16_t tmp4_U16;
   uint16_t tmp5_U16;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$00B1*/ CYCLES(0x00b1, 7);
@@ -154,7 +242,7 @@ bb_4:
             s_a = tmp2_U8;
 bb_5:
   /*$00C8*/ CYCLES(0x00c8, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
@@ -166,8 +254,7 @@ void FUNC_CHRGOT(uint16_t ret_addr) {
   uint16_t tmp4_U16;
   uint16_t tmp5_U16;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$00B7*/ CYCLES(0x00b7, 12);
@@ -211,7 +298,7 @@ bb_4:
             s_a = tmp2_U8;
 bb_5:
   /*$00C8*/ CYCLES(0x00c8, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
@@ -223,8 +310,7 @@ void FUNC_GETFORPTR(uint16_t ret_addr) {
   uint16_t tmp4_U16;
   uint16_t tmp5_U16;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$D365*/ CYCLES(0xd365, 9);
@@ -284,7 +370,7 @@ bb_6:
               goto bb_1;
 bb_7:
   /*$D392*/ CYCLES(0xd392, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
@@ -296,8 +382,7 @@ void FUNC_MVBLKUP2(uint16_t ret_addr) {
   uint16_t tmp4_U16;
   uint8_t tmp5_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$D39A*/ CYCLES(0xd39a, 29);
@@ -377,22 +462,21 @@ bb_8:
               goto bb_6;
 bb_9:
   /*$D3D5*/ CYCLES(0xd3d5, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
 void FUNC_FNDLIN(uint16_t ret_addr) {
   bool branchTarget = true;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$D61A*/ CYCLES(0xd61a, 7);
             s_a = ram_peek(0x0067);
   /*$D61C*/ s_x = ram_peek(0x0068);
-            FUNC_FNDLIN2(0x0000);
-            if (ret_addr) pop16(); return;
+            FUNC_FNDLIN2(0x0000); if (s_native_depth <= depth) return;
+            native_return(ret_addr); return;
 }
 
 
@@ -402,8 +486,7 @@ void FUNC_FNDLIN2(uint16_t ret_addr) {
   uint8_t tmp2_U8;
   uint8_t tmp3_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$D61E*/ CYCLES(0xd61e, 18);
@@ -481,7 +564,7 @@ bb_7:
             s_status_c = 0x00;
 bb_8:
   /*$D648*/ CYCLES(0xd648, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
@@ -490,8 +573,7 @@ void FUNC_CLRTXTPTR(uint16_t ret_addr) {
   uint16_t tmp1_U16;
   uint16_t tmp2_U16;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$D697*/ CYCLES(0xd697, 24);
@@ -502,7 +584,7 @@ bb_0:
             s_status_c = (uint8_t)(tmp1_U16 >> 8);
             s_status_v = ovf8((uint8_t)tmp1_U16, (uint8_t)tmp2_U16, (uint8_t)0x00ff);
   /*$D6A2*/ ram_poke(0x00b9, ((uint8_t)tmp1_U16));
-  /*$D6A4*/ if (ret_addr) pop16(); return;
+  /*$D6A4*/ native_return(ret_addr); return;
 }
 
 
@@ -510,8 +592,7 @@ void FUNC_GETCHAR(uint16_t ret_addr) {
   bool branchTarget = true;
   uint8_t tmp1_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$D72C*/ CYCLES(0xd72c, 6);
@@ -529,7 +610,7 @@ bb_2:
             s_status_not_z = tmp1_U8;
             s_status_n = (tmp1_U8 & 0x80);
             s_a = tmp1_U8;
-  /*$D733*/ if (ret_addr) pop16(); return;
+  /*$D733*/ native_return(ret_addr); return;
 }
 
 
@@ -541,8 +622,7 @@ void FUNC_ISLETC(uint16_t ret_addr) {
   uint16_t tmp4_U16;
   uint16_t tmp5_U16;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$E07D*/ CYCLES(0xe07d, 7);
@@ -567,7 +647,7 @@ bb_1:
             s_a = tmp2_U8;
 bb_2:
   /*$E086*/ CYCLES(0xe086, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
@@ -578,8 +658,7 @@ void FUNC_GETARY(uint16_t ret_addr) {
   uint16_t tmp3_U16;
   uint8_t tmp4_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$E0ED*/ CYCLES(0xe0ed, 19);
@@ -603,7 +682,7 @@ bb_2:
   /*$E0F9*/ CYCLES(0xe0f9, 9);
             ram_poke(0x0094, s_a);
   /*$E0FB*/ ram_poke(0x0095, s_y);
-  /*$E0FD*/ if (ret_addr) pop16(); return;
+  /*$E0FD*/ native_return(ret_addr); return;
 }
 
 
@@ -615,8 +694,7 @@ void FUNC_GARBAGE(uint16_t ret_addr) {
   uint16_t tmp4_U16;
   uint16_t tmp5_U16;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$E484*/ CYCLES(0xe484, 7);
@@ -640,7 +718,7 @@ bb_2:
               goto bb_4;
 bb_3:
   /*$E4A4*/ CYCLES(0xe4a4, 6);
-            FUNC_CHKVAR(0xe4a6);
+            FUNC_CHKVAR(0xe4a6); if (s_native_depth <= depth) return;
   /*$E4A7*/ CYCLES(0xe4a7, 4);
             branchTarget = true;
             if (!s_status_not_z)
@@ -666,7 +744,7 @@ bb_6:
               goto bb_8;
 bb_7:
   /*$E4BD*/ CYCLES(0xe4bd, 6);
-            FUNC_CHKSMPLVAR(0xe4bf);
+            FUNC_CHKSMPLVAR(0xe4bf); if (s_native_depth <= depth) return;
   /*$E4C0*/ CYCLES(0xe4c0, 4);
             branchTarget = true;
             if (!s_status_not_z)
@@ -766,7 +844,7 @@ bb_19:
               goto bb_10;
 bb_20:
   /*$E514*/ CYCLES(0xe514, 6);
-            FUNC_CHKVAR(0xe516);
+            FUNC_CHKVAR(0xe516); if (s_native_depth <= depth) return;
   /*$E517*/ CYCLES(0xe517, 4);
             branchTarget = true;
             if (!s_status_not_z)
@@ -779,7 +857,7 @@ bb_21:
   /*$E55F*/ s_status_not_z = 0x00;
             s_status_n = 0x00;
             s_y = 0x00;
-  /*$E561*/ if (ret_addr) pop16(); return;
+  /*$E561*/ native_return(ret_addr); return;
 bb_22:
   /*$E566*/ CYCLES(0xe566, 53);
   /*$E56A*/ tmp2_U8 = (ram_peek(0x0091) & 0x04) >> 0x01;
@@ -793,7 +871,7 @@ bb_22:
   /*$E578*/ ram_poke(0x0097, ((uint8_t)tmp3_U16));
   /*$E57E*/ ram_poke(0x0094, ram_peek(0x006f));
   /*$E580*/ ram_poke(0x0095, ram_peek(0x0070));
-  /*$E582*/ FUNC_MVBLKUP2(0xe584);
+  /*$E582*/ FUNC_MVBLKUP2(0xe584); if (s_native_depth <= depth) return;
   /*$E585*/ CYCLES(0xe585, 31);
             tmp2_U8 = ram_peek(0x0091);
   /*$E588*/ tmp1_U8 = ram_peek(0x0094);
@@ -806,8 +884,8 @@ bb_22:
             branchTarget = true;
             goto bb_1;
 bb_23:
-  /*$E517*/ FUNC_CHKSMPLVAR(0x0000);
-            if (ret_addr) pop16(); return;
+  /*$E517*/ FUNC_CHKSMPLVAR(0x0000); if (s_native_depth <= depth) return;
+            native_return(ret_addr); return;
 }
 
 
@@ -819,8 +897,7 @@ void FUNC_CHKSMPLVAR(uint16_t ret_addr) {
   uint16_t tmp4_U16;
   uint8_t tmp5_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$E519*/ CYCLES(0xe519, 7);
@@ -839,8 +916,8 @@ bb_1:
 bb_2:
   /*$E522*/ CYCLES(0xe522, 2);
             s_y = (uint8_t)(s_y + 0x01);
-            FUNC_CHKVAR(0x0000);
-            if (ret_addr) pop16(); return;
+            FUNC_CHKVAR(0x0000); if (s_native_depth <= depth) return;
+            native_return(ret_addr); return;
 bb_3:
   /*$E552*/ CYCLES(0xe552, 16);
   /*$E555*/ tmp2_U16 = ram_peek(0x008f);
@@ -864,7 +941,7 @@ bb_5:
   /*$E55F*/ s_status_not_z = 0x00;
             s_status_n = 0x00;
             s_y = 0x00;
-  /*$E561*/ if (ret_addr) pop16(); return;
+  /*$E561*/ native_return(ret_addr); return;
 }
 
 
@@ -876,8 +953,7 @@ void FUNC_CHKVAR(uint16_t ret_addr) {
   uint16_t tmp4_U16;
   uint16_t tmp5_U16;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$E523*/ CYCLES(0xe523, 7);
@@ -955,7 +1031,7 @@ bb_10:
   /*$E55F*/ s_status_not_z = 0x00;
             s_status_n = 0x00;
             s_y = 0x00;
-  /*$E561*/ if (ret_addr) pop16(); return;
+  /*$E561*/ native_return(ret_addr); return;
 }
 
 
@@ -967,8 +1043,7 @@ void FUNC_FRETMS(uint16_t ret_addr) {
   uint16_t tmp4_U16;
   uint16_t tmp5_U16;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$E635*/ CYCLES(0xe635, 7);
@@ -1005,7 +1080,7 @@ bb_2:
             s_status_n = 0x00;
 bb_3:
   /*$E645*/ CYCLES(0xe645, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
@@ -1014,8 +1089,7 @@ void FUNC_POINT(uint16_t ret_addr) {
   uint8_t tmp1_U8;
   uint8_t tmp2_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$E73D*/ CYCLES(0xe73d, 16);
@@ -1027,21 +1101,20 @@ bb_0:
             s_y = tmp2_U8;
   /*$E741*/ ram_poke(0x00b8, tmp1_U8);
   /*$E743*/ ram_poke(0x00b9, tmp2_U8);
-  /*$E745*/ if (ret_addr) pop16(); return;
+  /*$E745*/ native_return(ret_addr); return;
 }
 
 
 void FUNC_TWSCMPFAC(uint16_t ret_addr) {
   bool branchTarget = true;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$E89E*/ CYCLES(0xe89e, 11);
   /*$E8A2*/ ram_poke(0x00a2, (ram_peek(0x00a2) ^ 0xff));
-            FUNC_TCFACMANT(0x0000);
-            if (ret_addr) pop16(); return;
+            FUNC_TCFACMANT(0x0000); if (s_native_depth <= depth) return;
+            native_return(ret_addr); return;
 }
 
 
@@ -1049,8 +1122,7 @@ void FUNC_TCFACMANT(uint16_t ret_addr) {
   bool branchTarget = true;
   uint8_t tmp1_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$E8A4*/ CYCLES(0xe8a4, 58);
@@ -1070,10 +1142,10 @@ bb_0:
               goto bb_2;
 bb_1:
   /*$E8D4*/ CYCLES(0xe8d4, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 bb_2:
-  /*$E8C4*/ FUNC_INCFACMAN(0x0000);
-            if (ret_addr) pop16(); return;
+  /*$E8C4*/ FUNC_INCFACMAN(0x0000); if (s_native_depth <= depth) return;
+            native_return(ret_addr); return;
 }
 
 
@@ -1081,8 +1153,7 @@ void FUNC_INCFACMAN(uint16_t ret_addr) {
   bool branchTarget = true;
   uint8_t tmp1_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$E8C6*/ CYCLES(0xe8c6, 7);
@@ -1119,7 +1190,7 @@ bb_3:
             ram_poke(0x009e, tmp1_U8);
 bb_4:
   /*$E8D4*/ CYCLES(0xe8d4, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
@@ -1131,8 +1202,7 @@ void FUNC_SHFTRGHT(uint16_t ret_addr) {
   uint8_t tmp4_U8;
   uint8_t tmp5_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$E8F0*/ CYCLES(0xe8f0, 7);
@@ -1215,7 +1285,7 @@ bb_6:
 bb_7:
   /*$E911*/ CYCLES(0xe911, 4);
             s_status_c = 0x00;
-  /*$E912*/ if (ret_addr) pop16(); return;
+  /*$E912*/ native_return(ret_addr); return;
 }
 
 
@@ -1227,8 +1297,7 @@ void FUNC_SHFTRGHT4(uint16_t ret_addr) {
   uint8_t tmp4_U8;
   uint16_t tmp5_U16;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$E907*/ CYCLES(0xe907, 18);
@@ -1278,7 +1347,7 @@ bb_3:
 bb_4:
   /*$E911*/ CYCLES(0xe911, 4);
             s_status_c = 0x00;
-  /*$E912*/ if (ret_addr) pop16(); return;
+  /*$E912*/ native_return(ret_addr); return;
 }
 
 
@@ -1290,8 +1359,7 @@ void FUNC_MULT1(uint16_t ret_addr) {
   uint8_t tmp4_U8;
   uint8_t tmp5_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$E9B0*/ CYCLES(0xe9b0, 4);
@@ -1372,15 +1440,15 @@ bb_6:
 bb_7:
   /*$E911*/ CYCLES(0xe911, 4);
             s_status_c = 0x00;
-  /*$E912*/ if (ret_addr) pop16(); return;
+  /*$E912*/ native_return(ret_addr); return;
 bb_8:
   /*$E9B2*/ CYCLES(0xe9b2, 6);
   /*$E8DA*/ CYCLES(0xe8da, 4);
             s_x = 0x61;
             goto bb_1;
 bb_9:
-  /*$E9B0*/ FUNC_MULT2(0x0000);
-            if (ret_addr) pop16(); return;
+  /*$E9B0*/ FUNC_MULT2(0x0000); if (s_native_depth <= depth) return;
+            native_return(ret_addr); return;
 }
 
 
@@ -1392,8 +1460,7 @@ void FUNC_MULT2(uint16_t ret_addr) {
   uint16_t tmp4_U16;
   uint8_t tmp5_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$E9B5*/ CYCLES(0xe9b5, 6);
@@ -1442,7 +1509,7 @@ bb_3:
               goto bb_1;
 bb_4:
   /*$E9E2*/ CYCLES(0xe9e2, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
@@ -1450,8 +1517,7 @@ void FUNC_UPAY2ARG(uint16_t ret_addr) {
   bool branchTarget = true;
   uint8_t tmp1_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$E9E3*/ CYCLES(0xe9e3, 74);
@@ -1474,7 +1540,7 @@ bb_0:
             s_status_not_z = tmp1_U8;
             s_status_n = (tmp1_U8 & 0x80);
             s_a = tmp1_U8;
-  /*$EA0D*/ if (ret_addr) pop16(); return;
+  /*$EA0D*/ native_return(ret_addr); return;
 }
 
 
@@ -1482,8 +1548,7 @@ void FUNC_UPAY2FAC(uint16_t ret_addr) {
   bool branchTarget = true;
   uint8_t tmp1_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$EAF9*/ CYCLES(0xeaf9, 63);
@@ -1505,7 +1570,7 @@ bb_0:
             s_a = tmp1_U8;
   /*$EB19*/ ram_poke(0x009d, tmp1_U8);
   /*$EB1B*/ ram_poke(0x00ac, 0x00);
-  /*$EB1D*/ if (ret_addr) pop16(); return;
+  /*$EB1D*/ native_return(ret_addr); return;
 }
 
 
@@ -1513,8 +1578,7 @@ void FUNC_SIGN(uint16_t ret_addr) {
   bool branchTarget = true;
   uint8_t tmp1_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$EB82*/ CYCLES(0xeb82, 7);
@@ -1543,21 +1607,20 @@ bb_2:
             s_a = 0x01;
 bb_3:
   /*$EB8F*/ CYCLES(0xeb8f, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
 void FUNC_FCOMP(uint16_t ret_addr) {
   bool branchTarget = true;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$EBB2*/ CYCLES(0xebb2, 4);
             ram_poke(0x0060, s_a);
-            FUNC_FCOMP2(0x0000);
-            if (ret_addr) pop16(); return;
+            FUNC_FCOMP2(0x0000); if (s_native_depth <= depth) return;
+            native_return(ret_addr); return;
 }
 
 
@@ -1569,8 +1632,7 @@ void FUNC_FCOMP2(uint16_t ret_addr) {
   uint16_t tmp4_U16;
   uint16_t tmp5_U16;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$EBB4*/ CYCLES(0xebb4, 18);
@@ -1603,7 +1665,7 @@ bb_3:
             s_a = 0x01;
 bb_4:
   /*$EB8F*/ CYCLES(0xeb8f, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 bb_5:
   /*$EBBE*/ CYCLES(0xebbe, 11);
             tmp1_U8 = peek((ram_peek16al(0x0060) + s_y));
@@ -1679,10 +1741,10 @@ bb_13:
             goto bb_2;
 bb_14:
   /*$EC11*/ CYCLES(0xec11, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 bb_15:
-  /*$EBBC*/ FUNC_SIGN(0x0000);
-            if (ret_addr) pop16(); return;
+  /*$EBBC*/ FUNC_SIGN(0x0000); if (s_native_depth <= depth) return;
+            native_return(ret_addr); return;
 }
 
 
@@ -1690,8 +1752,7 @@ void FUNC_QINT(uint16_t ret_addr) {
   bool branchTarget = true;
   uint8_t tmp1_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$EBF2*/ CYCLES(0xebf2, 7);
@@ -1712,7 +1773,7 @@ bb_2:
   /*$EBFD*/ CYCLES(0xebfd, 14);
             tmp1_U8 = s_a;
   /*$EC00*/ ram_poke(0x00a4, 0xff);
-  /*$EC02*/ FUNC_TCFACMANT(0xec04);
+  /*$EC02*/ FUNC_TCFACMANT(0xec04); if (s_native_depth <= depth) return;
   /*$EC05*/ CYCLES(0xec05, 2);
             s_a = tmp1_U8;
 bb_3:
@@ -1725,11 +1786,11 @@ bb_3:
               goto bb_5;
 bb_4:
   /*$EC0C*/ CYCLES(0xec0c, 6);
-            FUNC_SHFTRGHT(0xec0e);
+            FUNC_SHFTRGHT(0xec0e); if (s_native_depth <= depth) return;
   /*$EC0F*/ CYCLES(0xec0f, 4);
             ram_poke(0x00a4, s_y);
   /*$EC11*/ CYCLES(0xec11, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 bb_5:
   /*$EC12*/ CYCLES(0xec12, 24);
             s_y = s_a;
@@ -1739,10 +1800,10 @@ bb_5:
   /*$EC19*/ tmp1_U8 = (ram_peek(0x00a2) & 0x80) | ram_peek(0x009e);
             s_a = tmp1_U8;
   /*$EC1B*/ ram_poke(0x009e, tmp1_U8);
-  /*$EC1D*/ FUNC_SHFTRGHT4(0xec1f);
+  /*$EC1D*/ FUNC_SHFTRGHT4(0xec1f); if (s_native_depth <= depth) return;
   /*$EC20*/ CYCLES(0xec20, 6);
             ram_poke(0x00a4, s_y);
-  /*$EC22*/ if (ret_addr) pop16(); return;
+  /*$EC22*/ native_return(ret_addr); return;
 bb_6:
   /*$EC40*/ CYCLES(0xec40, 18);
             tmp1_U8 = s_a;
@@ -1753,7 +1814,7 @@ bb_6:
   /*$EC48*/ s_status_not_z = tmp1_U8;
             s_status_n = (tmp1_U8 & 0x80);
             s_y = tmp1_U8;
-  /*$EC49*/ if (ret_addr) pop16(); return;
+  /*$EC49*/ native_return(ret_addr); return;
 }
 
 
@@ -1765,8 +1826,7 @@ void FUNC_HPOSN(uint16_t ret_addr) {
   uint16_t tmp4_U16;
   uint16_t tmp5_U16;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$F411*/ CYCLES(0xf411, 75);
@@ -1829,10 +1889,10 @@ bb_4:
               goto bb_6;
 bb_5:
   /*$F456*/ CYCLES(0xf456, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 bb_6:
-  /*$F454*/ FUNC_COLORSHIFT(0x0000);
-            if (ret_addr) pop16(); return;
+  /*$F454*/ FUNC_COLORSHIFT(0x0000); if (s_native_depth <= depth) return;
+            native_return(ret_addr); return;
 }
 
 
@@ -1842,18 +1902,17 @@ void FUNC_HPLOT0(uint16_t ret_addr) {
   uint8_t tmp2_U8;
   uint8_t tmp3_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$F457*/ CYCLES(0xf457, 6);
-            FUNC_HPOSN(0xf459);
+            FUNC_HPOSN(0xf459); if (s_native_depth <= depth) return;
   /*$F45A*/ CYCLES(0xf45a, 19);
   /*$F45C*/ tmp1_U8 = s_y;
             tmp2_U8 = peek((ram_peek16al(0x0026) + tmp1_U8));
   /*$F460*/ tmp3_U8 = peek((ram_peek16al(0x0026) + tmp1_U8));
   /*$F462*/ poke((ram_peek16al(0x0026) + tmp1_U8), (((ram_peek(0x001c) ^ tmp2_U8) & ram_peek(0x0030)) ^ tmp3_U8));
-  /*$F464*/ if (ret_addr) pop16(); return;
+  /*$F464*/ native_return(ret_addr); return;
 }
 
 
@@ -1861,8 +1920,7 @@ void FUNC_COLORSHIFT(uint16_t ret_addr) {
   bool branchTarget = true;
   uint8_t tmp1_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$F47E*/ CYCLES(0xf47e, 9);
@@ -1884,7 +1942,7 @@ bb_1:
   /*$F487*/ ram_poke(0x001c, tmp1_U8);
 bb_2:
   /*$F489*/ CYCLES(0xf489, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
@@ -1894,8 +1952,7 @@ void FUNC_PLOT1(uint16_t ret_addr) {
   uint8_t tmp2_U8;
   uint8_t tmp3_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$F80E*/ CYCLES(0xf80e, 19);
@@ -1907,7 +1964,7 @@ bb_0:
             s_status_n = (tmp2_U8 & 0x80);
             s_a = tmp2_U8;
   /*$F816*/ poke((ram_peek16al(0x0026) + tmp1_U8), tmp2_U8);
-  /*$F818*/ if (ret_addr) pop16(); return;
+  /*$F818*/ native_return(ret_addr); return;
 }
 
 
@@ -1916,8 +1973,7 @@ void FUNC_GBASCALC(uint16_t ret_addr) {
   uint8_t tmp1_U8;
   uint8_t tmp2_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$F847*/ CYCLES(0xf847, 23);
@@ -1939,7 +1995,7 @@ bb_2:
             tmp2_U8 = s_a;
             ram_poke(0x0026, tmp2_U8);
   /*$F85C*/ ram_poke(0x0026, ((uint8_t)(tmp2_U8 << 0x02) | ram_peek(0x0026)));
-  /*$F85E*/ if (ret_addr) pop16(); return;
+  /*$F85E*/ native_return(ret_addr); return;
 }
 
 
@@ -1947,8 +2003,7 @@ void FUNC_SCRN2(uint16_t ret_addr) {
   bool branchTarget = true;
   uint8_t tmp1_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$F879*/ CYCLES(0xf879, 4);
@@ -1966,22 +2021,21 @@ bb_2:
             s_status_not_z = tmp1_U8;
             s_status_n = 0x00;
             s_a = tmp1_U8;
-  /*$F881*/ if (ret_addr) pop16(); return;
+  /*$F881*/ native_return(ret_addr); return;
 }
 
 
 void FUNC_PCADJ(uint16_t ret_addr) {
   bool branchTarget = true;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$F953*/ CYCLES(0xf953, 6);
             s_status_c = 0x01;
   /*$F954*/ s_a = ram_peek(0x002f);
-            FUNC_PCADJ3(0x0000);
-            if (ret_addr) pop16(); return;
+            FUNC_PCADJ3(0x0000); if (s_native_depth <= depth) return;
+            native_return(ret_addr); return;
 }
 
 
@@ -1993,8 +2047,7 @@ void FUNC_PCADJ3(uint16_t ret_addr) {
   uint16_t tmp4_U16;
   uint8_t tmp5_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$F956*/ CYCLES(0xf956, 9);
@@ -2030,7 +2083,7 @@ bb_3:
             s_y = tmp1_U8;
 bb_4:
   /*$F961*/ CYCLES(0xf961, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
@@ -2038,8 +2091,7 @@ void FUNC_PREAD(uint16_t ret_addr) {
   bool branchTarget = true;
   uint8_t tmp1_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$FB1E*/ CYCLES(0xfb1e, 12);
@@ -2063,7 +2115,7 @@ bb_3:
             s_y = (uint8_t)(s_y - 0x01);
 bb_4:
   /*$FB2E*/ CYCLES(0xfb2e, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
@@ -2071,8 +2123,7 @@ void FUNC_INIT(uint16_t ret_addr) {
   bool branchTarget = true;
   uint8_t tmp1_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$FB2F*/ CYCLES(0xfb2f, 18);
@@ -2090,8 +2141,8 @@ bb_0:
             ram_poke(0x0025, 0x17);
   /*$FC22*/ CYCLES(0xfc22, 4);
             s_a = ram_peek(0x0025);
-            FUNC_VTABZ(0x0000);
-            if (ret_addr) pop16(); return;
+            FUNC_VTABZ(0x0000); if (s_native_depth <= depth) return;
+            native_return(ret_addr); return;
 }
 
 
@@ -2102,8 +2153,7 @@ void FUNC_BASCALC(uint16_t ret_addr) {
   uint16_t tmp3_U16;
   uint16_t tmp4_U16;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$FBC1*/ CYCLES(0xfbc1, 23);
@@ -2134,7 +2184,7 @@ bb_2:
             s_status_n = (tmp2_U8 & 0x80);
             s_a = tmp2_U8;
   /*$FBD6*/ ram_poke(0x0028, tmp2_U8);
-  /*$FBD8*/ if (ret_addr) pop16(); return;
+  /*$FBD8*/ native_return(ret_addr); return;
 }
 
 
@@ -2145,12 +2195,11 @@ void FUNC_VTABZ(uint16_t ret_addr) {
   uint16_t tmp3_U16;
   uint8_t tmp4_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$FC24*/ CYCLES(0xfc24, 6);
-            FUNC_BASCALC(0xfc26);
+            FUNC_BASCALC(0xfc26); if (s_native_depth <= depth) return;
   /*$FC27*/ CYCLES(0xfc27, 7);
             tmp1_U16 = s_a;
             tmp2_U16 = ram_peek(0x0020);
@@ -2163,21 +2212,20 @@ bb_0:
             s_a = tmp4_U8;
   /*$FC29*/ ram_poke(0x0028, tmp4_U8);
   /*$FC2B*/ CYCLES(0xfc2b, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
 void FUNC_CLREOL(uint16_t ret_addr) {
   bool branchTarget = true;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$FC9C*/ CYCLES(0xfc9c, 4);
             s_y = ram_peek(0x0024);
-            FUNC_CLREOLZ(0x0000);
-            if (ret_addr) pop16(); return;
+            FUNC_CLREOLZ(0x0000); if (s_native_depth <= depth) return;
+            native_return(ret_addr); return;
 }
 
 
@@ -2187,8 +2235,7 @@ void FUNC_CLREOLZ(uint16_t ret_addr) {
   uint8_t tmp2_U8;
   uint8_t tmp3_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$FC9E*/ CYCLES(0xfc9e, 4);
@@ -2209,7 +2256,7 @@ bb_1:
               goto bb_1;
 bb_2:
   /*$FCA7*/ CYCLES(0xfca7, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
@@ -2220,8 +2267,7 @@ void FUNC_NXTA1(uint16_t ret_addr) {
   uint16_t tmp3_U16;
   uint8_t tmp4_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$FCBA*/ CYCLES(0xfcba, 21);
@@ -2246,7 +2292,7 @@ bb_1:
             ram_poke(0x003d, tmp4_U8);
 bb_2:
   /*$FCC8*/ CYCLES(0xfcc8, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
@@ -2256,13 +2302,12 @@ void FUNC_HEADER(uint16_t ret_addr) {
   uint16_t tmp2_U16;
   uint8_t tmp3_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$FCC9*/ CYCLES(0xfcc9, 9);
             s_y = 0x4b;
-  /*$FCCB*/ FUNC_ZERODLY(0xfccd);
+  /*$FCCB*/ FUNC_ZERODLY(0xfccd); if (s_native_depth <= depth) return;
   /*$FCCE*/ CYCLES(0xfcce, 4);
             branchTarget = true;
             if (s_status_not_z)
@@ -2281,11 +2326,11 @@ bb_1:
 bb_2:
   /*$FCD4*/ CYCLES(0xfcd4, 9);
             s_y = 0x21;
-  /*$FCD6*/ FUNC_ZERODLY(0xfcd8);
+  /*$FCD6*/ FUNC_ZERODLY(0xfcd8); if (s_native_depth <= depth) return;
   /*$FCD9*/ CYCLES(0xfcd9, 4);
   /*$FCDA*/ s_y = (uint8_t)(s_y + 0x02);
-            FUNC_ZERODLY(0x0000);
-            if (ret_addr) pop16(); return;
+            FUNC_ZERODLY(0x0000); if (s_native_depth <= depth) return;
+            native_return(ret_addr); return;
 }
 
 
@@ -2293,8 +2338,7 @@ void FUNC_ZERODLY(uint16_t ret_addr) {
   bool branchTarget = true;
   uint8_t tmp1_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$FCDB*/ CYCLES(0xfcdb, 6);
@@ -2326,21 +2370,20 @@ bb_4:
             s_status_not_z = tmp1_U8;
             s_status_n = (tmp1_U8 & 0x80);
             s_x = tmp1_U8;
-  /*$FCEB*/ if (ret_addr) pop16(); return;
+  /*$FCEB*/ native_return(ret_addr); return;
 }
 
 
 void FUNC_RD2BIT(uint16_t ret_addr) {
   bool branchTarget = true;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$FCFA*/ CYCLES(0xfcfa, 6);
-            FUNC_RDBIT(0xfcfc);
-            FUNC_RDBIT(0x0000);
-            if (ret_addr) pop16(); return;
+            FUNC_RDBIT(0xfcfc); if (s_native_depth <= depth) return;
+            FUNC_RDBIT(0x0000); if (s_native_depth <= depth) return;
+            native_return(ret_addr); return;
 }
 
 
@@ -2348,8 +2391,7 @@ void FUNC_RDBIT(uint16_t ret_addr) {
   bool branchTarget = true;
   uint8_t tmp1_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$FCFD*/ CYCLES(0xfcfd, 14);
@@ -2369,7 +2411,7 @@ bb_1:
             s_status_not_z = (tmp1_U8 != 0x80);
             s_status_c = (tmp1_U8 >= 0x80);
             s_status_n = ((uint8_t)(tmp1_U8 - 0x80) & 0x80);
-  /*$FD0B*/ if (ret_addr) pop16(); return;
+  /*$FD0B*/ native_return(ret_addr); return;
 }
 
 
@@ -2377,8 +2419,7 @@ void FUNC_A1PC(uint16_t ret_addr) {
   bool branchTarget = true;
   uint8_t tmp1_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$FE75*/ CYCLES(0xfe75, 6);
@@ -2396,20 +2437,19 @@ bb_1:
               goto bb_1;
 bb_2:
   /*$FE7F*/ CYCLES(0xfe7f, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
 void FUNC_SETNORM(uint16_t ret_addr) {
   bool branchTarget = true;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$FE84*/ CYCLES(0xfe84, 9);
   /*$FE86*/ ram_poke(0x0032, 0xff);
-  /*$FE88*/ if (ret_addr) pop16(); return;
+  /*$FE88*/ native_return(ret_addr); return;
 }
 
 
@@ -2417,8 +2457,7 @@ void FUNC_SETKBD(uint16_t ret_addr) {
   bool branchTarget = true;
   uint8_t tmp1_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$FE89*/ CYCLES(0xfe89, 18);
@@ -2445,7 +2484,7 @@ bb_3:
             tmp1_U8 = s_x;
             ram_poke(tmp1_U8, s_y);
   /*$FEAB*/ ram_poke((uint8_t)(0x01 + tmp1_U8), s_a);
-  /*$FEAD*/ if (ret_addr) pop16(); return;
+  /*$FEAD*/ native_return(ret_addr); return;
 }
 
 
@@ -2453,8 +2492,7 @@ void FUNC_SETVID(uint16_t ret_addr) {
   bool branchTarget = true;
   uint8_t tmp1_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$FE93*/ CYCLES(0xfe93, 14);
@@ -2481,7 +2519,7 @@ bb_3:
             tmp1_U8 = s_x;
             ram_poke(tmp1_U8, s_y);
   /*$FEAB*/ ram_poke((uint8_t)(0x01 + tmp1_U8), s_a);
-  /*$FEAD*/ if (ret_addr) pop16(); return;
+  /*$FEAD*/ native_return(ret_addr); return;
 }
 
 
@@ -2489,8 +2527,7 @@ void FUNC_MON_RESTORE(uint16_t ret_addr) {
   bool branchTarget = true;
   uint8_t tmp1_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$FF3F*/ CYCLES(0xff3f, 19);
@@ -2506,7 +2543,7 @@ bb_0:
             s_status_b = 0x00;
             s_status_v = ((tmp1_U8 & 0x40) != 0);
             s_status_n = (tmp1_U8 & 0x80);
-  /*$FF49*/ if (ret_addr) pop16(); return;
+  /*$FF49*/ native_return(ret_addr); return;
 }
 
 
@@ -2517,8 +2554,7 @@ void FUNC_GETNUM(uint16_t ret_addr) {
   uint16_t tmp3_U16;
   uint8_t tmp4_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$FFA7*/ CYCLES(0xffa7, 11);
@@ -2591,15 +2627,14 @@ bb_8:
               goto bb_1;
 bb_9:
   /*$FFBD*/ CYCLES(0xffbd, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
 void FUNC_ZMODE(uint16_t ret_addr) {
   bool branchTarget = true;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$FFC7*/ CYCLES(0xffc7, 9);
@@ -2607,7 +2642,7 @@ bb_0:
             s_status_n = 0x00;
             s_y = 0x00;
   /*$FFC9*/ ram_poke(0x0031, 0x00);
-  /*$FFCB*/ if (ret_addr) pop16(); return;
+  /*$FFCB*/ native_return(ret_addr); return;
 }
 
 
@@ -2623,8 +2658,7 @@ void func_t001(uint16_t ret_addr) {
   uint16_t tmp5_U16;
   uint8_t tmp6_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
   for(;;) {
     switch (block_id) {
@@ -2633,7 +2667,7 @@ void func_t001(uint16_t ret_addr) {
                 s_status_b = 0x00;
                 s_status_i = 0x00;
       /*$FA62*/ CYCLES(0xfa62, 7);
-      /*$FA63*/ FUNC_SETNORM(0xfa65);
+      /*$FA63*/ FUNC_SETNORM(0xfa65); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1425;
       break;
     case 1:  // $0090
@@ -2756,7 +2790,7 @@ void func_t001(uint16_t ret_addr) {
       /*$D396*/ CYCLES(0xd396, 7);
                 ram_poke(0x006d, s_a);
       /*$D398*/ ram_poke(0x006e, s_y);
-                FUNC_MVBLKUP2(0x0000);
+                FUNC_MVBLKUP2(0x0000); if (s_native_depth <= depth) return;
                 block_id = find_block_id_func_t001(0xd398, pop16() + 1);;
       break;
     case 19:  // $D39A
@@ -2908,7 +2942,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 37:  // $D3F7
       /*$D3F7*/ CYCLES(0xd3f7, 6);
-                FUNC_GARBAGE(0xd3f9);
+                FUNC_GARBAGE(0xd3f9); if (s_native_depth <= depth) return;
       /*$D3FA*/ CYCLES(0xd3fa, 4);
                 s_x = 0xf7;
                 block_id = 38;
@@ -3027,7 +3061,7 @@ void func_t001(uint16_t ret_addr) {
                 ram_poke(0x00b8, s_x);
       /*$D446*/ ram_poke(0x00b9, s_y);
       /*$D448*/ ram_poke(0x00d8, (ram_peek(0x00d8) >> 0x01));
-      /*$D44A*/ FUNC_CHRGET(0xd44c);
+      /*$D44A*/ FUNC_CHRGET(0xd44c); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 58;
       break;
     case 58:  // $D44D
@@ -3063,7 +3097,7 @@ void func_t001(uint16_t ret_addr) {
     case 64:  // $D46A
       /*$D46A*/ CYCLES(0xd46a, 9);
                 ram_poke(0x000f, s_y);
-      /*$D46C*/ FUNC_FNDLIN(0xd46e);
+      /*$D46C*/ FUNC_FNDLIN(0xd46e); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 65;
       break;
     case 65:  // $D46F
@@ -3548,7 +3582,7 @@ void func_t001(uint16_t ret_addr) {
       /*$D61A*/ CYCLES(0xd61a, 7);
                 s_a = ram_peek(0x0067);
       /*$D61C*/ s_x = ram_peek(0x0068);
-                FUNC_FNDLIN2(0x0000);
+                FUNC_FNDLIN2(0x0000); if (s_native_depth <= depth) return;
                 block_id = find_block_id_func_t001(0xd61c, pop16() + 1);;
       break;
     case 135:  // $D61E
@@ -3645,7 +3679,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 146:  // $D665
       /*$D665*/ CYCLES(0xd665, 6);
-                FUNC_CLRTXTPTR(0xd667);
+                FUNC_CLRTXTPTR(0xd667); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 147;
       break;
     case 147:  // $D668
@@ -3736,12 +3770,12 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 158:  // $D6B4
       /*$D6B4*/ CYCLES(0xd6b4, 6);
-                FUNC_FNDLIN(0xd6b6);
+                FUNC_FNDLIN(0xd6b6); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 159;
       break;
     case 159:  // $D6B7
       /*$D6B7*/ CYCLES(0xd6b7, 6);
-                FUNC_CHRGOT(0xd6b9);
+                FUNC_CHRGOT(0xd6b9); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 160;
       break;
     case 160:  // $D6BA
@@ -3763,7 +3797,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 163:  // $D6C4
       /*$D6C4*/ CYCLES(0xd6c4, 6);
-                FUNC_CHRGET(0xd6c6);
+                FUNC_CHRGET(0xd6c6); if (s_native_depth <= depth) return;
       /*$D6C7*/ CYCLES(0xd6c7, 6);
                 branchTarget = true; push16(0xd6c9); block_id = 317;
       break;
@@ -3929,7 +3963,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 190:  // $D749
       /*$D749*/ CYCLES(0xd749, 6);
-                FUNC_GETCHAR(0xd74b);
+                FUNC_GETCHAR(0xd74b); if (s_native_depth <= depth) return;
       /*$D74C*/ CYCLES(0xd74c, 4);
                 branchTarget = true; block_id = !s_status_n ? 190 : 191;
       break;
@@ -3944,7 +3978,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 193:  // $D755
       /*$D755*/ CYCLES(0xd755, 6);
-                FUNC_GETCHAR(0xd757);
+                FUNC_GETCHAR(0xd757); if (s_native_depth <= depth) return;
       /*$D758*/ CYCLES(0xd758, 4);
                 branchTarget = true; block_id = s_status_n ? 196 : 194;
       break;
@@ -3973,7 +4007,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 199:  // $D76D
       /*$D76D*/ CYCLES(0xd76d, 6);
-                FUNC_GETFORPTR(0xd76f);
+                FUNC_GETFORPTR(0xd76f); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 200;
       break;
     case 200:  // $D770
@@ -4034,12 +4068,12 @@ void func_t001(uint16_t ret_addr) {
       /*$D7AF*/ CYCLES(0xd7af, 12);
                 s_a = 0x13;
       /*$D7B1*/ s_y = 0xe9;
-      /*$D7B3*/ FUNC_UPAY2FAC(0xd7b5);
+      /*$D7B3*/ FUNC_UPAY2FAC(0xd7b5); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 209;
       break;
     case 209:  // $D7B6
       /*$D7B6*/ CYCLES(0xd7b6, 6);
-                FUNC_CHRGOT(0xd7b8);
+                FUNC_CHRGOT(0xd7b8); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 210;
       break;
     case 210:  // $D7B9
@@ -4050,7 +4084,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 211:  // $D7BD
       /*$D7BD*/ CYCLES(0xd7bd, 6);
-                FUNC_CHRGET(0xd7bf);
+                FUNC_CHRGET(0xd7bf); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 212;
       break;
     case 212:  // $D7C0
@@ -4059,7 +4093,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 213:  // $D7C3
       /*$D7C3*/ CYCLES(0xd7c3, 6);
-                FUNC_SIGN(0xd7c5);
+                FUNC_SIGN(0xd7c5); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 214;
       break;
     case 214:  // $D7C6
@@ -4160,7 +4194,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 228:  // $D81D
       /*$D81D*/ CYCLES(0xd81d, 6);
-                FUNC_CHRGET(0xd81f);
+                FUNC_CHRGET(0xd81f); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 229;
       break;
     case 229:  // $D820
@@ -4203,7 +4237,7 @@ void func_t001(uint16_t ret_addr) {
       /*$D837*/ push8(tmp6_U8);
       /*$D838*/ tmp1_U8 = ram_peek((0xd000 + (tmp4_U16 & 0x00ff)));
       /*$D83B*/ push8(tmp1_U8);
-      /*$D83C*/ FUNC_CHRGET(0x0000);
+      /*$D83C*/ FUNC_CHRGET(0x0000); if (s_native_depth <= depth) return;
                 tmp2_U8 = pop8();
                 tmp2_U8 = pop8();
                 branchTarget = true; block_id = find_block_id_func_t001(0xd83b, ((tmp1_U8 + (tmp6_U8 << 8)) + 0x0001));
@@ -4381,7 +4415,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 264:  // $D935
       /*$D935*/ CYCLES(0xd935, 6);
-                FUNC_CHRGOT(0xd937);
+                FUNC_CHRGOT(0xd937); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 265;
       break;
     case 265:  // $D938
@@ -4426,7 +4460,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 273:  // $D959
       /*$D959*/ CYCLES(0xd959, 6);
-                FUNC_FNDLIN2(0xd95b);
+                FUNC_FNDLIN2(0xd95b); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 274;
       break;
     case 274:  // $D95C
@@ -4459,7 +4493,7 @@ void func_t001(uint16_t ret_addr) {
     case 278:  // $D96D
       /*$D96D*/ CYCLES(0xd96d, 12);
       /*$D96F*/ ram_poke(0x0085, 0xff);
-      /*$D971*/ FUNC_GETFORPTR(0xd973);
+      /*$D971*/ FUNC_GETFORPTR(0xd973); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 279;
       break;
     case 279:  // $D974
@@ -4604,7 +4638,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 298:  // $D9CC
       /*$D9CC*/ CYCLES(0xd9cc, 6);
-                FUNC_CHRGOT(0xd9ce);
+                FUNC_CHRGOT(0xd9ce); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 299;
       break;
     case 299:  // $D9CF
@@ -4634,7 +4668,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 304:  // $D9E1
       /*$D9E1*/ CYCLES(0xd9e1, 6);
-                FUNC_CHRGOT(0xd9e3);
+                FUNC_CHRGOT(0xd9e3); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 305;
       break;
     case 305:  // $D9E4
@@ -4680,7 +4714,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 313:  // $DA00
       /*$DA00*/ CYCLES(0xda00, 6);
-                FUNC_CHRGET(0xda02);
+                FUNC_CHRGET(0xda02); if (s_native_depth <= depth) return;
       /*$DA03*/ CYCLES(0xda03, 6);
                 branchTarget = true; push16(0xda05); block_id = 317;
       break;
@@ -4754,7 +4788,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 322:  // $DA40
       /*$DA40*/ CYCLES(0xda40, 6);
-                FUNC_CHRGET(0xda42);
+                FUNC_CHRGET(0xda42); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 323;
       break;
     case 323:  // $DA43
@@ -4894,7 +4928,7 @@ void func_t001(uint16_t ret_addr) {
       /*$DAB7*/ CYCLES(0xdab7, 12);
                 ram_poke(0x008c, s_a);
       /*$DAB9*/ ram_poke(0x008d, s_y);
-      /*$DABB*/ FUNC_FRETMS(0xdabd);
+      /*$DABB*/ FUNC_FRETMS(0xdabd); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 347;
       break;
     case 347:  // $DABE
@@ -4917,7 +4951,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 349:  // $DAD2
       /*$DAD2*/ CYCLES(0xdad2, 6);
-                FUNC_CHRGOT(0xdad4);
+                FUNC_CHRGOT(0xdad4); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 350;
       break;
     case 350:  // $DAD5
@@ -5085,7 +5119,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 376:  // $DB2F
       /*$DB2F*/ CYCLES(0xdb2f, 6);
-                FUNC_CHRGET(0xdb31);
+                FUNC_CHRGET(0xdb31); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 377;
       break;
     case 377:  // $DB32
@@ -5347,7 +5381,7 @@ void func_t001(uint16_t ret_addr) {
                 s_y = tmp6_U8;
       /*$DC04*/ ram_poke(0x00b8, tmp1_U8);
       /*$DC06*/ ram_poke(0x00b9, tmp6_U8);
-      /*$DC08*/ FUNC_CHRGOT(0xdc0a);
+      /*$DC08*/ FUNC_CHRGOT(0xdc0a); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 423;
       break;
     case 423:  // $DC0B
@@ -5393,7 +5427,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 431:  // $DC2B
       /*$DC2B*/ CYCLES(0xdc2b, 6);
-                FUNC_CHRGET(0xdc2d);
+                FUNC_CHRGET(0xdc2d); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 432;
       break;
     case 432:  // $DC2E
@@ -5452,7 +5486,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 441:  // $DC5A
       /*$DC5A*/ CYCLES(0xdc5a, 6);
-                FUNC_POINT(0xdc5c);
+                FUNC_POINT(0xdc5c); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 442;
       break;
     case 442:  // $DC5D
@@ -5481,7 +5515,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 447:  // $DC72
       /*$DC72*/ CYCLES(0xdc72, 6);
-                FUNC_CHRGOT(0xdc74);
+                FUNC_CHRGOT(0xdc74); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 448;
       break;
     case 448:  // $DC75
@@ -5510,7 +5544,7 @@ void func_t001(uint16_t ret_addr) {
                 s_y = tmp6_U8;
       /*$DC8A*/ ram_poke(0x00b8, ram_peek(0x0087));
       /*$DC8C*/ ram_poke(0x00b9, tmp6_U8);
-      /*$DC8E*/ FUNC_CHRGOT(0xdc90);
+      /*$DC8E*/ FUNC_CHRGOT(0xdc90); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 452;
       break;
     case 452:  // $DC91
@@ -5631,7 +5665,7 @@ void func_t001(uint16_t ret_addr) {
       /*$DD02*/ CYCLES(0xdd02, 12);
                 ram_poke(0x0085, s_a);
       /*$DD04*/ ram_poke(0x0086, s_y);
-      /*$DD06*/ FUNC_GETFORPTR(0xdd08);
+      /*$DD06*/ FUNC_GETFORPTR(0xdd08); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 473;
       break;
     case 473:  // $DD09
@@ -5655,7 +5689,7 @@ void func_t001(uint16_t ret_addr) {
       /*$DD14*/ s_a = (uint8_t)(tmp6_U8 + 0x04);
       /*$DD1B*/ ram_poke(0x0060, (uint8_t)(tmp6_U8 + 0x0a));
       /*$DD1D*/ s_y = 0x01;
-      /*$DD1F*/ FUNC_UPAY2FAC(0xdd21);
+      /*$DD1F*/ FUNC_UPAY2FAC(0xdd21); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 477;
       break;
     case 477:  // $DD22
@@ -5672,7 +5706,7 @@ void func_t001(uint16_t ret_addr) {
     case 479:  // $DD32
       /*$DD32*/ CYCLES(0xdd32, 9);
                 s_y = 0x01;
-      /*$DD34*/ FUNC_FCOMP2(0xdd36);
+      /*$DD34*/ FUNC_FCOMP2(0xdd36); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 480;
       break;
     case 480:  // $DD37
@@ -5707,7 +5741,7 @@ void func_t001(uint16_t ret_addr) {
                 tmp6_U8 = (uint8_t)tmp5_U16;
       /*$DD58*/ s_x = tmp6_U8;
       /*$DD59*/ s_sp = tmp6_U8;
-      /*$DD5A*/ FUNC_CHRGOT(0xdd5c);
+      /*$DD5A*/ FUNC_CHRGOT(0xdd5c); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 484;
       break;
     case 484:  // $DD5D
@@ -5716,7 +5750,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 485:  // $DD61
       /*$DD61*/ CYCLES(0xdd61, 6);
-                FUNC_CHRGET(0xdd63);
+                FUNC_CHRGET(0xdd63); if (s_native_depth <= depth) return;
       /*$DD64*/ CYCLES(0xdd64, 6);
                 branchTarget = true; push16(0xdd66); block_id = 471;
       break;
@@ -5793,7 +5827,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 500:  // $DD95
       /*$DD95*/ CYCLES(0xdd95, 6);
-                FUNC_CHRGOT(0xdd97);
+                FUNC_CHRGOT(0xdd97); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 501;
       break;
     case 501:  // $DD98
@@ -5824,7 +5858,7 @@ void func_t001(uint16_t ret_addr) {
     case 504:  // $DDAC
       /*$DDAC*/ CYCLES(0xddac, 9);
                 ram_poke(0x0089, s_a);
-      /*$DDAE*/ FUNC_CHRGET(0xddb0);
+      /*$DDAE*/ FUNC_CHRGET(0xddb0); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 505;
       break;
     case 505:  // $DDB1
@@ -6068,7 +6102,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 539:  // $DE64
       /*$DE64*/ CYCLES(0xde64, 6);
-                FUNC_CHRGET(0xde66);
+                FUNC_CHRGET(0xde66); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 540;
       break;
     case 540:  // $DE67
@@ -6081,7 +6115,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 542:  // $DE6C
       /*$DE6C*/ CYCLES(0xde6c, 6);
-                FUNC_ISLETC(0xde6e);
+                FUNC_ISLETC(0xde6e); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 543;
       break;
     case 543:  // $DE6F
@@ -6132,7 +6166,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 551:  // $DE8D
       /*$DE8D*/ CYCLES(0xde8d, 6);
-                FUNC_POINT(0x0000);
+                FUNC_POINT(0x0000); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = find_block_id_func_t001(0xde8d, pop16() + 1);;
       break;
     case 552:  // $DE90
@@ -6215,7 +6249,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 567:  // $DEC6
       /*$DEC6*/ CYCLES(0xdec6, 6);
-                FUNC_CHRGET(0x0000);
+                FUNC_CHRGET(0x0000); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = find_block_id_func_t001(0xdec6, pop16() + 1);;
       break;
     case 568:  // $DEC9
@@ -6268,12 +6302,12 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 576:  // $DEF6
       /*$DEF6*/ CYCLES(0xdef6, 6);
-                FUNC_UPAY2FAC(0x0000);
+                FUNC_UPAY2FAC(0x0000); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = find_block_id_func_t001(0xdef6, pop16() + 1);;
       break;
     case 577:  // $DEF9
       /*$DEF9*/ CYCLES(0xdef9, 6);
-                FUNC_CHRGET(0xdefb);
+                FUNC_CHRGET(0xdefb); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 578;
       break;
     case 578:  // $DEFC
@@ -6300,7 +6334,7 @@ void func_t001(uint16_t ret_addr) {
                 tmp1_U8 = (uint8_t)(s_a << 0x01);
       /*$DF11*/ push8(tmp1_U8);
       /*$DF12*/ s_x = tmp1_U8;
-      /*$DF13*/ FUNC_CHRGET(0xdf15);
+      /*$DF13*/ FUNC_CHRGET(0xdf15); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 583;
       break;
     case 583:  // $DF16
@@ -6381,7 +6415,7 @@ void func_t001(uint16_t ret_addr) {
       /*$DF70*/ ram_poke(0x00a6, ((ram_peek(0x00aa) | 0x7f) & ram_peek(0x00a6)));
       /*$DF72*/ s_a = 0xa5;
       /*$DF74*/ s_y = 0x00;
-      /*$DF76*/ FUNC_FCOMP(0xdf78);
+      /*$DF76*/ FUNC_FCOMP(0xdf78); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 597;
       break;
     case 597:  // $DF79
@@ -6501,7 +6535,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 615:  // $DFD0
       /*$DFD0*/ CYCLES(0xdfd0, 6);
-                FUNC_PREAD(0xdfd2);
+                FUNC_PREAD(0xdfd2); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 616;
       break;
     case 616:  // $DFD3
@@ -6511,7 +6545,7 @@ void func_t001(uint16_t ret_addr) {
     case 617:  // $DFE3
       /*$DFE3*/ CYCLES(0xdfe3, 9);
                 s_x = 0x00;
-      /*$DFE5*/ FUNC_CHRGOT(0xdfe7);
+      /*$DFE5*/ FUNC_CHRGOT(0xdfe7); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 618;
       break;
     case 618:  // $DFE8
@@ -6522,12 +6556,12 @@ void func_t001(uint16_t ret_addr) {
     case 619:  // $DFEA
       /*$DFEA*/ CYCLES(0xdfea, 9);
                 ram_poke(0x0081, s_a);
-      /*$DFEC*/ FUNC_CHRGOT(0xdfee);
+      /*$DFEC*/ FUNC_CHRGOT(0xdfee); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 620;
       break;
     case 620:  // $DFEF
       /*$DFEF*/ CYCLES(0xdfef, 6);
-                FUNC_ISLETC(0xdff1);
+                FUNC_ISLETC(0xdff1); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 621;
       break;
     case 621:  // $DFF2
@@ -6544,7 +6578,7 @@ void func_t001(uint16_t ret_addr) {
       /*$DFF9*/ ram_poke(0x0011, 0x00);
       /*$DFFB*/ ram_poke(0x0012, 0x00);
       /*$E007*/ CYCLES(0xe007, 6);
-                FUNC_CHRGET(0xe009);
+                FUNC_CHRGET(0xe009); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 625;
       break;
     case 624:  // $E003
@@ -6557,7 +6591,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 626:  // $E00C
       /*$E00C*/ CYCLES(0xe00c, 6);
-                FUNC_ISLETC(0xe00e);
+                FUNC_ISLETC(0xe00e); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 627;
       break;
     case 627:  // $E00F
@@ -6571,13 +6605,13 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 629:  // $E012
       /*$E012*/ CYCLES(0xe012, 6);
-                FUNC_CHRGET(0xe014);
+                FUNC_CHRGET(0xe014); if (s_native_depth <= depth) return;
       /*$E015*/ CYCLES(0xe015, 4);
                 branchTarget = true; block_id = !s_status_c ? 629 : 630;
       break;
     case 630:  // $E017
       /*$E017*/ CYCLES(0xe017, 6);
-                FUNC_ISLETC(0xe019);
+                FUNC_ISLETC(0xe019); if (s_native_depth <= depth) return;
       /*$E01A*/ CYCLES(0xe01a, 4);
                 branchTarget = true; block_id = s_status_c ? 629 : 631;
       break;
@@ -6609,7 +6643,7 @@ void func_t001(uint16_t ret_addr) {
     case 636:  // $E036
       /*$E036*/ CYCLES(0xe036, 12);
       /*$E039*/ s_x = (s_x | 0x80);
-      /*$E03A*/ FUNC_CHRGET(0xe03c);
+      /*$E03A*/ FUNC_CHRGET(0xe03c); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 637;
       break;
     case 637:  // $E03D
@@ -6837,7 +6871,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 666:  // $E102
       /*$E102*/ CYCLES(0xe102, 6);
-                FUNC_CHRGET(0xe104);
+                FUNC_CHRGET(0xe104); if (s_native_depth <= depth) return;
       /*$E105*/ CYCLES(0xe105, 6);
                 branchTarget = true; push16(0xe107); block_id = 486;
       break;
@@ -6857,7 +6891,7 @@ void func_t001(uint16_t ret_addr) {
       /*$E112*/ CYCLES(0xe112, 12);
                 s_a = 0xfe;
       /*$E114*/ s_y = 0xe0;
-      /*$E116*/ FUNC_FCOMP(0xe118);
+      /*$E116*/ FUNC_FCOMP(0xe118); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 670;
       break;
     case 670:  // $E119
@@ -6866,7 +6900,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 671:  // $E11B
       /*$E11B*/ CYCLES(0xe11b, 6);
-                FUNC_QINT(0x0000);
+                FUNC_QINT(0x0000); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = find_block_id_func_t001(0xe11b, pop16() + 1);;
       break;
     case 672:  // $E122
@@ -6897,7 +6931,7 @@ void func_t001(uint16_t ret_addr) {
       /*$E14A*/ ram_poke((0x0102 + tmp6_U8), ram_peek(0x00a0));
       /*$E14F*/ ram_poke((0x0101 + tmp6_U8), ram_peek(0x00a1));
       /*$E152*/ s_y = (uint8_t)(tmp1_U8 + 0x01);
-      /*$E153*/ FUNC_CHRGOT(0xe155);
+      /*$E153*/ FUNC_CHRGOT(0xe155); if (s_native_depth <= depth) return;
       /*$E156*/ CYCLES(0xe156, 7);
       /*$E158*/ branchTarget = true; block_id = !(s_a != 0x2c) ? 673 : 675;
       break;
@@ -7000,7 +7034,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 689:  // $E1AA
       /*$E1AA*/ CYCLES(0xe1aa, 6);
-                FUNC_GETARY(0xe1ac);
+                FUNC_GETARY(0xe1ac); if (s_native_depth <= depth) return;
       /*$E1AD*/ CYCLES(0xe1ad, 14);
                 tmp1_U8 = ram_peek(0x000f);
       /*$E1AF*/ s_y = 0x04;
@@ -7023,7 +7057,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 693:  // $E1C1
       /*$E1C1*/ CYCLES(0xe1c1, 6);
-                FUNC_GETARY(0xe1c3);
+                FUNC_GETARY(0xe1c3); if (s_native_depth <= depth) return;
       /*$E1C4*/ CYCLES(0xe1c4, 6);
                 branchTarget = true; push16(0xe1c6); block_id = 32;
       break;
@@ -7390,7 +7424,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 739:  // $E2E5
       /*$E2E5*/ CYCLES(0xe2e5, 6);
-                FUNC_GARBAGE(0xe2e7);
+                FUNC_GARBAGE(0xe2e7); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 740;
       break;
     case 740:  // $E2E8
@@ -7521,7 +7555,7 @@ void func_t001(uint16_t ret_addr) {
       /*$E39C*/ ram_poke(0x008a, tmp1_U8);
       /*$E39E*/ tmp1_U8 = pop8();
       /*$E39F*/ ram_poke(0x008b, tmp1_U8);
-      /*$E3A1*/ FUNC_CHRGOT(0xe3a3);
+      /*$E3A1*/ FUNC_CHRGOT(0xe3a3); if (s_native_depth <= depth) return;
       /*$E3A4*/ CYCLES(0xe3a4, 4);
                 branchTarget = true; block_id = !s_status_not_z ? 758 : 757;
       break;
@@ -7758,7 +7792,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 786:  // $E47A
       /*$E47A*/ CYCLES(0xe47a, 6);
-                FUNC_GARBAGE(0xe47c);
+                FUNC_GARBAGE(0xe47c); if (s_native_depth <= depth) return;
       /*$E47D*/ CYCLES(0xe47d, 12);
       /*$E47F*/ ram_poke(0x0013, 0x80);
       /*$E481*/ tmp6_U8 = pop8();
@@ -7790,7 +7824,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 790:  // $E4A4
       /*$E4A4*/ CYCLES(0xe4a4, 6);
-                FUNC_CHKVAR(0xe4a6);
+                FUNC_CHKVAR(0xe4a6); if (s_native_depth <= depth) return;
       /*$E4A7*/ CYCLES(0xe4a7, 4);
                 branchTarget = true; block_id = !s_status_not_z ? 789 : 791;
       break;
@@ -7815,7 +7849,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 794:  // $E4BD
       /*$E4BD*/ CYCLES(0xe4bd, 6);
-                FUNC_CHKSMPLVAR(0xe4bf);
+                FUNC_CHKSMPLVAR(0xe4bf); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 795;
       break;
     case 795:  // $E4C0
@@ -7915,7 +7949,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 808:  // $E514
       /*$E514*/ CYCLES(0xe514, 6);
-                FUNC_CHKVAR(0xe516);
+                FUNC_CHKVAR(0xe516); if (s_native_depth <= depth) return;
       /*$E517*/ CYCLES(0xe517, 4);
                 branchTarget = true; block_id = !s_status_not_z ? 806 : 1662;
       break;
@@ -7934,7 +7968,7 @@ void func_t001(uint16_t ret_addr) {
     case 811:  // $E522
       /*$E522*/ CYCLES(0xe522, 2);
                 s_y = (uint8_t)(s_y + 0x01);
-                FUNC_CHKVAR(0x0000);
+                FUNC_CHKVAR(0x0000); if (s_native_depth <= depth) return;
                 block_id = find_block_id_func_t001(0xe522, pop16() + 1);;
       break;
     case 812:  // $E523
@@ -8024,7 +8058,7 @@ void func_t001(uint16_t ret_addr) {
       /*$E578*/ ram_poke(0x0097, ((uint8_t)tmp4_U16));
       /*$E57E*/ ram_poke(0x0094, ram_peek(0x006f));
       /*$E580*/ ram_poke(0x0095, ram_peek(0x0070));
-      /*$E582*/ FUNC_MVBLKUP2(0xe584);
+      /*$E582*/ FUNC_MVBLKUP2(0xe584); if (s_native_depth <= depth) return;
       /*$E585*/ CYCLES(0xe585, 31);
                 tmp1_U8 = ram_peek(0x0091);
       /*$E588*/ tmp6_U8 = ram_peek(0x0094);
@@ -8175,7 +8209,7 @@ void func_t001(uint16_t ret_addr) {
       /*$E604*/ CYCLES(0xe604, 12);
                 ram_poke(0x005e, s_a);
       /*$E606*/ ram_poke(0x005f, s_y);
-      /*$E608*/ FUNC_FRETMS(0xe60a);
+      /*$E608*/ FUNC_FRETMS(0xe60a); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 845;
       break;
     case 845:  // $E60B
@@ -8298,7 +8332,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 857:  // $E6F5
       /*$E6F5*/ CYCLES(0xe6f5, 6);
-                FUNC_CHRGET(0xe6f7);
+                FUNC_CHRGET(0xe6f7); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 858;
       break;
     case 858:  // $E6F8
@@ -8316,7 +8350,7 @@ void func_t001(uint16_t ret_addr) {
     case 861:  // $E702
       /*$E702*/ CYCLES(0xe702, 9);
                 s_x = ram_peek(0x00a1);
-      /*$E704*/ FUNC_CHRGOT(0x0000);
+      /*$E704*/ FUNC_CHRGOT(0x0000); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = find_block_id_func_t001(0xe704, pop16() + 1);;
       break;
     case 862:  // $E73D
@@ -8355,7 +8389,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 868:  // $E758
       /*$E758*/ CYCLES(0xe758, 6);
-                FUNC_QINT(0xe75a);
+                FUNC_QINT(0xe75a); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 869;
       break;
     case 869:  // $E75B
@@ -8412,7 +8446,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 876:  // $E7B9
       /*$E7B9*/ CYCLES(0xe7b9, 6);
-                FUNC_SHFTRGHT(0xe7bb);
+                FUNC_SHFTRGHT(0xe7bb); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 877;
       break;
     case 877:  // $E7BC
@@ -8421,7 +8455,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 878:  // $E7BE
       /*$E7BE*/ CYCLES(0xe7be, 6);
-                FUNC_UPAY2ARG(0xe7c0);
+                FUNC_UPAY2ARG(0xe7c0); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 879;
       break;
     case 879:  // $E7C1
@@ -8498,7 +8532,7 @@ void func_t001(uint16_t ret_addr) {
                 tmp2_U8 = ram_peek(tmp5_U16);
                 s_status_c = (tmp2_U8 & 0x01);
                 ram_poke(tmp5_U16, (tmp2_U8 >> 0x01));
-      /*$E7F7*/ FUNC_SHFTRGHT4(0xe7f9);
+      /*$E7F7*/ FUNC_SHFTRGHT4(0xe7f9); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 889;
       break;
     case 889:  // $E7FA
@@ -8538,7 +8572,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 894:  // $E82B
       /*$E82B*/ CYCLES(0xe82b, 6);
-                FUNC_TWSCMPFAC(0xe82d);
+                FUNC_TWSCMPFAC(0xe82d); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 895;
       break;
     case 895:  // $E82E
@@ -8688,7 +8722,7 @@ void func_t001(uint16_t ret_addr) {
     case 909:  // $E89E
       /*$E89E*/ CYCLES(0xe89e, 11);
       /*$E8A2*/ ram_poke(0x00a2, (ram_peek(0x00a2) ^ 0xff));
-                FUNC_TCFACMANT(0x0000);
+                FUNC_TCFACMANT(0x0000); if (s_native_depth <= depth) return;
                 block_id = find_block_id_func_t001(0xe8a2, pop16() + 1);;
       break;
     case 910:  // $E8A4
@@ -8827,7 +8861,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 924:  // $E97F
       /*$E97F*/ CYCLES(0xe97f, 6);
-                FUNC_UPAY2ARG(0xe981);
+                FUNC_UPAY2ARG(0xe981); if (s_native_depth <= depth) return;
       /*$E982*/ CYCLES(0xe982, 4);
                 branchTarget = true; block_id = s_status_not_z ? 926 : 925;
       break;
@@ -8848,25 +8882,25 @@ void func_t001(uint16_t ret_addr) {
       /*$E994*/ tmp2_U8 = ram_peek(0x00ac);
                 s_status_not_z = tmp2_U8;
                 s_a = tmp2_U8;
-      /*$E996*/ FUNC_MULT1(0xe998);
+      /*$E996*/ FUNC_MULT1(0xe998); if (s_native_depth <= depth) return;
       /*$E999*/ CYCLES(0xe999, 9);
                 tmp2_U8 = ram_peek(0x00a1);
                 s_status_not_z = tmp2_U8;
                 s_a = tmp2_U8;
-      /*$E99B*/ FUNC_MULT1(0xe99d);
+      /*$E99B*/ FUNC_MULT1(0xe99d); if (s_native_depth <= depth) return;
       /*$E99E*/ CYCLES(0xe99e, 9);
                 tmp2_U8 = ram_peek(0x00a0);
                 s_status_not_z = tmp2_U8;
                 s_a = tmp2_U8;
-      /*$E9A0*/ FUNC_MULT1(0xe9a2);
+      /*$E9A0*/ FUNC_MULT1(0xe9a2); if (s_native_depth <= depth) return;
       /*$E9A3*/ CYCLES(0xe9a3, 9);
                 tmp2_U8 = ram_peek(0x009f);
                 s_status_not_z = tmp2_U8;
                 s_a = tmp2_U8;
-      /*$E9A5*/ FUNC_MULT1(0xe9a7);
+      /*$E9A5*/ FUNC_MULT1(0xe9a7); if (s_native_depth <= depth) return;
       /*$E9A8*/ CYCLES(0xe9a8, 9);
                 s_a = ram_peek(0x009e);
-      /*$E9AA*/ FUNC_MULT2(0xe9ac);
+      /*$E9AA*/ FUNC_MULT2(0xe9ac); if (s_native_depth <= depth) return;
       /*$E9AD*/ CYCLES(0xe9ad, 6);
                 branchTarget = true; block_id = 975;
       break;
@@ -9072,7 +9106,7 @@ void func_t001(uint16_t ret_addr) {
       /*$EA5A*/ s_y = 0xea;
       /*$EA5C*/ s_x = 0x00;
       /*$EA5E*/ ram_poke(0x00ab, 0x00);
-      /*$EA60*/ FUNC_UPAY2FAC(0xea62);
+      /*$EA60*/ FUNC_UPAY2FAC(0xea62); if (s_native_depth <= depth) return;
       /*$EA63*/ CYCLES(0xea63, 6);
                 branchTarget = true; block_id = 954;
       break;
@@ -9365,7 +9399,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 989:  // $EB7A
       /*$EB7A*/ CYCLES(0xeb7a, 6);
-                FUNC_INCFACMAN(0xeb7c);
+                FUNC_INCFACMAN(0xeb7c); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 990;
       break;
     case 990:  // $EB7D
@@ -9433,7 +9467,7 @@ void func_t001(uint16_t ret_addr) {
     case 1000:  // $EBB2
       /*$EBB2*/ CYCLES(0xebb2, 4);
                 ram_poke(0x0060, s_a);
-                FUNC_FCOMP2(0x0000);
+                FUNC_FCOMP2(0x0000); if (s_native_depth <= depth) return;
                 block_id = find_block_id_func_t001(0xebb2, pop16() + 1);;
       break;
     case 1001:  // $EBB4
@@ -9529,7 +9563,7 @@ void func_t001(uint16_t ret_addr) {
       /*$EBFD*/ CYCLES(0xebfd, 14);
                 s_x = s_a;
       /*$EC00*/ ram_poke(0x00a4, 0xff);
-      /*$EC02*/ FUNC_TCFACMANT(0xec04);
+      /*$EC02*/ FUNC_TCFACMANT(0xec04); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1014;
       break;
     case 1014:  // $EC05
@@ -9546,7 +9580,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 1016:  // $EC0C
       /*$EC0C*/ CYCLES(0xec0c, 6);
-                FUNC_SHFTRGHT(0xec0e);
+                FUNC_SHFTRGHT(0xec0e); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1017;
       break;
     case 1017:  // $EC0F
@@ -9567,7 +9601,7 @@ void func_t001(uint16_t ret_addr) {
       /*$EC19*/ tmp2_U8 = (ram_peek(0x00a2) & 0x80) | ram_peek(0x009e);
                 s_a = tmp2_U8;
       /*$EC1B*/ ram_poke(0x009e, tmp2_U8);
-      /*$EC1D*/ FUNC_SHFTRGHT4(0xec1f);
+      /*$EC1D*/ FUNC_SHFTRGHT4(0xec1f); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1020;
       break;
     case 1020:  // $EC20
@@ -9622,7 +9656,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 1028:  // $EC61
       /*$EC61*/ CYCLES(0xec61, 6);
-                FUNC_CHRGET(0xec63);
+                FUNC_CHRGET(0xec63); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1029;
       break;
     case 1029:  // $EC64
@@ -9641,7 +9675,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 1032:  // $EC6E
       /*$EC6E*/ CYCLES(0xec6e, 6);
-                FUNC_CHRGET(0xec70);
+                FUNC_CHRGET(0xec70); if (s_native_depth <= depth) return;
       /*$EC71*/ CYCLES(0xec71, 4);
                 branchTarget = true; block_id = !s_status_c ? 1040 : 1033;
       break;
@@ -9680,7 +9714,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 1039:  // $EC87
       /*$EC87*/ CYCLES(0xec87, 6);
-                FUNC_CHRGET(0xec89);
+                FUNC_CHRGET(0xec89); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1040;
       break;
     case 1040:  // $EC8A
@@ -9932,7 +9966,7 @@ void func_t001(uint16_t ret_addr) {
       /*$ED62*/ CYCLES(0xed62, 12);
                 s_a = 0x0f;
       /*$ED64*/ s_y = 0xed;
-      /*$ED66*/ FUNC_FCOMP(0xed68);
+      /*$ED66*/ FUNC_FCOMP(0xed68); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1083;
       break;
     case 1083:  // $ED69
@@ -9947,7 +9981,7 @@ void func_t001(uint16_t ret_addr) {
       /*$ED6D*/ CYCLES(0xed6d, 12);
                 s_a = 0x0a;
       /*$ED6F*/ s_y = 0xed;
-      /*$ED71*/ FUNC_FCOMP(0xed73);
+      /*$ED71*/ FUNC_FCOMP(0xed73); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1086;
       break;
     case 1086:  // $ED74
@@ -9984,7 +10018,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 1093:  // $ED89
       /*$ED89*/ CYCLES(0xed89, 6);
-                FUNC_QINT(0xed8b);
+                FUNC_QINT(0xed8b); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1094;
       break;
     case 1094:  // $ED8C
@@ -10665,7 +10699,7 @@ void func_t001(uint16_t ret_addr) {
       /*$F305*/ ram_poke(0x00b9, ram_peek(0x00f5));
       /*$F309*/ ram_poke(0x0075, ram_peek(0x00f6));
       /*$F30D*/ ram_poke(0x0076, ram_peek(0x00f7));
-      /*$F30F*/ FUNC_CHRGOT(0xf311);
+      /*$F30F*/ FUNC_CHRGOT(0xf311); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1193;
       break;
     case 1193:  // $F312
@@ -10731,7 +10765,7 @@ void func_t001(uint16_t ret_addr) {
                 tmp2_U8 = ram_peek(0x001c);
                 s_a = tmp2_U8;
       /*$F400*/ poke((ram_peek16al(0x001a) + s_y), tmp2_U8);
-      /*$F402*/ FUNC_COLORSHIFT(0xf404);
+      /*$F402*/ FUNC_COLORSHIFT(0xf404); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1202;
       break;
     case 1202:  // $F405
@@ -10821,7 +10855,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 1211:  // $F457
       /*$F457*/ CYCLES(0xf457, 6);
-                FUNC_HPOSN(0xf459);
+                FUNC_HPOSN(0xf459); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1212;
       break;
     case 1212:  // $F45A
@@ -10882,7 +10916,7 @@ void func_t001(uint16_t ret_addr) {
                 ram_poke(0x0030, s_a);
       /*$F47A*/ ram_poke(0x00e5, s_y);
       /*$F47C*/ s_a = ram_peek(0x001c);
-                FUNC_COLORSHIFT(0x0000);
+                FUNC_COLORSHIFT(0x0000); if (s_native_depth <= depth) return;
                 block_id = find_block_id_func_t001(0xf47c, pop16() + 1);;
       break;
     case 1221:  // $F47E
@@ -11564,12 +11598,12 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 1315:  // $F705
       /*$F705*/ CYCLES(0xf705, 6);
-                FUNC_HPLOT0(0xf707);
+                FUNC_HPLOT0(0xf707); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1316;
       break;
     case 1316:  // $F708
       /*$F708*/ CYCLES(0xf708, 6);
-                FUNC_CHRGOT(0xf70a);
+                FUNC_CHRGOT(0xf70a); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1317;
       break;
     case 1317:  // $F70B
@@ -11667,7 +11701,7 @@ void func_t001(uint16_t ret_addr) {
                 s_status_v = ovf8((uint8_t)tmp5_U16, (uint8_t)tmp4_U16, (uint8_t)tmp3_U16);
       /*$F752*/ ram_poke(0x001b, ((uint8_t)tmp5_U16));
       /*$F754*/ ram_poke(0x001a, tmp1_U8);
-      /*$F756*/ FUNC_CHRGOT(0xf758);
+      /*$F756*/ FUNC_CHRGOT(0xf758); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1332;
       break;
     case 1332:  // $F759
@@ -11686,7 +11720,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 1335:  // $F763
       /*$F763*/ CYCLES(0xf763, 6);
-                FUNC_HPOSN(0xf765);
+                FUNC_HPOSN(0xf765); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1336;
       break;
     case 1336:  // $F766
@@ -11779,7 +11813,7 @@ void func_t001(uint16_t ret_addr) {
                 tmp1_U8 = tmp2_U8 >> 0x01;
                 s_a = tmp1_U8;
       /*$F801*/ push8(((tmp2_U8 & 0x01) | ((tmp1_U8 == 0) << 1) | (s_status_i << 2) | (s_status_d << 3) | STATUS_B | (s_status_v << 6) | (tmp1_U8 & 0x80)));
-      /*$F802*/ FUNC_GBASCALC(0xf804);
+      /*$F802*/ FUNC_GBASCALC(0xf804); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1348;
       break;
     case 1348:  // $F805
@@ -11806,7 +11840,7 @@ void func_t001(uint16_t ret_addr) {
     case 1350:  // $F80C
       /*$F80C*/ CYCLES(0xf80c, 4);
                 ram_poke(0x002e, s_a);
-                FUNC_PLOT1(0x0000);
+                FUNC_PLOT1(0x0000); if (s_native_depth <= depth) return;
                 block_id = find_block_id_func_t001(0xf80c, pop16() + 1);;
       break;
     case 1351:  // $F80E
@@ -11834,7 +11868,7 @@ void func_t001(uint16_t ret_addr) {
     case 1353:  // $F820
       /*$F820*/ CYCLES(0xf820, 7);
                 s_y = (uint8_t)(s_y + 0x01);
-      /*$F821*/ FUNC_PLOT1(0xf823);
+      /*$F821*/ FUNC_PLOT1(0xf823); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1354;
       break;
     case 1354:  // $F824
@@ -11932,7 +11966,7 @@ void func_t001(uint16_t ret_addr) {
                 tmp6_U8 = tmp1_U8 >> 0x01;
                 s_a = tmp6_U8;
       /*$F872*/ push8(((tmp1_U8 & 0x01) | ((tmp6_U8 == 0) << 1) | (s_status_i << 2) | (s_status_d << 3) | STATUS_B | (s_status_v << 6) | (tmp6_U8 & 0x80)));
-      /*$F873*/ FUNC_GBASCALC(0xf875);
+      /*$F873*/ FUNC_GBASCALC(0xf875); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1367;
       break;
     case 1367:  // $F876
@@ -11945,7 +11979,7 @@ void func_t001(uint16_t ret_addr) {
                 s_status_d = ((tmp1_U8 & 0x08) != 0);
                 s_status_b = 0x00;
                 s_status_v = ((tmp1_U8 & 0x40) != 0);
-                FUNC_SCRN2(0x0000);
+                FUNC_SCRN2(0x0000); if (s_native_depth <= depth) return;
                 block_id = find_block_id_func_t001(0xf878, pop16() + 1);;
       break;
     case 1368:  // $F879
@@ -12007,7 +12041,7 @@ void func_t001(uint16_t ret_addr) {
                 tmp6_U8 = s_a;
                 s_status_c = (tmp6_U8 & 0x01);
       /*$F89D*/ s_a = ram_peek((0xf962 + (tmp6_U8 >> 0x01)));
-      /*$F8A0*/ FUNC_SCRN2(0xf8a2);
+      /*$F8A0*/ FUNC_SCRN2(0xf8a2); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1378;
       break;
     case 1378:  // $F8A3
@@ -12229,7 +12263,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 1411:  // $F938
       /*$F938*/ CYCLES(0xf938, 6);
-                FUNC_PCADJ3(0xf93a);
+                FUNC_PCADJ3(0xf93a); if (s_native_depth <= depth) return;
       /*$F93B*/ CYCLES(0xf93b, 7);
       /*$F93C*/ tmp1_U8 = (uint8_t)(s_a + 0x01);
                 s_x = tmp1_U8;
@@ -12278,7 +12312,7 @@ void func_t001(uint16_t ret_addr) {
       /*$F953*/ CYCLES(0xf953, 6);
                 s_status_c = 0x01;
       /*$F954*/ s_a = ram_peek(0x002f);
-                FUNC_PCADJ3(0x0000);
+                FUNC_PCADJ3(0x0000); if (s_native_depth <= depth) return;
                 block_id = find_block_id_func_t001(0xf954, pop16() + 1);;
       break;
     case 1420:  // $F956
@@ -12321,17 +12355,17 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 1425:  // $FA66
       /*$FA66*/ CYCLES(0xfa66, 6);
-                FUNC_INIT(0xfa68);
+                FUNC_INIT(0xfa68); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1426;
       break;
     case 1426:  // $FA69
       /*$FA69*/ CYCLES(0xfa69, 6);
-                FUNC_SETVID(0xfa6b);
+                FUNC_SETVID(0xfa6b); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1427;
       break;
     case 1427:  // $FA6C
       /*$FA6C*/ CYCLES(0xfa6c, 6);
-                FUNC_SETKBD(0xfa6e);
+                FUNC_SETKBD(0xfa6e); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1428;
       break;
     case 1428:  // $FA6F
@@ -12620,7 +12654,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 1472:  // $FBB3
       /*$FBB3*/ CYCLES(0xfbb3, 24);
-      /*$FBC0*/ FUNC_BASCALC(0x0000);
+      /*$FBC0*/ FUNC_BASCALC(0x0000); if (s_native_depth <= depth) return;
                 block_id = find_block_id_func_t001(0xfbc0, pop16() + 1);;
       break;
     case 1473:  // $FBC1
@@ -12770,12 +12804,12 @@ void func_t001(uint16_t ret_addr) {
     case 1493:  // $FC22
       /*$FC22*/ CYCLES(0xfc22, 4);
                 s_a = ram_peek(0x0025);
-                FUNC_VTABZ(0x0000);
+                FUNC_VTABZ(0x0000); if (s_native_depth <= depth) return;
                 block_id = find_block_id_func_t001(0xfc22, pop16() + 1);;
       break;
     case 1494:  // $FC24
       /*$FC24*/ CYCLES(0xfc24, 6);
-                FUNC_BASCALC(0xfc26);
+                FUNC_BASCALC(0xfc26); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1495;
       break;
     case 1495:  // $FC27
@@ -12854,12 +12888,12 @@ void func_t001(uint16_t ret_addr) {
     case 1504:  // $FC46
       /*$FC46*/ CYCLES(0xfc46, 7);
                 push8(s_a);
-      /*$FC47*/ FUNC_VTABZ(0xfc49);
+      /*$FC47*/ FUNC_VTABZ(0xfc49); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1505;
       break;
     case 1505:  // $FC4A
       /*$FC4A*/ CYCLES(0xfc4a, 6);
-                FUNC_CLREOLZ(0xfc4c);
+                FUNC_CLREOLZ(0xfc4c); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1506;
       break;
     case 1506:  // $FC4D
@@ -12903,7 +12937,7 @@ void func_t001(uint16_t ret_addr) {
       /*$FC70*/ tmp2_U8 = ram_peek(0x0022);
                 s_a = tmp2_U8;
       /*$FC72*/ push8(tmp2_U8);
-      /*$FC73*/ FUNC_VTABZ(0xfc75);
+      /*$FC73*/ FUNC_VTABZ(0xfc75); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1512;
       break;
     case 1512:  // $FC76
@@ -12922,7 +12956,7 @@ void func_t001(uint16_t ret_addr) {
     case 1513:  // $FC88
       /*$FC88*/ CYCLES(0xfc88, 7);
                 push8(s_a);
-      /*$FC89*/ FUNC_VTABZ(0xfc8b);
+      /*$FC89*/ FUNC_VTABZ(0xfc8b); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1514;
       break;
     case 1514:  // $FC8C
@@ -12943,7 +12977,7 @@ void func_t001(uint16_t ret_addr) {
     case 1516:  // $FC95
       /*$FC95*/ CYCLES(0xfc95, 9);
                 s_y = 0x00;
-      /*$FC97*/ FUNC_CLREOLZ(0xfc99);
+      /*$FC97*/ FUNC_CLREOLZ(0xfc99); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1517;
       break;
     case 1517:  // $FC9A
@@ -12953,7 +12987,7 @@ void func_t001(uint16_t ret_addr) {
     case 1518:  // $FC9C
       /*$FC9C*/ CYCLES(0xfc9c, 4);
                 s_y = ram_peek(0x0024);
-                FUNC_CLREOLZ(0x0000);
+                FUNC_CLREOLZ(0x0000); if (s_native_depth <= depth) return;
                 block_id = find_block_id_func_t001(0xfc9c, pop16() + 1);;
       break;
     case 1519:  // $FC9E
@@ -13042,7 +13076,7 @@ void func_t001(uint16_t ret_addr) {
     case 1530:  // $FCC9
       /*$FCC9*/ CYCLES(0xfcc9, 9);
                 s_y = 0x4b;
-      /*$FCCB*/ FUNC_ZERODLY(0xfccd);
+      /*$FCCB*/ FUNC_ZERODLY(0xfccd); if (s_native_depth <= depth) return;
       /*$FCCE*/ CYCLES(0xfcce, 4);
                 branchTarget = true; block_id = s_status_not_z ? 1530 : 1531;
       break;
@@ -13059,10 +13093,10 @@ void func_t001(uint16_t ret_addr) {
     case 1532:  // $FCD4
       /*$FCD4*/ CYCLES(0xfcd4, 9);
                 s_y = 0x21;
-      /*$FCD6*/ FUNC_ZERODLY(0xfcd8);
+      /*$FCD6*/ FUNC_ZERODLY(0xfcd8); if (s_native_depth <= depth) return;
       /*$FCD9*/ CYCLES(0xfcd9, 4);
       /*$FCDA*/ s_y = (uint8_t)(s_y + 0x02);
-                FUNC_ZERODLY(0x0000);
+                FUNC_ZERODLY(0x0000); if (s_native_depth <= depth) return;
                 block_id = find_block_id_func_t001(0xfcda, pop16() + 1);;
       break;
     case 1533:  // $FCDB
@@ -13104,7 +13138,7 @@ void func_t001(uint16_t ret_addr) {
     case 1539:  // $FCEE
       /*$FCEE*/ CYCLES(0xfcee, 7);
                 push8(s_a);
-      /*$FCEF*/ FUNC_RD2BIT(0xfcf1);
+      /*$FCEF*/ FUNC_RD2BIT(0xfcf1); if (s_native_depth <= depth) return;
       /*$FCF2*/ CYCLES(0xfcf2, 12);
                 tmp1_U8 = pop8();
       /*$FCF3*/ tmp3_U16 = (tmp1_U8 << 0x01) | s_status_c;
@@ -13123,8 +13157,8 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 1541:  // $FCFA
       /*$FCFA*/ CYCLES(0xfcfa, 6);
-                FUNC_RDBIT(0xfcfc);
-                FUNC_RDBIT(0x0000);
+                FUNC_RDBIT(0xfcfc); if (s_native_depth <= depth) return;
+                FUNC_RDBIT(0x0000); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = find_block_id_func_t001(0xfcfa, pop16() + 1);;
       break;
     case 1542:  // $FCFD
@@ -13319,7 +13353,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 1572:  // $FD8B
       /*$FD8B*/ CYCLES(0xfd8b, 6);
-                FUNC_CLREOL(0xfd8d);
+                FUNC_CLREOL(0xfd8d); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1573;
       break;
     case 1573:  // $FD8E
@@ -13380,7 +13414,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 1583:  // $FDC0
       /*$FDC0*/ CYCLES(0xfdc0, 6);
-                FUNC_NXTA1(0xfdc2);
+                FUNC_NXTA1(0xfdc2); if (s_native_depth <= depth) return;
       /*$FDC3*/ CYCLES(0xfdc3, 4);
                 branchTarget = true; block_id = !s_status_c ? 1579 : 1584;
       break;
@@ -13544,7 +13578,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 1606:  // $FE5E
       /*$FE5E*/ CYCLES(0xfe5e, 6);
-                FUNC_A1PC(0xfe60);
+                FUNC_A1PC(0xfe60); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1607;
       break;
     case 1607:  // $FE61
@@ -13559,7 +13593,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 1609:  // $FE67
       /*$FE67*/ CYCLES(0xfe67, 6);
-                FUNC_PCADJ(0xfe69);
+                FUNC_PCADJ(0xfe69); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1610;
       break;
     case 1610:  // $FE6A
@@ -13658,12 +13692,12 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 1622:  // $FEB6
       /*$FEB6*/ CYCLES(0xfeb6, 6);
-                FUNC_A1PC(0xfeb8);
+                FUNC_A1PC(0xfeb8); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1623;
       break;
     case 1623:  // $FEB9
       /*$FEB9*/ CYCLES(0xfeb9, 6);
-                FUNC_MON_RESTORE(0xfebb);
+                FUNC_MON_RESTORE(0xfebb); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1624;
       break;
     case 1624:  // $FEBC
@@ -13682,25 +13716,25 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 1627:  // $FEFD
       /*$FEFD*/ CYCLES(0xfefd, 6);
-                FUNC_RD2BIT(0xfeff);
+                FUNC_RD2BIT(0xfeff); if (s_native_depth <= depth) return;
       /*$FF00*/ CYCLES(0xff00, 9);
                 s_a = 0x16;
-      /*$FF02*/ FUNC_HEADER(0xff04);
+      /*$FF02*/ FUNC_HEADER(0xff04); if (s_native_depth <= depth) return;
       /*$FF05*/ CYCLES(0xff05, 9);
                 ram_poke(0x002e, s_a);
-      /*$FF07*/ FUNC_RD2BIT(0xff09);
+      /*$FF07*/ FUNC_RD2BIT(0xff09); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1628;
       break;
     case 1628:  // $FF0A
       /*$FF0A*/ CYCLES(0xff0a, 9);
                 s_y = 0x24;
-      /*$FF0C*/ FUNC_RDBIT(0xff0e);
+      /*$FF0C*/ FUNC_RDBIT(0xff0e); if (s_native_depth <= depth) return;
       /*$FF0F*/ CYCLES(0xff0f, 4);
                 branchTarget = true; block_id = s_status_c ? 1628 : 1629;
       break;
     case 1629:  // $FF11
       /*$FF11*/ CYCLES(0xff11, 6);
-                FUNC_RDBIT(0xff13);
+                FUNC_RDBIT(0xff13); if (s_native_depth <= depth) return;
       /*$FF14*/ CYCLES(0xff14, 4);
                 s_y = 0x3b;
                 block_id = 1630;
@@ -13715,7 +13749,7 @@ void func_t001(uint16_t ret_addr) {
                 tmp1_U8 = s_a;
                 poke((ram_peek((uint8_t)(0x3c + tmp6_U8)) + (ram_peek((uint8_t)(0x3d + tmp6_U8)) << 8)), tmp1_U8);
       /*$FF1D*/ ram_poke(0x002e, (tmp1_U8 ^ ram_peek(0x002e)));
-      /*$FF1F*/ FUNC_NXTA1(0xff21);
+      /*$FF1F*/ FUNC_NXTA1(0xff21); if (s_native_depth <= depth) return;
       /*$FF22*/ CYCLES(0xff22, 7);
                 s_y = 0x35;
       /*$FF24*/ branchTarget = true; block_id = !s_status_c ? 1630 : 1632;
@@ -13785,12 +13819,12 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 1641:  // $FF70
       /*$FF70*/ CYCLES(0xff70, 6);
-                FUNC_ZMODE(0xff72);
+                FUNC_ZMODE(0xff72); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1642;
       break;
     case 1642:  // $FF73
       /*$FF73*/ CYCLES(0xff73, 6);
-                FUNC_GETNUM(0xff75);
+                FUNC_GETNUM(0xff75); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1643;
       break;
     case 1643:  // $FF76
@@ -13901,7 +13935,7 @@ void func_t001(uint16_t ret_addr) {
       /*$FFC1*/ tmp1_U8 = ram_peek((0xffe3 + s_y));
       /*$FFC4*/ push8(tmp1_U8);
       /*$FFC5*/ s_a = ram_peek(0x0031);
-                FUNC_ZMODE(0x0000);
+                FUNC_ZMODE(0x0000); if (s_native_depth <= depth) return;
                 tmp6_U8 = pop8();
                 tmp6_U8 = pop8();
                 block_id = find_block_id_func_t001(0xffc4, ((tmp1_U8 + 0xfe00) + 0x0001));
@@ -13915,45 +13949,47 @@ void func_t001(uint16_t ret_addr) {
       /*$FFCB*/ branchTarget = true; block_id = find_block_id_func_t001(0xffcb, pop16() + 1);;
       break;
     case 1660:
-      /*$E07B*/ FUNC_ISLETC(0x0000);
+      /*$E07B*/ FUNC_ISLETC(0x0000); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = find_block_id_func_t001(0xe07b, pop16() + 1);;
       break;
     case 1661:
-      /*$E482*/ FUNC_GARBAGE(0x0000);
+      /*$E482*/ FUNC_GARBAGE(0x0000); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = find_block_id_func_t001(0xe482, pop16() + 1);;
       break;
     case 1662:
-      /*$E517*/ FUNC_CHKSMPLVAR(0x0000);
+      /*$E517*/ FUNC_CHKSMPLVAR(0x0000); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = find_block_id_func_t001(0xe517, pop16() + 1);;
       break;
     case 1663:
-      /*$E8C4*/ FUNC_INCFACMAN(0x0000);
+      /*$E8C4*/ FUNC_INCFACMAN(0x0000); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = find_block_id_func_t001(0xe8c4, pop16() + 1);;
       break;
     case 1664:
-      /*$E9B0*/ FUNC_MULT2(0x0000);
+      /*$E9B0*/ FUNC_MULT2(0x0000); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = find_block_id_func_t001(0xe9b0, pop16() + 1);;
       break;
     case 1665:
-      /*$EBBC*/ FUNC_SIGN(0x0000);
+      /*$EBBC*/ FUNC_SIGN(0x0000); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = find_block_id_func_t001(0xebbc, pop16() + 1);;
       break;
     case 1666:
-      /*$F454*/ FUNC_COLORSHIFT(0x0000);
+      /*$F454*/ FUNC_COLORSHIFT(0x0000); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = find_block_id_func_t001(0xf454, pop16() + 1);;
       break;
     case 1667:
-      /*$FC6C*/ FUNC_VTABZ(0x0000);
+      /*$FC6C*/ FUNC_VTABZ(0x0000); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = find_block_id_func_t001(0xfc6c, pop16() + 1);;
       break;
     case 1668:
-      /*$FC3E*/ FUNC_CLREOL(0x0000);
+      /*$FC3E*/ FUNC_CLREOL(0x0000); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = find_block_id_func_t001(0xfc3e, pop16() + 1);;
       break;
     case 1669:
-      /*$FC9A*/ FUNC_CLREOL(0x0000);
+      /*$FC9A*/ FUNC_CLREOL(0x0000); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = find_block_id_func_t001(0xfc9a, pop16() + 1);;
       break;
+    case UNWIND_BLOCK_ID:
+      return;
     default:
       fprintf(stderr, "panic: unknown block_id: %u\n", block_id);
       abort();
@@ -24,11 +24,11 @@ void init_emulated(void) {
 
 void run_emulated(unsigned run_cycles) {
   bool branchTarget = true;
-  s_remaining_cycles += (int)run_cycles;
+  start_run(run_cycles);
   while (s_remaining_cycles > 0) {
     uint16_t tmp16;
     uint8_t tmp;
-    switch (s_pc) {
+    switch (dispatch_pc()) {
     case 0x0090: // [$0090..$0090]    1 bytes
       CYCLES(0x0090, 2);
       // WARNING: opcode self modification.
@@ -11213,6 +11213,10 @@ void run_emulated(unsigned run_cycles) {
       s_pc = 0xfca9;
       break;
     case 0xfca9: // [$FCA9..$FCA9]    1 bytes
+      if (wait_fast(2, 7, 9)) {
+        s_pc = s_a ? 0xfca9 : 0xfcb3;
+        break;
+      }
       CYCLES(0xfca9, 2);
       /* $FCA9 PHA */ push8(s_a);
       s_pc = 0xfcaa;
@@ -11565,8 +11569,10 @@ void run_emulated(unsigned run_cycles) {
       branchTarget = true;
       break;
     default:
-      fprintf(stderr, "Unknown code address: $%04X\n", s_pc);
-      error_handler(s_pc);
+      if (!unknown_code_address())
+        return;
+      branchTarget = true;
+      break;
     }
   }
 }
@@ -28,22 +28,6 @@ static uint16_t sbc_dec16(uint8_t a, uint8_t b, uint8_t cf) {
   return res.result | (res.status << 8);
 }
 
-static int cmp_map_addr(const void *a, const void *b) {
-  return *((const int *)a) - *((const int *)b);
-}
-
-static unsigned
-addr_to_block_id(uint16_t from_pc, uint16_t addr, const unsigned *block_map, size_t length) {
-  unsigned uaddr = addr;
-  const unsigned *p =
-      (const unsigned *)bsearch(&uaddr, block_map, length, sizeof(unsigned) * 2, cmp_map_addr);
-  if (p)
-    return p[1];
-  fprintf(stderr, "Unknown address $%04X\n", addr);
-  error_handler(from_pc);
-  abort();
-};
-
 void func_t001(uint16_t ret_addr);
 void FUNC_BCC(uint16_t ret_addr);
 void func_60e4(uint16_t ret_addr);
@@ -99,6 +83,110 @@ void FUNC_SETKBD(uint16_t ret_addr);
 void FUNC_SETVID(uint16_t ret_addr);
 void FUNC_SAV1(uint16_t ret_addr);
 
+/// The entry points of the functions, where interpreted code continues
+/// natively.
+static const struct func_entry {
+  uint16_t addr;
+  void (*fn)(uint16_t ret_addr);
+} s_func_entries[] = {
+    {0x0090, FUNC_BCC},
+    {0x60e4, func_60e4},
+    {0x6127, func_6127},
+    {0x6217, func_6217},
+    {0x64a9, func_64a9},
+    {0x660f, func_660f},
+    {0x6641, func_6641},
+    {0x69a9, func_69a9},
+    {0x6b93, func_6b93},
+    {0x6bda, func_6bda},
+    {0x6bfb, func_6bfb},
+    {0x6c4b, func_6c4b},
+    {0x7019, func_7019},
+    {0x7024, func_7024},
+    {0x702b, func_702b},
+    {0x71cd, func_71cd},
+    {0x7267, func_7267},
+    {0x728d, func_728d},
+    {0x7633, func_7633},
+    {0xd39a, FUNC_MVBLKUP2},
+    {0xd61a, FUNC_FNDLIN},
+    {0xd61e, FUNC_FNDLIN2},
+    {0xd697, FUNC_CLRTXTPTR},
+    {0xd849, FUNC_RESTORE},
+    {0xe07d, FUNC_ISLETC},
+    {0xe0ed, FUNC_GETARY},
+    {0xe519, FUNC_CHKSMPLVAR},
+    {0xe523, FUNC_CHKVAR},
+    {0xe635, FUNC_FRETMS},
+    {0xe89e, FUNC_TWSCMPFAC},
+    {0xe8a4, FUNC_TCFACMANT},
+    {0xe8c6, FUNC_INCFACMAN},
+    {0xe8f0, FUNC_SHFTRGHT},
+    {0xe907, FUNC_SHFTRGHT4},
+    {0xe9b0, FUNC_MULT1},
+    {0xe9b5, FUNC_MULT2},
+    {0xe9e3, FUNC_UPAY2ARG},
+    {0xeaf9, FUNC_UPAY2FAC},
+    {0xebb2, FUNC_FCOMP},
+    {0xebf2, FUNC_QINT},
+    {0xf273, FUNC_NORMAL},
+    {0xf80e, FUNC_PLOT1},
+    {0xf847, FUNC_GBASCALC},
+    {0xf864, FUNC_SETCOL},
+    {0xfb2f, FUNC_INIT},
+    {0xfbc1, FUNC_BASCALC},
+    {0xfc24, FUNC_VTABZ},
+    {0xfc9c, FUNC_CLREOL},
+    {0xfc9e, FUNC_CLREOLZ},
+    {0xfe84, FUNC_SETNORM},
+    {0xfe89, FUNC_SETKBD},
+    {0xfe93, FUNC_SETVID},
+    {0xff4c, FUNC_SAV1},
+};
+
+static int cmp_func_entry(const void *key, const void *entry) {
+  return *((const uint16_t *)key) - ((const struct func_entry *)entry)->addr;
+}
+
+/// Invoked when execution reaches \p addr, which isn't a block of the current
+/// function. Return true if the function must return, because the code
+/// returned to one of its callers. Otherwise run the function starting at
+/// \p addr natively, or interpret one instruction, and store the address of
+/// the next one in \p addr.
+static bool run_unknown(uint16_t *addr) {
+  if (native_unwind(*addr))
+    return true;
+  const struct func_entry *f = (const struct func_entry *)bsearch(
+      addr,
+      s_func_entries,
+      sizeof(s_func_entries) / sizeof(s_func_entries[0]),
+      sizeof(s_func_entries[0]),
+      cmp_func_entry);
+  if (f && f->fn)
+    return native_call(f->fn, addr);
+  *addr = interpret_unknown(*addr);
+  return false;
+}
+
+static int cmp_map_addr(const void *a, const void *b) {
+  return *((const int *)a) - *((const int *)b);
+}
+
+/// Map \p addr to a block id. Code which wasn't decompiled is interpreted
+/// until it reaches a block in the map, or returns to a caller.
+static unsigned
+addr_to_block_id(uint16_t from_pc, uint16_t addr, const unsigned *block_map, size_t length) {
+  for (;;) {
+    unsigned uaddr = addr;
+    const unsigned *p =
+        (const unsigned *)bsearch(&uaddr, block_map, length, sizeof(unsigned) * 2, cmp_map_addr);
+    if (p)
+      return p[1];
+    if (run_unknown(&addr))
+      return UNWIND_BLOCK_ID;
+  }
+};
+
 static void emulated_entry_point(void) {
   func_t001(false);
 }
@@ -106,8 +194,7 @@ static void emulated_entry_point(void) {
 void FUNC_BCC(uint16_t ret_addr) {
   bool branchTarget = true;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$0090*/ CYCLES(0x0090, 2);
@@ -122,12 +209,11 @@ void func_60e4(uint16_t ret_addr) {
   uint16_t tmp3_U16;
   uint16_t tmp4_U16;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$60E4*/ CYCLES(0x60e4, 6);
-            func_6127(0xfffe);
+            func_6127(0xfffe); if (s_native_depth <= depth) return;
   /*$60E7*/ CYCLES(0x60e7, 28);
             s_x = 0x00;
   /*$60E9*/ tmp1_U8 = ram_peek(0x0003);
@@ -171,7 +257,7 @@ bb_4:
               goto bb_1;
 bb_5:
   /*$6126*/ CYCLES(0x6126, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
@@ -180,8 +266,7 @@ void func_6127(uint16_t ret_addr) {
   uint16_t tmp1_U16;
   uint8_t tmp2_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$6127*/ CYCLES(0x6127, 57);
@@ -193,7 +278,7 @@ bb_0:
   /*$6140*/ tmp2_U8 = (uint8_t)(tmp2_U8 + 0x03);
             s_x = tmp2_U8;
   /*$6144*/ ram_poke(0x6063, ram_peek((0x6174 + tmp2_U8)));
-  /*$6147*/ if (ret_addr) pop16(); return;
+  /*$6147*/ native_return(ret_addr); return;
 }
 
 
@@ -202,8 +287,7 @@ void func_6217(uint16_t ret_addr) {
   uint8_t tmp1_U8;
   uint8_t tmp2_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$6217*/ CYCLES(0x6217, 14);
@@ -217,7 +301,7 @@ bb_0:
               goto bb_2;
 bb_1:
   /*$6216*/ CYCLES(0x6216, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 bb_2:
   /*$621F*/ CYCLES(0x621f, 26);
             tmp2_U8 = s_a;
@@ -237,7 +321,7 @@ bb_2:
 bb_3:
   /*$622E*/ CYCLES(0x622e, 7);
             ram_poke(0x624d, s_a);
-  /*$6231*/ if (ret_addr) pop16(); return;
+  /*$6231*/ native_return(ret_addr); return;
 }
 
 
@@ -245,8 +329,7 @@ void func_64a9(uint16_t ret_addr) {
   bool branchTarget = true;
   uint8_t tmp1_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$64A9*/ CYCLES(0x64a9, 4);
@@ -294,15 +377,14 @@ bb_6:
               goto bb_4;
 bb_7:
   /*$64C7*/ CYCLES(0x64c7, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
 void func_660f(uint16_t ret_addr) {
   bool branchTarget = true;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$660F*/ CYCLES(0x660f, 62);
@@ -316,21 +398,20 @@ bb_0:
   /*$6628*/ ram_poke(0x663b, 0x26);
   /*$662D*/ ram_poke(0x663f, 0xff);
   /*$6630*/ s_a = 0x14;
-  /*$6632*/ if (ret_addr) pop16(); return;
+  /*$6632*/ native_return(ret_addr); return;
 }
 
 
 void func_6641(uint16_t ret_addr) {
   bool branchTarget = true;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$6641*/ CYCLES(0x6641, 16);
   /*$6643*/ ram_poke(0x0036, 0x4a);
   /*$6647*/ ram_poke(0x0037, 0x66);
-  /*$6649*/ if (ret_addr) pop16(); return;
+  /*$6649*/ native_return(ret_addr); return;
 }
 
 
@@ -338,8 +419,7 @@ void func_69a9(uint16_t ret_addr) {
   bool branchTarget = true;
   uint8_t tmp1_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$69A9*/ CYCLES(0x69a9, 7);
@@ -368,7 +448,7 @@ bb_4:
   /*$69BE*/ ram_poke(0x69c2, (ram_peek(0x69c2) ^ 0x01));
 bb_5:
   /*$69C1*/ CYCLES(0x69c1, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
@@ -380,12 +460,11 @@ void func_6b93(uint16_t ret_addr) {
   uint16_t tmp4_U16;
   uint16_t tmp5_U16;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$6B93*/ CYCLES(0x6b93, 6);
-            func_6127(0xfffe);
+            func_6127(0xfffe); if (s_native_depth <= depth) return;
   /*$6B96*/ CYCLES(0x6b96, 28);
             s_x = 0x00;
   /*$6B98*/ tmp1_U8 = ram_peek(0x0003);
@@ -429,19 +508,18 @@ bb_4:
               goto bb_1;
 bb_5:
   /*$6BD9*/ CYCLES(0x6bd9, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
 void func_6bda(uint16_t ret_addr) {
   bool branchTarget = true;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$6BDA*/ CYCLES(0x6bda, 6);
-            func_60e4(0xfffe);
+            func_60e4(0xfffe); if (s_native_depth <= depth) return;
   /*$6BDD*/ CYCLES(0x6bdd, 9);
             branchTarget = true;
             if (!ram_peek(0x0305))
@@ -449,12 +527,12 @@ bb_0:
 bb_1:
   /*$6BE2*/ CYCLES(0x6be2, 12);
   /*$6BE4*/ ram_poke(0x0000, 0x01);
-  /*$6BE6*/ func_6b93(0xfffe);
+  /*$6BE6*/ func_6b93(0xfffe); if (s_native_depth <= depth) return;
             branchTarget = true;
 bb_2:
   /*$6BE9*/ CYCLES(0x6be9, 11);
   /*$6BEB*/ ram_poke(0x0305, 0x00);
-  /*$6BEE*/ if (ret_addr) pop16(); return;
+  /*$6BEE*/ native_return(ret_addr); return;
 }
 
 
@@ -462,8 +540,7 @@ void func_6bfb(uint16_t ret_addr) {
   bool branchTarget = true;
   uint8_t tmp1_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$6BFB*/ CYCLES(0x6bfb, 9);
@@ -528,7 +605,7 @@ bb_10:
               goto bb_1;
 bb_11:
   /*$6C45*/ CYCLES(0x6c45, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
@@ -536,8 +613,7 @@ void func_6c4b(uint16_t ret_addr) {
   bool branchTarget = true;
   uint8_t tmp1_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$6C4B*/ CYCLES(0x6c4b, 7);
@@ -565,7 +641,7 @@ bb_3:
             goto bb_2;
 bb_4:
   /*$6C62*/ CYCLES(0x6c62, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
@@ -573,8 +649,7 @@ void func_7019(uint16_t ret_addr) {
   bool branchTarget = true;
   uint8_t tmp1_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$7019*/ CYCLES(0x7019, 14);
@@ -591,15 +666,14 @@ bb_1:
             ram_poke(0x000b, (uint8_t)(ram_peek(0x000b) + 0x01));
 bb_2:
   /*$7023*/ CYCLES(0x7023, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
 void func_7024(uint16_t ret_addr) {
   bool branchTarget = true;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$7024*/ CYCLES(0x7024, 4);
@@ -611,8 +685,8 @@ bb_1:
             s_a = 0x05;
 bb_2:
   /*$7028*/ CYCLES(0x7028, 6);
-            FUNC_SETCOL(0x0000);
-            if (ret_addr) pop16(); return;
+            FUNC_SETCOL(0x0000); if (s_native_depth <= depth) return;
+            native_return(ret_addr); return;
 }
 
 
@@ -620,8 +694,7 @@ void func_702b(uint16_t ret_addr) {
   bool branchTarget = true;
   uint8_t tmp1_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$702B*/ CYCLES(0x702b, 18);
@@ -647,7 +720,7 @@ bb_2:
               goto bb_1;
 bb_3:
   /*$7044*/ CYCLES(0x7044, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
@@ -657,8 +730,7 @@ void func_71cd(uint16_t ret_addr) {
   uint16_t tmp2_U16;
   uint8_t tmp3_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$71CD*/ CYCLES(0x71cd, 26);
@@ -707,7 +779,7 @@ bb_7:
 bb_8:
   /*$71F1*/ CYCLES(0x71f1, 4);
             s_status_d = 0x00;
-  /*$71F2*/ if (ret_addr) pop16(); return;
+  /*$71F2*/ native_return(ret_addr); return;
 }
 
 
@@ -717,8 +789,7 @@ void func_7267(uint16_t ret_addr) {
   uint16_t tmp2_U16;
   uint8_t tmp3_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$7267*/ CYCLES(0x7267, 65);
@@ -773,7 +844,7 @@ bb_8:
 bb_9:
   /*$7288*/ ram_poke(0x7255, s_a);
   /*$728B*/ s_status_d = 0x00;
-  /*$728C*/ if (ret_addr) pop16(); return;
+  /*$728C*/ native_return(ret_addr); return;
 }
 
 
@@ -782,8 +853,7 @@ void func_728d(uint16_t ret_addr) {
   uint8_t tmp1_U8;
   uint8_t tmp2_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$728D*/ CYCLES(0x728d, 14);
@@ -845,7 +915,7 @@ bb_8:
   /*$72CA*/ ram_poke(0x7259, ram_peek(0x7255));
 bb_9:
   /*$72CD*/ CYCLES(0x72cd, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
@@ -853,8 +923,7 @@ void func_7633(uint16_t ret_addr) {
   bool branchTarget = true;
   uint16_t tmp1_U16;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$7633*/ CYCLES(0x7633, 24);
@@ -862,9 +931,9 @@ bb_0:
             s_status_v = (((uint8_t)(tmp1_U16 >> 8) & 0x40) != 0);
   /*$763A*/ ram_poke(0x725e, ((uint8_t)tmp1_U16));
   /*$763D*/ s_status_d = 0x00;
-  /*$763E*/ func_64a9(0xfffe);
+  /*$763E*/ func_64a9(0xfffe); if (s_native_depth <= depth) return;
   /*$7641*/ CYCLES(0x7641, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
@@ -876,8 +945,7 @@ void FUNC_MVBLKUP2(uint16_t ret_addr) {
   uint16_t tmp4_U16;
   uint8_t tmp5_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$D39A*/ CYCLES(0xd39a, 29);
@@ -1007,22 +1075,21 @@ bb_20:
               goto bb_18;
 bb_21:
   /*$D3D5*/ CYCLES(0xd3d5, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
 void FUNC_FNDLIN(uint16_t ret_addr) {
   bool branchTarget = true;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$D61A*/ CYCLES(0xd61a, 7);
             s_a = ram_peek(0x0067);
   /*$D61C*/ s_x = ram_peek(0x0068);
-            FUNC_FNDLIN2(0x0000);
-            if (ret_addr) pop16(); return;
+            FUNC_FNDLIN2(0x0000); if (s_native_depth <= depth) return;
+            native_return(ret_addr); return;
 }
 
 
@@ -1032,8 +1099,7 @@ void FUNC_FNDLIN2(uint16_t ret_addr) {
   uint8_t tmp2_U8;
   uint8_t tmp3_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$D61E*/ CYCLES(0xd61e, 18);
@@ -1111,7 +1177,7 @@ bb_7:
             s_status_c = 0x00;
 bb_8:
   /*$D648*/ CYCLES(0xd648, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
@@ -1119,8 +1185,7 @@ void FUNC_CLRTXTPTR(uint16_t ret_addr) {
   bool branchTarget = true;
   uint16_t tmp1_U16;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$D697*/ CYCLES(0xd697, 24);
@@ -1149,7 +1214,7 @@ bb_5:
   /*$D6A0*/ s_a = ((uint8_t)adc_dec16(s_a, 0xff, s_status_c));
 bb_6:
   /*$D6A2*/ ram_poke(0x00b9, s_a);
-  /*$D6A4*/ if (ret_addr) pop16(); return;
+  /*$D6A4*/ native_return(ret_addr); return;
 }
 
 
@@ -1159,8 +1224,7 @@ void FUNC_RESTORE(uint16_t ret_addr) {
   uint16_t tmp2_U16;
   uint8_t tmp3_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$D849*/ CYCLES(0xd849, 16);
@@ -1194,7 +1258,7 @@ bb_5:
             ram_poke(0x007d, s_a);
   /*$D855*/ ram_poke(0x007e, s_y);
   /*$D857*/ CYCLES(0xd857, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
@@ -1205,8 +1269,7 @@ void FUNC_ISLETC(uint16_t ret_addr) {
   uint16_t tmp3_U16;
   uint16_t tmp4_U16;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$E07D*/ CYCLES(0xe07d, 7);
@@ -1252,7 +1315,7 @@ bb_6:
 bb_7:
 bb_8:
   /*$E086*/ CYCLES(0xe086, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
@@ -1263,8 +1326,7 @@ void FUNC_GETARY(uint16_t ret_addr) {
   uint16_t tmp3_U16;
   uint8_t tmp4_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$E0ED*/ CYCLES(0xe0ed, 19);
@@ -1311,7 +1373,7 @@ bb_8:
   /*$E0F9*/ CYCLES(0xe0f9, 9);
             ram_poke(0x0094, s_a);
   /*$E0FB*/ ram_poke(0x0095, s_y);
-  /*$E0FD*/ if (ret_addr) pop16(); return;
+  /*$E0FD*/ native_return(ret_addr); return;
 }
 
 
@@ -1322,8 +1384,7 @@ void FUNC_CHKSMPLVAR(uint16_t ret_addr) {
   uint16_t tmp3_U16;
   uint16_t tmp4_U16;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$E519*/ CYCLES(0xe519, 7);
@@ -1342,8 +1403,8 @@ bb_1:
 bb_2:
   /*$E522*/ CYCLES(0xe522, 2);
             s_y = (uint8_t)(s_y + 0x01);
-            FUNC_CHKVAR(0x0000);
-            if (ret_addr) pop16(); return;
+            FUNC_CHKVAR(0x0000); if (s_native_depth <= depth) return;
+            native_return(ret_addr); return;
 bb_3:
   /*$E552*/ CYCLES(0xe552, 16);
             s_a = ram_peek(0x008f);
@@ -1378,7 +1439,7 @@ bb_8:
   /*$E55F*/ s_status_not_z = 0x00;
             s_status_n = 0x00;
             s_y = 0x00;
-  /*$E561*/ if (ret_addr) pop16(); return;
+  /*$E561*/ native_return(ret_addr); return;
 }
 
 
@@ -1390,8 +1451,7 @@ void FUNC_CHKVAR(uint16_t ret_addr) {
   uint16_t tmp4_U16;
   uint16_t tmp5_U16;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$E523*/ CYCLES(0xe523, 7);
@@ -1480,7 +1540,7 @@ bb_13:
   /*$E55F*/ s_status_not_z = 0x00;
             s_status_n = 0x00;
             s_y = 0x00;
-  /*$E561*/ if (ret_addr) pop16(); return;
+  /*$E561*/ native_return(ret_addr); return;
 }
 
 
@@ -1492,8 +1552,7 @@ void FUNC_FRETMS(uint16_t ret_addr) {
   uint16_t tmp4_U16;
   uint16_t tmp5_U16;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$E635*/ CYCLES(0xe635, 7);
@@ -1541,21 +1600,20 @@ bb_5:
             s_status_n = 0x00;
 bb_6:
   /*$E645*/ CYCLES(0xe645, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
 void FUNC_TWSCMPFAC(uint16_t ret_addr) {
   bool branchTarget = true;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$E89E*/ CYCLES(0xe89e, 11);
   /*$E8A2*/ ram_poke(0x00a2, (ram_peek(0x00a2) ^ 0xff));
-            FUNC_TCFACMANT(0x0000);
-            if (ret_addr) pop16(); return;
+            FUNC_TCFACMANT(0x0000); if (s_native_depth <= depth) return;
+            native_return(ret_addr); return;
 }
 
 
@@ -1563,8 +1621,7 @@ void FUNC_TCFACMANT(uint16_t ret_addr) {
   bool branchTarget = true;
   uint8_t tmp1_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$E8A4*/ CYCLES(0xe8a4, 58);
@@ -1584,10 +1641,10 @@ bb_0:
               goto bb_2;
 bb_1:
   /*$E8D4*/ CYCLES(0xe8d4, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 bb_2:
-  /*$E8C4*/ FUNC_INCFACMAN(0x0000);
-            if (ret_addr) pop16(); return;
+  /*$E8C4*/ FUNC_INCFACMAN(0x0000); if (s_native_depth <= depth) return;
+            native_return(ret_addr); return;
 }
 
 
@@ -1595,8 +1652,7 @@ void FUNC_INCFACMAN(uint16_t ret_addr) {
   bool branchTarget = true;
   uint8_t tmp1_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$E8C6*/ CYCLES(0xe8c6, 7);
@@ -1633,7 +1689,7 @@ bb_3:
             ram_poke(0x009e, tmp1_U8);
 bb_4:
   /*$E8D4*/ CYCLES(0xe8d4, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
@@ -1645,8 +1701,7 @@ void FUNC_SHFTRGHT(uint16_t ret_addr) {
   uint8_t tmp4_U8;
   uint8_t tmp5_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$E8F0*/ CYCLES(0xe8f0, 7);
@@ -1757,7 +1812,7 @@ bb_12:
 bb_13:
   /*$E911*/ CYCLES(0xe911, 4);
             s_status_c = 0x00;
-  /*$E912*/ if (ret_addr) pop16(); return;
+  /*$E912*/ native_return(ret_addr); return;
 }
 
 
@@ -1769,8 +1824,7 @@ void FUNC_SHFTRGHT4(uint16_t ret_addr) {
   uint8_t tmp4_U8;
   uint16_t tmp5_U16;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$E907*/ CYCLES(0xe907, 18);
@@ -1820,7 +1874,7 @@ bb_3:
 bb_4:
   /*$E911*/ CYCLES(0xe911, 4);
             s_status_c = 0x00;
-  /*$E912*/ if (ret_addr) pop16(); return;
+  /*$E912*/ native_return(ret_addr); return;
 }
 
 
@@ -1832,8 +1886,7 @@ void FUNC_MULT1(uint16_t ret_addr) {
   uint8_t tmp4_U8;
   uint8_t tmp5_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$E9B0*/ CYCLES(0xe9b0, 4);
@@ -1938,15 +1991,15 @@ bb_12:
 bb_13:
   /*$E911*/ CYCLES(0xe911, 4);
             s_status_c = 0x00;
-  /*$E912*/ if (ret_addr) pop16(); return;
+  /*$E912*/ native_return(ret_addr); return;
 bb_14:
   /*$E9B2*/ CYCLES(0xe9b2, 6);
   /*$E8DA*/ CYCLES(0xe8da, 4);
             s_x = 0x61;
             goto bb_1;
 bb_15:
-  /*$E9B0*/ FUNC_MULT2(0x0000);
-            if (ret_addr) pop16(); return;
+  /*$E9B0*/ FUNC_MULT2(0x0000); if (s_native_depth <= depth) return;
+            native_return(ret_addr); return;
 }
 
 
@@ -1958,8 +2011,7 @@ void FUNC_MULT2(uint16_t ret_addr) {
   uint16_t tmp4_U16;
   uint8_t tmp5_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$E9B5*/ CYCLES(0xe9b5, 6);
@@ -2058,7 +2110,7 @@ bb_15:
               goto bb_1;
 bb_16:
   /*$E9E2*/ CYCLES(0xe9e2, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
@@ -2066,8 +2118,7 @@ void FUNC_UPAY2ARG(uint16_t ret_addr) {
   bool branchTarget = true;
   uint8_t tmp1_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$E9E3*/ CYCLES(0xe9e3, 74);
@@ -2090,7 +2141,7 @@ bb_0:
             s_status_not_z = tmp1_U8;
             s_status_n = (tmp1_U8 & 0x80);
             s_a = tmp1_U8;
-  /*$EA0D*/ if (ret_addr) pop16(); return;
+  /*$EA0D*/ native_return(ret_addr); return;
 }
 
 
@@ -2098,8 +2149,7 @@ void FUNC_UPAY2FAC(uint16_t ret_addr) {
   bool branchTarget = true;
   uint8_t tmp1_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$EAF9*/ CYCLES(0xeaf9, 63);
@@ -2121,7 +2171,7 @@ bb_0:
             s_a = tmp1_U8;
   /*$EB19*/ ram_poke(0x009d, tmp1_U8);
   /*$EB1B*/ ram_poke(0x00ac, 0x00);
-  /*$EB1D*/ if (ret_addr) pop16(); return;
+  /*$EB1D*/ native_return(ret_addr); return;
 }
 
 
@@ -2133,8 +2183,7 @@ void FUNC_FCOMP(uint16_t ret_addr) {
   uint16_t tmp4_U16;
   uint16_t tmp5_U16;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$EBB2*/ CYCLES(0xebb2, 21);
@@ -2175,7 +2224,7 @@ bb_4:
             s_a = 0x01;
 bb_5:
   /*$EB8F*/ CYCLES(0xeb8f, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 bb_6:
   /*$EBBE*/ CYCLES(0xebbe, 11);
             tmp1_U8 = peek((ram_peek16al(0x0060) + s_y));
@@ -2266,7 +2315,7 @@ bb_17:
             goto bb_3;
 bb_18:
   /*$EC11*/ CYCLES(0xec11, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
@@ -2274,8 +2323,7 @@ void FUNC_QINT(uint16_t ret_addr) {
   bool branchTarget = true;
   uint8_t tmp1_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$EBF2*/ CYCLES(0xebf2, 7);
@@ -2304,7 +2352,7 @@ bb_5:
   /*$EBFD*/ CYCLES(0xebfd, 14);
             tmp1_U8 = s_a;
   /*$EC00*/ ram_poke(0x00a4, 0xff);
-  /*$EC02*/ FUNC_TCFACMANT(0xfffe);
+  /*$EC02*/ FUNC_TCFACMANT(0xfffe); if (s_native_depth <= depth) return;
   /*$EC05*/ CYCLES(0xec05, 2);
             s_a = tmp1_U8;
 bb_6:
@@ -2317,11 +2365,11 @@ bb_6:
               goto bb_8;
 bb_7:
   /*$EC0C*/ CYCLES(0xec0c, 6);
-            FUNC_SHFTRGHT(0xfffe);
+            FUNC_SHFTRGHT(0xfffe); if (s_native_depth <= depth) return;
   /*$EC0F*/ CYCLES(0xec0f, 4);
             ram_poke(0x00a4, s_y);
   /*$EC11*/ CYCLES(0xec11, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 bb_8:
   /*$EC12*/ CYCLES(0xec12, 24);
             s_y = s_a;
@@ -2331,10 +2379,10 @@ bb_8:
   /*$EC19*/ tmp1_U8 = (ram_peek(0x00a2) & 0x80) | ram_peek(0x009e);
             s_a = tmp1_U8;
   /*$EC1B*/ ram_poke(0x009e, tmp1_U8);
-  /*$EC1D*/ FUNC_SHFTRGHT4(0xfffe);
+  /*$EC1D*/ FUNC_SHFTRGHT4(0xfffe); if (s_native_depth <= depth) return;
   /*$EC20*/ CYCLES(0xec20, 6);
             ram_poke(0x00a4, s_y);
-  /*$EC22*/ if (ret_addr) pop16(); return;
+  /*$EC22*/ native_return(ret_addr); return;
 bb_9:
   /*$EC40*/ CYCLES(0xec40, 18);
             tmp1_U8 = s_a;
@@ -2345,22 +2393,21 @@ bb_9:
   /*$EC48*/ s_status_not_z = tmp1_U8;
             s_status_n = (tmp1_U8 & 0x80);
             s_y = tmp1_U8;
-  /*$EC49*/ if (ret_addr) pop16(); return;
+  /*$EC49*/ native_return(ret_addr); return;
 }
 
 
 void FUNC_NORMAL(uint16_t ret_addr) {
   bool branchTarget = true;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$F273*/ CYCLES(0xf273, 7);
   /*$F279*/ CYCLES(0xf279, 12);
   /*$F27B*/ ram_poke(0x0032, 0xff);
   /*$F27D*/ ram_poke(0x00f3, 0x00);
-  /*$F27F*/ if (ret_addr) pop16(); return;
+  /*$F27F*/ native_return(ret_addr); return;
 }
 
 
@@ -2370,8 +2417,7 @@ void FUNC_PLOT1(uint16_t ret_addr) {
   uint8_t tmp2_U8;
   uint8_t tmp3_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$F80E*/ CYCLES(0xf80e, 19);
@@ -2383,7 +2429,7 @@ bb_0:
             s_status_n = (tmp2_U8 & 0x80);
             s_a = tmp2_U8;
   /*$F816*/ poke((ram_peek16al(0x0026) + tmp1_U8), tmp2_U8);
-  /*$F818*/ if (ret_addr) pop16(); return;
+  /*$F818*/ native_return(ret_addr); return;
 }
 
 
@@ -2392,8 +2438,7 @@ void FUNC_GBASCALC(uint16_t ret_addr) {
   uint8_t tmp1_U8;
   uint8_t tmp2_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$F847*/ CYCLES(0xf847, 23);
@@ -2422,7 +2467,7 @@ bb_5:
             tmp2_U8 = s_a;
             ram_poke(0x0026, tmp2_U8);
   /*$F85C*/ ram_poke(0x0026, ((uint8_t)(tmp2_U8 << 0x02) | ram_peek(0x0026)));
-  /*$F85E*/ if (ret_addr) pop16(); return;
+  /*$F85E*/ native_return(ret_addr); return;
 }
 
 
@@ -2431,8 +2476,7 @@ void FUNC_SETCOL(uint16_t ret_addr) {
   uint8_t tmp1_U8;
   uint16_t tmp2_U16;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$F864*/ CYCLES(0xf864, 23);
@@ -2445,7 +2489,7 @@ bb_0:
             s_status_n = (tmp1_U8 & 0x80);
             s_a = tmp1_U8;
   /*$F86E*/ ram_poke(0x0030, tmp1_U8);
-  /*$F870*/ if (ret_addr) pop16(); return;
+  /*$F870*/ native_return(ret_addr); return;
 }
 
 
@@ -2453,8 +2497,7 @@ void FUNC_INIT(uint16_t ret_addr) {
   bool branchTarget = true;
   uint8_t tmp1_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$FB2F*/ CYCLES(0xfb2f, 29);
@@ -2470,8 +2513,8 @@ bb_0:
   /*$FB5B*/ ram_poke(0x0025, 0x17);
   /*$FC22*/ CYCLES(0xfc22, 4);
             s_a = ram_peek(0x0025);
-            FUNC_VTABZ(0x0000);
-            if (ret_addr) pop16(); return;
+            FUNC_VTABZ(0x0000); if (s_native_depth <= depth) return;
+            native_return(ret_addr); return;
 }
 
 
@@ -2482,8 +2525,7 @@ void FUNC_BASCALC(uint16_t ret_addr) {
   uint16_t tmp3_U16;
   uint16_t tmp4_U16;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$FBC1*/ CYCLES(0xfbc1, 23);
@@ -2523,7 +2565,7 @@ bb_5:
             s_status_n = (tmp2_U8 & 0x80);
             s_a = tmp2_U8;
   /*$FBD6*/ ram_poke(0x0028, tmp2_U8);
-  /*$FBD8*/ if (ret_addr) pop16(); return;
+  /*$FBD8*/ native_return(ret_addr); return;
 }
 
 
@@ -2534,12 +2576,11 @@ void FUNC_VTABZ(uint16_t ret_addr) {
   uint16_t tmp3_U16;
   uint8_t tmp4_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$FC24*/ CYCLES(0xfc24, 6);
-            FUNC_BASCALC(0xfffe);
+            FUNC_BASCALC(0xfffe); if (s_native_depth <= depth) return;
   /*$FC27*/ CYCLES(0xfc27, 7);
             if (s_status_d)
               goto bb_2;
@@ -2565,21 +2606,20 @@ bb_2:
 bb_3:
   /*$FC29*/ ram_poke(0x0028, s_a);
   /*$FC2B*/ CYCLES(0xfc2b, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
 void FUNC_CLREOL(uint16_t ret_addr) {
   bool branchTarget = true;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
 bb_0:
   /*$FC9C*/ CYCLES(0xfc9c, 4);
             s_y = ram_peek(0x0024);
-            FUNC_CLREOLZ(0x0000);
-            if (ret_addr) pop16(); return;
+            FUNC_CLREOLZ(0x0000); if (s_native_depth <= depth) return;
+            native_return(ret_addr); return;
 }
 
 
@@ -2589,8 +2629,7 @@ void FUNC_CLREOLZ(uint16_t ret_addr) {
   uint8_t tmp2_U8;
   uint8_t tmp3_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$FC9E*/ CYCLES(0xfc9e, 4);
@@ -2611,20 +2650,19 @@ bb_1:
               goto bb_1;
 bb_2:
   /*$FCA7*/ CYCLES(0xfca7, 2);
-            if (ret_addr) pop16(); return;
+            native_return(ret_addr); return;
 }
 
 
 void FUNC_SETNORM(uint16_t ret_addr) {
   bool branchTarget = true;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$FE84*/ CYCLES(0xfe84, 9);
   /*$FE86*/ ram_poke(0x0032, 0xff);
-  /*$FE88*/ if (ret_addr) pop16(); return;
+  /*$FE88*/ native_return(ret_addr); return;
 }
 
 
@@ -2632,8 +2670,7 @@ void FUNC_SETKBD(uint16_t ret_addr) {
   bool branchTarget = true;
   uint8_t tmp1_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$FE89*/ CYCLES(0xfe89, 18);
@@ -2660,7 +2697,7 @@ bb_3:
             tmp1_U8 = s_x;
             ram_poke(tmp1_U8, s_y);
   /*$FEAB*/ ram_poke((uint8_t)(0x01 + tmp1_U8), s_a);
-  /*$FEAD*/ if (ret_addr) pop16(); return;
+  /*$FEAD*/ native_return(ret_addr); return;
 }
 
 
@@ -2668,8 +2705,7 @@ void FUNC_SETVID(uint16_t ret_addr) {
   bool branchTarget = true;
   uint8_t tmp1_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$FE93*/ CYCLES(0xfe93, 14);
@@ -2696,7 +2732,7 @@ bb_3:
             tmp1_U8 = s_x;
             ram_poke(tmp1_U8, s_y);
   /*$FEAB*/ ram_poke((uint8_t)(0x01 + tmp1_U8), s_a);
-  /*$FEAD*/ if (ret_addr) pop16(); return;
+  /*$FEAD*/ native_return(ret_addr); return;
 }
 
 
@@ -2704,8 +2740,7 @@ void FUNC_SAV1(uint16_t ret_addr) {
   bool branchTarget = true;
   uint8_t tmp1_U8;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  native_enter(ret_addr);
 
 bb_0:
   /*$FF4C*/ CYCLES(0xff4c, 23);
@@ -2718,7 +2753,7 @@ bb_0:
             s_x = tmp1_U8;
   /*$FF55*/ ram_poke(0x0049, tmp1_U8);
   /*$FF57*/ s_status_d = 0x00;
-  /*$FF58*/ if (ret_addr) pop16(); return;
+  /*$FF58*/ native_return(ret_addr); return;
 }
 
 
@@ -2734,8 +2769,7 @@ void func_t001(uint16_t ret_addr) {
   uint8_t tmp5_U8;
   uint16_t tmp6_U16;
 
-  if (ret_addr)
-    push16(ret_addr); // Fake return address.
+  unsigned depth = native_enter(ret_addr);
 
   for(;;) {
     switch (block_id) {
@@ -2745,7 +2779,7 @@ void func_t001(uint16_t ret_addr) {
                 s_status_i = 0x00;
       /*$FA62*/ CYCLES(0xfa62, 7);
                 s_status_d = 0x00;
-      /*$FA63*/ FUNC_SETNORM(0xfffe);
+      /*$FA63*/ FUNC_SETNORM(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1921;
       break;
     case 1:  // $0090
@@ -2852,12 +2886,12 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 18:  // $3768
       /*$3768*/ CYCLES(0x3768, 6);
-                FUNC_SETVID(0xfffe);
+                FUNC_SETVID(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 19;
       break;
     case 19:  // $376B
       /*$376B*/ CYCLES(0x376b, 6);
-                FUNC_SETKBD(0xfffe);
+                FUNC_SETKBD(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 20;
       break;
     case 20:  // $376E
@@ -2871,7 +2905,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 21:  // $60E4
       /*$60E4*/ CYCLES(0x60e4, 6);
-                func_6127(0xfffe);
+                func_6127(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 22;
       break;
     case 22:  // $60E7
@@ -2946,7 +2980,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 29:  // $6148
       /*$6148*/ CYCLES(0x6148, 6);
-                func_6127(0xfffe);
+                func_6127(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 30;
       break;
     case 30:  // $614B
@@ -2975,7 +3009,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 34:  // $615A
       /*$615A*/ CYCLES(0x615a, 6);
-                func_6127(0xfffe);
+                func_6127(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 35;
       break;
     case 35:  // $615D
@@ -3062,7 +3096,7 @@ void func_t001(uint16_t ret_addr) {
     case 44:  // $6256
       /*$6256*/ CYCLES(0x6256, 9);
                 s_a = 0x14;
-      /*$6258*/ func_660f(0xfffe);
+      /*$6258*/ func_660f(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 45;
       break;
     case 45:  // $625B
@@ -3098,7 +3132,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 49:  // $628B
       /*$628B*/ CYCLES(0x628b, 6);
-                func_6217(0xfffe);
+                func_6217(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 50;
       break;
     case 50:  // $628E
@@ -3141,7 +3175,7 @@ void func_t001(uint16_t ret_addr) {
       /*$62A9*/ ram_poke(0x0001, 0x0c);
       /*$62AE*/ ram_poke(0x0002, ram_peek(0x624f));
       /*$62B3*/ ram_poke(0x0003, ram_peek(0x6250));
-      /*$62B5*/ func_6bda(0xfffe);
+      /*$62B5*/ func_6bda(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 58;
       break;
     case 58:  // $62B8
@@ -3150,7 +3184,7 @@ void func_t001(uint16_t ret_addr) {
                 s_x = tmp5_U8;
       /*$62C1*/ ram_poke(0x624e, tmp5_U8);
       /*$62C4*/ s_a = tmp5_U8;
-      /*$62C5*/ FUNC_SETCOL(0xfffe);
+      /*$62C5*/ FUNC_SETCOL(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 59;
       break;
     case 59:  // $62C8
@@ -3206,7 +3240,7 @@ void func_t001(uint16_t ret_addr) {
       /*$62F9*/ ram_poke(0x0003, ram_peek(0x6250));
       /*$62FE*/ ram_poke(0x0000, ram_peek(0x624e));
       /*$6300*/ CYCLES(0x6300, 6);
-                func_60e4(0xfffe);
+                func_60e4(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 68;
       break;
     case 68:  // $6303
@@ -3370,7 +3404,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 97:  // $639B
       /*$639B*/ CYCLES(0x639b, 6);
-                func_69a9(0xfffe);
+                func_69a9(0xfffe); if (s_native_depth <= depth) return;
       /*$639E*/ CYCLES(0x639e, 6);
                 branchTarget = true; block_id = 116;
       break;
@@ -3395,7 +3429,7 @@ void func_t001(uint16_t ret_addr) {
       /*$63BA*/ CYCLES(0x63ba, 11);
                 push8(s_a);
       /*$63BB*/ s_a = 0x00;
-      /*$63BD*/ FUNC_SETCOL(0xfffe);
+      /*$63BD*/ FUNC_SETCOL(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 102;
       break;
     case 102:  // $63C0
@@ -3409,7 +3443,7 @@ void func_t001(uint16_t ret_addr) {
       /*$63CB*/ ram_poke(0x0001, 0x00);
       /*$63D0*/ ram_poke(0x0003, ram_peek(0x6252));
       /*$63D5*/ ram_poke(0x0002, ram_peek(0x6251));
-      /*$63D7*/ func_60e4(0xfffe);
+      /*$63D7*/ func_60e4(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 104;
       break;
     case 104:  // $63DA
@@ -3471,7 +3505,7 @@ void func_t001(uint16_t ret_addr) {
       /*$63FD*/ ram_poke(0x0001, 0x0c);
       /*$6402*/ ram_poke(0x0002, ram_peek(0x6251));
       /*$6407*/ ram_poke(0x0003, ram_peek(0x6252));
-      /*$6409*/ func_60e4(0xfffe);
+      /*$6409*/ func_60e4(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 115;
       break;
     case 115:  // $640C
@@ -3517,7 +3551,7 @@ void func_t001(uint16_t ret_addr) {
     case 121:  // $6444
       /*$6444*/ CYCLES(0x6444, 9);
                 s_a = 0x0d;
-      /*$6446*/ FUNC_SETCOL(0xfffe);
+      /*$6446*/ FUNC_SETCOL(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 122;
       break;
     case 122:  // $6449
@@ -3533,13 +3567,13 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 124:  // $6453
       /*$6453*/ CYCLES(0x6453, 6);
-                func_6bfb(0xfffe);
+                func_6bfb(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 125;
       break;
     case 125:  // $6456
       /*$6456*/ CYCLES(0x6456, 9);
       /*$6457*/ push8(s_x);
-      /*$6458*/ func_6217(0xfffe);
+      /*$6458*/ func_6217(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 126;
       break;
     case 126:  // $645B
@@ -3569,7 +3603,7 @@ void func_t001(uint16_t ret_addr) {
       /*$6479*/ CYCLES(0x6479, 6);
       /*$632E*/ CYCLES(0x632e, 9);
                 s_a = 0x07;
-      /*$6330*/ FUNC_SETCOL(0xfffe);
+      /*$6330*/ FUNC_SETCOL(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 83;
       break;
     case 131:  // $647C
@@ -3583,7 +3617,7 @@ void func_t001(uint16_t ret_addr) {
                 s_x = 0x20;
       /*$6482*/ ram_poke(0x6473, 0x20);
       /*$6485*/ s_a = 0x07;
-      /*$6487*/ FUNC_SETCOL(0xfffe);
+      /*$6487*/ FUNC_SETCOL(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 133;
       break;
     case 133:  // $648A
@@ -3788,14 +3822,14 @@ void func_t001(uint16_t ret_addr) {
       /*$654C*/ CYCLES(0x654c, 12);
                 s_a = 0x00;
       /*$654E*/ ram_poke(0x0001, 0x00);
-      /*$6550*/ FUNC_SETCOL(0xfffe);
+      /*$6550*/ FUNC_SETCOL(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 167;
       break;
     case 167:  // $6553
       /*$6553*/ CYCLES(0x6553, 23);
       /*$6556*/ ram_poke(0x0002, ram_peek(0x6633));
       /*$655B*/ ram_poke(0x0003, ram_peek(0x6634));
-      /*$655D*/ func_60e4(0xfffe);
+      /*$655D*/ func_60e4(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 168;
       break;
     case 168:  // $6560
@@ -3827,12 +3861,12 @@ void func_t001(uint16_t ret_addr) {
       /*$657D*/ ram_poke(0x6633, tmp1_U8);
       /*$6580*/ s_a = 0x03;
       /*$6582*/ ram_poke(0x0001, 0x03);
-      /*$6584*/ FUNC_SETCOL(0xfffe);
+      /*$6584*/ FUNC_SETCOL(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 172;
       break;
     case 172:  // $6587
       /*$6587*/ CYCLES(0x6587, 6);
-                func_60e4(0xfffe);
+                func_60e4(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 173;
       break;
     case 173:  // $658A
@@ -4364,7 +4398,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 261:  // $6B3D
       /*$6B3D*/ CYCLES(0x6b3d, 6);
-                func_6c4b(0xfffe);
+                func_6c4b(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 262;
       break;
     case 262:  // $6B40
@@ -4420,7 +4454,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 269:  // $6B93
       /*$6B93*/ CYCLES(0x6b93, 6);
-                func_6127(0xfffe);
+                func_6127(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 270;
       break;
     case 270:  // $6B96
@@ -4478,7 +4512,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 276:  // $6BDA
       /*$6BDA*/ CYCLES(0x6bda, 6);
-                func_60e4(0xfffe);
+                func_60e4(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 277;
       break;
     case 277:  // $6BDD
@@ -4488,7 +4522,7 @@ void func_t001(uint16_t ret_addr) {
     case 278:  // $6BE2
       /*$6BE2*/ CYCLES(0x6be2, 12);
       /*$6BE4*/ ram_poke(0x0000, 0x01);
-      /*$6BE6*/ func_6b93(0xfffe);
+      /*$6BE6*/ func_6b93(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 279;
       break;
     case 279:  // $6BE9
@@ -4877,7 +4911,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 341:  // $7028
       /*$7028*/ CYCLES(0x7028, 6);
-                FUNC_SETCOL(0x0000);
+                FUNC_SETCOL(0x0000); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = find_block_id_func_t001(0x7028, pop16() + 1);;
       break;
     case 342:  // $702B
@@ -4912,7 +4946,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 346:  // $7045
       /*$7045*/ CYCLES(0x7045, 6);
-                func_702b(0xfffe);
+                func_702b(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 347;
       break;
     case 347:  // $7048
@@ -4949,7 +4983,7 @@ void func_t001(uint16_t ret_addr) {
       /*$706E*/ ram_poke(0x0003, 0x27);
       /*$7070*/ s_status_not_z = 0x00;
                 s_a = 0x00;
-      /*$7072*/ func_7024(0xfffe);
+      /*$7072*/ func_7024(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 352;
       break;
     case 352:  // $7075
@@ -4972,7 +5006,7 @@ void func_t001(uint16_t ret_addr) {
       /*$708C*/ s_status_not_z = 0x0d;
                 s_a = 0x0d;
       /*$708E*/ ram_poke(0x0001, 0x0d);
-      /*$7090*/ func_7024(0xfffe);
+      /*$7090*/ func_7024(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 355;
       break;
     case 355:  // $7093
@@ -5068,7 +5102,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 370:  // $7121
       /*$7121*/ CYCLES(0x7121, 6);
-                func_7019(0xfffe);
+                func_7019(0xfffe); if (s_native_depth <= depth) return;
       /*$7124*/ CYCLES(0x7124, 7);
       /*$7126*/ branchTarget = true; block_id = !(s_a != 0x2a) ? 369 : 371;
       break;
@@ -5078,7 +5112,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 372:  // $712B
       /*$712B*/ CYCLES(0x712b, 6);
-                func_7019(0xfffe);
+                func_7019(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 373;
       break;
     case 373:  // $712E
@@ -5096,22 +5130,22 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 376:  // $713E
       /*$713E*/ CYCLES(0x713e, 6);
-                func_7019(0xfffe);
+                func_7019(0xfffe); if (s_native_depth <= depth) return;
       /*$7141*/ CYCLES(0x7141, 9);
                 ram_poke(0x0001, s_a);
-      /*$7143*/ func_7019(0xfffe);
+      /*$7143*/ func_7019(0xfffe); if (s_native_depth <= depth) return;
       /*$7146*/ CYCLES(0x7146, 9);
                 ram_poke(0x0002, s_a);
-      /*$7148*/ func_7019(0xfffe);
+      /*$7148*/ func_7019(0xfffe); if (s_native_depth <= depth) return;
       /*$714B*/ CYCLES(0x714b, 9);
                 ram_poke(0x0008, s_a);
-      /*$714D*/ func_7019(0xfffe);
+      /*$714D*/ func_7019(0xfffe); if (s_native_depth <= depth) return;
       /*$7150*/ CYCLES(0x7150, 12);
                 ram_poke(0x0003, s_a);
       /*$7152*/ tmp1_U8 = ram_peek(0x0001);
                 s_status_not_z = tmp1_U8;
                 s_a = tmp1_U8;
-      /*$7154*/ func_7024(0xfffe);
+      /*$7154*/ func_7024(0xfffe); if (s_native_depth <= depth) return;
       /*$7157*/ CYCLES(0x7157, 19);
       /*$7159*/ ram_poke(0x002c, ram_peek(0x0008));
       /*$715B*/ s_a = ram_peek(0x0003);
@@ -5132,22 +5166,22 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 380:  // $716C
       /*$716C*/ CYCLES(0x716c, 6);
-                func_7019(0xfffe);
+                func_7019(0xfffe); if (s_native_depth <= depth) return;
       /*$716F*/ CYCLES(0x716f, 9);
                 ram_poke(0x0001, s_a);
-      /*$7171*/ func_7019(0xfffe);
+      /*$7171*/ func_7019(0xfffe); if (s_native_depth <= depth) return;
       /*$7174*/ CYCLES(0x7174, 9);
                 ram_poke(0x0003, s_a);
-      /*$7176*/ func_7019(0xfffe);
+      /*$7176*/ func_7019(0xfffe); if (s_native_depth <= depth) return;
       /*$7179*/ CYCLES(0x7179, 9);
                 ram_poke(0x0008, s_a);
-      /*$717B*/ func_7019(0xfffe);
+      /*$717B*/ func_7019(0xfffe); if (s_native_depth <= depth) return;
       /*$717E*/ CYCLES(0x717e, 12);
                 ram_poke(0x0002, s_a);
       /*$7180*/ tmp1_U8 = ram_peek(0x0001);
                 s_status_not_z = tmp1_U8;
                 s_a = tmp1_U8;
-      /*$7182*/ func_7024(0xfffe);
+      /*$7182*/ func_7024(0xfffe); if (s_native_depth <= depth) return;
       /*$7185*/ CYCLES(0x7185, 6);
                 branchTarget = true; push16(0x7187); block_id = 331;
       break;
@@ -5165,19 +5199,19 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 384:  // $7192
       /*$7192*/ CYCLES(0x7192, 6);
-                func_7019(0xfffe);
+                func_7019(0xfffe); if (s_native_depth <= depth) return;
       /*$7195*/ CYCLES(0x7195, 9);
                 ram_poke(0x0001, s_a);
-      /*$7197*/ func_7019(0xfffe);
+      /*$7197*/ func_7019(0xfffe); if (s_native_depth <= depth) return;
       /*$719A*/ CYCLES(0x719a, 9);
                 ram_poke(0x0002, s_a);
-      /*$719C*/ func_7019(0xfffe);
+      /*$719C*/ func_7019(0xfffe); if (s_native_depth <= depth) return;
       /*$719F*/ CYCLES(0x719f, 12);
                 ram_poke(0x0003, s_a);
       /*$71A1*/ tmp1_U8 = ram_peek(0x0001);
                 s_status_not_z = tmp1_U8;
                 s_a = tmp1_U8;
-      /*$71A3*/ func_7024(0xfffe);
+      /*$71A3*/ func_7024(0xfffe); if (s_native_depth <= depth) return;
       /*$71A6*/ CYCLES(0x71a6, 12);
                 s_a = ram_peek(0x0003);
       /*$71A8*/ s_y = ram_peek(0x0002);
@@ -5185,7 +5219,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 385:  // $71AD
       /*$71AD*/ CYCLES(0x71ad, 6);
-                func_60e4(0xfffe);
+                func_60e4(0xfffe); if (s_native_depth <= depth) return;
       /*$71B0*/ CYCLES(0x71b0, 6);
                 branchTarget = true; block_id = 372;
       break;
@@ -5195,7 +5229,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 387:  // $71B7
       /*$71B7*/ CYCLES(0x71b7, 6);
-                func_7019(0xfffe);
+                func_7019(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 388;
       break;
     case 388:  // $71BA
@@ -6009,10 +6043,10 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 522:  // $747F
       /*$747F*/ CYCLES(0x747f, 6);
-                func_702b(0xfffe);
+                func_702b(0xfffe); if (s_native_depth <= depth) return;
       /*$7482*/ CYCLES(0x7482, 11);
                 tmp1_U8 = io_peek(0xc052);
-      /*$7485*/ func_6641(0xfffe);
+      /*$7485*/ func_6641(0xfffe); if (s_native_depth <= depth) return;
       /*$7488*/ CYCLES(0x7488, 12);
                 s_a = 0x01;
       /*$748A*/ ram_poke(0x0025, 0x01);
@@ -6045,19 +6079,19 @@ void func_t001(uint16_t ret_addr) {
     case 526:  // $763A
       /*$763A*/ ram_poke(0x725e, s_a);
       /*$763D*/ s_status_d = 0x00;
-      /*$763E*/ func_64a9(0xfffe);
+      /*$763E*/ func_64a9(0xfffe); if (s_native_depth <= depth) return;
       /*$7641*/ CYCLES(0x7641, 2);
                 branchTarget = true; block_id = find_block_id_func_t001(0x7641, pop16() + 1);;
       break;
     case 527:  // $7642
       /*$7642*/ CYCLES(0x7642, 6);
-                func_6c4b(0xfffe);
+                func_6c4b(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 528;
       break;
     case 528:  // $7645
       /*$7645*/ CYCLES(0x7645, 9);
                 ram_poke(0x0002, s_a);
-      /*$7647*/ func_6c4b(0xfffe);
+      /*$7647*/ func_6c4b(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 529;
       break;
     case 529:  // $764A
@@ -6076,7 +6110,7 @@ void func_t001(uint16_t ret_addr) {
     case 531:  // $7655
       /*$7655*/ CYCLES(0x7655, 9);
                 s_a = 0x0f;
-      /*$7657*/ FUNC_SETCOL(0xfffe);
+      /*$7657*/ FUNC_SETCOL(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 532;
       break;
     case 532:  // $765A
@@ -6089,7 +6123,7 @@ void func_t001(uint16_t ret_addr) {
       /*$7661*/ CYCLES(0x7661, 19);
       /*$7663*/ ram_poke(0x0000, 0x01);
       /*$7667*/ ram_poke(0x0001, 0x09);
-      /*$7669*/ func_60e4(0xfffe);
+      /*$7669*/ func_60e4(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 534;
       break;
     case 534:  // $766C
@@ -6143,7 +6177,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 541:  // $7694
       /*$7694*/ CYCLES(0x7694, 6);
-                func_728d(0xfffe);
+                func_728d(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 542;
       break;
     case 542:  // $7697
@@ -6182,7 +6216,7 @@ void func_t001(uint16_t ret_addr) {
     case 546:  // $76E4
       /*$76E4*/ CYCLES(0x76e4, 16);
       /*$76E7*/ ram_poke(0x7266, ram_peek(0x0304));
-      /*$76EA*/ func_71cd(0xfffe);
+      /*$76EA*/ func_71cd(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 547;
       break;
     case 547:  // $76ED
@@ -6193,7 +6227,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 548:  // $76F6
       /*$76F6*/ CYCLES(0x76f6, 6);
-                func_60e4(0xfffe);
+                func_60e4(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 549;
       break;
     case 549:  // $76F9
@@ -6375,7 +6409,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 582:  // $7784
       /*$7784*/ CYCLES(0x7784, 6);
-                func_7267(0xfffe);
+                func_7267(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 583;
       break;
     case 583:  // $7787
@@ -6421,11 +6455,11 @@ void func_t001(uint16_t ret_addr) {
       /*$77B1*/ CYCLES(0x77b1, 19);
       /*$77B3*/ ram_poke(0x0001, 0x00);
       /*$77B7*/ ram_poke(0x0002, 0x14);
-      /*$77B9*/ func_60e4(0xfffe);
+      /*$77B9*/ func_60e4(0xfffe); if (s_native_depth <= depth) return;
       /*$77BC*/ CYCLES(0x77bc, 18);
       /*$77BE*/ ram_poke(0x7266, 0xff);
       /*$77C1*/ s_a = 0x00;
-      /*$77C3*/ FUNC_SETCOL(0xfffe);
+      /*$77C3*/ FUNC_SETCOL(0xfffe); if (s_native_depth <= depth) return;
       /*$77C6*/ CYCLES(0x77c6, 12);
                 s_a = 0x00;
       /*$77C8*/ s_y = 0x14;
@@ -6479,7 +6513,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 601:  // $7803
       /*$7803*/ CYCLES(0x7803, 6);
-                func_7633(0xfffe);
+                func_7633(0xfffe); if (s_native_depth <= depth) return;
       /*$7806*/ CYCLES(0x7806, 6);
                 branchTarget = true; block_id = 543;
       break;
@@ -6688,9 +6722,9 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 641:  // $78C4
       /*$78C4*/ ram_poke(0x78b1, s_a);
-      /*$78C8*/ func_7267(0xfffe);
+      /*$78C8*/ func_7267(0xfffe); if (s_native_depth <= depth) return;
       /*$78CB*/ CYCLES(0x78cb, 6);
-                func_7267(0xfffe);
+                func_7267(0xfffe); if (s_native_depth <= depth) return;
       /*$78CE*/ CYCLES(0x78ce, 6);
                 branchTarget = true; push16(0x78d0); block_id = 450;
       break;
@@ -6751,7 +6785,7 @@ void func_t001(uint16_t ret_addr) {
       /*$7937*/ CYCLES(0x7937, 19);
       /*$7939*/ ram_poke(0x0024, 0x0f);
       /*$793D*/ ram_poke(0x0025, 0x09);
-      /*$793F*/ func_6641(0xfffe);
+      /*$793F*/ func_6641(0xfffe); if (s_native_depth <= depth) return;
       /*$7942*/ CYCLES(0x7942, 6);
                 branchTarget = true; push16(0x7944); block_id = 421;
       break;
@@ -6792,7 +6826,7 @@ void func_t001(uint16_t ret_addr) {
       /*$D396*/ CYCLES(0xd396, 7);
                 ram_poke(0x006d, s_a);
       /*$D398*/ ram_poke(0x006e, s_y);
-                FUNC_MVBLKUP2(0x0000);
+                FUNC_MVBLKUP2(0x0000); if (s_native_depth <= depth) return;
                 block_id = find_block_id_func_t001(0xd398, pop16() + 1);;
       break;
     case 658:  // $D39A
@@ -7179,7 +7213,7 @@ void func_t001(uint16_t ret_addr) {
     case 719:  // $D46A
       /*$D46A*/ CYCLES(0xd46a, 9);
                 ram_poke(0x000f, s_y);
-      /*$D46C*/ FUNC_FNDLIN(0xfffe);
+      /*$D46C*/ FUNC_FNDLIN(0xfffe); if (s_native_depth <= depth) return;
       /*$D46F*/ CYCLES(0xd46f, 4);
                 branchTarget = true; block_id = !s_status_c ? 744 : 720;
       break;
@@ -7836,7 +7870,7 @@ void func_t001(uint16_t ret_addr) {
       /*$D61A*/ CYCLES(0xd61a, 7);
                 s_a = ram_peek(0x0067);
       /*$D61C*/ s_x = ram_peek(0x0068);
-                FUNC_FNDLIN2(0x0000);
+                FUNC_FNDLIN2(0x0000); if (s_native_depth <= depth) return;
                 block_id = find_block_id_func_t001(0xd61c, pop16() + 1);;
       break;
     case 825:  // $D61E
@@ -7955,7 +7989,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 841:  // $D665
       /*$D665*/ CYCLES(0xd665, 6);
-                FUNC_CLRTXTPTR(0xfffe);
+                FUNC_CLRTXTPTR(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 842;
       break;
     case 842:  // $D668
@@ -7969,7 +8003,7 @@ void func_t001(uint16_t ret_addr) {
       /*$D67A*/ ram_poke(0x006c, tmp5_U8);
       /*$D67C*/ ram_poke(0x006d, tmp2_U8);
       /*$D67E*/ ram_poke(0x006e, tmp5_U8);
-      /*$D680*/ FUNC_RESTORE(0xfffe);
+      /*$D680*/ FUNC_RESTORE(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 843;
       break;
     case 843:  // $D683
@@ -8397,7 +8431,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 911:  // $D959
       /*$D959*/ CYCLES(0xd959, 6);
-                FUNC_FNDLIN2(0xfffe);
+                FUNC_FNDLIN2(0xfffe); if (s_native_depth <= depth) return;
       /*$D95C*/ CYCLES(0xd95c, 4);
                 branchTarget = true; block_id = !s_status_c ? 919 : 912;
       break;
@@ -8809,7 +8843,7 @@ void func_t001(uint16_t ret_addr) {
       /*$DAB7*/ CYCLES(0xdab7, 12);
                 ram_poke(0x008c, s_a);
       /*$DAB9*/ ram_poke(0x008d, s_y);
-      /*$DABB*/ FUNC_FRETMS(0xfffe);
+      /*$DABB*/ FUNC_FRETMS(0xfffe); if (s_native_depth <= depth) return;
       /*$DABE*/ CYCLES(0xdabe, 29);
       /*$DAC0*/ tmp2_U8 = peek(ram_peek16al(0x008c));
       /*$DAC2*/ poke(ram_peek16(0x0085), tmp2_U8);
@@ -9349,7 +9383,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 1062:  // $DE6C
       /*$DE6C*/ CYCLES(0xde6c, 6);
-                FUNC_ISLETC(0xfffe);
+                FUNC_ISLETC(0xfffe); if (s_native_depth <= depth) return;
       /*$DE6F*/ CYCLES(0xde6f, 4);
                 branchTarget = true; block_id = s_status_c ? 1093 : 1063;
       break;
@@ -9560,7 +9594,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 1098:  // $DEF6
       /*$DEF6*/ CYCLES(0xdef6, 6);
-                FUNC_UPAY2FAC(0x0000);
+                FUNC_UPAY2FAC(0x0000); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = find_block_id_func_t001(0xdef6, pop16() + 1);;
       break;
     case 1099:  // $DEF9
@@ -9651,7 +9685,7 @@ void func_t001(uint16_t ret_addr) {
       /*$DF44*/ tmp2_U8 = peek((0xcfdd + tmp2_U8));
                 s_a = tmp2_U8;
       /*$DF47*/ ram_poke(0x0092, tmp2_U8);
-      /*$DF49*/ FUNC_BCC(0xfffe);
+      /*$DF49*/ FUNC_BCC(0xfffe); if (s_native_depth <= depth) return;
       /*$DF4C*/ CYCLES(0xdf4c, 6);
                 branchTarget = true; block_id = 995;
       break;
@@ -9672,7 +9706,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 1118:  // $DFEF
       /*$DFEF*/ CYCLES(0xdfef, 6);
-                FUNC_ISLETC(0xfffe);
+                FUNC_ISLETC(0xfffe); if (s_native_depth <= depth) return;
       /*$DFF2*/ CYCLES(0xdff2, 4);
                 branchTarget = true; block_id = s_status_c ? 1120 : 1119;
       break;
@@ -9694,7 +9728,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 1122:  // $E00C
       /*$E00C*/ CYCLES(0xe00c, 6);
-                FUNC_ISLETC(0xfffe);
+                FUNC_ISLETC(0xfffe); if (s_native_depth <= depth) return;
       /*$E00F*/ CYCLES(0xe00f, 4);
                 branchTarget = true; block_id = !s_status_c ? 1127 : 1123;
       break;
@@ -9713,7 +9747,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 1126:  // $E017
       /*$E017*/ CYCLES(0xe017, 6);
-                FUNC_ISLETC(0xfffe);
+                FUNC_ISLETC(0xfffe); if (s_native_depth <= depth) return;
       /*$E01A*/ CYCLES(0xe01a, 4);
                 branchTarget = true; block_id = s_status_c ? 1124 : 1127;
       break;
@@ -10117,7 +10151,7 @@ void func_t001(uint16_t ret_addr) {
       /*$E112*/ CYCLES(0xe112, 12);
                 s_a = 0xfe;
       /*$E114*/ s_y = 0xe0;
-      /*$E116*/ FUNC_FCOMP(0xfffe);
+      /*$E116*/ FUNC_FCOMP(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1191;
       break;
     case 1191:  // $E119
@@ -10126,7 +10160,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 1192:  // $E11B
       /*$E11B*/ CYCLES(0xe11b, 6);
-                FUNC_QINT(0x0000);
+                FUNC_QINT(0x0000); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = find_block_id_func_t001(0xe11b, pop16() + 1);;
       break;
     case 1193:  // $E122
@@ -10299,7 +10333,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 1217:  // $E1AA
       /*$E1AA*/ CYCLES(0xe1aa, 6);
-                FUNC_GETARY(0xfffe);
+                FUNC_GETARY(0xfffe); if (s_native_depth <= depth) return;
       /*$E1AD*/ CYCLES(0xe1ad, 14);
                 tmp5_U8 = ram_peek(0x000f);
       /*$E1AF*/ s_y = 0x04;
@@ -10322,7 +10356,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 1221:  // $E1C1
       /*$E1C1*/ CYCLES(0xe1c1, 6);
-                FUNC_GETARY(0xfffe);
+                FUNC_GETARY(0xfffe); if (s_native_depth <= depth) return;
       /*$E1C4*/ CYCLES(0xe1c4, 6);
                 branchTarget = true; push16(0xe1c6); block_id = 686;
       break;
@@ -11274,7 +11308,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 1357:  // $E4A4
       /*$E4A4*/ CYCLES(0xe4a4, 6);
-                FUNC_CHKVAR(0xfffe);
+                FUNC_CHKVAR(0xfffe); if (s_native_depth <= depth) return;
       /*$E4A7*/ CYCLES(0xe4a7, 4);
                 branchTarget = true; block_id = !s_status_not_z ? 1356 : 1358;
       break;
@@ -11299,7 +11333,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 1361:  // $E4BD
       /*$E4BD*/ CYCLES(0xe4bd, 6);
-                FUNC_CHKSMPLVAR(0xfffe);
+                FUNC_CHKSMPLVAR(0xfffe); if (s_native_depth <= depth) return;
       /*$E4C0*/ CYCLES(0xe4c0, 4);
                 branchTarget = true; block_id = !s_status_not_z ? 1359 : 1362;
       break;
@@ -11455,7 +11489,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 1386:  // $E514
       /*$E514*/ CYCLES(0xe514, 6);
-                FUNC_CHKVAR(0xfffe);
+                FUNC_CHKVAR(0xfffe); if (s_native_depth <= depth) return;
       /*$E517*/ CYCLES(0xe517, 4);
                 branchTarget = true; block_id = !s_status_not_z ? 1384 : 2099;
       break;
@@ -11474,7 +11508,7 @@ void func_t001(uint16_t ret_addr) {
     case 1389:  // $E522
       /*$E522*/ CYCLES(0xe522, 2);
                 s_y = (uint8_t)(s_y + 0x01);
-                FUNC_CHKVAR(0x0000);
+                FUNC_CHKVAR(0x0000); if (s_native_depth <= depth) return;
                 block_id = find_block_id_func_t001(0xe522, pop16() + 1);;
       break;
     case 1390:  // $E523
@@ -11608,7 +11642,7 @@ void func_t001(uint16_t ret_addr) {
       /*$E578*/ ram_poke(0x0097, s_a);
       /*$E57E*/ ram_poke(0x0094, ram_peek(0x006f));
       /*$E580*/ ram_poke(0x0095, ram_peek(0x0070));
-      /*$E582*/ FUNC_MVBLKUP2(0xfffe);
+      /*$E582*/ FUNC_MVBLKUP2(0xfffe); if (s_native_depth <= depth) return;
       /*$E585*/ CYCLES(0xe585, 31);
                 tmp2_U8 = ram_peek(0x0091);
       /*$E588*/ tmp5_U8 = ram_peek(0x0094);
@@ -11791,7 +11825,7 @@ void func_t001(uint16_t ret_addr) {
       /*$E604*/ CYCLES(0xe604, 12);
                 ram_poke(0x005e, s_a);
       /*$E606*/ ram_poke(0x005f, s_y);
-      /*$E608*/ FUNC_FRETMS(0xfffe);
+      /*$E608*/ FUNC_FRETMS(0xfffe); if (s_native_depth <= depth) return;
       /*$E60B*/ CYCLES(0xe60b, 31);
                 push8((s_status_c | ((s_status_not_z == 0) << 1) | (s_status_i << 2) | (s_status_d << 3) | STATUS_B | (s_status_v << 6) | s_status_n));
       /*$E60E*/ tmp2_U8 = peek(ram_peek16al(0x005e));
@@ -11960,7 +11994,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 1460:  // $E758
       /*$E758*/ CYCLES(0xe758, 6);
-                FUNC_QINT(0xfffe);
+                FUNC_QINT(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1461;
       break;
     case 1461:  // $E75B
@@ -11987,7 +12021,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 1464:  // $E7B9
       /*$E7B9*/ CYCLES(0xe7b9, 6);
-                FUNC_SHFTRGHT(0xfffe);
+                FUNC_SHFTRGHT(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1465;
       break;
     case 1465:  // $E7BC
@@ -11996,7 +12030,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 1466:  // $E7BE
       /*$E7BE*/ CYCLES(0xe7be, 6);
-                FUNC_UPAY2ARG(0xfffe);
+                FUNC_UPAY2ARG(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1467;
       break;
     case 1467:  // $E7C1
@@ -12103,7 +12137,7 @@ void func_t001(uint16_t ret_addr) {
                 tmp1_U8 = ram_peek(tmp6_U16);
                 s_status_c = (tmp1_U8 & 0x01);
                 ram_poke(tmp6_U16, (tmp1_U8 >> 0x01));
-      /*$E7F7*/ FUNC_SHFTRGHT4(0xfffe);
+      /*$E7F7*/ FUNC_SHFTRGHT4(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1483;
       break;
     case 1483:  // $E7FA
@@ -12216,7 +12250,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 1503:  // $E82B
       /*$E82B*/ CYCLES(0xe82b, 6);
-                FUNC_TWSCMPFAC(0xfffe);
+                FUNC_TWSCMPFAC(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1504;
       break;
     case 1504:  // $E82E
@@ -12495,7 +12529,7 @@ void func_t001(uint16_t ret_addr) {
     case 1545:  // $E89E
       /*$E89E*/ CYCLES(0xe89e, 11);
       /*$E8A2*/ ram_poke(0x00a2, (ram_peek(0x00a2) ^ 0xff));
-                FUNC_TCFACMANT(0x0000);
+                FUNC_TCFACMANT(0x0000); if (s_native_depth <= depth) return;
                 block_id = find_block_id_func_t001(0xe8a2, pop16() + 1);;
       break;
     case 1546:  // $E8A4
@@ -12666,7 +12700,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 1566:  // $E97F
       /*$E97F*/ CYCLES(0xe97f, 6);
-                FUNC_UPAY2ARG(0xfffe);
+                FUNC_UPAY2ARG(0xfffe); if (s_native_depth <= depth) return;
       /*$E982*/ CYCLES(0xe982, 4);
                 branchTarget = true; block_id = s_status_not_z ? 1568 : 1567;
       break;
@@ -12687,25 +12721,25 @@ void func_t001(uint16_t ret_addr) {
       /*$E994*/ tmp1_U8 = ram_peek(0x00ac);
                 s_status_not_z = tmp1_U8;
                 s_a = tmp1_U8;
-      /*$E996*/ FUNC_MULT1(0xfffe);
+      /*$E996*/ FUNC_MULT1(0xfffe); if (s_native_depth <= depth) return;
       /*$E999*/ CYCLES(0xe999, 9);
                 tmp1_U8 = ram_peek(0x00a1);
                 s_status_not_z = tmp1_U8;
                 s_a = tmp1_U8;
-      /*$E99B*/ FUNC_MULT1(0xfffe);
+      /*$E99B*/ FUNC_MULT1(0xfffe); if (s_native_depth <= depth) return;
       /*$E99E*/ CYCLES(0xe99e, 9);
                 tmp1_U8 = ram_peek(0x00a0);
                 s_status_not_z = tmp1_U8;
                 s_a = tmp1_U8;
-      /*$E9A0*/ FUNC_MULT1(0xfffe);
+      /*$E9A0*/ FUNC_MULT1(0xfffe); if (s_native_depth <= depth) return;
       /*$E9A3*/ CYCLES(0xe9a3, 9);
                 tmp1_U8 = ram_peek(0x009f);
                 s_status_not_z = tmp1_U8;
                 s_a = tmp1_U8;
-      /*$E9A5*/ FUNC_MULT1(0xfffe);
+      /*$E9A5*/ FUNC_MULT1(0xfffe); if (s_native_depth <= depth) return;
       /*$E9A8*/ CYCLES(0xe9a8, 9);
                 s_a = ram_peek(0x009e);
-      /*$E9AA*/ FUNC_MULT2(0xfffe);
+      /*$E9AA*/ FUNC_MULT2(0xfffe); if (s_native_depth <= depth) return;
       /*$E9AD*/ CYCLES(0xe9ad, 6);
                 branchTarget = true; block_id = 1652;
       break;
@@ -13018,7 +13052,7 @@ void func_t001(uint16_t ret_addr) {
       /*$EA5A*/ s_y = 0xea;
       /*$EA5C*/ s_x = 0x00;
       /*$EA5E*/ ram_poke(0x00ab, 0x00);
-      /*$EA60*/ FUNC_UPAY2FAC(0xfffe);
+      /*$EA60*/ FUNC_UPAY2FAC(0xfffe); if (s_native_depth <= depth) return;
       /*$EA63*/ CYCLES(0xea63, 6);
       /*$EA69*/ CYCLES(0xea69, 4);
                 branchTarget = true; block_id = !s_status_not_z ? 1651 : 1617;
@@ -13380,7 +13414,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 1665:  // $EB7A
       /*$EB7A*/ CYCLES(0xeb7a, 6);
-                FUNC_INCFACMAN(0xfffe);
+                FUNC_INCFACMAN(0xfffe); if (s_native_depth <= depth) return;
       /*$EB7D*/ CYCLES(0xeb7d, 4);
                 branchTarget = true; block_id = s_status_not_z ? 1662 : 1666;
       break;
@@ -13565,7 +13599,7 @@ void func_t001(uint16_t ret_addr) {
       /*$EBFD*/ CYCLES(0xebfd, 14);
                 tmp1_U8 = s_a;
       /*$EC00*/ ram_poke(0x00a4, 0xff);
-      /*$EC02*/ FUNC_TCFACMANT(0xfffe);
+      /*$EC02*/ FUNC_TCFACMANT(0xfffe); if (s_native_depth <= depth) return;
       /*$EC05*/ CYCLES(0xec05, 2);
                 s_a = tmp1_U8;
                 block_id = 1694;
@@ -13579,7 +13613,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 1695:  // $EC0C
       /*$EC0C*/ CYCLES(0xec0c, 6);
-                FUNC_SHFTRGHT(0xfffe);
+                FUNC_SHFTRGHT(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1696;
       break;
     case 1696:  // $EC0F
@@ -13600,7 +13634,7 @@ void func_t001(uint16_t ret_addr) {
       /*$EC19*/ tmp1_U8 = (ram_peek(0x00a2) & 0x80) | ram_peek(0x009e);
                 s_a = tmp1_U8;
       /*$EC1B*/ ram_poke(0x009e, tmp1_U8);
-      /*$EC1D*/ FUNC_SHFTRGHT4(0xfffe);
+      /*$EC1D*/ FUNC_SHFTRGHT4(0xfffe); if (s_native_depth <= depth) return;
       /*$EC20*/ CYCLES(0xec20, 6);
                 ram_poke(0x00a4, s_y);
       /*$EC22*/ branchTarget = true; block_id = find_block_id_func_t001(0xec22, pop16() + 1);;
@@ -14069,7 +14103,7 @@ void func_t001(uint16_t ret_addr) {
       /*$ED62*/ CYCLES(0xed62, 12);
                 s_a = 0x0f;
       /*$ED64*/ s_y = 0xed;
-      /*$ED66*/ FUNC_FCOMP(0xfffe);
+      /*$ED66*/ FUNC_FCOMP(0xfffe); if (s_native_depth <= depth) return;
       /*$ED69*/ CYCLES(0xed69, 4);
                 branchTarget = true; block_id = !s_status_not_z ? 1787 : 1779;
       break;
@@ -14081,7 +14115,7 @@ void func_t001(uint16_t ret_addr) {
       /*$ED6D*/ CYCLES(0xed6d, 12);
                 s_a = 0x0a;
       /*$ED6F*/ s_y = 0xed;
-      /*$ED71*/ FUNC_FCOMP(0xfffe);
+      /*$ED71*/ FUNC_FCOMP(0xfffe); if (s_native_depth <= depth) return;
       /*$ED74*/ CYCLES(0xed74, 4);
                 branchTarget = true; block_id = !s_status_not_z ? 1782 : 1781;
       break;
@@ -14115,7 +14149,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 1787:  // $ED89
       /*$ED89*/ CYCLES(0xed89, 6);
-                FUNC_QINT(0xfffe);
+                FUNC_QINT(0xfffe); if (s_native_depth <= depth) return;
       /*$ED8C*/ CYCLES(0xed8c, 16);
                 s_x = 0x01;
       /*$ED8E*/ s_a = ram_peek(0x0099);
@@ -14716,7 +14750,7 @@ void func_t001(uint16_t ret_addr) {
                 tmp1_U8 = tmp5_U8 >> 0x01;
                 s_a = tmp1_U8;
       /*$F801*/ push8(((tmp5_U8 & 0x01) | ((tmp1_U8 == 0) << 1) | (s_status_i << 2) | (s_status_d << 3) | STATUS_B | (s_status_v << 6) | (tmp1_U8 & 0x80)));
-      /*$F802*/ FUNC_GBASCALC(0xfffe);
+      /*$F802*/ FUNC_GBASCALC(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1884;
       break;
     case 1884:  // $F805
@@ -14754,7 +14788,7 @@ void func_t001(uint16_t ret_addr) {
     case 1888:  // $F80C
       /*$F80C*/ CYCLES(0xf80c, 4);
                 ram_poke(0x002e, s_a);
-                FUNC_PLOT1(0x0000);
+                FUNC_PLOT1(0x0000); if (s_native_depth <= depth) return;
                 block_id = find_block_id_func_t001(0xf80c, pop16() + 1);;
       break;
     case 1889:  // $F80C
@@ -14789,7 +14823,7 @@ void func_t001(uint16_t ret_addr) {
     case 1893:  // $F820
       /*$F820*/ CYCLES(0xf820, 7);
                 s_y = (uint8_t)(s_y + 0x01);
-      /*$F821*/ FUNC_PLOT1(0xfffe);
+      /*$F821*/ FUNC_PLOT1(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1894;
       break;
     case 1894:  // $F824
@@ -14924,7 +14958,7 @@ void func_t001(uint16_t ret_addr) {
                 tmp1_U8 = tmp5_U8 >> 0x01;
                 s_a = tmp1_U8;
       /*$F872*/ push8(((tmp5_U8 & 0x01) | ((tmp1_U8 == 0) << 1) | (s_status_i << 2) | (s_status_d << 3) | STATUS_B | (s_status_v << 6) | (tmp1_U8 & 0x80)));
-      /*$F873*/ FUNC_GBASCALC(0xfffe);
+      /*$F873*/ FUNC_GBASCALC(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1914;
       break;
     case 1914:  // $F876
@@ -14979,7 +15013,7 @@ void func_t001(uint16_t ret_addr) {
                 s_status_b = 0x00;
                 s_status_v = ((tmp2_U8 & 0x40) != 0);
                 s_status_n = (tmp2_U8 & 0x80);
-      /*$FA4D*/ FUNC_SAV1(0xfffe);
+      /*$FA4D*/ FUNC_SAV1(0xfffe); if (s_native_depth <= depth) return;
       /*$FA50*/ CYCLES(0xfa50, 16);
                 tmp2_U8 = pop8();
       /*$FA51*/ ram_poke(0x003a, tmp2_U8);
@@ -14992,17 +15026,17 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 1921:  // $FA66
       /*$FA66*/ CYCLES(0xfa66, 6);
-                FUNC_INIT(0xfffe);
+                FUNC_INIT(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1922;
       break;
     case 1922:  // $FA69
       /*$FA69*/ CYCLES(0xfa69, 6);
-                FUNC_SETVID(0xfffe);
+                FUNC_SETVID(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1923;
       break;
     case 1923:  // $FA6C
       /*$FA6C*/ CYCLES(0xfa6c, 6);
-                FUNC_SETKBD(0xfffe);
+                FUNC_SETKBD(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1924;
       break;
     case 1924:  // $FA6F
@@ -15053,7 +15087,7 @@ void func_t001(uint16_t ret_addr) {
       /*$F135*/ ram_poke(0x0002, 0xf1);
       /*$F137*/ ram_poke(0x0004, 0x28);
       /*$F139*/ ram_poke(0x0005, 0xf1);
-      /*$F13B*/ FUNC_NORMAL(0xfffe);
+      /*$F13B*/ FUNC_NORMAL(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1856;
       break;
     case 1929:  // $FAA3
@@ -15255,7 +15289,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 1962:  // $FBB3
       /*$FBB3*/ CYCLES(0xfbb3, 24);
-      /*$FBC0*/ FUNC_BASCALC(0x0000);
+      /*$FBC0*/ FUNC_BASCALC(0x0000); if (s_native_depth <= depth) return;
                 block_id = find_block_id_func_t001(0xfbc0, pop16() + 1);;
       break;
     case 1963:  // $FBC1
@@ -15417,12 +15451,12 @@ void func_t001(uint16_t ret_addr) {
     case 1986:  // $FC22
       /*$FC22*/ CYCLES(0xfc22, 4);
                 s_a = ram_peek(0x0025);
-                FUNC_VTABZ(0x0000);
+                FUNC_VTABZ(0x0000); if (s_native_depth <= depth) return;
                 block_id = find_block_id_func_t001(0xfc22, pop16() + 1);;
       break;
     case 1987:  // $FC24
       /*$FC24*/ CYCLES(0xfc24, 6);
-                FUNC_BASCALC(0xfffe);
+                FUNC_BASCALC(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 1988;
       break;
     case 1988:  // $FC27
@@ -15560,12 +15594,12 @@ void func_t001(uint16_t ret_addr) {
     case 2009:  // $FC46
       /*$FC46*/ CYCLES(0xfc46, 7);
                 push8(s_a);
-      /*$FC47*/ FUNC_VTABZ(0xfffe);
+      /*$FC47*/ FUNC_VTABZ(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 2010;
       break;
     case 2010:  // $FC4A
       /*$FC4A*/ CYCLES(0xfc4a, 6);
-                FUNC_CLREOLZ(0xfffe);
+                FUNC_CLREOLZ(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 2011;
       break;
     case 2011:  // $FC4D
@@ -15623,7 +15657,7 @@ void func_t001(uint16_t ret_addr) {
       /*$FC70*/ tmp2_U8 = ram_peek(0x0022);
                 s_a = tmp2_U8;
       /*$FC72*/ push8(tmp2_U8);
-      /*$FC73*/ FUNC_VTABZ(0xfffe);
+      /*$FC73*/ FUNC_VTABZ(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 2021;
       break;
     case 2021:  // $FC76
@@ -15654,7 +15688,7 @@ void func_t001(uint16_t ret_addr) {
     case 2025:  // $FC88
       /*$FC88*/ CYCLES(0xfc88, 7);
                 push8(s_a);
-      /*$FC89*/ FUNC_VTABZ(0xfffe);
+      /*$FC89*/ FUNC_VTABZ(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 2026;
       break;
     case 2026:  // $FC8C
@@ -15675,14 +15709,14 @@ void func_t001(uint16_t ret_addr) {
     case 2028:  // $FC95
       /*$FC95*/ CYCLES(0xfc95, 9);
                 s_y = 0x00;
-      /*$FC97*/ FUNC_CLREOLZ(0xfffe);
+      /*$FC97*/ FUNC_CLREOLZ(0xfffe); if (s_native_depth <= depth) return;
       /*$FC9A*/ CYCLES(0xfc9a, 4);
                 branchTarget = true; block_id = s_status_c ? 1986 : 2104;
       break;
     case 2029:  // $FC9C
       /*$FC9C*/ CYCLES(0xfc9c, 4);
                 s_y = ram_peek(0x0024);
-                FUNC_CLREOLZ(0x0000);
+                FUNC_CLREOLZ(0x0000); if (s_native_depth <= depth) return;
                 block_id = find_block_id_func_t001(0xfc9c, pop16() + 1);;
       break;
     case 2030:  // $FC9E
@@ -15947,7 +15981,7 @@ void func_t001(uint16_t ret_addr) {
       break;
     case 2072:  // $FD8B
       /*$FD8B*/ CYCLES(0xfd8b, 6);
-                FUNC_CLREOL(0xfffe);
+                FUNC_CLREOL(0xfffe); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = 2073;
       break;
     case 2073:  // $FD8E
@@ -16131,31 +16165,31 @@ void func_t001(uint16_t ret_addr) {
       /*$FF58*/ branchTarget = true; block_id = find_block_id_func_t001(0xff58, pop16() + 1);;
       break;
     case 2098:
-      /*$E07B*/ FUNC_ISLETC(0x0000);
+      /*$E07B*/ FUNC_ISLETC(0x0000); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = find_block_id_func_t001(0xe07b, pop16() + 1);;
       break;
     case 2099:
-      /*$E517*/ FUNC_CHKSMPLVAR(0x0000);
+      /*$E517*/ FUNC_CHKSMPLVAR(0x0000); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = find_block_id_func_t001(0xe517, pop16() + 1);;
       break;
     case 2100:
-      /*$E8C4*/ FUNC_INCFACMAN(0x0000);
+      /*$E8C4*/ FUNC_INCFACMAN(0x0000); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = find_block_id_func_t001(0xe8c4, pop16() + 1);;
       break;
     case 2101:
-      /*$E9B0*/ FUNC_MULT2(0x0000);
+      /*$E9B0*/ FUNC_MULT2(0x0000); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = find_block_id_func_t001(0xe9b0, pop16() + 1);;
       break;
     case 2102:
-      /*$FC6C*/ FUNC_VTABZ(0x0000);
+      /*$FC6C*/ FUNC_VTABZ(0x0000); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = find_block_id_func_t001(0xfc6c, pop16() + 1);;
       break;
     case 2103:
-      /*$FC3E*/ FUNC_CLREOL(0x0000);
+      /*$FC3E*/ FUNC_CLREOL(0x0000); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = find_block_id_func_t001(0xfc3e, pop16() + 1);;
       break;
     case 2104:
-      /*$FC9A*/ FUNC_CLREOL(0x0000);
+      /*$FC9A*/ FUNC_CLREOL(0x0000); if (s_native_depth <= depth) return;
                 branchTarget = true; block_id = find_block_id_func_t001(0xfc9a, pop16() + 1);;
       break;
     case 2105:  // $10100
@@ -16173,6 +16207,8 @@ void func_t001(uint16_t ret_addr) {
                 s_a = tmp2_U8;
       /*$FA47*/ branchTarget = true; block_id = tmp1_U8 ? 1920 : 1919;
       break;
+    case UNWIND_BLOCK_ID:
+      return;
     default:
       fprintf(stderr, "panic: unknown block_id: %u\n", block_id);
       abort();
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) Tzvetan Mikov.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include "apple2tc/a2io.h"
+
+#include <stdio.h>
+
+/// Screen capture into a compact delta-compressed container.
+///
+/// File format (all integers are little endian):
+///   Header:
+///     char magic[8]    "A2CAP\x1A\x01\x00"
+///     u16 width, height
+///     u8 palette[16][3] RGB
+///   Followed by frames until EOF:
+///     u32 ms           time of the frame in milliseconds
+///     u8 changed[height / 8]
+///                      bitmap of scanlines which differ from the previous
+///                      frame, LSB first.
+///     For every changed scanline, the XOR of the pixels with the previous
+///     frame encoded as a sequence of tokens, until the line is complete:
+///       0x00..0x7F     (token + 1) unchanged pixels.
+///       0x80..0xFF     (token - 0x7F) XOR values follow.
+///
+/// The first frame is encoded against an all-black frame.
+
+#define A2_CAPTURE_MAGIC "A2CAP\x1A\x01\x00"
+/// Number of frames which can be waiting to be encoded. Frames arriving when
+/// the queue is full are dropped.
+#define A2_CAPTURE_QUEUE_SIZE 8
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct a2_capture a2_capture_t;
+
+/// Create the capture file and start the encoder thread. Returns NULL on error.
+a2_capture_t *a2_capture_open(const char *path);
+
+/// Queue a frame for encoding. Never blocks. Returns false if the frame had to
+/// be dropped because the encoder is falling behind.
+/// \param ms - time of the frame in milliseconds.
+bool a2_capture_frame(a2_capture_t *cap, const a2_screen8 *screen, uint32_t ms);
+
+/// Encode the remaining frames, stop the encoder thread and close the file.
+/// Returns false if there were any errors or dropped frames.
+bool a2_capture_close(a2_capture_t *cap);
+
+/// Reads a capture file frame by frame.
+typedef struct {
+  FILE *f;
+  unsigned width, height;
+  a2_rgba8 palette[16];
+  /// Time of the current frame.
+  uint32_t ms;
+  /// The current frame.
+  a2_screen8 screen;
+  /// Set if a frame could not be decoded.
+  bool error;
+} a2_capture_reader_t;
+
+/// Open a capture file and read its header. Returns false if the file cannot
+/// be opened or is not a valid capture.
+bool a2_capture_reader_open(a2_capture_reader_t *rd, const char *path);
+/// Decode the next frame into `rd->screen`. Returns false at EOF or on a
+/// decoding error, in which case `rd->error` is set.
+bool a2_capture_reader_next(a2_capture_reader_t *rd);
+void a2_capture_reader_close(a2_capture_reader_t *rd);
+
+#ifdef __cplusplus
+}
+#endif
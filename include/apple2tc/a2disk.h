@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) Tzvetan Mikov.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/// A Disk II controller with two 5.25" drives, loading 140KB sector images.
+///
+/// The drives keep the disk as a sector image. A track is converted to the
+/// nibbles the drive reads (6-and-2 encoding, 16 sectors) only when the head
+/// first reads it, and is cached. Writes go to the cached nibbles, which are
+/// decoded back into the sector image only for tracks that were written.
+///
+/// The timing of the disk rotation isn't emulated: every read of the data
+/// latch returns the next nibble, so software waiting for data never spins.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define A2_DISK_TRACKS 35
+#define A2_DISK_SECTORS 16
+#define A2_DISK_SECTOR_SIZE 256
+#define A2_DISK_IMAGE_SIZE (A2_DISK_TRACKS * A2_DISK_SECTORS * A2_DISK_SECTOR_SIZE)
+/// The number of nibbles in a track.
+#define A2_DISK_TRACK_NIBBLES (48 + A2_DISK_SECTORS * 396)
+
+/// The 256 bytes of the boot PROM, which is mapped at $Cn00 in the slot of the
+/// controller.
+extern const uint8_t a2_disk_rom[256];
+
+/// The order of the sectors in the image file.
+typedef enum {
+  /// DOS 3.3 logical sectors (.dsk, .do).
+  A2_DISK_ORDER_DOS,
+  /// ProDOS blocks (.po).
+  A2_DISK_ORDER_PRODOS,
+} a2_disk_order_t;
+
+typedef struct {
+  /// The sector image, or NULL if the drive is empty.
+  uint8_t *image;
+  a2_disk_order_t order;
+  /// The image is saved here by a2_disk_flush(), unless it is write protected.
+  char *path;
+  bool write_protected;
+  /// The image has been modified since it was loaded or saved.
+  bool image_dirty;
+  /// The nibbles of the tracks which have been read, or NULL.
+  uint8_t *tracks[A2_DISK_TRACKS];
+  /// The cached tracks which have been written, and must be decoded into the
+  /// image.
+  bool track_dirty[A2_DISK_TRACKS];
+  /// The position of the head in half tracks.
+  unsigned half_track;
+  /// The position of the next nibble in the track.
+  unsigned pos;
+} a2_disk_drive_t;
+
+typedef struct a2_disk {
+  a2_disk_drive_t drives[2];
+  /// The selected drive, 0 or 1.
+  unsigned drive;
+  bool motor_on;
+  /// A bit for every stepper motor phase which is on.
+  uint8_t phases;
+  /// The Q6 and Q7 switches. Q7 selects write mode, Q6 loading the latch or
+  /// sensing the write protection.
+  bool q6, q7;
+  uint8_t latch;
+  /// The state of the random nibbles read from an empty drive.
+  uint32_t noise;
+} a2_disk_t;
+
+void a2_disk_init(a2_disk_t *disk);
+/// Flush and eject both drives.
+void a2_disk_done(a2_disk_t *disk);
+
+/// Load the image at \p path into \p drive (0 or 1), replacing the current
+/// disk. The order of the sectors is determined by the extension: .po is
+/// ProDOS, everything else DOS 3.3. If the file can't be opened for writing,
+/// the disk is write protected. Print an error and return false on error.
+bool a2_disk_load(a2_disk_t *disk, unsigned drive, const char *path);
+/// Flush and remove the disk from \p drive.
+void a2_disk_eject(a2_disk_t *disk, unsigned drive);
+/// Decode the written tracks into the sector images and save the modified
+/// images to their files. Print an error and return false on error.
+bool a2_disk_flush(a2_disk_t *disk);
+
+/// Access the soft switch at offset `addr & 0xF` in the IO range of the slot.
+/// \p write is true for a write of \p value. Return the value read.
+uint8_t a2_disk_io(a2_disk_t *disk, uint16_t addr, bool write, uint8_t value);
+
+/// Return true if the drive motor is on.
+static inline bool a2_disk_motor_on(const a2_disk_t *disk) {
+  return disk->motor_on;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) Tzvetan Mikov.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include "apple2tc/a2io.h"
+
+#include <stdio.h>
+
+/// Per-frame hashing of the displayed video memory, used to compare runs of the
+/// same program automatically.
+///
+/// The hash log is a text file. After the "a2hash 1" header line, it contains
+/// a line "<frame> <mode> <hash>" (decimal, hex, hex) for every frame where the
+/// video mode or the contents of the displayed video memory changed. The mode
+/// is the A2_VC_xxx bits.
+
+#define A2_HASH_LOG_HEADER "a2hash 1"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// A fast non-cryptographic 64-bit hash. The main loop processes 32 bytes in
+/// eight independent 32-bit lanes, which the compiler maps to SIMD registers.
+/// Note that the result depends on the byte order of the host.
+uint64_t a2_hash_bytes(const void *data, size_t len, uint64_t seed);
+
+/// Hash the video mode and the video memory currently displayed: the text page
+/// in text and GR modes, the HGR page (plus the text page in mixed mode) in HGR
+/// mode.
+uint64_t a2_hash_video(const a2_iostate_t *io, const uint8_t *ram);
+
+typedef struct {
+  FILE *f;
+  /// Number of the next frame.
+  unsigned frame;
+  /// Mode and hash of the last logged frame.
+  uint8_t last_mode;
+  uint64_t last_hash;
+} a2_hash_log_t;
+
+/// Create the log file. Returns false on error.
+bool a2_hash_log_open(a2_hash_log_t *log, const char *path);
+/// Record the state at the end of a frame.
+void a2_hash_log_frame(a2_hash_log_t *log, const a2_iostate_t *io, const uint8_t *ram);
+void a2_hash_log_close(a2_hash_log_t *log);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) Tzvetan Mikov.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/// Hybrid execution: code decompiled to simple C, built as a shared library
+/// with A2_HYBRID defined, runs natively inside the emulator. The emulator
+/// passes its state in a context and the module runs until the cycle budget
+/// is exhausted, or it reaches code below `native_start` or an address it
+/// doesn't cover, which is left to the emulator.
+
+#define A2_HYBRID_VERSION 1
+/// The name of the function returning the module descriptor.
+#define A2_HYBRID_ENTRY "a2_hybrid_module"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct a2_hybrid_ctx a2_hybrid_ctx_t;
+
+struct a2_hybrid_ctx {
+  uint16_t pc;
+  uint8_t a;
+  uint8_t x;
+  uint8_t y;
+  uint8_t status;
+  uint8_t sp;
+
+  unsigned cycles;
+  /// The cycle budget. The module returns once it is exhausted.
+  int remaining_cycles;
+  /// Blocks below this address are left to the emulator, since the RAM may no
+  /// longer contain the code which was decompiled.
+  unsigned native_start;
+
+  /// The 64KB memory of the emulator.
+  uint8_t *ram;
+  /// Pointers to the pages which can be written directly, or NULL if the
+  /// write must go through poke_slow().
+  uint8_t *const *write_pages;
+  /// Read from the IO range. `cycles` is up to date.
+  uint8_t (*io_peek)(a2_hybrid_ctx_t *ctx, uint16_t addr);
+  /// Write to a page without a direct write pointer: IO, ROM or a watched
+  /// page. `cycles` is up to date.
+  void (*poke_slow)(a2_hybrid_ctx_t *ctx, uint16_t addr, uint8_t value);
+  void *host;
+};
+
+typedef struct {
+  /// A2_HYBRID_VERSION.
+  unsigned version;
+  /// Run from `ctx->pc`. If it isn't covered by the module, return without
+  /// changing anything.
+  void (*run)(a2_hybrid_ctx_t *ctx);
+} a2_hybrid_module_t;
+
+typedef const a2_hybrid_module_t *(*a2_hybrid_entry_t)(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -7,10 +7,12 @@
 
 #pragma once
 
-#include "apple2tc/soundqueue.h"
+#include "apple2tc/a2metrics.h"
+#include "apple2tc/spsc.h"
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <stdio.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -25,68 +27,197 @@ void apple2_decode_text_screen(
 
 #define A2_SCREEN_W 280
 #define A2_SCREEN_H 192
-#define A2_SCREEN_W_POT 512
-#define A2_SCREEN_H_POT 256
 
 typedef struct a2_rgba8 {
   uint8_t r, g, b, a;
 } a2_rgba8;
 
-/// RGB encoding of the Apple2 screen.
+/// The 16 Apple2 colors, in GR order. HGR and text use a subset of them.
+enum {
+  A2_COLOR_BLACK = 0x0,
+  A2_COLOR_PURPLE = 0x3,
+  A2_COLOR_MEDIUM_BLUE = 0x6,
+  A2_COLOR_ORANGE = 0x9,
+  A2_COLOR_GREEN = 0xC,
+  A2_COLOR_WHITE = 0xF,
+};
+
+/// RGB values of the 16 color indices.
+extern const a2_rgba8 a2_palette[16];
+
+/// Indexed encoding of the Apple2 screen: one palette index per pixel, tightly
+/// packed. This is what the renderers produce.
+typedef struct a2_screen8 {
+  uint8_t data[A2_SCREEN_W * A2_SCREEN_H];
+} a2_screen8;
+
+/// RGB encoding of the Apple2 screen, tightly packed. Suitable for uploading
+/// into a texture.
 typedef struct a2_screen {
-  a2_rgba8 data[A2_SCREEN_W_POT * A2_SCREEN_H_POT];
+  a2_rgba8 data[A2_SCREEN_W * A2_SCREEN_H];
 } a2_screen;
 
-/// Render the text page pointed by pageStart into a RGB screen.
+/// A rectangle in screen pixels.
+typedef struct a2_rect {
+  unsigned x, y, w, h;
+} a2_rect;
+
+/// Convert the region \p rect of the indexed screen \p src to RGB.
+void a2_screen_from_indexed(a2_screen *dst, const a2_screen8 *src, a2_rect rect);
+
+/// How graphics modes are displayed.
+typedef enum {
+  /// Simple color approximation: four HGR colors plus black and white.
+  A2_RENDER_COLOR,
+  /// Monochrome monitor.
+  A2_RENDER_MONO,
+  /// NTSC artifact colors, including fringes at color transitions.
+  A2_RENDER_NTSC,
+} a2_render_mode_t;
+
+/// Render the text page pointed by pageStart into an indexed screen.
 /// \param ms - millisecond since hardware reset. This is used to determine the
 ///     blink phase.
-void apple2_render_text_screen(const uint8_t *pageStart, a2_screen *screen, uint64_t ms);
+void apple2_render_text_screen(const uint8_t *pageStart, a2_screen8 *screen, uint64_t ms);
 
-/// Render the lowres graphics (GR) page pointed by pageStart into a RGB screen.
+/// Render the lowres graphics (GR) page pointed by pageStart into an indexed screen.
 /// \param ms - millisecond since hardware reset. This is used to determine the
 ///     blink phase. Only needed if mixed == true.
-void apple2_render_gr_screen(const uint8_t *pageStart, a2_screen *screen, uint64_t ms, bool mixed);
+void apple2_render_gr_screen(const uint8_t *pageStart, a2_screen8 *screen, uint64_t ms, bool mixed);
 
-/// Render the hires graphics (GR) page pointed by pageStart into a RGB screen.
+/// Render the hires graphics (GR) page pointed by pageStart into an indexed screen.
 /// \param textPageStart - the start of the text page. Only used if mixed == true.
 /// \param ms - millisecond since hardware reset. This is used to determine the
 ///     blink phase. Only needed if mixed == true.
 void apple2_render_hgr_screen(
     const uint8_t *grPageStart,
     const uint8_t *textPageStart,
-    a2_screen *screen,
+    a2_screen8 *screen,
     uint64_t ms,
     bool mixed,
     bool mono);
 
+/// The emulation only records the cycles at which the speaker is toggled and
+/// how far it has run. The samples are synthesized in the sound callback.
+///
+/// Speaker toggles are converted to band-limited steps: every toggle adds a
+/// windowed sinc impulse, selected by the sub-sample phase of the toggle, to
+/// a short buffer of pending deltas, which are integrated into samples.
+/// Number of taps of the impulse. Must be a power of 2.
+#define A2_BLEP_TAPS 16
+/// Number of sub-sample phases of the impulse.
+#define A2_BLEP_PHASES 64
+/// If the emulation gets further ahead of the sound callback than this many
+/// samples, the oldest samples are dropped.
+#define A2_SOUND_MAX_LAG 8192
+/// The default latency the sound callback tries to maintain.
+#define A2_SOUND_DEFAULT_LATENCY_MS 40
+/// The maximum relative adjustment of the sample rate used to maintain the
+/// latency. Small enough to be inaudible.
+#define A2_SOUND_MAX_RATE_ADJUST 0.005
+
+/// Band-limited synthesizer state.
+typedef struct {
+  /// The index of the next sample to generate.
+  uint64_t next_sample;
+  /// After this sample there are no pending deltas and the output is exactly
+  /// `last_state`.
+  uint64_t settle_sample;
+  /// The last speaker state.
+  float last_state;
+  /// The integrated output.
+  float acc;
+  /// Pending deltas for the samples starting from `next_sample`, circular
+  /// starting from `delta_pos`.
+  float deltas[A2_BLEP_TAPS];
+  unsigned delta_pos;
+} a2_blep_t;
+
 typedef struct {
-  /// Queue of float sound samples. Filled by the main thread, read by the
-  /// sound callback.
-  sound_queue_t sq;
+  /// Queue of 32-bit speaker toggle cycles. Filled by the emulation thread,
+  /// read by the sound callback.
+  a2_spsc_t sq;
 
   /// On web the sound callback may not activate until the user interacts
   /// with the page. We keep track of that to avoid filling the sound queue.
   atomic_bool cb_running;
 
-  /// The cycle count for the previous speaker access. This allows us
-  /// to detect cycle overflow/wraparound.
-  unsigned last_cycle;
-  /// After cycle wraparound, this keeps the high part that has been "lost".
-  uint64_t cycle_base;
-  /// The last speaker cycle we generated sound for.
-  double last_generated_cycle;
-  /// The last speaker state.
-  float last_state;
+  /// The emulation has run up to this cycle. All toggles before it are
+  /// already in the queue.
+  atomic_uint submitted_cycle;
+  /// Clock frequency of the emulated CPU.
+  atomic_uint cpu_freq;
+  /// Sample rate of the audio output.
+  atomic_uint audio_rate;
+  /// The latency to maintain in milliseconds.
+  atomic_uint target_ms;
+  /// Accessed only by the emulation: a toggle didn't fit in the queue, so the
+  /// next one is dropped too, which keeps the polarity of the speaker.
+  bool drop_next;
+
+  // Statistics, updated by the sound callback, except where noted.
+
+  /// Smoothed number of samples between the sound callback and the emulation.
+  atomic_uint stat_lag;
+  /// Number of callbacks which ran out of samples.
+  atomic_uint stat_underruns;
+  /// Number of samples dropped because the emulation was too far ahead.
+  atomic_uint stat_dropped;
+  /// Number of toggles dropped because the queue was full. Updated by the
+  /// emulation.
+  atomic_uint stat_lost;
+
+  // The rest is accessed only by the sound callback.
+
+  /// Set once the callback has synchronized with the emulation.
+  bool synced;
+  /// The 64-bit cycle of the last processed event, or the last submitted cycle
+  /// if there were no pending toggles before it. Used to extend the 32-bit
+  /// cycles in the queue.
+  uint64_t cycle;
+  /// Cycles are mapped to sample positions linearly from this point.
+  uint64_t anchor_cycle;
+  double anchor_pos;
+  /// Samples per cycle, including the rate adjustment.
+  double samples_per_cycle;
+  /// Exponential moving average of the lag in samples.
+  double lag;
+  /// The accumulated rate adjustment compensating for clock drift.
+  double drift;
+  a2_blep_t synth;
 } a2_sound_t;
 
-void a2_sound_init(a2_sound_t *sound);
+/// Return false if there isn't enough memory for the queue.
+bool a2_sound_init(a2_sound_t *sound);
 void a2_sound_done(a2_sound_t *sound);
 
-/// The speaker bit has been accessed at cycle \p cycle.
-void a2_sound_spkr(a2_sound_t *sound, unsigned cpu_freq, unsigned audio_rate, unsigned cycle);
-/// Submit the sound generated up to cycle \p cycle.
+/// Set the latency between the emulation and the audio output that the sound
+/// callback maintains by slightly adjusting the playback rate. It is limited
+/// to half of A2_SOUND_MAX_LAG.
+void a2_sound_set_latency(a2_sound_t *sound, unsigned ms);
+
+typedef struct {
+  /// Smoothed latency between the emulation and the sound callback.
+  unsigned latency_ms;
+  /// Number of callbacks which ran out of samples.
+  unsigned underruns;
+  /// Number of samples dropped because the emulation was too far ahead.
+  unsigned dropped;
+  /// Number of toggles dropped because the queue was full.
+  unsigned lost;
+} a2_sound_stats_t;
+
+/// Return the current statistics. Can be invoked from any thread.
+a2_sound_stats_t a2_sound_get_stats(a2_sound_t *sound);
+
+/// The speaker bit has been accessed at cycle \p cycle. If the queue is full,
+/// the toggle is dropped together with the next one, so the speaker doesn't
+/// stay inverted.
+void a2_sound_spkr(a2_sound_t *sound, unsigned cycle);
+/// Tell the sound callback that the emulation has run up to cycle \p cycle.
 void a2_sound_submit(a2_sound_t *sound, unsigned cpu_freq, unsigned audio_rate, unsigned cycle);
-/// The asynchronous sound callback. Needs to populate the specified buffer with samples.
+/// The asynchronous sound callback. Synthesizes the samples from the queued
+/// speaker toggles into the specified buffer.
 void a2_sound_cb(a2_sound_t *sound, float *buffer, unsigned num_frames, unsigned num_channels);
 
 enum {
@@ -106,18 +237,48 @@ enum {
 
 typedef enum { A2_VIDMODE_TEXT, A2_VIDMODE_GR, A2_VIDMODE_HGR } a2_vidmode_t;
 
+/// The video buffers whose modifications are tracked.
+typedef enum {
+  A2_VIDBUF_TXT1,
+  A2_VIDBUF_TXT2,
+  A2_VIDBUF_HGR1,
+  A2_VIDBUF_HGR2,
+  A2_NUM_VIDBUFS
+} a2_vidbuf_t;
+
+/// A bit mask of all 24 text rows.
+#define A2_ALL_ROWS 0xFFFFFFu
+/// A bit mask of the bottom 4 text rows displayed in mixed mode.
+#define A2_MIXED_TEXT_ROWS 0xF00000u
+
+struct a2_disk;
+struct a2_tape;
+
 typedef struct {
-  // Input keyboard queue.
+  /// Input keyboard queue over `keys`. It is consumed by the emulation, but
+  /// keys may be pushed by a different (single) thread. Since it points into
+  /// the struct, a2_iostate_t must not be copied.
+  a2_spsc_t key_queue;
   uint8_t keys[A2_KBD_QUEUE_SIZE];
-  unsigned keys_head;
-  unsigned keys_count;
+  /// Bulk input, consumed after the keyboard queue. See a2_io_paste().
+  char *paste;
+  size_t paste_len;
+  size_t paste_pos;
   /// The last key that was returned.
   uint8_t last_key;
   /// Video control status.
   uint8_t vid_control;
+  /// Dirty text rows (groups of 8 scanlines) of every video buffer, indexed by
+  /// a2_vidbuf_t. Set by a2_io_vid_write(), cleared by the renderer.
+  uint32_t vid_dirty[A2_NUM_VIDBUFS];
   /// Callback when speaker is accessed.
   void *spkr_cb_ctx;
   void (*spkr_cb)(void *ctx, unsigned cycles);
+  /// The Disk II controller in slot 6, or NULL. It isn't owned by the IO
+  /// state.
+  struct a2_disk *disk;
+  /// The cassette tape, or NULL. It isn't owned by the IO state.
+  struct a2_tape *tape;
   /// Debug flags.
   uint8_t debug;
 } a2_iostate_t;
@@ -133,21 +294,33 @@ static inline void a2_io_set_spkr_cb(
 }
 /// Return false if the keyboard queue was full.
 bool a2_io_push_key(a2_iostate_t *io, uint8_t key);
+/// Return the number of keys in the queue.
+static inline unsigned a2_io_keys_count(const a2_iostate_t *io) {
+  return a2_spsc_size_approx(&io->key_queue);
+}
 /// Push a key only if the queue is empty. Return true if pushed.
 /// This method should ordinarily be used for interactive input, since we don't
 /// want to emulate a keyboard queue where the Apple II didn't have one.
 static inline bool a2_io_push_key_if_empty(a2_iostate_t *io, uint8_t key) {
-  return io->keys_count == 0 ? a2_io_push_key(io, key) : false;
+  return a2_io_keys_count(io) == 0 && io->paste_pos == io->paste_len ? a2_io_push_key(io, key)
+                                                                      : false;
 }
 /// Push either the entire string or nothing. Return true on success.
 bool a2_io_push_str(a2_iostate_t *io, const char *str);
-/// Return the number of keys in the queue.
-static inline unsigned a2_io_keys_count(const a2_iostate_t *io) {
-  return io->keys_count;
+/// Append text of any length to the bulk input, which is read by the Apple II
+/// after the keyboard queue is empty, one key per KBDSTRB access. Line feeds
+/// are converted to carriage returns and carriage returns are dropped. Must
+/// be invoked from the emulation thread. Return false if out of memory.
+bool a2_io_paste(a2_iostate_t *io, const char *text, size_t len);
+/// Append the rest of a file to the bulk input. Return false on error.
+bool a2_io_paste_file(a2_iostate_t *io, FILE *f);
+/// Return the number of bulk input keys which haven't been read yet.
+static inline size_t a2_io_paste_pending(const a2_iostate_t *io) {
+  return io->paste_len - io->paste_pos;
 }
 /// Return the number of keys that can be pushed onto the keyboard queue.
 static inline unsigned a2_io_keys_expect(const a2_iostate_t *io) {
-  return A2_KBD_QUEUE_SIZE - io->keys_count;
+  return A2_KBD_QUEUE_SIZE - a2_spsc_size_approx(&io->key_queue);
 }
 uint8_t a2_io_peek(a2_iostate_t *io, uint16_t addr, unsigned cycles);
 void a2_io_poke(a2_iostate_t *io, uint16_t addr, uint8_t value, unsigned cycles);
@@ -175,6 +348,99 @@ uint16_t a2_io_get_hires_page_offset(const a2_iostate_t *io);
 /// Return the starting address of the active text page.
 uint16_t a2_io_get_text_page_offset(const a2_iostate_t *io);
 
+/// Record that the RAM at \p addr has been written to. If it is part of a
+/// video buffer, the corresponding text row (8 scanlines) is marked dirty.
+/// This must be invoked for every write in the range [$0400..$5FFF].
+static inline void a2_io_vid_write(a2_iostate_t *io, uint16_t addr) {
+  unsigned buf;
+  if ((unsigned)(addr - 0x0400) < 0x0800)
+    buf = (addr >> 10) - 1;
+  else if ((unsigned)(addr - 0x2000) < 0x4000)
+    buf = (addr >> 13) + 1;
+  else
+    return;
+
+  // Both text and hires buffers use the same interleaving in the low 10 bits:
+  // eight 128-byte regions of three 40-byte lines, with 8 unused bytes.
+  unsigned ofs = addr & 0x7F;
+  if (ofs >= 120)
+    return;
+  unsigned row = ((addr >> 7) & 7) + (ofs >= 80 ? 16 : ofs >= 40 ? 8 : 0);
+  io->vid_dirty[buf] |= 1u << row;
+}
+
+/// Mark all video buffers as completely dirty. This must be invoked after
+/// video memory has been modified without a2_io_vid_write(), for example when
+/// loading a binary.
+static inline void a2_io_vid_invalidate(a2_iostate_t *io) {
+  for (unsigned i = 0; i != A2_NUM_VIDBUFS; ++i)
+    io->vid_dirty[i] = A2_ALL_ROWS;
+}
+
+/// Renders the emulated screen incrementally, only re-drawing the rows which
+/// have been modified since the last frame.
+typedef struct {
+  /// How to display graphics modes.
+  a2_render_mode_t render_mode;
+  /// Set if the contents of the screen are unknown and must be fully redrawn.
+  bool invalid;
+  /// The video control bits of the last rendered frame.
+  uint8_t vid_control;
+  /// The blink phase of the last rendered frame.
+  uint8_t blink_on;
+  /// Rows containing flashing characters in the last rendered frame.
+  uint32_t flash_rows;
+  /// The glyph atlas tile drawn in every text cell, or A2_NO_TILE if the cell
+  /// doesn't contain text. Used to skip characters which haven't changed.
+  uint8_t text_tiles[24][40];
+} a2_renderer_t;
+
+/// Marks a text cell without a glyph in a2_renderer_t::text_tiles.
+#define A2_NO_TILE 0xFF
+
+void a2_renderer_init(a2_renderer_t *r);
+/// Force a full redraw on the next frame. This must be invoked after the screen
+/// has been modified externally or the rendering options have changed.
+static inline void a2_renderer_invalidate(a2_renderer_t *r) {
+  r->invalid = true;
+}
+
+/// Render the rows of the active video page which have changed since the last
+/// frame and clear their dirty state in \p io.
+/// \param ram - the 64KB of emulated RAM.
+/// \param ms - millisecond since hardware reset. This is used to determine the
+///     blink phase.
+/// \return the modified region of the screen. It is empty (h == 0) if nothing
+///     has changed.
+a2_rect a2_render_frame(
+    a2_renderer_t *r,
+    a2_iostate_t *io,
+    const uint8_t *ram,
+    a2_screen8 *screen,
+    uint64_t ms);
+
+/// The number of text lines of the metrics overlay.
+#define A2_OVERLAY_LINES 4
+
+/// A few lines of text at the top of the screen, showing the effective
+/// emulation speed, the frame timing and the state of the audio, computed from
+/// the metrics since the previous refresh.
+typedef struct {
+  /// When the text was last refreshed.
+  uint64_t last_ns;
+  /// The values of the metrics at that time, indexed by id - 1.
+  a2_metric_value_t last[A2_METRICS_MAX];
+  char text[A2_OVERLAY_LINES][A2_SCREEN_W / 7 + 1];
+} a2_overlay_t;
+
+/// Initialize the overlay and enable the metrics.
+void a2_overlay_init(a2_overlay_t *o);
+/// Refresh the text twice a second. Return true if it was refreshed.
+bool a2_overlay_update(a2_overlay_t *o);
+/// Draw the overlay into the RGB screen \p dst, restoring the rest of its
+/// rows from the indexed screen \p src.
+void a2_overlay_draw(const a2_overlay_t *o, const a2_screen8 *src, a2_screen *dst);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) Tzvetan Mikov.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/// A process wide registry of performance metrics: counters, gauges and
+/// histograms with fixed buckets.
+///
+/// Metrics are registered by name, usually when their owner is initialized,
+/// and are updated through the returned id. Registering an existing name
+/// returns the same metric. Updates are lock-free: every thread accumulates
+/// into its own shard, which is summed up only when the metrics are read. All
+/// updates are ignored, at the cost of one relaxed load, until the metrics are
+/// enabled.
+///
+/// The metrics can be read one by one, dumped periodically into a JSON or CSV
+/// file, and drawn as an overlay on the screen.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// The maximum number of metrics.
+#define A2_METRICS_MAX 64
+/// The maximum number of bucket bounds of a histogram.
+#define A2_METRICS_MAX_BOUNDS 15
+/// The number of per-thread shards. Threads after the first this many share
+/// the last shard.
+#define A2_METRICS_THREADS 8
+
+typedef enum {
+  /// A monotonic count, like the number of emulated cycles.
+  A2_METRIC_COUNTER,
+  /// The last set value, like the depth of a queue.
+  A2_METRIC_GAUGE,
+  /// The distribution of observed values, like frame times.
+  A2_METRIC_HISTOGRAM,
+} a2_metric_kind_t;
+
+/// Identifies a registered metric. Updating A2_METRIC_NONE does nothing.
+typedef unsigned a2_metric_t;
+#define A2_METRIC_NONE 0
+
+void a2_metrics_enable(bool enabled);
+bool a2_metrics_enabled(void);
+/// Return a monotonic timestamp in nanoseconds, for measuring intervals.
+uint64_t a2_metrics_now_ns(void);
+/// Return the start of an interval for a2_metric_observe_since(), or 0 if the
+/// metrics are disabled, which avoids reading the clock.
+uint64_t a2_metrics_start(void);
+
+/// Register a counter. \p name must remain valid. Return A2_METRIC_NONE if
+/// the registry is full, or the name is used by a metric of another kind.
+a2_metric_t a2_metric_counter(const char *name);
+a2_metric_t a2_metric_gauge(const char *name);
+/// Register a histogram with buckets for the values up to each of the
+/// \p n_bounds ascending \p bounds, plus a bucket for the larger values.
+a2_metric_t a2_metric_histogram(const char *name, const double *bounds, unsigned n_bounds);
+/// Register a histogram of durations in milliseconds, with buckets from 0.1 ms
+/// to a few frames.
+a2_metric_t a2_metric_histogram_ms(const char *name);
+
+/// Add \p n to a counter.
+void a2_metric_add(a2_metric_t m, uint64_t n);
+/// Set the value of a gauge.
+void a2_metric_set(a2_metric_t m, double value);
+/// Add a value to a histogram.
+void a2_metric_observe(a2_metric_t m, double value);
+/// Add the milliseconds since \p start_ns, which was returned by
+/// a2_metrics_start(), to a histogram.
+void a2_metric_observe_since(a2_metric_t m, uint64_t start_ns);
+
+typedef struct {
+  const char *name;
+  a2_metric_kind_t kind;
+  /// The value of a counter, or the number of values in a histogram.
+  uint64_t count;
+  /// The value of a gauge, or the sum of the values in a histogram.
+  double value;
+  /// The bucket bounds of a histogram.
+  const double *bounds;
+  unsigned n_bounds;
+  /// The number of values in every histogram bucket. The last one counts the
+  /// values larger than all bounds.
+  uint64_t buckets[A2_METRICS_MAX_BOUNDS + 1];
+} a2_metric_value_t;
+
+/// Return the number of registered metrics. Their ids are 1 to the count.
+unsigned a2_metrics_count(void);
+/// Find a metric by name. Return A2_METRIC_NONE if it isn't registered.
+a2_metric_t a2_metric_find(const char *name);
+/// Sum up the current value of metric \p m from all threads. Return false if
+/// \p m isn't valid.
+bool a2_metric_read(a2_metric_t m, a2_metric_value_t *v);
+/// Store in \p d the change of a counter or histogram from \p prev to \p cur,
+/// which are two reads of the same metric. Gauges are copied from \p cur.
+void a2_metric_diff(
+    a2_metric_value_t *d,
+    const a2_metric_value_t *cur,
+    const a2_metric_value_t *prev);
+/// Read metric \p m into \p v and its change since \p last into \p d, then
+/// update \p last. If \p last is zeroed, the change is from zero. \p m must be
+/// valid.
+void a2_metric_read_diff(
+    a2_metric_t m,
+    a2_metric_value_t *last,
+    a2_metric_value_t *v,
+    a2_metric_value_t *d);
+/// Estimate the quantile \p q (0 to 1) of a histogram by interpolating within
+/// its bucket. Values in the last bucket are reported as its lower bound.
+double a2_metric_quantile(const a2_metric_value_t *v, double q);
+
+/// A file into which all metrics are written periodically, for tracking
+/// performance over time. Files ending with `.json` get a JSON object per line,
+/// everything else is CSV with a row per metric. Counters are also written as
+/// the rate per second since the previous record.
+typedef struct a2_metrics_dump a2_metrics_dump_t;
+
+/// Create the dump file and enable the metrics. Print an error and return
+/// NULL on error.
+a2_metrics_dump_t *a2_metrics_dump_open(const char *path, unsigned interval_ms);
+/// Write a record if the interval has passed since the previous one.
+void a2_metrics_dump_poll(a2_metrics_dump_t *dump);
+/// Write a final record and close the file. Print an error and return false
+/// on error.
+bool a2_metrics_dump_close(a2_metrics_dump_t *dump);
+
+#ifdef __cplusplus
+}
+#endif
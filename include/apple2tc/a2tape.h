@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) Tzvetan Mikov.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include "apple2tc/apple2iodefs.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/// A cassette tape, connected to the cassette input and output.
+///
+/// The tape is kept as the durations of the half cycles of its signal in CPU
+/// cycles, so the input can be played back and the output recorded with the
+/// exact timing of the emulated code. The signal level alternates between the
+/// half cycles. Tapes are loaded from and saved to WAV files.
+///
+/// The tape plays only while the program reads the input. If it isn't read
+/// for A2_TAPE_PAUSE cycles, the tape pauses instead of running away.
+/// Recording appends to the end of the tape.
+///
+/// a2_tape_read_block() and a2_tape_write_block() transfer a whole Monitor
+/// tape record (header tone, sync bit, data and checksum) at once, without
+/// running the emulated code which would take as long as the audio.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// If the input isn't read, or the output isn't toggled, for this many cycles,
+/// the tape pauses. It is longer than the 3.5 second delay in the Monitor
+/// READ routine.
+#define A2_TAPE_PAUSE (5 * A2_CLOCK_FREQ)
+
+typedef struct a2_tape {
+  /// The durations of the half cycles in CPU cycles.
+  uint32_t *halves;
+  size_t len;
+  size_t cap;
+  /// The half cycle being played. The input level is the parity of the index.
+  size_t pos;
+  /// How many cycles of the current half cycle have been played.
+  uint32_t pos_cycles;
+  /// The input is being played. `last_in` is the cycle of the last read.
+  bool playing;
+  unsigned last_in;
+  /// The output is being recorded. `last_out` is the cycle of the last toggle.
+  bool recording;
+  unsigned last_out;
+  /// Something was recorded since the tape was loaded.
+  bool dirty;
+} a2_tape_t;
+
+/// Initialize an empty tape.
+void a2_tape_init(a2_tape_t *tape);
+void a2_tape_done(a2_tape_t *tape);
+
+/// Replace the tape with the signal in a 16-bit PCM WAV file. Print an error
+/// and return false on error.
+bool a2_tape_load(a2_tape_t *tape, const char *path);
+/// Save the tape to a 16-bit mono WAV file. Print an error and return false on
+/// error.
+bool a2_tape_save(a2_tape_t *tape, const char *path);
+/// Move the playback to the start of the tape.
+void a2_tape_rewind(a2_tape_t *tape);
+
+/// Return the current level of the input.
+static inline bool a2_tape_level(const a2_tape_t *tape) {
+  return tape->pos & 1;
+}
+/// The input is read at cycle \p cycles. Advance the playback and return the
+/// input level.
+bool a2_tape_in(a2_tape_t *tape, unsigned cycles);
+/// The output is toggled at cycle \p cycles.
+void a2_tape_out(a2_tape_t *tape, unsigned cycles);
+
+/// Find the next record from the playback position, a sync bit following at
+/// least a sixth of a second of the header tone, and decode \p len bytes
+/// into \p data, followed by the checksum byte, which is stored in
+/// \p checksum. The playback stops after the record. Return false, without
+/// moving the playback, if the rest of the tape doesn't contain a complete
+/// record.
+bool a2_tape_read_block(a2_tape_t *tape, uint8_t *data, size_t len, uint8_t *checksum);
+/// Append a record of \p len bytes like the Monitor WRITE routine: a header
+/// tone of \p header_halves half cycles, a sync bit, the data and its checksum.
+void a2_tape_write_block(a2_tape_t *tape, unsigned header_halves, const uint8_t *data, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
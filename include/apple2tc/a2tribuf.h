@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) Tzvetan Mikov.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include "apple2tc/a2io.h"
+
+/// Passing video state from the emulation thread to the render thread.
+///
+/// At the end of every emulated frame the emulation thread copies the
+/// displayed video memory and the video mode into the back buffer of a triple
+/// buffer and publishes it. The render thread always picks the most recently
+/// published frame. Neither side ever waits for the other.
+
+/// Video RAM up to the end of HGR page 2.
+#define A2_VIDEO_RAM_SIZE 0x6000
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// The video state at the end of an emulated frame.
+typedef struct {
+  uint8_t vid_control;
+  /// Rows modified since the last frame consumed by the render thread.
+  uint32_t vid_dirty[A2_NUM_VIDBUFS];
+  /// RAM starting from address 0, so it can be passed to the renderer directly.
+  /// Only the displayed pages are valid.
+  uint8_t ram[A2_VIDEO_RAM_SIZE];
+} a2_video_frame_t;
+
+/// Set in `middle` when the middle buffer has been published, but not consumed.
+#define A2_TRIBUF_FRESH 4u
+
+typedef struct {
+  a2_video_frame_t bufs[3];
+  /// The buffer being filled. Accessed only by the emulation thread.
+  unsigned back;
+  /// The buffer being rendered. Accessed only by the render thread.
+  unsigned front;
+  /// The last published buffer, plus A2_TRIBUF_FRESH if it hasn't been
+  /// consumed yet. Exchanged by both threads.
+  atomic_uint middle;
+  /// Dirty rows of the last published frame. If that frame is replaced before
+  /// the render thread picks it up, they are carried into the next one.
+  /// Accessed only by the emulation thread.
+  uint32_t carry_dirty[A2_NUM_VIDBUFS];
+} a2_video_tribuf_t;
+
+void a2_video_tribuf_init(a2_video_tribuf_t *tb);
+
+/// Called by the emulation thread: copy the displayed video memory and mode,
+/// move the dirty rows from \p io into the frame and publish it.
+void a2_video_tribuf_publish(a2_video_tribuf_t *tb, a2_iostate_t *io, const uint8_t *ram);
+
+/// Called by the render thread: return the most recently published frame, or
+/// NULL if nothing has been published since the last call. The frame remains
+/// valid until the next call.
+const a2_video_frame_t *a2_video_tribuf_acquire(a2_video_tribuf_t *tb);
+
+/// Transfer the mode and the dirty rows of \p frame into \p io, which is used
+/// only for rendering.
+void a2_video_frame_apply(const a2_video_frame_t *frame, a2_iostate_t *io);
+
+#ifdef __cplusplus
+}
+#endif
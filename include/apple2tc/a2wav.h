@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) Tzvetan Mikov.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include "apple2tc/a2io.h"
+
+#include <stdio.h>
+
+/// Offline rendering of the speaker into 16-bit mono WAV files.
+///
+/// The samples are synthesized from the cycles of the speaker toggles, so the
+/// output doesn't depend on the audio device or on how fast the emulation
+/// runs, and is identical between runs with the same input.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct a2_wav_sink a2_wav_sink_t;
+
+/// Create the WAV file. Returns NULL on error.
+a2_wav_sink_t *a2_wav_open(const char *path, unsigned cpu_freq, unsigned sample_rate);
+
+/// The speaker bit has been accessed at cycle \p cycle.
+void a2_wav_spkr(a2_wav_sink_t *wav, unsigned cycle);
+
+/// Write the samples up to cycle \p cycle. Cycles passed to a2_wav_spkr()
+/// after this must not be earlier than it.
+void a2_wav_advance(a2_wav_sink_t *wav, unsigned cycle);
+
+/// Write the remaining samples, complete the header and close the file.
+/// Returns false if there were any write errors.
+bool a2_wav_close(a2_wav_sink_t *wav);
+
+/// Reads 16-bit PCM WAV files.
+typedef struct {
+  FILE *f;
+  unsigned sample_rate;
+  unsigned channels;
+  /// Number of frames left in the data chunk.
+  uint32_t frames_left;
+} a2_wav_reader_t;
+
+/// Open a WAV file and find its data. Returns false if the file cannot be
+/// opened or is not a 16-bit PCM WAV.
+bool a2_wav_reader_open(a2_wav_reader_t *rd, const char *path);
+/// Read up to \p count frames, converting the first channel to float. Returns
+/// the number of frames read, 0 at the end of the data.
+unsigned a2_wav_reader_read(a2_wav_reader_t *rd, float *buf, unsigned count);
+void a2_wav_reader_close(a2_wav_reader_t *rd);
+
+#ifdef __cplusplus
+}
+#endif
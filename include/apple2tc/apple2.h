@@ -11,14 +11,30 @@
 #include "apple2tc/emu6502.h"
 
 #include <cstdio>
+#include <string>
 #include <vector>
 
 class EmuApple2 : public Emu6502 {
 public:
   /// TXTTAB Applesoft Start of Program Pointer (2B).
   static constexpr uint16_t TXTTAB = 0x67;
+  /// VARTAB Applesoft Start of Variables Pointer (2B).
+  static constexpr uint16_t VARTAB = 0x69;
+  /// ARYTAB Applesoft Start of Arrays Pointer (2B).
+  static constexpr uint16_t ARYTAB = 0x6B;
+  /// STREND Applesoft End of Arrays Pointer (2B).
+  static constexpr uint16_t STREND = 0x6D;
+  /// FRETOP Applesoft Start of String Storage Pointer (2B).
+  static constexpr uint16_t FRETOP = 0x6F;
+  /// MEMSIZE Applesoft HIMEM (2B).
+  static constexpr uint16_t MEMSIZE = 0x73;
   /// PRGEND Applesoft End of Program Pointer (2B).
   static constexpr uint16_t PRGEND = 0xAF;
+  /// Applesoft RUN entry point.
+  static constexpr uint16_t APPLESOFT_RUN = 0xD566;
+  /// Applesoft warm restart. The ROM cold start ends here, just before the
+  /// first prompt.
+  static constexpr uint16_t APPLESOFT_RESTART = 0xD43C;
 
   static constexpr uint16_t TXT1SCRN = 0x0400;
   static constexpr uint16_t TXT2SCRN = 0x0800;
@@ -32,18 +48,65 @@ public:
   /// register device behavior, etc, but for now this is sufficient.
   static constexpr uint16_t IO_RANGE_START = 0xC000;
   static constexpr uint16_t IO_RANGE_END = 0xCFFF;
+  /// The language card soft switches in slot 0, $C080-$C08F.
+  static constexpr uint16_t LC_SWITCHES = 0xC080;
 
   EmuApple2() : Emu6502(IO_RANGE_START, IO_RANGE_END) {
     a2_io_init(&io_);
+    // Track modifications of the text and hires pages.
+    addWriteWatch(TXT1SCRN >> 8, (TXT2SCRN + 0x3FF) >> 8);
+    addWriteWatch(HGR1SCRN >> 8, (HGR2SCRN + 0x1FFF) >> 8);
   }
-  ~EmuApple2() {
-    a2_io_done(&io_);
-  }
+  ~EmuApple2();
 
   void setSpeakerCB(void *ctx, void (*spkrCB)(void *ctx, unsigned cycles)) {
     a2_io_set_spkr_cb(&io_, ctx, spkrCB);
   }
 
+  /// Save the machine state: CPU registers, cycle counter, RAM and soft
+  /// switches. The ROM is identified only by its hash. Pending input and
+  /// callbacks are not saved.
+  [[nodiscard]] std::vector<uint8_t> saveSnapshot() const;
+  /// Restore a state produced by saveSnapshot(). Return false, leaving the
+  /// state unchanged, if the data is invalid or was saved with a different ROM.
+  bool restoreSnapshot(const uint8_t *data, size_t len);
+
+  /// Put the machine in the state at the end of the ROM cold start, stopped at
+  /// APPLESOFT_RESTART, without running it. The state is generated once per ROM
+  /// and cached in the user cache directory. The ROM must be loaded. Return
+  /// false if the ROM doesn't reach the restart, in which case the machine is
+  /// unchanged.
+  bool fastBoot();
+
+  /// Replace hot Monitor and Applesoft ROM routines (WAIT, HOME, SCROLL,
+  /// CLREOL, CLREOP, COUT1, HCLR, BKGND, HPOSN, HPLOT0, and the loads and
+  /// stores of the floating point accumulators) with native implementations.
+  /// They have exactly the same effect, including on the cycle counter, but
+  /// the cycles are added all at once. setTrapVerify() checks them against the
+  /// ROM.
+  void enableHLE();
+  /// Replace only the Monitor WAIT delay loop, whose cycles are computed in
+  /// closed form. A long delay is split at the end of runFor(), like the ROM
+  /// code would be, so it still takes the same emulated and real time.
+  void enableFastWait();
+  /// Replace the Monitor tape READ and WRITE routines with direct transfers
+  /// between memory and the tape in io()->tape. Unlike the other traps, they
+  /// take no time instead of the minutes of the audio, and they can't be
+  /// verified.
+  void enableFastTape();
+
+  /// Load a module decompiled from the ROM to simple C and built as a shared
+  /// library with A2_HYBRID defined, and run the ROM code that it covers
+  /// natively. Code in RAM and addresses it doesn't cover are still emulated.
+  /// Return false and set \p error on error.
+  bool loadHybrid(const char *path, std::string &error);
+
+  /// Return the 16KB of language card RAM: bank 1 of $D000-$DFFF, then bank 2,
+  /// then $E000-$FFFF.
+  [[nodiscard]] const uint8_t *getLanguageCardRAM() const {
+    return lcRAM_;
+  }
+
   [[nodiscard]] const a2_iostate_t *io() const {
     return &io_;
   }
@@ -56,10 +119,56 @@ protected:
   uint8_t ioPeek(uint16_t addr) override;
   /// Perform a write in the IO range.
   void ioPoke(uint16_t addr, uint8_t value) override;
+  /// Mark modified video memory as dirty.
+  void watchedWrite(uint16_t addr) override {
+    a2_io_vid_write(&io_, addr);
+  }
 
 private:
+  void unloadHybrid();
+
+  /// Update the language card state on an access to its soft switches.
+  void languageCardAccess(uint16_t addr, bool write);
+  /// Map the language card RAM or the ROM according to the current state.
+  void updateLanguageCard();
+
   a2_iostate_t io_;
+
+  /// The language card RAM. See getLanguageCardRAM().
+  uint8_t lcRAM_[0x4000] = {};
+  /// The low 4 bits of the last accessed soft switch. Bit 3 clear selects bank
+  /// 2 of $D000. Reads come from RAM when bits 0 and 1 are equal. The power-on
+  /// state is reading ROM from bank 2.
+  uint8_t lcSwitch_ = 2;
+  /// Writes go to RAM.
+  bool lcWrite_ = false;
+  /// An odd switch was read once. Reading one again enables writes.
+  bool lcPrewrite_ = false;
+  /// The handle of the hybrid module library.
+  void *hybridLib_ = nullptr;
 };
 
 /// Dump the BASIC program as binary tokens.
 void dumpApplesoftBasic(FILE *f, const EmuApple2 *emu);
+
+/// Tokenize an Applesoft listing into the in-memory program format, linked
+/// for loading at \p start. Every line must start with a line number. Like
+/// when typing the lines, they are sorted by number, a line replaces an earlier
+/// one with the same number and a line with only a number deletes it. Return
+/// false and set \p error on error.
+bool tokenizeApplesoft(
+    const char *text,
+    size_t len,
+    uint16_t start,
+    std::vector<uint8_t> &prog,
+    std::string &error);
+/// Convert a tokenized program back to a listing, which tokenizes to the same
+/// program.
+std::string detokenizeApplesoft(const uint8_t *prog, size_t len);
+
+/// Tokenize an Applesoft listing directly into memory, replacing the current
+/// program and clearing the variables. Applesoft must be initialized. Return
+/// false and set \p error on error.
+bool loadApplesoftProgram(EmuApple2 *emu, const char *text, size_t len, std::string &error);
+/// Start executing the program in memory, like RUN.
+void runApplesoftProgram(EmuApple2 *emu);
@@ -70,6 +70,15 @@
 /// [R/W] SETAN3: * Set AN3: Toggle ON (+5VDC)
 #define A2_AN3ON 0xC05F
 
+/// TAPEIN =($C060/$C068)[R] Cassette Data In: the level of the input is in bit 7.
+#define A2_TAPEIN 0xC060
+
+/// The soft switches of the Disk II controller in slot 6: stepper phases,
+/// motor, drive select, Q6 and Q7.
+#define A2_DISK2_SWITCHES 0xC0E0
+/// The boot PROM of the Disk II controller in slot 6.
+#define A2_DISK2_ROM 0xC600
+
 #define A2_CLOCK_FREQ 1023000
 
 /// TXTTAB Applesoft Start of Program Pointer (2B).
@@ -7,7 +7,11 @@
 
 #pragma once
 
+#include "apple2tc/a2hybrid.h"
+#include "apple2tc/a2metrics.h"
+
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -48,6 +52,8 @@ public:
     None,
     CyclesExpired,
     StopRequesed,
+    /// The event cycle set by setEventCycle() was reached.
+    EventCycle,
   };
 
 public:
@@ -62,9 +68,54 @@ public:
   void loadROM(const uint8_t *rom, unsigned size);
   /// Reset the CPU counter to the RESET vector.
   void reset();
-  /// Run the CPU for at least this many cycles.
+  /// Run the CPU for at least this many cycles, or until the event cycle. The
+  /// cycles by which the previous runs went past their end are subtracted.
   StopReason runFor(unsigned runCycles);
 
+  /// Make runFor() stop at the first instruction boundary at or after
+  /// \p cycle, so an external event, like a key press, can be delivered at an
+  /// exact cycle.
+  void setEventCycle(unsigned cycle) {
+    eventCycle_ = cycle;
+    eventPending_ = true;
+  }
+  void clearEventCycle() {
+    eventPending_ = false;
+  }
+
+  /// A native implementation of a routine, invoked instead of emulating the
+  /// instruction at its entry point. It must have exactly the same effect on
+  /// registers, flags and memory as the emulated code, normally up to and
+  /// including its final RTS, and return the number of instructions that it
+  /// replaces. It returns 0 to decline, in which case the code is emulated.
+  typedef unsigned (*TrapFn)(Emu6502 *emu);
+
+  /// Execute \p fn instead of the code at \p addr.
+  void setTrap(uint16_t addr, TrapFn fn);
+  /// Remove all traps.
+  void clearTraps();
+  /// When enabled, every trap is checked against the emulated code, starting
+  /// from the same state. The emulated result is kept and mismatches are
+  /// reported to stderr. This is very slow.
+  void setTrapVerify(bool verify) {
+    trapVerify_ = verify;
+  }
+  /// Return the number of traps which didn't match the emulated code.
+  [[nodiscard]] unsigned getTrapMismatches() const {
+    return trapMismatches_;
+  }
+  /// Return the number of cycles left in the current runFor(). Traps of delay
+  /// loops use it to stop at the end of the run, instead of running ahead of
+  /// real time and of pending events.
+  [[nodiscard]] unsigned getRunCyclesLeft() const {
+    return (int)(runEnd_ - cycles_) > 0 ? runEnd_ - cycles_ : 0;
+  }
+
+  /// Run the blocks of a decompiled \p module natively whenever the PC is in
+  /// the ROM, unless instructions are being traced. The module must stay loaded
+  /// until it is replaced. nullptr disables it.
+  void setHybridModule(const a2_hybrid_module_t *module);
+
   enum DebugFlags : uint8_t {
     DebugASM = 1,
     DebugIO1 = 2,
@@ -104,6 +155,16 @@ public:
     return cycles_;
   }
 
+  /// Set the cycle counter, for example when restoring a saved state.
+  void setCycles(unsigned cycles) {
+    cycles_ = cycles;
+  }
+
+  /// Return the address where the ROM starts, or 0x10000 if there is no ROM.
+  [[nodiscard]] unsigned getROMStart() const {
+    return romStart_;
+  }
+
   /// Return a read-only pointer to a 64KB buffer of RAM. Not all of that RAM is
   /// actually usable.
   [[nodiscard]] const uint8_t *getMainRAM() const {
@@ -137,10 +198,10 @@ public:
   /// so when invoked with an integer expression, it will be truncated to 16
   /// bits. This is deliberate.
   uint8_t peek(uint16_t addr) {
-    if (addr >= ioRangeStart_ && addr <= ioRangeEnd_)
-      return ioPeek(addr);
+    if (const uint8_t *page = readPages_[addr >> 8])
+      return page[addr & 0xFF];
     else
-      return ram_[addr];
+      return ioPeek(addr);
   }
   /// Read a 16-bit from memory, iospace, swoft switches, etc. Note that there
   //  /// coudl be side effects, so the method isn't const.
@@ -153,19 +214,39 @@ public:
 
   /// Write a 16-bit into memory, iospace, swoft switches, etc.
   void poke(uint16_t addr, uint8_t value) {
-    if (addr >= ioRangeStart_ && addr <= ioRangeEnd_)
-      ioPoke(addr, value);
-    else if (addr < romStart_)
-      ram_[addr] = value;
+    if (uint8_t *page = writePages_[addr >> 8])
+      page[addr & 0xFF] = value;
+    else
+      pokeSlow(addr, value);
   }
 
+  /// Writes to RAM in the specified range of pages will be reported by
+  /// invoking watchedWrite(). The range is inclusive.
+  void addWriteWatch(uint8_t fromPage, uint8_t toPage);
+
+  /// Map \p numPages pages starting from \p fromPage to other memory, for
+  /// example for bank switching: reads come from \p read and writes go to
+  /// \p write. nullptr restores the RAM buffer for that direction, where IO
+  /// and ROM behave as usual. Traps and the hybrid module are only active in
+  /// pages whose reads aren't mapped.
+  void mapPages(uint8_t fromPage, unsigned numPages, const uint8_t *read, uint8_t *write);
+
 protected:
   /// Perform a read in the IO range.
   virtual uint8_t ioPeek(uint16_t addr);
   /// Perform a write in the IO range.
   virtual void ioPoke(uint16_t addr, uint8_t value);
+  /// Invoked after RAM in a watched page has been written to.
+  virtual void watchedWrite(uint16_t addr) {}
 
 private:
+  /// Handle a write to a page without a direct write pointer: IO, ROM or a
+  /// watched page.
+  void pokeSlow(uint16_t addr, uint8_t value);
+  /// Update the page tables to reflect the IO range, ROM, watches and
+  /// mapped pages.
+  void updatePageTables();
+
   void push8(uint8_t v) {
     ram_[STACK_PAGE_ADDR + sp_--] = v;
   }
@@ -293,6 +374,19 @@ private:
     status_ = (status_ & ~STATUS_C) | (value & STATUS_C);
   }
 
+  /// Execute a trap. The loop adds the cycles of one instruction, so only the
+  /// rest are added here. Return false if the trap declined.
+  bool runTrap(TrapFn fn);
+  /// Execute a trap and the emulated code from the same state and compare
+  /// them.
+  bool runTrapVerified(TrapFn fn);
+
+  /// Run the hybrid module from the current PC. Return false if it doesn't
+  /// cover it.
+  bool runHybrid();
+  static uint8_t hybridIOPeek(a2_hybrid_ctx_t *ctx, uint16_t addr);
+  static void hybridPokeSlow(a2_hybrid_ctx_t *ctx, uint16_t addr, uint8_t value);
+
   /// Perform A + B + Carry in decimal mode and update the flags.
   uint8_t adcDecimal(uint8_t b);
   /// Perform A - B - Carry in decimal mode and update the flags.
@@ -320,12 +414,50 @@ private:
 
   /// Number of processor cycles.
   unsigned cycles_ = 0;
+  /// The cycle at which runFor() must stop, if `eventPending_`.
+  unsigned eventCycle_ = 0;
+  bool eventPending_ = false;
+  /// The cycle at which the current runFor() stops.
+  unsigned runEnd_ = 0;
+  /// Cycles executed past the end of the previous runFor() calls, which are
+  /// subtracted from the next one.
+  unsigned runDebt_ = 0;
+
+  /// The read path: pointers to the memory of every page, or nullptr for IO.
+  const uint8_t *readPages_[256];
+  /// The write fast path: pointers to RAM pages which can be written to
+  /// directly. nullptr means that the write must go through pokeSlow().
+  uint8_t *writePages_[256];
+  /// Pages mapped with mapPages(), or nullptr.
+  const uint8_t *readMap_[256] = {};
+  uint8_t *writeMap_[256] = {};
+  /// Pages whose writes are reported with watchedWrite().
+  bool watchedPages_[256] = {};
+
+  /// Traps of every page, indexed by the low byte of the address, or nullptr
+  /// if the page has no traps.
+  TrapFn *trapPages_[256] = {};
+  /// trapPages_ of the pages whose reads aren't mapped, checked by runFor().
+  TrapFn *activeTrapPages_[256] = {};
+  std::vector<std::unique_ptr<TrapFn[]>> trapStorage_{};
+  bool trapVerify_ = false;
+  /// Set while the emulated code of a trap is being verified.
+  bool inTrapVerify_ = false;
+  unsigned trapMismatches_ = 0;
+
+  const a2_hybrid_module_t *hybrid_ = nullptr;
+  /// Addresses not covered by the hybrid module, one bit each.
+  uint8_t hybridMisses_[0x10000 / 8] = {};
 
   /// If debugging is activated, invoked before every instruction. Can cause
   /// the execution loop to terminated by returning StopRequested.
   StopReason (*debugStateCB_)(void *ctx, Emu6502 *emu, uint16_t pc) = nullptr;
   void *debugStateCBCtx_ = nullptr;
 
+  /// Cycles executed by runFor(), and the number of calls.
+  a2_metric_t metricCycles_ = a2_metric_counter("emu.cycles");
+  a2_metric_t metricRuns_ = a2_metric_counter("emu.runs");
+
   /// 64Kb of RAM.
   uint8_t ram_[0x10000];
 };
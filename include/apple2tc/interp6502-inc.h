@@ -0,0 +1,550 @@
+/*
+ * Copyright (c) Tzvetan Mikov.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+/// A 6502 interpreter for code which wasn't decompiled. It executes one
+/// instruction at a time exactly like Emu6502, so the generated code can fall
+/// back to it when it reaches an unknown address, and resume at the next block
+/// it knows.
+///
+/// The addresses where the interpreter was entered are saved as runtime data,
+/// which can be passed to apple2tc with --run-data, so the next decompilation
+/// covers them.
+///
+/// This is included by the runtime, after s_ram, ram_poke_impl(), peek() and
+/// poke() are defined.
+
+/// Entry points of code which wasn't decompiled.
+static uint8_t s_missed_code[0x10000 / 8];
+static unsigned s_num_missed_code = 0;
+/// The address following the last interpreted instruction. Execution
+/// continuing there is not a new entry point.
+static unsigned s_interp_next_pc = 0x10000;
+/// Where to save the entry points on shutdown, if not NULL.
+static const char *s_missed_code_path = NULL;
+
+void set_missed_code_log(const char *path) {
+  s_missed_code_path = path;
+}
+
+enum {
+  INTERP_IMP,
+  INTERP_IMM,
+  INTERP_ZPG,
+  INTERP_ZPG_X,
+  INTERP_ZPG_Y,
+  INTERP_ABS,
+  INTERP_ABS_X,
+  INTERP_ABS_Y,
+  INTERP_X_IND,
+  INTERP_IND_Y,
+};
+
+/// Return the addressing mode of a documented instruction. Branches and
+/// jumps are decoded separately.
+static unsigned interp_mode(uint8_t op) {
+  static const uint8_t GROUP1[8] = {
+      INTERP_X_IND,
+      INTERP_ZPG,
+      INTERP_IMM,
+      INTERP_ABS,
+      INTERP_IND_Y,
+      INTERP_ZPG_X,
+      INTERP_ABS_Y,
+      INTERP_ABS_X};
+  static const uint8_t OTHER[8] = {
+      INTERP_IMM,
+      INTERP_ZPG,
+      INTERP_IMP,
+      INTERP_ABS,
+      INTERP_IMP,
+      INTERP_ZPG_X,
+      INTERP_IMP,
+      INTERP_ABS_X};
+
+  if ((op & 3) == 1)
+    return GROUP1[(op >> 2) & 7];
+  if ((op & 3) == 3 || (op & 0x9F) == 0)
+    return INTERP_IMP;
+  // STX and LDX index with Y.
+  if (op == 0x96 || op == 0xB6)
+    return INTERP_ZPG_Y;
+  if (op == 0xBE)
+    return INTERP_ABS_Y;
+  return OTHER[(op >> 2) & 7];
+}
+
+/// Return the effective address of the operand of the instruction at \p pc.
+/// Immediate operands are addressed in place. Like Emu6502, only the operand
+/// bytes of the instruction are read, since reads past it may hit IO.
+static uint16_t interp_ea(const regs_t *r, uint16_t pc, unsigned mode) {
+  switch (mode) {
+  case INTERP_IMM:
+    return pc + 1;
+  case INTERP_ZPG:
+    return peek(pc + 1);
+  case INTERP_ZPG_X:
+    return (uint8_t)(peek(pc + 1) + r->x);
+  case INTERP_ZPG_Y:
+    return (uint8_t)(peek(pc + 1) + r->y);
+  case INTERP_ABS:
+    return peek16(pc + 1);
+  case INTERP_ABS_X:
+    return peek16(pc + 1) + r->x;
+  case INTERP_ABS_Y:
+    return peek16(pc + 1) + r->y;
+  case INTERP_X_IND: {
+    uint8_t zp = peek(pc + 1) + r->x;
+    return peek(zp) + (peek((uint8_t)(zp + 1)) << 8);
+  }
+  case INTERP_IND_Y: {
+    uint8_t zp = peek(pc + 1);
+    return peek(zp) + (peek((uint8_t)(zp + 1)) << 8) + r->y;
+  }
+  default:
+    return 0;
+  }
+}
+
+static uint8_t interp_nz(regs_t *r, uint8_t v) {
+  r->status = (r->status & ~(STATUS_N | STATUS_Z)) | (v & STATUS_N) | (v ? 0 : STATUS_Z);
+  return v;
+}
+
+static void interp_set_c(regs_t *r, bool c) {
+  r->status = (r->status & ~STATUS_C) | (c ? STATUS_C : 0);
+}
+
+/// CMP, CPX and CPY.
+static void interp_cmp(regs_t *r, uint8_t reg, uint8_t m) {
+  interp_nz(r, reg - m);
+  interp_set_c(r, reg >= m);
+}
+
+static uint8_t interp_adc(regs_t *r, uint8_t m) {
+  uint8_t a = r->a;
+  uint8_t c = r->status & STATUS_C;
+  if (!(r->status & STATUS_D)) {
+    unsigned v = a + m + c;
+    interp_nz(r, (uint8_t)v);
+    interp_set_c(r, v > 0xFF);
+    r->status = (r->status & ~STATUS_V) | (((~(a ^ m) & (a ^ v)) >> 1) & STATUS_V);
+    return (uint8_t)v;
+  }
+
+  uint8_t al = (a & 15) + (m & 15) + c;
+  if (al >= 10)
+    al += 6;
+  uint8_t ah = (a >> 4) + (m >> 4) + (al > 15);
+
+  r->status &= ~(STATUS_N | STATUS_V | STATUS_Z | STATUS_C);
+  if (!(uint8_t)(a + m + c))
+    r->status |= STATUS_Z;
+  else if (ah & 8)
+    r->status |= STATUS_N;
+  if (~(a ^ m) & (a ^ (ah << 4)) & 0x80)
+    r->status |= STATUS_V;
+  if (ah >= 10)
+    ah += 6;
+  if (ah > 15)
+    r->status |= STATUS_C;
+  return (ah << 4) | (al & 15);
+}
+
+static uint8_t interp_sbc(regs_t *r, uint8_t m) {
+  if (!(r->status & STATUS_D))
+    return interp_adc(r, ~m);
+
+  uint8_t a = r->a;
+  uint8_t c = ~r->status & STATUS_C;
+  uint8_t al = (a & 15) - (m & 15) - c;
+  if ((int8_t)al < 0)
+    al -= 6;
+  uint8_t ah = (a >> 4) - (m >> 4) - ((int8_t)al < 0);
+
+  r->status &= ~(STATUS_N | STATUS_V | STATUS_Z | STATUS_C);
+  uint16_t diff = a - m - c;
+  if (!(uint8_t)diff)
+    r->status |= STATUS_Z;
+  else if (diff & 0x80)
+    r->status |= STATUS_N;
+  if ((a ^ m) & (a ^ diff) & 0x80)
+    r->status |= STATUS_V;
+  if (!(diff & 0xFF00))
+    r->status |= STATUS_C;
+  if ((int8_t)ah < 0)
+    ah -= 6;
+  return (ah << 4) | (al & 15);
+}
+
+static void interp_push(regs_t *r, uint8_t v) {
+  ram_poke_impl(STACK_PAGE_ADDR + r->sp--, v);
+}
+static uint8_t interp_pop(regs_t *r) {
+  return s_ram[STACK_PAGE_ADDR + ++r->sp];
+}
+static void interp_push16(regs_t *r, uint16_t v) {
+  interp_push(r, v >> 8);
+  interp_push(r, v);
+}
+static uint16_t interp_pop16(regs_t *r) {
+  uint8_t lo = interp_pop(r);
+  return lo + (interp_pop(r) << 8);
+}
+
+/// Execute the instruction at `r->pc`.
+static void interp_step(regs_t *r) {
+  static const uint8_t LENGTH[] = {1, 2, 2, 2, 2, 3, 3, 3, 2, 2};
+  static const uint8_t BRANCH_FLAGS[4] = {STATUS_N, STATUS_V, STATUS_C, STATUS_Z};
+
+  uint16_t pc = r->pc;
+  uint8_t op = peek(pc);
+  unsigned mode = interp_mode(op);
+  uint16_t ea = interp_ea(r, pc, mode);
+  r->pc = pc + LENGTH[mode];
+
+  // Branches: xxy10000, taken if the flag selected by xx equals y.
+  if ((op & 0x1F) == 0x10) {
+    bool flag = r->status & BRANCH_FLAGS[op >> 6];
+    if (flag == ((op >> 5) & 1))
+      r->pc = pc + 2 + (int8_t)peek(pc + 1);
+    else
+      r->pc = pc + 2;
+    return;
+  }
+
+  uint8_t m;
+  switch (op) {
+  // Group 1: ORA, AND, EOR, ADC, STA, LDA, CMP, SBC.
+  case 0x09:
+  case 0x05:
+  case 0x15:
+  case 0x0D:
+  case 0x1D:
+  case 0x19:
+  case 0x01:
+  case 0x11:
+    r->a = interp_nz(r, r->a | peek(ea));
+    break;
+  case 0x29:
+  case 0x25:
+  case 0x35:
+  case 0x2D:
+  case 0x3D:
+  case 0x39:
+  case 0x21:
+  case 0x31:
+    r->a = interp_nz(r, r->a & peek(ea));
+    break;
+  case 0x49:
+  case 0x45:
+  case 0x55:
+  case 0x4D:
+  case 0x5D:
+  case 0x59:
+  case 0x41:
+  case 0x51:
+    r->a = interp_nz(r, r->a ^ peek(ea));
+    break;
+  case 0x69:
+  case 0x65:
+  case 0x75:
+  case 0x6D:
+  case 0x7D:
+  case 0x79:
+  case 0x61:
+  case 0x71:
+    r->a = interp_adc(r, peek(ea));
+    break;
+  case 0x85:
+  case 0x95:
+  case 0x8D:
+  case 0x9D:
+  case 0x99:
+  case 0x81:
+  case 0x91:
+    poke(ea, r->a);
+    break;
+  case 0xA9:
+  case 0xA5:
+  case 0xB5:
+  case 0xAD:
+  case 0xBD:
+  case 0xB9:
+  case 0xA1:
+  case 0xB1:
+    r->a = interp_nz(r, peek(ea));
+    break;
+  case 0xC9:
+  case 0xC5:
+  case 0xD5:
+  case 0xCD:
+  case 0xDD:
+  case 0xD9:
+  case 0xC1:
+  case 0xD1:
+    interp_cmp(r, r->a, peek(ea));
+    break;
+  case 0xE9:
+  case 0xE5:
+  case 0xF5:
+  case 0xED:
+  case 0xFD:
+  case 0xF9:
+  case 0xE1:
+  case 0xF1:
+    r->a = interp_sbc(r, peek(ea));
+    break;
+
+  // Shifts and rotates.
+  case 0x0A:
+    interp_set_c(r, r->a & 0x80);
+    r->a = interp_nz(r, r->a << 1);
+    break;
+  case 0x06:
+  case 0x16:
+  case 0x0E:
+  case 0x1E:
+    m = peek(ea);
+    interp_set_c(r, m & 0x80);
+    poke(ea, interp_nz(r, m << 1));
+    break;
+  case 0x2A:
+    m = r->a;
+    r->a = interp_nz(r, (m << 1) | (r->status & STATUS_C));
+    interp_set_c(r, m & 0x80);
+    break;
+  case 0x26:
+  case 0x36:
+  case 0x2E:
+  case 0x3E:
+    m = peek(ea);
+    poke(ea, interp_nz(r, (m << 1) | (r->status & STATUS_C)));
+    interp_set_c(r, m & 0x80);
+    break;
+  case 0x4A:
+    interp_set_c(r, r->a & 1);
+    r->a = interp_nz(r, r->a >> 1);
+    break;
+  case 0x46:
+  case 0x56:
+  case 0x4E:
+  case 0x5E:
+    m = peek(ea);
+    interp_set_c(r, m & 1);
+    poke(ea, interp_nz(r, m >> 1));
+    break;
+  case 0x6A:
+    m = r->a;
+    r->a = interp_nz(r, (m >> 1) | ((r->status & STATUS_C) << 7));
+    interp_set_c(r, m & 1);
+    break;
+  case 0x66:
+  case 0x76:
+  case 0x6E:
+  case 0x7E:
+    m = peek(ea);
+    poke(ea, interp_nz(r, (m >> 1) | ((r->status & STATUS_C) << 7)));
+    interp_set_c(r, m & 1);
+    break;
+
+  // Increments and decrements.
+  case 0xC6:
+  case 0xD6:
+  case 0xCE:
+  case 0xDE:
+    poke(ea, interp_nz(r, peek(ea) - 1));
+    break;
+  case 0xE6:
+  case 0xF6:
+  case 0xEE:
+  case 0xFE:
+    poke(ea, interp_nz(r, peek(ea) + 1));
+    break;
+  case 0xCA:
+    r->x = interp_nz(r, r->x - 1);
+    break;
+  case 0x88:
+    r->y = interp_nz(r, r->y - 1);
+    break;
+  case 0xE8:
+    r->x = interp_nz(r, r->x + 1);
+    break;
+  case 0xC8:
+    r->y = interp_nz(r, r->y + 1);
+    break;
+
+  // Index register loads, stores and compares.
+  case 0xA2:
+  case 0xA6:
+  case 0xB6:
+  case 0xAE:
+  case 0xBE:
+    r->x = interp_nz(r, peek(ea));
+    break;
+  case 0xA0:
+  case 0xA4:
+  case 0xB4:
+  case 0xAC:
+  case 0xBC:
+    r->y = interp_nz(r, peek(ea));
+    break;
+  case 0x86:
+  case 0x96:
+  case 0x8E:
+    poke(ea, r->x);
+    break;
+  case 0x84:
+  case 0x94:
+  case 0x8C:
+    poke(ea, r->y);
+    break;
+  case 0xE0:
+  case 0xE4:
+  case 0xEC:
+    interp_cmp(r, r->x, peek(ea));
+    break;
+  case 0xC0:
+  case 0xC4:
+  case 0xCC:
+    interp_cmp(r, r->y, peek(ea));
+    break;
+
+  case 0x24:
+  case 0x2C:
+    m = peek(ea);
+    r->status = (r->status & ~(STATUS_N | STATUS_V | STATUS_Z)) | (m & (STATUS_N | STATUS_V)) |
+        (r->a & m ? 0 : STATUS_Z);
+    break;
+
+  // Transfers.
+  case 0xAA:
+    r->x = interp_nz(r, r->a);
+    break;
+  case 0xA8:
+    r->y = interp_nz(r, r->a);
+    break;
+  case 0xBA:
+    r->x = interp_nz(r, r->sp);
+    break;
+  case 0x8A:
+    r->a = interp_nz(r, r->x);
+    break;
+  case 0x9A:
+    r->sp = r->x;
+    break;
+  case 0x98:
+    r->a = interp_nz(r, r->y);
+    break;
+
+  // Flags.
+  case 0x18:
+    r->status &= ~STATUS_C;
+    break;
+  case 0x38:
+    r->status |= STATUS_C;
+    break;
+  case 0x58:
+    r->status &= ~STATUS_I;
+    break;
+  case 0x78:
+    r->status |= STATUS_I;
+    break;
+  case 0xB8:
+    r->status &= ~STATUS_V;
+    break;
+  case 0xD8:
+    r->status &= ~STATUS_D;
+    break;
+  case 0xF8:
+    r->status |= STATUS_D;
+    break;
+
+  // Stack.
+  case 0x48:
+    interp_push(r, r->a);
+    break;
+  case 0x08:
+    interp_push(r, r->status | STATUS_B);
+    break;
+  case 0x68:
+    r->a = interp_nz(r, interp_pop(r));
+    break;
+  case 0x28:
+    r->status = interp_pop(r) & ~STATUS_B;
+    break;
+
+  // Control flow.
+  case 0x4C:
+    r->pc = ea;
+    break;
+  case 0x6C:
+    r->pc = peek(ea) + (peek(ea + 1) << 8);
+    break;
+  case 0x20:
+    interp_push16(r, pc + 2);
+    r->pc = peek(pc + 1) + (peek(pc + 2) << 8);
+    break;
+  case 0x60:
+    r->pc = interp_pop16(r) + 1;
+    break;
+  case 0x40:
+    r->status = interp_pop(r) & ~STATUS_B;
+    r->pc = interp_pop16(r);
+    break;
+  case 0x00:
+    interp_push16(r, pc + 2);
+    interp_push(r, r->status | STATUS_B);
+    r->pc = peek(0xFFFE) + (peek(0xFFFF) << 8);
+    break;
+
+  case 0xEA:
+    break;
+
+  default:
+    fprintf(stderr, "Invalid instruction $%02X\n", op);
+    r->pc = pc + 1;
+    break;
+  }
+}
+
+/// Record \p pc as an entry point into code which wasn't decompiled, unless
+/// execution simply continues after the last interpreted instruction.
+static void interp_note_entry(uint16_t pc) {
+  // Code in the language card RAM can't be decompiled from the image.
+  if (lc_runs_ram(pc))
+    return;
+  if (pc != s_interp_next_pc && !(s_missed_code[pc >> 3] & (1 << (pc & 7)))) {
+    s_missed_code[pc >> 3] |= 1 << (pc & 7);
+    ++s_num_missed_code;
+  }
+}
+
+/// Save the recorded entry points as runtime data for apple2tc.
+static void save_missed_code(void) {
+  if (!s_num_missed_code)
+    return;
+  fprintf(stderr, "%u code addresses weren't decompiled and were interpreted\n", s_num_missed_code);
+  if (!s_missed_code_path)
+    return;
+
+  FILE *f = fopen(s_missed_code_path, "w");
+  if (!f) {
+    perror(s_missed_code_path);
+    return;
+  }
+  fprintf(f, "{\"BranchTargets\":[");
+  const char *sep = "";
+  for (unsigned addr = 0; addr != 0x10000; ++addr) {
+    if (s_missed_code[addr >> 3] & (1 << (addr & 7))) {
+      fprintf(f, "%s%u", sep, addr);
+      sep = ",";
+    }
+  }
+  fprintf(f, "]}\n");
+  if (fclose(f) != 0)
+    perror(s_missed_code_path);
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) Tzvetan Mikov.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+/// The 16KB language card in slot 0, like in EmuApple2. $D000-$FFFF is
+/// accessed through a small table of pointers to 4KB blocks, so bank switching
+/// only changes the pointers, and reads of RAM and ROM don't check the state.
+///
+/// This is included by the runtime, after s_ram is defined.
+
+/// The language card soft switches, $C080-$C08F.
+#define LC_SWITCHES 0xC080
+
+/// Bank 1 of $D000-$DFFF, then bank 2, then $E000-$FFFF.
+static uint8_t s_lc_ram[0x4000];
+/// The memory of the blocks at $D000, $E000 and $F000.
+static const uint8_t *s_lc_read[3];
+/// Like s_lc_read, or NULL if writes are ignored.
+static uint8_t *s_lc_write[3];
+/// The low 4 bits of the last accessed soft switch.
+static uint8_t s_lc_switch = 2;
+static bool s_lc_write_enabled = false;
+/// An odd switch was read once. Reading one again enables writes.
+static bool s_lc_prewrite = false;
+/// Reads of $D000-$FFFF come from the RAM.
+static bool s_lc_read_ram = false;
+
+static void lc_update(void) {
+  s_lc_read_ram = (s_lc_switch & 1) == ((s_lc_switch >> 1) & 1);
+  uint8_t *bank[3] = {
+      s_lc_ram + (s_lc_switch & 8 ? 0 : 0x1000),
+      s_lc_ram + 0x2000,
+      s_lc_ram + 0x3000,
+  };
+  for (unsigned i = 0; i != 3; ++i) {
+    s_lc_read[i] = s_lc_read_ram ? bank[i] : s_ram + 0xD000 + i * 0x1000;
+    s_lc_write[i] = s_lc_write_enabled ? bank[i] : NULL;
+  }
+}
+
+/// Reset to the power-on state: reading ROM, writes ignored.
+static void lc_reset(void) {
+  s_lc_switch = 2;
+  s_lc_write_enabled = false;
+  s_lc_prewrite = false;
+  lc_update();
+}
+
+/// Update the state on an access to the soft switch \p addr.
+static void lc_access(uint16_t addr, bool write) {
+  s_lc_switch = addr & 0xF;
+  if (!(addr & 1)) {
+    s_lc_write_enabled = false;
+    s_lc_prewrite = false;
+  } else if (write) {
+    // Writes don't count towards the two reads enabling writes.
+    s_lc_prewrite = false;
+  } else {
+    s_lc_write_enabled |= s_lc_prewrite;
+    s_lc_prewrite = true;
+  }
+  lc_update();
+}
+
+/// Read from $D000-$FFFF.
+static inline uint8_t lc_peek(uint16_t addr) {
+  return s_lc_read[(addr >> 12) - 0xD][addr & 0xFFF];
+}
+/// Write to $D000-$FFFF.
+static inline void lc_poke(uint16_t addr, uint8_t value) {
+  uint8_t *p = s_lc_write[(addr >> 12) - 0xD];
+  if (p)
+    p[addr & 0xFFF] = value;
+}
+
+/// Return true if the code at \p pc executes from the language card RAM,
+/// which the decompiled code doesn't describe.
+static inline bool lc_runs_ram(uint16_t pc) {
+  return pc >= 0xD000 && s_lc_read_ram;
+}
@@ -0,0 +1,296 @@
+/*
+ * Copyright (c) Tzvetan Mikov.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+#include <atomic>
+#include <new>
+#include <type_traits>
+
+using std::atomic_bool;
+using std::atomic_uint;
+using std::memory_order_acquire;
+using std::memory_order_relaxed;
+using std::memory_order_release;
+#else
+#include <stdatomic.h>
+#endif
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+/// A lock-free ring of fixed size elements, which can be accessed
+/// simultaneously by one producer and one consumer thread.
+///
+/// The producer owns `tail` and the consumer owns `head`. Both are free
+/// running and are reduced modulo the capacity only when indexing. They live
+/// on separate cache lines, and each side keeps a cached copy of the other
+/// side's index, which it refreshes only when the cached value says the ring
+/// is full (or empty). So in the steady state the two threads don't touch
+/// each other's cache lines.
+///
+/// Elements can be pushed and popped one by one, copied in bulk, or written
+/// and read in place through reserve/commit and peek/release.
+
+#define A2_CACHE_LINE 64
+
+typedef struct {
+  // Read-only after initialization.
+  char *data;
+  /// Capacity in elements minus 1. The capacity is a power of 2.
+  unsigned mask;
+  unsigned elem_size;
+  /// Whether `data` is freed by a2_spsc_free().
+  bool owns_data;
+  char pad0_[A2_CACHE_LINE];
+
+  // Producer side.
+  /// Index of the next element to write.
+  atomic_uint tail;
+  /// The last value of `head` seen by the producer.
+  unsigned head_cache;
+  char pad1_[A2_CACHE_LINE];
+
+  // Consumer side.
+  /// Index of the next element to read.
+  atomic_uint head;
+  /// The last value of `tail` seen by the consumer.
+  unsigned tail_cache;
+  char pad2_[A2_CACHE_LINE];
+} a2_spsc_t;
+
+/// A logically consecutive range of elements in the ring. Due to the
+/// wrap-around, it can be split in two.
+typedef struct {
+  void *part1;
+  /// Number of elements in part1.
+  unsigned count1;
+  void *part2;
+  /// Number of elements in part2.
+  unsigned count2;
+} a2_spsc_parts_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Initialize an empty ring. Return false if malloc() fails.
+/// \param capacity - the capacity in elements. Must be a power of 2.
+bool a2_spsc_init(a2_spsc_t *q, unsigned capacity, unsigned elem_size);
+/// Initialize an empty ring using the memory at \p buf, which must hold
+/// \p capacity elements and outlive the ring.
+void a2_spsc_init_buf(a2_spsc_t *q, void *buf, unsigned capacity, unsigned elem_size);
+/// Free the memory allocated by a2_spsc_init().
+void a2_spsc_free(a2_spsc_t *q);
+
+/// Producer: return up to \p max free slots, which can be written in place and
+/// then published with a2_spsc_commit().
+a2_spsc_parts_t a2_spsc_reserve(a2_spsc_t *q, unsigned max);
+/// Consumer: return up to \p max available elements, which can be read in
+/// place and then freed with a2_spsc_release().
+a2_spsc_parts_t a2_spsc_peek(a2_spsc_t *q, unsigned max);
+
+/// Producer: copy up to \p count elements into the ring. Return the number of
+/// elements actually pushed.
+unsigned a2_spsc_push(a2_spsc_t *q, const void *src, unsigned count);
+/// Consumer: copy up to \p count elements out of the ring. Return the number
+/// of elements actually popped.
+unsigned a2_spsc_pop(a2_spsc_t *q, void *dst, unsigned count);
+
+static inline unsigned a2_spsc_capacity(const a2_spsc_t *q) {
+  return q->mask + 1;
+}
+
+static inline void *a2_spsc_slot(const a2_spsc_t *q, unsigned index) {
+  return q->data + (size_t)(index & q->mask) * q->elem_size;
+}
+
+/// Producer: return the number of free slots.
+static inline unsigned a2_spsc_space(a2_spsc_t *q) {
+  unsigned tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+  q->head_cache = atomic_load_explicit(&q->head, memory_order_acquire);
+  return a2_spsc_capacity(q) - (tail - q->head_cache);
+}
+
+/// Consumer: return the number of available elements.
+static inline unsigned a2_spsc_count(a2_spsc_t *q) {
+  unsigned head = atomic_load_explicit(&q->head, memory_order_relaxed);
+  q->tail_cache = atomic_load_explicit(&q->tail, memory_order_acquire);
+  return q->tail_cache - head;
+}
+
+/// Any thread: an approximate number of elements in the ring, e.g. for
+/// statistics.
+static inline unsigned a2_spsc_size_approx(const a2_spsc_t *q) {
+  unsigned head = atomic_load_explicit(&q->head, memory_order_relaxed);
+  unsigned tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+  unsigned size = tail - head;
+  return size > a2_spsc_capacity(q) ? 0 : size;
+}
+
+/// Producer: publish \p count reserved elements.
+static inline void a2_spsc_commit(a2_spsc_t *q, unsigned count) {
+  unsigned tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+  atomic_store_explicit(&q->tail, tail + count, memory_order_release);
+}
+
+/// Consumer: free \p count elements.
+static inline void a2_spsc_release(a2_spsc_t *q, unsigned count) {
+  unsigned head = atomic_load_explicit(&q->head, memory_order_relaxed);
+  atomic_store_explicit(&q->head, head + count, memory_order_release);
+}
+
+/// Producer: return the next free slot, or NULL if the ring is full. The slot
+/// is published with `a2_spsc_commit(q, 1)`.
+static inline void *a2_spsc_reserve1(a2_spsc_t *q) {
+  unsigned tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+  if (tail - q->head_cache == a2_spsc_capacity(q)) {
+    q->head_cache = atomic_load_explicit(&q->head, memory_order_acquire);
+    if (tail - q->head_cache == a2_spsc_capacity(q))
+      return NULL;
+  }
+  return a2_spsc_slot(q, tail);
+}
+
+/// Consumer: return the first element, or NULL if the ring is empty. The
+/// element is freed with `a2_spsc_release(q, 1)`.
+static inline void *a2_spsc_front(a2_spsc_t *q) {
+  unsigned head = atomic_load_explicit(&q->head, memory_order_relaxed);
+  if (head == q->tail_cache) {
+    q->tail_cache = atomic_load_explicit(&q->tail, memory_order_acquire);
+    if (head == q->tail_cache)
+      return NULL;
+  }
+  return a2_spsc_slot(q, head);
+}
+
+/// Producer: push one element. Return false if the ring is full.
+static inline bool a2_spsc_push1(a2_spsc_t *q, const void *elem) {
+  void *slot = a2_spsc_reserve1(q);
+  if (!slot)
+    return false;
+  memcpy(slot, elem, q->elem_size);
+  a2_spsc_commit(q, 1);
+  return true;
+}
+
+/// Consumer: pop one element. Return false if the ring is empty.
+static inline bool a2_spsc_pop1(a2_spsc_t *q, void *elem) {
+  const void *slot = a2_spsc_front(q);
+  if (!slot)
+    return false;
+  memcpy(elem, slot, q->elem_size);
+  a2_spsc_release(q, 1);
+  return true;
+}
+
+#ifdef __cplusplus
+}
+
+/// A typed wrapper of a2_spsc_t.
+template <typename T>
+class SPSCRing {
+  static_assert(std::is_trivially_copyable<T>::value, "elements are copied with memcpy()");
+
+public:
+  /// A range of elements, possibly split in two.
+  struct Parts {
+    T *part1;
+    unsigned count1;
+    T *part2;
+    unsigned count2;
+
+    unsigned size() const {
+      return count1 + count2;
+    }
+    T &operator[](unsigned i) const {
+      return i < count1 ? part1[i] : part2[i - count1];
+    }
+  };
+
+  /// \param capacity - the capacity in elements. Must be a power of 2.
+  explicit SPSCRing(unsigned capacity) {
+    if (!a2_spsc_init(&q_, capacity, sizeof(T)))
+      throw std::bad_alloc();
+  }
+  ~SPSCRing() {
+    a2_spsc_free(&q_);
+  }
+  SPSCRing(const SPSCRing &) = delete;
+  SPSCRing &operator=(const SPSCRing &) = delete;
+
+  unsigned capacity() const {
+    return a2_spsc_capacity(&q_);
+  }
+
+  // Producer.
+
+  unsigned space() {
+    return a2_spsc_space(&q_);
+  }
+  bool push(const T &v) {
+    T *slot = (T *)a2_spsc_reserve1(&q_);
+    if (!slot)
+      return false;
+    *slot = v;
+    a2_spsc_commit(&q_, 1);
+    return true;
+  }
+  unsigned push(const T *src, unsigned count) {
+    return a2_spsc_push(&q_, src, count);
+  }
+  Parts reserve(unsigned max) {
+    return toParts(a2_spsc_reserve(&q_, max));
+  }
+  void commit(unsigned count) {
+    a2_spsc_commit(&q_, count);
+  }
+
+  // Consumer.
+
+  unsigned count() {
+    return a2_spsc_count(&q_);
+  }
+  /// Return the first element or nullptr if the ring is empty.
+  T *front() {
+    return (T *)a2_spsc_front(&q_);
+  }
+  bool pop(T &v) {
+    T *slot = front();
+    if (!slot)
+      return false;
+    v = *slot;
+    a2_spsc_release(&q_, 1);
+    return true;
+  }
+  unsigned pop(T *dst, unsigned count) {
+    return a2_spsc_pop(&q_, dst, count);
+  }
+  Parts peek(unsigned max) {
+    return toParts(a2_spsc_peek(&q_, max));
+  }
+  void release(unsigned count) {
+    a2_spsc_release(&q_, count);
+  }
+
+  // Any thread.
+
+  unsigned sizeApprox() const {
+    return a2_spsc_size_approx(&q_);
+  }
+
+private:
+  static Parts toParts(const a2_spsc_parts_t &p) {
+    return {(T *)p.part1, p.count1, (T *)p.part2, p.count2};
+  }
+
+  a2_spsc_t q_;
+};
+#endif
@@ -12,6 +12,22 @@
 #include <stdlib.h>
 #include <string.h>
 
+#ifdef A2_HYBRID
+#include "apple2tc/a2hybrid.h"
+
+/// In hybrid mode, the state is owned by the emulator.
+static a2_hybrid_ctx_t *s_ctx = NULL;
+
+#define s_pc (s_ctx->pc)
+#define s_a (s_ctx->a)
+#define s_x (s_ctx->x)
+#define s_y (s_ctx->y)
+#define s_status (s_ctx->status)
+#define s_sp (s_ctx->sp)
+#define s_cycles (s_ctx->cycles)
+#define s_remaining_cycles (s_ctx->remaining_cycles)
+#define s_ram (s_ctx->ram)
+#else
 static uint16_t s_pc = 0;
 static uint8_t s_a = 0;
 static uint8_t s_x = 0;
@@ -24,10 +40,57 @@ static int s_remaining_cycles = 0;
 
 static uint8_t s_ram[0x10000];
 
+#include "apple2tc/langcard-inc.h"
+#endif
+
+/// The cycle at which run_emulated() must stop, if `s_event_pending`.
+static unsigned s_event_cycle = 0;
+static bool s_event_pending = false;
+/// The part of the cycle budget held back until after the event cycle.
+static int s_deferred_cycles = 0;
+
+void set_event_cycle(unsigned cycle) {
+  s_event_cycle = cycle;
+  s_event_pending = true;
+}
+
+void clear_event_cycle(void) {
+  s_event_pending = false;
+}
+
+/// Add \p run_cycles to the budget of run_emulated(), holding back the part
+/// past the event cycle. That way the run stops at the event without any
+/// additional per-instruction checks.
+static void start_run(unsigned run_cycles) {
+  s_remaining_cycles += s_deferred_cycles + (int)run_cycles;
+  s_deferred_cycles = 0;
+  if (s_event_pending) {
+    int to_event = (int)(s_event_cycle - (unsigned)s_cycles);
+    if (to_event < 0)
+      to_event = 0;
+    if (to_event < s_remaining_cycles) {
+      s_deferred_cycles = s_remaining_cycles - to_event;
+      s_remaining_cycles = to_event;
+    }
+  }
+}
+
 uint8_t g_debug = 0;
 
+#ifdef A2_HYBRID
+/// Return to the emulator before a block below the ROM.
+#define CHECK_NATIVE(pc)            \
+  do {                              \
+    if ((pc) < s_ctx->native_start) \
+      return;                       \
+  } while (0)
+#else
+#define CHECK_NATIVE(pc) (void)0
+#endif
+
 #define CYCLES(pc, cycles)                                                 \
   do {                                                                     \
+    CHECK_NATIVE(pc);                                                      \
     s_cycles += (cycles);                                                  \
     s_remaining_cycles -= (cycles);                                        \
     if ((g_debug & DebugASM) && (!(g_debug & DebugEmu) || branchTarget)) { \
@@ -44,6 +107,9 @@ void reset_regs(void) {
   s_y = 0;
   s_status = STATUS_IGNORED;
   s_sp = 0xFF;
+#ifndef A2_HYBRID
+  lc_reset();
+#endif
 }
 
 void set_regs(regs_t r) {
@@ -67,9 +133,19 @@ const uint8_t *get_ram(void) {
   return s_ram;
 }
 static inline void ram_poke_impl(uint16_t addr, uint8_t value) {
+#ifdef A2_HYBRID
+  uint8_t *page = s_ctx->write_pages[addr >> 8];
+  if (page)
+    page[addr & 0xFF] = value;
+  else
+    s_ctx->poke_slow(s_ctx, addr, value);
+#else
   if (g_debug & DebugMem)
     printf("$%04x: $%04x=$%02x\n", s_pc, addr, value);
   s_ram[addr] = value;
+  if (addr >= 0x0400 && addr < 0x6000)
+    video_ram_written(addr);
+#endif
 }
 void ram_poke(uint16_t addr, uint8_t value) {
   ram_poke_impl(addr, value);
@@ -96,18 +172,37 @@ static uint16_t peek16_zpg(uint8_t addr) {
 }
 
 static uint8_t peek(uint16_t addr) {
+#ifdef A2_HYBRID
+  // The emulator handles the language card.
   if (addr >= 0xC000 && addr <= 0xCFFF)
     return io_peek(addr);
   return s_ram[addr];
+#else
+  if (addr < 0xC000)
+    return s_ram[addr];
+  if (addr >= 0xD000)
+    return lc_peek(addr);
+  if ((addr & 0xFFF0) == LC_SWITCHES) {
+    lc_access(addr, false);
+    return 0;
+  }
+  return io_peek(addr);
+#endif
 }
 static inline void poke(uint16_t addr, uint8_t value) {
-  if (addr < 0xC000) {
+#ifdef A2_HYBRID
+  // The emulator knows which pages are RAM.
+  ram_poke_impl(addr, value);
+#else
+  if (addr < 0xC000)
     ram_poke_impl(addr, value);
-  } else if (addr <= 0xCFFF) {
+  else if (addr >= 0xD000)
+    lc_poke(addr, value);
+  else if ((addr & 0xFFF0) == LC_SWITCHES)
+    lc_access(addr, true);
+  else
     io_poke(addr, value);
-  } else {
-    // Ignore writes to ROM.
-  }
+#endif
 }
 static uint16_t peek16(uint16_t addr) {
   return peek(addr) + (peek(addr + 1) << 8);
@@ -231,4 +326,97 @@ static uint8_t sbc_decimal(uint8_t a, uint8_t b) {
   return (ah << 4) | (al & 15);
 }
 
-void shutdown_emulated(void) {}
+/// Execute the outer loop of the Monitor WAIT routine at the top of its
+/// iteration (PHA, then A times SBC #1 and BNE, then PLA, SBC #1, BNE) for A
+/// down to 1, adding the same cycles as the generated blocks, which cost
+/// \p pha, \p inner and \p outer cycles. Only the iterations that fit in the
+/// remaining cycles are executed, so a long delay still stops at events.
+/// Return false if not even one iteration was executed.
+static inline bool wait_fast(int pha, int inner, int outer) {
+  if (!s_a || !(s_status & STATUS_C) || (s_status & STATUS_D) || (g_debug & DebugASM))
+    return false;
+  uint8_t a = s_a;
+  uint8_t pushed = 0;
+  int cycles = 0;
+  while (a && cycles + pha + a * inner + outer <= s_remaining_cycles) {
+    cycles += pha + a * inner + outer;
+    pushed = a--;
+  }
+  if (!pushed)
+    return false;
+  s_cycles += cycles;
+  s_remaining_cycles -= cycles;
+  push8(pushed);
+  pop8();
+  s_a = update_nz(a);
+  // SBC #1 overflows only from $80 to $7F.
+  s_status = (s_status & ~STATUS_V) | (a == 0x7F ? STATUS_V : 0);
+  return true;
+}
+
+#ifndef A2_HYBRID
+#include "apple2tc/interp6502-inc.h"
+#endif
+
+/// The address run_emulated() dispatches on. Code in the language card RAM is
+/// not the code which was decompiled, so it goes to unknown_code_address().
+static inline unsigned dispatch_pc(void) {
+#ifdef A2_HYBRID
+  return s_pc;
+#else
+  return lc_runs_ram(s_pc) ? 0x10000 : s_pc;
+#endif
+}
+
+/// Invoked when execution reaches an address which wasn't decompiled.
+/// Interpret one instruction, like the emulator, and return true. Return false
+/// if run_emulated() must return instead.
+static bool unknown_code_address(void) {
+#ifdef A2_HYBRID
+  // Leave it to the emulator.
+  return false;
+#else
+  if (g_debug & DebugASM)
+    debug_asm(s_pc);
+  interp_note_entry(s_pc);
+  regs_t r = get_regs();
+  interp_step(&r);
+  set_regs(r);
+  s_interp_next_pc = s_pc;
+  // The emulator counts 3 cycles per instruction.
+  s_cycles += 3;
+  s_remaining_cycles -= 3;
+  return true;
+#endif
+}
+
+void shutdown_emulated(void) {
+#ifndef A2_HYBRID
+  save_missed_code();
+#endif
+}
+
+#ifdef A2_HYBRID
+#define A2_HYBRID_EXPORT __attribute__((visibility("default")))
+
+uint8_t io_peek(uint16_t addr) {
+  return s_ctx->io_peek(s_ctx, addr);
+}
+void io_poke(uint16_t addr, uint8_t value) {
+  s_ctx->poke_slow(s_ctx, addr, value);
+}
+void debug_asm(uint16_t pc) {}
+void error_handler(uint16_t pc) {}
+void video_ram_written(uint16_t addr) {}
+
+static void hybrid_run(a2_hybrid_ctx_t *ctx) {
+  s_ctx = ctx;
+  run_emulated(0);
+  s_ctx = NULL;
+}
+
+A2_HYBRID_EXPORT const a2_hybrid_module_t *a2_hybrid_module(void) {
+  static const a2_hybrid_module_t module = {.version = A2_HYBRID_VERSION, .run = hybrid_run};
+  return &module;
+}
+#endif
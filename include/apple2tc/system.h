@@ -62,10 +62,23 @@ uint8_t ram_peek(uint16_t addr);
 uint16_t ram_peek16(uint16_t addr);
 
 void init_emulated(void);
+/// Run for \p run_cycles more cycles. The cycles run in excess of the budget
+/// are deducted from the next call. If an event cycle is set, stop at the
+/// first instruction boundary at or after it instead, keeping the rest of the
+/// budget for the next call, which may be `run_emulated(0)`.
 void run_emulated(unsigned run_cycles);
 void shutdown_emulated(void);
+/// Make run_emulated() stop at \p cycle, so an external event, like a key
+/// press, can be delivered at an exact cycle.
+void set_event_cycle(unsigned cycle);
+void clear_event_cycle(void);
+/// Code which wasn't decompiled is interpreted. Save its entry points on
+/// shutdown into the specified file, as runtime data for apple2tc.
+void set_missed_code_log(const char *path);
 
 uint8_t io_peek(uint16_t addr);
 void io_poke(uint16_t addr, uint8_t value);
 void debug_asm(uint16_t pc);
 void error_handler(uint16_t pc);
+/// Invoked after a write to the text or hires video pages ($0400-$5FFF).
+void video_ram_written(uint16_t addr);
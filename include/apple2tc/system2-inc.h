@@ -36,6 +36,8 @@ static uint8_t s_status_c = 0;
 
 static uint8_t s_ram[0x10000];
 
+#include "apple2tc/langcard-inc.h"
+
 static unsigned s_cycles = 0;
 uint8_t g_debug = 0;
 
@@ -53,6 +55,7 @@ void reset_regs(void) {
   s_status_not_z = 1;
   s_status_c = 0;
   s_sp = 0xFF;
+  lc_reset();
 }
 
 void set_regs(regs_t r) {
@@ -92,6 +95,8 @@ static inline void ram_poke_impl(uint16_t addr, uint8_t value) {
   if (g_debug & DebugMem)
     printf("%8u $%04x: $%04x=$%02x\n", s_cycles, s_pc, addr, value);
   s_ram[addr] = value;
+  if (addr >= 0x0400 && addr < 0x6000)
+    video_ram_written(addr);
 }
 void ram_poke(uint16_t addr, uint8_t value) {
   ram_poke_impl(addr, value);
@@ -118,18 +123,25 @@ static uint16_t peek16_zpg(uint8_t addr) {
 }
 
 static uint8_t peek(uint16_t addr) {
-  if (addr >= 0xC000 && addr <= 0xCFFF)
-    return io_peek(addr);
-  return s_ram[addr];
+  if (addr < 0xC000)
+    return s_ram[addr];
+  if (addr >= 0xD000)
+    return lc_peek(addr);
+  if ((addr & 0xFFF0) == LC_SWITCHES) {
+    lc_access(addr, false);
+    return 0;
+  }
+  return io_peek(addr);
 }
 static inline void poke(uint16_t addr, uint8_t value) {
-  if (addr < 0xC000) {
+  if (addr < 0xC000)
     ram_poke_impl(addr, value);
-  } else if (addr <= 0xCFFF) {
+  else if (addr >= 0xD000)
+    lc_poke(addr, value);
+  else if ((addr & 0xFFF0) == LC_SWITCHES)
+    lc_access(addr, true);
+  else
     io_poke(addr, value);
-  } else {
-    // Ignore writes to ROM.
-  }
 }
 static uint16_t peek16(uint16_t addr) {
   return peek(addr) + (peek(addr + 1) << 8);
@@ -207,6 +219,8 @@ static struct ResAndStatus sbc_decimal(uint8_t a, uint8_t b, uint8_t cf) {
   return (struct ResAndStatus){.result = (ah << 4) | (al & 15), .status = status};
 }
 
+#include "apple2tc/interp6502-inc.h"
+
 static bool s_initialized = false;
 static thrd_t s_emu_thread;
 static cnd_t s_emu_cond;
@@ -215,6 +229,38 @@ static int s_emu_enabled = 0; // 0: disabled. 1: enabled. -1: stop.
 
 static int s_remaining_cycles;
 
+/// The cycle at which run_emulated() must stop, if `s_event_pending`.
+static unsigned s_event_cycle = 0;
+static bool s_event_pending = false;
+/// The part of the cycle budget held back until after the event cycle.
+static int s_deferred_cycles = 0;
+
+void set_event_cycle(unsigned cycle) {
+  s_event_cycle = cycle;
+  s_event_pending = true;
+}
+
+void clear_event_cycle(void) {
+  s_event_pending = false;
+}
+
+/// Add \p run_cycles to the budget of run_emulated(), holding back the part
+/// past the event cycle. That way the run stops at the event without any
+/// additional per-instruction checks.
+static void start_run(unsigned run_cycles) {
+  s_remaining_cycles += s_deferred_cycles + (int)run_cycles;
+  s_deferred_cycles = 0;
+  if (s_event_pending) {
+    int to_event = (int)(s_event_cycle - (unsigned)s_cycles);
+    if (to_event < 0)
+      to_event = 0;
+    if (to_event < s_remaining_cycles) {
+      s_deferred_cycles = s_remaining_cycles - to_event;
+      s_remaining_cycles = to_event;
+    }
+  }
+}
+
 static void emulated_entry_point(void);
 
 static int emulated_thread(void *arg) {
@@ -252,6 +298,94 @@ static void cycles_expired() {
     }                                                                      \
   } while (0)
 
+/// Invoked when execution reaches \p addr, which wasn't decompiled. Interpret
+/// one instruction, like the emulator, and return the address of the next one.
+static uint16_t interpret_unknown(uint16_t addr) {
+  s_pc = addr;
+  if (s_remaining_cycles <= 0)
+    cycles_expired();
+  // The emulator counts 3 cycles per instruction.
+  s_cycles += 3;
+  s_remaining_cycles -= 3;
+  if (g_debug & DebugASM)
+    debug_asm(addr);
+
+  interp_note_entry(addr);
+  regs_t r = get_regs();
+  interp_step(&r);
+  set_regs(r);
+  s_interp_next_pc = r.pc;
+  return r.pc;
+}
+
+/// A generated function being executed. Functions called with a return
+/// address push it on the 6502 stack, and pop it when they return.
+typedef struct {
+  /// The return address, or 0.
+  uint16_t ret_addr;
+  /// The stack pointer after pushing the return address.
+  uint8_t sp;
+} native_frame_t;
+
+/// The generated functions being executed, innermost last, so interpreted code
+/// returning to one of their callers can unwind them. Only the outermost
+/// NATIVE_FRAMES are recorded.
+#define NATIVE_FRAMES 1024
+static native_frame_t s_native_frames[NATIVE_FRAMES];
+static unsigned s_native_depth = 0;
+
+/// Returned by find_block_id_*() when the function must return, because
+/// interpreted code returned to one of its callers.
+#define UNWIND_BLOCK_ID (~0u)
+
+/// Invoked on entry to a generated function. Return its depth: it must return
+/// if, after any call, `s_native_depth` is not larger.
+static inline unsigned native_enter(uint16_t ret_addr) {
+  if (ret_addr)
+    push16(ret_addr); // Fake return address.
+  unsigned depth = s_native_depth++;
+  if (depth < NATIVE_FRAMES)
+    s_native_frames[depth] = (native_frame_t){.ret_addr = ret_addr, .sp = s_sp};
+  return depth;
+}
+
+/// Invoked when a generated function returns normally.
+static inline void native_return(uint16_t ret_addr) {
+  if (ret_addr)
+    pop16();
+  --s_native_depth;
+}
+
+/// Interpreted code reached the entry point of the generated function \p fn.
+/// Run it natively. If the code returned to a caller of the current function,
+/// return true. Otherwise store the address following its RTS in \p addr.
+static bool native_call(void (*fn)(uint16_t ret_addr), uint16_t *addr) {
+  unsigned depth = s_native_depth;
+  // The return address is already on the stack, so it is left to the RTS.
+  fn(0);
+  if (s_native_depth < depth)
+    return true;
+  *addr = pop16() + 1;
+  // Returning there isn't a new entry point.
+  s_interp_next_pc = *addr;
+  return false;
+}
+
+/// Execution reached \p addr in interpreted code. If that popped the return
+/// address of a generated function, unwind it and the functions it called, and
+/// return true.
+static bool native_unwind(uint16_t addr) {
+  unsigned depth = s_native_depth < NATIVE_FRAMES ? s_native_depth : NATIVE_FRAMES;
+  while (depth--) {
+    const native_frame_t *f = &s_native_frames[depth];
+    if (f->ret_addr && (uint16_t)(f->ret_addr + 1) == addr && (uint8_t)(f->sp + 2) == s_sp) {
+      s_native_depth = depth;
+      return true;
+    }
+  }
+  return false;
+}
+
 void run_emulated(unsigned run_cycles) {
   if (!s_initialized) {
     s_initialized = true;
@@ -267,13 +401,11 @@ void run_emulated(unsigned run_cycles) {
       abort();
   }
   assert((int)run_cycles >= 0 && "run_cycles must be a non-negative int");
-  if (run_cycles == 0)
-    return;
 
   mtx_lock(&s_emu_mutex);
   assert(!s_emu_enabled);
 
-  s_remaining_cycles += (int)run_cycles;
+  start_run(run_cycles);
   if (s_remaining_cycles <= 0) {
     mtx_unlock(&s_emu_mutex);
     return;
@@ -287,11 +419,12 @@ void run_emulated(unsigned run_cycles) {
 }
 
 void shutdown_emulated(void) {
-  if (!s_initialized)
-    return; // Nothing to do.
-  mtx_lock(&s_emu_mutex);
-  s_emu_enabled = -1;
-  cnd_signal(&s_emu_cond);
-  mtx_unlock(&s_emu_mutex);
-  thrd_join(s_emu_thread, NULL);
+  if (s_initialized) {
+    mtx_lock(&s_emu_mutex);
+    s_emu_enabled = -1;
+    cnd_signal(&s_emu_cond);
+    mtx_unlock(&s_emu_mutex);
+    thrd_join(s_emu_thread, NULL);
+  }
+  save_missed_code();
 }
@@ -0,0 +1,255 @@
+/*
+ * Copyright (c) Tzvetan Mikov.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "apple2tc/a2capture.h"
+
+#include "apple2tc/spsc.h"
+#include "c11threads/c11threads.h"
+
+#include <stdlib.h>
+
+typedef struct {
+  uint32_t ms;
+  a2_screen8 screen;
+} CaptureSlot;
+
+struct a2_capture {
+  FILE *f;
+  thrd_t thread;
+
+  /// The frame queue. Slots are filled in place by the emulation thread and
+  /// encoded in place by the encoder thread.
+  a2_spsc_t queue;
+  CaptureSlot slots[A2_CAPTURE_QUEUE_SIZE];
+  /// Set when the encoder thread should exit after draining the queue.
+  atomic_bool closing;
+
+  /// Number of dropped frames. Accessed only by the emulation thread.
+  unsigned dropped;
+  /// Set by the encoder thread on write error.
+  bool error;
+
+  /// The last encoded frame. Accessed only by the encoder thread.
+  a2_screen8 prev;
+  /// Encoding buffer for one frame. Accessed only by the encoder thread.
+  uint8_t buf[4 + A2_SCREEN_H / 8 + A2_SCREEN_H * (A2_SCREEN_W + A2_SCREEN_W / 128 + 1)];
+};
+
+static inline uint8_t *put_u16(uint8_t *p, uint16_t v) {
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+  return p + 2;
+}
+
+static inline uint8_t *put_u32(uint8_t *p, uint32_t v) {
+  p = put_u16(p, (uint16_t)v);
+  return put_u16(p, (uint16_t)(v >> 16));
+}
+
+/// Encode the XOR of two scanlines into \p d and return the end of the output.
+static uint8_t *encode_line(uint8_t *d, const uint8_t *cur, const uint8_t *prev) {
+  unsigned x = 0;
+  while (x != A2_SCREEN_W) {
+    unsigned start = x;
+    if (cur[x] == prev[x]) {
+      while (x != A2_SCREEN_W && x - start != 128 && cur[x] == prev[x])
+        ++x;
+      *d++ = (uint8_t)(x - start - 1);
+    } else {
+      uint8_t *token = d++;
+      while (x != A2_SCREEN_W && x - start != 128 && cur[x] != prev[x])
+        *d++ = cur[x] ^ prev[x], ++x;
+      *token = (uint8_t)(0x7F + x - start);
+    }
+  }
+  return d;
+}
+
+static void encode_frame(a2_capture_t *cap, const CaptureSlot *slot) {
+  uint8_t *d = put_u32(cap->buf, slot->ms);
+  uint8_t *changed = d;
+  memset(changed, 0, A2_SCREEN_H / 8);
+  d += A2_SCREEN_H / 8;
+
+  for (unsigned y = 0; y != A2_SCREEN_H; ++y) {
+    const uint8_t *cur = slot->screen.data + y * A2_SCREEN_W;
+    uint8_t *prev = cap->prev.data + y * A2_SCREEN_W;
+    if (memcmp(cur, prev, A2_SCREEN_W) == 0)
+      continue;
+    changed[y / 8] |= 1 << (y % 8);
+    d = encode_line(d, cur, prev);
+    memcpy(prev, cur, A2_SCREEN_W);
+  }
+
+  if (fwrite(cap->buf, 1, d - cap->buf, cap->f) != (size_t)(d - cap->buf))
+    cap->error = true;
+}
+
+static int encoder_thread(void *arg) {
+  a2_capture_t *cap = (a2_capture_t *)arg;
+  for (;;) {
+    const CaptureSlot *slot = (const CaptureSlot *)a2_spsc_front(&cap->queue);
+    if (!slot) {
+      // The emulation thread never waits for us, so polling is fine here.
+      if (atomic_load_explicit(&cap->closing, memory_order_acquire) &&
+          !a2_spsc_count(&cap->queue)) {
+        break;
+      }
+      struct timespec ts = {.tv_sec = 0, .tv_nsec = 2000000};
+      thrd_sleep(&ts, NULL);
+      continue;
+    }
+    encode_frame(cap, slot);
+    a2_spsc_release(&cap->queue, 1);
+  }
+  return 0;
+}
+
+a2_capture_t *a2_capture_open(const char *path) {
+  a2_capture_t *cap = (a2_capture_t *)calloc(1, sizeof(a2_capture_t));
+  if (!cap)
+    return NULL;
+  if (!(cap->f = fopen(path, "wb"))) {
+    perror(path);
+    free(cap);
+    return NULL;
+  }
+  // Frames are written in pieces of a few KB, let stdio combine them.
+  setvbuf(cap->f, NULL, _IOFBF, 256 * 1024);
+
+  uint8_t hdr[8 + 4 + 16 * 3];
+  memcpy(hdr, A2_CAPTURE_MAGIC, 8);
+  uint8_t *p = put_u16(hdr + 8, A2_SCREEN_W);
+  p = put_u16(p, A2_SCREEN_H);
+  for (unsigned i = 0; i != 16; ++i) {
+    *p++ = a2_palette[i].r;
+    *p++ = a2_palette[i].g;
+    *p++ = a2_palette[i].b;
+  }
+  fwrite(hdr, 1, sizeof(hdr), cap->f);
+
+  a2_spsc_init_buf(&cap->queue, cap->slots, A2_CAPTURE_QUEUE_SIZE, sizeof(CaptureSlot));
+  atomic_init(&cap->closing, false);
+  if (thrd_create(&cap->thread, encoder_thread, cap) != thrd_success) {
+    fprintf(stderr, "%s: failed to start the capture thread\n", path);
+    fclose(cap->f);
+    free(cap);
+    return NULL;
+  }
+  return cap;
+}
+
+bool a2_capture_frame(a2_capture_t *cap, const a2_screen8 *screen, uint32_t ms) {
+  CaptureSlot *slot = (CaptureSlot *)a2_spsc_reserve1(&cap->queue);
+  if (!slot) {
+    ++cap->dropped;
+    return false;
+  }
+  slot->ms = ms;
+  memcpy(&slot->screen, screen, sizeof(*screen));
+  a2_spsc_commit(&cap->queue, 1);
+  return true;
+}
+
+bool a2_capture_close(a2_capture_t *cap) {
+  atomic_store_explicit(&cap->closing, true, memory_order_release);
+  thrd_join(cap->thread, NULL);
+
+  bool ok = !cap->error && !cap->dropped;
+  if (fclose(cap->f) != 0)
+    ok = false;
+  if (cap->dropped)
+    fprintf(stderr, "capture: %u frames dropped\n", cap->dropped);
+  free(cap);
+  return ok;
+}
+
+static bool read_u16(FILE *f, unsigned *v) {
+  uint8_t b[2];
+  if (fread(b, 1, 2, f) != 2)
+    return false;
+  *v = b[0] | (b[1] << 8);
+  return true;
+}
+
+bool a2_capture_reader_open(a2_capture_reader_t *rd, const char *path) {
+  memset(rd, 0, sizeof(*rd));
+  if (!(rd->f = fopen(path, "rb"))) {
+    perror(path);
+    return false;
+  }
+
+  char magic[8];
+  uint8_t pal[16 * 3];
+  if (fread(magic, 1, 8, rd->f) != 8 || memcmp(magic, A2_CAPTURE_MAGIC, 8) != 0 ||
+      !read_u16(rd->f, &rd->width) || !read_u16(rd->f, &rd->height) ||
+      fread(pal, 1, sizeof(pal), rd->f) != sizeof(pal)) {
+    fprintf(stderr, "%s: not a capture file\n", path);
+    a2_capture_reader_close(rd);
+    return false;
+  }
+  if (rd->width != A2_SCREEN_W || rd->height != A2_SCREEN_H) {
+    fprintf(stderr, "%s: unsupported capture size %ux%u\n", path, rd->width, rd->height);
+    a2_capture_reader_close(rd);
+    return false;
+  }
+  for (unsigned i = 0; i != 16; ++i)
+    rd->palette[i] = (a2_rgba8){pal[i * 3], pal[i * 3 + 1], pal[i * 3 + 2], 0xFF};
+  return true;
+}
+
+/// Decode a frame, returning false if the data is truncated or invalid.
+static bool decode_frame(a2_capture_reader_t *rd, const uint8_t *hdr) {
+  const uint8_t *changed = hdr + 4;
+  for (unsigned y = 0; y != A2_SCREEN_H; ++y) {
+    if (!(changed[y / 8] & (1 << (y % 8))))
+      continue;
+    uint8_t *d = rd->screen.data + y * A2_SCREEN_W;
+    unsigned x = 0;
+    while (x != A2_SCREEN_W) {
+      int token = getc(rd->f);
+      if (token == EOF)
+        return false;
+      unsigned len = token < 0x80 ? token + 1 : token - 0x7F;
+      if (len > A2_SCREEN_W - x)
+        return false;
+      if (token >= 0x80) {
+        for (unsigned e = x + len; x != e; ++x) {
+          int v = getc(rd->f);
+          if (v == EOF)
+            return false;
+          d[x] ^= (uint8_t)v;
+        }
+      } else {
+        x += len;
+      }
+    }
+  }
+  return true;
+}
+
+bool a2_capture_reader_next(a2_capture_reader_t *rd) {
+  uint8_t hdr[4 + A2_SCREEN_H / 8];
+  size_t len = fread(hdr, 1, sizeof(hdr), rd->f);
+  if (len != sizeof(hdr)) {
+    // A clean EOF is only allowed between frames.
+    rd->error = len != 0;
+    return false;
+  }
+  rd->ms = hdr[0] | (hdr[1] << 8) | (hdr[2] << 16) | ((uint32_t)hdr[3] << 24);
+  if (!decode_frame(rd, hdr)) {
+    rd->error = true;
+    return false;
+  }
+  return true;
+}
+
+void a2_capture_reader_close(a2_capture_reader_t *rd) {
+  if (rd->f)
+    fclose(rd->f);
+  rd->f = NULL;
+}
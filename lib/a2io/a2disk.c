@@ -0,0 +1,380 @@
+/*
+ * Copyright (c) Tzvetan Mikov.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "apple2tc/a2disk.h"
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/// The 16-sector boot PROM (P5A). It reads track 0, sector 0 into $0800 and
+/// jumps to $0801. DOS 3.3 then calls its sector reader at $Cn5C.
+const uint8_t a2_disk_rom[256] = {
+    0xA2, 0x20, 0xA0, 0x00, 0xA2, 0x03, 0x86, 0x3C, 0x8A, 0x0A, 0x24, 0x3C, 0xF0, 0x10, 0x05, 0x3C,
+    0x49, 0xFF, 0x29, 0x7E, 0xB0, 0x08, 0x4A, 0xD0, 0xFB, 0x98, 0x9D, 0x56, 0x03, 0xC8, 0xE8, 0x10,
+    0xE5, 0x20, 0x58, 0xFF, 0xBA, 0xBD, 0x00, 0x01, 0x0A, 0x0A, 0x0A, 0x0A, 0x85, 0x2B, 0xAA, 0xBD,
+    0x8E, 0xC0, 0xBD, 0x8C, 0xC0, 0xBD, 0x8A, 0xC0, 0xBD, 0x89, 0xC0, 0xA0, 0x50, 0xBD, 0x80, 0xC0,
+    0x98, 0x29, 0x03, 0x0A, 0x05, 0x2B, 0xAA, 0xBD, 0x81, 0xC0, 0xA9, 0x56, 0x20, 0xA8, 0xFC, 0x88,
+    0x10, 0xEB, 0x85, 0x26, 0x85, 0x3D, 0x85, 0x41, 0xA9, 0x08, 0x85, 0x27, 0x18, 0x08, 0xBD, 0x8C,
+    0xC0, 0x10, 0xFB, 0x49, 0xD5, 0xD0, 0xF7, 0xBD, 0x8C, 0xC0, 0x10, 0xFB, 0xC9, 0xAA, 0xD0, 0xF3,
+    0xEA, 0xBD, 0x8C, 0xC0, 0x10, 0xFB, 0xC9, 0x96, 0xF0, 0x09, 0x28, 0x90, 0xDF, 0x49, 0xAD, 0xF0,
+    0x25, 0xD0, 0xD9, 0xA0, 0x03, 0x85, 0x40, 0xBD, 0x8C, 0xC0, 0x10, 0xFB, 0x2A, 0x85, 0x3C, 0xBD,
+    0x8C, 0xC0, 0x10, 0xFB, 0x25, 0x3C, 0x88, 0xD0, 0xEC, 0x28, 0xC5, 0x3D, 0xD0, 0xBE, 0xA5, 0x40,
+    0xC5, 0x41, 0xD0, 0xB8, 0xB0, 0xB7, 0xA0, 0x56, 0x84, 0x3C, 0xBC, 0x8C, 0xC0, 0x10, 0xFB, 0x59,
+    0xD6, 0x02, 0xA4, 0x3C, 0x88, 0x99, 0x00, 0x03, 0xD0, 0xEE, 0x84, 0x3C, 0xBC, 0x8C, 0xC0, 0x10,
+    0xFB, 0x59, 0xD6, 0x02, 0xA4, 0x3C, 0x91, 0x26, 0xC8, 0xD0, 0xEF, 0xBC, 0x8C, 0xC0, 0x10, 0xFB,
+    0x59, 0xD6, 0x02, 0xD0, 0x87, 0xA0, 0x00, 0xA2, 0x56, 0xCA, 0x30, 0xFB, 0xB1, 0x26, 0x5E, 0x00,
+    0x03, 0x2A, 0x5E, 0x00, 0x03, 0x2A, 0x91, 0x26, 0xC8, 0xD0, 0xEE, 0xE6, 0x27, 0xE6, 0x3D, 0xA5,
+    0x3D, 0xCD, 0x00, 0x08, 0xA6, 0x2B, 0x90, 0xDB, 0x4C, 0x01, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+/// The volume number written in the address fields.
+#define DISK_VOLUME 254
+/// Sync nibbles before the first sector, between the address and data fields,
+/// and after every sector.
+#define GAP1 48
+#define GAP2 6
+#define GAP3 27
+/// The number of nibbles of 6-and-2 encoded data, including the checksum.
+#define DATA_NIBBLES 343
+
+/// The logical sector stored in every physical sector.
+static const uint8_t s_dos_order[A2_DISK_SECTORS] = {
+    0, 7, 14, 6, 13, 5, 12, 4, 11, 3, 10, 2, 9, 1, 8, 15};
+static const uint8_t s_prodos_order[A2_DISK_SECTORS] = {
+    0, 8, 1, 9, 2, 10, 3, 11, 4, 12, 5, 13, 6, 14, 7, 15};
+
+/// The disk nibbles of the 64 6-bit values.
+static const uint8_t s_nibbles[64] = {
+    0x96, 0x97, 0x9A, 0x9B, 0x9D, 0x9E, 0x9F, 0xA6, 0xA7, 0xAB, 0xAC, 0xAD, 0xAE, 0xAF, 0xB2, 0xB3,
+    0xB4, 0xB5, 0xB6, 0xB7, 0xB9, 0xBA, 0xBB, 0xBC, 0xBD, 0xBE, 0xBF, 0xCB, 0xCD, 0xCE, 0xCF, 0xD3,
+    0xD6, 0xD7, 0xD9, 0xDA, 0xDB, 0xDC, 0xDD, 0xDE, 0xDF, 0xE5, 0xE6, 0xE7, 0xE9, 0xEA, 0xEB, 0xEC,
+    0xED, 0xEE, 0xEF, 0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF9, 0xFA, 0xFB, 0xFC, 0xFD, 0xFE, 0xFF,
+};
+
+/// Return the offset in the image of physical sector \p sector of \p track.
+static size_t sector_offset(const a2_disk_drive_t *drv, unsigned track, unsigned sector) {
+  const uint8_t *order = drv->order == A2_DISK_ORDER_PRODOS ? s_prodos_order : s_dos_order;
+  return ((size_t)track * A2_DISK_SECTORS + order[sector]) * A2_DISK_SECTOR_SIZE;
+}
+
+static uint8_t *put_sync(uint8_t *d, unsigned count) {
+  memset(d, 0xFF, count);
+  return d + count;
+}
+
+/// Encode a byte with the 4-and-4 encoding of the address fields.
+static uint8_t *put_44(uint8_t *d, uint8_t v) {
+  *d++ = (v >> 1) | 0xAA;
+  *d++ = v | 0xAA;
+  return d;
+}
+
+/// Encode 256 bytes with the 6-and-2 encoding into DATA_NIBBLES nibbles.
+static uint8_t *put_62(uint8_t *d, const uint8_t *data) {
+  // The low two bits of every byte, swapped, are packed in 86 values: bytes i,
+  // i + 86 and i + 172 go to value i. They are followed by the high 6 bits.
+  uint8_t values[86 + 256];
+  memset(values, 0, 86);
+  for (unsigned i = 0; i != 256; ++i) {
+    uint8_t v = data[i];
+    values[i % 86] |= (((v & 1) << 1) | ((v >> 1) & 1)) << (i / 86 * 2);
+    values[86 + i] = v >> 2;
+  }
+  // Every value is stored XOR-ed with the previous one, followed by the last
+  // one as a checksum.
+  uint8_t prev = 0;
+  for (unsigned i = 0; i != sizeof(values); ++i) {
+    *d++ = s_nibbles[values[i] ^ prev];
+    prev = values[i];
+  }
+  *d++ = s_nibbles[prev];
+  return d;
+}
+
+/// Convert a track of the sector image to nibbles.
+static void nibblize_track(const a2_disk_drive_t *drv, unsigned track, uint8_t *d) {
+  d = put_sync(d, GAP1);
+  for (unsigned sector = 0; sector != A2_DISK_SECTORS; ++sector) {
+    static const uint8_t addrProlog[] = {0xD5, 0xAA, 0x96};
+    static const uint8_t dataProlog[] = {0xD5, 0xAA, 0xAD};
+    static const uint8_t epilog[] = {0xDE, 0xAA, 0xEB};
+
+    memcpy(d, addrProlog, 3);
+    d = put_44(d + 3, DISK_VOLUME);
+    d = put_44(d, track);
+    d = put_44(d, sector);
+    d = put_44(d, DISK_VOLUME ^ track ^ sector);
+    memcpy(d, epilog, 3);
+    d = put_sync(d + 3, GAP2);
+
+    memcpy(d, dataProlog, 3);
+    d = put_62(d + 3, drv->image + sector_offset(drv, track, sector));
+    memcpy(d, epilog, 3);
+    d = put_sync(d + 3, GAP3);
+  }
+}
+
+/// Decode the data fields of a written track back into the sector image.
+/// Sectors which can't be decoded are left unchanged.
+static void denibblize_track(a2_disk_drive_t *drv, unsigned track) {
+  uint8_t inverse[256];
+  memset(inverse, 0xFF, sizeof(inverse));
+  for (unsigned i = 0; i != 64; ++i)
+    inverse[s_nibbles[i]] = i;
+
+  const uint8_t *nib = drv->tracks[track];
+  const unsigned N = A2_DISK_TRACK_NIBBLES;
+#define NIB(i) nib[(i) % N]
+
+  for (unsigned i = 0; i != N; ++i) {
+    if (NIB(i) != 0xD5 || NIB(i + 1) != 0xAA || NIB(i + 2) != 0x96)
+      continue;
+    unsigned sector = ((NIB(i + 7) << 1) | 1) & NIB(i + 8);
+    if (sector >= A2_DISK_SECTORS)
+      continue;
+
+    // The data field follows shortly, before the next address field.
+    for (unsigned j = i + 14, e = j + 64; j != e; ++j) {
+      if (NIB(j) != 0xD5 || NIB(j + 1) != 0xAA)
+        continue;
+      if (NIB(j + 2) != 0xAD)
+        break;
+
+      uint8_t data[86 + 256];
+      uint8_t prev = 0;
+      bool ok = true;
+      for (unsigned k = 0; k != DATA_NIBBLES && ok; ++k) {
+        uint8_t v = inverse[NIB(j + 3 + k)];
+        if (v == 0xFF)
+          ok = false;
+        else if (k != DATA_NIBBLES - 1)
+          prev = data[k] = v ^ prev;
+        else
+          ok = v == prev;
+      }
+      if (!ok)
+        break;
+
+      uint8_t *d = drv->image + sector_offset(drv, track, sector);
+      for (unsigned k = 0; k != 256; ++k) {
+        uint8_t low = (data[k % 86] >> (k / 86 * 2)) & 3;
+        d[k] = (data[86 + k] << 2) | ((low & 1) << 1) | (low >> 1);
+      }
+      break;
+    }
+  }
+#undef NIB
+}
+
+/// Return the nibbles of the track under the head, or NULL if there is no
+/// disk.
+static uint8_t *cur_track(a2_disk_drive_t *drv) {
+  if (!drv->image)
+    return NULL;
+  unsigned track = drv->half_track >> 1;
+  if (!drv->tracks[track]) {
+    if (!(drv->tracks[track] = (uint8_t *)malloc(A2_DISK_TRACK_NIBBLES)))
+      return NULL;
+    nibblize_track(drv, track, drv->tracks[track]);
+  }
+  return drv->tracks[track];
+}
+
+/// Decode the written tracks into the image. They stay cached.
+static void decode_dirty_tracks(a2_disk_drive_t *drv) {
+  for (unsigned track = 0; track != A2_DISK_TRACKS; ++track) {
+    if (drv->track_dirty[track]) {
+      denibblize_track(drv, track);
+      drv->track_dirty[track] = false;
+      drv->image_dirty = true;
+    }
+  }
+}
+
+/// Save the image to its file if it has been modified.
+static bool save_image(a2_disk_drive_t *drv) {
+  if (!drv->image_dirty || drv->write_protected)
+    return true;
+  FILE *f = fopen(drv->path, "wb");
+  if (!f) {
+    perror(drv->path);
+    return false;
+  }
+  bool ok = fwrite(drv->image, 1, A2_DISK_IMAGE_SIZE, f) == A2_DISK_IMAGE_SIZE;
+  if (fclose(f) != 0)
+    ok = false;
+  if (!ok) {
+    fprintf(stderr, "%s: write error\n", drv->path);
+    return false;
+  }
+  drv->image_dirty = false;
+  return true;
+}
+
+void a2_disk_init(a2_disk_t *disk) {
+  memset(disk, 0, sizeof(*disk));
+}
+
+void a2_disk_done(a2_disk_t *disk) {
+  a2_disk_eject(disk, 0);
+  a2_disk_eject(disk, 1);
+}
+
+/// Return true if \p path ends with \p ext, ignoring the case.
+static bool has_ext(const char *path, const char *ext) {
+  size_t len = strlen(path), extLen = strlen(ext);
+  if (len < extLen)
+    return false;
+  for (const char *p = path + len - extLen; *ext; ++p, ++ext) {
+    if (tolower((unsigned char)*p) != *ext)
+      return false;
+  }
+  return true;
+}
+
+bool a2_disk_load(a2_disk_t *disk, unsigned drive, const char *path) {
+  FILE *f = fopen(path, "rb");
+  if (!f) {
+    perror(path);
+    return false;
+  }
+  uint8_t *image = (uint8_t *)malloc(A2_DISK_IMAGE_SIZE);
+  char *pathCopy = (char *)malloc(strlen(path) + 1);
+  size_t len = image ? fread(image, 1, A2_DISK_IMAGE_SIZE, f) : 0;
+  bool tooLong = fgetc(f) != EOF;
+  fclose(f);
+  if (!image || !pathCopy) {
+    fprintf(stderr, "%s: out of memory\n", path);
+    free(image);
+    free(pathCopy);
+    return false;
+  }
+  if (len != A2_DISK_IMAGE_SIZE || tooLong) {
+    fprintf(stderr, "%s: not a 140KB disk image\n", path);
+    free(image);
+    free(pathCopy);
+    return false;
+  }
+
+  a2_disk_eject(disk, drive);
+  a2_disk_drive_t *drv = &disk->drives[drive];
+  drv->image = image;
+  drv->order = has_ext(path, ".po") ? A2_DISK_ORDER_PRODOS : A2_DISK_ORDER_DOS;
+  drv->path = strcpy(pathCopy, path);
+  if ((f = fopen(path, "r+b")) != NULL)
+    fclose(f);
+  drv->write_protected = f == NULL;
+  return true;
+}
+
+void a2_disk_eject(a2_disk_t *disk, unsigned drive) {
+  a2_disk_drive_t *drv = &disk->drives[drive];
+  if (!drv->image)
+    return;
+  decode_dirty_tracks(drv);
+  save_image(drv);
+  for (unsigned track = 0; track != A2_DISK_TRACKS; ++track)
+    free(drv->tracks[track]);
+  free(drv->image);
+  free(drv->path);
+  unsigned halfTrack = drv->half_track;
+  memset(drv, 0, sizeof(*drv));
+  // The head stays where it was.
+  drv->half_track = halfTrack;
+}
+
+bool a2_disk_flush(a2_disk_t *disk) {
+  bool ok = true;
+  for (unsigned drive = 0; drive != 2; ++drive) {
+    a2_disk_drive_t *drv = &disk->drives[drive];
+    if (!drv->image)
+      continue;
+    decode_dirty_tracks(drv);
+    if (!save_image(drv))
+      ok = false;
+  }
+  return ok;
+}
+
+/// Turn on a stepper motor phase. The head moves half a track towards it, if
+/// it is adjacent to the current position.
+static void phase_on(a2_disk_drive_t *drv, unsigned phase) {
+  if (phase == ((drv->half_track + 1) & 3)) {
+    if (drv->half_track < (A2_DISK_TRACKS - 1) * 2)
+      ++drv->half_track;
+  } else if (phase == ((drv->half_track + 3) & 3)) {
+    if (drv->half_track > 0)
+      --drv->half_track;
+  }
+}
+
+uint8_t a2_disk_io(a2_disk_t *disk, uint16_t addr, bool write, uint8_t value) {
+  a2_disk_drive_t *drv = &disk->drives[disk->drive];
+  unsigned sw = addr & 0xF;
+  uint8_t *track;
+
+  if (sw < 8) {
+    unsigned phase = sw >> 1;
+    if (sw & 1) {
+      disk->phases |= 1 << phase;
+      phase_on(drv, phase);
+    } else {
+      disk->phases &= ~(1 << phase);
+    }
+    return disk->latch;
+  }
+
+  switch (sw) {
+  case 0x8:
+    disk->motor_on = false;
+    break;
+  case 0x9:
+    disk->motor_on = true;
+    break;
+  case 0xA:
+  case 0xB:
+    disk->drive = sw & 1;
+    break;
+  case 0xC:
+    disk->q6 = false;
+    track = disk->motor_on ? cur_track(drv) : NULL;
+    if (track) {
+      if (!disk->q7) {
+        disk->latch = track[drv->pos];
+      } else if (!drv->write_protected) {
+        track[drv->pos] = disk->latch;
+        drv->track_dirty[drv->half_track >> 1] = true;
+      }
+      drv->pos = (drv->pos + 1) % A2_DISK_TRACK_NIBBLES;
+    } else if (disk->motor_on && !disk->q7) {
+      // An empty drive reads amplified noise, so RWTS doesn't find an address
+      // field and times out instead of waiting for a nibble forever.
+      disk->noise = disk->noise * 1103515245 + 12345;
+      disk->latch = disk->noise >> 16;
+    }
+    break;
+  case 0xD:
+    disk->q6 = true;
+    break;
+  case 0xE:
+    disk->q7 = false;
+    // Sense the write protection.
+    if (disk->q6)
+      disk->latch = drv->write_protected ? 0x80 : 0;
+    break;
+  case 0xF:
+    disk->q7 = true;
+    break;
+  }
+
+  // In write mode with Q6 set, a write loads the latch.
+  if (write && disk->q6 && disk->q7)
+    disk->latch = value;
+  return sw & 1 ? 0 : disk->latch;
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) Tzvetan Mikov.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "apple2tc/a2hash.h"
+
+#include <inttypes.h>
+
+#define PRIME32_1 0x9E3779B1u
+#define PRIME32_2 0x85EBCA77u
+#define PRIME64_1 0x9E3779B185EBCA87ull
+#define PRIME64_2 0xC2B2AE3D27D4EB4Full
+
+static inline uint32_t rotl32(uint32_t x, unsigned r) {
+  return (x << r) | (x >> (32 - r));
+}
+
+uint64_t a2_hash_bytes(const void *data, size_t len, uint64_t seed) {
+  const uint8_t *p = (const uint8_t *)data;
+  uint32_t lanes[8];
+  for (unsigned i = 0; i != 8; ++i)
+    lanes[i] = (uint32_t)seed + i * PRIME32_1;
+
+  size_t rem = len;
+  for (; rem >= 32; rem -= 32, p += 32) {
+    uint32_t w[8];
+    memcpy(w, p, 32);
+    for (unsigned i = 0; i != 8; ++i)
+      lanes[i] = rotl32(lanes[i] + w[i] * PRIME32_2, 13) * PRIME32_1;
+  }
+
+  uint64_t h = seed ^ (len * PRIME64_1);
+  for (unsigned i = 0; i != 8; ++i)
+    h = (h ^ lanes[i]) * PRIME64_2;
+  for (; rem; --rem, ++p)
+    h = (h ^ *p) * PRIME64_1;
+
+  // Final avalanche.
+  h ^= h >> 33;
+  h *= PRIME64_2;
+  h ^= h >> 29;
+  h *= PRIME64_1;
+  h ^= h >> 32;
+  return h;
+}
+
+/// The video control bits which affect what is displayed.
+static inline uint8_t video_mode(const a2_iostate_t *io) {
+  return io->vid_control & (A2_VC_TEXT | A2_VC_MIXED | A2_VC_PAGE2 | A2_VC_HIRES);
+}
+
+uint64_t a2_hash_video(const a2_iostate_t *io, const uint8_t *ram) {
+  uint64_t h = video_mode(io);
+  if (a2_io_get_vidmode(io) == A2_VIDMODE_HGR) {
+    h = a2_hash_bytes(ram + a2_io_get_hires_page_offset(io), 0x2000, h);
+    if (!a2_io_is_vidmode_mixed(io))
+      return h;
+  }
+  return a2_hash_bytes(ram + a2_io_get_text_page_offset(io), 0x400, h);
+}
+
+bool a2_hash_log_open(a2_hash_log_t *log, const char *path) {
+  memset(log, 0, sizeof(*log));
+  if (!(log->f = fopen(path, "wt"))) {
+    perror(path);
+    return false;
+  }
+  fprintf(log->f, "%s\n", A2_HASH_LOG_HEADER);
+  return true;
+}
+
+void a2_hash_log_frame(a2_hash_log_t *log, const a2_iostate_t *io, const uint8_t *ram) {
+  uint8_t mode = video_mode(io);
+  uint64_t hash = a2_hash_video(io, ram);
+  if (log->frame == 0 || mode != log->last_mode || hash != log->last_hash) {
+    fprintf(log->f, "%u %x %016" PRIx64 "\n", log->frame, mode, hash);
+    log->last_mode = mode;
+    log->last_hash = hash;
+  }
+  ++log->frame;
+}
+
+void a2_hash_log_close(a2_hash_log_t *log) {
+  if (log->f)
+    fclose(log->f);
+  log->f = NULL;
+}
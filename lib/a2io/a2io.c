@@ -7,14 +7,21 @@
 
 #include "apple2tc/a2io.h"
 
+#include "apple2tc/a2disk.h"
+#include "apple2tc/a2tape.h"
 #include "apple2tc/apple2iodefs.h"
 
 #include "font.h"
 
+#include <ctype.h>
 #include <stdio.h>
+#include <stdlib.h>
 
-void apple2_decode_text_screen(
+/// Invoke the callback for every character in the text rows selected by the
+/// bit mask \p rows, starting from top left.
+static void decode_text_rows(
     const uint8_t *pageStart,
+    uint32_t rows,
     void *ctx,
     void (*drawGlyph)(void *ctx, uint8_t ch, unsigned x, unsigned y)) {
   // The screen memory is interleaved. It is organized in eight 128-byte
@@ -30,7 +37,9 @@ void apple2_decode_text_screen(
   // or simply:
   // offset = (scr_line % 8) * 128 + (scr_line / 8) * 40;
 
-  for (unsigned scr_line = 0; scr_line != 24; ++scr_line) {
+  for (unsigned scr_line = 0; rows; ++scr_line, rows >>= 1) {
+    if (!(rows & 1))
+      continue;
     const uint8_t *start = pageStart + (scr_line % 8) * 128 + (scr_line / 8) * 40;
     for (unsigned col = 0; col != 40; ++col, ++start) {
       drawGlyph(ctx, *start, col, scr_line);
@@ -38,41 +47,83 @@ void apple2_decode_text_screen(
   }
 }
 
+void apple2_decode_text_screen(
+    const uint8_t *pageStart,
+    void *ctx,
+    void (*drawGlyph)(void *ctx, uint8_t ch, unsigned x, unsigned y)) {
+  decode_text_rows(pageStart, A2_ALL_ROWS, ctx, drawGlyph);
+}
+
+/// The glyph atlas: 64 normal glyphs followed by 64 inverse glyphs, each
+/// expanded to a 7x8 tile of color indices. Flashing characters alternate
+/// between the two halves.
+static uint8_t s_glyph_atlas[128][8 * 7];
+static bool s_glyph_atlas_ready = false;
+
+static void init_glyph_atlas(void) {
+  if (s_glyph_atlas_ready)
+    return;
+  for (unsigned tile = 0; tile != 128; ++tile) {
+    bool inverse = tile >= 64;
+    const uint8_t *glyph = font_rom + (tile & 0x3F) * 8;
+    uint8_t *d = s_glyph_atlas[tile];
+    for (unsigned row = 0; row != 8; ++glyph, ++row)
+      for (unsigned col = 0; col != 7; ++col, ++d)
+        *d = ((*glyph & (0x40 >> col)) != 0) != inverse ? A2_COLOR_WHITE : A2_COLOR_BLACK;
+  }
+  s_glyph_atlas_ready = true;
+}
+
+/// \return the atlas tile of character \p ch in the specified blink phase.
+static inline uint8_t glyph_tile(uint8_t ch, uint8_t blinkOn) {
+  bool inverse = !(ch & (0x80 | blinkOn));
+  return (ch & 0x3F) | (inverse ? 64 : 0);
+}
+
 struct RenderText {
-  a2_screen *screen;
+  a2_screen8 *screen;
   /// 0 or 0x40.
   uint8_t blinkOn;
   /// Set if the display mode is mixed.
   bool mixed;
+  /// Rows where flashing characters were drawn.
+  uint32_t flashRows;
+  /// Rows where at least one glyph was drawn.
+  uint32_t drawnRows;
+  /// If not null, the tiles already on screen. Unchanged cells are skipped.
+  uint8_t (*tiles)[40];
 };
 
-static void draw_glyph_cb(void *ctx, uint8_t ch, unsigned x, unsigned y) {
-  struct RenderText *self = (struct RenderText *)ctx;
-  bool inverse = !(ch & (0x80 | self->blinkOn));
-  ch = (ch >= 0x40 && ch < 0x80) ? ch - 0x40 : ch;
-
-  a2_rgba8 fg;
-  a2_rgba8 bg;
-  if (!inverse) {
-    fg = (a2_rgba8){0xFF, 0xFF, 0xFF, 0};
-    bg = (a2_rgba8){0, 0, 0, 0};
-  } else {
-    fg = (a2_rgba8){0, 0, 0, 0};
-    bg = (a2_rgba8){0xFF, 0xFF, 0xFF, 0};
+static inline void draw_glyph(struct RenderText *self, uint8_t ch, unsigned x, unsigned y) {
+  if ((ch & 0xC0) == 0x40)
+    self->flashRows |= 1u << y;
+  uint8_t tile = glyph_tile(ch, self->blinkOn);
+  if (self->tiles) {
+    if (self->tiles[y][x] == tile)
+      return;
+    self->tiles[y][x] = tile;
   }
+  self->drawnRows |= 1u << y;
 
-  const uint8_t *glyph = font_rom + (ch & 0x3F) * 8;
-  a2_rgba8 *d = self->screen->data + y * A2_SCREEN_W_POT * 8 + x * 7;
-  for (unsigned row = 0; row != 8; ++glyph, ++row) {
-    for (unsigned col = 0; col != 7; ++col, ++d) {
-      *d = *glyph & (0x40 >> col) ? fg : bg;
-    }
-    d += A2_SCREEN_W_POT - 7;
+  const uint8_t *src = s_glyph_atlas[tile];
+  uint8_t *d = self->screen->data + y * A2_SCREEN_W * 8 + x * 7;
+  for (unsigned row = 0; row != 8; ++row, src += 7, d += A2_SCREEN_W)
+    memcpy(d, src, 7);
+}
+
+/// Draw the text rows selected by \p rows.
+static void render_text_rows(struct RenderText *self, const uint8_t *pageStart, uint32_t rows) {
+  init_glyph_atlas();
+  for (unsigned scr_line = 0; rows; ++scr_line, rows >>= 1) {
+    if (!(rows & 1))
+      continue;
+    const uint8_t *start = pageStart + (scr_line % 8) * 128 + (scr_line / 8) * 40;
+    for (unsigned col = 0; col != 40; ++col, ++start)
+      draw_glyph(self, *start, col, scr_line);
   }
 }
 
-/// GR colors.
-static const a2_rgba8 s_gr_colors[] = {
+const a2_rgba8 a2_palette[16] = {
     {0, 0, 0}, // 0x0 black
     {227, 30, 96}, // 0x1 deep red
     {96, 78, 189}, // 0x2 dark blue
@@ -91,45 +142,221 @@ static const a2_rgba8 s_gr_colors[] = {
     {255, 255, 255}, // 0xf white
 };
 
-static void draw_gr_cb(void *ctx, uint8_t ch, unsigned x, unsigned y) {
-  struct RenderText *self = (struct RenderText *)ctx;
+static void draw_gr_block(struct RenderText *self, uint8_t ch, unsigned x, unsigned y) {
+  uint8_t *d = self->screen->data + y * A2_SCREEN_W * 8 + x * 7;
+  for (unsigned row = 0; row != 4; ++row, d += A2_SCREEN_W)
+    memset(d, ch & 0x0F, 7);
+  for (unsigned row = 0; row != 4; ++row, d += A2_SCREEN_W)
+    memset(d, ch >> 4, 7);
+}
 
-  if (y >= 20 && self->mixed) {
-    draw_glyph_cb(ctx, ch, x, y);
+/// Draw the GR rows selected by \p rows. In mixed mode the bottom four rows
+/// are drawn as text.
+static void render_gr_rows(struct RenderText *self, const uint8_t *pageStart, uint32_t rows) {
+  if (self->mixed) {
+    render_text_rows(self, pageStart, rows & A2_MIXED_TEXT_ROWS);
+    rows &= ~A2_MIXED_TEXT_ROWS;
+  }
+  for (unsigned scr_line = 0; rows; ++scr_line, rows >>= 1) {
+    if (!(rows & 1))
+      continue;
+    const uint8_t *start = pageStart + (scr_line % 8) * 128 + (scr_line / 8) * 40;
+    for (unsigned col = 0; col != 40; ++col, ++start)
+      draw_gr_block(self, *start, col, scr_line);
+  }
+}
+
+static inline uint8_t blink_phase(uint64_t ms) {
+  return (ms / 267) & 1 ? 0x40 : 0;
+}
+
+void apple2_render_text_screen(const uint8_t *pageStart, a2_screen8 *screen, uint64_t ms) {
+  struct RenderText ctx = {.screen = screen, .blinkOn = blink_phase(ms)};
+  render_text_rows(&ctx, pageStart, A2_ALL_ROWS);
+}
+
+void apple2_render_gr_screen(const uint8_t *pageStart, a2_screen8 *screen, uint64_t ms, bool mixed) {
+  struct RenderText ctx = {.screen = screen, .blinkOn = blink_phase(ms), .mixed = mixed};
+  render_gr_rows(&ctx, pageStart, A2_ALL_ROWS);
+}
+
+/// NTSC artifact colors.
+///
+/// The video signal is modelled as a stream of dots at four times the color
+/// subcarrier frequency: 560 dots per line, two per screen pixel. Every four
+/// consecutive dots span one color cycle and the monitor sees them as the color
+/// whose bits, rotated to the phase of the first dot, match the pattern. The GR
+/// palette is in exactly that order: color c is displayed as dot i = bit (i & 3)
+/// of c, so the decoded colors are palette indices.
+///
+/// Screen pixel x is decoded from the window of dots 2x-1 .. 2x+2.
+
+/// Number of dots in a line, including one padding dot before the line and
+/// one after it.
+#define NTSC_DOTS (A2_SCREEN_W * 2 + 2)
+
+/// Window to color LUTs for even and odd pixels. Bits 0..3 of the index are
+/// dots 2x-1 .. 2x+2.
+static uint8_t s_ntsc_colors[2][16];
+/// The 14 dots of every HGR byte: each of the 7 pixels is doubled and the
+/// high bit delays them by one dot. The first dot of a delayed byte repeats the
+/// last dot of the previous byte and is filled in while rendering.
+static uint16_t s_hgr_dots[256];
+static bool s_ntsc_ready = false;
+
+static void init_ntsc(void) {
+  if (s_ntsc_ready)
     return;
+  for (unsigned odd = 0; odd != 2; ++odd) {
+    for (unsigned w = 0; w != 16; ++w) {
+      uint8_t color = 0;
+      for (unsigned k = 0; k != 4; ++k)
+        if (w & (1 << k))
+          color |= 1 << ((odd * 2 + 3 + k) & 3);
+      s_ntsc_colors[odd][w] = color;
+    }
   }
+  for (unsigned b = 0; b != 256; ++b) {
+    uint16_t dots = 0;
+    for (unsigned i = 0; i != 7; ++i)
+      if (b & (1 << i))
+        dots |= 3 << (i * 2);
+    s_hgr_dots[b] = b & 0x80 ? (dots << 1) & 0x3FFF : dots;
+  }
+  s_ntsc_ready = true;
+}
 
-  a2_rgba8 *d = self->screen->data + y * A2_SCREEN_W_POT * 8 + x * 7;
-  for (unsigned row = 0; row != 4; ++row) {
-    for (unsigned col = 0; col != 7; ++col, ++d)
-      *d = s_gr_colors[ch & 0x0F];
-    d += A2_SCREEN_W_POT - 7;
+/// Decode a line of dots. \p dots starts with the padding dot.
+static void ntsc_decode_line(const uint8_t *dots, uint8_t *d) {
+  unsigned w = dots[0] | dots[1] << 1;
+  for (unsigned x = 0; x != A2_SCREEN_W; x += 2, dots += 4) {
+    w |= dots[2] << 2 | dots[3] << 3;
+    *d++ = s_ntsc_colors[0][w];
+    w = w >> 2 | dots[4] << 2 | dots[5] << 3;
+    *d++ = s_ntsc_colors[1][w];
+    w >>= 2;
   }
-  ch >>= 4;
-  for (unsigned row = 0; row != 4; ++row) {
-    for (unsigned col = 0; col != 7; ++col, ++d)
-      *d = s_gr_colors[ch];
-    d += A2_SCREEN_W_POT - 7;
+}
+
+static void render_hgr_line_ntsc(const uint8_t *start, uint8_t *d) {
+  uint8_t dots[NTSC_DOTS];
+  uint8_t *dp = dots;
+  uint16_t lastDot = 0;
+  *dp++ = 0;
+  for (unsigned bcol = 0; bcol != 40; ++start, ++bcol) {
+    uint16_t bits = s_hgr_dots[*start];
+    if (*start & 0x80)
+      bits |= lastDot;
+    for (unsigned i = 0; i != 14; ++i)
+      *dp++ = (bits >> i) & 1;
+    lastDot = bits >> 13;
   }
+  *dp = 0;
+  ntsc_decode_line(dots, d);
 }
 
-void apple2_render_text_screen(const uint8_t *pageStart, a2_screen *screen, uint64_t ms) {
-  struct RenderText ctx = {.screen = screen, .blinkOn = (ms / 267) & 1 ? 0x40 : 0};
-  apple2_decode_text_screen(pageStart, &ctx, draw_glyph_cb);
+/// Draw the text rows selected by \p rows through the NTSC decoder, as a color
+/// monitor displays them in mixed mode.
+static void render_text_rows_ntsc(struct RenderText *self, const uint8_t *pageStart, uint32_t rows) {
+  init_glyph_atlas();
+  uint8_t dots[NTSC_DOTS];
+  dots[0] = dots[NTSC_DOTS - 1] = 0;
+  for (unsigned scr_line = 0; rows; ++scr_line, rows >>= 1) {
+    if (!(rows & 1))
+      continue;
+    const uint8_t *line = pageStart + (scr_line % 8) * 128 + (scr_line / 8) * 40;
+    for (unsigned col = 0; col != 40; ++col)
+      if ((line[col] & 0xC0) == 0x40)
+        self->flashRows |= 1u << scr_line;
+    for (unsigned row = 0; row != 8; ++row) {
+      uint8_t *dp = dots + 1;
+      for (unsigned col = 0; col != 40; ++col) {
+        const uint8_t *src = s_glyph_atlas[glyph_tile(line[col], self->blinkOn)] + row * 7;
+        for (unsigned i = 0; i != 7; ++i, dp += 2)
+          dp[0] = dp[1] = src[i] != A2_COLOR_BLACK;
+      }
+      ntsc_decode_line(dots, self->screen->data + (scr_line * 8 + row) * A2_SCREEN_W);
+    }
+  }
 }
 
-void apple2_render_gr_screen(const uint8_t *pageStart, a2_screen *screen, uint64_t ms, bool mixed) {
-  struct RenderText ctx = {.screen = screen, .blinkOn = (ms / 267) & 1 ? 0x40 : 0, .mixed = mixed};
-  apple2_decode_text_screen(pageStart, &ctx, draw_gr_cb);
+/// Draw the GR rows selected by \p rows through the NTSC decoder.
+static void render_gr_rows_ntsc(struct RenderText *self, const uint8_t *pageStart, uint32_t rows) {
+  if (self->mixed) {
+    render_text_rows_ntsc(self, pageStart, rows & A2_MIXED_TEXT_ROWS);
+    rows &= ~A2_MIXED_TEXT_ROWS;
+  }
+  uint8_t dots[NTSC_DOTS];
+  dots[0] = dots[NTSC_DOTS - 1] = 0;
+  for (unsigned scr_line = 0; rows; ++scr_line, rows >>= 1) {
+    if (!(rows & 1))
+      continue;
+    const uint8_t *line = pageStart + (scr_line % 8) * 128 + (scr_line / 8) * 40;
+    uint8_t *d = self->screen->data + scr_line * 8 * A2_SCREEN_W;
+    // The top and the bottom half of the row.
+    for (unsigned half = 0; half != 2; ++half) {
+      uint8_t *dp = dots + 1;
+      for (unsigned col = 0; col != 40; ++col) {
+        uint8_t color = half ? line[col] >> 4 : line[col] & 0x0F;
+        for (unsigned i = col * 14, e = i + 14; i != e; ++i)
+          *dp++ = (color >> (i & 3)) & 1;
+      }
+      ntsc_decode_line(dots, d);
+      for (unsigned row = 1; row != 4; ++row)
+        memcpy(d + row * A2_SCREEN_W, d, A2_SCREEN_W);
+      d += 4 * A2_SCREEN_W;
+    }
+  }
 }
 
-void apple2_render_hgr_screen(
+/// Render a single hires screen line starting at \p start into \p d.
+static void render_hgr_line(const uint8_t *start, uint8_t *d, a2_render_mode_t mode) {
+  if (mode == A2_RENDER_NTSC) {
+    render_hgr_line_ntsc(start, d);
+  } else if (mode == A2_RENDER_MONO) {
+    for (unsigned bcol = 0; bcol != 40; ++start, ++bcol) {
+      uint8_t memb = *start;
+      for (unsigned i = 0; i != 7; memb >>= 1, ++d, ++i) {
+        *d = memb & 1 ? A2_COLOR_WHITE : A2_COLOR_BLACK;
+      }
+    }
+  } else {
+    static const uint8_t colors[4] = {
+        A2_COLOR_PURPLE,
+        A2_COLOR_GREEN,
+        A2_COLOR_MEDIUM_BLUE,
+        A2_COLOR_ORANGE,
+    };
+    uint8_t odd = 0;
+    uint8_t last = 0;
+
+    for (unsigned bcol = 0; bcol != 40; ++start, ++bcol) {
+      uint8_t memb = *start;
+      uint8_t highBit = (memb >> 6) & 2;
+      for (unsigned i = 0; i != 7; memb >>= 1, ++d, ++i) {
+        if ((memb & 1) == 0) {
+          *d = A2_COLOR_BLACK;
+        } else {
+          if (last)
+            *d = A2_COLOR_WHITE;
+          else {
+            *d = colors[highBit | odd];
+          }
+        }
+        last = memb & 1;
+        odd ^= 1;
+      }
+    }
+  }
+}
+
+/// Render the hires screen lines of the text rows selected by \p rows. Every
+/// text row corresponds to 8 screen lines.
+static void render_hgr_rows(
     const uint8_t *grPageStart,
-    const uint8_t *textPageStart,
-    a2_screen *screen,
-    uint64_t ms,
-    bool mixed,
-    bool mono) {
+    a2_screen8 *screen,
+    uint32_t rows,
+    a2_render_mode_t mode) {
   // There are 8 1024B blocks. Block 0 starts at line 0, block 1 starts at line 1, etc.
   //
   // Each 1024KB block consists of 8 128B regions. Each region consists of 3 40B lines,
@@ -148,188 +375,326 @@ void apple2_render_hgr_screen(
   //    or
   // offset = (scr_line % 8) * 1024 + (scr_line / 8) % 8 * 128 + (scr_line / 64) * 40
 
-  a2_rgba8 *srow = screen->data;
-  unsigned end_line = mixed ? 160 : 192;
-  for (unsigned scr_line = 0; scr_line != end_line; srow += A2_SCREEN_W_POT, ++scr_line) {
-    const uint8_t *start =
-        grPageStart + (scr_line % 8) * 1024 + ((scr_line / 8) % 8) * 128 + (scr_line / 64) * 40;
-
-    a2_rgba8 *d = srow;
-    if (mono) {
-      const a2_rgba8 fg = {0xFF, 0xFF, 0xFF, 0};
-      const a2_rgba8 bg = {0, 0, 0, 0};
-      for (unsigned bcol = 0; bcol != 40; ++start, ++bcol) {
-        uint8_t memb = *start;
-        for (unsigned i = 0; i != 7; memb >>= 1, ++d, ++i) {
-          *d = memb & 1 ? fg : bg;
-        }
-      }
-    } else {
-      // const orangeCol: Color = [255, 106, 60];
-      // const greenCol: Color = [20, 245, 60];
-      // const blueCol: Color = [20, 207, 253];
-      // const violetCol: Color = [255, 68, 253];
-      // const whiteCol: Color = [255, 255, 255];
-      // const blackCol: Color = [0, 0, 0];
-      const a2_rgba8 black = {0, 0, 0};
-      const a2_rgba8 white = {0xFF, 0xFF, 0xFF};
-      static a2_rgba8 colors[4] = {
-          // Violet.
-          {255, 68, 253},
-          // Green.
-          {20, 245, 60},
-          // Blue.
-          {20, 207, 253},
-          // Red.
-          {255, 106, 60},
-      };
-      uint8_t odd = 0;
-      uint8_t last = 0;
-
-      for (unsigned bcol = 0; bcol != 40; ++start, ++bcol) {
-        uint8_t memb = *start;
-        uint8_t highBit = (memb >> 6) & 2;
-        for (unsigned i = 0; i != 7; memb >>= 1, ++d, ++i) {
-          if ((memb & 1) == 0) {
-            *d = black;
-          } else {
-            if (last)
-              *d = white;
-            else {
-              *d = colors[highBit | odd];
-            }
-          }
-          last = memb & 1;
-          odd ^= 1;
-        }
-      }
+  for (unsigned text_row = 0; rows; ++text_row, rows >>= 1) {
+    if (!(rows & 1))
+      continue;
+    for (unsigned scr_line = text_row * 8, e = scr_line + 8; scr_line != e; ++scr_line) {
+      const uint8_t *start =
+          grPageStart + (scr_line % 8) * 1024 + ((scr_line / 8) % 8) * 128 + (scr_line / 64) * 40;
+      render_hgr_line(start, screen->data + scr_line * A2_SCREEN_W, mode);
     }
   }
+}
+
+void apple2_render_hgr_screen(
+    const uint8_t *grPageStart,
+    const uint8_t *textPageStart,
+    a2_screen8 *screen,
+    uint64_t ms,
+    bool mixed,
+    bool mono) {
+  render_hgr_rows(
+      grPageStart,
+      screen,
+      mixed ? A2_ALL_ROWS & ~A2_MIXED_TEXT_ROWS : A2_ALL_ROWS,
+      mono ? A2_RENDER_MONO : A2_RENDER_COLOR);
 
   if (mixed) {
-    struct RenderText ctx = {.screen = screen, .blinkOn = (ms / 267) & 1 ? 0x40 : 0};
-    for (unsigned scr_line = 20; scr_line != 24; ++scr_line) {
-      const uint8_t *start = textPageStart + (scr_line % 8) * 128 + (scr_line / 8) * 40;
-      for (unsigned col = 0; col != 40; ++col, ++start) {
-        draw_glyph_cb(&ctx, *start, col, scr_line);
-      }
-    }
+    struct RenderText ctx = {.screen = screen, .blinkOn = blink_phase(ms)};
+    render_text_rows(&ctx, textPageStart, A2_MIXED_TEXT_ROWS);
   }
 }
 
-void a2_sound_init(a2_sound_t *sound) {
-  sound_queue_init(&sound->sq, sizeof(float) * 8192, sizeof(float));
-  atomic_store_explicit(&sound->cb_running, false, memory_order_relaxed);
-  sound->last_cycle = 0;
-  sound->cycle_base = 0;
-  sound->last_generated_cycle = 0;
-  sound->last_state = -0.1f;
+void a2_screen_from_indexed(a2_screen *dst, const a2_screen8 *src, a2_rect rect) {
+  for (unsigned y = rect.y, e = rect.y + rect.h; y != e; ++y) {
+    const uint8_t *s = src->data + y * A2_SCREEN_W + rect.x;
+    a2_rgba8 *d = dst->data + y * A2_SCREEN_W + rect.x;
+    for (unsigned w = rect.w; w; --w)
+      *d++ = a2_palette[*s++];
+  }
 }
 
-void a2_sound_done(a2_sound_t *sound) {
-  sound_queue_free(&sound->sq);
-}
+/// The time spent in a2_render_frame().
+static a2_metric_t s_metric_render;
 
-void a2_sound_spkr(a2_sound_t *sound, unsigned cpu_freq, unsigned audio_rate, unsigned cycle) {
-  a2_sound_submit(sound, cpu_freq, audio_rate, cycle);
-  sound->last_state = -sound->last_state;
+void a2_renderer_init(a2_renderer_t *r) {
+  memset(r, 0, sizeof(*r));
+  r->invalid = true;
+  s_metric_render = a2_metric_histogram_ms("render.frame_ms");
 }
 
-void a2_sound_submit(a2_sound_t *sound, unsigned cpu_freq, unsigned audio_rate, unsigned cycle) {
-  if (cycle < sound->last_cycle)
-    sound->cycle_base += 0x100000000LLU;
-  sound->last_cycle = cycle;
-  uint64_t currentCycle = sound->cycle_base + cycle;
-
-  if (!atomic_load_explicit(&sound->cb_running, memory_order_relaxed)) {
-    sound->last_generated_cycle = (double)currentCycle;
+static a2_rect render_frame(
+    a2_renderer_t *r,
+    a2_iostate_t *io,
+    const uint8_t *ram,
+    a2_screen8 *screen,
+    uint64_t ms) {
+  a2_vidmode_t mode = a2_io_get_vidmode(io);
+  bool mixed = a2_io_is_vidmode_mixed(io);
+  unsigned page = a2_io_get_vidpage_index(io);
+  unsigned textBuf = A2_VIDBUF_TXT1 + page;
+  unsigned hgrBuf = A2_VIDBUF_HGR1 + page;
+  const uint8_t *textPage = ram + a2_io_get_text_page_offset(io);
+  uint8_t blinkOn = blink_phase(ms);
+
+  // Rows displayed as text.
+  uint32_t textRows = mode == A2_VIDMODE_TEXT ? A2_ALL_ROWS : mixed ? A2_MIXED_TEXT_ROWS : 0;
+  // The color burst is disabled in text mode, so NTSC decoding applies only to
+  // graphics modes, including their mixed text rows.
+  bool ntsc = r->render_mode == A2_RENDER_NTSC && mode != A2_VIDMODE_TEXT;
+  // Rows drawn from the glyph atlas.
+  uint32_t atlasRows = ntsc ? 0 : textRows;
+
+  // Determine which rows need to be redrawn.
+  uint32_t rows;
+  if (r->invalid || r->vid_control != io->vid_control) {
+    rows = A2_ALL_ROWS;
+    r->flash_rows = 0;
+    memset(r->text_tiles, A2_NO_TILE, sizeof(r->text_tiles));
   } else {
-    // Number of 6502 cycles per sound frame.
-    double frameCycles = (double)cpu_freq / audio_rate;
-
-    // TODO: we don't really need a buffer, we can acquire space in the queue directly.
-    enum { BUF_SIZE = 256 };
-    float buf[BUF_SIZE];
-    unsigned bufIndex = 0;
-
-    while (sound->last_generated_cycle < (double)currentCycle) {
-      buf[bufIndex++] = sound->last_state;
-      if (bufIndex == BUF_SIZE) {
-        sound_queue_push(&sound->sq, buf, bufIndex * sizeof(float));
-        bufIndex = 0;
-      }
-      sound->last_generated_cycle += frameCycles;
+    rows = io->vid_dirty[textBuf];
+    // Flashing characters change with the blink phase.
+    if (r->blink_on != blinkOn)
+      rows |= r->flash_rows & textRows;
+    if (mode == A2_VIDMODE_HGR)
+      rows = (rows & textRows) | (io->vid_dirty[hgrBuf] & ~textRows);
+  }
+
+  r->invalid = false;
+  r->vid_control = io->vid_control;
+  r->blink_on = blinkOn;
+  io->vid_dirty[textBuf] = 0;
+  if (mode == A2_VIDMODE_HGR)
+    io->vid_dirty[hgrBuf] = 0;
+
+  if (!rows)
+    return (a2_rect){0, 0, 0, 0};
+
+  // Everything else overwrites the text cells.
+  for (uint32_t gfxRows = rows & ~atlasRows, y = 0; gfxRows; ++y, gfxRows >>= 1)
+    if (gfxRows & 1)
+      memset(r->text_tiles[y], A2_NO_TILE, sizeof(r->text_tiles[y]));
+
+  struct RenderText ctx = {
+      .screen = screen, .blinkOn = blinkOn, .mixed = mixed, .tiles = r->text_tiles};
+  switch (mode) {
+  case A2_VIDMODE_TEXT:
+    render_text_rows(&ctx, textPage, rows);
+    break;
+  case A2_VIDMODE_GR:
+    if (ntsc) {
+      init_ntsc();
+      render_gr_rows_ntsc(&ctx, textPage, rows);
+    } else {
+      render_gr_rows(&ctx, textPage, rows);
     }
-    if (bufIndex)
-      sound_queue_push(&sound->sq, buf, bufIndex * sizeof(float));
+    break;
+  case A2_VIDMODE_HGR:
+  default:
+    if (ntsc)
+      init_ntsc();
+    render_hgr_rows(
+        ram + a2_io_get_hires_page_offset(io), screen, rows & ~textRows, r->render_mode);
+    if (ntsc)
+      render_text_rows_ntsc(&ctx, textPage, rows & textRows);
+    else
+      render_text_rows(&ctx, textPage, rows & textRows);
+    break;
   }
+  r->flash_rows = (r->flash_rows & ~(rows & textRows)) | ctx.flashRows;
+  // Atlas rows whose characters didn't change weren't modified.
+  rows = (rows & ~atlasRows) | ctx.drawnRows;
+  if (!rows)
+    return (a2_rect){0, 0, 0, 0};
+
+  // Convert the row mask to a rectangle.
+  unsigned first = 0, last = 23;
+  while (!(rows & (1u << first)))
+    ++first;
+  while (!(rows & (1u << last)))
+    --last;
+  return (a2_rect){0, first * 8, A2_SCREEN_W, (last - first + 1) * 8};
 }
 
-void a2_sound_cb(a2_sound_t *sound, float *buffer, unsigned num_frames, unsigned num_channels) {
-  // Tell the main thread that the sond callback is running, so the main thread
-  // can start generating sound.
-  atomic_store_explicit(&sound->cb_running, true, memory_order_relaxed);
+a2_rect a2_render_frame(
+    a2_renderer_t *r,
+    a2_iostate_t *io,
+    const uint8_t *ram,
+    a2_screen8 *screen,
+    uint64_t ms) {
+  uint64_t start = a2_metrics_start();
+  a2_rect dirty = render_frame(r, io, ram, screen, ms);
+  a2_metric_observe_since(s_metric_render, start);
+  return dirty;
+}
 
-  do {
-    queue_parts_t parts = sound_queue_readparts(&sound->sq, num_frames * sizeof(float));
-    if (parts.size1 == 0)
-      break;
-    const float *rptr = (const float *)parts.part1;
-    unsigned rlen = parts.size1 / sizeof(float);
-    if (num_channels == 1) {
-      memcpy(buffer, rptr, rlen * sizeof(float));
-      buffer += rlen;
-    } else {
-      for (unsigned cnt = rlen; cnt; buffer += 2, --cnt)
-        buffer[0] = buffer[1] = *rptr++;
-    }
-    num_frames -= rlen;
-    sound_queue_adv_head(&sound->sq, rlen * sizeof(float));
-  } while (num_frames);
+/// How often the overlay text is refreshed.
+#define OVERLAY_MS 500
+
+void a2_overlay_init(a2_overlay_t *o) {
+  memset(o, 0, sizeof(*o));
+  o->last_ns = a2_metrics_now_ns();
+  a2_metrics_enable(true);
+}
 
-  if (num_frames)
-    memset(buffer, 0, sizeof(float) * num_channels * num_frames);
+/// Read the metric \p name and store its change since the previous refresh in
+/// \p d. Return its total count. Metrics which aren't registered read as zero.
+static uint64_t overlay_read(a2_overlay_t *o, const char *name, a2_metric_value_t *d) {
+  a2_metric_t m = a2_metric_find(name);
+  a2_metric_value_t v;
+  memset(d, 0, sizeof(*d));
+  if (m == A2_METRIC_NONE)
+    return 0;
+  a2_metric_read_diff(m, &o->last[m - 1], &v, d);
+  return v.count;
+}
+
+static inline double mean(const a2_metric_value_t *d) {
+  return d->count ? d->value / d->count : 0;
+}
+
+bool a2_overlay_update(a2_overlay_t *o) {
+  uint64_t now = a2_metrics_now_ns();
+  if (now - o->last_ns < (uint64_t)OVERLAY_MS * 1000000)
+    return false;
+  double elapsed = (double)(now - o->last_ns) / 1e9;
+  o->last_ns = now;
+
+  a2_metric_value_t cycles, requested, run, interval, sim, render, upload, queue, lag, d;
+  overlay_read(o, "emu.cycles", &cycles);
+  overlay_read(o, "frame.requested_cycles", &requested);
+  overlay_read(o, "frame.cycles", &run);
+  overlay_read(o, "frame.interval_ms", &interval);
+  overlay_read(o, "frame.sim_ms", &sim);
+  overlay_read(o, "render.frame_ms", &render);
+  overlay_read(o, "render.upload_ms", &upload);
+  overlay_read(o, "sound.queue", &queue);
+  overlay_read(o, "sound.lag_ms", &lag);
+  uint64_t underruns = overlay_read(o, "sound.underruns", &d);
+  uint64_t dropped = overlay_read(o, "sound.dropped", &d);
+
+  snprintf(
+      o->text[0],
+      sizeof(o->text[0]),
+      "%.3f MHZ %.1f FPS %.0f%% CYCLES",
+      cycles.count / elapsed / 1e6,
+      interval.count / elapsed,
+      requested.count ? 100.0 * run.count / requested.count : 0);
+  snprintf(
+      o->text[1],
+      sizeof(o->text[1]),
+      "FRAME %.1f P99 %.1f MS",
+      a2_metric_quantile(&interval, 0.5),
+      a2_metric_quantile(&interval, 0.99));
+  snprintf(
+      o->text[2],
+      sizeof(o->text[2]),
+      "SIM %.2f REN %.2f UPL %.2f MS",
+      mean(&sim),
+      mean(&render),
+      mean(&upload));
+  snprintf(
+      o->text[3],
+      sizeof(o->text[3]),
+      "AUDIO Q %.0f LAG %.0f MS U%llu D%llu",
+      queue.value,
+      lag.value,
+      (unsigned long long)underruns,
+      (unsigned long long)dropped);
+  return true;
+}
+
+void a2_overlay_draw(const a2_overlay_t *o, const a2_screen8 *src, a2_screen *dst) {
+  a2_screen_from_indexed(dst, src, (a2_rect){0, 0, A2_SCREEN_W, A2_OVERLAY_LINES * 8});
+  // White characters on black, from the same font as the text mode.
+  for (unsigned line = 0; line != A2_OVERLAY_LINES; ++line) {
+    for (unsigned x = 0; o->text[line][x]; ++x) {
+      const uint8_t *glyph = font_rom + (toupper((uint8_t)o->text[line][x]) & 0x3F) * 8;
+      for (unsigned row = 0; row != 8; ++glyph, ++row) {
+        a2_rgba8 *d = dst->data + (line * 8 + row) * A2_SCREEN_W + x * 7;
+        for (unsigned col = 0; col != 7; ++col)
+          *d++ = a2_palette[*glyph & (0x40 >> col) ? A2_COLOR_WHITE : A2_COLOR_BLACK];
+      }
+    }
+  }
 }
 
 void a2_io_init(a2_iostate_t *io) {
   memset(io, 0, sizeof(*io));
+  a2_spsc_init_buf(&io->key_queue, io->keys, A2_KBD_QUEUE_SIZE, 1);
   io->vid_control = A2_VC_TEXT;
 }
 
 void a2_io_done(a2_iostate_t *io) {
+  free(io->paste);
   memset(io, 0, sizeof(*io));
 }
 
-/// \return number of available entries in the keyboard queue.
-static inline unsigned a2_io_kbd_space(a2_iostate_t *io) {
-  return A2_KBD_QUEUE_SIZE - io->keys_count;
+bool a2_io_push_key(a2_iostate_t *io, uint8_t key) {
+  return a2_spsc_push1(&io->key_queue, &key);
 }
 
-bool a2_io_push_key(a2_iostate_t *io, uint8_t key) {
-  if (a2_io_kbd_space(io) == 0)
+bool a2_io_push_str(a2_iostate_t *io, const char *str) {
+  size_t len = strlen(str);
+  if (a2_spsc_space(&io->key_queue) < len)
     return false;
-  io->keys[(io->keys_head + io->keys_count++) % A2_KBD_QUEUE_SIZE] = key;
+  a2_spsc_push(&io->key_queue, str, (unsigned)len);
   return true;
 }
 
-bool a2_io_push_str(a2_iostate_t *io, const char *str) {
-  size_t len = strlen(str);
-  if (a2_io_kbd_space(io) < len)
+bool a2_io_paste(a2_iostate_t *io, const char *text, size_t len) {
+  // Drop the consumed part first, so a long session doesn't accumulate it.
+  size_t pending = a2_io_paste_pending(io);
+  if (io->paste_pos) {
+    memmove(io->paste, io->paste + io->paste_pos, pending);
+    io->paste_pos = 0;
+    io->paste_len = pending;
+  }
+  char *buf = (char *)realloc(io->paste, pending + len);
+  if (!buf && pending + len)
     return false;
-  while (*str)
-    a2_io_push_key(io, *str++);
+  io->paste = buf;
+
+  char *d = buf + pending;
+  for (const char *e = text + len; text != e; ++text) {
+    if (*text == '\r')
+      continue;
+    *d++ = *text == '\n' ? '\r' : *text;
+  }
+  io->paste_len = d - buf;
   return true;
 }
 
+bool a2_io_paste_file(a2_iostate_t *io, FILE *f) {
+  char buf[4096];
+  size_t len;
+  while ((len = fread(buf, 1, sizeof(buf), f)) != 0) {
+    if (!a2_io_paste(io, buf, len))
+      return false;
+  }
+  return !ferror(f);
+}
+
+/// Return a pointer to the current key, or NULL if there is no input.
+static const uint8_t *cur_key(a2_iostate_t *io) {
+  const uint8_t *key = (const uint8_t *)a2_spsc_front(&io->key_queue);
+  if (key)
+    return key;
+  return io->paste_pos != io->paste_len ? (const uint8_t *)io->paste + io->paste_pos : NULL;
+}
+
 static uint8_t kbd(a2_iostate_t *io) {
-  return io->keys_count == 0 ? io->last_key : io->keys[io->keys_head] | 0x80;
+  const uint8_t *key = cur_key(io);
+  return key ? *key | 0x80 : io->last_key;
 }
 
 static void kbdstrb(a2_iostate_t *io) {
-  if (io->keys_count) {
-    io->last_key = io->keys[io->keys_head] & 0x7F;
-    io->keys_head = (io->keys_head + 1) % A2_KBD_QUEUE_SIZE;
-    --io->keys_count;
+  const uint8_t *key = (const uint8_t *)a2_spsc_front(&io->key_queue);
+  if (key) {
+    io->last_key = *key & 0x7F;
+    a2_spsc_release(&io->key_queue, 1);
+  } else if (io->paste_pos != io->paste_len) {
+    io->last_key = io->paste[io->paste_pos++] & 0x7F;
   }
 }
 
@@ -347,6 +712,8 @@ uint8_t a2_io_peek(a2_iostate_t *io, uint16_t addr, unsigned cycles) {
   case A2_TAPEOUT:
     if (io->debug & A2_DEBUG_IO1)
       fprintf(stderr, "[%u] TAPEOUT\n", cycles);
+    if (io->tape)
+      a2_tape_out(io->tape, cycles);
     break;
   case A2_SPKR:
     if (io->debug & A2_DEBUG_IO1)
@@ -358,6 +725,16 @@ uint8_t a2_io_peek(a2_iostate_t *io, uint16_t addr, unsigned cycles) {
     if (io->debug & A2_DEBUG_IO1)
       fprintf(stderr, "[%u] STROBE\n", cycles);
     break;
+  case A2_TAPEIN:
+    // $C061-$C067 are the buttons and the paddles.
+    if (io->tape && (addr & 7) == 0)
+      return a2_tape_in(io->tape, cycles) ? 0x80 : 0;
+    fprintf(stderr, "[%u] Unsupported IO location read $%04X\n", cycles, addr);
+    break;
+  case A2_DISK2_SWITCHES:
+    if (io->disk)
+      return a2_disk_io(io->disk, addr, false, 0);
+    break;
 
   case A2_TXTCLR:
     switch (addr) {
@@ -409,6 +786,8 @@ uint8_t a2_io_peek(a2_iostate_t *io, uint16_t addr, unsigned cycles) {
     break;
 
   default:
+    if (io->disk && (addr & 0xFF00) == A2_DISK2_ROM)
+      return a2_disk_rom[addr & 0xFF];
     fprintf(stderr, "[%u] Unsupported IO location read $%04X\n", cycles, addr);
   }
 
@@ -416,6 +795,10 @@ uint8_t a2_io_peek(a2_iostate_t *io, uint16_t addr, unsigned cycles) {
 }
 
 void a2_io_poke(a2_iostate_t *io, uint16_t addr, uint8_t value, unsigned cycles) {
+  if (io->disk && (addr & 0xFFF0) == A2_DISK2_SWITCHES) {
+    a2_disk_io(io->disk, addr, true, value);
+    return;
+  }
   a2_io_peek(io, addr, cycles);
   a2_io_peek(io, addr, cycles);
 }
@@ -0,0 +1,400 @@
+/*
+ * Copyright (c) Tzvetan Mikov.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "apple2tc/a2metrics.h"
+
+#include "c11threads/c11threads.h"
+
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/// The number of 64-bit slots in every shard. A counter uses one slot, a
+/// histogram one per bucket plus one for the sum.
+#define SLOTS 256
+
+typedef struct {
+  const char *name;
+  a2_metric_kind_t kind;
+  /// The first slot of the metric in the shards.
+  unsigned slot;
+  unsigned n_bounds;
+  double bounds[A2_METRICS_MAX_BOUNDS];
+} metric_desc_t;
+
+/// Registered metrics. Only written under `s_lock` and published by
+/// incrementing `s_count`, so readers don't need the lock.
+static metric_desc_t s_metrics[A2_METRICS_MAX];
+static atomic_uint s_count;
+static unsigned s_slots_used;
+static atomic_flag s_lock = ATOMIC_FLAG_INIT;
+
+static atomic_bool s_enabled;
+
+/// Every thread adds to its own row, so the cache lines aren't shared. The
+/// adds are still atomic, because the readers, and the threads sharing the
+/// last shard, access them concurrently. Histogram sums are doubles stored as
+/// their bits.
+static _Alignas(64) _Atomic uint64_t s_shards[A2_METRICS_THREADS][SLOTS];
+/// Gauges aren't sharded: the last value wins.
+static _Atomic uint64_t s_gauges[A2_METRICS_MAX];
+static atomic_uint s_next_shard;
+/// The shard of the current thread plus 1, or 0 if it hasn't been assigned.
+static _Thread_local unsigned s_shard;
+
+/// Buckets of a2_metric_histogram_ms().
+static const double s_ms_bounds[] = {
+    0.1, 0.25, 0.5, 1, 2, 4, 8, 12, 16.7, 25, 33.3, 50, 100, 250, 1000};
+
+static inline uint64_t double_bits(double d) {
+  uint64_t bits;
+  memcpy(&bits, &d, sizeof(bits));
+  return bits;
+}
+
+static inline double bits_double(uint64_t bits) {
+  double d;
+  memcpy(&d, &bits, sizeof(d));
+  return d;
+}
+
+void a2_metrics_enable(bool enabled) {
+  atomic_store_explicit(&s_enabled, enabled, memory_order_relaxed);
+}
+
+bool a2_metrics_enabled(void) {
+  return atomic_load_explicit(&s_enabled, memory_order_relaxed);
+}
+
+uint64_t a2_metrics_now_ns(void) {
+  // Not the wall clock, which may be stepped while measuring.
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+uint64_t a2_metrics_start(void) {
+  return a2_metrics_enabled() ? a2_metrics_now_ns() : 0;
+}
+
+static a2_metric_t
+register_metric(const char *name, a2_metric_kind_t kind, const double *bounds, unsigned n_bounds) {
+  while (atomic_flag_test_and_set_explicit(&s_lock, memory_order_acquire))
+    ;
+
+  a2_metric_t id = A2_METRIC_NONE;
+  unsigned count = atomic_load_explicit(&s_count, memory_order_relaxed);
+  unsigned i;
+  for (i = 0; i != count && strcmp(s_metrics[i].name, name) != 0; ++i)
+    ;
+  if (i != count) {
+    if (s_metrics[i].kind == kind)
+      id = i + 1;
+    else
+      fprintf(stderr, "metrics: %s registered with another kind\n", name);
+  } else {
+    unsigned slots = kind == A2_METRIC_COUNTER ? 1 : kind == A2_METRIC_HISTOGRAM ? n_bounds + 2 : 0;
+    if (count == A2_METRICS_MAX || s_slots_used + slots > SLOTS ||
+        n_bounds > A2_METRICS_MAX_BOUNDS) {
+      fprintf(stderr, "metrics: no room for %s\n", name);
+    } else {
+      metric_desc_t *desc = &s_metrics[count];
+      desc->name = name;
+      desc->kind = kind;
+      desc->slot = s_slots_used;
+      desc->n_bounds = n_bounds;
+      if (n_bounds)
+        memcpy(desc->bounds, bounds, n_bounds * sizeof(double));
+      s_slots_used += slots;
+      atomic_store_explicit(&s_count, count + 1, memory_order_release);
+      id = count + 1;
+    }
+  }
+
+  atomic_flag_clear_explicit(&s_lock, memory_order_release);
+  return id;
+}
+
+a2_metric_t a2_metric_counter(const char *name) {
+  return register_metric(name, A2_METRIC_COUNTER, NULL, 0);
+}
+
+a2_metric_t a2_metric_gauge(const char *name) {
+  return register_metric(name, A2_METRIC_GAUGE, NULL, 0);
+}
+
+a2_metric_t a2_metric_histogram(const char *name, const double *bounds, unsigned n_bounds) {
+  return register_metric(name, A2_METRIC_HISTOGRAM, bounds, n_bounds);
+}
+
+a2_metric_t a2_metric_histogram_ms(const char *name) {
+  return a2_metric_histogram(
+      name, s_ms_bounds, (unsigned)(sizeof(s_ms_bounds) / sizeof(s_ms_bounds[0])));
+}
+
+/// Return the slots of metric \p m in the shard of the current thread.
+static _Atomic uint64_t *thread_slots(a2_metric_t m) {
+  if (!s_shard) {
+    unsigned n = atomic_fetch_add_explicit(&s_next_shard, 1, memory_order_relaxed);
+    s_shard = (n < A2_METRICS_THREADS ? n : A2_METRICS_THREADS - 1) + 1;
+  }
+  return s_shards[s_shard - 1] + s_metrics[m - 1].slot;
+}
+
+void a2_metric_add(a2_metric_t m, uint64_t n) {
+  if (m == A2_METRIC_NONE || !a2_metrics_enabled())
+    return;
+  atomic_fetch_add_explicit(thread_slots(m), n, memory_order_relaxed);
+}
+
+void a2_metric_set(a2_metric_t m, double value) {
+  if (m == A2_METRIC_NONE || !a2_metrics_enabled())
+    return;
+  atomic_store_explicit(&s_gauges[m - 1], double_bits(value), memory_order_relaxed);
+}
+
+void a2_metric_observe(a2_metric_t m, double value) {
+  if (m == A2_METRIC_NONE || !a2_metrics_enabled())
+    return;
+  const metric_desc_t *desc = &s_metrics[m - 1];
+  unsigned b = 0;
+  while (b != desc->n_bounds && value > desc->bounds[b])
+    ++b;
+  _Atomic uint64_t *slots = thread_slots(m);
+  atomic_fetch_add_explicit(&slots[b], 1, memory_order_relaxed);
+
+  _Atomic uint64_t *sum = &slots[desc->n_bounds + 1];
+  uint64_t old = atomic_load_explicit(sum, memory_order_relaxed);
+  while (!atomic_compare_exchange_weak_explicit(
+      sum, &old, double_bits(bits_double(old) + value), memory_order_relaxed, memory_order_relaxed))
+    ;
+}
+
+void a2_metric_observe_since(a2_metric_t m, uint64_t start_ns) {
+  if (start_ns)
+    a2_metric_observe(m, (double)(a2_metrics_now_ns() - start_ns) / 1e6);
+}
+
+unsigned a2_metrics_count(void) {
+  return atomic_load_explicit(&s_count, memory_order_acquire);
+}
+
+a2_metric_t a2_metric_find(const char *name) {
+  for (unsigned i = 0, e = a2_metrics_count(); i != e; ++i)
+    if (strcmp(s_metrics[i].name, name) == 0)
+      return i + 1;
+  return A2_METRIC_NONE;
+}
+
+bool a2_metric_read(a2_metric_t m, a2_metric_value_t *v) {
+  if (m == A2_METRIC_NONE || m > a2_metrics_count())
+    return false;
+  const metric_desc_t *desc = &s_metrics[m - 1];
+  memset(v, 0, sizeof(*v));
+  v->name = desc->name;
+  v->kind = desc->kind;
+  v->bounds = desc->bounds;
+  v->n_bounds = desc->n_bounds;
+
+  switch (desc->kind) {
+  case A2_METRIC_COUNTER:
+    for (unsigned t = 0; t != A2_METRICS_THREADS; ++t)
+      v->count += atomic_load_explicit(&s_shards[t][desc->slot], memory_order_relaxed);
+    break;
+  case A2_METRIC_GAUGE:
+    v->value = bits_double(atomic_load_explicit(&s_gauges[m - 1], memory_order_relaxed));
+    break;
+  case A2_METRIC_HISTOGRAM:
+    for (unsigned t = 0; t != A2_METRICS_THREADS; ++t) {
+      _Atomic uint64_t *slots = s_shards[t] + desc->slot;
+      for (unsigned b = 0; b <= desc->n_bounds; ++b)
+        v->buckets[b] += atomic_load_explicit(&slots[b], memory_order_relaxed);
+      v->value +=
+          bits_double(atomic_load_explicit(&slots[desc->n_bounds + 1], memory_order_relaxed));
+    }
+    for (unsigned b = 0; b <= desc->n_bounds; ++b)
+      v->count += v->buckets[b];
+    break;
+  }
+  return true;
+}
+
+void a2_metric_diff(
+    a2_metric_value_t *d,
+    const a2_metric_value_t *cur,
+    const a2_metric_value_t *prev) {
+  *d = *cur;
+  if (cur->kind == A2_METRIC_GAUGE)
+    return;
+  d->count -= prev->count;
+  d->value -= prev->value;
+  for (unsigned b = 0; b <= cur->n_bounds; ++b)
+    d->buckets[b] -= prev->buckets[b];
+}
+
+void a2_metric_read_diff(
+    a2_metric_t m,
+    a2_metric_value_t *last,
+    a2_metric_value_t *v,
+    a2_metric_value_t *d) {
+  a2_metric_read(m, v);
+  // A metric which hasn't been read before starts from zero.
+  if (!last->name)
+    *last = (a2_metric_value_t){.kind = v->kind, .n_bounds = v->n_bounds};
+  a2_metric_diff(d, v, last);
+  *last = *v;
+}
+
+double a2_metric_quantile(const a2_metric_value_t *v, double q) {
+  if (!v->count)
+    return 0;
+  double rank = q * v->count;
+  uint64_t below = 0;
+  for (unsigned b = 0; b != v->n_bounds; ++b) {
+    if (v->buckets[b] && below + v->buckets[b] >= rank) {
+      double lo = b ? v->bounds[b - 1] : 0;
+      return lo + (v->bounds[b] - lo) * (rank - below) / v->buckets[b];
+    }
+    below += v->buckets[b];
+  }
+  return v->n_bounds ? v->bounds[v->n_bounds - 1] : 0;
+}
+
+struct a2_metrics_dump {
+  FILE *f;
+  char *path;
+  bool json;
+  uint64_t interval_ns;
+  uint64_t start_ns;
+  /// The time and the values of the previous record.
+  uint64_t last_ns;
+  a2_metric_value_t last[A2_METRICS_MAX];
+};
+
+a2_metrics_dump_t *a2_metrics_dump_open(const char *path, unsigned interval_ms) {
+  FILE *f = fopen(path, "w");
+  if (!f) {
+    perror(path);
+    return NULL;
+  }
+  a2_metrics_dump_t *dump = (a2_metrics_dump_t *)calloc(1, sizeof(a2_metrics_dump_t));
+  size_t len = strlen(path);
+  char *pathCopy = (char *)malloc(len + 1);
+  if (!dump || !pathCopy) {
+    fprintf(stderr, "%s: out of memory\n", path);
+    free(dump);
+    free(pathCopy);
+    fclose(f);
+    return NULL;
+  }
+  dump->f = f;
+  dump->path = strcpy(pathCopy, path);
+  dump->json = len >= 5 && strcmp(path + len - 5, ".json") == 0;
+  dump->interval_ns = (uint64_t)interval_ms * 1000000;
+  dump->start_ns = dump->last_ns = a2_metrics_now_ns();
+  if (!dump->json)
+    fprintf(f, "time,metric,kind,count,value,rate,mean,p50,p99\n");
+  a2_metrics_enable(true);
+  return dump;
+}
+
+static const char *kind_name(a2_metric_kind_t kind) {
+  switch (kind) {
+  case A2_METRIC_COUNTER:
+    return "counter";
+  case A2_METRIC_GAUGE:
+    return "gauge";
+  case A2_METRIC_HISTOGRAM:
+  default:
+    return "histogram";
+  }
+}
+
+/// Write a record with the values of all metrics, and the rates and the
+/// distributions since the previous record.
+static void dump_record(a2_metrics_dump_t *dump, uint64_t now) {
+  FILE *f = dump->f;
+  double time = (double)(now - dump->start_ns) / 1e9;
+  double elapsed = (double)(now - dump->last_ns) / 1e9;
+  if (dump->json)
+    fprintf(f, "{\"time\":%.3f,\"metrics\":{", time);
+
+  for (unsigned i = 0, e = a2_metrics_count(); i != e; ++i) {
+    a2_metric_value_t v, d;
+    a2_metric_read_diff(i + 1, &dump->last[i], &v, &d);
+    double rate = elapsed > 0 ? d.count / elapsed : 0;
+
+    if (dump->json) {
+      fprintf(f, "%s\"%s\":{", i ? "," : "", v.name);
+      switch (v.kind) {
+      case A2_METRIC_COUNTER:
+        fprintf(f, "\"count\":%llu,\"rate\":%.6g}", (unsigned long long)v.count, rate);
+        break;
+      case A2_METRIC_GAUGE:
+        fprintf(f, "\"value\":%.6g}", v.value);
+        break;
+      case A2_METRIC_HISTOGRAM:
+        fprintf(
+            f,
+            "\"count\":%llu,\"sum\":%.6g,\"rate\":%.6g,\"mean\":%.6g,\"p50\":%.6g,\"p99\":%.6g}",
+            (unsigned long long)v.count,
+            v.value,
+            rate,
+            d.count ? d.value / d.count : 0,
+            a2_metric_quantile(&d, 0.5),
+            a2_metric_quantile(&d, 0.99));
+        break;
+      }
+    } else {
+      fprintf(f, "%.3f,%s,%s,", time, v.name, kind_name(v.kind));
+      switch (v.kind) {
+      case A2_METRIC_COUNTER:
+        fprintf(f, "%llu,,%.6g,,,\n", (unsigned long long)v.count, rate);
+        break;
+      case A2_METRIC_GAUGE:
+        fprintf(f, ",%.6g,,,,\n", v.value);
+        break;
+      case A2_METRIC_HISTOGRAM:
+        fprintf(
+            f,
+            "%llu,%.6g,%.6g,%.6g,%.6g,%.6g\n",
+            (unsigned long long)v.count,
+            v.value,
+            rate,
+            d.count ? d.value / d.count : 0,
+            a2_metric_quantile(&d, 0.5),
+            a2_metric_quantile(&d, 0.99));
+        break;
+      }
+    }
+  }
+
+  if (dump->json)
+    fprintf(f, "}}\n");
+  fflush(f);
+  dump->last_ns = now;
+}
+
+void a2_metrics_dump_poll(a2_metrics_dump_t *dump) {
+  uint64_t now = a2_metrics_now_ns();
+  if (now - dump->last_ns >= dump->interval_ns)
+    dump_record(dump, now);
+}
+
+bool a2_metrics_dump_close(a2_metrics_dump_t *dump) {
+  dump_record(dump, a2_metrics_now_ns());
+  bool ok = !ferror(dump->f);
+  if (fclose(dump->f) != 0)
+    ok = false;
+  if (!ok)
+    fprintf(stderr, "%s: write error\n", dump->path);
+  free(dump->path);
+  free(dump);
+  return ok;
+}
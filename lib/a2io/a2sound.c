@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) Tzvetan Mikov.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "blep.h"
+
+/// The number of speaker toggles waiting in the queue.
+static a2_metric_t s_metric_queue;
+/// The smoothed latency of the sound callback.
+static a2_metric_t s_metric_lag;
+static a2_metric_t s_metric_underruns;
+static a2_metric_t s_metric_dropped;
+static a2_metric_t s_metric_lost;
+/// The time spent in the sound callback.
+static a2_metric_t s_metric_cb;
+
+bool a2_sound_init(a2_sound_t *sound) {
+  memset(sound, 0, sizeof(*sound));
+  a2_blep_init(&sound->synth, 0);
+  if (!a2_spsc_init(&sound->sq, 16384, sizeof(uint32_t)))
+    return false;
+  atomic_init(&sound->cb_running, false);
+  atomic_init(&sound->submitted_cycle, 0);
+  atomic_init(&sound->cpu_freq, 0);
+  atomic_init(&sound->audio_rate, 0);
+  atomic_init(&sound->target_ms, A2_SOUND_DEFAULT_LATENCY_MS);
+  atomic_init(&sound->stat_lag, 0);
+  atomic_init(&sound->stat_underruns, 0);
+  atomic_init(&sound->stat_dropped, 0);
+  atomic_init(&sound->stat_lost, 0);
+  s_metric_queue = a2_metric_gauge("sound.queue");
+  s_metric_lag = a2_metric_gauge("sound.lag_ms");
+  s_metric_underruns = a2_metric_counter("sound.underruns");
+  s_metric_dropped = a2_metric_counter("sound.dropped");
+  s_metric_lost = a2_metric_counter("sound.lost_toggles");
+  s_metric_cb = a2_metric_histogram_ms("sound.cb_ms");
+  return true;
+}
+
+void a2_sound_done(a2_sound_t *sound) {
+  a2_spsc_free(&sound->sq);
+}
+
+void a2_sound_set_latency(a2_sound_t *sound, unsigned ms) {
+  atomic_store_explicit(&sound->target_ms, ms, memory_order_relaxed);
+}
+
+a2_sound_stats_t a2_sound_get_stats(a2_sound_t *sound) {
+  unsigned rate = atomic_load_explicit(&sound->audio_rate, memory_order_relaxed);
+  unsigned lag = atomic_load_explicit(&sound->stat_lag, memory_order_relaxed);
+  return (a2_sound_stats_t){
+      .latency_ms = rate ? (unsigned)((uint64_t)lag * 1000 / rate) : 0,
+      .underruns = atomic_load_explicit(&sound->stat_underruns, memory_order_relaxed),
+      .dropped = atomic_load_explicit(&sound->stat_dropped, memory_order_relaxed),
+      .lost = atomic_load_explicit(&sound->stat_lost, memory_order_relaxed),
+  };
+}
+
+void a2_sound_spkr(a2_sound_t *sound, unsigned cycle) {
+  if (!atomic_load_explicit(&sound->cb_running, memory_order_relaxed))
+    return;
+  uint32_t c = cycle;
+  if (!sound->drop_next && a2_spsc_push1(&sound->sq, &c))
+    return;
+  sound->drop_next = !sound->drop_next;
+  atomic_fetch_add_explicit(&sound->stat_lost, 1, memory_order_relaxed);
+  a2_metric_add(s_metric_lost, 1);
+}
+
+void a2_sound_submit(a2_sound_t *sound, unsigned cpu_freq, unsigned audio_rate, unsigned cycle) {
+  atomic_store_explicit(&sound->cpu_freq, cpu_freq, memory_order_relaxed);
+  atomic_store_explicit(&sound->audio_rate, audio_rate, memory_order_relaxed);
+  atomic_store_explicit(&sound->submitted_cycle, cycle, memory_order_release);
+  a2_metric_set(s_metric_queue, a2_spsc_size_approx(&sound->sq));
+}
+
+/// Extend a 32-bit cycle, which is not too far from the last processed one,
+/// to 64 bits. Cycles before the last processed one are clamped to it.
+static inline uint64_t extend_cycle(const a2_sound_t *sound, uint32_t cycle) {
+  int32_t diff = (int32_t)(cycle - (uint32_t)sound->cycle);
+  return diff > 0 ? sound->cycle + (uint32_t)diff : sound->cycle;
+}
+
+/// Convert a cycle to a sample position. The result is delayed by half the
+/// impulse length, so the impulse never starts before `next_sample`.
+static inline double cycle_to_sample(const a2_sound_t *sound, uint64_t cycle) {
+  return sound->anchor_pos +
+      (double)(int64_t)(cycle - sound->anchor_cycle) * sound->samples_per_cycle;
+}
+
+/// Convert a sample position after the anchor to the last cycle before it.
+static inline uint64_t sample_to_cycle(const a2_sound_t *sound, double pos) {
+  return sound->anchor_cycle + (uint64_t)((pos - sound->anchor_pos) / sound->samples_per_cycle);
+}
+
+/// Generate samples up to \p end, applying the queued toggles up to
+/// \p endCycle. Return the end of the output.
+static float *
+render(a2_sound_t *sound, float *d, unsigned channels, uint64_t end, uint64_t endCycle) {
+  const uint32_t *c;
+  while ((c = (const uint32_t *)a2_spsc_front(&sound->sq)) != NULL) {
+    uint64_t cycle = extend_cycle(sound, *c);
+    if (cycle > endCycle)
+      break;
+    double pos = cycle_to_sample(sound, cycle);
+    uint64_t start = a2_blep_settled_until(pos);
+    if (start >= end)
+      break;
+    if (start > sound->synth.next_sample)
+      d = a2_blep_generate(&sound->synth, d, channels, start - sound->synth.next_sample);
+    a2_blep_toggle(&sound->synth, pos);
+    a2_spsc_release(&sound->sq, 1);
+    sound->cycle = cycle;
+  }
+  return a2_blep_generate(&sound->synth, d, channels, end - sound->synth.next_sample);
+}
+
+static inline double clamp_adjust(double adjust) {
+  return adjust > A2_SOUND_MAX_RATE_ADJUST ? A2_SOUND_MAX_RATE_ADJUST
+      : adjust < -A2_SOUND_MAX_RATE_ADJUST ? -A2_SOUND_MAX_RATE_ADJUST
+                                           : adjust;
+}
+
+void a2_sound_cb(a2_sound_t *sound, float *buffer, unsigned num_frames, unsigned num_channels) {
+  // Tell the main thread that the sond callback is running, so the main thread
+  // can start recording toggles.
+  atomic_store_explicit(&sound->cb_running, true, memory_order_relaxed);
+  uint64_t start = a2_metrics_start();
+
+  uint32_t submitted = atomic_load_explicit(&sound->submitted_cycle, memory_order_acquire);
+  unsigned cpu_freq = atomic_load_explicit(&sound->cpu_freq, memory_order_relaxed);
+  unsigned audio_rate = atomic_load_explicit(&sound->audio_rate, memory_order_relaxed);
+  if (!cpu_freq || !audio_rate) {
+    memset(buffer, 0, sizeof(float) * num_channels * num_frames);
+    a2_metric_observe_since(s_metric_cb, start);
+    return;
+  }
+
+  double target = (double)audio_rate *
+      atomic_load_explicit(&sound->target_ms, memory_order_relaxed) / 1000;
+  if (target > A2_SOUND_MAX_LAG / 2)
+    target = A2_SOUND_MAX_LAG / 2;
+  double nominal = (double)audio_rate / cpu_freq;
+  if (!sound->synced) {
+    // Start from the current emulation time, already at the target latency.
+    sound->synced = true;
+    sound->cycle = sound->anchor_cycle = submitted;
+    sound->anchor_pos = target + A2_BLEP_TAPS;
+    sound->samples_per_cycle = nominal;
+    a2_blep_init(&sound->synth, 0);
+    sound->lag = target;
+    sound->drift = 0;
+  }
+
+  uint64_t endCycle = extend_cycle(sound, submitted);
+  uint64_t available = a2_blep_settled_until(cycle_to_sample(sound, endCycle));
+  // If we are too far behind, drop the oldest samples.
+  if (available > sound->synth.next_sample + A2_SOUND_MAX_LAG) {
+    uint64_t drop = available - A2_SOUND_MAX_LAG - sound->synth.next_sample;
+    render(sound, NULL, 0, available - A2_SOUND_MAX_LAG, endCycle);
+    atomic_fetch_add_explicit(&sound->stat_dropped, (unsigned)drop, memory_order_relaxed);
+    a2_metric_add(s_metric_dropped, drop);
+  }
+
+  // Adjust the rate to keep the lag close to the target: if we are falling
+  // behind, the same number of cycles is played with slightly fewer samples.
+  // The mapping is re-anchored at the cycle being played now, so the new rate
+  // applies only from there on. It stays continuous for the pending toggles,
+  // which all come later.
+  double lag = available > sound->synth.next_sample ? (double)(available - sound->synth.next_sample) : 0;
+  sound->lag += (lag - sound->lag) * 0.05;
+  double error = target > 0 ? (sound->lag - target) / target : 0;
+  if (error > 1)
+    error = 1;
+  else if (error < -1)
+    error = -1;
+  // The integral term compensates for a constant clock drift.
+  sound->drift = clamp_adjust(sound->drift + error * (A2_SOUND_MAX_RATE_ADJUST / 256));
+  double adjust = clamp_adjust(sound->drift + error * (A2_SOUND_MAX_RATE_ADJUST / 2));
+  if (sound->synth.next_sample > sound->anchor_pos) {
+    uint64_t cycle = sample_to_cycle(sound, (double)sound->synth.next_sample);
+    sound->anchor_pos = cycle_to_sample(sound, cycle);
+    sound->anchor_cycle = cycle;
+  }
+  sound->samples_per_cycle = nominal * (1 - adjust);
+  atomic_store_explicit(&sound->stat_lag, (unsigned)sound->lag, memory_order_relaxed);
+  a2_metric_set(s_metric_lag, sound->lag * 1000 / audio_rate);
+
+  uint64_t end = sound->synth.next_sample + num_frames;
+  if (end > available)
+    end = available > sound->synth.next_sample ? available : sound->synth.next_sample;
+  float *d = render(sound, buffer, num_channels, end, endCycle);
+  // If no toggles before the submitted cycle are pending, extend from there,
+  // so a long silence doesn't leave the reference 2^31 cycles behind.
+  const uint32_t *next = (const uint32_t *)a2_spsc_front(&sound->sq);
+  if (!next || extend_cycle(sound, *next) > endCycle)
+    sound->cycle = endCycle;
+
+  // Underrun: hold the current level.
+  float *bufEnd = buffer + num_frames * num_channels;
+  if (d != bufEnd) {
+    atomic_fetch_add_explicit(&sound->stat_underruns, 1, memory_order_relaxed);
+    a2_metric_add(s_metric_underruns, 1);
+  }
+  while (d != bufEnd)
+    *d++ = sound->synth.acc;
+  a2_metric_observe_since(s_metric_cb, start);
+}
@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) Tzvetan Mikov.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "apple2tc/a2tape.h"
+
+#include "apple2tc/a2wav.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/// Convert microseconds to CPU cycles.
+#define US(us) ((uint32_t)((uint64_t)(us) * A2_CLOCK_FREQ / 1000000))
+
+/// The half cycles written by the Monitor: the header tone, the two halves of
+/// the sync bit, and the data bits.
+#define HEADER_HALF US(650)
+#define SYNC_HALF1 US(200)
+#define SYNC_HALF2 US(250)
+#define ZERO_HALF US(250)
+#define ONE_HALF US(500)
+/// Half cycles in this range are part of the header tone.
+#define HEADER_MIN US(575)
+#define HEADER_MAX US(800)
+/// A half cycle shorter than this after the header is the sync bit.
+#define SYNC_MAX US(425)
+/// The number of header half cycles, about a sixth of a second, which must
+/// precede the sync bit.
+#define HEADER_MIN_HALVES 256
+/// A bit whose two half cycles are longer than this is a one.
+#define ONE_MIN US(750)
+
+/// The sample rate of saved tapes.
+#define TAPE_SAMPLE_RATE 44100
+/// The level of the input changes when the signal crosses this far past zero
+/// in the other direction, which ignores low level noise.
+#define HYSTERESIS 0.01f
+/// Number of samples read from the file at once.
+#define READ_SAMPLES 4096
+
+void a2_tape_init(a2_tape_t *tape) {
+  memset(tape, 0, sizeof(*tape));
+}
+
+void a2_tape_done(a2_tape_t *tape) {
+  free(tape->halves);
+  a2_tape_init(tape);
+}
+
+static bool append(a2_tape_t *tape, uint32_t half) {
+  if (tape->len == tape->cap) {
+    size_t cap = tape->cap ? tape->cap * 2 : 4096;
+    uint32_t *halves = (uint32_t *)realloc(tape->halves, cap * sizeof(uint32_t));
+    if (!halves)
+      return false;
+    tape->halves = halves;
+    tape->cap = cap;
+  }
+  tape->halves[tape->len++] = half;
+  tape->dirty = true;
+  return true;
+}
+
+bool a2_tape_load(a2_tape_t *tape, const char *path) {
+  a2_wav_reader_t rd;
+  if (!a2_wav_reader_open(&rd, path))
+    return false;
+
+  a2_tape_t t;
+  a2_tape_init(&t);
+  double cycles_per_sample = (double)A2_CLOCK_FREQ / rd.sample_rate;
+  float buf[READ_SAMPLES];
+  uint64_t sample = 0;
+  // The level is unknown until the signal first crosses the threshold. The
+  // time before that isn't a complete half cycle, so it is dropped, and the
+  // half cycles start at the first crossing.
+  int level = 0;
+  uint64_t last_cycle = 0;
+  bool ok = true;
+  unsigned n;
+  while (ok && (n = a2_wav_reader_read(&rd, buf, READ_SAMPLES)) != 0) {
+    for (unsigned i = 0; i != n; ++i, ++sample) {
+      int new_level = buf[i] > HYSTERESIS ? 1 : buf[i] < -HYSTERESIS ? -1 : level;
+      if (new_level == level)
+        continue;
+      uint64_t cycle = (uint64_t)(sample * cycles_per_sample + 0.5);
+      if (level != 0) {
+        ok = append(&t, (uint32_t)(cycle - last_cycle));
+      } else if (new_level > 0) {
+        // The input level is the parity of the half cycle, so a signal which
+        // starts high begins with an empty low half cycle.
+        ok = append(&t, 0);
+      }
+      level = new_level;
+      last_cycle = cycle;
+    }
+  }
+  a2_wav_reader_close(&rd);
+  if (!ok) {
+    fprintf(stderr, "%s: out of memory\n", path);
+    a2_tape_done(&t);
+    return false;
+  }
+
+  a2_tape_done(tape);
+  *tape = t;
+  tape->dirty = false;
+  return true;
+}
+
+bool a2_tape_save(a2_tape_t *tape, const char *path) {
+  a2_wav_sink_t *wav = a2_wav_open(path, A2_CLOCK_FREQ, TAPE_SAMPLE_RATE);
+  if (!wav)
+    return false;
+  // The 32-bit cycles wrap around after about an hour, which the sink handles
+  // as long as every half cycle is shorter. The signal starts low, like the
+  // input during the first half cycle.
+  unsigned cycle = 0;
+  a2_wav_advance(wav, cycle);
+  for (size_t i = 0; i != tape->len; ++i) {
+    cycle += tape->halves[i];
+    a2_wav_spkr(wav, cycle);
+  }
+  if (!a2_wav_close(wav)) {
+    fprintf(stderr, "%s: write error\n", path);
+    return false;
+  }
+  tape->dirty = false;
+  return true;
+}
+
+void a2_tape_rewind(a2_tape_t *tape) {
+  tape->pos = 0;
+  tape->pos_cycles = 0;
+  tape->playing = false;
+}
+
+/// Play \p cycles cycles of the tape.
+static void advance(a2_tape_t *tape, uint32_t cycles) {
+  while (tape->pos < tape->len) {
+    uint32_t left = tape->halves[tape->pos] - tape->pos_cycles;
+    if (cycles < left) {
+      tape->pos_cycles += cycles;
+      return;
+    }
+    cycles -= left;
+    tape->pos_cycles = 0;
+    ++tape->pos;
+  }
+}
+
+bool a2_tape_in(a2_tape_t *tape, unsigned cycles) {
+  if (tape->playing) {
+    uint32_t elapsed = cycles - tape->last_in;
+    if (elapsed < A2_TAPE_PAUSE)
+      advance(tape, elapsed);
+  }
+  tape->playing = true;
+  tape->last_in = cycles;
+  return a2_tape_level(tape);
+}
+
+void a2_tape_out(a2_tape_t *tape, unsigned cycles) {
+  if (tape->recording) {
+    // A long pause is recorded as a shorter gap.
+    uint32_t elapsed = cycles - tape->last_out;
+    append(tape, elapsed < A2_TAPE_PAUSE ? elapsed : A2_TAPE_PAUSE);
+  }
+  tape->recording = true;
+  tape->last_out = cycles;
+}
+
+bool a2_tape_read_block(a2_tape_t *tape, uint8_t *data, size_t len, uint8_t *checksum) {
+  // Look for a short half cycle following a run of the header tone, like the
+  // Monitor does after skipping most of the header, then skip the second half
+  // of the sync bit.
+  size_t pos = tape->pos;
+  unsigned run = 0;
+  for (; pos < tape->len; ++pos) {
+    uint32_t half = tape->halves[pos];
+    if (half >= HEADER_MIN && half <= HEADER_MAX)
+      ++run;
+    else if (half < SYNC_MAX && run >= HEADER_MIN_HALVES)
+      break;
+    else
+      run = 0;
+  }
+  pos += 2;
+  // The data and the checksum byte.
+  if (pos > tape->len || (tape->len - pos) / 16 < len + 1)
+    return false;
+
+  for (size_t i = 0; i != len + 1; ++i) {
+    uint8_t byte = 0;
+    for (unsigned bit = 0; bit != 8; ++bit, pos += 2)
+      byte = (byte << 1) | (tape->halves[pos] + tape->halves[pos + 1] > ONE_MIN);
+    if (i != len)
+      data[i] = byte;
+    else
+      *checksum = byte;
+  }
+
+  tape->pos = pos;
+  tape->pos_cycles = 0;
+  tape->playing = false;
+  return true;
+}
+
+void a2_tape_write_block(a2_tape_t *tape, unsigned header_halves, const uint8_t *data, size_t len) {
+  for (unsigned i = 0; i != header_halves; ++i)
+    append(tape, HEADER_HALF);
+  append(tape, SYNC_HALF1);
+  append(tape, SYNC_HALF2);
+
+  uint8_t sum = 0xFF;
+  for (size_t i = 0; i != len + 1; ++i) {
+    uint8_t byte = i != len ? data[i] : sum;
+    sum ^= byte;
+    for (unsigned bit = 0; bit != 8; ++bit, byte <<= 1) {
+      uint32_t half = byte & 0x80 ? ONE_HALF : ZERO_HALF;
+      append(tape, half);
+      append(tape, half);
+    }
+  }
+  tape->recording = false;
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) Tzvetan Mikov.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "apple2tc/a2tribuf.h"
+
+void a2_video_tribuf_init(a2_video_tribuf_t *tb) {
+  memset(tb, 0, sizeof(*tb));
+  tb->back = 0;
+  tb->front = 1;
+  atomic_init(&tb->middle, 2);
+}
+
+void a2_video_tribuf_publish(a2_video_tribuf_t *tb, a2_iostate_t *io, const uint8_t *ram) {
+  a2_video_frame_t *frame = &tb->bufs[tb->back];
+  frame->vid_control = io->vid_control;
+
+  uint16_t textOfs = a2_io_get_text_page_offset(io);
+  memcpy(frame->ram + textOfs, ram + textOfs, 0x400);
+  if (a2_io_get_vidmode(io) == A2_VIDMODE_HGR) {
+    uint16_t hgrOfs = a2_io_get_hires_page_offset(io);
+    memcpy(frame->ram + hgrOfs, ram + hgrOfs, 0x2000);
+  }
+
+  // If the previous frame has been consumed, its dirty rows have been drawn.
+  // Otherwise it is about to be replaced, so they must be drawn with this one.
+  bool consumed = !(atomic_load_explicit(&tb->middle, memory_order_acquire) & A2_TRIBUF_FRESH);
+  for (unsigned i = 0; i != A2_NUM_VIDBUFS; ++i) {
+    frame->vid_dirty[i] = io->vid_dirty[i] | (consumed ? 0 : tb->carry_dirty[i]);
+    tb->carry_dirty[i] = frame->vid_dirty[i];
+    io->vid_dirty[i] = 0;
+  }
+
+  unsigned old = atomic_exchange_explicit(
+      &tb->middle, tb->back | A2_TRIBUF_FRESH, memory_order_acq_rel);
+  tb->back = old & ~A2_TRIBUF_FRESH;
+}
+
+const a2_video_frame_t *a2_video_tribuf_acquire(a2_video_tribuf_t *tb) {
+  if (!(atomic_load_explicit(&tb->middle, memory_order_acquire) & A2_TRIBUF_FRESH))
+    return NULL;
+  unsigned old = atomic_exchange_explicit(&tb->middle, tb->front, memory_order_acq_rel);
+  tb->front = old & ~A2_TRIBUF_FRESH;
+  return &tb->bufs[tb->front];
+}
+
+void a2_video_frame_apply(const a2_video_frame_t *frame, a2_iostate_t *io) {
+  io->vid_control = frame->vid_control;
+  for (unsigned i = 0; i != A2_NUM_VIDBUFS; ++i)
+    io->vid_dirty[i] |= frame->vid_dirty[i];
+}
@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) Tzvetan Mikov.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "apple2tc/a2wav.h"
+
+#include "blep.h"
+
+#include <stdlib.h>
+
+/// Number of samples converted and written at once.
+#define WAV_BUF_SAMPLES 16384
+#define WAV_HEADER_SIZE 44
+
+struct a2_wav_sink {
+  FILE *f;
+  unsigned sample_rate;
+  double samples_per_cycle;
+  /// The 64-bit cycle of the last event, used to extend the 32-bit cycles.
+  uint64_t cycle;
+  bool started;
+  a2_blep_t synth;
+  /// Number of samples written to the file.
+  uint64_t written;
+  bool error;
+  float fbuf[WAV_BUF_SAMPLES];
+  int16_t buf[WAV_BUF_SAMPLES];
+};
+
+static inline uint8_t *put_u16(uint8_t *p, uint16_t v) {
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+  return p + 2;
+}
+
+static inline uint8_t *put_u32(uint8_t *p, uint32_t v) {
+  p = put_u16(p, (uint16_t)v);
+  return put_u16(p, (uint16_t)(v >> 16));
+}
+
+static void write_header(a2_wav_sink_t *wav) {
+  unsigned sample_rate = wav->sample_rate;
+  uint32_t dataSize = wav->written * 2 > 0xFFFFFFFFu - WAV_HEADER_SIZE
+      ? 0xFFFFFFFFu - WAV_HEADER_SIZE
+      : (uint32_t)(wav->written * 2);
+  uint8_t hdr[WAV_HEADER_SIZE];
+  uint8_t *p = hdr;
+  memcpy(p, "RIFF", 4);
+  p = put_u32(p + 4, WAV_HEADER_SIZE - 8 + dataSize);
+  memcpy(p, "WAVEfmt ", 8);
+  p = put_u32(p + 8, 16);
+  p = put_u16(p, 1); // PCM
+  p = put_u16(p, 1); // Mono
+  p = put_u32(p, sample_rate);
+  p = put_u32(p, sample_rate * 2);
+  p = put_u16(p, 2); // Block align
+  p = put_u16(p, 16); // Bits per sample
+  memcpy(p, "data", 4);
+  put_u32(p + 4, dataSize);
+  if (fwrite(hdr, 1, sizeof(hdr), wav->f) != sizeof(hdr))
+    wav->error = true;
+}
+
+a2_wav_sink_t *a2_wav_open(const char *path, unsigned cpu_freq, unsigned sample_rate) {
+  a2_wav_sink_t *wav = (a2_wav_sink_t *)calloc(1, sizeof(a2_wav_sink_t));
+  if (!wav)
+    return NULL;
+  if (!(wav->f = fopen(path, "wb"))) {
+    perror(path);
+    free(wav);
+    return NULL;
+  }
+  setvbuf(wav->f, NULL, _IOFBF, 256 * 1024);
+  wav->sample_rate = sample_rate;
+  wav->samples_per_cycle = (double)sample_rate / cpu_freq;
+  a2_blep_init(&wav->synth, 0);
+  // The sizes are filled in when closing.
+  write_header(wav);
+  return wav;
+}
+
+static inline double cycle_to_sample(const a2_wav_sink_t *wav, uint64_t cycle) {
+  return (double)cycle * wav->samples_per_cycle + A2_BLEP_TAPS / 2;
+}
+
+/// Extend a 32-bit cycle to 64 bits. Cycles are never earlier than the last
+/// one.
+static inline uint64_t extend_cycle(a2_wav_sink_t *wav, uint32_t cycle) {
+  if (!wav->started) {
+    // The file starts at the first event.
+    wav->started = true;
+    wav->cycle = cycle;
+    a2_blep_init(&wav->synth, a2_blep_settled_until(cycle_to_sample(wav, cycle)));
+  }
+  int32_t diff = (int32_t)(cycle - (uint32_t)wav->cycle);
+  if (diff > 0)
+    wav->cycle += (uint32_t)diff;
+  return wav->cycle;
+}
+
+/// Generate and write the samples up to \p end.
+static void write_until(a2_wav_sink_t *wav, uint64_t end) {
+  while (wav->synth.next_sample < end) {
+    uint64_t left = end - wav->synth.next_sample;
+    unsigned n = left < WAV_BUF_SAMPLES ? (unsigned)left : WAV_BUF_SAMPLES;
+    a2_blep_generate(&wav->synth, wav->fbuf, 1, n);
+    for (unsigned i = 0; i != n; ++i) {
+      float v = wav->fbuf[i] * 32767.0f;
+      wav->buf[i] = (int16_t)(v > 32767.0f ? 32767 : v < -32767.0f ? -32767 : v);
+    }
+    if (fwrite(wav->buf, 2, n, wav->f) != n)
+      wav->error = true;
+    wav->written += n;
+  }
+}
+
+void a2_wav_spkr(a2_wav_sink_t *wav, unsigned cycle) {
+  double pos = cycle_to_sample(wav, extend_cycle(wav, cycle));
+  write_until(wav, a2_blep_settled_until(pos));
+  a2_blep_toggle(&wav->synth, pos);
+}
+
+void a2_wav_advance(a2_wav_sink_t *wav, unsigned cycle) {
+  write_until(wav, a2_blep_settled_until(cycle_to_sample(wav, extend_cycle(wav, cycle))));
+}
+
+bool a2_wav_close(a2_wav_sink_t *wav) {
+  // Let the last step settle.
+  write_until(wav, wav->synth.settle_sample);
+  if (fseek(wav->f, 0, SEEK_SET) == 0)
+    write_header(wav);
+  else
+    wav->error = true;
+  bool ok = !wav->error;
+  if (fclose(wav->f) != 0)
+    ok = false;
+  free(wav);
+  return ok;
+}
+
+static bool read_u32(FILE *f, uint32_t *v) {
+  uint8_t b[4];
+  if (fread(b, 1, 4, f) != 4)
+    return false;
+  *v = b[0] | (b[1] << 8) | (b[2] << 16) | ((uint32_t)b[3] << 24);
+  return true;
+}
+
+bool a2_wav_reader_open(a2_wav_reader_t *rd, const char *path) {
+  memset(rd, 0, sizeof(*rd));
+  if (!(rd->f = fopen(path, "rb"))) {
+    perror(path);
+    return false;
+  }
+
+  char tag[4];
+  uint32_t size;
+  bool haveFmt = false;
+  if (fread(tag, 1, 4, rd->f) != 4 || memcmp(tag, "RIFF", 4) != 0 || !read_u32(rd->f, &size) ||
+      fread(tag, 1, 4, rd->f) != 4 || memcmp(tag, "WAVE", 4) != 0) {
+    goto invalid;
+  }
+  // Walk the chunks until the data.
+  while (fread(tag, 1, 4, rd->f) == 4 && read_u32(rd->f, &size)) {
+    if (memcmp(tag, "fmt ", 4) == 0) {
+      uint8_t fmt[16];
+      if (size < sizeof(fmt) || fread(fmt, 1, sizeof(fmt), rd->f) != sizeof(fmt))
+        goto invalid;
+      unsigned format = fmt[0] | (fmt[1] << 8);
+      rd->channels = fmt[2] | (fmt[3] << 8);
+      rd->sample_rate = fmt[4] | (fmt[5] << 8) | (fmt[6] << 16) | ((uint32_t)fmt[7] << 24);
+      unsigned bits = fmt[14] | (fmt[15] << 8);
+      if (format != 1 || bits != 16 || !rd->channels || !rd->sample_rate) {
+        fprintf(stderr, "%s: only 16-bit PCM is supported\n", path);
+        a2_wav_reader_close(rd);
+        return false;
+      }
+      haveFmt = true;
+      size -= sizeof(fmt);
+    } else if (memcmp(tag, "data", 4) == 0) {
+      if (!haveFmt)
+        goto invalid;
+      rd->frames_left = size / (2 * rd->channels);
+      return true;
+    }
+    // Chunks are padded to an even size.
+    if (fseek(rd->f, (long)(size + (size & 1)), SEEK_CUR) != 0)
+      break;
+  }
+
+invalid:
+  fprintf(stderr, "%s: not a WAV file\n", path);
+  a2_wav_reader_close(rd);
+  return false;
+}
+
+unsigned a2_wav_reader_read(a2_wav_reader_t *rd, float *buf, unsigned count) {
+  if (count > rd->frames_left)
+    count = rd->frames_left;
+  unsigned n = 0;
+  for (; n != count; ++n) {
+    uint8_t frame[2 * 8];
+    unsigned frameSize = 2 * rd->channels;
+    // Only the first channel is used, skip the rest.
+    if (frameSize > sizeof(frame)) {
+      if (fread(frame, 1, 2, rd->f) != 2 || fseek(rd->f, frameSize - 2, SEEK_CUR) != 0)
+        break;
+    } else if (fread(frame, 1, frameSize, rd->f) != frameSize) {
+      break;
+    }
+    buf[n] = (int16_t)(frame[0] | (frame[1] << 8)) / 32768.0f;
+  }
+  rd->frames_left = n == count ? rd->frames_left - n : 0;
+  return n;
+}
+
+void a2_wav_reader_close(a2_wav_reader_t *rd) {
+  if (rd->f)
+    fclose(rd->f);
+  rd->f = NULL;
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) Tzvetan Mikov.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "blep.h"
+
+#include <math.h>
+
+#define BLEP_MASK (A2_BLEP_TAPS - 1)
+
+/// The band-limited impulse for every sub-sample phase. The taps of every
+/// phase add up to exactly 1, so a step always settles at its full height.
+static float s_blep[A2_BLEP_PHASES][A2_BLEP_TAPS];
+static bool s_blep_ready = false;
+
+void a2_blep_init_tables(void) {
+  if (s_blep_ready)
+    return;
+  s_blep_ready = true;
+
+  const double pi = 3.14159265358979323846;
+  // Slightly below Nyquist, to leave room for the transition band.
+  const double cutoff = 0.45;
+  for (unsigned phase = 0; phase != A2_BLEP_PHASES; ++phase) {
+    double frac = (double)phase / A2_BLEP_PHASES;
+    double sum = 0;
+    double taps[A2_BLEP_TAPS];
+    for (unsigned i = 0; i != A2_BLEP_TAPS; ++i) {
+      // Distance of the tap from the step, in samples.
+      double x = (double)i - (A2_BLEP_TAPS / 2 - 1) - frac;
+      double sinc = x == 0 ? 2 * cutoff : sin(2 * pi * cutoff * x) / (pi * x);
+      // Blackman window over (-TAPS/2, TAPS/2).
+      double w = (x + A2_BLEP_TAPS / 2) / A2_BLEP_TAPS;
+      double window = 0.42 - 0.5 * cos(2 * pi * w) + 0.08 * cos(4 * pi * w);
+      taps[i] = sinc * window;
+      sum += taps[i];
+    }
+    for (unsigned i = 0; i != A2_BLEP_TAPS; ++i)
+      s_blep[phase][i] = (float)(taps[i] / sum);
+  }
+}
+
+void a2_blep_init(a2_blep_t *b, uint64_t next_sample) {
+  a2_blep_init_tables();
+  memset(b, 0, sizeof(*b));
+  b->next_sample = b->settle_sample = next_sample;
+  b->last_state = -0.1f;
+  b->acc = b->last_state;
+}
+
+float *a2_blep_generate(a2_blep_t *b, float *d, unsigned channels, uint64_t count) {
+  while (count) {
+    if (b->next_sample >= b->settle_sample) {
+      // Nothing pending, the output is constant.
+      if (d) {
+        for (uint64_t i = 0; i != count * channels; ++i)
+          *d++ = b->last_state;
+      }
+      b->next_sample += count;
+      return d;
+    }
+
+    uint64_t pending = b->settle_sample - b->next_sample;
+    unsigned n = (unsigned)(pending < count ? pending : count);
+    float acc = b->acc;
+    unsigned pos = b->delta_pos;
+    for (unsigned i = 0; i != n; ++i) {
+      acc += b->deltas[pos];
+      b->deltas[pos] = 0;
+      pos = (pos + 1) & BLEP_MASK;
+      if (d) {
+        for (unsigned ch = 0; ch != channels; ++ch)
+          *d++ = acc;
+      }
+    }
+    b->delta_pos = pos;
+    b->next_sample += n;
+    count -= n;
+    // Once settled, snap to the exact level so rounding errors don't
+    // accumulate.
+    b->acc = b->next_sample >= b->settle_sample ? b->last_state : acc;
+  }
+  return d;
+}
+
+void a2_blep_toggle(a2_blep_t *b, double pos) {
+  uint64_t whole = (uint64_t)pos;
+  unsigned phase = (unsigned)((pos - (double)whole) * A2_BLEP_PHASES + 0.5);
+  if (phase == A2_BLEP_PHASES) {
+    phase = 0;
+    ++whole;
+  }
+  // The first sample affected by the impulse.
+  uint64_t start = whole - (A2_BLEP_TAPS / 2 - 1);
+  if (start < b->next_sample)
+    start = b->next_sample;
+
+  float delta = -2 * b->last_state;
+  b->last_state = -b->last_state;
+  const float *taps = s_blep[phase];
+  unsigned pos0 = b->delta_pos + (unsigned)(start - b->next_sample);
+  for (unsigned i = 0; i != A2_BLEP_TAPS; ++i)
+    b->deltas[(pos0 + i) & BLEP_MASK] += delta * taps[i];
+  b->settle_sample = start + A2_BLEP_TAPS;
+}
@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) Tzvetan Mikov.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include "apple2tc/a2io.h"
+
+/// Band-limited speaker synthesis, shared by the sound callback and the
+/// offline sinks. Sample positions are delayed by half the impulse length
+/// relative to the speaker, so an impulse never starts before `next_sample`.
+
+/// Initialize the impulse tables. Invoked automatically by a2_blep_init(), but
+/// not thread safe, so it must happen before any synthesis on other threads.
+void a2_blep_init_tables(void);
+
+/// Start with the speaker idle at sample \p next_sample.
+void a2_blep_init(a2_blep_t *b, uint64_t next_sample);
+
+/// Generate \p count samples into \p d, which has \p channels interleaved
+/// channels. If \p d is NULL, the samples are generated and discarded.
+/// Return the end of the output.
+float *a2_blep_generate(a2_blep_t *b, float *d, unsigned channels, uint64_t count);
+
+/// Toggle the speaker at sample position \p pos. All samples not affected by
+/// the toggle, up to a2_blep_settled_until(pos), must have been generated.
+void a2_blep_toggle(a2_blep_t *b, double pos);
+
+/// Return the end of the samples which are not affected by a toggle at \p pos.
+static inline uint64_t a2_blep_settled_until(double pos) {
+  return (uint64_t)pos - (A2_BLEP_TAPS / 2 - 1);
+}
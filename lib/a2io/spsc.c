@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) Tzvetan Mikov.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "apple2tc/spsc.h"
+
+#include <stdlib.h>
+
+void a2_spsc_init_buf(a2_spsc_t *q, void *buf, unsigned capacity, unsigned elem_size) {
+  assert(capacity && (capacity & (capacity - 1)) == 0 && "capacity must be a power of 2");
+  memset(q, 0, sizeof(*q));
+  q->data = (char *)buf;
+  q->mask = capacity - 1;
+  q->elem_size = elem_size;
+  q->owns_data = false;
+  atomic_init(&q->tail, 0);
+  atomic_init(&q->head, 0);
+}
+
+bool a2_spsc_init(a2_spsc_t *q, unsigned capacity, unsigned elem_size) {
+  void *buf = malloc((size_t)capacity * elem_size);
+  a2_spsc_init_buf(q, buf, capacity, elem_size);
+  q->owns_data = true;
+  return buf != NULL;
+}
+
+void a2_spsc_free(a2_spsc_t *q) {
+  if (q->owns_data)
+    free(q->data);
+  q->data = NULL;
+}
+
+/// Split \p count elements starting from \p index into at most two parts.
+static a2_spsc_parts_t make_parts(const a2_spsc_t *q, unsigned index, unsigned count) {
+  unsigned first = index & q->mask;
+  unsigned toEnd = a2_spsc_capacity(q) - first;
+  if (count <= toEnd)
+    return (a2_spsc_parts_t){.part1 = a2_spsc_slot(q, index), .count1 = count};
+  return (a2_spsc_parts_t){
+      .part1 = a2_spsc_slot(q, index),
+      .count1 = toEnd,
+      .part2 = q->data,
+      .count2 = count - toEnd,
+  };
+}
+
+a2_spsc_parts_t a2_spsc_reserve(a2_spsc_t *q, unsigned max) {
+  unsigned tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+  unsigned space = a2_spsc_capacity(q) - (tail - q->head_cache);
+  if (space < max) {
+    q->head_cache = atomic_load_explicit(&q->head, memory_order_acquire);
+    space = a2_spsc_capacity(q) - (tail - q->head_cache);
+  }
+  return make_parts(q, tail, max < space ? max : space);
+}
+
+a2_spsc_parts_t a2_spsc_peek(a2_spsc_t *q, unsigned max) {
+  unsigned head = atomic_load_explicit(&q->head, memory_order_relaxed);
+  unsigned count = q->tail_cache - head;
+  if (count < max) {
+    q->tail_cache = atomic_load_explicit(&q->tail, memory_order_acquire);
+    count = q->tail_cache - head;
+  }
+  return make_parts(q, head, max < count ? max : count);
+}
+
+unsigned a2_spsc_push(a2_spsc_t *q, const void *src, unsigned count) {
+  a2_spsc_parts_t parts = a2_spsc_reserve(q, count);
+  memcpy(parts.part1, src, (size_t)parts.count1 * q->elem_size);
+  if (parts.count2) {
+    memcpy(
+        parts.part2,
+        (const char *)src + (size_t)parts.count1 * q->elem_size,
+        (size_t)parts.count2 * q->elem_size);
+  }
+  a2_spsc_commit(q, parts.count1 + parts.count2);
+  return parts.count1 + parts.count2;
+}
+
+unsigned a2_spsc_pop(a2_spsc_t *q, void *dst, unsigned count) {
+  a2_spsc_parts_t parts = a2_spsc_peek(q, count);
+  memcpy(dst, parts.part1, (size_t)parts.count1 * q->elem_size);
+  if (parts.count2) {
+    memcpy(
+        (char *)dst + (size_t)parts.count1 * q->elem_size,
+        parts.part2,
+        (size_t)parts.count2 * q->elem_size);
+  }
+  a2_spsc_release(q, parts.count1 + parts.count2);
+  return parts.count1 + parts.count2;
+}
@@ -0,0 +1,878 @@
+/*
+ * Copyright (c) Tzvetan Mikov.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "apple2tc/apple2.h"
+
+#include "apple2tc/a2tape.h"
+
+#include <vector>
+
+/// Native implementations of hot Monitor and Applesoft ROM routines. They
+/// mirror the ROM code closely enough to leave exactly the same registers,
+/// flags and memory, including what the code leaves behind the stack pointer,
+/// and to count the same number of instructions. The inner loops, where the
+/// time goes, only compute their final effect.
+
+// Monitor zero page.
+static constexpr uint8_t WNDLFT = 0x20;
+static constexpr uint8_t WNDWDTH = 0x21;
+static constexpr uint8_t WNDTOP = 0x22;
+static constexpr uint8_t WNDBTM = 0x23;
+static constexpr uint8_t CH = 0x24;
+static constexpr uint8_t CV = 0x25;
+static constexpr uint8_t GBASL = 0x26;
+static constexpr uint8_t BASL = 0x28;
+static constexpr uint8_t BASH = 0x29;
+static constexpr uint8_t BAS2L = 0x2A;
+static constexpr uint8_t BAS2H = 0x2B;
+static constexpr uint8_t CHKSUM = 0x2E;
+static constexpr uint8_t LASTIN = 0x2F;
+static constexpr uint8_t HMASK = 0x30;
+static constexpr uint8_t INVFLG = 0x32;
+static constexpr uint8_t YSAV1 = 0x35;
+static constexpr uint8_t A1L = 0x3C;
+static constexpr uint8_t A2L = 0x3E;
+// Applesoft hires zero page.
+static constexpr uint8_t HPTRL = 0x1A;
+static constexpr uint8_t HPTRH = 0x1B;
+static constexpr uint8_t HCOLOR1 = 0x1C;
+static constexpr uint8_t HGRX = 0xE0;
+static constexpr uint8_t HGRY = 0xE2;
+static constexpr uint8_t HGRCOLOR = 0xE4;
+static constexpr uint8_t HGRHORIZ = 0xE5;
+static constexpr uint8_t HPAG = 0xE6;
+// Applesoft floating point zero page.
+static constexpr uint8_t INDEX = 0x5E;
+static constexpr uint8_t FAC = 0x9D;
+static constexpr uint8_t FACSIGN = 0xA2;
+static constexpr uint8_t ARG = 0xA5;
+static constexpr uint8_t ARGSIGN = 0xAA;
+static constexpr uint8_t SGNCPR = 0xAB;
+static constexpr uint8_t FACEXT = 0xAC;
+
+// Entry points.
+static constexpr uint16_t UPAY2ARG = 0xE9E3;
+static constexpr uint16_t UPAY2FAC = 0xEAF9;
+static constexpr uint16_t FACRND2XY = 0xEB2B;
+static constexpr uint16_t HCLR = 0xF3F2;
+static constexpr uint16_t BKGND = 0xF3F6;
+static constexpr uint16_t HPOSN = 0xF411;
+static constexpr uint16_t HPLOT0 = 0xF457;
+/// The hires bit masks, indexed by the remainder of the division by 7 minus 7.
+static constexpr uint16_t MSKTBL_M7 = 0xF4B9;
+static constexpr uint16_t CLREOP = 0xFC42;
+static constexpr uint16_t HOME = 0xFC58;
+static constexpr uint16_t SCROLL = 0xFC70;
+static constexpr uint16_t CLREOL = 0xFC9C;
+static constexpr uint16_t CLEOLZ = 0xFC9E;
+static constexpr uint16_t WAIT = 0xFCA8;
+static constexpr uint16_t WAIT_LOOP = 0xFCA9;
+static constexpr uint16_t MON_WRITE = 0xFECD;
+static constexpr uint16_t MON_READ = 0xFEFD;
+static constexpr uint16_t MON_RDERR = 0xFF2D;
+static constexpr uint16_t COUT1 = 0xFDF0;
+static constexpr uint16_t BELL = 0xFF3A;
+
+namespace {
+
+/// The CPU state of a native routine, with helpers mirroring the effect of
+/// individual instructions.
+struct Cpu {
+  Emu6502 *const emu;
+  Emu6502::Regs r;
+  /// Number of instructions executed so far.
+  unsigned count = 0;
+
+  explicit Cpu(Emu6502 *emu) : emu(emu), r(emu->getRegs()) {}
+
+  [[nodiscard]] bool decimal() const {
+    return r.status & Emu6502::STATUS_D;
+  }
+  [[nodiscard]] bool carry() const {
+    return r.status & Emu6502::STATUS_C;
+  }
+  void setC(bool c) {
+    r.status = (r.status & ~Emu6502::STATUS_C) | (c ? Emu6502::STATUS_C : 0);
+  }
+  uint8_t nz(uint8_t v) {
+    r.status = (r.status & ~(Emu6502::STATUS_N | Emu6502::STATUS_Z)) | (v & Emu6502::STATUS_N) |
+        (v ? 0 : Emu6502::STATUS_Z);
+    return v;
+  }
+  /// Binary mode ADC.
+  uint8_t adc(uint8_t a, uint8_t m) {
+    unsigned v = a + m + carry();
+    nz((uint8_t)v);
+    setC(v > 0xFF);
+    r.status = (r.status & ~Emu6502::STATUS_V) | (((~(a ^ m) & (a ^ v)) >> 1) & Emu6502::STATUS_V);
+    return (uint8_t)v;
+  }
+  /// CMP, CPX, CPY.
+  void cmp(uint8_t a, uint8_t m) {
+    nz(a - m);
+    setC(a >= m);
+  }
+
+  [[nodiscard]] uint8_t zp(uint8_t addr) const {
+    return emu->ram_peek(addr);
+  }
+  void setZP(uint8_t addr, uint8_t v) {
+    emu->ram_poke(addr, v);
+  }
+  [[nodiscard]] uint16_t zp16(uint8_t addr) const {
+    return zp(addr) + (zp(addr + 1) << 8);
+  }
+
+  void push(uint8_t v) {
+    emu->ram_poke(Emu6502::STACK_PAGE_ADDR + r.sp--, v);
+  }
+  uint8_t pop() {
+    return emu->ram_peek(Emu6502::STACK_PAGE_ADDR + ++r.sp);
+  }
+  /// JSR located at \p addr.
+  void jsr(uint16_t addr) {
+    push((addr + 2) >> 8);
+    push(addr + 2);
+    ++count;
+  }
+  void rts() {
+    uint8_t lo = pop();
+    r.pc = (lo + (pop() << 8) + 1) & 0xFFFF;
+    ++count;
+  }
+
+  void setV(bool v) {
+    r.status = (r.status & ~Emu6502::STATUS_V) | (v ? Emu6502::STATUS_V : 0);
+  }
+
+  unsigned finish() {
+    emu->setRegs(r);
+    return count;
+  }
+};
+
+} // namespace
+
+/// VTABZ ($FC24) up to its RTS: calculate BASL/BASH of the text line in A,
+/// relative to the left edge of the window.
+static void vtabz(Cpu &c) {
+  // JSR BASCALC
+  c.jsr(0xFC24);
+  uint8_t line = c.r.a;
+  // PHA, LSR, AND #3, ORA #4, STA BASH, PLA, AND #$18, BCC
+  c.push(line);
+  c.setC(line & 1);
+  c.setZP(BASH, ((line >> 1) & 3) | 4);
+  c.pop();
+  uint8_t a = c.nz(line & 0x18);
+  c.count += 8;
+  // ADC #$7F
+  if (c.carry()) {
+    a = c.adc(a, 0x7F);
+    ++c.count;
+  }
+  // STA BASL, ASL, ASL, ORA BASL, STA BASL
+  c.setC(a & 0x40);
+  a = c.nz((uint8_t)(a << 2) | a);
+  c.count += 5;
+  c.rts();
+  // ADC WNDLFT, STA BASL
+  c.r.a = c.adc(a, c.zp(WNDLFT));
+  c.setZP(BASL, c.r.a);
+  c.count += 2;
+}
+
+/// CLEOLZ ($FC9E) including its RTS: clear the text line at BASL from column Y
+/// to the right edge of the window.
+static void cleolz(Cpu &c) {
+  uint16_t bas = c.zp16(BASL);
+  uint8_t width = c.zp(WNDWDTH);
+  uint8_t y = c.r.y;
+  // LDA #$A0, then STA (BASL),Y, INY, CPY WNDWDTH, BCC for every column.
+  c.r.a = c.nz(0xA0);
+  ++c.count;
+  do {
+    c.emu->poke(bas + y, 0xA0);
+    ++y;
+    c.count += 4;
+  } while (y < width);
+  c.cmp(y, width);
+  c.r.y = y;
+  c.rts();
+}
+
+/// VTAB ($FC22) including its RTS.
+static void vtab(Cpu &c) {
+  c.r.a = c.nz(c.zp(CV));
+  ++c.count;
+  vtabz(c);
+  c.rts();
+}
+
+/// CLEOP1 ($FC46) including its RTS: clear the window from the line in A,
+/// starting from column Y.
+static void cleop1(Cpu &c) {
+  do {
+    // PHA, JSR VTABZ, JSR CLEOLZ
+    c.push(c.r.a);
+    ++c.count;
+    c.jsr(0xFC47);
+    vtabz(c);
+    c.rts();
+    c.jsr(0xFC4A);
+    cleolz(c);
+    // LDY #0, PLA, ADC #0, CMP WNDBTM, BCC CLEOP1
+    c.r.y = 0;
+    uint8_t a = c.adc(c.pop(), 0);
+    c.cmp(a, c.zp(WNDBTM));
+    c.r.a = a;
+    c.count += 5;
+  } while (!c.carry());
+  // BCS VTAB
+  ++c.count;
+  vtab(c);
+}
+
+static unsigned hleCLREOP(Emu6502 *emu) {
+  Cpu c(emu);
+  if (c.decimal())
+    return 0;
+  // LDY CH, LDA CV
+  c.r.y = c.zp(CH);
+  c.r.a = c.nz(c.zp(CV));
+  c.count += 2;
+  cleop1(c);
+  return c.finish();
+}
+
+static unsigned hleHOME(Emu6502 *emu) {
+  Cpu c(emu);
+  if (c.decimal())
+    return 0;
+  // LDA WNDTOP, STA CV, LDY #0, STY CH, BEQ CLEOP1
+  c.r.a = c.zp(WNDTOP);
+  c.setZP(CV, c.r.a);
+  c.r.y = c.nz(0);
+  c.setZP(CH, 0);
+  c.count += 5;
+  cleop1(c);
+  return c.finish();
+}
+
+/// SCROLL ($FC70) including its RTS: scroll the window up by one line and
+/// clear the bottom line.
+static void scroll(Cpu &c) {
+  // LDA WNDTOP, PHA, JSR VTABZ
+  c.r.a = c.nz(c.zp(WNDTOP));
+  c.push(c.r.a);
+  c.count += 2;
+  c.jsr(0xFC73);
+  vtabz(c);
+  c.rts();
+  for (;;) {
+    // LDA BASL, STA BAS2L, LDA BASH, STA BAS2H, LDY WNDWDTH, DEY, PLA,
+    // ADC #1, CMP WNDBTM, BCS
+    c.setZP(BAS2L, c.zp(BASL));
+    c.setZP(BAS2H, c.zp(BASH));
+    c.r.y = c.zp(WNDWDTH) - 1;
+    c.r.a = c.adc(c.pop(), 1);
+    c.cmp(c.r.a, c.zp(WNDBTM));
+    c.count += 10;
+    if (c.carry())
+      break;
+    // PHA, JSR VTABZ
+    c.push(c.r.a);
+    ++c.count;
+    c.jsr(0xFC89);
+    vtabz(c);
+    c.rts();
+    // LDA (BASL),Y, STA (BAS2L),Y, DEY, BPL for every column, then BMI.
+    uint16_t src = c.zp16(BASL);
+    uint16_t dst = c.zp16(BAS2L);
+    uint8_t y = c.r.y;
+    do {
+      c.r.a = c.emu->peek(src + y);
+      c.emu->poke(dst + y, c.r.a);
+      c.count += 4;
+    } while (!(--y & 0x80));
+    c.r.y = c.nz(y);
+    ++c.count;
+  }
+  // LDY #0, JSR CLEOLZ, BCS VTAB
+  c.r.y = 0;
+  ++c.count;
+  c.jsr(0xFC97);
+  cleolz(c);
+  ++c.count;
+  vtab(c);
+}
+
+static unsigned hleSCROLL(Emu6502 *emu) {
+  Cpu c(emu);
+  if (c.decimal())
+    return 0;
+  scroll(c);
+  return c.finish();
+}
+
+/// Return true if the text line at BASL, indexed by any Y, is in plain RAM.
+static bool basInRAM(const Cpu &c) {
+  uint8_t bash = c.zp(BASH);
+  return bash >= 0x02 && bash < 0xBF;
+}
+
+static unsigned hleCLREOL(Emu6502 *emu) {
+  Cpu c(emu);
+  if (!basInRAM(c))
+    return 0;
+  // LDY CH
+  c.r.y = c.nz(c.zp(CH));
+  ++c.count;
+  cleolz(c);
+  return c.finish();
+}
+
+static unsigned hleCLEOLZ(Emu6502 *emu) {
+  Cpu c(emu);
+  if (!basInRAM(c))
+    return 0;
+  cleolz(c);
+  return c.finish();
+}
+
+/// CARRETURN ($FC62) including its RTS: move the cursor to the start of the
+/// next line, scrolling the window at its bottom.
+static void carriageReturn(Cpu &c) {
+  // LDA #0, STA CH, INC CV, LDA CV, CMP WNDBTM, BCC VTABZ
+  c.setZP(CH, 0);
+  uint8_t cv = c.zp(CV) + 1;
+  c.setZP(CV, cv);
+  c.r.a = cv;
+  c.cmp(cv, c.zp(WNDBTM));
+  c.count += 6;
+  if (!c.carry()) {
+    vtabz(c);
+    c.rts();
+    return;
+  }
+  // DEC CV
+  c.setZP(CV, cv - 1);
+  ++c.count;
+  scroll(c);
+}
+
+/// COUT1 ($FDF0): print the character in A at the cursor. Only characters
+/// which are stored on the screen and the carriage return are handled, the
+/// rest of the control characters and a pending Ctrl-S pause are declined.
+static unsigned hleCOUT1(Emu6502 *emu) {
+  Cpu c(emu);
+  if (c.decimal() || !basInRAM(c))
+    return 0;
+  // CMP #$A0, BCC COUTZ, AND INVFLG
+  uint8_t ch = c.r.a;
+  c.cmp(ch, 0xA0);
+  c.count += 2;
+  if (c.carry()) {
+    ch = c.nz(ch & c.zp(INVFLG));
+    ++c.count;
+  }
+  bool cr = ch == 0x8D;
+  if (ch >= 0x80 && ch < 0xA0 && !cr)
+    return 0;
+  // VIDWAIT checks the keyboard for Ctrl-S after a carriage return.
+  uint8_t key = cr ? c.emu->peek(A2_KBD) : 0;
+  if (key == 0x93)
+    return 0;
+
+  // STY YSAV1, PHA, JSR VIDWAIT, CMP #$8D, BNE NOWAIT
+  c.setZP(YSAV1, c.r.y);
+  c.push(ch);
+  c.jsr(0xFDF9);
+  c.count += 4;
+  if (cr) {
+    // LDY KBD, BPL NOWAIT, then CPY #$93, BNE NOWAIT if a key is pressed.
+    c.r.y = key;
+    c.count += key & 0x80 ? 4 : 2;
+  }
+  // JMP VIDOUT, CMP #$A0, BCS STORADV
+  c.cmp(ch, 0xA0);
+  c.count += 3;
+  if (!c.carry()) {
+    // TAY, BPL STORADV, then CMP #$8D, BEQ CARRETURN
+    c.r.y = c.nz(ch);
+    c.count += 2;
+    if (cr) {
+      c.cmp(ch, 0x8D);
+      c.count += 2;
+    }
+  }
+  bool newline = cr;
+  if (!cr) {
+    // LDY CH, STA (BASL),Y, INC CH, LDA CH, CMP WNDWDTH, BCS CARRETURN
+    uint8_t h = c.zp(CH);
+    c.emu->poke(c.zp16(BASL) + h, ch);
+    c.r.y = h++;
+    c.setZP(CH, h);
+    c.r.a = h;
+    c.cmp(h, c.zp(WNDWDTH));
+    c.count += 6;
+    newline = c.carry();
+    if (!newline)
+      c.rts();
+  }
+  if (newline)
+    carriageReturn(c);
+  // PLA, LDY YSAV1, RTS
+  c.r.a = c.nz(c.pop());
+  c.r.y = c.nz(c.zp(YSAV1));
+  c.count += 2;
+  c.rts();
+  return c.finish();
+}
+
+/// The outer loop of WAIT ($FCA9), entered with the carry set: for every A
+/// down to 1, PHA, A times SBC #1 and BNE, then PLA, SBC #1, BNE, and finally
+/// RTS. Only the iterations which fit in the current run are executed, so a
+/// long delay still takes its time and doesn't hold back pending events.
+static void waitLoop(Cpu &c) {
+  // Every instruction takes 3 cycles.
+  unsigned left = c.emu->getRunCyclesLeft() / 3;
+  unsigned a = c.r.a;
+  uint8_t pushed = 0;
+  while (a && c.count + 2 * a + 4 <= left) {
+    c.count += 2 * a + 4;
+    pushed = a--;
+  }
+  if (!pushed)
+    return;
+  c.push(pushed);
+  c.pop();
+  c.r.a = c.nz(a);
+  c.setC(true);
+  // SBC #1 overflows only from $80 to $7F.
+  c.r.status = (c.r.status & ~Emu6502::STATUS_V) | (a == 0x7F ? Emu6502::STATUS_V : 0);
+  if (a)
+    c.r.pc = WAIT_LOOP;
+  else
+    c.rts();
+}
+
+static unsigned hleWAIT(Emu6502 *emu) {
+  Cpu c(emu);
+  // A=0 wraps around with the carry clear, which isn't worth the trouble.
+  if (c.decimal() || c.r.a == 0)
+    return 0;
+  // SEC
+  c.setC(true);
+  c.r.pc = WAIT_LOOP;
+  c.count = 1;
+  waitLoop(c);
+  return c.finish();
+}
+
+static unsigned hleWAITLoop(Emu6502 *emu) {
+  Cpu c(emu);
+  if (c.decimal() || c.r.a == 0 || !c.carry())
+    return 0;
+  waitLoop(c);
+  return c.count ? c.finish() : 0;
+}
+
+/// BKGND ($F3F6) including its RTS: fill the hires page at HPAG with
+/// HCOLOR1, alternating it every byte if the color is green or violet.
+static void bkgnd(Cpu &c) {
+  // LDA HPAG, STA HPTRH, LDY #0, STY HPTRL
+  uint8_t page = c.zp(HPAG);
+  uint8_t color = c.zp(HCOLOR1);
+  c.count += 4;
+  uint8_t shifted = 0;
+  do {
+    // LDA HCOLOR1, STA (HPTRL),Y, JSR $F47E: ASL, CMP #$C0, BPL, then
+    // LDA HCOLOR1, EOR #$7F, STA HCOLOR1 unless the branch is taken, RTS.
+    // INY, BNE.
+    for (unsigned y = 0; y != 256; ++y) {
+      c.emu->poke((page << 8) + y, color);
+      shifted = color << 1;
+      if ((uint8_t)(shifted - 0xC0) & 0x80) {
+        color ^= 0x7F;
+        c.count += 12;
+      } else {
+        c.count += 9;
+      }
+    }
+    // INC HPTRH, LDA HPTRH, AND #$1F, BNE
+    ++page;
+    c.count += 4;
+  } while (page & 0x1F);
+  c.setZP(HPTRL, 0);
+  c.setZP(HPTRH, page);
+  c.setZP(HCOLOR1, color);
+  // What the last JSR left behind the stack pointer.
+  c.push(0xF4);
+  c.push(0x04);
+  c.pop();
+  c.pop();
+  c.r.a = c.nz(0);
+  c.r.y = 0;
+  c.setC(shifted >= 0xC0);
+  c.rts();
+}
+
+/// Return true if the hires page at HPAG is in plain RAM.
+static bool hpagInRAM(const Cpu &c) {
+  uint8_t page = c.zp(HPAG);
+  return page >= 0x02 && (page | 0x1F) < 0xC0;
+}
+
+static unsigned hleHCLR(Emu6502 *emu) {
+  Cpu c(emu);
+  if (!hpagInRAM(c))
+    return 0;
+  // LDA #0, STA HCOLOR1
+  c.setZP(HCOLOR1, 0);
+  c.count += 2;
+  bkgnd(c);
+  return c.finish();
+}
+
+static unsigned hleBKGND(Emu6502 *emu) {
+  Cpu c(emu);
+  if (!hpagInRAM(c))
+    return 0;
+  bkgnd(c);
+  return c.finish();
+}
+
+/// COLORSHIFT ($F47E) including its RTS: shift the color in A for an odd
+/// column, flipping HCOLOR1 unless it is black or white.
+static void colorShift(Cpu &c) {
+  // ASL, CMP #$C0, BPL, then LDA HCOLOR1, EOR #$7F, STA HCOLOR1 unless the
+  // branch is taken.
+  uint8_t shifted = c.r.a << 1;
+  c.cmp(shifted, 0xC0);
+  c.r.a = shifted;
+  c.count += 3;
+  if (c.r.status & Emu6502::STATUS_N) {
+    c.r.a = c.nz(c.zp(HCOLOR1) ^ 0x7F);
+    c.setZP(HCOLOR1, c.r.a);
+    c.count += 3;
+  }
+  c.rts();
+}
+
+/// HPOSN ($F411) including its RTS: position the hires cursor at the column
+/// in Y:X and the row in A.
+static void hposn(Cpu &c) {
+  // STA HGRY, STX HGRX, STY HGRX+1
+  uint8_t row = c.r.a;
+  c.setZP(HGRY, row);
+  c.setZP(HGRX, c.r.x);
+  c.setZP(HGRX + 1, c.r.y);
+  // PHA, AND #$C0, STA GBASL, LSR, LSR, ORA GBASL, STA GBASL, PLA, STA GBASH,
+  // ASL, ASL, ASL, ROL GBASH, ASL, ROL GBASH, ASL, ROR GBASL, LDA GBASH,
+  // AND #$1F, ORA HPAG, STA GBASH
+  c.push(row);
+  c.pop();
+  uint8_t gbasl = (row & 0xC0) | ((row & 0xC0) >> 2);
+  uint8_t gbash = (uint8_t)(row << 2) | ((row >> 4) & 2) | ((row >> 4) & 1);
+  c.setZP(GBASL, ((row << 4) & 0x80) | (gbasl >> 1));
+  c.setZP(GBASL + 1, (gbash & 0x1F) | c.zp(HPAG));
+  // TXA, CPY #0, BEQ
+  uint8_t a = c.r.x;
+  uint8_t y = c.r.y;
+  c.setC(true);
+  c.count += 27;
+  if (y) {
+    // LDY #35, ADC #4, INY
+    a = c.adc(a, 4);
+    y = 36;
+    c.count += 3;
+  }
+  // SBC #7, BCS, INY until the subtraction borrows.
+  for (;;) {
+    a = c.adc(a, ~7);
+    c.count += 2;
+    if (!c.carry())
+      break;
+    ++y;
+    ++c.count;
+  }
+  // STY HGRHORIZ, TAX, LDA MSKTBL-249,X, STA HMASK, TYA, LSR, LDA HGRCOLOR,
+  // STA HCOLOR1, BCS COLORSHIFT
+  c.setZP(HGRHORIZ, y);
+  c.r.x = a;
+  c.setZP(HMASK, c.emu->peek(MSKTBL_M7 + a));
+  c.r.y = y;
+  c.setC(y & 1);
+  c.r.a = c.nz(c.zp(HGRCOLOR));
+  c.setZP(HCOLOR1, c.r.a);
+  c.count += 9;
+  if (c.carry())
+    colorShift(c);
+  else
+    c.rts();
+}
+
+static unsigned hleHPOSN(Emu6502 *emu) {
+  Cpu c(emu);
+  if (c.decimal())
+    return 0;
+  hposn(c);
+  return c.finish();
+}
+
+/// Return true if the hires page at HPAG is in plain RAM, together with the
+/// page after it, into which a column past the end of the last line reaches.
+static bool hplotInRAM(const Cpu &c) {
+  uint8_t page = c.zp(HPAG);
+  return page >= 0x02 && (page | 0x1F) < 0xBF;
+}
+
+static unsigned hleHPLOT0(Emu6502 *emu) {
+  Cpu c(emu);
+  if (c.decimal() || !hplotInRAM(c))
+    return 0;
+  // JSR HPOSN
+  c.jsr(HPLOT0);
+  hposn(c);
+  // LDA HCOLOR1, EOR (GBASL),Y, AND HMASK, EOR (GBASL),Y, STA (GBASL),Y, RTS
+  uint16_t addr = c.zp16(GBASL) + c.r.y;
+  uint8_t old = c.emu->peek(addr);
+  c.r.a = c.nz(((c.zp(HCOLOR1) ^ old) & c.zp(HMASK)) ^ old);
+  c.emu->poke(addr, c.r.a);
+  c.count += 5;
+  c.rts();
+  return c.finish();
+}
+
+/// Return true if the 5 bytes of a packed floating point number at \p addr
+/// don't overlap the IO range.
+static bool numberInMemory(uint16_t addr) {
+  return addr + 4 < A2_IO_RANGE_START || addr > A2_IO_RANGE_END;
+}
+
+static unsigned hleUPAY2ARG(Emu6502 *emu) {
+  Cpu c(emu);
+  uint16_t addr = c.r.a + (c.r.y << 8);
+  if (!numberInMemory(addr))
+    return 0;
+  // STA INDEX, STY INDEX+1, LDY #4, then LDA (INDEX),Y, STA, DEY for every
+  // byte in the same order as the ROM, in case the number overlaps ARG.
+  c.setZP(INDEX, c.r.a);
+  c.setZP(INDEX + 1, c.r.y);
+  c.setZP(ARG + 4, c.emu->peek(addr + 4));
+  c.setZP(ARG + 3, c.emu->peek(addr + 3));
+  c.setZP(ARG + 2, c.emu->peek(addr + 2));
+  // STA ARGSIGN, EOR FACSIGN, STA SGNCPR, LDA ARGSIGN, ORA #$80, STA ARG+1
+  uint8_t top = c.emu->peek(addr + 1);
+  c.setZP(ARGSIGN, top);
+  c.setZP(SGNCPR, top ^ c.zp(FACSIGN));
+  c.setZP(ARG + 1, top | 0x80);
+  c.setZP(ARG, c.emu->peek(addr));
+  // LDA FAC
+  c.r.y = 0;
+  c.r.a = c.nz(c.zp(FAC));
+  c.count += 23;
+  c.rts();
+  return c.finish();
+}
+
+static unsigned hleUPAY2FAC(Emu6502 *emu) {
+  Cpu c(emu);
+  uint16_t addr = c.r.a + (c.r.y << 8);
+  if (!numberInMemory(addr))
+    return 0;
+  // Like UPAY2ARG, but without SGNCPR.
+  c.setZP(INDEX, c.r.a);
+  c.setZP(INDEX + 1, c.r.y);
+  c.setZP(FAC + 4, c.emu->peek(addr + 4));
+  c.setZP(FAC + 3, c.emu->peek(addr + 3));
+  c.setZP(FAC + 2, c.emu->peek(addr + 2));
+  uint8_t top = c.emu->peek(addr + 1);
+  c.setZP(FACSIGN, top);
+  c.setZP(FAC + 1, top | 0x80);
+  c.r.a = c.nz(c.emu->peek(addr));
+  c.setZP(FAC, c.r.a);
+  // STY FACEXT
+  c.r.y = 0;
+  c.setZP(FACEXT, 0);
+  c.count += 20;
+  c.rts();
+  return c.finish();
+}
+
+/// Return true if rounding FAC carries out of the mantissa, into FROUND.
+static bool roundCarries(const Cpu &c) {
+  return c.zp(FAC) && (c.zp(FACEXT) & 0x80) && c.zp(FAC + 1) == 0xFF && c.zp(FAC + 2) == 0xFF &&
+      c.zp(FAC + 3) == 0xFF && c.zp(FAC + 4) == 0xFF;
+}
+
+/// ROUND_FAC ($EB72) including its RTS, unless roundCarries().
+static void roundFAC(Cpu &c) {
+  // LDA FAC, BEQ
+  c.r.a = c.nz(c.zp(FAC));
+  c.count += 2;
+  if (c.r.a) {
+    // ASL FACEXT, BCC
+    uint8_t ext = c.zp(FACEXT);
+    c.setC(ext & 0x80);
+    c.setZP(FACEXT, c.nz(ext << 1));
+    c.count += 2;
+    if (c.carry()) {
+      // JSR INCFACMAN: INC, BNE from the lowest byte of the mantissa, RTS.
+      c.jsr(0xEB7A);
+      for (uint8_t i = FAC + 4;; --i) {
+        uint8_t v = c.nz(c.zp(i) + 1);
+        c.setZP(i, v);
+        if (i == FAC + 1) {
+          ++c.count;
+          break;
+        }
+        c.count += 2;
+        if (v)
+          break;
+      }
+      c.rts();
+      // BNE
+      ++c.count;
+    }
+  }
+  c.rts();
+}
+
+static unsigned hleFACRND2XY(Emu6502 *emu) {
+  Cpu c(emu);
+  uint16_t addr = c.r.x + (c.r.y << 8);
+  if (!numberInMemory(addr) || roundCarries(c))
+    return 0;
+  // JSR ROUND_FAC
+  c.jsr(FACRND2XY);
+  roundFAC(c);
+  // STX INDEX, STY INDEX+1, LDY #4, then LDA, STA (INDEX),Y, DEY for every
+  // byte, packing the sign into the top of the mantissa with
+  // LDA FACSIGN, ORA #$7F, AND FAC+1.
+  c.setZP(INDEX, c.r.x);
+  c.setZP(INDEX + 1, c.r.y);
+  c.emu->poke(addr + 4, c.zp(FAC + 4));
+  c.emu->poke(addr + 3, c.zp(FAC + 3));
+  c.emu->poke(addr + 2, c.zp(FAC + 2));
+  c.emu->poke(addr + 1, (c.zp(FACSIGN) | 0x7F) & c.zp(FAC + 1));
+  c.r.a = c.nz(c.zp(FAC));
+  c.emu->poke(addr, c.r.a);
+  // STY FACEXT
+  c.r.y = 0;
+  c.setZP(FACEXT, 0);
+  c.count += 20;
+  c.rts();
+  return c.finish();
+}
+
+/// Return the length of the range A1..A2 transferred by READ and WRITE, or 0
+/// if it wraps around or overlaps the IO range, which isn't plain memory.
+static unsigned tapeRange(const Cpu &c) {
+  unsigned a1 = c.zp16(A1L);
+  unsigned a2 = c.zp16(A2L);
+  if (a2 < a1 || (a1 <= A2_IO_RANGE_END && a2 >= A2_IO_RANGE_START))
+    return 0;
+  return a2 - a1 + 1;
+}
+
+/// The Monitor tape routines leave A1 after the range, through NXTA1.
+static void tapeEnd(Cpu &c, unsigned len) {
+  uint16_t a1 = c.zp16(A1L) + len;
+  c.setZP(A1L, a1);
+  c.setZP(A1L + 1, a1 >> 8);
+}
+
+/// READ ($FEFD) up to the checksum comparison: read the record into A1..A2.
+/// It continues with BELL or with the error message, like the ROM.
+static unsigned fastREAD(Emu6502 *emu) {
+  a2_tape_t *tape = static_cast<EmuApple2 *>(emu)->io()->tape;
+  Cpu c(emu);
+  unsigned len;
+  // HEADER counts with ADC, which decimal mode would change.
+  if (!tape || c.decimal() || !(len = tapeRange(c)))
+    return 0;
+  std::vector<uint8_t> data(len);
+  uint8_t checksum;
+  if (!a2_tape_read_block(tape, data.data(), len, &checksum))
+    return 0;
+
+  uint16_t a1 = c.zp16(A1L);
+  uint8_t sum = 0xFF;
+  for (unsigned i = 0; i != len; ++i) {
+    emu->poke(a1 + i, data[i]);
+    sum ^= data[i];
+  }
+  tapeEnd(c, len);
+  c.setZP(CHKSUM, sum);
+  c.setZP(LASTIN, a2_tape_level(tape) ? 0x80 : 0);
+  // RDBYTE leaves X=0 and Y=$3A. HEADER's last ADC clears V. CMP CHKSUM.
+  c.r.a = checksum;
+  c.r.x = 0;
+  c.r.y = 0x3A;
+  c.setV(false);
+  c.cmp(checksum, sum);
+  c.r.pc = checksum == sum ? BELL : MON_RDERR;
+  // The transfer takes no time, as if it were a single instruction.
+  c.count = 1;
+  return c.finish();
+}
+
+/// WRITE ($FECD) up to BEQ BELL: write A1..A2 and the checksum to the tape.
+static unsigned fastWRITE(Emu6502 *emu) {
+  a2_tape_t *tape = static_cast<EmuApple2 *>(emu)->io()->tape;
+  Cpu c(emu);
+  unsigned len;
+  if (!tape || c.decimal() || !(len = tapeRange(c)))
+    return 0;
+  uint16_t a1 = c.zp16(A1L);
+  std::vector<uint8_t> data(len);
+  uint8_t sum = 0xFF;
+  for (unsigned i = 0; i != len; ++i)
+    sum ^= data[i] = emu->peek(a1 + i);
+  // LDA #64 before HEADER: 64 * 256 half cycles.
+  a2_tape_write_block(tape, 64 * 256, data.data(), len);
+
+  tapeEnd(c, len);
+  // WRBYTE shifts the checksum out of A, and leaves X=0 and Y=44.
+  c.r.a = 0;
+  c.r.x = c.nz(0);
+  c.r.y = 0x2C;
+  c.setC(sum & 1);
+  c.setV(false);
+  c.r.pc = BELL;
+  c.count = 1;
+  return c.finish();
+}
+
+void EmuApple2::enableHLE() {
+  setTrap(UPAY2ARG, hleUPAY2ARG);
+  setTrap(UPAY2FAC, hleUPAY2FAC);
+  setTrap(FACRND2XY, hleFACRND2XY);
+  setTrap(HCLR, hleHCLR);
+  setTrap(BKGND, hleBKGND);
+  setTrap(HPOSN, hleHPOSN);
+  setTrap(HPLOT0, hleHPLOT0);
+  setTrap(CLREOP, hleCLREOP);
+  setTrap(HOME, hleHOME);
+  setTrap(SCROLL, hleSCROLL);
+  setTrap(CLREOL, hleCLREOL);
+  setTrap(CLEOLZ, hleCLEOLZ);
+  setTrap(COUT1, hleCOUT1);
+  enableFastWait();
+}
+
+void EmuApple2::enableFastWait() {
+  setTrap(WAIT, hleWAIT);
+  setTrap(WAIT_LOOP, hleWAITLoop);
+}
+
+void EmuApple2::enableFastTape() {
+  setTrap(MON_READ, fastREAD);
+  setTrap(MON_WRITE, fastWRITE);
+}
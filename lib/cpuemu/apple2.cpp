@@ -9,11 +9,49 @@
 
 #include <cassert>
 
+EmuApple2::~EmuApple2() {
+  unloadHybrid();
+  a2_io_done(&io_);
+}
+
 uint8_t EmuApple2::ioPeek(uint16_t addr) {
   assert(addr >= IO_RANGE_START && addr <= IO_RANGE_END);
+  if ((addr & 0xFFF0) == LC_SWITCHES) {
+    languageCardAccess(addr, false);
+    return 0;
+  }
   return a2_io_peek(&io_, addr, getCycles());
 }
 
 void EmuApple2::ioPoke(uint16_t addr, uint8_t value) {
+  if ((addr & 0xFFF0) == LC_SWITCHES) {
+    languageCardAccess(addr, true);
+    return;
+  }
   a2_io_poke(&io_, addr, value, getCycles());
 }
+
+void EmuApple2::languageCardAccess(uint16_t addr, bool write) {
+  lcSwitch_ = addr & 0xF;
+  if (!(addr & 1)) {
+    lcWrite_ = false;
+    lcPrewrite_ = false;
+  } else if (write) {
+    // Writes don't count towards the two reads enabling writes.
+    lcPrewrite_ = false;
+  } else {
+    lcWrite_ |= lcPrewrite_;
+    lcPrewrite_ = true;
+  }
+  updateLanguageCard();
+}
+
+void EmuApple2::updateLanguageCard() {
+  // Switching is only a change of the page tables, so accesses to RAM and ROM
+  // don't check the state.
+  bool readRAM = (lcSwitch_ & 1) == ((lcSwitch_ >> 1) & 1);
+  uint8_t *bankD = lcRAM_ + (lcSwitch_ & 8 ? 0 : 0x1000);
+  uint8_t *bankEF = lcRAM_ + 0x2000;
+  mapPages(0xD0, 0x10, readRAM ? bankD : nullptr, lcWrite_ ? bankD : nullptr);
+  mapPages(0xE0, 0x20, readRAM ? bankEF : nullptr, lcWrite_ ? bankEF : nullptr);
+}
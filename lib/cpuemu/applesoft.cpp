@@ -7,6 +7,8 @@
 
 #include "apple2tc/apple2.h"
 
+#include <map>
+
 void dumpApplesoftBasic(FILE *f, const EmuApple2 *emu) {
   uint16_t start = emu->ram_peek16(EmuApple2::TXTTAB);
   uint16_t end = emu->ram_peek16(EmuApple2::PRGEND);
@@ -16,3 +18,233 @@ void dumpApplesoftBasic(FILE *f, const EmuApple2 *emu) {
     fprintf(f, " $%02X", emu->ram_peek(addr));
   fprintf(f, "\n");
 }
+
+/// Applesoft keywords in token order, starting from $80. This is the table at
+/// $D0D0 in the ROM.
+static const char *const s_keywords[] = {
+    "END",    "FOR",    "NEXT",   "DATA",   "INPUT",  "DEL",     "DIM",   "READ",   "GR",
+    "TEXT",   "PR#",    "IN#",    "CALL",   "PLOT",   "HLIN",    "VLIN",  "HGR2",   "HGR",
+    "HCOLOR=", "HPLOT", "DRAW",   "XDRAW",  "HTAB",   "HOME",    "ROT=",  "SCALE=", "SHLOAD",
+    "TRACE",  "NOTRACE", "NORMAL", "INVERSE", "FLASH", "COLOR=", "POP",   "VTAB",   "HIMEM:",
+    "LOMEM:", "ONERR",  "RESUME", "RECALL", "STORE",  "SPEED=",  "LET",   "GOTO",   "RUN",
+    "IF",     "RESTORE", "&",     "GOSUB",  "RETURN", "REM",     "STOP",  "ON",     "WAIT",
+    "LOAD",   "SAVE",   "DEF",    "POKE",   "PRINT",  "CONT",    "LIST",  "CLEAR",  "GET",
+    "NEW",    "TAB(",   "TO",     "FN",     "SPC(",   "THEN",    "AT",    "NOT",    "STEP",
+    "+",      "-",      "*",      "/",      "^",      "AND",     "OR",    ">",      "=",
+    "<",      "SGN",    "INT",    "ABS",    "USR",    "FRE",     "SCRN(", "PDL",    "POS",
+    "SQR",    "RND",    "LOG",    "EXP",    "COS",    "SIN",     "TAN",   "ATN",    "PEEK",
+    "LEN",    "STR$",   "VAL",    "ASC",    "CHR$",   "LEFT$",   "RIGHT$", "MID$",
+};
+
+static constexpr unsigned NUM_KEYWORDS = sizeof(s_keywords) / sizeof(s_keywords[0]);
+static constexpr uint8_t TOKEN_DATA = 0x83;
+static constexpr uint8_t TOKEN_REM = 0xB2;
+static constexpr uint8_t TOKEN_PRINT = 0xBA;
+static constexpr uint8_t TOKEN_AT = 0xC5;
+/// The highest line number accepted by Applesoft.
+static constexpr unsigned MAX_LINE_NUMBER = 63999;
+
+/// Match a keyword at \p p, ignoring blanks, like the ROM does. Return the end
+/// of the match or nullptr.
+static const char *matchKeyword(const char *p, const char *end, const char *keyword) {
+  for (; *keyword; ++keyword, ++p) {
+    while (p != end && *p == ' ')
+      ++p;
+    if (p == end || *p != *keyword)
+      return nullptr;
+  }
+  return p;
+}
+
+/// Tokenize the text of one line after the line number, replicating PARSE at
+/// $D56C, and append the result to \p out, without the terminating zero.
+static void tokenizeLine(const char *p, const char *end, std::vector<uint8_t> &out) {
+  bool inData = false;
+  while (p != end) {
+    char ch = *p;
+    if (ch == ' ' && !inData) {
+      ++p;
+      continue;
+    }
+    if (ch == '"') {
+      // Strings are copied verbatim up to the closing quote.
+      out.push_back(*p++);
+      while (p != end && *p != '"')
+        out.push_back(*p++);
+      if (p != end)
+        out.push_back(*p++);
+      continue;
+    }
+
+    uint8_t token = 0;
+    if (inData || (ch >= '0' && ch <= ';')) {
+      // Digits and punctuation are never tokenized.
+    } else if (ch == '?') {
+      token = TOKEN_PRINT;
+      ++p;
+    } else {
+      for (unsigned i = 0; i != NUM_KEYWORDS; ++i) {
+        const char *e = matchKeyword(p, end, s_keywords[i]);
+        if (!e)
+          continue;
+        // "AT" followed by "N" or "O" is "ATN" or "A TO".
+        if (0x80 + i == TOKEN_AT && e != end && (*e == 'N' || *e == 'O'))
+          continue;
+        token = 0x80 + i;
+        p = e;
+        break;
+      }
+    }
+
+    if (!token) {
+      out.push_back(*p++);
+      if (ch == ':')
+        inData = false;
+      continue;
+    }
+    out.push_back(token);
+    if (token == TOKEN_DATA) {
+      inData = true;
+    } else if (token == TOKEN_REM) {
+      out.insert(out.end(), p, end);
+      return;
+    }
+  }
+}
+
+bool tokenizeApplesoft(
+    const char *text,
+    size_t len,
+    uint16_t start,
+    std::vector<uint8_t> &prog,
+    std::string &error) {
+  // Lines are kept sorted by number, like when they are typed.
+  std::map<unsigned, std::vector<uint8_t>> lines{};
+  unsigned lineIndex = 0;
+  for (const char *end = text + len; text != end;) {
+    const char *eol = text;
+    while (eol != end && *eol != '\n' && *eol != '\r')
+      ++eol;
+    const char *next = eol != end ? eol + 1 : eol;
+    if (eol != end && *eol == '\r' && next != end && *next == '\n')
+      ++next;
+    ++lineIndex;
+
+    const char *p = text;
+    text = next;
+    while (p != eol && *p == ' ')
+      ++p;
+    if (p == eol)
+      continue;
+    if (*p < '0' || *p > '9') {
+      error = "line " + std::to_string(lineIndex) + ": missing line number";
+      return false;
+    }
+    // Blanks within the line number are ignored, like in LINGET.
+    unsigned number = 0;
+    for (; p != eol && ((*p >= '0' && *p <= '9') || *p == ' '); ++p) {
+      if (*p == ' ')
+        continue;
+      number = number * 10 + (*p - '0');
+      if (number > MAX_LINE_NUMBER) {
+        error = "line " + std::to_string(lineIndex) + ": line number too large";
+        return false;
+      }
+    }
+
+    std::vector<uint8_t> body{};
+    tokenizeLine(p, eol, body);
+    if (body.empty())
+      lines.erase(number);
+    else
+      lines[number] = std::move(body);
+  }
+
+  prog.clear();
+  for (const auto &[number, body] : lines) {
+    uint16_t link = start + prog.size() + 4 + body.size() + 1;
+    prog.push_back(link);
+    prog.push_back(link >> 8);
+    prog.push_back(number);
+    prog.push_back(number >> 8);
+    prog.insert(prog.end(), body.begin(), body.end());
+    prog.push_back(0);
+    if (start + prog.size() > 0xFFFE) {
+      error = "program too large";
+      return false;
+    }
+  }
+  // The end of the program is marked by a zero link.
+  prog.push_back(0);
+  prog.push_back(0);
+  return true;
+}
+
+std::string detokenizeApplesoft(const uint8_t *prog, size_t len) {
+  std::string res{};
+  for (size_t pos = 0; pos + 4 <= len && (prog[pos] | prog[pos + 1]);) {
+    res += std::to_string(prog[pos + 2] | (prog[pos + 3] << 8));
+    res += ' ';
+    pos += 4;
+    // Like LIST, surround keywords with blanks, which are ignored by the
+    // tokenizer, except where they would become part of the REM or DATA text.
+    for (; pos != len && prog[pos]; ++pos) {
+      uint8_t b = prog[pos];
+      if (b < 0x80) {
+        res += (char)b;
+      } else if (b - 0x80u < NUM_KEYWORDS) {
+        if (!res.empty() && res.back() != ' ')
+          res += ' ';
+        res += s_keywords[b - 0x80];
+        if (b != TOKEN_REM && b != TOKEN_DATA)
+          res += ' ';
+      } else {
+        char buf[8];
+        snprintf(buf, sizeof(buf), "{$%02X}", b);
+        res += buf;
+      }
+    }
+    res += '\n';
+    ++pos;
+  }
+  return res;
+}
+
+bool loadApplesoftProgram(EmuApple2 *emu, const char *text, size_t len, std::string &error) {
+  uint16_t start = emu->ram_peek16(EmuApple2::TXTTAB);
+  uint16_t memSize = emu->ram_peek16(EmuApple2::MEMSIZE);
+  if (!start || start >= memSize) {
+    error = "Applesoft has not been initialized";
+    return false;
+  }
+  std::vector<uint8_t> prog{};
+  if (!tokenizeApplesoft(text, len, start, prog, error))
+    return false;
+  if (start + prog.size() >= memSize) {
+    error = "out of memory";
+    return false;
+  }
+
+  memcpy(emu->getMainRAMWritable() + start, prog.data(), prog.size());
+  // The program starts in text page 2, whose writes are tracked.
+  a2_io_vid_invalidate(emu->io());
+  // Point the variables right after the program and clear them, like NEW does.
+  uint16_t end = start + prog.size();
+  for (uint16_t ptr :
+       {EmuApple2::VARTAB, EmuApple2::ARYTAB, EmuApple2::STREND, EmuApple2::PRGEND}) {
+    emu->ram_poke(ptr, (uint8_t)end);
+    emu->ram_poke(ptr + 1, end >> 8);
+  }
+  emu->ram_poke(EmuApple2::FRETOP, (uint8_t)memSize);
+  emu->ram_poke(EmuApple2::FRETOP + 1, memSize >> 8);
+  return true;
+}
+
+void runApplesoftProgram(EmuApple2 *emu) {
+  // RUN clears the variables and the stack before executing the first line,
+  // so it can be entered from anywhere.
+  auto r = emu->getRegs();
+  r.pc = EmuApple2::APPLESOFT_RUN;
+  r.status = Emu6502::STATUS_IGNORED;
+  emu->setRegs(r);
+}
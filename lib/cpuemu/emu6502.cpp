@@ -7,6 +7,9 @@
 
 #include "apple2tc/emu6502.h"
 
+#include "apple2tc/SaveAndRestore.h"
+
+#include <algorithm>
 #include <cassert>
 #include <cstdarg>
 #include <cstdio>
@@ -37,6 +40,7 @@ static void fatal(const char *msg, ...) {
 Emu6502::Emu6502(unsigned int ioRangeStart, unsigned int ioRangeEnd)
     : ioRangeStart_(ioRangeStart), ioRangeEnd_(ioRangeEnd) {
   memset(ram_, 0xFF, 0x10000);
+  updatePageTables();
 }
 
 void Emu6502::loadROM(const uint8_t *rom, unsigned int size) {
@@ -44,9 +48,57 @@ void Emu6502::loadROM(const uint8_t *rom, unsigned int size) {
   release_assert(romStart_ == 0x10000, "ROM already loaded");
   romStart_ = 0x10000 - size;
   memcpy(ram_ + romStart_, rom, size);
+  updatePageTables();
   reset();
 }
 
+void Emu6502::addWriteWatch(uint8_t fromPage, uint8_t toPage) {
+  for (unsigned page = fromPage; page <= toPage; ++page)
+    watchedPages_[page] = true;
+  updatePageTables();
+}
+
+void Emu6502::mapPages(uint8_t fromPage, unsigned numPages, const uint8_t *read, uint8_t *write) {
+  release_assert(fromPage + numPages <= 256, "Mapped pages out of range");
+  for (unsigned i = 0; i != numPages; ++i) {
+    readMap_[fromPage + i] = read ? read + i * 256 : nullptr;
+    writeMap_[fromPage + i] = write ? write + i * 256 : nullptr;
+  }
+  updatePageTables();
+}
+
+void Emu6502::updatePageTables() {
+  for (unsigned page = 0; page != 256; ++page) {
+    unsigned start = page << 8;
+    unsigned end = start + 0xFF;
+    bool io = start <= ioRangeEnd_ && end >= ioRangeStart_;
+
+    if (readMap_[page])
+      readPages_[page] = readMap_[page];
+    else
+      readPages_[page] = io ? nullptr : ram_ + start;
+
+    if (writeMap_[page])
+      writePages_[page] = writeMap_[page];
+    else if (io || end >= romStart_ || watchedPages_[page])
+      writePages_[page] = nullptr;
+    else
+      writePages_[page] = ram_ + start;
+
+    activeTrapPages_[page] = readMap_[page] ? nullptr : trapPages_[page];
+  }
+}
+
+void Emu6502::pokeSlow(uint16_t addr, uint8_t value) {
+  if (addr >= ioRangeStart_ && addr <= ioRangeEnd_) {
+    ioPoke(addr, value);
+  } else if (addr < romStart_) {
+    ram_[addr] = value;
+    if (watchedPages_[addr >> 8])
+      watchedWrite(addr);
+  }
+}
+
 void Emu6502::reset() {
   a_ = 0;
   x_ = 0;
@@ -109,13 +161,46 @@ Emu6502::StopReason Emu6502::runFor(unsigned runCycles) {
 #define BR_ABS(x) (pc_ = (x))
 #define BR_REL(x) (pc_ += (x))
 
-  for (unsigned startCycles = cycles_; cycles_ - startCycles < runCycles; cycles_ += 3) {
+  // Cycles executed past the end of the previous runs, for example by a long
+  // trap, are taken out of this one, so the emulated clock doesn't run ahead
+  // of the time that the caller measures.
+  unsigned debt = std::min(runDebt_, runCycles);
+  runDebt_ -= debt;
+  runCycles -= debt;
+  unsigned budgetEnd = cycles_ + runCycles;
+
+  // Stopping at the event cycle only shortens the run, so there is nothing to
+  // check per instruction.
+  StopReason reason = StopReason::CyclesExpired;
+  if (eventPending_) {
+    int toEvent = std::max((int)(eventCycle_ - cycles_), 0);
+    if ((unsigned)toEvent < runCycles) {
+      runCycles = toEvent;
+      reason = StopReason::EventCycle;
+    }
+  }
+
+  runEnd_ = cycles_ + runCycles;
+  unsigned startCycles = cycles_;
+  for (; cycles_ - startCycles < runCycles; cycles_ += 3) {
     if (debug_ & DebugASM) {
-      if (debugStateCB_ && debugStateCB_(debugStateCBCtx_, this, pc_) == StopReason::StopRequesed)
-        return StopReason::StopRequesed;
+      if (debugStateCB_ &&
+          debugStateCB_(debugStateCBCtx_, this, pc_) == StopReason::StopRequesed) {
+        reason = StopReason::StopRequesed;
+        break;
+      }
+    }
+
+    if (TrapFn *page = activeTrapPages_[pc_ >> 8]) {
+      if (TrapFn fn = page[pc_ & 0xFF]; fn && runTrap(fn))
+        continue;
+    }
+    if (hybrid_ && pc_ >= romStart_ && !readMap_[pc_ >> 8] &&
+        !(hybridMisses_[pc_ >> 3] & (1 << (pc_ & 7))) && !(debug_ & DebugASM) && runHybrid()) {
+      continue;
     }
 
-    switch (ram_[pc_]) {
+    switch (peek(pc_)) {
     case 0x69: { // ADC #imm
       uint8_t m = OP8();
       if (!(status_ & STATUS_D))
@@ -906,7 +991,7 @@ Emu6502::StopReason Emu6502::runFor(unsigned runCycles) {
       break;
 
     default:
-      fprintf(stderr, "Invalid instruction $%02X\n", ram_[pc_]);
+      fprintf(stderr, "Invalid instruction $%02X\n", peek(pc_));
       // TODO: we might want to decode the invalid instructions the way the
       //       CPU would. Only if we find that it makes a difference.
       pc_ += 1;
@@ -914,13 +999,167 @@ Emu6502::StopReason Emu6502::runFor(unsigned runCycles) {
     }
   }
 
-  return StopReason::CyclesExpired;
+  if ((int)(cycles_ - budgetEnd) > 0)
+    runDebt_ += cycles_ - budgetEnd;
+  // The cycles of a verified trap are counted by the run which executes it.
+  if (!inTrapVerify_) {
+    a2_metric_add(metricCycles_, cycles_ - startCycles);
+    a2_metric_add(metricRuns_, 1);
+  }
+  return reason;
 
 #undef BR_ABS
 #undef OP16
 #undef OP8
 }
 
+void Emu6502::setTrap(uint16_t addr, TrapFn fn) {
+  TrapFn *&page = trapPages_[addr >> 8];
+  if (!page) {
+    trapStorage_.push_back(std::make_unique<TrapFn[]>(256));
+    page = trapStorage_.back().get();
+    updatePageTables();
+  }
+  page[addr & 0xFF] = fn;
+}
+
+void Emu6502::clearTraps() {
+  std::fill(std::begin(trapPages_), std::end(trapPages_), nullptr);
+  trapStorage_.clear();
+  updatePageTables();
+}
+
+bool Emu6502::runTrap(TrapFn fn) {
+  if (inTrapVerify_)
+    return false;
+  if (trapVerify_)
+    return runTrapVerified(fn);
+  unsigned count = fn(this);
+  if (!count)
+    return false;
+  cycles_ += (count - 1) * 3;
+  return true;
+}
+
+bool Emu6502::runTrapVerified(TrapFn fn) {
+  // A generous limit on the emulated instructions, in case the code never
+  // returns.
+  static constexpr unsigned MAX_INSTRUCTIONS = 10000000;
+
+  Regs entry = getRegs();
+  std::vector<uint8_t> entryRAM(ram_, ram_ + 0x10000);
+  unsigned count = fn(this);
+  if (!count)
+    return false;
+  Regs native = getRegs();
+  std::vector<uint8_t> nativeRAM(ram_, ram_ + 0x10000);
+
+  // Emulate the code from the same state one instruction at a time, until it
+  // returns to the caller, or executes as many instructions as the trap, which
+  // may stop early.
+  memcpy(ram_, entryRAM.data(), 0x10000);
+  setRegs(entry);
+  uint8_t retSP = entry.sp + 2;
+  uint16_t retPC =
+      ram_[STACK_PAGE_ADDR + (uint8_t)(entry.sp + 1)] + (ram_[STACK_PAGE_ADDR + retSP] << 8) + 1;
+  unsigned emulated = 0;
+  {
+    SaveAndRestore<bool> saveVerify(inTrapVerify_, true);
+    SaveAndRestore<uint8_t> saveDebug(debug_, 0);
+    SaveAndRestore<bool> saveEvent(eventPending_, false);
+    SaveAndRestore<unsigned> saveRunEnd(runEnd_);
+    SaveAndRestore<unsigned> saveRunDebt(runDebt_);
+    do {
+      // Every step runs exactly one instruction, whatever the previous one overran.
+      runDebt_ = 0;
+      runFor(1);
+      ++emulated;
+    } while (!(pc_ == retPC && sp_ == retSP) && emulated != count &&
+             emulated != MAX_INSTRUCTIONS);
+  }
+
+  Regs r = getRegs();
+  const uint8_t *diff = std::mismatch(ram_, ram_ + 0x10000, nativeRAM.data()).first;
+  if (count != emulated || r.pc != native.pc || r.a != native.a || r.x != native.x ||
+      r.y != native.y || r.status != native.status || r.sp != native.sp ||
+      diff != ram_ + 0x10000) {
+    ++trapMismatches_;
+    fprintf(
+        stderr,
+        "Trap $%04X mismatch: emulated %u insts A=%02X X=%02X Y=%02X P=%02X S=%02X, "
+        "native %u insts A=%02X X=%02X Y=%02X P=%02X S=%02X",
+        entry.pc,
+        emulated,
+        r.a,
+        r.x,
+        r.y,
+        r.status,
+        r.sp,
+        count,
+        native.a,
+        native.x,
+        native.y,
+        native.status,
+        native.sp);
+    if (diff != ram_ + 0x10000) {
+      unsigned addr = diff - ram_;
+      fprintf(stderr, ", [$%04X] %02X vs %02X", addr, ram_[addr], nativeRAM[addr]);
+    }
+    fprintf(stderr, "\n");
+  }
+  // runFor() has already counted all cycles, and the loop will add one more
+  // instruction.
+  cycles_ -= 3;
+  return true;
+}
+
+void Emu6502::setHybridModule(const a2_hybrid_module_t *module) {
+  hybrid_ = module;
+  memset(hybridMisses_, 0, sizeof(hybridMisses_));
+}
+
+bool Emu6502::runHybrid() {
+  a2_hybrid_ctx_t ctx{};
+  ctx.pc = pc_;
+  ctx.a = a_;
+  ctx.x = x_;
+  ctx.y = y_;
+  ctx.status = status_;
+  ctx.sp = sp_;
+  ctx.cycles = cycles_;
+  ctx.remaining_cycles = (int)(runEnd_ - cycles_);
+  ctx.native_start = romStart_;
+  ctx.ram = ram_;
+  ctx.write_pages = writePages_;
+  ctx.io_peek = hybridIOPeek;
+  ctx.poke_slow = hybridPokeSlow;
+  ctx.host = this;
+
+  unsigned startCycles = cycles_;
+  hybrid_->run(&ctx);
+  // Every block adds cycles, so if there are none, the module didn't run.
+  if (ctx.cycles == startCycles) {
+    hybridMisses_[pc_ >> 3] |= 1 << (pc_ & 7);
+    return false;
+  }
+  setRegs({ctx.pc, ctx.a, ctx.x, ctx.y, ctx.status, ctx.sp});
+  // The loop will add one more instruction.
+  cycles_ = ctx.cycles - 3;
+  return true;
+}
+
+uint8_t Emu6502::hybridIOPeek(a2_hybrid_ctx_t *ctx, uint16_t addr) {
+  auto *self = (Emu6502 *)ctx->host;
+  self->cycles_ = ctx->cycles;
+  return self->peek(addr);
+}
+
+void Emu6502::hybridPokeSlow(a2_hybrid_ctx_t *ctx, uint16_t addr, uint8_t value) {
+  auto *self = (Emu6502 *)ctx->host;
+  self->cycles_ = ctx->cycles;
+  self->pokeSlow(addr, value);
+}
+
 uint8_t Emu6502::ioPeek(uint16_t addr) {
   return 0;
 }
@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) Tzvetan Mikov.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "apple2tc/apple2.h"
+#include "apple2tc/support.h"
+
+#if !defined(__EMSCRIPTEN__) && !defined(_WIN32)
+#include <dlfcn.h>
+#define HAVE_DLOPEN
+#endif
+
+bool EmuApple2::loadHybrid(const char *path, std::string &error) {
+#ifdef HAVE_DLOPEN
+  void *lib = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+  if (!lib) {
+    error = dlerror();
+    return false;
+  }
+  auto entry = (a2_hybrid_entry_t)dlsym(lib, A2_HYBRID_ENTRY);
+  const a2_hybrid_module_t *module = entry ? entry() : nullptr;
+  if (!module || module->version != A2_HYBRID_VERSION) {
+    error = format("%s: not a hybrid module of version %u", path, A2_HYBRID_VERSION);
+    dlclose(lib);
+    return false;
+  }
+
+  setHybridModule(module);
+  unloadHybrid();
+  hybridLib_ = lib;
+  return true;
+#else
+  error = "hybrid modules are not supported on this platform";
+  return false;
+#endif
+}
+
+void EmuApple2::unloadHybrid() {
+#ifdef HAVE_DLOPEN
+  if (hybridLib_)
+    dlclose(hybridLib_);
+#endif
+  hybridLib_ = nullptr;
+}
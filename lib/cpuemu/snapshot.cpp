@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) Tzvetan Mikov.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "apple2tc/a2hash.h"
+#include "apple2tc/apple2.h"
+#include "apple2tc/support.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <random>
+
+/// Snapshot format (all integers are little endian):
+///   char magic[8]      "A2SNAP\x1A\x02"
+///   u64 rom_hash       a2_hash_bytes() of the ROM.
+///   u16 pc
+///   u8 a, x, y, status, sp
+///   u32 cycles
+///   u8 last_key, vid_control
+///   u8 lc_state        Language card: bits 0-3 the last switch, bit 4 write
+///                      enabled, bit 5 one read towards write enable.
+///   u8 lc_ram[0x4000]
+///   u32 ram_len        Equal to the start of the ROM.
+///   u8 ram[ram_len]
+static const char SNAPSHOT_MAGIC[8] = {'A', '2', 'S', 'N', 'A', 'P', '\x1A', '\x02'};
+static constexpr size_t SNAPSHOT_HEADER_SIZE = 8 + 8 + 7 + 4 + 2 + 1 + 0x4000 + 4;
+
+/// The cold start takes about a second. If the restart hasn't been reached
+/// after this many cycles, something is wrong with the ROM.
+static constexpr unsigned MAX_BOOT_CYCLES = 20 * Emu6502::CLOCK_FREQ;
+
+static uint64_t hashROM(const Emu6502 *emu) {
+  unsigned romStart = emu->getROMStart();
+  return a2_hash_bytes(emu->getMainRAM() + romStart, 0x10000 - romStart, 0);
+}
+
+static void put(std::vector<uint8_t> &buf, uint64_t v, unsigned size) {
+  for (unsigned i = 0; i != size; ++i, v >>= 8)
+    buf.push_back((uint8_t)v);
+}
+
+static uint64_t get(const uint8_t *&p, unsigned size) {
+  uint64_t v = 0;
+  for (unsigned i = 0; i != size; ++i)
+    v |= (uint64_t)*p++ << (i * 8);
+  return v;
+}
+
+std::vector<uint8_t> EmuApple2::saveSnapshot() const {
+  unsigned ramLen = getROMStart();
+  std::vector<uint8_t> buf;
+  buf.reserve(SNAPSHOT_HEADER_SIZE + ramLen);
+  buf.insert(buf.end(), SNAPSHOT_MAGIC, SNAPSHOT_MAGIC + sizeof(SNAPSHOT_MAGIC));
+  put(buf, hashROM(this), 8);
+  Regs r = getRegs();
+  put(buf, r.pc, 2);
+  put(buf, r.a, 1);
+  put(buf, r.x, 1);
+  put(buf, r.y, 1);
+  put(buf, r.status, 1);
+  put(buf, r.sp, 1);
+  put(buf, getCycles(), 4);
+  put(buf, io_.last_key, 1);
+  put(buf, io_.vid_control, 1);
+  put(buf, lcSwitch_ | (lcWrite_ ? 0x10 : 0) | (lcPrewrite_ ? 0x20 : 0), 1);
+  buf.insert(buf.end(), lcRAM_, lcRAM_ + sizeof(lcRAM_));
+  put(buf, ramLen, 4);
+  buf.insert(buf.end(), getMainRAM(), getMainRAM() + ramLen);
+  return buf;
+}
+
+bool EmuApple2::restoreSnapshot(const uint8_t *data, size_t len) {
+  if (len < SNAPSHOT_HEADER_SIZE || memcmp(data, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0)
+    return false;
+  const uint8_t *p = data + sizeof(SNAPSHOT_MAGIC);
+  if (get(p, 8) != hashROM(this))
+    return false;
+  Regs r;
+  r.pc = (uint16_t)get(p, 2);
+  r.a = (uint8_t)get(p, 1);
+  r.x = (uint8_t)get(p, 1);
+  r.y = (uint8_t)get(p, 1);
+  r.status = (uint8_t)get(p, 1);
+  r.sp = (uint8_t)get(p, 1);
+  auto cycles = (unsigned)get(p, 4);
+  auto lastKey = (uint8_t)get(p, 1);
+  auto vidControl = (uint8_t)get(p, 1);
+  auto lcState = (uint8_t)get(p, 1);
+  const uint8_t *lcRAM = p;
+  p += sizeof(lcRAM_);
+  auto ramLen = (unsigned)get(p, 4);
+  if (ramLen != getROMStart() || len - SNAPSHOT_HEADER_SIZE != ramLen)
+    return false;
+
+  setRegs(r);
+  setCycles(cycles);
+  io_.last_key = lastKey;
+  io_.vid_control = vidControl;
+  lcSwitch_ = lcState & 0xF;
+  lcWrite_ = lcState & 0x10;
+  lcPrewrite_ = lcState & 0x20;
+  memcpy(lcRAM_, lcRAM, sizeof(lcRAM_));
+  updateLanguageCard();
+  memcpy(getMainRAMWritable(), p, ramLen);
+  a2_io_vid_invalidate(&io_);
+  return true;
+}
+
+/// Run the ROM cold start in a separate machine, so no callbacks are invoked,
+/// and return its state at the restart, or an empty vector on failure.
+static std::vector<uint8_t> coldBootSnapshot(const EmuApple2 *emu) {
+  auto boot = std::make_unique<EmuApple2>();
+  unsigned romStart = emu->getROMStart();
+  boot->loadROM(emu->getMainRAM() + romStart, 0x10000 - romStart);
+  boot->setDebugStateCB(nullptr, [](void *, Emu6502 *, uint16_t pc) {
+    return pc == EmuApple2::APPLESOFT_RESTART ? Emu6502::StopReason::StopRequesed
+                                              : Emu6502::StopReason::None;
+  });
+  boot->addDebugFlags(Emu6502::DebugASM);
+  while (boot->getCycles() < MAX_BOOT_CYCLES) {
+    if (boot->runFor(Emu6502::CLOCK_FREQ / 10) == Emu6502::StopReason::StopRequesed)
+      return boot->saveSnapshot();
+  }
+  return {};
+}
+
+/// Return the path of the cached snapshot of the ROM with the specified hash,
+/// or an empty string if there is no cache directory.
+static std::string cachePath(uint64_t romHash) {
+#ifdef __EMSCRIPTEN__
+  return {};
+#else
+  std::string dir;
+  if (const char *xdg = getenv("XDG_CACHE_HOME"); xdg && *xdg)
+    dir = std::string(xdg) + "/apple2tc";
+  else if (const char *home = getenv("HOME"); home && *home)
+    dir = std::string(home) + "/.cache/apple2tc";
+  else
+    return {};
+  return format("%s/boot-%016llx.a2snap", dir.c_str(), (unsigned long long)romHash);
+#endif
+}
+
+/// Write the snapshot into the cache. Concurrent jobs may be doing the same,
+/// so the file is written under a unique name and renamed into place. Errors
+/// are ignored, since the cache is only an optimization.
+static void writeCache(const std::string &path, const std::vector<uint8_t> &snap) {
+  namespace fs = std::filesystem;
+  std::error_code ec;
+  fs::create_directories(fs::path(path).parent_path(), ec);
+  if (ec)
+    return;
+
+  std::string tmp = format("%s.%08x.tmp", path.c_str(), (unsigned)std::random_device{}());
+  FILE *f = fopen(tmp.c_str(), "wb");
+  if (!f)
+    return;
+  bool ok = fwrite(snap.data(), 1, snap.size(), f) == snap.size();
+  if (fclose(f) != 0)
+    ok = false;
+  if (ok)
+    fs::rename(tmp, path, ec);
+  if (!ok || ec)
+    fs::remove(tmp, ec);
+}
+
+bool EmuApple2::fastBoot() {
+  std::string path = cachePath(hashROM(this));
+  if (!path.empty()) {
+    if (FILE *f = fopen(path.c_str(), "rb")) {
+      auto snap = readAll<std::vector<uint8_t>>(f);
+      fclose(f);
+      if (restoreSnapshot(snap.data(), snap.size()))
+        return true;
+    }
+  }
+
+  auto snap = coldBootSnapshot(this);
+  if (snap.empty())
+    return false;
+  if (!path.empty())
+    writeCache(path, snap);
+  return restoreSnapshot(snap.data(), snap.size());
+}
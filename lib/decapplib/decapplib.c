@@ -5,7 +5,12 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include "apple2tc/a2capture.h"
+#include "apple2tc/a2hash.h"
 #include "apple2tc/a2io.h"
+#include "apple2tc/a2metrics.h"
+#include "apple2tc/a2tribuf.h"
+#include "apple2tc/a2wav.h"
 #include "apple2tc/apple2iodefs.h"
 #include "apple2tc/sokol/sokol_app.h"
 #include "apple2tc/sokol/sokol_audio.h"
@@ -15,6 +20,7 @@
 #include "apple2tc/system.h"
 
 #include "apple2tc/sokol/blit.h"
+#include "c11threads/c11threads.h"
 
 #include <ctype.h>
 #include <limits.h>
@@ -27,10 +33,35 @@ typedef struct KeyPress {
 } KeyPress;
 
 static bool sound_enabled_ = true;
+/// Target audio latency in milliseconds.
+static unsigned audio_latency_ = A2_SOUND_DEFAULT_LATENCY_MS;
 /// If set, a file to read keyboard input from.
 static FILE *kbd_file_ = NULL;
+/// Run as fast as possible while pasting the KBD file.
+static bool paste_warp_ = false;
+/// Run as fast as possible while reading the KBD file or replaying key presses.
+static bool auto_warp_ = false;
+/// Set by interactive key presses, which return the emulation to normal speed
+/// until the reason for warping is gone.
+static bool warp_suspended_ = false;
+/// Wall time in milliseconds spent emulating per frame while warping. It is
+/// longer than a frame, so the video is published about 20 times a second,
+/// and the rest of the time goes to the emulation.
+#define WARP_MS 50
 /// Assumed clock frequency. Can be used for "overclocking".
 static unsigned clock_freq_ = A2_CLOCK_FREQ;
+/// How to display graphics modes.
+static a2_render_mode_t render_mode_ = A2_RENDER_COLOR;
+/// If set, the screen is captured here.
+static const char *capture_path_ = NULL;
+static a2_capture_t *capture_ = NULL;
+/// Per-frame video hashes are logged here, if `hash_log_.f` is set.
+static a2_hash_log_t hash_log_;
+/// If set, the speaker is recorded here.
+static const char *wav_path_ = NULL;
+/// Sample rate of the recording.
+static unsigned wav_rate_ = 44100;
+static a2_wav_sink_t *wav_ = NULL;
 /// If true, dump key presses with cycle stamps.
 static bool trace_keys_ = false;
 /// Key-presses loaded from disk.
@@ -40,13 +71,30 @@ static unsigned key_press_count_ = 0;
 /// Next key press to process.
 static unsigned next_key_press_ = 0;
 
+#ifndef __EMSCRIPTEN__
+/// Run the emulation in its own thread.
+static bool emu_thread_enabled_ = true;
+#else
+static bool emu_thread_enabled_ = false;
+#endif
+static bool emu_thread_running_ = false;
+static thrd_t emu_thread_;
+/// Set by the render thread to stop the emulation thread.
+static atomic_bool emu_quit_;
+/// Key presses sent from the render thread to the emulation.
+static a2_spsc_t input_;
+/// Video frames published by the emulation for rendering.
+static a2_video_tribuf_t tribuf_;
+
 static sg_bindings bind_;
 static sg_pipeline pip_;
 
-/// stm_now() at the start of every frame.
+/// stm_now() at the start of every rendered frame.
 static uint64_t curFrameTick_ = 0;
-static uint64_t lastRunTick_ = 0;
+/// stm_now() at startup.
 static uint64_t firstFrameTick_ = 0;
+/// Accessed only by the emulation.
+static uint64_t lastRunTick_ = 0;
 static bool firstFrame_ = true;
 
 /// KBD handling.
@@ -57,8 +105,41 @@ static bool firstFrame_ = true;
 static int ignoreNextCh_ = -1;
 
 static a2_sound_t sound_;
+/// The emulated I/O state. Accessed only by the emulation.
 static a2_iostate_t io_;
+/// Video mode and dirty rows accumulated from the consumed video frames.
+static a2_iostate_t video_io_;
+/// RAM of the last consumed video frame.
+static const uint8_t *video_ram_ = NULL;
+/// The indexed screen produced by the renderer.
+static a2_screen8 screen8_;
+/// The RGB screen uploaded to the texture.
 static a2_screen screen_;
+static a2_renderer_t renderer_;
+
+/// Draw the metrics over the screen.
+static bool metrics_overlay_ = false;
+static a2_overlay_t overlay_;
+/// If set, the metrics are dumped here every `metrics_interval_` ms.
+static const char *metrics_path_ = NULL;
+static unsigned metrics_interval_ = 1000;
+static a2_metrics_dump_t *metrics_dump_ = NULL;
+/// Emulated cycles.
+static a2_metric_t metric_cycles_;
+/// Cycles of real time requested by simulate_frame() and the cycles it ran,
+/// which differ when it falls behind or warps, and the time spent in it.
+static a2_metric_t metric_requested_;
+static a2_metric_t metric_run_;
+static a2_metric_t metric_sim_;
+/// The time between rendered frames and the time spent uploading the screen.
+static a2_metric_t metric_interval_;
+static a2_metric_t metric_upload_;
+/// a2_metrics_start() at the start of the previous frame.
+static uint64_t last_frame_start_ = 0;
+
+void video_ram_written(uint16_t addr) {
+  a2_io_vid_write(&io_, addr);
+}
 
 uint8_t io_peek(uint16_t addr) {
   return a2_io_peek(&io_, addr, get_cycles());
@@ -168,11 +249,14 @@ static void init_window(void) {
   sg_setup(&desc);
 
   sg_image_desc idesc = {
-      .width = A2_SCREEN_W_POT,
-      .height = A2_SCREEN_H_POT,
+      .width = A2_SCREEN_W,
+      .height = A2_SCREEN_H,
       .usage = SG_USAGE_STREAM,
       .min_filter = SG_FILTER_LINEAR,
       .mag_filter = SG_FILTER_LINEAR,
+      // Required for non-power-of-two textures in GLES2.
+      .wrap_u = SG_WRAP_CLAMP_TO_EDGE,
+      .wrap_v = SG_WRAP_CLAMP_TO_EDGE,
       .label = "a2_image",
   };
   bind_.fs_images[SLOT_tex] = sg_make_image(&idesc);
@@ -183,13 +267,11 @@ static void init_window(void) {
    * ------+------
    *    3  |  1
    */
-  static const float U = (float)A2_SCREEN_W / A2_SCREEN_W_POT;
-  static const float V = (float)A2_SCREEN_H / A2_SCREEN_H_POT;
   static const float vertices[][4] = {
-      {1, 1, U, 0},
-      {1, -1, U, V},
+      {1, 1, 1, 0},
+      {1, -1, 1, 1},
       {-1, 1, 0, 0},
-      {-1, -1, 0, V},
+      {-1, -1, 0, 1},
   };
   sg_buffer_desc bdesc = {
       .data = SG_RANGE(vertices),
@@ -215,7 +297,9 @@ static void init_window(void) {
 
 /// Callback from a2_io_t, when speaker has been flipped.
 static void speaker_cb(void *ctx, unsigned cycles) {
-  a2_sound_spkr((a2_sound_t *)ctx, A2_CLOCK_FREQ, saudio_sample_rate(), cycles);
+  a2_sound_spkr((a2_sound_t *)ctx, cycles);
+  if (wav_)
+    a2_wav_spkr(wav_, cycles);
 }
 
 /// Callback from saudio to generate new sound samples.
@@ -230,10 +314,23 @@ static void push_key(uint8_t ch) {
 }
 
 static void push_key_if_empty(uint8_t ch) {
-  if (a2_io_keys_count(&io_) == 0)
+  if (a2_io_keys_count(&io_) == 0 && !a2_io_paste_pending(&io_))
     push_key(ch);
 }
 
+/// Paste the whole KBD file, unless key presses are being traced, in which case
+/// it is drained gradually by drain_kbd_file(), so every key is traced.
+static void paste_kbd_file() {
+  if (!kbd_file_ || trace_keys_)
+    return;
+  if (!a2_io_paste_file(&io_, kbd_file_)) {
+    fprintf(stderr, "Error reading the kbd file\n");
+    exit(2);
+  }
+  fclose(kbd_file_);
+  kbd_file_ = NULL;
+}
+
 /// While the KBD file is open, read as many characters from it as possible.
 /// Close the file of EOF is reached.
 static void drain_kbd_file() {
@@ -254,26 +351,31 @@ static void drain_kbd_file() {
   }
 }
 
-/// Return true if there are more keypresses to process.
-static void drain_key_presses() {
+/// Push the recorded keys whose time has come and stop the next run at the
+/// cycle of the following one. Return true if any keys were pushed.
+static bool drain_key_presses() {
   if (!key_presses_)
-    return;
+    return false;
 
-  static unsigned last_cycles = 0;
   unsigned cycles = get_cycles();
+  unsigned start = next_key_press_;
 
   while (next_key_press_ != key_press_count_ && cycles >= key_presses_[next_key_press_].cycles) {
     a2_io_push_key(&io_, key_presses_[next_key_press_].ch);
     ++next_key_press_;
   }
 
-  if (next_key_press_ != key_press_count_)
-    return;
+  if (next_key_press_ != key_press_count_) {
+    set_event_cycle(key_presses_[next_key_press_].cycles);
+    return next_key_press_ != start;
+  }
 
+  clear_event_cycle();
   free(key_presses_);
   key_presses_ = 0;
   next_key_press_ = 0;
   key_press_count_ = 0;
+  return true;
 }
 
 static void load_key_file(const char *path) {
@@ -320,12 +422,42 @@ static void load_key_file(const char *path) {
   fclose(f);
 }
 
+static bool simulate_frame(uint64_t now);
+static void process_input(void);
+static int emulation_thread(void *arg);
+
 static void init_cb(void) {
   init_window();
   stm_setup();
+  firstFrameTick_ = stm_now();
 
-  a2_sound_init(&sound_);
+  if (!a2_sound_init(&sound_)) {
+    fprintf(stderr, "Not enough memory\n");
+    exit(2);
+  }
+  a2_sound_set_latency(&sound_, audio_latency_);
+  if (!a2_spsc_init(&input_, 64, 1)) {
+    fprintf(stderr, "Not enough memory\n");
+    exit(2);
+  }
+  a2_video_tribuf_init(&tribuf_);
   a2_io_init(&io_);
+  a2_renderer_init(&renderer_);
+  renderer_.render_mode = render_mode_;
+  if (capture_path_ && !(capture_ = a2_capture_open(capture_path_)))
+    exit(2);
+  if (wav_path_ && !(wav_ = a2_wav_open(wav_path_, A2_CLOCK_FREQ, wav_rate_)))
+    exit(2);
+  metric_cycles_ = a2_metric_counter("emu.cycles");
+  metric_requested_ = a2_metric_counter("frame.requested_cycles");
+  metric_run_ = a2_metric_counter("frame.cycles");
+  metric_sim_ = a2_metric_histogram_ms("frame.sim_ms");
+  metric_interval_ = a2_metric_histogram_ms("frame.interval_ms");
+  metric_upload_ = a2_metric_histogram_ms("render.upload_ms");
+  if (metrics_path_ && !(metrics_dump_ = a2_metrics_dump_open(metrics_path_, metrics_interval_)))
+    exit(2);
+  if (metrics_overlay_)
+    a2_overlay_init(&overlay_);
   a2_io_set_spkr_cb(&io_, &sound_, speaker_cb);
   io_.debug = 0;
 
@@ -350,82 +482,224 @@ static void init_cb(void) {
   if (kbd_file_ || key_presses_) {
     // The first key pressed before initialization is lost, so just add a dummy keypress.
     a2_io_push_key(&io_, '\r');
-    if (key_presses_)
+    if (key_presses_) {
       drain_key_presses();
-    else
+    } else {
+      paste_kbd_file();
       drain_kbd_file();
+    }
+  }
+
+  if (emu_thread_enabled_) {
+    atomic_init(&emu_quit_, false);
+    if (thrd_create(&emu_thread_, emulation_thread, NULL) != thrd_success) {
+      fprintf(stderr, "Failed to start the emulation thread\n");
+      exit(2);
+    }
+    emu_thread_running_ = true;
   }
 }
 
 static void cleanup_cb(void) {
+  if (emu_thread_running_) {
+    atomic_store_explicit(&emu_quit_, true, memory_order_release);
+    thrd_join(emu_thread_, NULL);
+    emu_thread_running_ = false;
+  }
   shutdown_emulated();
   sg_shutdown();
-  if (sound_enabled_)
+  if (sound_enabled_) {
     saudio_shutdown();
+    a2_sound_stats_t stats = a2_sound_get_stats(&sound_);
+    fprintf(
+        stderr,
+        "Sound: latency %u ms, %u underruns, %u samples dropped, %u toggles lost\n",
+        stats.latency_ms,
+        stats.underruns,
+        stats.dropped,
+        stats.lost);
+  }
+  if (capture_)
+    a2_capture_close(capture_);
+  a2_hash_log_close(&hash_log_);
+  if (wav_) {
+    a2_wav_advance(wav_, get_cycles());
+    if (!a2_wav_close(wav_))
+      fprintf(stderr, "%s: write error\n", wav_path_);
+  }
+  if (metrics_dump_)
+    a2_metrics_dump_close(metrics_dump_);
   a2_io_done(&io_);
   a2_sound_done(&sound_);
+  a2_spsc_free(&input_);
+}
+
+/// Push the keys received from the render thread. Invoked by the emulation.
+static void process_input(void) {
+  // If we are reading from a file, just ensure that the keyboard queue us full,
+  // so key events will have no effect.
+  if (kbd_file_)
+    drain_kbd_file();
+
+  uint8_t ch;
+  while (a2_spsc_pop1(&input_, &ch)) {
+    // Key events are ignored while replaying.
+    if (!key_presses_) {
+      push_key_if_empty(ch);
+      warp_suspended_ = true;
+    }
+  }
+}
+
+/// Run the emulation for the specified number of cycles.
+static void run_cycles(unsigned runCycles) {
+  unsigned startCycles = get_cycles();
+  run_emulated(runCycles);
+  // Recorded keys are delivered at their exact cycle, regardless of how the
+  // run is split into frames.
+  while (drain_key_presses())
+    run_emulated(0);
+  a2_metric_add(metric_cycles_, get_cycles() - startCycles);
+  if (hash_log_.f)
+    a2_hash_log_frame(&hash_log_, &io_, get_ram());
+  a2_sound_submit(&sound_, A2_CLOCK_FREQ, saudio_sample_rate(), get_cycles());
+  if (wav_)
+    a2_wav_advance(wav_, get_cycles());
 }
 
-static void simulate_frame(void) {
+/// Return true if the emulation should run as fast as possible.
+static bool warping(void) {
+  bool wanted = ((paste_warp_ || auto_warp_) && a2_io_paste_pending(&io_)) ||
+      (auto_warp_ && (key_presses_ || kbd_file_));
+  if (!wanted) {
+    warp_suspended_ = false;
+    return false;
+  }
+  return !warp_suspended_;
+}
+
+/// Simulate the time since the last frame. Return true if it warped.
+static bool simulate_frame(uint64_t now) {
+  uint64_t sim_start = a2_metrics_start();
+  bool warped = false;
   if (firstFrame_) {
     firstFrame_ = false;
-    firstFrameTick_ = curFrameTick_;
   } else {
     if (key_presses_)
       drain_key_presses();
     else if (kbd_file_)
       drain_kbd_file();
 
-    unsigned runCycles;
-    if (trace_keys_ || key_presses_ || (g_debug & (DebugASM | DebugMem)) != 0) {
+    const unsigned frameCycles = (unsigned)((1.0 / 60.0) * clock_freq_);
+    unsigned startCycles = get_cycles();
+    if (trace_keys_ || key_presses_ || hash_log_.f || (g_debug & (DebugASM | DebugMem)) != 0) {
       // If we are recording or replaying, we need to have reproducible cycles.
-      runCycles = (unsigned)((1.0 / 60.0) * clock_freq_);
+      run_cycles(frameCycles);
+      a2_metric_add(metric_requested_, frameCycles);
     } else {
-      double elapsed = stm_sec(curFrameTick_ - lastRunTick_);
-      runCycles = (unsigned)((elapsed < 0.200 ? elapsed : 0.200) * clock_freq_);
+      double elapsed = stm_sec(now - lastRunTick_);
+      run_cycles((unsigned)((elapsed < 0.200 ? elapsed : 0.200) * clock_freq_));
+      // The real time is requested, even if the run is capped.
+      a2_metric_add(metric_requested_, (uint64_t)(elapsed * clock_freq_));
+    }
+
+    // While warping, run whole frames for WARP_MS. Only the video of the last
+    // one is displayed.
+    if (warping()) {
+      uint64_t start = stm_now();
+      while (warping() && stm_ms(stm_since(start)) < WARP_MS) {
+        if (kbd_file_)
+          drain_kbd_file();
+        run_cycles(frameCycles);
+      }
+      now = stm_now();
+      warped = true;
     }
-    run_emulated(runCycles);
-    a2_sound_submit(&sound_, A2_CLOCK_FREQ, saudio_sample_rate(), get_cycles());
+    a2_metric_add(metric_run_, get_cycles() - startCycles);
   }
-  lastRunTick_ = curFrameTick_;
+  lastRunTick_ = now;
+  a2_metric_observe_since(metric_sim_, sim_start);
+  return warped;
 }
 
-static void update_screen(void) {
+/// Simulate and publish a frame every 1/60 s until stopped.
+static int emulation_thread(void *arg) {
+  (void)arg;
+  const uint64_t period_ns = 1000000000 / 60;
+  uint64_t start = stm_now();
+  uint64_t next_ns = 0;
+  for (;;) {
+    process_input();
+    if (atomic_load_explicit(&emu_quit_, memory_order_acquire))
+      break;
+    bool warped = simulate_frame(stm_now());
+    a2_video_tribuf_publish(&tribuf_, &io_, get_ram());
+
+    // Keep a steady rate. If we have warped or fallen too far behind, don't
+    // try to catch up.
+    next_ns += period_ns;
+    uint64_t now_ns = (uint64_t)stm_ns(stm_since(start));
+    if (warped || now_ns > next_ns + 200000000) {
+      next_ns = now_ns;
+    } else if (next_ns > now_ns) {
+      uint64_t wait = next_ns - now_ns;
+      struct timespec ts = {
+          .tv_sec = (time_t)(wait / 1000000000),
+          .tv_nsec = (long)(wait % 1000000000),
+      };
+      thrd_sleep(&ts, NULL);
+    }
+  }
+  return 0;
+}
+
+/// Render the latest published video frame. Returns true if anything changed.
+static bool update_screen(void) {
   // Milliseconds since hw reset. Used to determine blink phase.
   uint64_t ms = (uint64_t)stm_ms(stm_diff(curFrameTick_, firstFrameTick_));
-
-  switch (a2_io_get_vidmode(&io_)) {
-  case A2_VIDMODE_TEXT:
-    apple2_render_text_screen(get_ram() + a2_io_get_text_page_offset(&io_), &screen_, ms);
-    break;
-  case A2_VIDMODE_GR:
-    apple2_render_gr_screen(
-        get_ram() + a2_io_get_text_page_offset(&io_), &screen_, ms, a2_io_is_vidmode_mixed(&io_));
-    break;
-  case A2_VIDMODE_HGR:
-  default:;
-    bool mono = false;
-    apple2_render_hgr_screen(
-        get_ram() + a2_io_get_hires_page_offset(&io_),
-        get_ram() + a2_io_get_text_page_offset(&io_),
-        &screen_,
-        ms,
-        a2_io_is_vidmode_mixed(&io_),
-        mono);
-    break;
+  const a2_video_frame_t *vf = a2_video_tribuf_acquire(&tribuf_);
+  if (vf) {
+    a2_video_frame_apply(vf, &video_io_);
+    video_ram_ = vf->ram;
   }
+  if (!video_ram_)
+    return false;
+  a2_rect dirty = a2_render_frame(&renderer_, &video_io_, video_ram_, &screen8_, ms);
+  if (dirty.h == 0)
+    return false;
+  if (capture_)
+    a2_capture_frame(capture_, &screen8_, (uint32_t)ms);
+  a2_screen_from_indexed(&screen_, &screen8_, dirty);
+  return true;
 }
 
 static void update_screen_image(void) {
+  uint64_t start = a2_metrics_start();
   sg_image_data imgData = {.subimage[0][0] = {.ptr = screen_.data, .size = sizeof(screen_.data)}};
   sg_update_image(bind_.fs_images[SLOT_tex], &imgData);
+  a2_metric_observe_since(metric_upload_, start);
 }
 
 static void frame_cb(void) {
   curFrameTick_ = stm_now();
-  simulate_frame();
-  update_screen();
-  update_screen_image();
+  a2_metric_observe_since(metric_interval_, last_frame_start_);
+  last_frame_start_ = a2_metrics_start();
+  if (!emu_thread_running_) {
+    process_input();
+    simulate_frame(curFrameTick_);
+    a2_video_tribuf_publish(&tribuf_, &io_, get_ram());
+  }
+  // Sokol can only update the whole image, so the dirty rectangle is used
+  // to skip the upload of unchanged frames and to limit the RGB conversion.
+  bool changed = update_screen();
+  if (metrics_overlay_ && video_ram_ && (a2_overlay_update(&overlay_) || changed)) {
+    a2_overlay_draw(&overlay_, &screen8_, &screen_);
+    changed = true;
+  }
+  if (changed)
+    update_screen_image();
+  if (metrics_dump_)
+    a2_metrics_dump_poll(metrics_dump_);
 
   sg_pass_action pass_action = {.colors[0] = {.action = SG_ACTION_CLEAR}};
   sg_begin_default_pass(&pass_action, sapp_width(), sapp_height());
@@ -454,18 +728,16 @@ static void frame_cb(void) {
   sg_commit();
 }
 
+/// Send a key press to the emulation.
+static void send_key(uint8_t ch) {
+  // If the emulation is not keeping up, dropping keys is the best we can do.
+  a2_spsc_push1(&input_, &ch);
+}
+
 static void event_cb(const sapp_event *ev) {
   int toIgnore = ignoreNextCh_;
   ignoreNextCh_ = -1;
 
-  if (key_presses_)
-    return;
-
-  // If we are reading from a file, just ensure that the keyboard queue us full,
-  // so events here will have no effect.
-  if (kbd_file_)
-    drain_kbd_file();
-
   if (ev->type == SAPP_EVENTTYPE_CHAR && ev->char_code < 128) {
     int k = (int)ev->char_code;
     if (k == 127) // Del
@@ -473,22 +745,22 @@ static void event_cb(const sapp_event *ev) {
     else if (isalpha(k))
       k = toupper(k);
     if (k != toIgnore)
-      push_key_if_empty(k);
+      send_key(k);
   } else if (ev->type == SAPP_EVENTTYPE_KEY_DOWN) {
     switch (ev->key_code) {
     case SAPP_KEYCODE_DELETE:
     case SAPP_KEYCODE_BACKSPACE:
     case SAPP_KEYCODE_LEFT:
-      push_key_if_empty(ignoreNextCh_ = 8);
+      send_key(ignoreNextCh_ = 8);
       break;
     case SAPP_KEYCODE_RIGHT:
-      push_key_if_empty(ignoreNextCh_ = 21); // CTRL+U
+      send_key(ignoreNextCh_ = 21); // CTRL+U
       break;
     case SAPP_KEYCODE_ENTER:
-      push_key_if_empty(ignoreNextCh_ = 13);
+      send_key(ignoreNextCh_ = 13);
       break;
     case SAPP_KEYCODE_ESCAPE:
-      push_key_if_empty(ignoreNextCh_ = 27);
+      send_key(ignoreNextCh_ = 27);
       break;
     default:
       break;
@@ -502,9 +774,23 @@ static void print_help() {
   printf("syntax: %s [options]\n", s_argv0);
   printf(" --help           This help\n");
   printf(" --no-sound       Disable sound\n");
+  printf(" --audio-latency=ms Target audio latency (default %u)\n", A2_SOUND_DEFAULT_LATENCY_MS);
   printf(" --kbd-file=path  Read ascii keyboard input from the specified file\n");
+  printf(" --paste-warp     Run as fast as possible while reading the kbd file\n");
+  printf(" --auto-warp      Run as fast as possible while reading the kbd or key file, until\n");
+  printf("                  a key is pressed\n");
   printf(" --key-file=path  Read key presses and cycles from the specified file\n");
   printf(" --fast           Emulate a faster CPU\n");
+  printf(" --video=mode     Display graphics as color (default), mono or ntsc\n");
+  printf(" --capture=path   Capture the screen into the specified file\n");
+  printf(" --hash-log=path  Log per-frame video hashes into the specified file\n");
+  printf(" --missed-code=path Save addresses of code which wasn't decompiled as runtime data\n");
+  printf(" --no-emu-thread  Run the emulation in the render thread\n");
+  printf(" --wav=path       Record the speaker into the specified WAV file\n");
+  printf(" --wav-rate=hz    Sample rate of the recording (default 44100)\n");
+  printf(" --metrics-overlay Show the emulation speed, frame times and audio state\n");
+  printf(" --metrics=path   Dump the metrics periodically into a .json or .csv file\n");
+  printf(" --metrics-interval=ms Interval of the metrics dump (default 1000)\n");
   printf(" --compat         Debug info compatible with the emulator\n");
   printf(" --trace          Dump state at branch targets\n");
   printf(" --trace-mem      Dump all memory writes\n");
@@ -531,6 +817,17 @@ static void parse_args(int argc, char *argv[]) {
       sound_enabled_ = false;
       continue;
     }
+    if (strncmp(arg, "--audio-latency=", 16) == 0) {
+      char *end;
+      unsigned long ms = strtoul(arg + 16, &end, 10);
+      if (!arg[16] || *end || ms > 1000) {
+        fprintf(stderr, "Invalid latency in '%s'\n", arg);
+        print_help();
+        exit(1);
+      }
+      audio_latency_ = (unsigned)ms;
+      continue;
+    }
     if (strcmp(arg, "--compat") == 0) {
       g_debug |= DebugEmu;
       continue;
@@ -551,6 +848,14 @@ static void parse_args(int argc, char *argv[]) {
       g_debug |= DebugCountBB;
       continue;
     }
+    if (strcmp(arg, "--paste-warp") == 0) {
+      paste_warp_ = true;
+      continue;
+    }
+    if (strcmp(arg, "--auto-warp") == 0) {
+      auto_warp_ = true;
+      continue;
+    }
     if (strncmp(arg, "--kbd-file=", 11) == 0) {
       const char *path = arg + 11;
       if ((kbd_file_ = fopen(path, "rt")) == NULL) {
@@ -568,6 +873,72 @@ static void parse_args(int argc, char *argv[]) {
       clock_freq_ = A2_CLOCK_FREQ * 5;
       continue;
     }
+    if (strncmp(arg, "--hash-log=", 11) == 0) {
+      if (!a2_hash_log_open(&hash_log_, arg + 11))
+        exit(2);
+      continue;
+    }
+    if (strncmp(arg, "--wav=", 6) == 0) {
+      wav_path_ = arg + 6;
+      continue;
+    }
+    if (strncmp(arg, "--wav-rate=", 11) == 0) {
+      char *end;
+      unsigned long rate = strtoul(arg + 11, &end, 10);
+      if (!arg[11] || *end || !rate || rate > 1000000) {
+        fprintf(stderr, "Invalid sample rate in '%s'\n", arg);
+        print_help();
+        exit(1);
+      }
+      wav_rate_ = (unsigned)rate;
+      continue;
+    }
+    if (strcmp(arg, "--metrics-overlay") == 0) {
+      metrics_overlay_ = true;
+      continue;
+    }
+    if (strncmp(arg, "--metrics=", 10) == 0) {
+      metrics_path_ = arg + 10;
+      continue;
+    }
+    if (strncmp(arg, "--metrics-interval=", 19) == 0) {
+      char *end;
+      unsigned long ms = strtoul(arg + 19, &end, 10);
+      if (!arg[19] || *end || !ms || ms > UINT_MAX) {
+        fprintf(stderr, "Invalid interval in '%s'\n", arg);
+        print_help();
+        exit(1);
+      }
+      metrics_interval_ = (unsigned)ms;
+      continue;
+    }
+    if (strcmp(arg, "--no-emu-thread") == 0) {
+      emu_thread_enabled_ = false;
+      continue;
+    }
+    if (strncmp(arg, "--missed-code=", 14) == 0) {
+      set_missed_code_log(arg + 14);
+      continue;
+    }
+    if (strncmp(arg, "--capture=", 10) == 0) {
+      capture_path_ = arg + 10;
+      continue;
+    }
+    if (strncmp(arg, "--video=", 8) == 0) {
+      const char *mode = arg + 8;
+      if (strcmp(mode, "color") == 0) {
+        render_mode_ = A2_RENDER_COLOR;
+      } else if (strcmp(mode, "mono") == 0) {
+        render_mode_ = A2_RENDER_MONO;
+      } else if (strcmp(mode, "ntsc") == 0) {
+        render_mode_ = A2_RENDER_NTSC;
+      } else {
+        fprintf(stderr, "Invalid video mode '%s'\n", mode);
+        print_help();
+        exit(1);
+      }
+      continue;
+    }
 
     if (arg[0] == '-') {
       fprintf(stderr, "Invalid option '%s'\n", arg);
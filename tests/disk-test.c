@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) Tzvetan Mikov.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "apple2tc/a2disk.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/// Test the track encoding of a2disk.c: the tracks of a source image are read
+/// through the soft switches of one drive and written back through the soft
+/// switches of the other drive, in every combination of sector orders. The
+/// image saved by the second drive must contain the sectors of the first, moved
+/// according to the skew of both orders.
+
+/// The logical sector stored in every physical sector, from "Beneath Apple DOS"
+/// and "Beneath Apple ProDOS".
+static const uint8_t s_dos_skew[A2_DISK_SECTORS] = {
+    0, 7, 14, 6, 13, 5, 12, 4, 11, 3, 10, 2, 9, 1, 8, 15};
+static const uint8_t s_prodos_skew[A2_DISK_SECTORS] = {
+    0, 8, 1, 9, 2, 10, 3, 11, 4, 12, 5, 13, 6, 14, 7, 15};
+
+/// The paths of the source and destination images in both orders.
+static const char *const s_src_paths[2] = {"disk-test-src.dsk", "disk-test-src.po"};
+static const char *const s_dst_paths[2] = {"disk-test-dst.dsk", "disk-test-dst.po"};
+
+static unsigned s_failures = 0;
+
+static void fail(const char *msg, unsigned src, unsigned dst, unsigned track) {
+  if (s_failures++ < 20)
+    fprintf(stderr, "%s -> %s: track %u: %s\n", s_src_paths[src], s_dst_paths[dst], track, msg);
+}
+
+static bool write_file(const char *path, const uint8_t *data) {
+  FILE *f = fopen(path, "wb");
+  if (!f) {
+    perror(path);
+    return false;
+  }
+  bool ok = fwrite(data, 1, A2_DISK_IMAGE_SIZE, f) == A2_DISK_IMAGE_SIZE;
+  if (fclose(f) != 0 || !ok) {
+    fprintf(stderr, "%s: write error\n", path);
+    return false;
+  }
+  return true;
+}
+
+static bool read_file(const char *path, uint8_t *data) {
+  FILE *f = fopen(path, "rb");
+  if (!f) {
+    perror(path);
+    return false;
+  }
+  bool ok = fread(data, 1, A2_DISK_IMAGE_SIZE, f) == A2_DISK_IMAGE_SIZE;
+  fclose(f);
+  if (!ok)
+    fprintf(stderr, "%s: read error\n", path);
+  return ok;
+}
+
+/// Move the head of the selected drive to the next track, one half track at a
+/// time, like RWTS does.
+static void step_in(a2_disk_t *disk) {
+  for (unsigned i = 0; i != 2; ++i) {
+    unsigned phase = (disk->drives[disk->drive].half_track + 1) & 3;
+    a2_disk_io(disk, 0xC0E1 + phase * 2, false, 0);
+    a2_disk_io(disk, 0xC0E0 + phase * 2, false, 0);
+  }
+}
+
+/// Find the data field of physical sector \p sector in the track nibbles \p nib.
+/// Return its offset, or -1 if it isn't found.
+static int find_data_field(const uint8_t *nib, unsigned sector) {
+  const unsigned N = A2_DISK_TRACK_NIBBLES;
+#define NIB(i) nib[(i) % N]
+  for (unsigned i = 0; i != N; ++i) {
+    if (NIB(i) == 0xD5 && NIB(i + 1) == 0xAA && NIB(i + 2) == 0x96 &&
+        (((NIB(i + 7) << 1) | 1) & NIB(i + 8)) == sector) {
+      for (unsigned j = i + 14; j != i + 14 + 64; ++j) {
+        if (NIB(j) == 0xD5 && NIB(j + 1) == 0xAA && NIB(j + 2) == 0xAD)
+          return (int)((j + 3) % N);
+      }
+    }
+  }
+#undef NIB
+  return -1;
+}
+
+/// Check the 6-and-2 encoding of a sector whose first two bytes are $02 and $04
+/// and the rest are zero. The low two bits of $02 are stored swapped in the
+/// first value, followed by the high six bits of $04 in value 87; every value is
+/// XOR-ed with the previous one.
+static void check_encoding(const uint8_t *nib, unsigned src, unsigned dst) {
+  int pos = find_data_field(nib, 0);
+  if (pos < 0) {
+    fail("no data field", src, dst, 0);
+    return;
+  }
+  for (unsigned k = 0; k != 343; ++k) {
+    uint8_t expected = k == 0 || k == 1 || k == 87 || k == 88 ? 0x97 : 0x96;
+    if (nib[(pos + k) % A2_DISK_TRACK_NIBBLES] != expected) {
+      fail("wrong 6-and-2 encoding", src, dst, 0);
+      return;
+    }
+  }
+}
+
+static void test_round_trip(unsigned src, unsigned dst) {
+  const uint8_t *srcSkew = src ? s_prodos_skew : s_dos_skew;
+  const uint8_t *dstSkew = dst ? s_prodos_skew : s_dos_skew;
+  static uint8_t srcImage[A2_DISK_IMAGE_SIZE], dstImage[A2_DISK_IMAGE_SIZE];
+  static uint8_t nib[A2_DISK_TRACK_NIBBLES];
+
+  for (unsigned i = 0; i != A2_DISK_IMAGE_SIZE; ++i) {
+    srcImage[i] = rand();
+    dstImage[i] = rand();
+  }
+  memset(srcImage, 0, A2_DISK_SECTOR_SIZE);
+  srcImage[0] = 0x02;
+  srcImage[1] = 0x04;
+  if (!write_file(s_src_paths[src], srcImage) || !write_file(s_dst_paths[dst], dstImage))
+    exit(1);
+
+  // The source image is in drive 2 and the destination in drive 1.
+  a2_disk_t disk;
+  a2_disk_init(&disk);
+  if (!a2_disk_load(&disk, 1, s_src_paths[src]) || !a2_disk_load(&disk, 0, s_dst_paths[dst]))
+    exit(1);
+
+  a2_disk_io(&disk, 0xC0E9, false, 0);
+  for (unsigned track = 0; track != A2_DISK_TRACKS; ++track) {
+    if (track) {
+      a2_disk_io(&disk, 0xC0EB, false, 0);
+      step_in(&disk);
+      a2_disk_io(&disk, 0xC0EA, false, 0);
+      step_in(&disk);
+    }
+
+    a2_disk_io(&disk, 0xC0EB, false, 0);
+    for (unsigned i = 0; i != A2_DISK_TRACK_NIBBLES; ++i)
+      nib[i] = a2_disk_io(&disk, 0xC0EC, false, 0);
+    if (track == 0)
+      check_encoding(nib, src, dst);
+
+    // Start writing at a different position in every track.
+    a2_disk_io(&disk, 0xC0EA, false, 0);
+    for (unsigned i = 0; i != 1000 + track * 37; ++i)
+      a2_disk_io(&disk, 0xC0EC, false, 0);
+    a2_disk_io(&disk, 0xC0EF, false, 0);
+    for (unsigned i = 0; i != A2_DISK_TRACK_NIBBLES; ++i) {
+      a2_disk_io(&disk, 0xC0ED, true, nib[i]);
+      a2_disk_io(&disk, 0xC0EC, false, 0);
+    }
+    a2_disk_io(&disk, 0xC0EE, false, 0);
+  }
+  a2_disk_io(&disk, 0xC0E8, false, 0);
+  if (!a2_disk_flush(&disk))
+    exit(1);
+  a2_disk_done(&disk);
+
+  if (!read_file(s_dst_paths[dst], dstImage))
+    exit(1);
+  for (unsigned track = 0; track != A2_DISK_TRACKS; ++track) {
+    for (unsigned sector = 0; sector != A2_DISK_SECTORS; ++sector) {
+      const uint8_t *s = srcImage + (track * A2_DISK_SECTORS + srcSkew[sector]) * 256;
+      const uint8_t *d = dstImage + (track * A2_DISK_SECTORS + dstSkew[sector]) * 256;
+      if (memcmp(s, d, A2_DISK_SECTOR_SIZE) != 0)
+        fail("sector mismatch", src, dst, track);
+    }
+  }
+}
+
+int main(void) {
+  srand(1);
+  for (unsigned src = 0; src != 2; ++src) {
+    for (unsigned dst = 0; dst != 2; ++dst)
+      test_round_trip(src, dst);
+  }
+  for (unsigned order = 0; order != 2; ++order) {
+    remove(s_src_paths[order]);
+    remove(s_dst_paths[order]);
+  }
+
+  printf("%u mismatches\n", s_failures);
+  return s_failures != 0;
+}
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) Tzvetan Mikov.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "interp6502-test.h"
+
+#include <stdio.h>
+
+/// A minimal runtime for interp6502-inc.h: flat memory, with every access
+/// outside of the zero page and the stack recorded.
+
+static uint8_t s_ram[0x10000];
+static test_access_t *s_log;
+static unsigned s_log_len;
+static unsigned s_log_max;
+
+static void log_access(bool write, uint16_t addr, uint8_t value) {
+  if (addr >= 0x200 && s_log_len != s_log_max)
+    s_log[s_log_len++] = (test_access_t){write, addr, value};
+}
+
+static void ram_poke_impl(uint16_t addr, uint8_t value) {
+  s_ram[addr] = value;
+}
+static uint8_t peek(uint16_t addr) {
+  log_access(false, addr, s_ram[addr]);
+  return s_ram[addr];
+}
+static uint16_t peek16(uint16_t addr) {
+  return peek(addr) + (peek(addr + 1) << 8);
+}
+static void poke(uint16_t addr, uint8_t value) {
+  log_access(true, addr, value);
+  ram_poke_impl(addr, value);
+}
+/// There is no language card.
+static bool lc_runs_ram(uint16_t pc) {
+  (void)pc;
+  return false;
+}
+
+#include "apple2tc/interp6502-inc.h"
+
+uint8_t *interp_test_ram(void) {
+  return s_ram;
+}
+
+unsigned interp_test_step(regs_t *r, test_access_t *log, unsigned max) {
+  s_log = log;
+  s_log_len = 0;
+  s_log_max = max;
+  interp_step(r);
+  return s_log_len;
+}
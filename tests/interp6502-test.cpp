@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) Tzvetan Mikov.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "interp6502-test.h"
+
+#include "apple2tc/d6502.h"
+#include "apple2tc/emu6502.h"
+
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+/// Execute every documented instruction with random registers and memory in
+/// Emu6502 and in the interpreter of the generated code, and compare the
+/// registers, the zero page and the stack, and the sequence of all other
+/// memory accesses.
+
+namespace {
+
+/// The number of random states every instruction is executed in.
+constexpr unsigned ITERATIONS = 2000;
+/// More than any instruction makes.
+constexpr unsigned MAX_ACCESSES = 8;
+
+/// Emu6502 with all memory in the IO range, so all accesses which don't go
+/// directly to the zero page or the stack are logged.
+class LoggedEmu : public Emu6502 {
+public:
+  LoggedEmu() : Emu6502(0, 0xFFFF) {}
+
+  std::vector<test_access_t> log{};
+
+protected:
+  uint8_t ioPeek(uint16_t addr) override {
+    uint8_t value = ram_peek(addr);
+    logAccess(false, addr, value);
+    return value;
+  }
+  void ioPoke(uint16_t addr, uint8_t value) override {
+    logAccess(true, addr, value);
+    ram_poke(addr, value);
+  }
+
+private:
+  void logAccess(bool write, uint16_t addr, uint8_t value) {
+    if (addr >= 0x200)
+      log.push_back({write, addr, value});
+  }
+};
+
+void printAccesses(const char *name, const test_access_t *log, size_t len) {
+  printf("  %s:", name);
+  for (size_t i = 0; i != len; ++i)
+    printf(" %s $%04X=%02X", log[i].write ? "W" : "R", log[i].addr, log[i].value);
+  printf("\n");
+}
+
+} // namespace
+
+int main() {
+  std::mt19937 rng(1);
+  LoggedEmu emu;
+  uint8_t *emuRAM = emu.getMainRAMWritable();
+  uint8_t *interpRAM = interp_test_ram();
+  for (unsigned i = 0; i != 0x10000; ++i)
+    emuRAM[i] = rng();
+  memcpy(interpRAM, emuRAM, 0x10000);
+
+  unsigned tests = 0, failures = 0;
+  for (unsigned op = 0; op != 256; ++op) {
+    if (decodeOpcode(op).kind == CPUInstKind::INVALID)
+      continue;
+    for (unsigned it = 0; it != ITERATIONS; ++it) {
+      // The rest of the memory keeps the random contents and the results of
+      // the previous instructions.
+      for (unsigned i = 0; i != 0x200; ++i)
+        emuRAM[i] = rng();
+      uint16_t pc = rng();
+      emuRAM[pc] = op;
+      emuRAM[(uint16_t)(pc + 1)] = rng();
+      emuRAM[(uint16_t)(pc + 2)] = rng();
+      for (unsigned i : {0u, 1u, 2u})
+        interpRAM[(uint16_t)(pc + i)] = emuRAM[(uint16_t)(pc + i)];
+      memcpy(interpRAM, emuRAM, 0x200);
+
+      Emu6502::Regs r{
+          pc, (uint8_t)rng(), (uint8_t)rng(), (uint8_t)rng(), (uint8_t)rng(), (uint8_t)rng()};
+      r.status = (r.status | Emu6502::STATUS_IGNORED) & ~Emu6502::STATUS_B;
+      // Half of the states in binary mode.
+      if (it & 1)
+        r.status &= ~Emu6502::STATUS_D;
+      emu.setRegs(r);
+      emu.log.clear();
+      // Every instruction takes 3 cycles.
+      emu.runFor(3);
+      Emu6502::Regs e = emu.getRegs();
+
+      regs_t ir{r.pc, r.a, r.x, r.y, r.status, r.sp};
+      test_access_t log[MAX_ACCESSES];
+      unsigned logLen = interp_test_step(&ir, log, MAX_ACCESSES);
+
+      ++tests;
+      bool same = e.pc == ir.pc && e.a == ir.a && e.x == ir.x && e.y == ir.y &&
+          e.status == ir.status && e.sp == ir.sp && memcmp(emuRAM, interpRAM, 0x200) == 0 &&
+          emu.log.size() == logLen;
+      for (unsigned i = 0; same && i != logLen; ++i) {
+        same = emu.log[i].write == log[i].write && emu.log[i].addr == log[i].addr &&
+            emu.log[i].value == log[i].value;
+      }
+      if (same)
+        continue;
+
+      if (failures++ < 20) {
+        printf(
+            "$%02X at $%04X A=%02X X=%02X Y=%02X P=%02X S=%02X\n",
+            op,
+            r.pc,
+            r.a,
+            r.x,
+            r.y,
+            r.status,
+            r.sp);
+        printf(
+            "  Emu6502: PC=%04X A=%02X X=%02X Y=%02X P=%02X S=%02X\n",
+            e.pc,
+            e.a,
+            e.x,
+            e.y,
+            e.status,
+            e.sp);
+        printf(
+            "  interp:  PC=%04X A=%02X X=%02X Y=%02X P=%02X S=%02X\n",
+            ir.pc,
+            ir.a,
+            ir.x,
+            ir.y,
+            ir.status,
+            ir.sp);
+        printAccesses("Emu6502", emu.log.data(), emu.log.size());
+        printAccesses("interp", log, logLen);
+      }
+      // Continue from the same memory.
+      memcpy(interpRAM, emuRAM, 0x10000);
+    }
+  }
+
+  printf("%u instructions, %u mismatches\n", tests, failures);
+  return failures ? 1 : 0;
+}
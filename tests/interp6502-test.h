@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) Tzvetan Mikov.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include "apple2tc/system.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// A memory access outside of the zero page and the stack, which the
+/// emulators access directly.
+typedef struct {
+  bool write;
+  uint16_t addr;
+  uint8_t value;
+} test_access_t;
+
+/// The memory of the interpreter of the generated code.
+uint8_t *interp_test_ram(void);
+/// Execute the instruction at `r->pc` with the interpreter of the generated
+/// code. Store up to \p max of its memory accesses in \p log and return their
+/// number.
+unsigned interp_test_step(regs_t *r, test_access_t *log, unsigned max);
+
+#ifdef __cplusplus
+}
+#endif
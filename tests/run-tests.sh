@@ -26,4 +26,8 @@ $a6502 func.s func.b33 && $apple2tc -O3 --ir func.b33 > func-test.ir
 diff -q func.ir func-test.ir
 rm func-test.ir func.b33
 
+$bin/tests/interp6502-test > /dev/null
+(cd $bin/tests && ./disk-test > /dev/null)
+$bin/tests/tape-test > /dev/null
+
 echo "Success!"
@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) Tzvetan Mikov.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "apple2tc/a2tape.h"
+#include "apple2tc/apple2.h"
+#include "apple2tc/apple2plus_rom.h"
+#include "apple2tc/support.h"
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+/// Compare the fast tape transfers of EmuApple2::enableFastTape() with the
+/// Monitor READ and WRITE routines running in the emulator: the registers, the
+/// zero page and the rest of memory when they reach BELL, and the records
+/// that they leave on the tape.
+
+namespace {
+
+constexpr uint16_t MON_READ = 0xFEFD;
+constexpr uint16_t MON_WRITE = 0xFECD;
+constexpr uint16_t MON_RDERR = 0xFF2D;
+constexpr uint16_t BELL = 0xFF3A;
+constexpr uint16_t A1L = 0x3C;
+constexpr uint16_t A2L = 0x3E;
+
+/// Longer than the header tone and the data of any record in the test.
+constexpr unsigned MAX_CYCLES = 60 * Emu6502::CLOCK_FREQ;
+
+unsigned s_failures = 0;
+
+void fail(const char *test, unsigned len, const std::string &msg) {
+  if (s_failures++ < 20)
+    fprintf(stderr, "%s, %u bytes: %s\n", test, len, msg.c_str());
+}
+
+std::string regsStr(const Emu6502::Regs &r) {
+  return format("PC=%04X A=%02X X=%02X Y=%02X P=%02X S=%02X", r.pc, r.a, r.x, r.y, r.status, r.sp);
+}
+
+/// An emulator with random memory, about to call \p entry to transfer \p len
+/// bytes at \p addr through \p tape.
+std::unique_ptr<EmuApple2> newEmu(
+    unsigned seed,
+    uint16_t entry,
+    uint16_t addr,
+    unsigned len,
+    a2_tape_t *tape) {
+  auto emu = std::make_unique<EmuApple2>();
+  emu->loadROM(apple2plus_rom, apple2plus_rom_len);
+  std::mt19937 rng(seed);
+  uint8_t *ram = emu->getMainRAMWritable();
+  for (unsigned i = 0; i != 0xC000; ++i)
+    ram[i] = rng();
+  uint16_t end = addr + len - 1;
+  ram[A1L] = addr;
+  ram[A1L + 1] = addr >> 8;
+  ram[A2L] = end;
+  ram[A2L + 1] = end >> 8;
+
+  Emu6502::Regs r;
+  r.pc = entry;
+  r.a = rng();
+  r.x = rng();
+  r.y = rng();
+  // Random flags, except decimal mode, which the Monitor never calls them in.
+  r.status = (rng() | 0x30) & ~Emu6502::STATUS_D;
+  r.sp = 0xF0;
+  emu->setRegs(r);
+  emu->io()->tape = tape;
+  return emu;
+}
+
+/// Run until the Monitor rings the bell or prints the read error. Return false
+/// if it doesn't get there.
+bool runToBell(EmuApple2 *emu) {
+  emu->setDebugStateCB(nullptr, [](void *, Emu6502 *, uint16_t pc) {
+    return pc == BELL || pc == MON_RDERR ? Emu6502::StopReason::StopRequesed
+                                         : Emu6502::StopReason::None;
+  });
+  emu->addDebugFlags(Emu6502::DebugASM);
+  unsigned start = emu->getCycles();
+  while (emu->getCycles() - start < MAX_CYCLES) {
+    if (emu->runFor(100000) == Emu6502::StopReason::StopRequesed)
+      return true;
+  }
+  return false;
+}
+
+/// Compare the registers and the RAM, except for the stack page, where the
+/// ROM leaves the return addresses of its subroutines.
+void compareStates(const char *test, unsigned len, const EmuApple2 *rom, const EmuApple2 *fast) {
+  Emu6502::Regs a = rom->getRegs(), b = fast->getRegs();
+  if (a.pc != b.pc || a.a != b.a || a.x != b.x || a.y != b.y || a.status != b.status ||
+      a.sp != b.sp) {
+    fail(test, len, "registers: " + regsStr(a) + ", fast " + regsStr(b));
+  }
+  const uint8_t *ramA = rom->getMainRAM(), *ramB = fast->getMainRAM();
+  for (unsigned i = 0; i != 0x100; ++i) {
+    if (ramA[i] != ramB[i])
+      fail(test, len, format("zero page $%02X: %02X, fast %02X", i, ramA[i], ramB[i]));
+  }
+  if (memcmp(ramA + 0x200, ramB + 0x200, 0xC000 - 0x200) != 0)
+    fail(test, len, "memory");
+}
+
+/// Decode the first record of \p tape.
+std::vector<uint8_t> readRecord(a2_tape_t *tape, unsigned len) {
+  std::vector<uint8_t> data(len + 1);
+  a2_tape_rewind(tape);
+  if (!a2_tape_read_block(tape, data.data(), len, &data[len]))
+    data.clear();
+  return data;
+}
+
+/// READ a record written by a2_tape_write_block(), like fastWRITE does, with
+/// the ROM and with fastREAD.
+void testRead(unsigned seed, uint16_t addr, unsigned len, bool badChecksum) {
+  const char *test = badChecksum ? "READ with a bad checksum" : "READ";
+  std::mt19937 rng(seed);
+  std::vector<uint8_t> data(len + 1);
+  uint8_t sum = 0xFF;
+  for (unsigned i = 0; i != len; ++i)
+    sum ^= data[i] = rng();
+  // With an extra byte, READ takes it as the checksum.
+  data[len] = ~sum;
+  a2_tape_t tapes[2];
+  for (a2_tape_t &tape : tapes) {
+    a2_tape_init(&tape);
+    a2_tape_write_block(&tape, 64 * 256, data.data(), len + badChecksum);
+    a2_tape_rewind(&tape);
+  }
+
+  auto rom = newEmu(seed, MON_READ, addr, len, &tapes[0]);
+  auto fast = newEmu(seed, MON_READ, addr, len, &tapes[1]);
+  fast->enableFastTape();
+  if (!runToBell(rom.get()) || !runToBell(fast.get())) {
+    fail(test, len, "didn't finish");
+  } else {
+    if (rom->getRegs().pc != (badChecksum ? MON_RDERR : BELL))
+      fail(test, len, "wrong result");
+    compareStates(test, len, rom.get(), fast.get());
+  }
+  a2_tape_done(&tapes[0]);
+  a2_tape_done(&tapes[1]);
+}
+
+/// WRITE a record with the ROM and with fastWRITE, and compare the states and
+/// the records. Then READ the record of the ROM with fastREAD.
+void testWrite(unsigned seed, uint16_t addr, unsigned len) {
+  const char *test = "WRITE";
+  a2_tape_t tapes[2];
+  a2_tape_init(&tapes[0]);
+  a2_tape_init(&tapes[1]);
+
+  auto rom = newEmu(seed, MON_WRITE, addr, len, &tapes[0]);
+  auto fast = newEmu(seed, MON_WRITE, addr, len, &tapes[1]);
+  fast->enableFastTape();
+  if (!runToBell(rom.get()) || !runToBell(fast.get())) {
+    fail(test, len, "didn't finish");
+  } else {
+    compareStates(test, len, rom.get(), fast.get());
+    std::vector<uint8_t> recorded = readRecord(&tapes[0], len);
+    if (recorded.empty())
+      fail(test, len, "the ROM record can't be decoded");
+    if (recorded != readRecord(&tapes[1], len))
+      fail(test, len, "different records");
+
+    a2_tape_rewind(&tapes[0]);
+    auto reader = newEmu(seed + 1, MON_READ, addr, len, &tapes[0]);
+    reader->enableFastTape();
+    if (!runToBell(reader.get()) || reader->getRegs().pc != BELL ||
+        memcmp(reader->getMainRAM() + addr, rom->getMainRAM() + addr, len) != 0) {
+      fail("fastREAD of the ROM record", len, "wrong data");
+    }
+  }
+  a2_tape_done(&tapes[0]);
+  a2_tape_done(&tapes[1]);
+}
+
+} // namespace
+
+int main() {
+  static const struct {
+    uint16_t addr;
+    unsigned len;
+  } ranges[] = {{0x300, 1}, {0x800, 256}, {0x1F80, 300}};
+
+  unsigned seed = 1;
+  for (const auto &range : ranges) {
+    testRead(seed++, range.addr, range.len, false);
+    testRead(seed++, range.addr, range.len, true);
+    testWrite(seed++, range.addr, range.len);
+  }
+
+  printf("%u mismatches\n", s_failures);
+  return s_failures != 0;
+}
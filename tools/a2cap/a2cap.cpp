@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) Tzvetan Mikov.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "apple2tc/a2capture.h"
+
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+/// Converts screen captures to formats understood by standard tools.
+
+static void printHelp(const char **argv) {
+  fprintf(stderr, "syntax: %s [options] input_file\n", argv[0]);
+  fprintf(stderr, " --ppm=prefix   Write every captured frame to prefix-NNNNNN.ppm\n");
+  fprintf(stderr, " --y4m=path     Write a constant frame rate Y4M stream ('-' is stdout)\n");
+  fprintf(stderr, " --fps=number   Frame rate of the Y4M stream (default 60)\n");
+  fprintf(stderr, " --info         Print the number of frames and the duration\n");
+}
+
+/// Expand an indexed screen to packed RGB.
+static void toRGB(const a2_capture_reader_t &rd, std::vector<uint8_t> &rgb) {
+  rgb.resize(A2_SCREEN_W * A2_SCREEN_H * 3);
+  uint8_t *d = rgb.data();
+  for (uint8_t index : rd.screen.data) {
+    const a2_rgba8 &c = rd.palette[index & 15];
+    *d++ = c.r;
+    *d++ = c.g;
+    *d++ = c.b;
+  }
+}
+
+static bool writePPM(const a2_capture_reader_t &rd, const std::string &prefix, unsigned index) {
+  char name[32];
+  snprintf(name, sizeof(name), "-%06u.ppm", index);
+  std::string path = prefix + name;
+  FILE *f = fopen(path.c_str(), "wb");
+  if (!f) {
+    perror(path.c_str());
+    return false;
+  }
+  std::vector<uint8_t> rgb;
+  toRGB(rd, rgb);
+  fprintf(f, "P6\n%u %u\n255\n", A2_SCREEN_W, A2_SCREEN_H);
+  fwrite(rgb.data(), 1, rgb.size(), f);
+  return fclose(f) == 0;
+}
+
+/// Writes YUV 4:4:4 frames in the YUV4MPEG2 format.
+class Y4MWriter {
+public:
+  explicit Y4MWriter(FILE *f, unsigned fps) : f_(f) {
+    fprintf(f_, "YUV4MPEG2 W%u H%u F%u:1 Ip A1:1 C444\n", A2_SCREEN_W, A2_SCREEN_H, fps);
+  }
+
+  /// Pre-compute the YUV values of the palette (BT.601, studio range).
+  void setPalette(const a2_rgba8 *palette) {
+    for (unsigned i = 0; i != 16; ++i) {
+      double r = palette[i].r, g = palette[i].g, b = palette[i].b;
+      yuv_[i][0] = (uint8_t)(16.5 + 0.257 * r + 0.504 * g + 0.098 * b);
+      yuv_[i][1] = (uint8_t)(128.5 - 0.148 * r - 0.291 * g + 0.439 * b);
+      yuv_[i][2] = (uint8_t)(128.5 + 0.439 * r - 0.368 * g - 0.071 * b);
+    }
+  }
+
+  void write(const a2_screen8 &screen) {
+    fputs("FRAME\n", f_);
+    plane_.resize(A2_SCREEN_W * A2_SCREEN_H);
+    for (unsigned p = 0; p != 3; ++p) {
+      for (unsigned i = 0; i != A2_SCREEN_W * A2_SCREEN_H; ++i)
+        plane_[i] = yuv_[screen.data[i] & 15][p];
+      fwrite(plane_.data(), 1, plane_.size(), f_);
+    }
+  }
+
+private:
+  FILE *f_;
+  uint8_t yuv_[16][3] = {};
+  std::vector<uint8_t> plane_{};
+};
+
+int main(int argc, const char **argv) {
+  std::string inputPath{};
+  std::string ppmPrefix{};
+  std::string y4mPath{};
+  unsigned fps = 60;
+  bool info = false;
+
+  for (int i = 1; i < argc; ++i) {
+    const char *arg = argv[i];
+    if (strncmp(arg, "--ppm=", 6) == 0) {
+      ppmPrefix = arg + 6;
+      continue;
+    }
+    if (strncmp(arg, "--y4m=", 6) == 0) {
+      y4mPath = arg + 6;
+      continue;
+    }
+    if (strncmp(arg, "--fps=", 6) == 0) {
+      auto cr = std::from_chars(arg + 6, strchr(arg, 0), fps);
+      if (*cr.ptr || cr.ec != std::errc() || !fps) {
+        fprintf(stderr, "Invalid number in '%s'\n", arg);
+        printHelp(argv);
+        return 1;
+      }
+      continue;
+    }
+    if (strcmp(arg, "--info") == 0) {
+      info = true;
+      continue;
+    }
+    if (arg[0] == '-') {
+      printHelp(argv);
+      return 1;
+    }
+    if (inputPath.empty()) {
+      inputPath = arg;
+      continue;
+    }
+    fprintf(stderr, "too many arguments\n");
+    printHelp(argv);
+    return 1;
+  }
+  if (inputPath.empty()) {
+    printHelp(argv);
+    return 1;
+  }
+
+  a2_capture_reader_t rd;
+  if (!a2_capture_reader_open(&rd, inputPath.c_str()))
+    return 1;
+
+  FILE *y4mFile = nullptr;
+  std::unique_ptr<Y4MWriter> y4m{};
+  if (!y4mPath.empty()) {
+    y4mFile = y4mPath == "-" ? stdout : fopen(y4mPath.c_str(), "wb");
+    if (!y4mFile) {
+      perror(y4mPath.c_str());
+      return 1;
+    }
+    y4m = std::make_unique<Y4MWriter>(y4mFile, fps);
+    y4m->setPalette(rd.palette);
+  }
+
+  // Y4M has a constant frame rate, so every output frame shows the last
+  // captured frame at or before its time.
+  a2_screen8 cur{};
+  uint32_t firstMS = 0;
+  uint32_t lastMS = 0;
+  unsigned outFrames = 0;
+  unsigned count = 0;
+  bool ok = true;
+  for (; a2_capture_reader_next(&rd); ++count) {
+    if (count == 0)
+      firstMS = rd.ms;
+    if (y4m) {
+      while (firstMS + (uint64_t)outFrames * 1000 / fps < rd.ms) {
+        y4m->write(cur);
+        ++outFrames;
+      }
+    }
+    cur = rd.screen;
+    lastMS = rd.ms;
+    if (!ppmPrefix.empty() && !writePPM(rd, ppmPrefix, count)) {
+      ok = false;
+      break;
+    }
+  }
+  if (y4m && count)
+    y4m->write(cur);
+
+  if (rd.error) {
+    fprintf(stderr, "%s: corrupted frame %u\n", inputPath.c_str(), count);
+    ok = false;
+  }
+  a2_capture_reader_close(&rd);
+  if (y4mFile && y4mFile != stdout && fclose(y4mFile) != 0)
+    ok = false;
+
+  if (info)
+    printf("%u frames, %.3f s\n", count, (lastMS - firstMS) / 1000.0);
+  return ok ? 0 : 1;
+}
@@ -6,8 +6,16 @@
  */
 
 #include "apple2tc/DebugState6502.h"
+#include "apple2tc/a2capture.h"
+#include "apple2tc/a2disk.h"
+#include "apple2tc/a2hash.h"
+#include "apple2tc/a2tape.h"
 #include "apple2tc/a2io.h"
+#include "apple2tc/a2metrics.h"
+#include "apple2tc/a2tribuf.h"
+#include "apple2tc/a2wav.h"
 #include "apple2tc/apple2.h"
+#include "apple2tc/apple2iodefs.h"
 #include "apple2tc/apple2plus_rom.h"
 #include "apple2tc/sokol/sokol_app.h"
 #include "apple2tc/sokol/sokol_audio.h"
@@ -21,9 +29,11 @@
 #include <algorithm>
 #include <cctype>
 #include <charconv>
+#include <chrono>
 #include <fstream>
 #include <iostream>
 #include <optional>
+#include <thread>
 
 /// Load a DOS3.3 binary buffer into emulated RAM.
 /// Return the load address.
@@ -39,6 +49,15 @@ static void runB33(EmuApple2 *emu, const uint8_t *data, size_t len);
 /// length.
 static std::optional<uint16_t> loadB33File(EmuApple2 *emu, const char *path);
 
+/// Return true if the file should be loaded as an Applesoft listing.
+static bool isBasicPath(const std::string &path);
+
+/// Return true if the file should be loaded as a disk image.
+static bool isDiskPath(const std::string &path);
+
+/// Tokenize an Applesoft listing into memory. Return false on error.
+static bool loadBasicFile(EmuApple2 *emu, const char *path);
+
 struct CLIArgs {
   enum Action {
     // Just run the specified file.
@@ -51,16 +70,65 @@ struct CLIArgs {
   Action action = Action::Run;
   /// Start tracing/collecting from rom.
   bool rom = false;
+  /// Run the ROM cold start instead of restoring the cached state after it.
+  bool coldBoot = false;
   bool soundEnabled = true;
+  /// Target audio latency in milliseconds.
+  unsigned audioLatency = A2_SOUND_DEFAULT_LATENCY_MS;
   unsigned limit = 100000;
   unsigned clockFreq = Emu6502::CLOCK_FREQ;
   std::string runPath{};
   std::string outputPath{};
-  /// Kbd input streamed from here.
+  /// Kbd input pasted from here.
   std::string kbdPath{};
+  /// Run as fast as possible while pasting.
+  bool pasteWarp = false;
+  /// Run as fast as possible while the disk drive motor is on.
+  bool diskWarp = false;
+  /// Run as fast as possible while pasting, replaying the key file, or the disk
+  /// drive motor is on.
+  bool autoWarp = false;
+  /// Execute hot ROM routines natively.
+  bool hle = false;
+  /// Check the native ROM routines against the ROM.
+  bool hleVerify = false;
+  /// If not empty, the decompiled ROM module to run natively.
+  std::string hybridPath{};
+  /// How to display graphics modes.
+  a2_render_mode_t renderMode = A2_RENDER_COLOR;
+  /// If not empty, capture the screen into this file.
+  std::string capturePath{};
+  /// Key presses with cycle stamps are replayed from here.
+  std::string keyPath{};
+  /// If not empty, per-frame video hashes are logged here.
+  std::string hashLogPath{};
+  /// If not empty, the speaker is recorded here.
+  std::string wavPath{};
+  /// Sample rate of the recording.
+  unsigned wavRate = 44100;
+  /// If not empty, the cassette tape WAV file.
+  std::string tapePath{};
+  /// Transfer tape data only through the emulated cassette signal.
+  bool tapeSlow = false;
+  /// Draw the metrics over the screen.
+  bool metricsOverlay = false;
+  /// If not empty, the metrics are dumped here every `metricsInterval` ms.
+  std::string metricsPath{};
+  unsigned metricsInterval = 1000;
+#ifndef __EMSCRIPTEN__
+  /// Run the emulation in its own thread.
+  bool emuThread = true;
+#else
+  bool emuThread = false;
+#endif
 };
 
 class A2Emu {
+  /// Wall time in milliseconds spent emulating per frame while warping. It is
+  /// longer than a frame, so the video is published about 20 times a second,
+  /// and the rest of the time goes to the emulation.
+  static constexpr unsigned WARP_MS = 50;
+
 public:
   explicit A2Emu(CLIArgs &&cliArgs);
   ~A2Emu();
@@ -81,24 +149,59 @@ private:
   /// Prepare the system window, init GFX.
   void initWindow();
 
+  /// Insert the input file into the disk drive, if it is a disk image.
+  void insertDisk();
+  /// Connect the cassette tape, if one was specified.
+  void insertTape();
+
   /// Init the debugging/trace/collection state.
   void initTraceCollect();
 
-  /// Invoked when the warm restart breakpoint is hit.
+  /// Invoked at the warm restart, when the breakpoint is hit or right after
+  /// the fast boot.
   void onWarmRestartBP();
 
-  /// Open and start draining the keyboard file if specified.
+  /// Paste the contents of the keyboard file if specified.
   void openKBDFile();
 
-  /// While the KBD file is open, read as many characters from it as possible.
-  /// Close the file of EOF is reached.
-  void drainKBDFile();
+  /// Load key presses with cycle stamps from the key file if specified.
+  void loadKeyFile();
+
+  /// Start replaying key presses and logging hashes. Cycles are counted from
+  /// here, which is the start of the program, like in the decompiled binary.
+  void startReplay();
+
+  /// Push the key presses whose time has come and stop the next run at the
+  /// cycle of the following one. Return true if any keys were pushed.
+  bool drainKeyPresses();
+
+  /// Queue an input command for the emulation.
+  void pushInput(uint8_t kind, uint8_t ch = 0);
+
+  /// Execute the queued input commands. Invoked by the emulation.
+  void processInput();
+
+  /// The body of the emulation thread: simulate and publish a frame every
+  /// 1/60 s until stopped.
+  void emulationLoop();
+
+  /// Stop the emulation thread, if it is running.
+  void stopEmulation();
+
+  /// Return true if the input comes from a file, or the disk is spinning, and
+  /// the options ask to run as fast as possible then.
+  bool warpWanted();
+  /// Return true if the emulation should run as fast as possible.
+  bool warping();
 
-  /// Simulate the last frame.
-  void simulateFrame();
+  /// Simulate the time since the last frame. Return true if it warped.
+  bool simulateFrame(uint64_t now);
+  /// Run the emulation for the specified number of cycles.
+  void runEmulation(unsigned runCycles);
 
-  /// Update the screen buffer.
-  void updateScreen();
+  /// Render the latest published video frame into the screen buffer. Returns
+  /// true if anything changed.
+  bool updateScreen();
 
   /// Update the GFX image with data from the screen.
   void updateScreenImage();
@@ -112,25 +215,95 @@ private:
   sg_bindings bind_ = {0};
   sg_pipeline pip_ = {0};
 
-  /// stm_now() at the start of every frame.
+  /// stm_now() at the start of every rendered frame.
   uint64_t curFrameTick_ = 0;
+  /// stm_now() at startup.
+  uint64_t firstFrameTick_ = 0;
+
+  // Emulation state. Everything below, except where noted, is accessed only
+  // by the emulation, which runs either in the emulation thread or, if there
+  // isn't one, in the render thread before rendering.
 
   uint64_t lastRunTick_ = 0;
-  uint64_t firstFrameTick_ = 0;
   bool firstFrame_ = true;
 
+  std::thread emuThread_{};
+  /// Set by the render thread to stop the emulation thread.
+  std::atomic<bool> emuQuit_{false};
+
+  /// Input commands sent from the UI to the emulation.
+  struct Input {
+    enum : uint8_t { Key, RunBolo, RunRobotron, Stop };
+    uint8_t kind;
+    uint8_t ch;
+  };
+  /// Written by the render thread, read by the emulation thread.
+  SPSCRing<Input> input_{64};
+  /// Video frames published by the emulation for rendering.
+  a2_video_tribuf_t tribuf_;
+
   // KBD handling.
 
   /// If set to a valid character, the next character will be ignored, if it
   /// matches this value. Next character, whatever it is, always clears this.
   /// This is used on same platforms where some keys like ENTER arrive both as
-  /// characters and as keydown events.
+  /// characters and as keydown events. Accessed only by the render thread.
   int ignoreNextCh_ = -1;
-  /// If not-null, a file from where to read keyboard presses.
-  FILE *kbdFile_ = nullptr;
+  /// Whether the keyboard file has been pasted.
+  bool kbdFilePasted_ = false;
+
+  struct KeyPress {
+    unsigned cycles;
+    uint8_t ch;
+  };
+  /// Key presses loaded from the key file.
+  std::vector<KeyPress> keyPresses_{};
+  /// Next key press to process.
+  size_t nextKeyPress_ = 0;
+  /// Set when startReplay() has been invoked.
+  bool replayStarted_ = false;
+  /// Cycle count at the start of the replay.
+  unsigned replayBaseCycles_ = 0;
+  /// Set by interactive key presses, which return the emulation to normal
+  /// speed until the reason for warping is gone.
+  bool warpSuspended_ = false;
+  /// Per-frame video hashes are logged here, if `hashLog_.f` is set.
+  a2_hash_log_t hashLog_{};
+  /// If not null, the speaker is recorded here.
+  a2_wav_sink_t *wav_ = nullptr;
 
   a2_sound_t sound_;
+  /// The Disk II controller. It is only connected if a disk is inserted.
+  a2_disk_t disk_;
+  a2_tape_t tape_;
+
+  /// Cycles of real time requested by simulateFrame() and the cycles it ran,
+  /// which differ when it falls behind or warps, and the time spent in it.
+  a2_metric_t metricRequested_ = a2_metric_counter("frame.requested_cycles");
+  a2_metric_t metricRun_ = a2_metric_counter("frame.cycles");
+  a2_metric_t metricSim_ = a2_metric_histogram_ms("frame.sim_ms");
+
+  // Render thread state.
+
+  /// Video mode and dirty rows accumulated from the consumed video frames.
+  a2_iostate_t videoIO_{};
+  /// RAM of the last consumed video frame.
+  const uint8_t *videoRAM_ = nullptr;
+  /// The indexed screen produced by the renderer.
+  a2_screen8 screen8_;
+  /// The RGB screen uploaded to the texture.
   a2_screen screen_;
+  /// If not null, the screen is captured here.
+  a2_capture_t *capture_ = nullptr;
+  a2_renderer_t renderer_;
+  /// The time between rendered frames and the time spent uploading the screen.
+  a2_metric_t metricInterval_ = a2_metric_histogram_ms("frame.interval_ms");
+  a2_metric_t metricUpload_ = a2_metric_histogram_ms("render.upload_ms");
+  /// a2_metrics_start() at the start of the previous frame.
+  uint64_t lastFrameStart_ = 0;
+  /// If not null, the metrics are dumped here.
+  a2_metrics_dump_t *metricsDump_ = nullptr;
+  a2_overlay_t overlay_;
 
   DebugState6502 dbg_{};
   EmuApple2 emu_{};
@@ -141,7 +314,32 @@ static A2Emu *s_a2emu = nullptr;
 A2Emu::A2Emu(CLIArgs &&cliArgs) : cliArgs_(std::move(cliArgs)) {
   initWindow();
 
-  a2_sound_init(&sound_);
+  if (!a2_sound_init(&sound_)) {
+    fprintf(stderr, "Not enough memory\n");
+    exit(2);
+  }
+  a2_sound_set_latency(&sound_, cliArgs_.audioLatency);
+  a2_video_tribuf_init(&tribuf_);
+  a2_renderer_init(&renderer_);
+  a2_disk_init(&disk_);
+  a2_tape_init(&tape_);
+  renderer_.render_mode = cliArgs_.renderMode;
+  if (!cliArgs_.capturePath.empty() && !(capture_ = a2_capture_open(cliArgs_.capturePath.c_str())))
+    exit(2);
+  if (!cliArgs_.hashLogPath.empty() && !a2_hash_log_open(&hashLog_, cliArgs_.hashLogPath.c_str()))
+    exit(2);
+  if (!cliArgs_.wavPath.empty() &&
+      !(wav_ = a2_wav_open(cliArgs_.wavPath.c_str(), Emu6502::CLOCK_FREQ, cliArgs_.wavRate))) {
+    exit(2);
+  }
+  if (!cliArgs_.metricsPath.empty() &&
+      !(metricsDump_ =
+            a2_metrics_dump_open(cliArgs_.metricsPath.c_str(), cliArgs_.metricsInterval))) {
+    exit(2);
+  }
+  if (cliArgs_.metricsOverlay)
+    a2_overlay_init(&overlay_);
+  loadKeyFile();
 
   if (cliArgs_.soundEnabled) {
     saudio_desc audioDesc = {
@@ -156,14 +354,58 @@ A2Emu::A2Emu(CLIArgs &&cliArgs) : cliArgs_(std::move(cliArgs)) {
     };
     saudio_setup(&audioDesc);
   }
-  emu_.setSpeakerCB(&sound_, [](void *ctx, unsigned cycles) {
-    a2_sound_spkr((a2_sound_t *)ctx, Emu6502::CLOCK_FREQ, saudio_sample_rate(), cycles);
+  emu_.setSpeakerCB(this, [](void *ctx, unsigned cycles) {
+    auto *self = (A2Emu *)ctx;
+    a2_sound_spkr(&self->sound_, cycles);
+    if (self->wav_)
+      a2_wav_spkr(self->wav_, cycles);
   });
   emu_.loadROM(apple2plus_rom, apple2plus_rom_len);
+  if (cliArgs_.hle)
+    emu_.enableHLE();
+  else if (cliArgs_.action != CLIArgs::Collect)
+    emu_.enableFastWait();
+  emu_.setTrapVerify(cliArgs_.hleVerify);
+  if (!cliArgs_.hybridPath.empty()) {
+    std::string error;
+    if (!emu_.loadHybrid(cliArgs_.hybridPath.c_str(), error)) {
+      fprintf(stderr, "%s\n", error.c_str());
+      exit(1);
+    }
+  }
 
   stm_setup();
+  firstFrameTick_ = stm_now();
 
+  insertDisk();
+  insertTape();
   initTraceCollect();
+
+  if (cliArgs_.emuThread)
+    emuThread_ = std::thread([this] { emulationLoop(); });
+}
+
+void A2Emu::insertDisk() {
+  if (!isDiskPath(cliArgs_.runPath))
+    return;
+  if (!a2_disk_load(&disk_, 0, cliArgs_.runPath.c_str()))
+    exit(1);
+  emu_.io()->disk = &disk_;
+}
+
+void A2Emu::insertTape() {
+  if (cliArgs_.tapePath.empty())
+    return;
+  // A missing file is a blank tape, which is created when recorded.
+  if (FILE *f = fopen(cliArgs_.tapePath.c_str(), "rb")) {
+    fclose(f);
+    if (!a2_tape_load(&tape_, cliArgs_.tapePath.c_str()))
+      exit(1);
+  }
+  emu_.io()->tape = &tape_;
+  // Like the other traps, skip the ROM code only when it isn't being observed.
+  if (!cliArgs_.tapeSlow && !cliArgs_.hleVerify && cliArgs_.action != CLIArgs::Collect)
+    emu_.enableFastTape();
 }
 
 void A2Emu::initTraceCollect() {
@@ -186,11 +428,18 @@ void A2Emu::initTraceCollect() {
     dbg_.setModeCollect(&emu_, cliArgs_.limit);
   }
 
+  // Unless the ROM itself is being traced, skip the cold start and start at
+  // the warm restart.
+  bool booted = !cliArgs_.rom && !cliArgs_.coldBoot && emu_.fastBoot();
+  bool loadFile = !cliArgs_.runPath.empty() && !emu_.io()->disk;
+
   // If we have a file to load, we place a breakpoint after initialization.
   // As soon as we hit the breakpoint, we load the file and start it.
-  if (!cliArgs_.runPath.empty()) {
+  if (loadFile && booted) {
+    onWarmRestartBP();
+  } else if (loadFile) {
     emu_.addDebugFlags(Emu6502::DebugASM);
-    dbg_.setBreakpoint(0xD43C); // Warm restart.
+    dbg_.setBreakpoint(EmuApple2::APPLESOFT_RESTART);
     dbg_.setBreakpointCB([this](uint16_t addr) {
       dbg_.clearBreakpoint(addr);
       dbg_.setBreakpointCB({});
@@ -203,10 +452,17 @@ void A2Emu::initTraceCollect() {
       onWarmRestartBP();
       return Emu6502::StopReason::None;
     });
-  } else if (!cliArgs_.kbdPath.empty()) {
-    // The first key pressed before initialization is lost, so just add a dummy keypress.
-    a2_io_push_key(emu_.io(), '\r');
-    openKBDFile();
+  } else {
+    // Boot the disk like PR#6. The ROM cold start boots it by itself.
+    if (emu_.io()->disk && booted)
+      setRegsForRun(&emu_, A2_DISK2_ROM);
+    startReplay();
+    if (!cliArgs_.kbdPath.empty()) {
+      // The first key pressed before initialization is lost, so just add a dummy keypress.
+      if (!booted)
+        a2_io_push_key(emu_.io(), '\r');
+      openKBDFile();
+    }
   }
 }
 
@@ -215,20 +471,27 @@ void A2Emu::onWarmRestartBP() {
     // This should never happen, but why not check.
     return;
   }
-  auto addr = loadB33File(&emu_, cliArgs_.runPath.c_str());
-  if (!addr)
-    return;
-
-  if (cliArgs_.rom) {
-    // If we are tracing/collecting starting from ROM, invoke the program from BASIC.
-    char buf[32];
-    snprintf(buf, sizeof(buf), "CALL %u\r", *addr);
-    a2_io_push_str(emu_.io(), buf);
+  if (isBasicPath(cliArgs_.runPath)) {
+    if (!loadBasicFile(&emu_, cliArgs_.runPath.c_str()))
+      return;
+    runApplesoftProgram(&emu_);
   } else {
-    setRegsForRun(&emu_, *addr);
+    auto addr = loadB33File(&emu_, cliArgs_.runPath.c_str());
+    if (!addr)
+      return;
+
+    if (cliArgs_.rom) {
+      // If we are tracing/collecting starting from ROM, invoke the program from BASIC.
+      char buf[32];
+      snprintf(buf, sizeof(buf), "CALL %u\r", *addr);
+      a2_io_push_str(emu_.io(), buf);
+    } else {
+      setRegsForRun(&emu_, *addr);
+    }
   }
 
   openKBDFile();
+  startReplay();
 
   // If mode is already set, do nothing.
   if (dbg_.getMode() != DebugState6502::Mode::None)
@@ -249,16 +512,59 @@ void A2Emu::onWarmRestartBP() {
 }
 
 void A2Emu::openKBDFile() {
-  assert(!kbdFile_ && "openKBDFile() must not be called twice");
+  assert(!kbdFilePasted_ && "openKBDFile() must not be called twice");
   if (cliArgs_.kbdPath.empty())
     return;
 
-  if ((kbdFile_ = fopen(cliArgs_.kbdPath.c_str(), "rt")) == nullptr) {
+  FILE *f = fopen(cliArgs_.kbdPath.c_str(), "rt");
+  if (!f) {
     perror(cliArgs_.kbdPath.c_str());
     exit(2);
   }
+  if (!a2_io_paste_file(emu_.io(), f)) {
+    fprintf(stderr, "%s: read error\n", cliArgs_.kbdPath.c_str());
+    exit(2);
+  }
+  fclose(f);
+  kbdFilePasted_ = true;
+}
 
-  drainKBDFile();
+void A2Emu::loadKeyFile() {
+  if (cliArgs_.keyPath.empty())
+    return;
+  FILE *f = fopen(cliArgs_.keyPath.c_str(), "rt");
+  if (!f) {
+    perror(cliArgs_.keyPath.c_str());
+    exit(2);
+  }
+  unsigned cycles, ch;
+  int res;
+  while ((res = fscanf(f, "%u %u\n", &cycles, &ch)) == 2)
+    keyPresses_.push_back({cycles, (uint8_t)ch});
+  fclose(f);
+  if (res != EOF) {
+    fprintf(stderr, "Error parsing key file\n");
+    exit(2);
+  }
+  fprintf(stderr, "Loaded %zu keys\n", keyPresses_.size());
+}
+
+void A2Emu::startReplay() {
+  replayStarted_ = true;
+  replayBaseCycles_ = emu_.getCycles();
+}
+
+bool A2Emu::drainKeyPresses() {
+  unsigned cycles = emu_.getCycles() - replayBaseCycles_;
+  size_t start = nextKeyPress_;
+  while (nextKeyPress_ != keyPresses_.size() && cycles >= keyPresses_[nextKeyPress_].cycles)
+    a2_io_push_key(emu_.io(), keyPresses_[nextKeyPress_++].ch);
+
+  if (nextKeyPress_ != keyPresses_.size())
+    emu_.setEventCycle(replayBaseCycles_ + keyPresses_[nextKeyPress_].cycles);
+  else
+    emu_.clearEventCycle();
+  return nextKeyPress_ != start;
 }
 
 void A2Emu::initWindow() {
@@ -266,11 +572,14 @@ void A2Emu::initWindow() {
   sg_setup(&desc);
 
   sg_image_desc idesc = {
-      .width = A2_SCREEN_W_POT,
-      .height = A2_SCREEN_H_POT,
+      .width = A2_SCREEN_W,
+      .height = A2_SCREEN_H,
       .usage = SG_USAGE_STREAM,
       .min_filter = SG_FILTER_LINEAR,
       .mag_filter = SG_FILTER_LINEAR,
+      // Required for non-power-of-two textures in GLES2.
+      .wrap_u = SG_WRAP_CLAMP_TO_EDGE,
+      .wrap_v = SG_WRAP_CLAMP_TO_EDGE,
       .label = "a2_image",
   };
   bind_.fs_images[SLOT_tex] = sg_make_image(&idesc);
@@ -281,13 +590,11 @@ void A2Emu::initWindow() {
    * ------+------
    *    3  |  1
    */
-  static const float U = (float)A2_SCREEN_W / A2_SCREEN_W_POT;
-  static const float V = (float)A2_SCREEN_H / A2_SCREEN_H_POT;
   static const float vertices[][4] = {
-      {1, 1, U, 0},
-      {1, -1, U, V},
+      {1, 1, 1, 0},
+      {1, -1, 1, 1},
       {-1, 1, 0, 0},
-      {-1, -1, 0, V},
+      {-1, -1, 0, 1},
   };
   sg_buffer_desc bdesc = {
       .data = SG_RANGE(vertices),
@@ -308,32 +615,45 @@ void A2Emu::initWindow() {
 }
 
 A2Emu::~A2Emu() {
-  if (kbdFile_) {
-    fclose(kbdFile_);
-    kbdFile_ = nullptr;
+  stopEmulation();
+  if (capture_)
+    a2_capture_close(capture_);
+  a2_hash_log_close(&hashLog_);
+  if (cliArgs_.hleVerify)
+    fprintf(stderr, "HLE: %u mismatches\n", emu_.getTrapMismatches());
+  if (wav_) {
+    a2_wav_advance(wav_, emu_.getCycles());
+    if (!a2_wav_close(wav_))
+      fprintf(stderr, "%s: write error\n", cliArgs_.wavPath.c_str());
   }
+  a2_disk_done(&disk_);
+  if (tape_.dirty)
+    a2_tape_save(&tape_, cliArgs_.tapePath.c_str());
+  a2_tape_done(&tape_);
   sg_shutdown();
-  if (cliArgs_.soundEnabled)
+  if (cliArgs_.soundEnabled) {
     saudio_shutdown();
+    a2_sound_stats_t stats = a2_sound_get_stats(&sound_);
+    fprintf(
+        stderr,
+        "Sound: latency %u ms, %u underruns, %u samples dropped, %u toggles lost\n",
+        stats.latency_ms,
+        stats.underruns,
+        stats.dropped,
+        stats.lost);
+  }
+  if (metricsDump_)
+    a2_metrics_dump_close(metricsDump_);
   a2_sound_done(&sound_);
 }
 
-void A2Emu::drainKBDFile() {
-  if (!kbdFile_)
-    return;
-  while (a2_io_keys_expect(emu_.io())) {
-    int ch = getc(kbdFile_);
-    if (ch == EOF) {
-      fclose(kbdFile_);
-      kbdFile_ = nullptr;
-      break;
-    }
-    if (ch == '\r')
-      continue;
-    if (ch == '\n')
-      ch = '\r';
-    a2_io_push_key(emu_.io(), (int8_t)ch);
+void A2Emu::stopEmulation() {
+  if (emuThread_.joinable()) {
+    emuQuit_.store(true, std::memory_order_release);
+    emuThread_.join();
   }
+  // Execute any commands that were queued after the last frame, like Stop.
+  processInput();
 }
 
 static std::optional<uint16_t> loadB33Buf(EmuApple2 *emu, const uint8_t *data, size_t len) {
@@ -341,6 +661,7 @@ static std::optional<uint16_t> loadB33Buf(EmuApple2 *emu, const uint8_t *data, s
     uint16_t start = data[0] + data[1] * 256;
     if (len - 4 <= 0x10000 - start) {
       memcpy(emu->getMainRAMWritable() + start, data + 4, len - 4);
+      a2_io_vid_invalidate(emu->io());
       fprintf(stderr, "Loaded %zu at $%04X (%u)\n", len - 4, start, start);
       return start;
     }
@@ -373,6 +694,41 @@ static std::optional<uint16_t> loadB33File(EmuApple2 *emu, const char *path) {
   return std::nullopt;
 }
 
+/// Return the lowercase extension of the path, without the dot.
+static std::string pathExt(const std::string &path) {
+  auto dot = path.rfind('.');
+  if (dot == std::string::npos)
+    return {};
+  std::string ext = path.substr(dot + 1);
+  std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+  return ext;
+}
+
+static bool isBasicPath(const std::string &path) {
+  return pathExt(path) == "bas";
+}
+
+static bool isDiskPath(const std::string &path) {
+  std::string ext = pathExt(path);
+  return ext == "dsk" || ext == "do" || ext == "po";
+}
+
+static bool loadBasicFile(EmuApple2 *emu, const char *path) {
+  FILE *f = fopen(path, "rt");
+  if (!f) {
+    perror(path);
+    return false;
+  }
+  auto text = readAll<std::string>(f);
+  fclose(f);
+  std::string error;
+  if (!loadApplesoftProgram(emu, text.data(), text.size(), error)) {
+    fprintf(stderr, "%s: %s\n", path, error.c_str());
+    return false;
+  }
+  return true;
+}
+
 void A2Emu::simulationStop() {
   fprintf(stderr, "Command completed\n");
 
@@ -398,20 +754,44 @@ void A2Emu::simulationStop() {
 #include "bolo.h"
 #include "robotron2084.h"
 
+void A2Emu::pushInput(uint8_t kind, uint8_t ch) {
+  // If the emulation is not keeping up, dropping input is the best we can do.
+  input_.push(Input{kind, ch});
+}
+
+void A2Emu::processInput() {
+  Input in;
+  while (input_.pop(in)) {
+    switch (in.kind) {
+    case Input::Key:
+      // Key events have no effect while pasting.
+      if (!a2_io_paste_pending(emu_.io())) {
+        a2_io_push_key(emu_.io(), in.ch);
+        warpSuspended_ = true;
+      }
+      break;
+    case Input::RunBolo:
+      runB33(&emu_, bolo_bin, bolo_bin_len);
+      break;
+    case Input::RunRobotron:
+      runB33(&emu_, robotron2084_bin, robotron2084_bin_len);
+      break;
+    case Input::Stop:
+      simulationStop();
+      break;
+    }
+  }
+}
+
 void A2Emu::event(const sapp_event *ev) {
   if (ev->type == SAPP_EVENTTYPE_QUIT_REQUESTED) {
-    simulationStop();
+    pushInput(Input::Stop);
     return;
   }
 
   int toIgnore = ignoreNextCh_;
   ignoreNextCh_ = -1;
 
-  // If we are reading from a file, just ensure that the keyboard queue us full,
-  // so events here will have no effect.
-  if (kbdFile_)
-    drainKBDFile();
-
   if (ev->type == SAPP_EVENTTYPE_CHAR && ev->char_code < 128) {
     int k = (int)ev->char_code;
     if (k == 127) // Del
@@ -419,28 +799,28 @@ void A2Emu::event(const sapp_event *ev) {
     else if (isalpha(k))
       k = toupper(k);
     if (k != toIgnore)
-      a2_io_push_key(emu_.io(), k);
+      pushInput(Input::Key, k);
   } else if (ev->type == SAPP_EVENTTYPE_KEY_DOWN) {
     switch (ev->key_code) {
     case SAPP_KEYCODE_F1:
-      runB33(&emu_, bolo_bin, bolo_bin_len);
+      pushInput(Input::RunBolo);
       break;
     case SAPP_KEYCODE_F2:
-      runB33(&emu_, robotron2084_bin, robotron2084_bin_len);
+      pushInput(Input::RunRobotron);
       break;
     case SAPP_KEYCODE_DELETE:
     case SAPP_KEYCODE_BACKSPACE:
     case SAPP_KEYCODE_LEFT:
-      a2_io_push_key(emu_.io(), ignoreNextCh_ = 8);
+      pushInput(Input::Key, ignoreNextCh_ = 8);
       break;
     case SAPP_KEYCODE_RIGHT:
-      a2_io_push_key(emu_.io(), ignoreNextCh_ = 21); // CTRL+U
+      pushInput(Input::Key, ignoreNextCh_ = 21); // CTRL+U
       break;
     case SAPP_KEYCODE_ENTER:
-      a2_io_push_key(emu_.io(), ignoreNextCh_ = 13);
+      pushInput(Input::Key, ignoreNextCh_ = 13);
       break;
     case SAPP_KEYCODE_ESCAPE:
-      a2_io_push_key(emu_.io(), ignoreNextCh_ = 27);
+      pushInput(Input::Key, ignoreNextCh_ = 27);
       break;
     default:
       break;
@@ -448,11 +828,48 @@ void A2Emu::event(const sapp_event *ev) {
   }
 }
 
+void A2Emu::emulationLoop() {
+  using namespace std::chrono;
+  const auto period = microseconds(1000000 / 60);
+  auto nextFrame = steady_clock::now();
+  for (;;) {
+    processInput();
+    if (emuQuit_.load(std::memory_order_acquire))
+      break;
+    bool warped = simulateFrame(stm_now());
+    a2_video_tribuf_publish(&tribuf_, emu_.io(), emu_.getMainRAM());
+
+    // Keep a steady rate. If we have warped or fallen too far behind, don't
+    // try to catch up.
+    nextFrame += period;
+    auto now = steady_clock::now();
+    if (warped || now - nextFrame > milliseconds(200))
+      nextFrame = now;
+    else
+      std::this_thread::sleep_until(nextFrame);
+  }
+}
+
 void A2Emu::frame() {
   curFrameTick_ = stm_now();
-  simulateFrame();
-  updateScreen();
-  updateScreenImage();
+  a2_metric_observe_since(metricInterval_, lastFrameStart_);
+  lastFrameStart_ = a2_metrics_start();
+  if (!emuThread_.joinable()) {
+    processInput();
+    simulateFrame(curFrameTick_);
+    a2_video_tribuf_publish(&tribuf_, emu_.io(), emu_.getMainRAM());
+  }
+  // Sokol can only update the whole image, so the dirty rectangle is used
+  // to skip the upload of unchanged frames and to limit the RGB conversion.
+  bool changed = updateScreen();
+  if (cliArgs_.metricsOverlay && videoRAM_ && (a2_overlay_update(&overlay_) || changed)) {
+    a2_overlay_draw(&overlay_, &screen8_, &screen_);
+    changed = true;
+  }
+  if (changed)
+    updateScreenImage();
+  if (metricsDump_)
+    a2_metrics_dump_poll(metricsDump_);
 
   sg_pass_action pass_action = {};
   pass_action.colors[0] = {.action = SG_ACTION_CLEAR};
@@ -482,58 +899,106 @@ void A2Emu::frame() {
   sg_commit();
 }
 
-void A2Emu::simulateFrame() {
+bool A2Emu::simulateFrame(uint64_t now) {
+  uint64_t simStart = a2_metrics_start();
+  bool warped = false;
   if (firstFrame_) {
     firstFrame_ = false;
-    firstFrameTick_ = curFrameTick_;
   } else {
-    if (kbdFile_)
-      drainKBDFile();
-
-    double elapsed = stm_sec(curFrameTick_ - lastRunTick_);
-    unsigned runCycles = (unsigned)(std::min(elapsed, 0.200) * cliArgs_.clockFreq);
-    auto stopReason = emu_.runFor(runCycles);
-    a2_sound_submit(&sound_, Emu6502::CLOCK_FREQ, saudio_sample_rate(), emu_.getCycles());
-    if (stopReason == Emu6502::StopReason::StopRequesed)
-      simulationStop();
+    if (replayStarted_)
+      drainKeyPresses();
+
+    const auto frameCycles = (unsigned)((1.0 / 60.0) * cliArgs_.clockFreq);
+    unsigned startCycles = emu_.getCycles();
+    if (!keyPresses_.empty() || hashLog_.f) {
+      // If we are replaying, we need to have reproducible cycles.
+      runEmulation(frameCycles);
+      a2_metric_add(metricRequested_, frameCycles);
+    } else {
+      double elapsed = stm_sec(now - lastRunTick_);
+      runEmulation((unsigned)(std::min(elapsed, 0.200) * cliArgs_.clockFreq));
+      // The real time is requested, even if the run is capped.
+      a2_metric_add(metricRequested_, (uint64_t)(elapsed * cliArgs_.clockFreq));
+    }
+
+    // While warping, run whole frames for WARP_MS. Only the video of the last
+    // one is displayed.
+    if (warping()) {
+      uint64_t start = stm_now();
+      while (warping() && stm_ms(stm_since(start)) < WARP_MS)
+        runEmulation(frameCycles);
+      now = stm_now();
+      warped = true;
+    }
+    a2_metric_add(metricRun_, emu_.getCycles() - startCycles);
   }
-  lastRunTick_ = curFrameTick_;
+  lastRunTick_ = now;
+  a2_metric_observe_since(metricSim_, simStart);
+  return warped;
 }
 
-void A2Emu::updateScreen() {
+bool A2Emu::warpWanted() {
+  bool autoWarp = cliArgs_.autoWarp;
+  if ((autoWarp || cliArgs_.pasteWarp) && a2_io_paste_pending(emu_.io()))
+    return true;
+  if (autoWarp && replayStarted_ && nextKeyPress_ != keyPresses_.size())
+    return true;
+  return (autoWarp || cliArgs_.diskWarp) && emu_.io()->disk && a2_disk_motor_on(emu_.io()->disk);
+}
+
+bool A2Emu::warping() {
+  if (!warpWanted()) {
+    warpSuspended_ = false;
+    return false;
+  }
+  return !warpSuspended_;
+}
+
+void A2Emu::runEmulation(unsigned runCycles) {
+  // Recorded keys are delivered at their exact cycle, regardless of how the
+  // run is split into frames.
+  unsigned startCycles = emu_.getCycles();
+  auto stopReason = emu_.runFor(runCycles);
+  while (stopReason == Emu6502::StopReason::EventCycle) {
+    drainKeyPresses();
+    unsigned elapsed = emu_.getCycles() - startCycles;
+    if (elapsed >= runCycles)
+      break;
+    stopReason = emu_.runFor(runCycles - elapsed);
+  }
+  if (replayStarted_ && hashLog_.f)
+    a2_hash_log_frame(&hashLog_, emu_.io(), emu_.getMainRAM());
+  a2_sound_submit(&sound_, Emu6502::CLOCK_FREQ, saudio_sample_rate(), emu_.getCycles());
+  if (wav_)
+    a2_wav_advance(wav_, emu_.getCycles());
+  if (stopReason == Emu6502::StopReason::StopRequesed)
+    simulationStop();
+}
+
+bool A2Emu::updateScreen() {
   // Milliseconds since hw reset. Used to determine blink phase.
   auto ms = (uint64_t)stm_ms(stm_diff(curFrameTick_, firstFrameTick_));
-
-  switch (a2_io_get_vidmode(emu_.io())) {
-  case A2_VIDMODE_TEXT:
-    apple2_render_text_screen(
-        emu_.getMainRAM() + a2_io_get_text_page_offset(emu_.io()), &screen_, ms);
-    break;
-  case A2_VIDMODE_GR:
-    apple2_render_gr_screen(
-        emu_.getMainRAM() + a2_io_get_text_page_offset(emu_.io()),
-        &screen_,
-        ms,
-        a2_io_is_vidmode_mixed(emu_.io()));
-    break;
-  case A2_VIDMODE_HGR:
-  default:;
-    bool mono = false;
-    apple2_render_hgr_screen(
-        emu_.getMainRAM() + a2_io_get_hires_page_offset(emu_.io()),
-        emu_.getMainRAM() + a2_io_get_text_page_offset(emu_.io()),
-        &screen_,
-        ms,
-        a2_io_is_vidmode_mixed(emu_.io()),
-        mono);
-    break;
+  if (const a2_video_frame_t *vf = a2_video_tribuf_acquire(&tribuf_)) {
+    a2_video_frame_apply(vf, &videoIO_);
+    videoRAM_ = vf->ram;
   }
+  if (!videoRAM_)
+    return false;
+  a2_rect dirty = a2_render_frame(&renderer_, &videoIO_, videoRAM_, &screen8_, ms);
+  if (dirty.h == 0)
+    return false;
+  if (capture_)
+    a2_capture_frame(capture_, &screen8_, (uint32_t)ms);
+  a2_screen_from_indexed(&screen_, &screen8_, dirty);
+  return true;
 }
 
 void A2Emu::updateScreenImage() {
+  uint64_t start = a2_metrics_start();
   sg_image_data imgData = {};
   imgData.subimage[0][0] = {.ptr = screen_.data, .size = sizeof(screen_.data)};
   sg_update_image(bind_.fs_images[SLOT_tex], &imgData);
+  a2_metric_observe_since(metricUpload_, start);
 }
 
 void A2Emu::disasm(uint16_t pc) {
@@ -593,16 +1058,40 @@ void A2Emu::printDB(uint16_t startAddr) {
 static const char *s_argv0 = "a2emu";
 static void printHelp() {
   printf("syntax: %s [options] [inputFile]\n", s_argv0);
+  printf("inputFile is a DOS 3.3 binary, an Applesoft listing if it ends in .bas, or a\n");
+  printf("disk image booted from slot 6 if it ends in .dsk, .do or .po\n");
   printf(" --help           This help\n");
   printf(" --rom            Start tracing from ROM\n");
+  printf(" --cold-boot      Run the ROM cold start instead of restoring its end state\n");
   printf(" --run            Run the binary\n");
   printf(" --trace          Trace the binary\n");
   printf(" --collect        Collect data from running and write to outputFile or stdout\n");
   printf(" --limit=number   Number of basic blocks to trace/collect\n");
   printf(" --out=path       Specify output file\n");
   printf(" --no-sound       Disable sound\n");
+  printf(" --audio-latency=ms Target audio latency (default %u)\n", A2_SOUND_DEFAULT_LATENCY_MS);
   printf(" --kbd-file=path  Read keyboard input from the specified file\n");
+  printf(" --paste-warp     Run as fast as possible while reading the keyboard file\n");
+  printf(" --disk-warp      Run as fast as possible while the disk drive motor is on\n");
+  printf(" --auto-warp      Run as fast as possible while reading the keyboard or key file,\n");
+  printf("                  or while the disk drive motor is on, until a key is pressed\n");
   printf(" --fast           Emulate a faster CPU\n");
+  printf(" --hle            Execute hot ROM routines natively\n");
+  printf(" --hle-verify     Like --hle, but check every call against the ROM (slow)\n");
+  printf(" --hybrid=path    Run the ROM code covered by a decompiled module natively\n");
+  printf("                  (not with --key-file, --hash-log or --wav)\n");
+  printf(" --video=mode     Display graphics as color (default), mono or ntsc\n");
+  printf(" --capture=path   Capture the screen into the specified file\n");
+  printf(" --key-file=path  Replay key presses with cycle stamps from the specified file\n");
+  printf(" --hash-log=path  Log per-frame video hashes into the specified file\n");
+  printf(" --no-emu-thread  Run the emulation in the render thread\n");
+  printf(" --wav=path       Record the speaker into the specified WAV file\n");
+  printf(" --wav-rate=hz    Sample rate of the recording (default 44100)\n");
+  printf(" --tape=path      Cassette tape WAV file, saved on exit if recorded into\n");
+  printf(" --tape-slow      Read and write the tape only through the cassette signal\n");
+  printf(" --metrics-overlay Show the emulation speed, frame times and audio state\n");
+  printf(" --metrics=path   Dump the metrics periodically into a .json or .csv file\n");
+  printf(" --metrics-interval=ms Interval of the metrics dump (default 1000)\n");
 }
 
 static CLIArgs parseCLI(int argc, char **argv) {
@@ -618,6 +1107,10 @@ static CLIArgs parseCLI(int argc, char **argv) {
       cliArgs.rom = true;
       continue;
     }
+    if (strcmp(arg, "--cold-boot") == 0) {
+      cliArgs.coldBoot = true;
+      continue;
+    }
     if (strcmp(arg, "--run") == 0) {
       cliArgs.action = CLIArgs::Action::Run;
       continue;
@@ -643,10 +1136,31 @@ static CLIArgs parseCLI(int argc, char **argv) {
       cliArgs.outputPath = arg + 6;
       continue;
     }
+    if (strcmp(arg, "--paste-warp") == 0) {
+      cliArgs.pasteWarp = true;
+      continue;
+    }
+    if (strcmp(arg, "--disk-warp") == 0) {
+      cliArgs.diskWarp = true;
+      continue;
+    }
+    if (strcmp(arg, "--auto-warp") == 0) {
+      cliArgs.autoWarp = true;
+      continue;
+    }
     if (strcmp(arg, "--no-sound") == 0) {
       cliArgs.soundEnabled = false;
       continue;
     }
+    if (strncmp(arg, "--audio-latency=", 16) == 0) {
+      auto cr = std::from_chars(arg + 16, strchr(arg, 0), cliArgs.audioLatency);
+      if (*cr.ptr || cr.ec != std::errc()) {
+        fprintf(stderr, "Invalid number in '%s'\n", arg);
+        printHelp();
+        exit(1);
+      }
+      continue;
+    }
     if (strncmp(arg, "--kbd-file=", 11) == 0) {
       cliArgs.kbdPath = arg + 11;
       continue;
@@ -655,6 +1169,87 @@ static CLIArgs parseCLI(int argc, char **argv) {
       cliArgs.clockFreq = Emu6502::CLOCK_FREQ * 10;
       continue;
     }
+    if (strcmp(arg, "--hle") == 0) {
+      cliArgs.hle = true;
+      continue;
+    }
+    if (strcmp(arg, "--hle-verify") == 0) {
+      cliArgs.hle = cliArgs.hleVerify = true;
+      continue;
+    }
+    if (strncmp(arg, "--hybrid=", 9) == 0) {
+      cliArgs.hybridPath = arg + 9;
+      continue;
+    }
+    if (strncmp(arg, "--key-file=", 11) == 0) {
+      cliArgs.keyPath = arg + 11;
+      continue;
+    }
+    if (strncmp(arg, "--hash-log=", 11) == 0) {
+      cliArgs.hashLogPath = arg + 11;
+      continue;
+    }
+    if (strncmp(arg, "--tape=", 7) == 0) {
+      cliArgs.tapePath = arg + 7;
+      continue;
+    }
+    if (strcmp(arg, "--tape-slow") == 0) {
+      cliArgs.tapeSlow = true;
+      continue;
+    }
+    if (strncmp(arg, "--wav=", 6) == 0) {
+      cliArgs.wavPath = arg + 6;
+      continue;
+    }
+    if (strncmp(arg, "--wav-rate=", 11) == 0) {
+      auto cr = std::from_chars(arg + 11, strchr(arg, 0), cliArgs.wavRate);
+      if (*cr.ptr || cr.ec != std::errc() || !cliArgs.wavRate) {
+        fprintf(stderr, "Invalid number in '%s'\n", arg);
+        printHelp();
+        exit(1);
+      }
+      continue;
+    }
+    if (strcmp(arg, "--metrics-overlay") == 0) {
+      cliArgs.metricsOverlay = true;
+      continue;
+    }
+    if (strncmp(arg, "--metrics=", 10) == 0) {
+      cliArgs.metricsPath = arg + 10;
+      continue;
+    }
+    if (strncmp(arg, "--metrics-interval=", 19) == 0) {
+      auto cr = std::from_chars(arg + 19, strchr(arg, 0), cliArgs.metricsInterval);
+      if (*cr.ptr || cr.ec != std::errc() || !cliArgs.metricsInterval) {
+        fprintf(stderr, "Invalid number in '%s'\n", arg);
+        printHelp();
+        exit(1);
+      }
+      continue;
+    }
+    if (strcmp(arg, "--no-emu-thread") == 0) {
+      cliArgs.emuThread = false;
+      continue;
+    }
+    if (strncmp(arg, "--capture=", 10) == 0) {
+      cliArgs.capturePath = arg + 10;
+      continue;
+    }
+    if (strncmp(arg, "--video=", 8) == 0) {
+      const char *mode = arg + 8;
+      if (strcmp(mode, "color") == 0) {
+        cliArgs.renderMode = A2_RENDER_COLOR;
+      } else if (strcmp(mode, "mono") == 0) {
+        cliArgs.renderMode = A2_RENDER_MONO;
+      } else if (strcmp(mode, "ntsc") == 0) {
+        cliArgs.renderMode = A2_RENDER_NTSC;
+      } else {
+        fprintf(stderr, "Invalid video mode '%s'\n", mode);
+        printHelp();
+        exit(1);
+      }
+      continue;
+    }
     if (arg[0] == '-') {
       fprintf(stderr, "Invalid option '%s'\n", arg);
       printHelp();
@@ -669,6 +1264,14 @@ static CLIArgs parseCLI(int argc, char **argv) {
     exit(1);
   }
 
+  // The native code counts cycles per block, so neither the replayed key presses nor the
+  // recordings would land on the same cycles as in the emulator.
+  if (!cliArgs.hybridPath.empty() &&
+      (!cliArgs.keyPath.empty() || !cliArgs.hashLogPath.empty() || !cliArgs.wavPath.empty())) {
+    fprintf(stderr, "--hybrid can't be combined with --key-file, --hash-log or --wav\n");
+    exit(1);
+  }
+
   return cliArgs;
 }
 
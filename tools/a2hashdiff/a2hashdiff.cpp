@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) Tzvetan Mikov.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "apple2tc/a2hash.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <vector>
+
+/// Compares two frame hash logs, for example from an a2emu replay and from a
+/// replay of the decompiled binary with the same key file.
+///
+/// The two programs don't execute the same number of cycles per frame, so the
+/// same screen appears on different frames. Instead of comparing frame by
+/// frame, we compare the sequences of distinct screen states.
+
+struct State {
+  unsigned frame;
+  unsigned mode;
+  uint64_t hash;
+
+  bool operator==(const State &o) const {
+    return mode == o.mode && hash == o.hash;
+  }
+};
+
+static std::optional<std::vector<State>> readLog(const char *path) {
+  FILE *f = fopen(path, "rt");
+  if (!f) {
+    perror(path);
+    return std::nullopt;
+  }
+
+  std::vector<State> states{};
+  char line[128];
+  bool ok = fgets(line, sizeof(line), f) &&
+      strncmp(line, A2_HASH_LOG_HEADER, strlen(A2_HASH_LOG_HEADER)) == 0;
+  if (!ok) {
+    fprintf(stderr, "%s: not a hash log\n", path);
+  } else {
+    State st;
+    int res;
+    while ((res = fscanf(f, "%u %x %" SCNx64 "\n", &st.frame, &st.mode, &st.hash)) == 3) {
+      // Logs contain only changes, but be tolerant of repeated states.
+      if (states.empty() || !(states.back() == st))
+        states.push_back(st);
+    }
+    if (res != EOF) {
+      fprintf(stderr, "%s: parse error after %zu states\n", path, states.size());
+      ok = false;
+    }
+  }
+  fclose(f);
+  if (!ok)
+    return std::nullopt;
+  return states;
+}
+
+static void printState(const char *name, const std::vector<State> &states, size_t index) {
+  if (index < states.size()) {
+    const State &st = states[index];
+    printf("  %s: frame %u mode %x hash %016" PRIx64 "\n", name, st.frame, st.mode, st.hash);
+  } else {
+    printf("  %s: <end>\n", name);
+  }
+}
+
+static void printHelp(const char **argv) {
+  fprintf(stderr, "syntax: %s [options] log1 log2\n", argv[0]);
+  fprintf(stderr, " --prefix  Succeed if one log is a prefix of the other\n");
+}
+
+int main(int argc, const char **argv) {
+  const char *paths[2] = {};
+  unsigned numPaths = 0;
+  bool prefix = false;
+
+  for (int i = 1; i < argc; ++i) {
+    if (strcmp(argv[i], "--prefix") == 0) {
+      prefix = true;
+      continue;
+    }
+    if (argv[i][0] == '-' || numPaths == 2) {
+      printHelp(argv);
+      return 1;
+    }
+    paths[numPaths++] = argv[i];
+  }
+  if (numPaths != 2) {
+    printHelp(argv);
+    return 1;
+  }
+
+  auto a = readLog(paths[0]);
+  auto b = readLog(paths[1]);
+  if (!a || !b)
+    return 2;
+
+  size_t n = std::min(a->size(), b->size());
+  size_t i = 0;
+  while (i != n && (*a)[i] == (*b)[i])
+    ++i;
+
+  if (i == a->size() && i == b->size()) {
+    printf("Identical: %zu states\n", i);
+    return 0;
+  }
+  if (i == n && prefix) {
+    printf("Prefix: %zu common states (%zu vs %zu)\n", i, a->size(), b->size());
+    return 0;
+  }
+
+  printf("Divergence at state %zu of %zu/%zu:\n", i, a->size(), b->size());
+  if (i) {
+    printf(" last common:\n");
+    printState(paths[0], *a, i - 1);
+    printState(paths[1], *b, i - 1);
+  }
+  printf(" first different:\n");
+  printState(paths[0], *a, i);
+  printState(paths[1], *b, i);
+  return 1;
+}
@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) Tzvetan Mikov.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "apple2tc/a2wav.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/// Audio fingerprints for comparing speaker recordings, for example of the
+/// same key file replayed in A2emu and in a decompiled game.
+///
+/// The audio is split into blocks of 20 ms. Every block is described by the
+/// RMS of its AC component and by its dominant frequency, estimated from the
+/// number of crossings of the block mean. The speaker produces square waves,
+/// for which this is a good estimate, and it doesn't depend on the sample
+/// rate or the exact shape of the edges.
+
+static void printHelp(const char **argv) {
+  fprintf(stderr, "syntax: %s [options] file1.wav [file2.wav]\n", argv[0]);
+  fprintf(stderr, "With one file, print its fingerprint. With two, compare them.\n");
+  fprintf(stderr, " --dump           Print the features of every block\n");
+  fprintf(stderr, " --threshold=pct  Minimum percentage of matching blocks (default 95)\n");
+}
+
+namespace {
+
+constexpr unsigned kBlockMS = 20;
+/// Blocks with a lower RMS are considered silent.
+constexpr float kSilence = 0.005f;
+
+struct Block {
+  float rms;
+  float freq;
+
+  bool silent() const {
+    return rms < kSilence;
+  }
+};
+
+} // namespace
+
+static bool loadBlocks(const char *path, std::vector<Block> &blocks) {
+  a2_wav_reader_t rd;
+  if (!a2_wav_reader_open(&rd, path))
+    return false;
+
+  unsigned blockLen = rd.sample_rate * kBlockMS / 1000;
+  if (!blockLen) {
+    fprintf(stderr, "%s: sample rate %u is too low\n", path, rd.sample_rate);
+    a2_wav_reader_close(&rd);
+    return false;
+  }
+  std::vector<float> buf(blockLen);
+  unsigned n;
+  while ((n = a2_wav_reader_read(&rd, buf.data(), blockLen)) == blockLen) {
+    double mean = 0;
+    for (float v : buf)
+      mean += v;
+    mean /= n;
+
+    double sq = 0;
+    unsigned crossings = 0;
+    bool above = buf[0] > mean;
+    for (float v : buf) {
+      double ac = v - mean;
+      sq += ac * ac;
+      if ((v > mean) != above) {
+        above = !above;
+        ++crossings;
+      }
+    }
+    blocks.push_back(
+        {(float)std::sqrt(sq / n), (float)(crossings * 1000.0 / 2 / kBlockMS)});
+  }
+  a2_wav_reader_close(&rd);
+  return true;
+}
+
+/// Skip the silence at the start, so recordings which start at different
+/// times can be compared.
+static size_t firstSound(const std::vector<Block> &blocks) {
+  size_t i = 0;
+  while (i != blocks.size() && blocks[i].silent())
+    ++i;
+  return i;
+}
+
+static bool blocksMatch(const Block &a, const Block &b) {
+  if (a.silent() || b.silent())
+    return a.silent() == b.silent();
+  // The frequency estimate of a single block is within one crossing.
+  float freqTol = std::max(a.freq, b.freq) * 0.03f + 1000.0f / kBlockMS;
+  return std::fabs(a.freq - b.freq) <= freqTol &&
+      std::fabs(a.rms - b.rms) <= std::max(a.rms, b.rms) * 0.25f;
+}
+
+/// A hash of the quantized blocks: the frequency in semitones and the level
+/// in 3 dB steps.
+static uint64_t fingerprint(const std::vector<Block> &blocks, size_t from) {
+  uint64_t h = 0xCBF29CE484222325ULL;
+  for (size_t i = from; i != blocks.size(); ++i) {
+    const Block &b = blocks[i];
+    int q = 0;
+    if (!b.silent()) {
+      int semi = b.freq > 0 ? (int)std::lround(12 * std::log2(b.freq / 440.0)) : -1000;
+      int level = (int)std::lround(20 * std::log10(b.rms) / 3);
+      q = semi * 64 + level;
+    }
+    h = (h ^ (uint32_t)q) * 0x100000001B3ULL;
+  }
+  return h;
+}
+
+int main(int argc, const char **argv) {
+  std::vector<std::string> paths{};
+  bool dump = false;
+  unsigned threshold = 95;
+
+  for (int i = 1; i < argc; ++i) {
+    const char *arg = argv[i];
+    if (strcmp(arg, "--dump") == 0) {
+      dump = true;
+      continue;
+    }
+    if (strncmp(arg, "--threshold=", 12) == 0) {
+      auto cr = std::from_chars(arg + 12, strchr(arg, 0), threshold);
+      if (*cr.ptr || cr.ec != std::errc() || threshold > 100) {
+        fprintf(stderr, "Invalid number in '%s'\n", arg);
+        printHelp(argv);
+        return 1;
+      }
+      continue;
+    }
+    if (arg[0] == '-') {
+      printHelp(argv);
+      return 1;
+    }
+    paths.push_back(arg);
+  }
+  if (paths.empty() || paths.size() > 2) {
+    printHelp(argv);
+    return 1;
+  }
+
+  std::vector<Block> blocks[2];
+  size_t start[2];
+  for (size_t i = 0; i != paths.size(); ++i) {
+    if (!loadBlocks(paths[i].c_str(), blocks[i]))
+      return 1;
+    start[i] = firstSound(blocks[i]);
+    if (dump) {
+      printf("# %s\n", paths[i].c_str());
+      for (size_t j = start[i]; j != blocks[i].size(); ++j) {
+        const Block &b = blocks[i][j];
+        printf("%8zu %8.1f %.4f\n", j * kBlockMS, b.silent() ? 0 : b.freq, b.rms);
+      }
+    }
+  }
+
+  if (paths.size() == 1) {
+    printf(
+        "%016llx %zu blocks\n",
+        (unsigned long long)fingerprint(blocks[0], start[0]),
+        blocks[0].size() - start[0]);
+    return 0;
+  }
+
+  size_t len0 = blocks[0].size() - start[0];
+  size_t len1 = blocks[1].size() - start[1];
+  size_t common = std::min(len0, len1);
+  size_t total = std::max(len0, len1);
+  size_t matches = 0;
+  size_t firstMismatch = SIZE_MAX;
+  for (size_t i = 0; i != common; ++i) {
+    if (blocksMatch(blocks[0][start[0] + i], blocks[1][start[1] + i]))
+      ++matches;
+    else if (firstMismatch == SIZE_MAX)
+      firstMismatch = i;
+  }
+  double pct = total ? matches * 100.0 / total : 100;
+  printf("%zu of %zu blocks match (%.1f%%)\n", matches, total, pct);
+  if (firstMismatch != SIZE_MAX) {
+    printf(
+        "first mismatch at %zu ms / %zu ms\n",
+        (start[0] + firstMismatch) * kBlockMS,
+        (start[1] + firstMismatch) * kBlockMS);
+  }
+  return pct >= threshold ? 0 : 1;
+}
@@ -406,6 +406,11 @@ private:
   /// \return true if the generated instruction "falls through" to whatever
   ///     follows.
   bool printSimpleCInst(FILE *f, uint16_t pc, CPUInst inst);
+  /// The number of cycles charged for executing \p block.
+  static long simpleCCycles(const AsmBlock &block);
+  /// If \p block is the outer loop of the Monitor WAIT routine, with the same
+  /// code and blocks as in the ROM, print its fast path.
+  void printSimpleCWait(FILE *f, const AsmBlock &block);
   std::string simpleCRead(CPUInst inst) const;
   static const char *simpleCReadOp(CPUInst inst);
   static const char *simpleCWriteOp(CPUInst inst);
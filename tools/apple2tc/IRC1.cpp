@@ -12,6 +12,7 @@
 #include "apple2tc/d6502.h"
 #include "apple2tc/support.h"
 
+#include <algorithm>
 #include <cstdarg>
 
 static inline constexpr bool BLOCKMAP_BSEARCH = true;
@@ -45,22 +46,77 @@ static uint16_t sbc_dec16(uint8_t a, uint8_t b, uint8_t cf) {
   return res.result | (res.status << 8);
 }
 )");
+}
+
+void IRC1Mod::printUnknownAddr() {
+  std::vector<std::pair<uint32_t, Function *>> entries{};
+  for (auto &func : mod_->functions())
+    if (func.getAddress() && func.isRealAddress() && *func.getAddress() <= 0xFFFF)
+      entries.emplace_back(*func.getAddress(), &func);
+  std::sort(entries.begin(), entries.end(), [](const auto &a, const auto &b) {
+    return a.first < b.first;
+  });
+
+  fprintf(os_, R"(
+/// The entry points of the functions, where interpreted code continues
+/// natively.
+static const struct func_entry {
+  uint16_t addr;
+  void (*fn)(uint16_t ret_addr);
+} s_func_entries[] = {
+)");
+  for (const auto &e : entries)
+    fprintf(os_, "    {0x%04x, %s},\n", e.first, getName(e.second));
+  // An empty array isn't valid C.
+  if (entries.empty())
+    fprintf(os_, "    {0, NULL},\n");
+  fprintf(os_, "};\n");
+
+  fprintf(os_, "%s", R"(
+static int cmp_func_entry(const void *key, const void *entry) {
+  return *((const uint16_t *)key) - ((const struct func_entry *)entry)->addr;
+}
+
+/// Invoked when execution reaches \p addr, which isn't a block of the current
+/// function. Return true if the function must return, because the code
+/// returned to one of its callers. Otherwise run the function starting at
+/// \p addr natively, or interpret one instruction, and store the address of
+/// the next one in \p addr.
+static bool run_unknown(uint16_t *addr) {
+  if (native_unwind(*addr))
+    return true;
+  const struct func_entry *f = (const struct func_entry *)bsearch(
+      addr,
+      s_func_entries,
+      sizeof(s_func_entries) / sizeof(s_func_entries[0]),
+      sizeof(s_func_entries[0]),
+      cmp_func_entry);
+  if (f && f->fn)
+    return native_call(f->fn, addr);
+  *addr = interpret_unknown(*addr);
+  return false;
+}
+)");
+
   if (BLOCKMAP_BSEARCH) {
     fprintf(os_, "%s", R"(
 static int cmp_map_addr(const void *a, const void *b) {
   return *((const int *)a) - *((const int *)b);
 }
 
+/// Map \p addr to a block id. Code which wasn't decompiled is interpreted
+/// until it reaches a block in the map, or returns to a caller.
 static unsigned
 addr_to_block_id(uint16_t from_pc, uint16_t addr, const unsigned *block_map, size_t length) {
-  unsigned uaddr = addr;
-  const unsigned *p =
-      (const unsigned *)bsearch(&uaddr, block_map, length, sizeof(unsigned) * 2, cmp_map_addr);
-  if (p)
-    return p[1];
-  fprintf(stderr, "Unknown address $%04X\n", addr);
-  error_handler(from_pc);
-  abort();
+  for (;;) {
+    unsigned uaddr = addr;
+    const unsigned *p =
+        (const unsigned *)bsearch(&uaddr, block_map, length, sizeof(unsigned) * 2, cmp_map_addr);
+    if (p)
+      return p[1];
+    if (run_unknown(&addr))
+      return UNWIND_BLOCK_ID;
+  }
 };
 )");
   }
@@ -106,6 +162,8 @@ void IRC1Mod::run() {
   for (auto &func : mod_->functions())
     fprintf(os_, "void %s(uint16_t ret_addr);\n", getName(&func));
 
+  printUnknownAddr();
+
   fprintf(os_, "\n");
   fprintf(os_, "static void emulated_entry_point(void) {\n");
   fprintf(os_, "  %s(false);\n", getName(mod_->getStartFunction()));
@@ -345,12 +403,14 @@ static unsigned find_block_id_%s(uint16_t from_pc, uint16_t addr) {
         name_);
   } else {
     fprintf(os_, "static unsigned find_block_id_%s(uint16_t from_pc, uint16_t addr) {\n", name_);
-    fprintf(os_, "  switch(addr) {\n");
+    fprintf(os_, "  for (;;) {\n");
+    fprintf(os_, "    switch(addr) {\n");
     for (const auto &p : map)
-      fprintf(os_, "  case 0x%04x: return %u;\n", p.first, p.second);
-    fprintf(os_, "  default:\n");
-    fprintf(os_, "    fprintf(stderr, \"Unknown address $%%04X\\n\", addr);\n");
-    fprintf(os_, "    error_handler(from_pc);\n");
+      fprintf(os_, "    case 0x%04x: return %u;\n", p.first, p.second);
+    fprintf(os_, "    default:\n");
+    fprintf(os_, "      if (run_unknown(&addr))\n");
+    fprintf(os_, "        return UNWIND_BLOCK_ID;\n");
+    fprintf(os_, "    }\n");
     fprintf(os_, "  }\n");
     fprintf(os_, "}\n\n");
   }
@@ -421,8 +481,10 @@ void IRC1::runFunc() {
   }
   fprintf(os_, "\n");
 
-  fprintf(os_, "  if (ret_addr)\n");
-  fprintf(os_, "    push16(ret_addr); // Fake return address.\n");
+  if (haveCalls_)
+    fprintf(os_, "  unsigned depth = native_enter(ret_addr);\n");
+  else
+    fprintf(os_, "  native_enter(ret_addr);\n");
   fprintf(os_, "\n");
   if (needDynamicBlocks()) {
     fprintf(os_, "  for(;;) {\n");
@@ -435,6 +497,8 @@ void IRC1::runFunc() {
   }
 
   if (needDynamicBlocks()) {
+    fprintf(os_, "    case UNWIND_BLOCK_ID:\n");
+    fprintf(os_, "      return;\n");
     fprintf(os_, "    default:\n");
     fprintf(os_, "      fprintf(stderr, \"panic: unknown block_id: %%u\\n\", block_id);\n");
     fprintf(os_, "      abort();\n");
@@ -454,6 +518,8 @@ void IRC1::scanForDynamicBlocks() {
     for (auto &inst : bb.instructions()) {
       if (inst.getKind() == ValueKind::CPUAddr2BB || inst.getKind() == ValueKind::RTS)
         haveCPUAddr2BB = true;
+      if (inst.getKind() == ValueKind::Call)
+        haveCalls_ = true;
 
       int opIndex = -1;
       switch (inst.getKind()) {
@@ -1015,14 +1081,15 @@ void IRC1::printCPUAddr2BB(Instruction *inst) {
       formatOperand(inst->getOperand(0)).c_str());
 }
 void IRC1::printCall(Instruction *inst) {
+  // If the callee was unwound past this function, return too.
   bprintf(
       obuf_,
-      "%s(%s)",
+      "%s(%s); if (s_native_depth <= depth) return",
       c1mod_->getName(cast<Function>(inst->getOperand(0))),
       formatOperand(inst->getOperand(1)).c_str());
 }
 void IRC1::printReturn(Instruction *inst) {
-  bprintf(obuf_, "if (ret_addr) pop16(); return");
+  bprintf(obuf_, "native_return(ret_addr); return");
 }
 void IRC1::printExit(Instruction *inst) {}
 void IRC1::printJmp(Instruction *inst) {
@@ -40,6 +40,8 @@ class IRC1 {
 
   /// Blocks for which we require CPU address mapping.
   std::vector<BasicBlock *> sortedDynamicBlocks_{};
+  /// The function calls other functions, so it needs its depth to unwind.
+  bool haveCalls_ = false;
 
   /// Descriptor of a single temporary variable.
   struct TmpVar {
@@ -135,5 +137,7 @@ public:
 
 private:
   void printPrologue();
+  /// Print the function entry points and the fallback to the interpreter.
+  void printUnknownAddr();
   void printEpilogue();
 };
\ No newline at end of file
@@ -68,11 +68,11 @@ void Disas::printSimpleC(FILE *f) {
   fprintf(f, "\n");
   fprintf(f, "void run_emulated(unsigned run_cycles) {\n");
   fprintf(f, "  bool branchTarget = true;\n");
-  fprintf(f, "  s_remaining_cycles += (int)run_cycles;\n");
+  fprintf(f, "  start_run(run_cycles);\n");
   fprintf(f, "  while (s_remaining_cycles > 0) {\n");
   fprintf(f, "    uint16_t tmp16;\n");
   fprintf(f, "    uint8_t tmp;\n");
-  fprintf(f, "    switch (s_pc) {\n");
+  fprintf(f, "    switch (dispatch_pc()) {\n");
 
   for (auto it = asmBlocks_.begin(), end = asmBlocks_.end(); it != end;) {
     const AsmBlock &block = it->second;
@@ -82,8 +82,10 @@ void Disas::printSimpleC(FILE *f) {
   }
 
   fprintf(f, "    default:\n");
-  fprintf(f, "      fprintf(stderr, \"Unknown code address: $%%04X\\n\", s_pc);\n");
-  fprintf(f, "      error_handler(s_pc);\n");
+  fprintf(f, "      if (!unknown_code_address())\n");
+  fprintf(f, "        return;\n");
+  fprintf(f, "      branchTarget = true;\n");
+  fprintf(f, "      break;\n");
   fprintf(f, "    }\n");
   fprintf(f, "  }\n");
   fprintf(f, "}\n");
@@ -100,7 +102,8 @@ void Disas::printSimpleCRange(FILE *f, const AsmBlock &block, const AsmBlock * /
       block.addr(),
       block.endAddr() - 1,
       block.size());
-  printf("      CYCLES(0x%04x, %ld);\n", block.addr(), lround(block.size() * 1.7 + 0.5));
+  printSimpleCWait(f, block);
+  printf("      CYCLES(0x%04x, %ld);\n", block.addr(), simpleCCycles(block));
 
   bool fall = false;
   for (const auto [addr, inst] : block.instructions(this))
@@ -115,6 +118,44 @@ void Disas::printSimpleCRange(FILE *f, const AsmBlock &block, const AsmBlock * /
   }
 }
 
+long Disas::simpleCCycles(const AsmBlock &block) {
+  return lround(block.size() * 1.7 + 0.5);
+}
+
+void Disas::printSimpleCWait(FILE *f, const AsmBlock &block) {
+  // WAIT   SEC
+  // WAIT2  PHA
+  // WAIT3  SBC #$01
+  //        BNE WAIT3
+  //        PLA
+  //        SBC #$01
+  //        BNE WAIT2
+  //        RTS
+  static constexpr uint16_t WAIT2 = 0xFCA9;
+  static const uint8_t code[] = {0x48, 0xE9, 0x01, 0xD0, 0xFC, 0x68, 0xE9, 0x01, 0xD0, 0xF6, 0x60};
+  if (block.addr() != WAIT2)
+    return;
+  for (unsigned i = 0; i != sizeof(code); ++i)
+    if (peek(WAIT2 + i) != code[i] || checkSelfModified(WAIT2 + i))
+      return;
+  const AsmBlock *inner = cfindAsmBlockAt(WAIT2 + 1);
+  const AsmBlock *outer = cfindAsmBlockAt(WAIT2 + 5);
+  if (block.size() != 1 || !inner || inner->size() != 4 || !outer || outer->size() != 5 ||
+      !cfindAsmBlockAt(WAIT2 + 10)) {
+    return;
+  }
+
+  fprintf(
+      f,
+      "      if (wait_fast(%ld, %ld, %ld)) {\n",
+      simpleCCycles(block),
+      simpleCCycles(*inner),
+      simpleCCycles(*outer));
+  fprintf(f, "        s_pc = s_a ? 0x%04x : 0x%04x;\n", WAIT2, WAIT2 + 10);
+  fprintf(f, "        break;\n");
+  fprintf(f, "      }\n");
+}
+
 bool Disas::printSimpleCInst(FILE *f, uint16_t pc, CPUInst inst) {
   bool fall = true;
   scSelfModOperand_ = false;
@@ -0,0 +1,258 @@
+/*
+ * Copyright (c) Tzvetan Mikov.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "apple2tc/spsc.h"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+/// Measures the throughput and the cross-thread latency of SPSCRing, and of a
+/// replica of the ring it replaced, which kept a single shared element count
+/// next to its head and tail.
+
+static void printHelp(const char **argv) {
+  fprintf(stderr, "syntax: %s [options]\n", argv[0]);
+  fprintf(stderr, " --count=n     Number of elements to transfer (default 50000000)\n");
+  fprintf(stderr, " --trips=n     Number of round trips in the latency test (default 1000000)\n");
+  fprintf(stderr, " --cpus=a,b    Pin the two threads to CPUs a and b (Linux only)\n");
+}
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr unsigned kCapacity = 4096;
+/// Batch size of the batched throughput test.
+constexpr unsigned kBatch = 64;
+
+int cpus_[2] = {-1, -1};
+
+/// Pin the calling thread to `cpus_[index]`, if requested.
+void pinThread(unsigned index) {
+#ifdef __linux__
+  if (cpus_[index] < 0)
+    return;
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpus_[index], &set);
+  if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0)
+    fprintf(stderr, "warning: failed to pin to CPU %d\n", cpus_[index]);
+#else
+  (void)index;
+#endif
+}
+
+/// The old queue design: byte ring with one atomic count shared by both sides.
+class SharedCountRing {
+public:
+  explicit SharedCountRing(unsigned capacity) : capacity_(capacity), data_(new uint32_t[capacity]) {}
+  ~SharedCountRing() {
+    delete[] data_;
+  }
+
+  bool push(uint32_t v) {
+    if (count_.load(std::memory_order_acquire) == capacity_)
+      return false;
+    data_[tail_] = v;
+    tail_ = (tail_ + 1) & (capacity_ - 1);
+    count_.fetch_add(1, std::memory_order_release);
+    return true;
+  }
+  bool pop(uint32_t &v) {
+    if (count_.load(std::memory_order_acquire) == 0)
+      return false;
+    v = data_[head_];
+    head_ = (head_ + 1) & (capacity_ - 1);
+    count_.fetch_sub(1, std::memory_order_release);
+    return true;
+  }
+
+private:
+  unsigned head_ = 0;
+  unsigned tail_ = 0;
+  std::atomic<unsigned> count_{0};
+  unsigned capacity_;
+  uint32_t *data_;
+};
+
+/// Adapts SPSCRing to the interface of SharedCountRing.
+class Ring {
+public:
+  explicit Ring(unsigned capacity) : ring_(capacity) {}
+
+  bool push(uint32_t v) {
+    return ring_.push(v);
+  }
+  bool pop(uint32_t &v) {
+    return ring_.pop(v);
+  }
+  SPSCRing<uint32_t> &ring() {
+    return ring_;
+  }
+
+private:
+  SPSCRing<uint32_t> ring_;
+};
+
+/// Busy wait while \p cond returns false. Yield occasionally, so the test can
+/// complete even when both threads share a CPU.
+template <class F>
+void spinUntil(F cond) {
+  for (unsigned spins = 0; !cond();) {
+    if (++spins == 1000) {
+      spins = 0;
+      std::this_thread::yield();
+    }
+  }
+}
+
+double seconds(Clock::time_point start) {
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+void report(const char *name, unsigned count, double secs, uint64_t sum) {
+  uint64_t expected = (uint64_t)count * (count - 1) / 2;
+  printf(
+      "  %-22s %8.1f M/s%s\n",
+      name,
+      count / secs / 1e6,
+      sum == expected ? "" : "  CHECKSUM MISMATCH");
+}
+
+/// Transfer `count` consecutive integers one by one.
+template <class Q>
+void throughput(const char *name, unsigned count) {
+  Q q(kCapacity);
+  uint64_t sum = 0;
+  auto start = Clock::now();
+  std::thread consumer([&] {
+    pinThread(1);
+    uint32_t v;
+    for (unsigned i = 0; i != count; ++i) {
+      spinUntil([&] { return q.pop(v); });
+      sum += v;
+    }
+  });
+  pinThread(0);
+  for (unsigned i = 0; i != count; ++i)
+    spinUntil([&] { return q.push(i); });
+  consumer.join();
+  report(name, count, seconds(start), sum);
+}
+
+/// Transfer `count` consecutive integers in place, up to kBatch at a time.
+void throughputBatch(unsigned count) {
+  SPSCRing<uint32_t> q(kCapacity);
+  uint64_t sum = 0;
+  auto start = Clock::now();
+  std::thread consumer([&] {
+    pinThread(1);
+    for (unsigned i = 0; i != count;) {
+      SPSCRing<uint32_t>::Parts parts;
+      spinUntil([&] { return (parts = q.peek(kBatch)).size() != 0; });
+      for (unsigned j = 0, e = parts.size(); j != e; ++j)
+        sum += parts[j];
+      q.release(parts.size());
+      i += parts.size();
+    }
+  });
+  pinThread(0);
+  for (unsigned i = 0; i != count;) {
+    SPSCRing<uint32_t>::Parts parts;
+    spinUntil([&] { return (parts = q.reserve(std::min(kBatch, count - i))).size() != 0; });
+    for (unsigned j = 0, e = parts.size(); j != e; ++j)
+      parts[j] = i + j;
+    q.commit(parts.size());
+    i += parts.size();
+  }
+  consumer.join();
+  report("SPSCRing reserve/peek", count, seconds(start), sum);
+}
+
+/// Bounce a value between two threads through a pair of queues and report the
+/// average one way latency.
+template <class Q>
+void latency(const char *name, unsigned trips) {
+  Q ping(kCapacity), pong(kCapacity);
+  std::thread echo([&] {
+    pinThread(1);
+    uint32_t v;
+    for (unsigned i = 0; i != trips; ++i) {
+      spinUntil([&] { return ping.pop(v); });
+      pong.push(v);
+    }
+  });
+  pinThread(0);
+  auto start = Clock::now();
+  uint32_t v;
+  for (unsigned i = 0; i != trips; ++i) {
+    ping.push(i);
+    spinUntil([&] { return pong.pop(v); });
+  }
+  double secs = seconds(start);
+  echo.join();
+  printf("  %-22s %8.1f ns\n", name, secs * 1e9 / trips / 2);
+}
+
+bool parseUnsigned(const char *arg, const char *s, unsigned &v) {
+  auto cr = std::from_chars(s, strchr(s, 0), v);
+  if (*cr.ptr || cr.ec != std::errc() || !v) {
+    fprintf(stderr, "Invalid number in '%s'\n", arg);
+    return false;
+  }
+  return true;
+}
+
+} // namespace
+
+int main(int argc, const char **argv) {
+  unsigned count = 50000000;
+  unsigned trips = 1000000;
+
+  for (int i = 1; i < argc; ++i) {
+    const char *arg = argv[i];
+    if (strncmp(arg, "--count=", 8) == 0) {
+      if (!parseUnsigned(arg, arg + 8, count))
+        return 1;
+      continue;
+    }
+    if (strncmp(arg, "--trips=", 8) == 0) {
+      if (!parseUnsigned(arg, arg + 8, trips))
+        return 1;
+      continue;
+    }
+    if (strncmp(arg, "--cpus=", 7) == 0) {
+      if (sscanf(arg + 7, "%d,%d", &cpus_[0], &cpus_[1]) != 2) {
+        fprintf(stderr, "Invalid CPUs in '%s'\n", arg);
+        return 1;
+      }
+      continue;
+    }
+    printHelp(argv);
+    return 1;
+  }
+
+  printf("Throughput (%u x uint32):\n", count);
+  throughput<SharedCountRing>("shared count", count);
+  throughput<Ring>("SPSCRing push/pop", count);
+  throughputBatch(count);
+
+  printf("One way latency (%u round trips):\n", trips);
+  latency<SharedCountRing>("shared count", trips);
+  latency<Ring>("SPSCRing", trips);
+  return 0;
+}
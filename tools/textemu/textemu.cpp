@@ -126,6 +126,8 @@ int main(int argc, const char **argv) {
   auto emu = std::make_unique<Debug6502>();
   auto rom = readAll(argc < 2 ? "rom/apple2plus.rom" : argv[1]);
   emu->loadROM((const uint8_t *)rom.data(), rom.size());
+  // Start at the Applesoft prompt without running the cold start, if possible.
+  emu->fastBoot();
   // emu->addDebugFlags(Emu6502::DebugASM);
   emu->addDebugFlags(Emu6502::DebugKbdin);
   emu->addDebugFlags(Emu6502::DebugStdout);